@@ -0,0 +1,168 @@
+﻿#pragma once
+#include "Render/AnimationClip.h"
+#include "Render/AnimationPose.h"
+#include "Render/Skeleton.h"
+
+#include "Core/SObject.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace animationTest
+{
+	/// @brief root - (조인트가 아닌 노드) - hip - spine 계층의 스켈레톤
+	inline auto MakeSkeleton() -> sh::render::Skeleton
+	{
+		const std::vector<int> parents{ -1, 0, 1, 2 };
+		std::vector<glm::mat4> matrices(4, glm::mat4{ 1.f });
+		matrices[1][3] = glm::vec4{ 0.f, 0.f, 5.f, 1.f };
+		matrices[2][3] = glm::vec4{ 1.f, 0.f, 0.f, 1.f };
+		matrices[3][3] = glm::vec4{ 0.f, 2.f, 0.f, 1.f };
+		const std::vector<std::string> names{ "root", "offset", "hip", "spine" };
+
+		sh::render::Skeleton skeleton;
+		skeleton.joints.resize(2);
+		// 자식 조인트를 먼저 둬서 계산 순서가 필요하게 만든다.
+		skeleton.joints[0].nodeIdx = 3;
+		skeleton.joints[1].nodeIdx = 2;
+		skeleton.BuildHierarchy(parents, matrices, names);
+		return skeleton;
+	}
+	inline auto AxisAngle(float angle) -> glm::vec4
+	{
+		return glm::vec4{ 0.f, 0.f, std::sin(angle * 0.5f), std::cos(angle * 0.5f) };
+	}
+}//namespace
+
+TEST(AnimationTest, Hierarchy)
+{
+	using namespace sh::render;
+	const Skeleton skeleton = animationTest::MakeSkeleton();
+	EXPECT_EQ(skeleton.joints[0].name, "spine");
+	EXPECT_EQ(skeleton.joints[0].parentIdx, 1);
+	EXPECT_EQ(skeleton.joints[1].parentIdx, -1);
+	EXPECT_EQ(skeleton.joints[1].parentMat[3].z, 5.f);
+	ASSERT_EQ(skeleton.order.size(), 2);
+	EXPECT_EQ(skeleton.order[0], 1);
+	EXPECT_EQ(skeleton.FindJoint("hip"), 1);
+	EXPECT_EQ(skeleton.FindJoint("offset"), -1);
+
+	AnimationPose pose;
+	pose.SetRestPose(skeleton);
+	std::vector<glm::mat4> matrices(skeleton.joints.size());
+	pose.ComputeModelMatrices(skeleton, matrices.data());
+	EXPECT_FLOAT_EQ(matrices[0][3].x, 1.f);
+	EXPECT_FLOAT_EQ(matrices[0][3].y, 2.f);
+	EXPECT_FLOAT_EQ(matrices[0][3].z, 5.f);
+
+	// hip을 z축으로 90도 돌리면 spine의 (0, 2, 0)이 (-2, 0, 0)이 된다.
+	const glm::vec4 rotation = animationTest::AxisAngle(3.14159265f * 0.5f);
+	for (int i = 0; i < 4; ++i)
+		pose.GetChannel(AnimationPose::RotationX + i)[1] = rotation[i];
+	pose.ComputeModelMatrices(skeleton, matrices.data());
+	EXPECT_NEAR(matrices[0][3].x, -1.f, 1e-5f);
+	EXPECT_NEAR(matrices[0][3].y, 0.f, 1e-5f);
+	EXPECT_NEAR(matrices[0][3].z, 5.f, 1e-5f);
+
+	glm::vec3 t, s;
+	glm::vec4 q;
+	Skeleton::DecomposeMatrix(matrices[0], t, q, s);
+	EXPECT_NEAR(std::abs(q.z), rotation.z, 1e-5f);
+	EXPECT_NEAR(s.x, 1.f, 1e-5f);
+}
+
+TEST(AnimationTest, CompressAndSample)
+{
+	using namespace sh::render;
+	const Skeleton skeleton = animationTest::MakeSkeleton();
+
+	AnimationClip::RawTrack hip{};
+	hip.name = "hip";
+	hip.translation.times = { 0.f, 1.f, 2.f };
+	hip.translation.values = { glm::vec4{ 0.f, 0.f, 0.f, 0.f }, glm::vec4{ 3.f, 0.f, 0.f, 0.f }, glm::vec4{ 6.f, 0.f, 0.f, 0.f } };
+	hip.rotation.times = { 0.f, 2.f };
+	hip.rotation.values = { animationTest::AxisAngle(0.f), animationTest::AxisAngle(2.f) };
+	hip.scale.times = { 0.f, 2.f };
+	hip.scale.values = { glm::vec4{ 1.f, 1.f, 1.f, 0.f }, glm::vec4{ 1.f, 1.f, 1.f, 0.f } };
+	AnimationClip::RawTrack unknown{};
+	unknown.name = "tail";
+	unknown.translation.times = { 0.f, 2.f };
+	unknown.translation.values = { glm::vec4{ 0.f }, glm::vec4{ 1.f } };
+	unknown.scale = unknown.translation;
+
+	AnimationClip* const clip = sh::core::SObject::Create<AnimationClip>();
+	clip->Compress({ hip, unknown });
+	const AnimationClip::Data& data = clip->GetData();
+	EXPECT_FLOAT_EQ(clip->GetDuration(), 2.f);
+	EXPECT_EQ(clip->GetFrameCount(), 61);
+	// 움직이는 채널: hip의 tx, qz, qw와 tail의 이동, 크기
+	EXPECT_EQ(data.animatedTargets.size(), 9);
+	EXPECT_EQ(data.constantTargets.size(), 7);
+	EXPECT_EQ(data.frames.size(), 9 * 61);
+
+	const AnimationClip::Binding binding = clip->Bind(skeleton);
+	AnimationPose pose;
+	pose.SetRestPose(skeleton);
+	for (float time : { 0.f, 0.37f, 1.f, 1.52f, 2.f })
+	{
+		clip->Sample(time, false, binding, pose);
+		EXPECT_NEAR(pose.GetChannel(AnimationPose::TranslationX)[1], time * 3.f, 1e-3f);
+		EXPECT_NEAR(pose.GetChannel(AnimationPose::RotationZ)[1], std::sin(time * 0.5f), 2e-3f);
+		EXPECT_NEAR(pose.GetChannel(AnimationPose::RotationW)[1], std::cos(time * 0.5f), 2e-3f);
+		EXPECT_FLOAT_EQ(pose.GetChannel(AnimationPose::ScaleY)[1], 1.f);
+		// 스켈레톤에 없는 트랙과 애니메이션 되지 않은 조인트는 그대로다.
+		EXPECT_FLOAT_EQ(pose.GetChannel(AnimationPose::TranslationY)[0], 2.f);
+	}
+	// 반복 재생은 길이로 나눈 나머지 시간을 쓴다.
+	clip->Sample(2.5f, true, binding, pose);
+	EXPECT_NEAR(pose.GetChannel(AnimationPose::TranslationX)[1], 1.5f, 1e-3f);
+	clip->Sample(2.5f, false, binding, pose);
+	EXPECT_NEAR(pose.GetChannel(AnimationPose::TranslationX)[1], 6.f, 1e-3f);
+
+	// 다른 스켈레톤용 바인딩은 무시된다.
+	AnimationPose other(7);
+	clip->Sample(1.f, false, binding, other);
+	EXPECT_FLOAT_EQ(other.GetChannel(AnimationPose::TranslationX)[1], 0.f);
+
+	clip->Destroy();
+}
+
+TEST(AnimationTest, Blend)
+{
+	using namespace sh::render;
+	AnimationPose a(6), b(6), out;
+	for (int j = 0; j < 6; ++j)
+	{
+		a.GetChannel(AnimationPose::TranslationX)[j] = 0.f;
+		b.GetChannel(AnimationPose::TranslationX)[j] = 2.f;
+		const glm::vec4 qa = animationTest::AxisAngle(0.f);
+		// 같은 회전을 반대 부호로 둬도 보간 결과가 뒤집히지 않아야 한다.
+		const glm::vec4 qb = -animationTest::AxisAngle(1.f);
+		for (int i = 0; i < 4; ++i)
+		{
+			a.GetChannel(AnimationPose::RotationX + i)[j] = qa[i];
+			b.GetChannel(AnimationPose::RotationX + i)[j] = qb[i];
+		}
+	}
+	AnimationPose::Blend(a, b, 0.5f, out);
+	ASSERT_EQ(out.GetJointCount(), 6);
+	for (int j = 0; j < 6; ++j)
+	{
+		EXPECT_FLOAT_EQ(out.GetChannel(AnimationPose::TranslationX)[j], 1.f);
+		EXPECT_GT(out.GetChannel(AnimationPose::RotationW)[j], 0.9f);
+		EXPECT_NEAR(out.GetChannel(AnimationPose::RotationZ)[j], std::sin(0.25f), 1e-3f);
+		float length = 0.f;
+		for (int i = 0; i < 4; ++i)
+			length += out.GetChannel(AnimationPose::RotationX + i)[j] * out.GetChannel(AnimationPose::RotationX + i)[j];
+		EXPECT_NEAR(length, 1.f, 1e-5f);
+	}
+
+	// 조인트 마스크
+	std::vector<float> mask(a.GetStride(), 0.f);
+	mask[5] = 1.f;
+	AnimationPose::Blend(a, b, 1.f, a, mask.data());
+	EXPECT_FLOAT_EQ(a.GetChannel(AnimationPose::TranslationX)[0], 0.f);
+	EXPECT_FLOAT_EQ(a.GetChannel(AnimationPose::TranslationX)[4], 0.f);
+	EXPECT_FLOAT_EQ(a.GetChannel(AnimationPose::TranslationX)[5], 2.f);
+}
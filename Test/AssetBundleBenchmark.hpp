@@ -0,0 +1,69 @@
+﻿#pragma once
+#include "AssetBundleTest.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <filesystem>
+#include <iostream>
+#include <algorithm>
+
+TEST(AssetBundleBenchmark, LoadThroughput)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 256;
+	constexpr std::size_t size = 64 * 1024;
+	constexpr uint32_t rounds = 4;
+	const auto path = GetBundlePath("sh_bundle_bench.bundle");
+	ASSERT_TRUE(SaveTestBundle(path, count, size));
+
+	const uint32_t threadCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+	const auto measure =
+		[&](const AssetBundle& bundle, uint32_t threads) -> double
+		{
+			std::atomic<uint64_t> bytes{ 0 };
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<std::thread> workers;
+			for (uint32_t t = 0; t < threads; ++t)
+			{
+				workers.emplace_back(
+					[&, t]()
+					{
+						uint64_t loaded = 0;
+						for (uint32_t n = t; n < count * rounds; n += threads)
+						{
+							auto asset = bundle.LoadAsset(Id(n % count));
+							if (asset != nullptr)
+								loaded += asset->GetAssetDataSize();
+						}
+						bytes.fetch_add(loaded, std::memory_order_relaxed);
+					}
+				);
+			}
+			for (std::thread& worker : workers)
+				worker.join();
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			EXPECT_GT(bytes.load(), 0);
+			return static_cast<double>(bytes.load()) / (1024.0 * 1024.0) / seconds;
+		};
+
+	AssetBundle mapped;
+	ASSERT_TRUE(mapped.LoadBundle(path));
+	AssetBundle stream;
+	ASSERT_TRUE(stream.LoadBundle(path, false));
+	mapped.Prefetch(mapped.GetAllAssetUUIDs());
+
+	const double streamSingle = measure(stream, 1);
+	const double mappedSingle = measure(mapped, 1);
+	const double streamMulti = measure(stream, threadCount);
+	const double mappedMulti = measure(mapped, threadCount);
+	std::cout << "[AssetBundle] 1 thread: fstream " << streamSingle << " MB/s, mmap " << mappedSingle << " MB/s\n";
+	std::cout << "[AssetBundle] " << threadCount << " threads: fstream " << streamMulti << " MB/s, mmap " << mappedMulti << " MB/s\n";
+
+	mapped.Clear();
+	stream.Clear();
+	std::filesystem::remove(path);
+}
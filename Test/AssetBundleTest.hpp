@@ -0,0 +1,319 @@
+﻿#pragma once
+#include "Core/Asset.h"
+#include "Core/AssetBundle.h"
+#include "Core/AssetBundleLayout.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <algorithm>
+
+/// @brief 임의의 바이트를 그대로 담는 에셋
+class BundleTestAsset : public sh::core::Asset
+{
+	SASSET(BundleTestAsset, "btst")
+public:
+	BundleTestAsset() : Asset(ASSET_NAME) {}
+	BundleTestAsset(const sh::core::UUID& uuid, std::vector<uint8_t> bytes) :
+		Asset(ASSET_NAME), bytes(std::move(bytes))
+	{
+		assetUUID = uuid;
+	}
+	void SetAsset(const sh::core::SObject& obj) override {}
+	auto GetBytes() const -> const std::vector<uint8_t>& { return data; }
+protected:
+	void SetAssetData() const override { data = bytes; }
+	auto ParseAssetData() -> bool override { return true; }
+public:
+	constexpr static const char* ASSET_NAME = "btst";
+private:
+	std::vector<uint8_t> bytes;
+};
+
+namespace bundleTest
+{
+	inline auto Id(uint32_t i) -> sh::core::UUID
+	{
+		return sh::core::UUID{ std::array<uint32_t, 4>{ i + 1, 0xb0d1e, 0, 0 } };
+	}
+	/// @brief 에셋 데이터 흉내. 반복되는 부분이 있어 압축이 된다.
+	inline auto MakeBytes(uint32_t seed, std::size_t size) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> bytes(size);
+		uint32_t state = seed * 2654435761u + 1;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (i % 64 == 0)
+				state = state * 1664525u + 1013904223u;
+			bytes[i] = static_cast<uint8_t>((state >> 24) + (i % 16));
+		}
+		return bytes;
+	}
+	inline auto SaveTestBundle(const std::filesystem::path& path, uint32_t count, std::size_t size) -> bool
+	{
+		sh::core::AssetBundle bundle;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			BundleTestAsset asset{ Id(i), MakeBytes(i, size + i * 7) };
+			if (!bundle.AddAsset(asset, i % 4 != 0))
+				return false;
+		}
+		return bundle.SaveBundle(path);
+	}
+	inline auto GetBundlePath(const char* name) -> std::filesystem::path
+	{
+		return std::filesystem::temp_directory_path() / name;
+	}
+	inline auto IsSame(const std::unique_ptr<sh::core::Asset>& asset, uint32_t i, std::size_t size) -> bool
+	{
+		if (asset == nullptr || asset->GetAssetUUID() != Id(i))
+			return false;
+		return static_cast<const BundleTestAsset&>(*asset).GetBytes() == MakeBytes(i, size + i * 7);
+	}
+}//namespace
+
+TEST(AssetBundleTest, MappedAndStream)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 64;
+	constexpr std::size_t size = 4096;
+	const auto path = GetBundlePath("sh_bundle_test.bundle");
+	ASSERT_TRUE(SaveTestBundle(path, count, size));
+
+	AssetBundle mapped;
+	ASSERT_TRUE(mapped.LoadBundle(path));
+	EXPECT_TRUE(mapped.IsMemoryMapped());
+	AssetBundle stream;
+	ASSERT_TRUE(stream.LoadBundle(path, false));
+	EXPECT_FALSE(stream.IsMemoryMapped());
+	EXPECT_TRUE(stream.IsLoaded());
+	ASSERT_EQ(mapped.GetAllAssetUUIDs().size(), count);
+
+	mapped.Prefetch(mapped.GetAllAssetUUIDs());
+	stream.Prefetch(stream.GetAllAssetUUIDs());
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		EXPECT_TRUE(IsSame(mapped.LoadAsset(Id(i)), i, size));
+		EXPECT_TRUE(IsSame(stream.LoadAsset(Id(i)), i, size));
+
+		// 뷰는 파일 안을 그대로 가리키며 스트림으로 읽은 데이터와 같다.
+		const ArrayView<const uint8_t> view = mapped.GetAssetView(Id(i));
+		std::vector<uint8_t> data;
+		ASSERT_TRUE(stream.ReadAssetData(Id(i), data));
+		ASSERT_EQ(view.size(), data.size());
+		EXPECT_TRUE(std::equal(data.begin(), data.end(), view.data()));
+		EXPECT_EQ(stream.GetAssetView(Id(i)).size(), 0);
+	}
+	EXPECT_EQ(mapped.LoadAsset(Id(count)), nullptr);
+	EXPECT_EQ(stream.LoadAsset(Id(count)), nullptr);
+
+	mapped.Clear();
+	EXPECT_FALSE(mapped.IsLoaded());
+	EXPECT_EQ(mapped.LoadAsset(Id(0)), nullptr);
+	// 다시 열 수 있다.
+	ASSERT_TRUE(mapped.LoadBundle(path));
+	EXPECT_TRUE(IsSame(mapped.LoadAsset(Id(3)), 3, size));
+
+	mapped.Clear();
+	stream.Clear();
+	std::filesystem::remove(path);
+}
+
+TEST(AssetBundleTest, TruncatedBundle)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 16;
+	constexpr std::size_t size = 1024;
+	const auto path = GetBundlePath("sh_bundle_truncated.bundle");
+	ASSERT_TRUE(SaveTestBundle(path, count, size));
+
+	const auto fullSize = std::filesystem::file_size(path);
+	std::filesystem::resize_file(path, fullSize - size);
+	{
+		// 잘린 뒷부분의 에셋들은 버려지고 나머지는 읽힌다.
+		AssetBundle bundle;
+		ASSERT_TRUE(bundle.LoadBundle(path));
+		const std::size_t loaded = bundle.GetAllAssetUUIDs().size();
+		EXPECT_LT(loaded, count);
+		EXPECT_GT(loaded, 0);
+		for (const UUID& uuid : bundle.GetAllAssetUUIDs())
+			EXPECT_NE(bundle.LoadAsset(uuid), nullptr);
+	}
+	// 목록조차 들어있지 않은 파일
+	std::filesystem::resize_file(path, 20);
+	{
+		AssetBundle bundle;
+		EXPECT_FALSE(bundle.LoadBundle(path));
+		EXPECT_FALSE(bundle.IsLoaded());
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(AssetBundleTest, ConcurrentLoad)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 128;
+	constexpr std::size_t size = 8192;
+	constexpr uint32_t threadCount = 8;
+	const auto path = GetBundlePath("sh_bundle_concurrent.bundle");
+	ASSERT_TRUE(SaveTestBundle(path, count, size));
+
+	for (bool bMapped : { true, false })
+	{
+		AssetBundle bundle;
+		ASSERT_TRUE(bundle.LoadBundle(path, bMapped));
+		std::atomic<uint32_t> failed{ 0 };
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back(
+				[&, t]()
+				{
+					for (uint32_t n = 0; n < count; ++n)
+					{
+						const uint32_t i = (n + t * 17) % count;
+						if (!IsSame(bundle.LoadAsset(Id(i)), i, size))
+							failed.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			);
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		EXPECT_EQ(failed.load(), 0) << (bMapped ? "mapped" : "stream");
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(AssetBundleTest, LayoutOrder)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	// 0 -> 1, 2 / 1 -> 3 / 2 -> 3, 4 / 5 -> 4, 6
+	AssetBundleLayout layout;
+	layout.AddDependencies(Id(0), { Id(1), Id(2) });
+	layout.AddDependencies(Id(1), { Id(3) });
+	layout.AddDependencies(Id(2), { Id(3), Id(4) });
+	layout.AddDependencies(Id(5), { Id(4), Id(6) });
+	layout.AddRoot(Id(7));
+	layout.AddRoot(Id(0));
+	layout.AddRoot(Id(5));
+	layout.AddRoot(Id(0));
+
+	// 루트 순서대로, 루트 안에서는 로더가 요청하는 순서(너비 우선)로 나열된다. 공유된 4는 먼저 도달한 0 쪽에 있다.
+	const std::vector<UUID> expected{ Id(7), Id(0), Id(1), Id(2), Id(3), Id(4), Id(5), Id(6) };
+	EXPECT_EQ(layout.Build(), expected);
+}
+
+TEST(AssetBundleTest, SortedTOC)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 40;
+	constexpr std::size_t size = 512;
+	const auto path = GetBundlePath("sh_bundle_toc.bundle");
+	{
+		AssetBundle bundle;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			BundleTestAsset asset{ Id(i), MakeBytes(i, size + i * 7) };
+			ASSERT_TRUE(bundle.AddAsset(asset, true));
+		}
+		// 뒤에서부터 섞어서 지정한 순서대로 데이터가 놓여야 한다.
+		std::vector<UUID> order;
+		for (uint32_t i = count; i > 0; i -= 2)
+			order.push_back(Id(i - 1));
+		order.push_back(Id(count + 5)); // 번들에 없는 UUID
+		bundle.SetLayoutOrder(order);
+		ASSERT_TRUE(bundle.SaveBundle(path));
+	}
+	for (bool bMapped : { true, false })
+	{
+		AssetBundle bundle;
+		ASSERT_TRUE(bundle.LoadBundle(path, bMapped));
+		const auto entries = bundle.GetAssetEntries();
+		ASSERT_EQ(entries.size(), count);
+		for (std::size_t i = 1; i < entries.size(); ++i)
+			EXPECT_LT(entries[i - 1].uuid, entries[i].uuid);
+
+		const auto offsetOf =
+			[&](uint32_t i)
+			{
+				for (const auto& entry : bundle.GetAssetEntries())
+				{
+					if (UUID{ entry.uuid } == Id(i))
+						return entry.dataOffset;
+				}
+				return ~uint64_t{ 0 };
+			};
+		// 지정한 에셋들이 앞에서부터 빈틈없이 이어지고, 나머지는 추가된 순서대로 뒤에 온다.
+		uint64_t expectedOffset = 0;
+		for (uint32_t i = count; i > 0; i -= 2)
+		{
+			EXPECT_EQ(offsetOf(i - 1), expectedOffset);
+			std::vector<uint8_t> data;
+			ASSERT_TRUE(bundle.ReadAssetData(Id(i - 1), data));
+			expectedOffset += data.size();
+		}
+		uint64_t last = 0;
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			EXPECT_GE(offsetOf(i), expectedOffset);
+			EXPECT_GE(offsetOf(i), last);
+			last = offsetOf(i);
+		}
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			EXPECT_TRUE(bundle.HasAsset(Id(i)));
+			EXPECT_TRUE(IsSame(bundle.LoadAsset(Id(i)), i, size));
+		}
+		EXPECT_FALSE(bundle.HasAsset(Id(count)));
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(AssetBundleTest, UnsortedTOC)
+{
+	using namespace sh::core;
+	using namespace bundleTest;
+	constexpr uint32_t count = 10;
+	constexpr std::size_t size = 256;
+	const auto path = GetBundlePath("sh_bundle_unsorted.bundle");
+	ASSERT_TRUE(SaveTestBundle(path, count, size));
+
+	// 목록을 뒤집어 정렬되지 않은 이전 버전의 번들을 만든다.
+	std::vector<uint8_t> file;
+	{
+		std::ifstream in{ path, std::ios::binary };
+		file.assign(std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{});
+	}
+	constexpr std::size_t headerSize = 8;
+	constexpr std::size_t entrySize = 48;
+	file[0] = 1;
+	for (std::size_t i = 0; i < count / 2; ++i)
+	{
+		std::swap_ranges(file.begin() + headerSize + i * entrySize, file.begin() + headerSize + (i + 1) * entrySize,
+			file.begin() + headerSize + (count - 1 - i) * entrySize);
+	}
+	{
+		std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+		out.write(reinterpret_cast<const char*>(file.data()), file.size());
+	}
+	for (bool bMapped : { true, false })
+	{
+		AssetBundle bundle;
+		ASSERT_TRUE(bundle.LoadBundle(path, bMapped));
+		EXPECT_EQ(bundle.GetVersion(), 1);
+		for (uint32_t i = 0; i < count; ++i)
+			EXPECT_TRUE(IsSame(bundle.LoadAsset(Id(i)), i, size));
+	}
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,339 @@
+﻿#pragma once
+#include "Core/SObject.h"
+#include "Core/Asset.h"
+#include "Core/Reflection.hpp"
+#include "Core/GarbageCollection.h"
+#include "Core/SContainer.hpp"
+#include "Core/SObjectManager.h"
+#include "Core/AssetResolver.h"
+#include "Core/ThreadPool.h"
+#include "Core/IAssetLoader.h"
+#include "Game/AssetLoaderFactory.h"
+#include "Game/AsyncAssetLoader.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+class AsyncLoadedObject : public sh::core::SObject
+{
+	SCLASS(AsyncLoadedObject)
+public:
+	PROPERTY(refs)
+	std::vector<AsyncLoadedObject*> refs;
+};
+
+/// @brief 다른 에셋의 UUID를 가지고 있는 json 에셋
+class AsyncTestAsset : public sh::core::Asset
+{
+	SASSET(AsyncTestAsset, "atst")
+public:
+	AsyncTestAsset() : Asset(ASSET_NAME) {}
+	AsyncTestAsset(const sh::core::UUID& uuid, const sh::core::Json& json) :
+		Asset(ASSET_NAME), json(json)
+	{
+		assetUUID = uuid;
+	}
+	void SetAsset(const sh::core::SObject& obj) override {}
+	auto GetDependencies() const -> std::vector<sh::core::UUID> override { return CollectUUIDs(json); }
+protected:
+	void SetAssetData() const override {}
+	auto ParseAssetData() -> bool override { return true; }
+public:
+	constexpr static const char* ASSET_NAME = "atst";
+
+	sh::core::Json json;
+};
+
+namespace asyncLoaderTest
+{
+	/// @brief 통합 순서를 기록하고 참조하는 에셋을 리졸버로 찾는 로더
+	class TestLoader : public sh::core::IAssetLoader
+	{
+	public:
+		auto Load(const std::filesystem::path& filePath) const -> sh::core::SObject* override { return nullptr; }
+		auto Load(const sh::core::Asset& asset) const -> sh::core::SObject* override
+		{
+			using namespace sh;
+			const auto& testAsset = static_cast<const AsyncTestAsset&>(asset);
+			auto obj = core::SObject::Create<AsyncLoadedObject>();
+			obj->SetUUID(asset.GetAssetUUID());
+			order.push_back(asset.GetAssetUUID().ToString());
+			for (const auto& ref : testAsset.json["refs"])
+			{
+				// 먼저 통합됐다면 리졸버를 거치지 않는다.
+				const core::UUID uuid{ ref.get_ref<const std::string&>() };
+				if (core::SObjectManager::GetInstance()->GetSObject(uuid) == nullptr)
+					++resolverCalls;
+				obj->refs.push_back(static_cast<AsyncLoadedObject*>(core::SObject::GetSObjectUsingResolver(uuid)));
+			}
+			return obj;
+		}
+		auto GetAssetName() const -> const char* override { return AsyncTestAsset::ASSET_NAME; }
+	public:
+		mutable std::vector<std::string> order;
+		mutable int resolverCalls = 0;
+	};
+
+	/// @brief 에셋 번들 흉내. 읽을 때 마다 잠깐 멈춘다.
+	class TestSource
+	{
+	public:
+		void Add(const std::string& uuid, const std::vector<std::string>& refs)
+		{
+			sh::core::Json json{};
+			json["refs"] = refs;
+			// 에셋이 아닌 오브젝트의 UUID
+			json["objs"].push_back(sh::core::UUID::Generate().ToString());
+			assets.insert({ sh::core::UUID{ uuid }, json });
+		}
+		auto MakeLoader() -> std::unique_ptr<sh::game::AsyncAssetLoader>
+		{
+			using namespace sh;
+			return std::make_unique<game::AsyncAssetLoader>(
+				[this](const core::UUID& uuid) -> std::unique_ptr<core::Asset>
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+					auto it = assets.find(uuid);
+					if (it == assets.end())
+						return nullptr;
+					{
+						std::lock_guard<std::mutex> lock{ mu };
+						++loadCounts[uuid.ToString()];
+					}
+					return std::make_unique<AsyncTestAsset>(uuid, it->second);
+				},
+				[this](const core::UUID& uuid) { return assets.find(uuid) != assets.end(); }
+			);
+		}
+	public:
+		std::unordered_map<sh::core::UUID, sh::core::Json> assets;
+		std::unordered_map<std::string, int> loadCounts;
+		std::mutex mu;
+	};
+
+	inline auto Id(char c) -> std::string
+	{
+		return std::string(31, 'a') + c;
+	}
+	inline auto IndexOf(const std::vector<std::string>& order, const std::string& uuid) -> std::ptrdiff_t
+	{
+		return std::find(order.begin(), order.end(), uuid) - order.begin();
+	}
+	/// @brief 테스트마다 새 로더를 팩토리와 리졸버에 연결한다.
+	inline auto Connect(TestSource& source, std::unique_ptr<sh::game::AsyncAssetLoader>& assetLoader) -> TestLoader*
+	{
+		using namespace sh;
+		if (!core::ThreadPool::GetInstance()->IsInit())
+			core::ThreadPool::GetInstance()->Init(4);
+		// 팩토리는 이미 등록된 로더를 바꾸지 않으므로 처음 등록한 것을 비워서 쓴다.
+		auto factory = game::AssetLoaderFactory::GetInstance();
+		if (factory->GetLoader(AsyncTestAsset::ASSET_NAME) == nullptr)
+			factory->RegisterLoader(AsyncTestAsset::ASSET_NAME, std::make_unique<TestLoader>());
+		auto loaderPtr = static_cast<TestLoader*>(factory->GetLoader(AsyncTestAsset::ASSET_NAME));
+		loaderPtr->order.clear();
+		loaderPtr->resolverCalls = 0;
+		assetLoader = source.MakeLoader();
+		core::AssetResolverRegistry::SetResolver(
+			[loader = assetLoader.get()](const core::UUID& uuid) { return loader->Resolve(uuid); });
+		return loaderPtr;
+	}
+	inline void Disconnect(std::unique_ptr<sh::game::AsyncAssetLoader>& assetLoader)
+	{
+		sh::core::AssetResolverRegistry::SetResolver(nullptr);
+		assetLoader.reset();
+		auto gc = sh::core::GarbageCollection::GetInstance();
+		gc->Collect();
+		gc->DestroyPendingKillObjs();
+	}
+}//namespace
+
+TEST(AsyncAssetLoaderTest, DependenciesIntegrateFirst)
+{
+	using namespace sh;
+	using namespace asyncLoaderTest;
+	using Clock = std::chrono::steady_clock;
+	// A -> B, C / B -> D / C -> D, E
+	TestSource source{};
+	source.Add(Id('a'), { Id('b'), Id('c') });
+	source.Add(Id('b'), { Id('d') });
+	source.Add(Id('c'), { Id('d'), Id('e') });
+	source.Add(Id('d'), {});
+	source.Add(Id('e'), {});
+	std::unique_ptr<game::AsyncAssetLoader> assetLoader;
+	TestLoader* loader = Connect(source, assetLoader);
+	{
+		game::AsyncAssetLoader::Handle handle = assetLoader->Load(core::UUID{ Id('a') });
+		EXPECT_EQ(handle.GetState(), game::AsyncAssetLoader::State::Loading);
+		EXPECT_EQ(handle.Get(), nullptr);
+
+		const auto deadline = Clock::now() + std::chrono::seconds{ 5 };
+		while (!handle.IsDone() && Clock::now() < deadline)
+		{
+			assetLoader->Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		ASSERT_EQ(handle.GetState(), game::AsyncAssetLoader::State::Ready);
+		auto a = static_cast<AsyncLoadedObject*>(handle.Get());
+		ASSERT_NE(a, nullptr);
+		EXPECT_EQ(a->GetUUID(), core::UUID{ Id('a') });
+		ASSERT_EQ(a->refs.size(), 2);
+		EXPECT_NE(a->refs[0], nullptr);
+		EXPECT_NE(a->refs[1], nullptr);
+		EXPECT_EQ(assetLoader->GetPendingCount(), 0);
+
+		// 의존하는 에셋이 먼저 통합되므로 리졸버로 동기 로드되는 일이 없다.
+		const auto& order = loader->order;
+		ASSERT_EQ(order.size(), 5);
+		EXPECT_LT(IndexOf(order, Id('d')), IndexOf(order, Id('b')));
+		EXPECT_LT(IndexOf(order, Id('d')), IndexOf(order, Id('c')));
+		EXPECT_LT(IndexOf(order, Id('e')), IndexOf(order, Id('c')));
+		EXPECT_LT(IndexOf(order, Id('b')), IndexOf(order, Id('a')));
+		EXPECT_LT(IndexOf(order, Id('c')), IndexOf(order, Id('a')));
+		EXPECT_EQ(loader->resolverCalls, 0);
+		for (const auto& [uuid, count] : source.loadCounts)
+			EXPECT_EQ(count, 1) << uuid;
+
+		// 이미 불러온 에셋은 바로 준비된 핸들이 나온다.
+		EXPECT_EQ(assetLoader->Load(core::UUID{ Id('d') }).GetState(), game::AsyncAssetLoader::State::Ready);
+	}
+	Disconnect(assetLoader);
+}
+
+TEST(AsyncAssetLoaderTest, WaitAndResolve)
+{
+	using namespace sh;
+	using namespace asyncLoaderTest;
+	// 순환 참조 X <-> Y 와 의존성 체인 P -> Q -> R
+	TestSource source{};
+	source.Add(Id('1'), { Id('2') });
+	source.Add(Id('2'), { Id('1') });
+	source.Add(Id('3'), { Id('4') });
+	source.Add(Id('4'), { Id('5') });
+	source.Add(Id('5'), {});
+	std::unique_ptr<game::AsyncAssetLoader> assetLoader;
+	TestLoader* loader = Connect(source, assetLoader);
+	{
+		game::AsyncAssetLoader::Handle handle = assetLoader->Load(core::UUID{ Id('1') });
+		assetLoader->Wait(handle);
+		ASSERT_EQ(handle.GetState(), game::AsyncAssetLoader::State::Ready);
+		auto x = static_cast<AsyncLoadedObject*>(handle.Get());
+		ASSERT_EQ(x->refs.size(), 1);
+		ASSERT_NE(x->refs[0], nullptr);
+		auto y = x->refs[0];
+		ASSERT_EQ(y->refs.size(), 1);
+		EXPECT_EQ(y->refs[0], x);
+
+		// 요청하지 않은 에셋은 지금 읽고, 그 동안 의존하는 에셋들은 워커 스레드에서 읽힌다.
+		auto p = static_cast<AsyncLoadedObject*>(assetLoader->Resolve(core::UUID{ Id('3') }));
+		ASSERT_NE(p, nullptr);
+		ASSERT_EQ(p->refs.size(), 1);
+		ASSERT_NE(p->refs[0], nullptr);
+		ASSERT_EQ(p->refs[0]->refs.size(), 1);
+		EXPECT_NE(p->refs[0]->refs[0], nullptr);
+		EXPECT_EQ(loader->order.size(), 5);
+
+		// 없는 에셋
+		EXPECT_EQ(assetLoader->Resolve(core::UUID{ Id('6') }), nullptr);
+		game::AsyncAssetLoader::Handle missing = assetLoader->Load(core::UUID{ Id('6') });
+		assetLoader->Wait(missing);
+		EXPECT_EQ(missing.GetState(), game::AsyncAssetLoader::State::Failed);
+
+		for (const auto& [uuid, count] : source.loadCounts)
+			EXPECT_EQ(count, 1) << uuid;
+	}
+	Disconnect(assetLoader);
+}
+
+TEST(AsyncAssetLoaderTest, BudgetAndRelease)
+{
+	using namespace sh;
+	using namespace asyncLoaderTest;
+	using Clock = std::chrono::steady_clock;
+	constexpr int count = 20;
+	TestSource source{};
+	std::vector<std::string> refs;
+	for (int i = 0; i < count; ++i)
+	{
+		std::string uuid = core::UUID::Generate().ToString();
+		source.Add(uuid, {});
+		refs.push_back(std::move(uuid));
+	}
+	const std::string rootUUID = Id('7');
+	source.Add(rootUUID, refs);
+	std::unique_ptr<game::AsyncAssetLoader> assetLoader;
+	TestLoader* loader = Connect(source, assetLoader);
+
+	game::AsyncAssetLoader::Settings settings{};
+	settings.integrationBudgetMs = 0.f;
+	settings.maxConcurrentLoads = 4;
+	assetLoader->SetSettings(settings);
+
+	auto gc = core::GarbageCollection::GetInstance();
+	core::SObjWeakPtr<core::SObject> root;
+	{
+		game::AsyncAssetLoader::Handle handle = assetLoader->Load(core::UUID{ rootUUID });
+		const auto deadline = Clock::now() + std::chrono::seconds{ 5 };
+		while (!handle.IsDone() && Clock::now() < deadline)
+		{
+			const std::size_t before = loader->order.size();
+			assetLoader->Update();
+			// 예산이 없으면 프레임당 하나씩만 통합한다.
+			EXPECT_LE(loader->order.size(), before + 1);
+			// 핸들이 살아있는 동안에는 통합된 에셋이 수집되지 않는다.
+			gc->Collect();
+			gc->DestroyPendingKillObjs();
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		ASSERT_EQ(handle.GetState(), game::AsyncAssetLoader::State::Ready);
+		auto rootObj = static_cast<AsyncLoadedObject*>(handle.Get());
+		ASSERT_EQ(rootObj->refs.size(), count);
+		for (auto ref : rootObj->refs)
+			EXPECT_TRUE(core::IsValid(ref));
+		EXPECT_EQ(loader->resolverCalls, 0);
+		root = rootObj;
+	}
+	// 핸들이 없어지면 로더는 더 이상 에셋을 붙잡지 않는다.
+	assetLoader->Update();
+	gc->Collect();
+	gc->DestroyPendingKillObjs();
+	EXPECT_FALSE(root.IsValid());
+	Disconnect(assetLoader);
+}
+
+TEST(AsyncAssetLoaderTest, ReleaseCycle)
+{
+	using namespace sh;
+	using namespace asyncLoaderTest;
+	TestSource source{};
+	source.Add(Id('8'), { Id('9') });
+	source.Add(Id('9'), { Id('8') });
+	std::unique_ptr<game::AsyncAssetLoader> assetLoader;
+	Connect(source, assetLoader);
+
+	auto gc = core::GarbageCollection::GetInstance();
+	core::SObjWeakPtr<core::SObject> x;
+	core::SObjWeakPtr<core::SObject> y;
+	{
+		game::AsyncAssetLoader::Handle handle = assetLoader->Load(core::UUID{ Id('8') });
+		assetLoader->Wait(handle);
+		ASSERT_EQ(handle.GetState(), game::AsyncAssetLoader::State::Ready);
+		auto xObj = static_cast<AsyncLoadedObject*>(handle.Get());
+		ASSERT_EQ(xObj->refs.size(), 1);
+		x = xObj;
+		y = xObj->refs[0];
+		ASSERT_TRUE(y.IsValid());
+	}
+	// 서로 의존하는 에셋도 핸들이 없어지면 로더에서 풀려나 수집된다.
+	assetLoader->Update();
+	gc->Collect();
+	gc->DestroyPendingKillObjs();
+	EXPECT_FALSE(x.IsValid());
+	EXPECT_FALSE(y.IsValid());
+	Disconnect(assetLoader);
+}
@@ -0,0 +1,156 @@
+﻿#pragma once
+#include "Physics/PhysWorld.h"
+#include "Physics/ContactBuffer.h"
+#include "Core/ThreadPool.h"
+
+#include "reactphysics3d/reactphysics3d.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace contactBufferTest
+{
+	inline void InitThreadPool()
+	{
+		auto threadPool = sh::core::ThreadPool::GetInstance();
+		if (!threadPool->IsInit())
+			threadPool->Init(4);
+	}
+	inline auto CreateSphere(reactphysics3d::PhysicsCommon& ctx, reactphysics3d::PhysicsWorld& world, const reactphysics3d::Vector3& pos, reactphysics3d::BodyType type) -> reactphysics3d::RigidBody*
+	{
+		auto body = world.createRigidBody(reactphysics3d::Transform{ pos, reactphysics3d::Quaternion::identity() });
+		body->setType(type);
+		body->enableGravity(false);
+		body->addCollider(ctx.createSphereShape(1.f), reactphysics3d::Transform::identity());
+		return body;
+	}
+}//namespace
+
+TEST(ContactBufferTest, Append)
+{
+	using namespace sh::phys;
+	ContactBuffer stepBuffer;
+	stepBuffer.AddPair(ContactBuffer::PairType::CollisionEnter, 0, 1, 2, 3);
+	stepBuffer.AddContact({ 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, 0.1f);
+	stepBuffer.AddContact({ 2.f, 0.f, 0.f }, { -2.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, 0.2f);
+
+	ContactBuffer buffer;
+	buffer.AddPair(ContactBuffer::PairType::TriggerEnter, 4, 5, 6, 7);
+	buffer.AddPair(ContactBuffer::PairType::CollisionStay, 8, 9, 10, 11);
+	buffer.AddContact({ 3.f, 0.f, 0.f }, { -3.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, 0.3f);
+	buffer.Append(stepBuffer);
+
+	ASSERT_EQ(buffer.GetPairCount(), 3u);
+	ASSERT_EQ(buffer.GetContactCount(), 3u);
+	EXPECT_EQ(buffer.GetTypes()[2], ContactBuffer::PairType::CollisionEnter);
+	EXPECT_EQ(buffer.GetBody2Idxs()[2], 1u);
+	EXPECT_EQ(buffer.GetContactBegins()[2], 1u);
+	EXPECT_EQ(buffer.GetContactCounts()[2], 2u);
+	auto depths = buffer.GetPenetrationDepths(buffer.GetContactBegins()[2], buffer.GetContactCounts()[2]);
+	EXPECT_FLOAT_EQ(depths[1], 0.2f);
+	EXPECT_FLOAT_EQ(buffer.GetContactPoint(2).localPointOnCollider1.x, 2.f);
+
+	const uint64_t generation = buffer.GetGeneration();
+	buffer.Clear();
+	EXPECT_NE(buffer.GetGeneration(), generation);
+	EXPECT_EQ(buffer.GetPairCount(), 0u);
+}
+
+TEST(ContactBufferTest, AsyncStepKeepsOrder)
+{
+	using namespace sh;
+	using phys::ContactBuffer;
+	contactBufferTest::InitThreadPool();
+
+	phys::PhysWorld physWorld;
+	physWorld.SetAsyncStep(true);
+	auto ctx = reinterpret_cast<reactphysics3d::PhysicsCommon*>(physWorld.GetContext());
+	auto world = reinterpret_cast<reactphysics3d::PhysicsWorld*>(physWorld.GetNative());
+
+	int userData[4]{};
+	// 겹쳐 있는 두 구
+	auto ground = contactBufferTest::CreateSphere(*ctx, *world, { 0.f, 0.f, 0.f }, reactphysics3d::BodyType::STATIC);
+	auto ball = contactBufferTest::CreateSphere(*ctx, *world, { 0.f, 1.5f, 0.f }, reactphysics3d::BodyType::DYNAMIC);
+	const uint32_t groundIdx = physWorld.RegisterBody(ground, &userData[0]);
+	const uint32_t ballIdx = physWorld.RegisterBody(ball, &userData[1]);
+	const uint32_t groundColliderIdx = physWorld.RegisterCollider(ground->getCollider(0), &userData[2]);
+	const uint32_t ballColliderIdx = physWorld.RegisterCollider(ball->getCollider(0), &userData[3]);
+
+	// 스텝 도중에는 게임 쪽 버퍼가 바뀌지 않는다.
+	physWorld.BeginStep(0.0166f);
+	EXPECT_EQ(physWorld.GetContacts().GetPairCount(), 0u);
+	physWorld.EndStep();
+
+	const ContactBuffer& contacts = physWorld.GetContacts();
+	ASSERT_GE(contacts.GetPairCount(), 1u);
+	EXPECT_EQ(contacts.GetTypes()[0], ContactBuffer::PairType::CollisionEnter);
+	const uint32_t firstBody1 = contacts.GetBody1Idxs()[0];
+	const uint32_t firstBody2 = contacts.GetBody2Idxs()[0];
+	EXPECT_TRUE((firstBody1 == groundIdx && firstBody2 == ballIdx) || (firstBody1 == ballIdx && firstBody2 == groundIdx));
+	EXPECT_TRUE(contacts.GetCollider1Idxs()[0] == groundColliderIdx || contacts.GetCollider1Idxs()[0] == ballColliderIdx);
+	EXPECT_EQ(physWorld.GetBodyUserData(firstBody1), firstBody1 == groundIdx ? &userData[0] : &userData[1]);
+	const uint32_t firstPairCount = contacts.GetPairCount();
+	const uint64_t generation = contacts.GetGeneration();
+
+	// 처리하지 않은 쌍이 남아 있으면 다음 스텝의 쌍은 그 뒤에 이어 붙는다.
+	physWorld.BeginStep(0.0166f);
+	physWorld.EndStep();
+	ASSERT_GT(contacts.GetPairCount(), firstPairCount);
+	EXPECT_EQ(contacts.GetGeneration(), generation);
+	EXPECT_EQ(contacts.GetTypes()[0], ContactBuffer::PairType::CollisionEnter);
+	EXPECT_EQ(contacts.GetBody1Idxs()[0], firstBody1);
+	EXPECT_EQ(contacts.GetBody2Idxs()[0], firstBody2);
+	EXPECT_NE(contacts.GetTypes()[firstPairCount], ContactBuffer::PairType::CollisionEnter);
+
+	physWorld.ClearContacts();
+	EXPECT_EQ(contacts.GetPairCount(), 0u);
+	EXPECT_NE(contacts.GetGeneration(), generation);
+}
+
+TEST(ContactBufferTest, RecycleIndexAfterBuffersCleared)
+{
+	using namespace sh;
+	contactBufferTest::InitThreadPool();
+
+	phys::PhysWorld physWorld;
+	physWorld.SetAsyncStep(true);
+	auto ctx = reinterpret_cast<reactphysics3d::PhysicsCommon*>(physWorld.GetContext());
+	auto world = reinterpret_cast<reactphysics3d::PhysicsWorld*>(physWorld.GetNative());
+
+	std::vector<reactphysics3d::RigidBody*> bodies;
+	for (int i = 0; i < 5; ++i)
+		bodies.push_back(contactBufferTest::CreateSphere(*ctx, *world, { 10.f * i, 0.f, 0.f }, reactphysics3d::BodyType::DYNAMIC));
+
+	int userData[5]{};
+	EXPECT_EQ(physWorld.RegisterBody(bodies[0], &userData[0]), 0u);
+	EXPECT_EQ(physWorld.RegisterBody(bodies[1], &userData[1]), 1u);
+
+	// 스텝이 없을 때 해제된 인덱스는 게임 쪽 버퍼만 비우면 재사용된다.
+	physWorld.UnregisterBody(1);
+	EXPECT_EQ(physWorld.GetBodyUserData(1), nullptr);
+	physWorld.ClearContacts();
+	EXPECT_EQ(physWorld.RegisterBody(bodies[1], &userData[1]), 1u);
+
+	// 스텝 도중에 해제된 인덱스는 그 스텝의 버퍼에 남아 있을 수 있다.
+	physWorld.BeginStep(0.0166f);
+	physWorld.UnregisterBody(0);
+	EXPECT_EQ(physWorld.GetBodyUserData(0), nullptr);
+	physWorld.ClearContacts();
+	// 스텝을 끝내도 게임 쪽 버퍼에 옮겨졌을 수 있으므로 아직 재사용하지 않는다.
+	physWorld.EndStep();
+	EXPECT_EQ(physWorld.RegisterBody(bodies[2], &userData[2]), 2u);
+	EXPECT_EQ(physWorld.GetBodyUserData(2), &userData[2]);
+	// 게임 쪽 버퍼까지 비워진 뒤에 재사용된다.
+	physWorld.ClearContacts();
+	EXPECT_EQ(physWorld.RegisterBody(bodies[3], &userData[3]), 0u);
+	EXPECT_EQ(physWorld.GetBodyUserData(0), &userData[3]);
+
+	// 충돌체도 같은 규칙을 따른다.
+	const uint32_t colliderIdx = physWorld.RegisterCollider(bodies[4]->getCollider(0), &userData[4]);
+	physWorld.BeginStep(0.0166f);
+	physWorld.UnregisterCollider(colliderIdx);
+	physWorld.EndStep();
+	EXPECT_NE(physWorld.RegisterCollider(bodies[3]->getCollider(0), &userData[3]), colliderIdx);
+	physWorld.ClearContacts();
+	EXPECT_EQ(physWorld.RegisterCollider(bodies[2]->getCollider(0), &userData[2]), colliderIdx);
+}
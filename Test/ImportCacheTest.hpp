@@ -0,0 +1,161 @@
+﻿#pragma once
+#include "AssetBundleTest.hpp"
+
+#include "Core/ImportCache.h"
+#include "Core/AssetExporter.h"
+#include "Core/FileSystem.h"
+#include "Core/Util.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace importCacheTest
+{
+	inline auto Hash(const char* str, uint64_t seed = 0) -> uint64_t
+	{
+		return sh::core::Util::Hash64(str, std::strlen(str), seed);
+	}
+	inline auto MakeCachePath(const char* name) -> std::filesystem::path
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+		std::error_code ec;
+		std::filesystem::remove_all(path, ec);
+		return path;
+	}
+	inline auto Meta(const char* str) -> std::vector<uint8_t>
+	{
+		return std::vector<uint8_t>(str, str + std::strlen(str));
+	}
+}//namespace
+
+TEST(HashTest, XXH64Vectors)
+{
+	using importCacheTest::Hash;
+	// 공개된 XXH64 구현과 같은 값이어야 한다.
+	EXPECT_EQ(Hash(""), 0xef46db3751d8e999ull);
+	EXPECT_EQ(sh::core::Util::Hash64(nullptr, 0), 0xef46db3751d8e999ull);
+	EXPECT_EQ(Hash("", 2654435761ull), 0xac75fda2929b17efull);
+	EXPECT_EQ(Hash("a"), 0xd24ec4f1a98c6e5bull);
+	EXPECT_EQ(Hash("abc"), 0x44bc2cf5ad770999ull);
+	EXPECT_EQ(Hash("xxhash"), 0x32dd38952c4bc720ull);
+	EXPECT_EQ(Hash("xxhash", 20141025), 0xb559b98d844e0635ull);
+	// 32바이트 이상은 4개 누산기를 쓰는 경로를 탄다.
+	EXPECT_EQ(Hash("Nobody inspects the spammish repetition"), 0xfbcea83c8a378bf1ull);
+	EXPECT_EQ(Hash("Nobody inspects the spammish repetition", 20141025), 0xce06936136852706ull);
+
+	std::vector<uint8_t> bytes(101);
+	for (std::size_t i = 0; i < bytes.size(); ++i)
+		bytes[i] = static_cast<uint8_t>(i);
+	EXPECT_EQ(sh::core::Util::Hash64(bytes.data(), bytes.size()), 0xe99038495f85381eull);
+}
+
+TEST(ImportCacheTest, RoundTrip)
+{
+	using namespace sh::core;
+	ImportCache cache;
+	cache.SetPath(importCacheTest::MakeCachePath("sh_import_cache_roundtrip"));
+	ASSERT_TRUE(std::filesystem::exists(cache.GetPath()));
+
+	const std::vector<uint8_t> meta = importCacheTest::Meta("{\"uuid\":\"0\"}");
+	const uint64_t key = ImportCache::MakeKey(0x1234, meta.data(), meta.size(), 1);
+	EXPECT_EQ(cache.Load(key), nullptr);
+
+	BundleTestAsset asset{ bundleTest::Id(0), bundleTest::MakeBytes(0, 1000) };
+	const std::vector<uint8_t> blob = AssetExporter::SaveToMemory(asset, true);
+	ASSERT_TRUE(cache.Store(key, blob));
+
+	auto blobOpt = cache.LoadBlob(key);
+	ASSERT_TRUE(blobOpt.has_value());
+	EXPECT_EQ(blobOpt.value(), blob);
+	EXPECT_TRUE(bundleTest::IsSame(cache.Load(key), 0, 1000));
+
+	// Library에 Asset 파일이 없을 때 캐시에서 되살린다.
+	const std::filesystem::path restored = cache.GetPath() / "restored.asset";
+	ASSERT_TRUE(cache.Restore(key, restored));
+	EXPECT_EQ(FileSystem::LoadBinary(restored).value(), blob);
+
+	// 디스크의 Asset 파일로 저장해도 같다.
+	const std::vector<uint8_t> meta2 = importCacheTest::Meta("{\"uuid\":\"1\"}");
+	const uint64_t key2 = ImportCache::MakeKey(0x1234, meta2.data(), meta2.size(), 1);
+	ASSERT_TRUE(cache.StoreFile(key2, restored));
+	EXPECT_EQ(cache.LoadBlob(key2).value(), blob);
+
+	std::filesystem::remove_all(cache.GetPath());
+}
+
+TEST(ImportCacheTest, Invalidation)
+{
+	using namespace sh::core;
+	ImportCache cache;
+	cache.SetPath(importCacheTest::MakeCachePath("sh_import_cache_invalidation"));
+
+	const std::vector<uint8_t> meta = importCacheTest::Meta("{\"bQuantize\":false}");
+	const std::vector<uint8_t> otherMeta = importCacheTest::Meta("{\"bQuantize\":true}");
+	const uint64_t key = ImportCache::MakeKey(0x1234, meta.data(), meta.size(), 1);
+	EXPECT_EQ(key, ImportCache::MakeKey(0x1234, meta.data(), meta.size(), 1));
+
+	// 원본, 임포트 설정, 임포터 버전 중 하나라도 바뀌면 다른 키가 된다.
+	const uint64_t sourceChanged = ImportCache::MakeKey(0x1235, meta.data(), meta.size(), 1);
+	const uint64_t metaChanged = ImportCache::MakeKey(0x1234, otherMeta.data(), otherMeta.size(), 1);
+	const uint64_t importerChanged = ImportCache::MakeKey(0x1234, meta.data(), meta.size(), 2);
+	EXPECT_NE(key, sourceChanged);
+	EXPECT_NE(key, metaChanged);
+	EXPECT_NE(key, importerChanged);
+
+	BundleTestAsset asset{ bundleTest::Id(1), bundleTest::MakeBytes(1, 200 + 7) };
+	ASSERT_TRUE(cache.Store(key, AssetExporter::SaveToMemory(asset, false)));
+	EXPECT_TRUE(bundleTest::IsSame(cache.Load(key), 1, 200));
+	EXPECT_EQ(cache.Load(sourceChanged), nullptr);
+	EXPECT_EQ(cache.Load(metaChanged), nullptr);
+	EXPECT_EQ(cache.Load(importerChanged), nullptr);
+
+	std::filesystem::remove_all(cache.GetPath());
+}
+
+TEST(ImportCacheTest, RejectCorruptFile)
+{
+	using namespace sh::core;
+	ImportCache cache;
+	cache.SetPath(importCacheTest::MakeCachePath("sh_import_cache_corrupt"));
+
+	const std::vector<uint8_t> meta = importCacheTest::Meta("{}");
+	const uint64_t key = ImportCache::MakeKey(0x1234, meta.data(), meta.size(), 1);
+	BundleTestAsset asset{ bundleTest::Id(2), bundleTest::MakeBytes(2, 500) };
+	const std::vector<uint8_t> blob = AssetExporter::SaveToMemory(asset, false);
+
+	// 내용 한 바이트가 바뀜
+	ASSERT_TRUE(cache.Store(key, blob));
+	std::vector<uint8_t> file = FileSystem::LoadBinary(cache.GetFile(key)).value();
+	file[file.size() - 10] ^= 0xff;
+	ASSERT_TRUE(FileSystem::SaveBinary(file, cache.GetFile(key)));
+	EXPECT_EQ(cache.Load(key), nullptr);
+	// 손상된 파일은 지워진다.
+	EXPECT_FALSE(std::filesystem::exists(cache.GetFile(key)));
+
+	// 잘린 파일
+	ASSERT_TRUE(cache.Store(key, blob));
+	file = FileSystem::LoadBinary(cache.GetFile(key)).value();
+	file.resize(file.size() / 2);
+	ASSERT_TRUE(FileSystem::SaveBinary(file, cache.GetFile(key)));
+	EXPECT_FALSE(cache.LoadBlob(key).has_value());
+
+	// 헤더보다 작은 파일
+	ASSERT_TRUE(FileSystem::SaveBinary(std::vector<uint8_t>{ 1, 2, 3 }, cache.GetFile(key)));
+	EXPECT_FALSE(cache.LoadBlob(key).has_value());
+
+	// 다른 키의 파일(이름만 바뀐 경우)
+	const uint64_t otherKey = key + 1;
+	ASSERT_TRUE(cache.Store(otherKey, blob));
+	std::filesystem::rename(cache.GetFile(otherKey), cache.GetFile(key));
+	EXPECT_EQ(cache.Load(key), nullptr);
+	EXPECT_FALSE(cache.Restore(key, cache.GetPath() / "restored.asset"));
+
+	// 예전 형식(헤더 없이 Asset 파일 그대로 복사된 캐시)
+	ASSERT_TRUE(FileSystem::SaveBinary(blob, cache.GetFile(key)));
+	EXPECT_EQ(cache.Load(key), nullptr);
+
+	std::filesystem::remove_all(cache.GetPath());
+}
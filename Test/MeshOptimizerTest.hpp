@@ -0,0 +1,195 @@
+﻿#pragma once
+#include "Render/MeshOptimizer.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace meshOptimizerTest
+{
+	/// @brief size x size 격자 메쉬. 캐시에 불리하도록 줄 단위로 번갈아 가며 삼각형을 만든다.
+	inline void MakeGrid(int size, std::vector<sh::render::Mesh::Vertex>& verts, std::vector<uint32_t>& indices)
+	{
+		verts.clear();
+		indices.clear();
+		for (int y = 0; y <= size; ++y)
+		{
+			for (int x = 0; x <= size; ++x)
+			{
+				sh::render::Mesh::Vertex vert{};
+				vert.vertex = glm::vec3{ static_cast<float>(x), static_cast<float>(y), 0.f };
+				vert.uv = glm::vec2{ x / static_cast<float>(size), y / static_cast<float>(size) };
+				vert.normal = glm::vec3{ 0.f, 0.f, 1.f };
+				vert.tangent = glm::vec3{ 1.f, 0.f, 0.f };
+				verts.push_back(vert);
+			}
+		}
+		const uint32_t stride = static_cast<uint32_t>(size + 1);
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			for (int y = pass; y < size; y += 2)
+			{
+				for (int x = 0; x < size; ++x)
+				{
+					const uint32_t v0 = y * stride + x;
+					indices.insert(indices.end(), { v0, v0 + 1, v0 + stride });
+					indices.insert(indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+				}
+			}
+		}
+	}
+	/// @brief 시작 버텍스에 상관 없이 비교할 수 있도록 정규화된 삼각형 목록
+	inline auto GetTriangles(const std::vector<sh::render::Mesh::Vertex>& verts, const std::vector<uint32_t>& indices) -> std::vector<std::array<float, 9>>
+	{
+		std::vector<std::array<float, 9>> tris;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			std::array<std::array<float, 3>, 3> corners{};
+			for (int k = 0; k < 3; ++k)
+			{
+				const glm::vec3& p = verts[indices[i + k]].vertex;
+				corners[k] = { p.x, p.y, p.z };
+			}
+			// 감기 순서를 유지한 채 가장 작은 꼭짓점이 앞에 오도록 회전
+			const std::size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+			std::array<float, 9> tri{};
+			for (int k = 0; k < 3; ++k)
+			{
+				const auto& c = corners[(first + k) % 3];
+				std::copy(c.begin(), c.end(), tri.begin() + k * 3);
+			}
+			tris.push_back(tri);
+		}
+		std::sort(tris.begin(), tris.end());
+		return tris;
+	}
+}//namespace
+
+TEST(MeshOptimizerTest, VertexCache)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshOptimizerTest::MakeGrid(32, verts, indices);
+	const auto trisBefore = meshOptimizerTest::GetTriangles(verts, indices);
+
+	const MeshOptimizer::CacheStatistics before = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), verts.size());
+	MeshOptimizer::OptimizeVertexCache(indices.data(), indices.size(), verts.size());
+	const MeshOptimizer::CacheStatistics after = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), verts.size());
+
+	EXPECT_LT(after.acmr, before.acmr);
+	EXPECT_LT(after.acmr, 1.f);
+	EXPECT_GE(after.atvr, 1.f);
+	// 삼각형의 집합과 감기 순서는 그대로여야 한다.
+	EXPECT_EQ(meshOptimizerTest::GetTriangles(verts, indices), trisBefore);
+
+	MeshOptimizer::OptimizeOverdraw(indices.data(), indices.size(), verts);
+	EXPECT_EQ(meshOptimizerTest::GetTriangles(verts, indices), trisBefore);
+}
+
+TEST(MeshOptimizerTest, VertexFetch)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshOptimizerTest::MakeGrid(8, verts, indices);
+	// 참조되지 않는 버텍스
+	verts.push_back(Mesh::Vertex{ glm::vec3{ 100.f } });
+	const auto trisBefore = meshOptimizerTest::GetTriangles(verts, indices);
+
+	MeshOptimizer::Optimize(verts, indices, {});
+	EXPECT_EQ(verts.size(), 81);
+	EXPECT_EQ(meshOptimizerTest::GetTriangles(verts, indices), trisBefore);
+
+	// 버텍스는 처음 참조되는 순서대로 놓인다.
+	uint32_t next = 0;
+	for (uint32_t idx : indices)
+	{
+		EXPECT_LE(idx, next);
+		if (idx == next)
+			++next;
+	}
+	EXPECT_EQ(next, verts.size());
+}
+
+TEST(MeshOptimizerTest, SubMeshRange)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshOptimizerTest::MakeGrid(4, verts, indices);
+	const std::vector<uint32_t> first(indices.begin(), indices.begin() + 12);
+	std::vector<SubMesh> subMeshes(2);
+	subMeshes[0].indexOffset = 0;
+	subMeshes[0].indexCount = 12;
+	subMeshes[1].indexOffset = 12;
+	subMeshes[1].indexCount = indices.size() - 12;
+
+	std::vector<Mesh::Vertex> original = verts;
+	MeshOptimizer::Optimize(verts, indices, subMeshes);
+	// 첫번째 서브 메쉬의 삼각형은 첫번째 범위 안에 남아있어야 한다.
+	EXPECT_EQ(meshOptimizerTest::GetTriangles(verts, std::vector<uint32_t>(indices.begin(), indices.begin() + 12)),
+		meshOptimizerTest::GetTriangles(original, first));
+}
+
+TEST(MeshOptimizerTest, Octahedral)
+{
+	using namespace sh::render;
+	const std::array<glm::vec3, 7> dirs =
+	{
+		glm::vec3{ 0.f, 0.f, 1.f },
+		glm::vec3{ 0.f, 0.f, -1.f },
+		glm::vec3{ 1.f, 0.f, 0.f },
+		glm::vec3{ 0.f, -1.f, 0.f },
+		glm::normalize(glm::vec3{ 1.f, 2.f, 3.f }),
+		glm::normalize(glm::vec3{ -1.f, 0.5f, -3.f }),
+		glm::normalize(glm::vec3{ -0.3f, -0.8f, -0.1f })
+	};
+	for (const glm::vec3& dir : dirs)
+	{
+		const glm::vec3 decoded = MeshOptimizer::DecodeOctahedral(MeshOptimizer::EncodeOctahedral(dir));
+		EXPECT_GT(glm::dot(decoded, dir), 0.99999f);
+	}
+}
+
+TEST(MeshOptimizerTest, Half)
+{
+	using namespace sh::render;
+	EXPECT_EQ(MeshOptimizer::FloatToHalf(0.f), 0x0000);
+	EXPECT_EQ(MeshOptimizer::FloatToHalf(1.f), 0x3c00);
+	EXPECT_EQ(MeshOptimizer::FloatToHalf(-2.f), 0xc000);
+	EXPECT_EQ(MeshOptimizer::FloatToHalf(65504.f), 0x7bff);
+	EXPECT_EQ(MeshOptimizer::FloatToHalf(1e6f), 0x7c00);
+	for (float v : { 0.f, 0.5f, 0.25f, 1.f, -3.75f, 0.1f, 0.333f, 1e-5f })
+		EXPECT_NEAR(MeshOptimizer::HalfToFloat(MeshOptimizer::FloatToHalf(v)), v, std::abs(v) * 1e-3f + 1e-7f);
+}
+
+TEST(MeshOptimizerTest, Quantize)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshOptimizerTest::MakeGrid(16, verts, indices);
+	for (Mesh::Vertex& vert : verts)
+		vert.vertex.z = std::sin(vert.vertex.x) * 3.f;
+
+	const Mesh::Dequantization deq = MeshOptimizer::CalcDequantization(verts);
+	const std::vector<Mesh::QuantizedVertex> quantized = MeshOptimizer::Quantize(verts, deq);
+	ASSERT_EQ(quantized.size(), verts.size());
+	EXPECT_EQ(sizeof(Mesh::QuantizedVertex), 20);
+	EXPECT_NE(deq.scale.w, 0.f);
+
+	for (std::size_t i = 0; i < verts.size(); ++i)
+	{
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			// 셰이더와 같은 방식으로 복원
+			const float restored = deq.offset[axis] + quantized[i].vertex[axis] / 65535.f * deq.scale[axis];
+			EXPECT_NEAR(restored, verts[i].vertex[axis], deq.scale[axis] / 65535.f);
+		}
+		EXPECT_NEAR(MeshOptimizer::HalfToFloat(quantized[i].uv[0]), verts[i].uv.x, 1e-3f);
+		EXPECT_GT(glm::dot(MeshOptimizer::DecodeOctahedral(quantized[i].normal), verts[i].normal), 0.9999f);
+	}
+}
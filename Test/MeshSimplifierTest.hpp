@@ -0,0 +1,144 @@
+﻿#pragma once
+#include "Render/MeshSimplifier.h"
+#include "Render/Mesh.h"
+
+#include "Core/SObject.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace meshSimplifierTest
+{
+	/// @brief size x size 격자를 z = f(x, y) 곡면으로 휜 메쉬
+	inline void MakeSurface(int size, bool bFlat, std::vector<sh::render::Mesh::Vertex>& verts, std::vector<uint32_t>& indices)
+	{
+		verts.clear();
+		indices.clear();
+		for (int y = 0; y <= size; ++y)
+		{
+			for (int x = 0; x <= size; ++x)
+			{
+				sh::render::Mesh::Vertex vert{};
+				const float fx = static_cast<float>(x) / size;
+				const float fy = static_cast<float>(y) / size;
+				const float z = bFlat ? 0.f : std::sin(fx * 3.f) * std::cos(fy * 2.f) * 0.2f;
+				vert.vertex = glm::vec3{ fx, fy, z };
+				vert.uv = glm::vec2{ fx, fy };
+				vert.normal = glm::vec3{ 0.f, 0.f, 1.f };
+				vert.tangent = glm::vec3{ 1.f, 0.f, 0.f };
+				verts.push_back(vert);
+			}
+		}
+		const uint32_t stride = static_cast<uint32_t>(size + 1);
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const uint32_t v0 = y * stride + x;
+				indices.insert(indices.end(), { v0, v0 + 1, v0 + stride });
+				indices.insert(indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+			}
+		}
+	}
+	inline auto IsBorder(const sh::render::Mesh::Vertex& vert) -> bool
+	{
+		return vert.vertex.x == 0.f || vert.vertex.x == 1.f || vert.vertex.y == 0.f || vert.vertex.y == 1.f;
+	}
+}//namespace
+
+TEST(MeshSimplifierTest, Simplify)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshSimplifierTest::MakeSurface(32, false, verts, indices);
+
+	float error = 0.f;
+	const std::vector<uint32_t> result = MeshSimplifier::Simplify(verts, indices.data(), indices.size(), indices.size() / 4, 1.f, &error);
+	ASSERT_EQ(result.size() % 3, 0);
+	EXPECT_LT(result.size(), indices.size() / 2);
+	EXPECT_GT(error, 0.f);
+	EXPECT_LT(error, 0.1f);
+
+	for (std::size_t i = 0; i < result.size(); i += 3)
+	{
+		ASSERT_LT(result[i], verts.size());
+		EXPECT_NE(result[i], result[i + 1]);
+		EXPECT_NE(result[i + 1], result[i + 2]);
+		EXPECT_NE(result[i], result[i + 2]);
+		// 뒤집힌 삼각형이 없어야 한다.
+		const glm::vec3 normal = glm::cross(verts[result[i + 1]].vertex - verts[result[i]].vertex, verts[result[i + 2]].vertex - verts[result[i]].vertex);
+		EXPECT_GT(normal.z, 0.f);
+	}
+	// 경계 버텍스는 움직이지 않으므로 모두 남아있어야 한다.
+	for (uint32_t v = 0; v < verts.size(); ++v)
+	{
+		if (meshSimplifierTest::IsBorder(verts[v]))
+			EXPECT_NE(std::find(result.begin(), result.end(), v), result.end());
+	}
+}
+
+TEST(MeshSimplifierTest, ErrorLimit)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+
+	// 평면은 오차 없이 줄어든다.
+	meshSimplifierTest::MakeSurface(16, true, verts, indices);
+	float error = 1.f;
+	std::vector<uint32_t> result = MeshSimplifier::Simplify(verts, indices.data(), indices.size(), 0, 0.f, &error);
+	EXPECT_LT(result.size(), indices.size() / 4);
+	EXPECT_EQ(error, 0.f);
+
+	// 곡면은 오차를 허용하지 않으면 거의 줄지 않는다.
+	meshSimplifierTest::MakeSurface(16, false, verts, indices);
+	result = MeshSimplifier::Simplify(verts, indices.data(), indices.size(), 0, 0.f, &error);
+	EXPECT_GT(result.size(), indices.size() / 2);
+}
+
+TEST(MeshSimplifierTest, Lod)
+{
+	using namespace sh::render;
+	std::vector<Mesh::Vertex> verts;
+	std::vector<uint32_t> indices;
+	meshSimplifierTest::MakeSurface(32, false, verts, indices);
+	const std::size_t half = indices.size() / 2;
+
+	Mesh* const mesh = sh::core::SObject::Create<Mesh>();
+	mesh->SetVertex(verts);
+	mesh->SetIndices(indices);
+	mesh->SetSubMeshes({ SubMesh{ 0, half }, SubMesh{ half, indices.size() - half } });
+	mesh->lodRatios = { 0.5f, 0.25f };
+	mesh->lodScreenSizes = { 0.5f, 0.2f };
+	mesh->GenerateLods();
+
+	ASSERT_EQ(mesh->GetLodCount(), 3);
+	std::size_t prevCount = indices.size();
+	for (const Mesh::Lod& lod : mesh->GetLods())
+	{
+		ASSERT_EQ(lod.subMeshes.size(), 2);
+		const std::size_t count = lod.subMeshes[0].indexCount + lod.subMeshes[1].indexCount;
+		EXPECT_LT(count, prevCount);
+		prevCount = count;
+	}
+	// GPU 인덱스 버퍼에서 LOD는 원본 뒤에 있다.
+	const SubMesh range = mesh->GetIndexRange(1, 2);
+	EXPECT_EQ(range.indexOffset, indices.size() + mesh->GetLods()[1].subMeshes[1].indexOffset);
+	EXPECT_EQ(range.indexCount, mesh->GetLods()[1].subMeshes[1].indexCount);
+	EXPECT_EQ(mesh->GetIndexRange(0, 0).indexCount, half);
+	EXPECT_EQ(mesh->GetIndexRange(5, 1).indexOffset, indices.size());
+
+	// 경계를 hysteresis 만큼 넘어야 LOD가 바뀐다.
+	EXPECT_EQ(mesh->SelectLod(1.f, 0), 0);
+	EXPECT_EQ(mesh->SelectLod(0.48f, 0), 0);
+	EXPECT_EQ(mesh->SelectLod(0.4f, 0), 1);
+	EXPECT_EQ(mesh->SelectLod(0.52f, 1), 1);
+	EXPECT_EQ(mesh->SelectLod(0.6f, 1), 0);
+	EXPECT_EQ(mesh->SelectLod(0.1f, 0), 2);
+	EXPECT_EQ(mesh->SelectLod(1.f, 2), 0);
+
+	mesh->Destroy();
+}
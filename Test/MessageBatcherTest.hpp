@@ -0,0 +1,238 @@
+﻿#pragma once
+#include "Network/NetworkContext.h"
+#include "Network/MessageBatcher.h"
+#include "Network/UdpSocket.h"
+#include "Network/Endpoint.h"
+#include "Network/StringPacket.h"
+#include "Network/PacketCodec.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+namespace batcherTest
+{
+	struct SentDatagram
+	{
+		sh::network::Endpoint peer;
+		std::vector<uint8_t> data;
+	};
+	inline auto FlushAll(sh::network::MessageBatcher& batcher) -> std::vector<SentDatagram>
+	{
+		std::vector<SentDatagram> out;
+		batcher.Flush(
+			[&](const sh::network::Endpoint& peer, const uint8_t* data, std::size_t size)
+			{
+				out.push_back(SentDatagram{ peer, std::vector<uint8_t>(data, data + size) });
+			}
+		);
+		return out;
+	}
+	/// @brief 게임 메시지 흉내. 앞부분은 매번 바뀌고 뒷부분은 비슷한 값이 반복된다.
+	inline auto MakeMessage(uint32_t seq, std::size_t size) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> message(size);
+		for (std::size_t i = 0; i < size; ++i)
+			message[i] = i < 4 ? static_cast<uint8_t>(seq >> (i * 8)) : static_cast<uint8_t>(i % 8);
+		return message;
+	}
+}//namespace
+
+TEST(MessageBatcherTest, PackAndUnpack)
+{
+	using namespace sh::network;
+	using namespace batcherTest;
+	MessageBatcher::Config config{};
+	config.bCompress = false;
+	MessageBatcher batcher{ config };
+
+	const Endpoint a = Endpoint::FromIPv4(0x7f000001, 1000);
+	const Endpoint b = Endpoint::FromIPv4(0x7f000001, 2000);
+	std::unordered_map<Endpoint, std::vector<std::vector<uint8_t>>> expected;
+	for (uint32_t seq = 0; seq < 300; ++seq)
+	{
+		const Endpoint& peer = seq % 3 == 0 ? b : a;
+		std::vector<uint8_t> message = MakeMessage(seq, 5 + (seq * 37) % 200);
+		ASSERT_TRUE(batcher.Add(peer, message.data(), message.size()));
+		expected[peer].push_back(std::move(message));
+	}
+	// 데이터그램 하나에 들어가지 않는 메시지
+	std::vector<uint8_t> tooLarge(config.maxDatagramSize);
+	EXPECT_FALSE(batcher.Add(a, tooLarge.data(), tooLarge.size()));
+
+	const std::vector<SentDatagram> datagrams = FlushAll(batcher);
+	std::unordered_map<Endpoint, std::vector<std::vector<uint8_t>>> received;
+	std::vector<uint8_t> scratch;
+	std::size_t totalSize = 0;
+	for (const SentDatagram& datagram : datagrams)
+	{
+		EXPECT_LE(datagram.data.size(), config.maxDatagramSize);
+		ASSERT_TRUE(MessageBatcher::IsBatch(datagram.data.data(), datagram.data.size()));
+		EXPECT_FALSE(PacketCodec::IsBinary(datagram.data.data(), datagram.data.size()));
+		const bool bValid = MessageBatcher::Unpack(datagram.data.data(), datagram.data.size(), scratch,
+			[&](const uint8_t* data, std::size_t size)
+			{
+				// 압축하지 않은 묶음은 데이터그램 안을 그대로 가리킨다.
+				EXPECT_GE(data, datagram.data.data());
+				EXPECT_LE(data + size, datagram.data.data() + datagram.data.size());
+				received[datagram.peer].emplace_back(data, data + size);
+			}
+		);
+		EXPECT_TRUE(bValid);
+		totalSize += datagram.data.size();
+	}
+	EXPECT_EQ(received, expected);
+	EXPECT_EQ(batcher.GetStats().messages, 300);
+	EXPECT_EQ(batcher.GetStats().datagrams, datagrams.size());
+	// 꽉 채워서 보내므로 데이터그램 수는 전체 크기로 정해지는 최소값에 가깝다.
+	EXPECT_LE(datagrams.size(), totalSize / (config.maxDatagramSize - 200) + 2);
+
+	// 보낸 뒤에는 비어 있다.
+	EXPECT_TRUE(FlushAll(batcher).empty());
+}
+
+TEST(MessageBatcherTest, Compression)
+{
+	using namespace sh::network;
+	using namespace batcherTest;
+	MessageBatcher batcher{};
+	const Endpoint peer = Endpoint::FromIPv4(0x7f000001, 1000);
+
+	std::vector<std::vector<uint8_t>> expected;
+	for (uint32_t seq = 0; seq < 100; ++seq)
+	{
+		expected.push_back(MakeMessage(seq, 60));
+		ASSERT_TRUE(batcher.Add(peer, expected.back().data(), expected.back().size()));
+	}
+	// 압축되지 않는 데이터는 그대로 보낸다.
+	std::vector<uint8_t> noise(300);
+	uint32_t state = 12345;
+	for (uint8_t& byte : noise)
+	{
+		state = state * 1664525u + 1013904223u;
+		byte = static_cast<uint8_t>(state >> 24);
+	}
+	const Endpoint noisePeer = Endpoint::FromIPv4(0x7f000001, 2000);
+	ASSERT_TRUE(batcher.Add(noisePeer, noise.data(), noise.size()));
+
+	const std::vector<SentDatagram> datagrams = FlushAll(batcher);
+	std::vector<std::vector<uint8_t>> received;
+	std::vector<uint8_t> scratch;
+	std::size_t peerDatagrams = 0;
+	for (const SentDatagram& datagram : datagrams)
+	{
+		EXPECT_LE(datagram.data.size(), batcher.GetConfig().maxDatagramSize);
+		if (datagram.peer == noisePeer)
+		{
+			EXPECT_EQ(datagram.data[1], MessageBatcher::MAGIC_RAW);
+			continue;
+		}
+		++peerDatagrams;
+		EXPECT_TRUE(MessageBatcher::Unpack(datagram.data.data(), datagram.data.size(), scratch,
+			[&](const uint8_t* data, std::size_t size) { received.emplace_back(data, data + size); }));
+	}
+	EXPECT_EQ(received, expected);
+
+	const MessageBatcher::Stats& stats = batcher.GetStats();
+	EXPECT_GE(stats.compressedDatagrams, 1);
+	EXPECT_LT(stats.sentBytes, stats.rawBytes / 2);
+	// 압축하면 원본이 데이터그램 크기를 넘어도 계속 모으므로 압축하지 않을 때(7개)보다 적게 보낸다.
+	EXPECT_LE(peerDatagrams, 3);
+}
+
+TEST(MessageBatcherTest, InvalidData)
+{
+	using namespace sh::network;
+	using namespace batcherTest;
+	MessageBatcher batcher{};
+	const Endpoint peer = Endpoint::FromIPv4(0x7f000001, 1000);
+	for (uint32_t seq = 0; seq < 20; ++seq)
+	{
+		std::vector<uint8_t> message = MakeMessage(seq, 40);
+		batcher.Add(peer, message.data(), message.size());
+	}
+	const std::vector<SentDatagram> datagrams = FlushAll(batcher);
+	ASSERT_EQ(datagrams.size(), 1);
+	const std::vector<uint8_t>& datagram = datagrams[0].data;
+
+	std::vector<uint8_t> scratch;
+	std::size_t count = 0;
+	const auto counter = [&](const uint8_t*, std::size_t) { ++count; };
+	// 잘린 데이터, 부서진 데이터에서 범위를 넘어 읽지 않는다.
+	for (std::size_t size = 0; size < datagram.size(); ++size)
+		EXPECT_FALSE(MessageBatcher::Unpack(datagram.data(), size, scratch, counter));
+	std::vector<uint8_t> broken = datagram;
+	for (std::size_t i = 3; i < broken.size(); i += 3)
+		broken[i] ^= 0x5a;
+	MessageBatcher::Unpack(broken.data(), broken.size(), scratch, counter);
+
+	const std::vector<uint8_t> garbage{ PacketCodec::MAGIC0, MessageBatcher::MAGIC_RAW, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 };
+	EXPECT_FALSE(MessageBatcher::Unpack(garbage.data(), garbage.size(), scratch, counter));
+	const std::vector<uint8_t> bomb{ PacketCodec::MAGIC0, MessageBatcher::MAGIC_LZ4, 0xff, 0xff, 0xff, 0x7f, 0x00 };
+	EXPECT_FALSE(MessageBatcher::Unpack(bomb.data(), bomb.size(), scratch, counter));
+}
+
+TEST(MessageBatcherTest, UdpLoopback)
+{
+	using namespace sh::network;
+	constexpr uint32_t frames = 50;
+	constexpr uint32_t perFrame = 100;
+
+	NetworkContext ctx{};
+	UdpSocket receiver{ ctx };
+	UdpSocket sender{ ctx };
+	ASSERT_TRUE(receiver.Bind());
+	ASSERT_TRUE(sender.Bind());
+	const Endpoint target = Endpoint::FromIPv4(0x7f000001, receiver.GetLocalPort());
+	std::thread networkThread{ [&ctx]() { ctx.Update(); } };
+
+	const uint16_t senderPort = sender.GetLocalPort();
+	MessageBatcher batcher{};
+	StringPacket packet{};
+	std::vector<NetworkContext::Message> messages;
+	std::size_t datagrams = 0;
+	for (uint32_t frame = 0; frame < frames; ++frame)
+	{
+		for (uint32_t i = 0; i < perFrame; ++i)
+		{
+			packet.SetString("move " + std::to_string(frame * perFrame + i));
+			ASSERT_TRUE(batcher.Add(target, packet));
+		}
+		datagrams += batcher.Flush(
+			[&](const Endpoint& peer, const uint8_t* data, std::size_t size)
+			{
+				sender.Enqueue(data, size, peer);
+			}
+		);
+		sender.Flush();
+		receiver.GetReceivedMessages(messages);
+	}
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+	while (messages.size() < frames * perFrame && std::chrono::steady_clock::now() < deadline)
+	{
+		receiver.GetReceivedMessages(messages);
+		std::this_thread::yield();
+	}
+	receiver.Close();
+	sender.Close();
+	ctx.Stop();
+	networkThread.join();
+
+	EXPECT_LT(datagrams, frames * perFrame / 10);
+	// 루프백이라도 유실될 수 있으므로 도착한 것들의 순서와 내용만 확인한다.
+	ASSERT_GT(messages.size(), frames * perFrame / 2);
+	int last = -1;
+	for (const NetworkContext::Message& msg : messages)
+	{
+		EXPECT_EQ(msg.sender.GetPort(), senderPort);
+		const std::string& str = static_cast<StringPacket*>(msg.packet.get())->GetString();
+		ASSERT_EQ(str.rfind("move ", 0), 0);
+		const int seq = std::stoi(str.substr(5));
+		EXPECT_GT(seq, last);
+		last = seq;
+	}
+}
@@ -0,0 +1,377 @@
+﻿#pragma once
+#include "Game/Asset/ModelLoader.h"
+
+#include "Render/IRenderContext.h"
+#include "Render/RenderDataManager.h"
+#include "Render/SkinPaletteBuffer.h"
+#include "Render/Model.h"
+
+#include "Core/ThreadPool.h"
+
+#include "../external/tinygltf/tiny_gltf.h"
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace modelLoaderTest
+{
+	/// @brief GPU 없이 ModelLoader를 만들기 위한 렌더 컨텍스트. 메쉬를 Build하지 않는 경로에서만 쓴다.
+	class FakeRenderContext : public sh::render::IRenderContext
+	{
+	public:
+		void Init() override {}
+		void Clear() override {}
+		auto GetRenderAPIType() const -> sh::render::RenderAPI override { return sh::render::RenderAPI::Vulkan; }
+
+		auto AllocateCommandBuffer(bool bCompute) -> sh::render::CommandBuffer* override { return nullptr; }
+		void DeallocateCommandBuffer(sh::render::CommandBuffer& cmd) override {}
+		void SubmitCommand(sh::render::CommandBuffer& cmd) override {}
+
+		void SetViewport(const glm::vec2& start, const glm::vec2& end) override { viewportStart = start; viewportEnd = end; }
+		auto GetViewportStart() const -> const glm::vec2& override { return viewportStart; }
+		auto GetViewportEnd() const -> const glm::vec2& override { return viewportEnd; }
+
+		auto GetRenderDataManager() const -> const sh::render::RenderDataManager& override { return renderDataManager; }
+		auto GetRenderDataManager() -> sh::render::RenderDataManager& override { return renderDataManager; }
+		auto GetSkinPaletteBuffer() const -> const sh::render::SkinPaletteBuffer& override { return skinPaletteBuffer; }
+		auto GetSkinPaletteBuffer() -> sh::render::SkinPaletteBuffer& override { return skinPaletteBuffer; }
+		auto IsTextureCompressionSupported() const -> bool override { return true; }
+	private:
+		glm::vec2 viewportStart{ 0.f };
+		glm::vec2 viewportEnd{ 0.f };
+		sh::render::RenderDataManager renderDataManager;
+		sh::render::SkinPaletteBuffer skinPaletteBuffer;
+	};
+
+	/// @brief 변환을 검사하기 위한 결정적인 바이트열. 앞부분은 각 정수 타입의 최소, 최대값이 나오도록 채운다.
+	inline auto MakeBytes(std::size_t size, uint32_t seed) -> std::vector<uint8_t>
+	{
+		static constexpr uint8_t extremes[] = { 0x00, 0x80, 0xff, 0x7f, 0xff, 0xff, 0x01, 0x00 };
+		std::vector<uint8_t> bytes(size);
+		uint32_t state = seed * 747796405u + 2891336453u;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			bytes[i] = i < sizeof(extremes) ? extremes[i] : static_cast<uint8_t>(state >> 24);
+		}
+		return bytes;
+	}
+	inline auto MakeFloats(std::size_t count, float start, float step) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> bytes(count * sizeof(float));
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float value = start + step * static_cast<float>(i);
+			std::memcpy(bytes.data() + i * sizeof(float), &value, sizeof(float));
+		}
+		return bytes;
+	}
+	/// @brief 첫번째 버퍼 끝에 데이터를 붙이고 버퍼 뷰를 만든다. glTF 규칙대로 4바이트 정렬한다.
+	inline auto AddView(tinygltf::Model& model, const std::vector<uint8_t>& bytes, std::size_t byteStride = 0) -> int
+	{
+		if (model.buffers.empty())
+			model.buffers.emplace_back();
+		std::vector<unsigned char>& data = model.buffers[0].data;
+		data.resize((data.size() + 3) / 4 * 4);
+
+		tinygltf::BufferView view{};
+		view.buffer = 0;
+		view.byteOffset = data.size();
+		view.byteLength = bytes.size();
+		view.byteStride = byteStride;
+		data.insert(data.end(), bytes.begin(), bytes.end());
+		model.bufferViews.push_back(view);
+		return static_cast<int>(model.bufferViews.size() - 1);
+	}
+	inline auto AddAccessor(tinygltf::Model& model, int view, std::size_t byteOffset, int componentType, int type, std::size_t count, bool bNormalized = false) -> int
+	{
+		tinygltf::Accessor accessor{};
+		accessor.bufferView = view;
+		accessor.byteOffset = byteOffset;
+		accessor.componentType = componentType;
+		accessor.type = type;
+		accessor.count = count;
+		accessor.normalized = bNormalized;
+		model.accessors.push_back(accessor);
+		return static_cast<int>(model.accessors.size() - 1);
+	}
+
+	/// @brief glTF 명세를 그대로 옮긴 성분 하나의 변환
+	template<typename T>
+	inline auto ScalarComponent(const uint8_t* src, bool bNormalized) -> float
+	{
+		T value;
+		std::memcpy(&value, src, sizeof(T));
+		if (!bNormalized || std::is_same_v<T, float>)
+			return static_cast<float>(value);
+		const float result = static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+		return std::is_signed_v<T> ? std::max(result, -1.f) : result;
+	}
+	/// @brief 요소마다, 성분마다 하나씩 읽는 기준 구현
+	inline auto ScalarRead(const tinygltf::Model& model, const tinygltf::Accessor& accessor) -> std::vector<float>
+	{
+		const int compCount = tinygltf::GetNumComponentsInType(accessor.type);
+		const int compSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+		const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
+		const std::size_t stride = view.byteStride != 0 ? view.byteStride : static_cast<std::size_t>(compCount * compSize);
+		const uint8_t* const base = model.buffers[view.buffer].data.data() + view.byteOffset + accessor.byteOffset;
+
+		std::vector<float> result;
+		for (std::size_t i = 0; i < accessor.count; ++i)
+		{
+			for (int c = 0; c < compCount; ++c)
+			{
+				const uint8_t* const src = base + i * stride + c * compSize;
+				switch (accessor.componentType)
+				{
+				case TINYGLTF_COMPONENT_TYPE_BYTE: result.push_back(ScalarComponent<int8_t>(src, accessor.normalized)); break;
+				case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: result.push_back(ScalarComponent<uint8_t>(src, accessor.normalized)); break;
+				case TINYGLTF_COMPONENT_TYPE_SHORT: result.push_back(ScalarComponent<int16_t>(src, accessor.normalized)); break;
+				case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: result.push_back(ScalarComponent<uint16_t>(src, accessor.normalized)); break;
+				case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: result.push_back(ScalarComponent<uint32_t>(src, accessor.normalized)); break;
+				case TINYGLTF_COMPONENT_TYPE_FLOAT: result.push_back(ScalarComponent<float>(src, accessor.normalized)); break;
+				}
+			}
+		}
+		return result;
+	}
+	inline void ExpectSameAsScalar(const tinygltf::Model& model, int accessorIdx)
+	{
+		const tinygltf::Accessor& accessor = model.accessors[accessorIdx];
+		std::vector<float> result;
+		ASSERT_TRUE(sh::game::ModelLoader::ReadGLTFAccessor(model, accessor, result));
+		const std::vector<float> expected = ScalarRead(model, accessor);
+		ASSERT_EQ(result.size(), expected.size());
+		for (std::size_t i = 0; i < expected.size(); ++i)
+			EXPECT_FLOAT_EQ(result[i], expected[i]) << "type " << accessor.componentType << ", normalized " << accessor.normalized << ", count " << accessor.count << ", scalar " << i;
+	}
+
+	/// @brief 위치(float), 노말(정규화된 정수), UV(정규화된 정수)를 가진 프리미티브를 추가한다.
+	/// @param bInterleaved true면 세 속성을 하나의 버퍼 뷰에 byteStride로 섞어 넣는다.
+	/// @param indexType 인덱스 성분 타입. 0이면 인덱스가 없다.
+	inline auto AddPrimitive(tinygltf::Model& model, std::size_t vertexCount, bool bInterleaved,
+		int normalType, int uvType, int indexType, std::size_t indexCount, uint32_t seed) -> tinygltf::Primitive
+	{
+		const std::size_t normalSize = 3 * tinygltf::GetComponentSizeInBytes(normalType);
+		const std::size_t uvSize = 2 * tinygltf::GetComponentSizeInBytes(uvType);
+		const std::vector<uint8_t> positions = MakeFloats(vertexCount * 3, -1.5f * seed, 0.25f);
+		const std::vector<uint8_t> normals = MakeBytes(vertexCount * normalSize, seed);
+		const std::vector<uint8_t> uvs = MakeBytes(vertexCount * uvSize, seed + 100);
+
+		tinygltf::Primitive primitive{};
+		if (bInterleaved)
+		{
+			const std::size_t normalOffset = 12;
+			const std::size_t uvOffset = (normalOffset + normalSize + 3) / 4 * 4;
+			const std::size_t stride = (uvOffset + uvSize + 3) / 4 * 4;
+			std::vector<uint8_t> bytes(stride * vertexCount, 0xcd);
+			for (std::size_t v = 0; v < vertexCount; ++v)
+			{
+				std::memcpy(bytes.data() + v * stride, positions.data() + v * 12, 12);
+				std::memcpy(bytes.data() + v * stride + normalOffset, normals.data() + v * normalSize, normalSize);
+				std::memcpy(bytes.data() + v * stride + uvOffset, uvs.data() + v * uvSize, uvSize);
+			}
+			const int view = AddView(model, bytes, stride);
+			primitive.attributes["POSITION"] = AddAccessor(model, view, 0, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, vertexCount);
+			primitive.attributes["NORMAL"] = AddAccessor(model, view, normalOffset, normalType, TINYGLTF_TYPE_VEC3, vertexCount, true);
+			primitive.attributes["TEXCOORD_0"] = AddAccessor(model, view, uvOffset, uvType, TINYGLTF_TYPE_VEC2, vertexCount, true);
+		}
+		else
+		{
+			primitive.attributes["POSITION"] = AddAccessor(model, AddView(model, positions), 0, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, vertexCount);
+			primitive.attributes["NORMAL"] = AddAccessor(model, AddView(model, normals), 0, normalType, TINYGLTF_TYPE_VEC3, vertexCount, true);
+			primitive.attributes["TEXCOORD_0"] = AddAccessor(model, AddView(model, uvs), 0, uvType, TINYGLTF_TYPE_VEC2, vertexCount, true);
+		}
+		if (indexType != 0)
+		{
+			const std::size_t indexSize = tinygltf::GetComponentSizeInBytes(indexType);
+			std::vector<uint8_t> bytes(indexCount * indexSize);
+			for (std::size_t i = 0; i < indexCount; ++i)
+			{
+				const uint32_t index = static_cast<uint32_t>((i * 7 + seed) % vertexCount);
+				std::memcpy(bytes.data() + i * indexSize, &index, indexSize); // 리틀 엔디언
+			}
+			primitive.indices = AddAccessor(model, AddView(model, bytes), 0, indexType, TINYGLTF_TYPE_SCALAR, indexCount);
+		}
+		return primitive;
+	}
+	inline auto AddMeshNode(tinygltf::Model& model, std::vector<tinygltf::Primitive> primitives, const char* name) -> int
+	{
+		model.meshes.emplace_back().primitives = std::move(primitives);
+		tinygltf::Node& node = model.nodes.emplace_back();
+		node.name = name;
+		node.mesh = static_cast<int>(model.meshes.size() - 1);
+		if (model.scenes.empty())
+			model.scenes.emplace_back();
+		model.scenes[0].nodes.push_back(static_cast<int>(model.nodes.size() - 1));
+		return node.mesh;
+	}
+	/// @brief 메쉬의 버텍스, 인덱스가 각 프리미티브를 기준 구현으로 읽은 것과 같은지 검사한다.
+	inline void ExpectSameMesh(const tinygltf::Model& gltfModel, const tinygltf::Mesh& gltfMesh, const sh::render::Mesh& mesh)
+	{
+		const std::vector<sh::render::Mesh::Vertex>& verts = mesh.GetVertex();
+		const std::vector<uint32_t>& indices = mesh.GetIndices();
+		ASSERT_EQ(mesh.GetSubMeshes().size(), gltfMesh.primitives.size());
+
+		std::size_t vertexStart = 0;
+		for (std::size_t p = 0; p < gltfMesh.primitives.size(); ++p)
+		{
+			const tinygltf::Primitive& primitive = gltfMesh.primitives[p];
+			const std::vector<float> positions = ScalarRead(gltfModel, gltfModel.accessors[primitive.attributes.at("POSITION")]);
+			const std::vector<float> normals = ScalarRead(gltfModel, gltfModel.accessors[primitive.attributes.at("NORMAL")]);
+			const std::vector<float> uvs = ScalarRead(gltfModel, gltfModel.accessors[primitive.attributes.at("TEXCOORD_0")]);
+			const std::size_t vertexCount = positions.size() / 3;
+			ASSERT_LE(vertexStart + vertexCount, verts.size());
+			for (std::size_t v = 0; v < vertexCount; ++v)
+			{
+				const sh::render::Mesh::Vertex& vert = verts[vertexStart + v];
+				for (int c = 0; c < 3; ++c)
+					EXPECT_FLOAT_EQ(vert.vertex[c], positions[v * 3 + c]);
+				const glm::vec3 normal{ normals[v * 3 + 0], normals[v * 3 + 1], normals[v * 3 + 2] };
+				if (glm::length(normal) > 0.f)
+				{
+					const glm::vec3 expected = glm::normalize(normal);
+					for (int c = 0; c < 3; ++c)
+						EXPECT_NEAR(vert.normal[c], expected[c], 1e-6f);
+				}
+				for (int c = 0; c < 2; ++c)
+					EXPECT_FLOAT_EQ(vert.uv[c], uvs[v * 2 + c]);
+			}
+
+			const sh::render::SubMesh& subMesh = mesh.GetSubMeshes()[p];
+			if (primitive.indices >= 0)
+			{
+				const std::vector<float> expected = ScalarRead(gltfModel, gltfModel.accessors[primitive.indices]);
+				ASSERT_EQ(subMesh.indexCount, expected.size());
+				for (std::size_t i = 0; i < expected.size(); ++i)
+					EXPECT_EQ(indices[subMesh.indexOffset + i], static_cast<uint32_t>(expected[i]) + vertexStart);
+			}
+			else
+			{
+				ASSERT_EQ(subMesh.indexCount, vertexCount);
+				for (std::size_t i = 0; i < vertexCount; ++i)
+					EXPECT_EQ(indices[subMesh.indexOffset + i], i + vertexStart);
+			}
+			vertexStart += vertexCount;
+		}
+		EXPECT_EQ(vertexStart, verts.size());
+	}
+
+	/// @brief LoadGLTF(tinygltf::Model)에 접근하기 위한 로더
+	class TestModelLoader : public sh::game::ModelLoader
+	{
+	public:
+		TestModelLoader(const sh::render::IRenderContext& context) :
+			ModelLoader(context)
+		{
+			// 버텍스 순서가 그대로 남아야 기준 구현과 비교할 수 있다.
+			SetOptimizeMesh(false);
+			SetGenerateLods(false);
+		}
+		using ModelLoader::LoadGLTF;
+	};
+}//namespace
+
+TEST(ModelLoaderTest, ReadAccessor)
+{
+	using namespace modelLoaderTest;
+	const int types[] = {
+		TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE,
+		TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT,
+		TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT
+	};
+	// SIMD 한 번에 못 미치는 수, 벡터 루프 뒤에 꼬리가 남는 수
+	const std::size_t counts[] = { 1, 2, 7, 13, 37 };
+
+	tinygltf::Model model{};
+	std::vector<int> accessors;
+	uint32_t seed = 0;
+	for (int type : types)
+	{
+		const std::size_t elementSize = 3 * tinygltf::GetComponentSizeInBytes(type);
+		for (std::size_t count : counts)
+		{
+			for (bool bNormalized : { false, true })
+			{
+				if (bNormalized && type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
+					continue;
+				// 빽빽한 버퍼
+				const int packedView = AddView(model, MakeBytes(elementSize * count, ++seed));
+				accessors.push_back(AddAccessor(model, packedView, 0, type, TINYGLTF_TYPE_VEC3, count, bNormalized));
+				// 다른 데이터와 섞여있는 버퍼. 요소 앞뒤에 다른 바이트가 있다.
+				const std::size_t stride = (elementSize + 4 + 3) / 4 * 4;
+				const int interleavedView = AddView(model, MakeBytes(stride * count + 4, ++seed), stride);
+				accessors.push_back(AddAccessor(model, interleavedView, 4, type, TINYGLTF_TYPE_VEC3, count, bNormalized));
+			}
+		}
+	}
+	for (int accessor : accessors)
+		ExpectSameAsScalar(model, accessor);
+
+	// 정규화 규칙: 부호 있는 타입의 최소값은 -1로 잘린다.
+	std::vector<float> result;
+	const int bytes = AddAccessor(model, AddView(model, { 0x80, 0x81, 0x7f, 0x00 }), 0, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_TYPE_VEC4, 1, true);
+	ASSERT_TRUE(sh::game::ModelLoader::ReadGLTFAccessor(model, model.accessors[bytes], result));
+	EXPECT_FLOAT_EQ(result[0], -1.f);
+	EXPECT_FLOAT_EQ(result[1], -1.f);
+	EXPECT_FLOAT_EQ(result[2], 1.f);
+	EXPECT_FLOAT_EQ(result[3], 0.f);
+	const int shorts = AddAccessor(model, AddView(model, { 0x00, 0x80, 0xff, 0xff }), 0, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC2, 1, true);
+	ASSERT_TRUE(sh::game::ModelLoader::ReadGLTFAccessor(model, model.accessors[shorts], result));
+	EXPECT_FLOAT_EQ(result[0], 32768.f / 65535.f);
+	EXPECT_FLOAT_EQ(result[1], 1.f);
+
+	// 버퍼 범위를 벗어나는 액세서
+	const int outOfRange = AddAccessor(model, AddView(model, MakeBytes(10, 0)), 0, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_TYPE_VEC3, 2);
+	model.buffers[0].data.resize(model.bufferViews.back().byteOffset + 10);
+	EXPECT_FALSE(sh::game::ModelLoader::ReadGLTFAccessor(model, model.accessors[outOfRange], result));
+}
+
+TEST(ModelLoaderTest, LoadGLTF)
+{
+	using namespace modelLoaderTest;
+	if (!sh::core::ThreadPool::GetInstance()->IsInit())
+		sh::core::ThreadPool::GetInstance()->Init(4);
+
+	tinygltf::Model gltfModel{};
+	// 여러 메쉬, 여러 프리미티브가 스레드 풀에서 동시에 변환된다.
+	AddMeshNode(gltfModel, {
+		AddPrimitive(gltfModel, 13, true, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, 21, 1),
+		AddPrimitive(gltfModel, 37, false, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, 45, 2)
+	}, "mesh0");
+	AddMeshNode(gltfModel, {
+		AddPrimitive(gltfModel, 300, true, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, 99, 3)
+	}, "mesh1");
+	AddMeshNode(gltfModel, {
+		AddPrimitive(gltfModel, 9, false, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, 0, 0, 4)
+	}, "mesh2");
+
+	FakeRenderContext context{};
+	TestModelLoader loader{ context };
+	sh::render::Model* const model = loader.LoadGLTF(gltfModel, "synthetic", false);
+	ASSERT_NE(model, nullptr);
+	ASSERT_EQ(model->GetMeshes().size(), gltfModel.meshes.size());
+	for (std::size_t i = 0; i < gltfModel.meshes.size(); ++i)
+	{
+		const sh::render::Mesh* const mesh = model->GetMeshes()[i];
+		ASSERT_NE(mesh, nullptr);
+		EXPECT_EQ(mesh->GetName().ToString(), gltfModel.nodes[i].name);
+		EXPECT_TRUE(mesh->IsQuantized());
+		ExpectSameMesh(gltfModel, gltfModel.meshes[i], *mesh);
+	}
+	model->Destroy();
+
+	// 버텍스 범위를 벗어나는 인덱스가 있으면 실패한다.
+	tinygltf::Model invalidModel = gltfModel;
+	std::vector<unsigned char>& data = invalidModel.buffers[0].data;
+	const tinygltf::Accessor& indexAccessor = invalidModel.accessors[invalidModel.meshes[1].primitives[0].indices];
+	const std::size_t indexOffset = invalidModel.bufferViews[indexAccessor.bufferView].byteOffset + indexAccessor.byteOffset;
+	data[indexOffset] = 0xff;
+	data[indexOffset + 1] = 0xff;
+	EXPECT_EQ(loader.LoadGLTF(invalidModel, "invalid", false), nullptr);
+}
@@ -0,0 +1,314 @@
+﻿#pragma once
+#include "NetworkSimulationTest.hpp"
+#include "NetworkCodecTest.hpp"
+#include "ReliableUdpTest.hpp"
+#include "TcpSocketTest.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <iostream>
+
+// 전역 operator new를 바꾸므로 ShellEngineTest가 아닌 ShellEngineBenchmark 실행 파일에만 포함된다.
+namespace netSimTest
+{
+	/// @brief 현재 스레드에서 일어난 전역 operator new 호출 수.
+	/// @brief 윈도우에서는 DLL 안에서 일어난 할당은 세지 않으므로 리눅스 결과를 기준으로 본다.
+	inline thread_local uint64_t allocCount = 0;
+}//namespace
+
+void* operator new(std::size_t size)
+{
+	++netSimTest::allocCount;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+TEST(NetworkBenchmark, Codec)
+{
+	using namespace sh::network;
+	using namespace netSimTest;
+	constexpr int iterations = 200000;
+
+	SimTestPacket packet{};
+	packet.client = 3;
+	packet.payload.resize(64, 0xab);
+	SimTestPacket decoded{};
+	decoded.payload.reserve(512);
+	std::vector<uint8_t> buffer(Packet::MAX_PACKET_SIZE);
+	std::vector<uint8_t> anyBuffer;
+	anyBuffer.reserve(Packet::MAX_PACKET_SIZE);
+
+	const auto measure =
+		[&](const char* name, auto&& fn)
+		{
+			fn(0);
+			const uint64_t allocBegin = allocCount;
+			const auto begin = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < iterations; ++i)
+				fn(i);
+			const double ns = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count();
+			const double allocs = static_cast<double>(allocCount - allocBegin) / iterations;
+			std::cout << "[NetworkBenchmark] " << name << ": " << ns / iterations << "ns/packet, " << allocs << " allocs/packet\n";
+			return allocs;
+		};
+
+	std::size_t size = 0;
+	const double encodeAllocs = measure("Encode",
+		[&](int i)
+		{
+			packet.seq = static_cast<uint32_t>(i);
+			size = PacketCodec::Encode(packet, { buffer.data(), buffer.size() });
+		}
+	);
+	ASSERT_GT(size, 0u);
+	const double decodeAllocs = measure("Decode (in place)",
+		[&](int i)
+		{
+			PacketCodec::Decode(buffer.data(), size, decoded);
+		}
+	);
+	EXPECT_EQ(decoded.payload, packet.payload);
+	measure("EncodeAny",
+		[&](int i)
+		{
+			PacketCodec::EncodeAny(packet, anyBuffer);
+		}
+	);
+	measure("DecodeAny",
+		[&](int i)
+		{
+			auto result = PacketCodec::DecodeAny(buffer.data(), size);
+		}
+	);
+
+	// 미리 할당된 버퍼와 객체를 쓰는 경로는 할당이 없어야 한다.
+	EXPECT_EQ(encodeAllocs, 0.0);
+	EXPECT_EQ(decodeAllocs, 0.0);
+}
+
+TEST(NetworkBenchmark, BinaryVsBson)
+{
+	using namespace sh::network;
+	constexpr int count = 20000;
+
+	CodecTestPacket packet{};
+	packet.entity = 123;
+	packet.pos = { 10.f, 2.f, -35.f };
+	packet.rot = glm::normalize(glm::quat{ 0.9f, 0.1f, 0.3f, 0.f });
+	packet.hp = 55.f;
+	packet.flags = 3;
+	packet.name = "player";
+
+	std::array<uint8_t, Packet::MAX_PACKET_SIZE> buffer{};
+	std::size_t binarySize = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		packet.entity = i;
+		binarySize = PacketCodec::Encode(packet, { buffer.data(), buffer.size() });
+	}
+	auto binaryEncode = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	CodecTestPacket decoded{};
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; ++i)
+		PacketCodec::Decode(buffer.data(), binarySize, decoded);
+	auto binaryDecode = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::vector<uint8_t> bson;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		packet.entity = i;
+		bson = sh::core::Json::to_bson(packet.Serialize());
+	}
+	auto bsonEncode = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; ++i)
+		decoded.Deserialize(sh::core::Json::from_bson(bson));
+	auto bsonDecode = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << "[NetworkBenchmark] BinaryVsBson: " << count << " packets\n";
+	std::cout << "  binary: " << binarySize << " bytes, encode " << binaryEncode / count << "ns, decode " << binaryDecode / count << "ns\n";
+	std::cout << "  bson: " << bson.size() << " bytes, encode " << bsonEncode / count << "ns, decode " << bsonDecode / count << "ns\n";
+
+	EXPECT_LT(binarySize, bson.size() / 4);
+}
+
+TEST(NetworkBenchmark, ReliableThroughput)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Pair pair{ 0.02, 0.005, 0.05 };
+
+	constexpr uint32_t messageSize = 200;
+	constexpr uint32_t count = 20000;
+	std::vector<uint8_t> message(messageSize, 0xab);
+	std::vector<Connection::ReceivedMessage> messages;
+
+	uint32_t sent = 0;
+	uint32_t received = 0;
+	const auto start = std::chrono::high_resolution_clock::now();
+	while (received < count && pair.now < 120.0)
+	{
+		while (sent < count && pair.a.Send(RELIABLE_ORDERED, message.data(), message.size()))
+			++sent;
+		pair.Step(0.001);
+		messages.clear();
+		received += static_cast<uint32_t>(pair.b.PollMessages(messages));
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(received, count);
+
+	const double wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+	const auto& stats = pair.a.GetStats();
+	std::cout << "[NetworkBenchmark] ReliableThroughput: " << count << " x " << messageSize << "B reliable ordered, 5% loss: "
+		<< "simulated " << pair.now << "s (" << (count * messageSize / pair.now / 1024.0) << " KB/s), "
+		<< "wall " << wallMs << "ms (" << (wallMs * 1e6 / count) << " ns/msg), "
+		<< stats.sentDatagrams << " datagrams, " << stats.resentFragments << " resent, "
+		<< "rtt " << pair.a.GetRtt() * 1000.0 << "ms, rate " << pair.a.GetSendRate() / 1024.0 << " KB/s\n";
+}
+
+TEST(NetworkBenchmark, UdpThroughput)
+{
+	using namespace sh::network;
+	using namespace netSimTest;
+	constexpr std::size_t clientCount = 4;
+	constexpr uint32_t perClient = 5000;
+
+	UdpLoopbackHarness harness{ clientCount, NetworkSimulator::Settings{} };
+	ASSERT_TRUE(harness.IsOpen());
+
+	SimTestPacket packet{};
+	packet.payload.resize(64);
+	std::vector<NetworkContext::Message> messages;
+	messages.reserve(1024);
+	std::size_t received = 0;
+	uint64_t sendAllocs = 0;
+
+	const auto begin = Clock::now();
+	for (uint32_t seq = 0; seq < perClient; ++seq)
+	{
+		const double now = harness.Now();
+		const uint64_t allocBegin = allocCount;
+		for (std::size_t i = 0; i < clientCount; ++i)
+		{
+			packet.client = static_cast<uint32_t>(i);
+			packet.seq = seq;
+			harness.SendToServer(i, packet, now);
+		}
+		harness.Update(now);
+		sendAllocs += allocCount - allocBegin;
+		// 소켓 버퍼가 넘치지 않도록 중간에 받아간다.
+		if (seq % 16 == 0)
+		{
+			received += harness.PollServer(messages);
+			messages.clear();
+		}
+	}
+	const auto deadline = Clock::now() + std::chrono::seconds{ 2 };
+	while (received < clientCount * perClient && Clock::now() < deadline)
+	{
+		received += harness.PollServer(messages);
+		messages.clear();
+		std::this_thread::yield();
+	}
+	const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+	std::cout << "[NetworkBenchmark] UDP " << clientCount << " clients -> server: " << received << "/" << clientCount * perClient
+		<< " packets, " << static_cast<uint64_t>(received / seconds) << " packets/s, "
+		<< static_cast<double>(sendAllocs) / (clientCount * perClient) << " allocs/packet (send path)\n";
+	EXPECT_GT(received, clientCount * perClient / 2);
+}
+
+TEST(NetworkBenchmark, UdpLatency)
+{
+	using namespace sh::network;
+	using namespace netSimTest;
+	constexpr uint32_t count = 2000;
+
+	UdpLoopbackHarness harness{ 1, NetworkSimulator::Settings{} };
+	ASSERT_TRUE(harness.IsOpen());
+
+	SimTestPacket packet{};
+	std::vector<NetworkContext::Message> messages;
+	std::vector<double> rtts;
+	rtts.reserve(count);
+	for (uint32_t seq = 0; seq < count; ++seq)
+	{
+		packet.seq = seq;
+		const auto sendTime = Clock::now();
+		harness.SendToServer(0, packet, harness.Now());
+		harness.Update(harness.Now());
+
+		bool bEchoed = false;
+		bool bReceived = false;
+		const auto deadline = sendTime + std::chrono::milliseconds{ 100 };
+		while (!bReceived && Clock::now() < deadline)
+		{
+			messages.clear();
+			if (!bEchoed && harness.PollServer(messages) > 0)
+			{
+				harness.SendToClient(0, *messages.front().packet, harness.Now());
+				harness.Update(harness.Now());
+				bEchoed = true;
+			}
+			messages.clear();
+			if (bEchoed && harness.PollClient(0, messages) > 0)
+				bReceived = true;
+		}
+		if (bReceived)
+			rtts.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sendTime).count());
+	}
+	std::sort(rtts.begin(), rtts.end());
+	std::cout << "[NetworkBenchmark] UDP echo RTT (" << rtts.size() << "/" << count << "): p50 " << Percentile(rtts, 0.5)
+		<< "us, p99 " << Percentile(rtts, 0.99) << "us, p99.9 " << Percentile(rtts, 0.999)
+		<< "us, max " << (rtts.empty() ? 0.0 : rtts.back()) << "us\n";
+	EXPECT_GT(rtts.size(), count * 9 / 10);
+}
+
+TEST(NetworkBenchmark, TcpThroughput)
+{
+	using namespace sh::network;
+	using namespace tcpTest;
+	TcpPair pair{};
+	ASSERT_TRUE(pair.IsOpen());
+
+	for (std::size_t payloadSize : { 32, 1024, 64 * 1024 })
+	{
+		const std::size_t count = std::max<std::size_t>(64, (64 * 1024 * 1024) / (payloadSize * 16));
+		TcpBlobPacket packet{};
+		packet.payload.resize(payloadSize, 0x5a);
+
+		std::vector<std::unique_ptr<Packet>> received;
+		received.reserve(count);
+		const auto begin = Clock::now();
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			packet.seq = static_cast<uint32_t>(i);
+			pair.client->Send(packet);
+		}
+		ASSERT_EQ(TcpPair::Receive(*pair.serverQueue, count, received), count);
+		const double sec = std::chrono::duration<double>(Clock::now() - begin).count();
+		EXPECT_EQ(static_cast<TcpBlobPacket*>(received.back().get())->seq, count - 1);
+
+		std::cout << "[NetworkBenchmark] TcpThroughput: payload " << payloadSize << "B x " << count << ": "
+			<< count / sec << " msg/s, " << (count * payloadSize) / sec / (1024.0 * 1024.0) << " MB/s\n";
+	}
+}
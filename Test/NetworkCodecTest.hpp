@@ -0,0 +1,188 @@
+﻿#pragma once
+#include "Network/Packet.h"
+#include "Network/PacketCodec.h"
+#include "Network/StringPacket.h"
+
+#include <gtest/gtest.h>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <string>
+#include <array>
+
+class CodecTestPacket : public sh::network::Packet
+{
+	SPACKET(CodecTestPacket, 100)
+	SPACKET_CODEC()
+public:
+	auto GetId() const -> uint32_t override { return 100; }
+	auto Serialize() const -> sh::core::Json override
+	{
+		sh::core::Json json = Packet::Serialize();
+		json["entity"] = entity;
+		json["pos"] = { pos.x, pos.y, pos.z };
+		json["rot"] = { rot.x, rot.y, rot.z, rot.w };
+		json["hp"] = hp;
+		json["flags"] = flags;
+		json["name"] = name;
+		return json;
+	}
+	void Deserialize(const sh::core::Json& json) override
+	{
+		Packet::Deserialize(json);
+		entity = json["entity"];
+		pos = { json["pos"][0], json["pos"][1], json["pos"][2] };
+		rot = glm::quat{ json["rot"][3], json["rot"][0], json["rot"][1], json["rot"][2] };
+		hp = json["hp"];
+		flags = json["flags"];
+		name = json["name"];
+	}
+
+	template<typename Stream>
+	void Codec(Stream& stream)
+	{
+		stream.Varint(entity);
+		stream.QuantizedVec3(pos, -512.f, 512.f, 20);
+		stream.Quaternion(rot, 10);
+		stream.QuantizedFloat(hp, 0.f, 100.f, 8);
+		stream.Varint(flags);
+		stream.String(name, 32);
+	}
+public:
+	int32_t entity = 0;
+	glm::vec3 pos{ 0.f };
+	glm::quat rot{ 1.f, 0.f, 0.f, 0.f };
+	float hp = 100.f;
+	uint32_t flags = 0;
+	std::string name;
+};
+
+TEST(NetworkCodecTest, BitStream)
+{
+	using namespace sh::network;
+	std::array<uint8_t, 64> buffer{};
+	BitWriter writer{ buffer.data(), buffer.size() };
+
+	uint32_t bits = 5;
+	bool b = true;
+	int32_t negative = -12345;
+	uint64_t big = 1ull << 40;
+	float quantized = 12.3f;
+	writer.Bits(bits, 3);
+	writer.Boolean(b);
+	writer.Varint(negative);
+	writer.Varint(big);
+	writer.QuantizedFloat(quantized, -100.f, 100.f, 16);
+	const std::size_t size = writer.Flush();
+	EXPECT_FALSE(writer.IsOverflow());
+
+	BitReader reader{ buffer.data(), size };
+	uint32_t bits2 = 0;
+	bool b2 = false;
+	int32_t negative2 = 0;
+	uint64_t big2 = 0;
+	float quantized2 = 0.f;
+	reader.Bits(bits2, 3);
+	reader.Boolean(b2);
+	reader.Varint(negative2);
+	reader.Varint(big2);
+	reader.QuantizedFloat(quantized2, -100.f, 100.f, 16);
+	EXPECT_FALSE(reader.IsOverflow());
+	EXPECT_EQ(bits2, 5u);
+	EXPECT_TRUE(b2);
+	EXPECT_EQ(negative2, -12345);
+	EXPECT_EQ(big2, 1ull << 40);
+	EXPECT_NEAR(quantized2, 12.3f, 200.f / 65535.f);
+
+	// 작은 값은 1바이트
+	std::array<uint8_t, 8> small{};
+	BitWriter smallWriter{ small.data(), small.size() };
+	int32_t minusOne = -1;
+	smallWriter.Varint(minusOne);
+	EXPECT_EQ(smallWriter.Flush(), 1u);
+
+	// 버퍼가 부족하면 실패해야 한다.
+	std::string str = "hello world";
+	BitWriter overflowWriter{ small.data(), 4 };
+	EXPECT_FALSE(overflowWriter.String(str));
+	BitReader overflowReader{ buffer.data(), 1 };
+	EXPECT_FALSE(overflowReader.String(str));
+
+	// 최대 길이를 넘는 값은 잘라서 기록하지 않고 실패해야 한다.
+	std::array<uint8_t, 64> large{};
+	BitWriter longStringWriter{ large.data(), large.size() };
+	EXPECT_FALSE(longStringWriter.String(str, 5));
+	EXPECT_TRUE(longStringWriter.IsOverflow());
+	std::vector<uint8_t> bytes(6, 1);
+	BitWriter longBytesWriter{ large.data(), large.size() };
+	EXPECT_FALSE(longBytesWriter.Bytes(bytes, 5));
+	EXPECT_TRUE(longBytesWriter.IsOverflow());
+}
+
+TEST(NetworkCodecTest, PacketRoundTrip)
+{
+	using namespace sh::network;
+	CodecTestPacket packet{};
+	packet.entity = 4026;
+	packet.pos = { 12.5f, -3.25f, 400.f };
+	packet.rot = glm::normalize(glm::quat{ 0.3f, -0.7f, 0.2f, 0.6f });
+	packet.hp = 73.f;
+	packet.flags = 0b1011;
+	packet.name = "shell";
+
+	std::array<uint8_t, Packet::MAX_PACKET_SIZE> buffer{};
+	const std::size_t size = PacketCodec::Encode(packet, { buffer.data(), buffer.size() });
+	ASSERT_GT(size, 0u);
+	ASSERT_TRUE(PacketCodec::IsBinary(buffer.data(), size));
+
+	auto decoded = PacketCodec::Decode(buffer.data(), size);
+	ASSERT_NE(decoded, nullptr);
+	ASSERT_EQ(decoded->GetId(), 100u);
+	auto result = static_cast<CodecTestPacket*>(decoded.get());
+	EXPECT_EQ(result->entity, packet.entity);
+	EXPECT_NEAR(result->pos.x, packet.pos.x, 0.001f);
+	EXPECT_NEAR(result->pos.y, packet.pos.y, 0.001f);
+	EXPECT_NEAR(result->pos.z, packet.pos.z, 0.001f);
+	// q와 -q는 같은 회전
+	EXPECT_GT(std::abs(glm::dot(result->rot, packet.rot)), 0.999f);
+	EXPECT_NEAR(result->hp, packet.hp, 0.5f);
+	EXPECT_EQ(result->flags, packet.flags);
+	EXPECT_EQ(result->name, packet.name);
+
+	// 할당 없이 기존 객체로 읽기
+	CodecTestPacket reused{};
+	EXPECT_TRUE(PacketCodec::Decode(buffer.data(), size, reused));
+	EXPECT_EQ(reused.entity, packet.entity);
+	StringPacket wrongType{};
+	EXPECT_FALSE(PacketCodec::Decode(buffer.data(), size, wrongType));
+
+	// 잘린 데이터
+	EXPECT_EQ(PacketCodec::Decode(buffer.data(), size - 2), nullptr);
+	// 버퍼 부족
+	EXPECT_EQ(PacketCodec::Encode(packet, { buffer.data(), 8 }), 0u);
+
+	StringPacket strPacket{};
+	strPacket.SetString("binary string");
+	const std::size_t strSize = PacketCodec::Encode(strPacket, { buffer.data(), buffer.size() });
+	auto strDecoded = PacketCodec::Decode(buffer.data(), strSize);
+	ASSERT_NE(strDecoded, nullptr);
+	EXPECT_EQ(static_cast<StringPacket*>(strDecoded.get())->GetString(), "binary string");
+}
+
+TEST(NetworkCodecTest, BinarySmallerThanBson)
+{
+	using namespace sh::network;
+	CodecTestPacket packet{};
+	packet.entity = 123;
+	packet.pos = { 10.f, 2.f, -35.f };
+	packet.rot = glm::normalize(glm::quat{ 0.9f, 0.1f, 0.3f, 0.f });
+	packet.hp = 55.f;
+	packet.flags = 3;
+	packet.name = "player";
+
+	std::array<uint8_t, Packet::MAX_PACKET_SIZE> buffer{};
+	const std::size_t binarySize = PacketCodec::Encode(packet, { buffer.data(), buffer.size() });
+	const std::vector<uint8_t> bson = sh::core::Json::to_bson(packet.Serialize());
+	ASSERT_GT(binarySize, 0u);
+	EXPECT_LT(binarySize, bson.size() / 4);
+}
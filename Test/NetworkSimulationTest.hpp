@@ -0,0 +1,589 @@
+﻿#pragma once
+#include "Network/NetworkContext.h"
+#include "Network/NetworkSimulator.h"
+#include "Network/UdpSocket.h"
+#include "Network/TcpSocket.h"
+#include "Network/TcpListener.h"
+#include "Network/MessageQueue.h"
+#include "Network/PacketCodec.h"
+#include "Network/Endpoint.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <optional>
+#include <cstring>
+#include <iostream>
+
+class SimTestPacket : public sh::network::Packet
+{
+	SPACKET(SimTestPacket, 101)
+	SPACKET_CODEC()
+public:
+	auto GetId() const -> uint32_t override { return 101; }
+	auto Serialize() const -> sh::core::Json override
+	{
+		sh::core::Json json = Packet::Serialize();
+		json["client"] = client;
+		json["seq"] = seq;
+		json["payload"] = sh::core::Json::binary(payload);
+		return json;
+	}
+	void Deserialize(const sh::core::Json& json) override
+	{
+		Packet::Deserialize(json);
+		client = json["client"];
+		seq = json["seq"];
+		payload = json["payload"].get_binary();
+	}
+
+	template<typename Stream>
+	void Codec(Stream& stream)
+	{
+		stream.Varint(client);
+		stream.Varint(seq);
+		stream.Bytes(payload, 512);
+	}
+public:
+	uint32_t client = 0;
+	uint32_t seq = 0;
+	std::vector<uint8_t> payload;
+};
+
+namespace netSimTest
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// @brief 서버 UdpSocket 하나와 클라이언트 UdpSocket N개를 localhost에 열고, 모든 데이터그램이 방향별 NetworkSimulator를 거쳐 나가게 한다.
+	/// @brief 시뮬레이터는 링크마다 시드가 달라지며 손실, 중복, 순서는 시드로 정해진다. 실제 전송은 커널 루프백을 쓴다.
+	class UdpLoopbackHarness
+	{
+	public:
+		struct Client
+		{
+			std::unique_ptr<sh::network::UdpSocket> socket;
+			std::unique_ptr<sh::network::NetworkSimulator> up;
+			std::unique_ptr<sh::network::NetworkSimulator> down;
+			sh::network::Endpoint endpoint;
+		};
+	public:
+		UdpLoopbackHarness(std::size_t clientCount, const sh::network::NetworkSimulator::Settings& settings) :
+			server(ctx), start(Clock::now())
+		{
+			using namespace sh::network;
+			bOpen = server.Bind();
+			serverEndpoint = Endpoint::FromIPv4(0x7f000001, server.GetLocalPort());
+			clients.resize(clientCount);
+			for (std::size_t i = 0; i < clientCount; ++i)
+			{
+				Client& client = clients[i];
+				client.socket = std::make_unique<UdpSocket>(ctx);
+				bOpen &= client.socket->Bind();
+				client.endpoint = Endpoint::FromIPv4(0x7f000001, client.socket->GetLocalPort());
+				NetworkSimulator::Settings linkSettings = settings;
+				linkSettings.seed = settings.seed + static_cast<uint32_t>(i) * 2 + 1;
+				client.up = std::make_unique<NetworkSimulator>(linkSettings);
+				linkSettings.seed += 1;
+				client.down = std::make_unique<NetworkSimulator>(linkSettings);
+				clientIndices.insert({ client.endpoint, i });
+			}
+			networkThread = std::thread{ [this]() { ctx.Update(); } };
+		}
+		~UdpLoopbackHarness()
+		{
+			server.Close();
+			for (Client& client : clients)
+				client.socket->Close();
+			ctx.Stop();
+			networkThread.join();
+		}
+		auto IsOpen() const -> bool { return bOpen; }
+		/// @brief 하네스가 만들어진 뒤 지난 시간 (초)
+		auto Now() const -> double { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+		auto SendToServer(std::size_t client, const sh::network::Packet& packet, double now) -> bool
+		{
+			if (!sh::network::PacketCodec::EncodeAny(packet, scratch))
+				return false;
+			clients[client].up->Submit(scratch.data(), scratch.size(), now);
+			return true;
+		}
+		auto SendToClient(std::size_t client, const sh::network::Packet& packet, double now) -> bool
+		{
+			if (!sh::network::PacketCodec::EncodeAny(packet, scratch))
+				return false;
+			clients[client].down->Submit(scratch.data(), scratch.size(), now);
+			return true;
+		}
+		/// @brief 링크에서 도착한 데이터그램들을 실제 소켓으로 보낸다.
+		void Update(double now)
+		{
+			for (Client& client : clients)
+			{
+				client.up->Poll(now, [&](const uint8_t* data, std::size_t size) { client.socket->Enqueue(data, size, serverEndpoint); });
+				client.socket->Flush();
+				client.down->Poll(now, [&](const uint8_t* data, std::size_t size) { server.Enqueue(data, size, client.endpoint); });
+			}
+			server.Flush();
+		}
+		auto PollServer(std::vector<sh::network::NetworkContext::Message>& out) -> std::size_t
+		{
+			return server.GetReceivedMessages(out);
+		}
+		auto PollClient(std::size_t client, std::vector<sh::network::NetworkContext::Message>& out) -> std::size_t
+		{
+			return clients[client].socket->GetReceivedMessages(out);
+		}
+		/// @return 하네스의 클라이언트가 아니면 -1
+		auto GetClientIndex(const sh::network::Endpoint& endpoint) const -> int
+		{
+			auto it = clientIndices.find(endpoint);
+			return it == clientIndices.end() ? -1 : static_cast<int>(it->second);
+		}
+		auto GetClient(std::size_t client) const -> const Client& { return clients[client]; }
+	private:
+		sh::network::NetworkContext ctx;
+		sh::network::UdpSocket server;
+		sh::network::Endpoint serverEndpoint;
+		std::vector<Client> clients;
+		std::unordered_map<sh::network::Endpoint, std::size_t> clientIndices;
+		std::vector<uint8_t> scratch;
+		std::thread networkThread;
+		Clock::time_point start;
+		bool bOpen = false;
+	};
+
+	/// @brief TcpListener 하나와 TcpSocket 클라이언트 N개를 localhost에 연결한다.
+	/// @brief 스트림이므로 시뮬레이터는 순서를 지킨 채 지연과 지터만 준다. (NetworkSimulator::Settings::bStream)
+	class TcpLoopbackHarness
+	{
+	public:
+		TcpLoopbackHarness(std::size_t clientCount, sh::network::NetworkSimulator::Settings settings) :
+			listener(ctx), serverQueue(std::make_shared<sh::network::MessageQueue>()), start(Clock::now())
+		{
+			using namespace sh::network;
+			settings.bStream = true;
+			bOpen = listener.Listen(0);
+			networkThread = std::thread{ [this]() { ctx.Update(); } };
+			if (!bOpen)
+				return;
+
+			for (std::size_t i = 0; i < clientCount && bOpen; ++i)
+			{
+				auto queue = std::make_shared<MessageQueue>();
+				auto client = std::make_unique<TcpSocket>(ctx);
+				client->SetReceiveQueue(queue);
+				client->Connect("127.0.0.1", listener.GetLocalPort());
+
+				// 클라이언트 순서와 서버 쪽 소켓 순서를 맞추기 위해 하나씩 연결한다.
+				std::optional<TcpSocket> joined;
+				const auto deadline = Clock::now() + std::chrono::seconds{ 2 };
+				while (!joined.has_value() && Clock::now() < deadline)
+				{
+					joined = listener.GetJoinedSocket();
+					std::this_thread::yield();
+				}
+				if (!joined.has_value())
+				{
+					bOpen = false;
+					clients.push_back(std::move(client));
+					break;
+				}
+				// 비동기 핸들러가 this를 가지므로 자리를 잡은 뒤에 읽기 시작한다.
+				auto serverSide = std::make_unique<TcpSocket>(std::move(joined.value()));
+				serverSide->SetReceiveQueue(serverQueue);
+				serverSide->ReadStart();
+				clientIndices.insert({ Endpoint::FromString(serverSide->GetIp(), serverSide->GetPort()), i });
+
+				NetworkSimulator::Settings linkSettings = settings;
+				linkSettings.seed = settings.seed + static_cast<uint32_t>(i) * 2 + 1;
+				up.push_back(std::make_unique<NetworkSimulator>(linkSettings));
+				linkSettings.seed += 1;
+				down.push_back(std::make_unique<NetworkSimulator>(linkSettings));
+
+				clients.push_back(std::move(client));
+				clientQueues.push_back(std::move(queue));
+				serverSockets.push_back(std::move(serverSide));
+			}
+		}
+		~TcpLoopbackHarness()
+		{
+			for (auto& socket : clients)
+				socket->Close();
+			for (auto& socket : serverSockets)
+				socket->Close();
+			ctx.Stop();
+			networkThread.join();
+		}
+		auto IsOpen() const -> bool { return bOpen; }
+		auto Now() const -> double { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+		auto SendToServer(std::size_t client, const sh::network::Packet& packet, double now) -> bool
+		{
+			if (!sh::network::PacketCodec::EncodeAny(packet, scratch))
+				return false;
+			up[client]->Submit(scratch.data(), scratch.size(), now);
+			return true;
+		}
+		auto SendToClient(std::size_t client, const sh::network::Packet& packet, double now) -> bool
+		{
+			if (!sh::network::PacketCodec::EncodeAny(packet, scratch))
+				return false;
+			down[client]->Submit(scratch.data(), scratch.size(), now);
+			return true;
+		}
+		void Update(double now)
+		{
+			using namespace sh::network;
+			for (std::size_t i = 0; i < clients.size() && i < serverSockets.size(); ++i)
+			{
+				up[i]->Poll(now,
+					[&](const uint8_t* data, std::size_t size)
+					{
+						if (auto packet = PacketCodec::DecodeAny(data, size))
+							clients[i]->Send(*packet);
+					}
+				);
+				down[i]->Poll(now,
+					[&](const uint8_t* data, std::size_t size)
+					{
+						if (auto packet = PacketCodec::DecodeAny(data, size))
+							serverSockets[i]->Send(*packet);
+					}
+				);
+			}
+		}
+		auto PollServer(std::vector<sh::network::NetworkContext::Message>& out) -> std::size_t
+		{
+			return Drain(*serverQueue, out);
+		}
+		auto PollClient(std::size_t client, std::vector<sh::network::NetworkContext::Message>& out) -> std::size_t
+		{
+			return Drain(*clientQueues[client], out);
+		}
+		auto GetClientIndex(const sh::network::Endpoint& endpoint) const -> int
+		{
+			auto it = clientIndices.find(endpoint);
+			return it == clientIndices.end() ? -1 : static_cast<int>(it->second);
+		}
+	private:
+		static auto Drain(sh::network::MessageQueue& queue, std::vector<sh::network::NetworkContext::Message>& out) -> std::size_t
+		{
+			std::size_t count = 0;
+			while (auto msg = queue.Pop())
+			{
+				out.push_back(std::move(msg.value()));
+				++count;
+			}
+			return count;
+		}
+	private:
+		sh::network::NetworkContext ctx;
+		sh::network::TcpListener listener;
+		std::vector<std::unique_ptr<sh::network::TcpSocket>> clients;
+		std::vector<std::unique_ptr<sh::network::TcpSocket>> serverSockets;
+		std::shared_ptr<sh::network::MessageQueue> serverQueue;
+		std::vector<std::shared_ptr<sh::network::MessageQueue>> clientQueues;
+		std::vector<std::unique_ptr<sh::network::NetworkSimulator>> up;
+		std::vector<std::unique_ptr<sh::network::NetworkSimulator>> down;
+		std::unordered_map<sh::network::Endpoint, std::size_t> clientIndices;
+		std::vector<uint8_t> scratch;
+		std::thread networkThread;
+		Clock::time_point start;
+		bool bOpen = false;
+	};
+
+	inline auto Percentile(std::vector<double>& sorted, double p) -> double
+	{
+		if (sorted.empty())
+			return 0.0;
+		const std::size_t idx = std::min(sorted.size() - 1, static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5));
+		return sorted[idx];
+	}
+}//namespace
+
+TEST(NetworkSimulationTest, SimulatorIsDeterministic)
+{
+	using namespace sh::network;
+	NetworkSimulator::Settings settings{};
+	settings.latency = 0.02;
+	settings.jitter = 0.01;
+	settings.loss = 0.1f;
+	settings.duplicate = 0.05f;
+	settings.reorder = 0.05f;
+	settings.seed = 42;
+
+	const auto run =
+		[](NetworkSimulator& sim)
+		{
+			std::vector<uint32_t> delivered;
+			for (uint32_t i = 0; i < 2000; ++i)
+			{
+				const double now = i * 0.001;
+				sim.Submit(reinterpret_cast<const uint8_t*>(&i), sizeof(i), now);
+				sim.Poll(now,
+					[&](const uint8_t* data, std::size_t size)
+					{
+						uint32_t value;
+						std::memcpy(&value, data, sizeof(value));
+						delivered.push_back(value);
+					}
+				);
+			}
+			return delivered;
+		};
+
+	NetworkSimulator a{ settings };
+	NetworkSimulator b{ settings };
+	const std::vector<uint32_t> resultA = run(a);
+	EXPECT_EQ(resultA, run(b));
+
+	// Reset() 뒤에는 처음과 같은 결과
+	a.Reset();
+	EXPECT_EQ(resultA, run(a));
+
+	settings.seed = 43;
+	NetworkSimulator c{ settings };
+	EXPECT_NE(resultA, run(c));
+}
+
+TEST(NetworkSimulationTest, SimulatorImpairments)
+{
+	using namespace sh::network;
+	constexpr uint32_t count = 20000;
+	NetworkSimulator::Settings settings{};
+	settings.latency = 0.05;
+	settings.jitter = 0.02;
+	settings.loss = 0.1f;
+	settings.duplicate = 0.02f;
+	settings.reorder = 0.03f;
+
+	NetworkSimulator sim{ settings };
+	uint32_t prev = 0;
+	uint32_t outOfOrder = 0;
+	double lastTime = 0.0;
+	double minDelay = 1.0;
+	std::vector<double> sendTimes;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const double now = i * 0.0001;
+		sendTimes.push_back(now);
+		sim.Submit(reinterpret_cast<const uint8_t*>(&i), sizeof(i), now);
+		sim.Poll(now,
+			[&](const uint8_t* data, std::size_t size)
+			{
+				uint32_t value;
+				std::memcpy(&value, data, sizeof(value));
+				if (value < prev)
+					++outOfOrder;
+				prev = value;
+				minDelay = std::min(minDelay, now - sendTimes[value]);
+			}
+		);
+		lastTime = now;
+	}
+	sim.Poll(lastTime + 1.0, [](const uint8_t*, std::size_t) {});
+	const auto& stats = sim.GetStats();
+	EXPECT_EQ(stats.submitted, count);
+	EXPECT_NEAR(static_cast<double>(stats.dropped) / count, 0.1, 0.01);
+	EXPECT_NEAR(static_cast<double>(stats.duplicated) / count, 0.02 * 0.9, 0.005);
+	EXPECT_EQ(stats.delivered, stats.submitted - stats.dropped + stats.duplicated);
+	EXPECT_GT(outOfOrder, 0u);
+	EXPECT_GE(minDelay, settings.latency - 0.0001);
+	EXPECT_EQ(sim.GetInFlightCount(), 0u);
+
+	// 순서 뒤바뀜이 없으면 지터가 있어도 보낸 순서대로 도착한다.
+	settings.reorder = 0.f;
+	settings.duplicate = 0.f;
+	NetworkSimulator ordered{ settings };
+	prev = 0;
+	outOfOrder = 0;
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		ordered.Submit(reinterpret_cast<const uint8_t*>(&i), sizeof(i), i * 0.0001);
+		ordered.Poll(i * 0.0001,
+			[&](const uint8_t* data, std::size_t size)
+			{
+				uint32_t value;
+				std::memcpy(&value, data, sizeof(value));
+				if (value < prev)
+					++outOfOrder;
+				prev = value;
+			}
+		);
+	}
+	EXPECT_EQ(outOfOrder, 0u);
+
+	// 스트림은 손실 없이 순서대로
+	settings.bStream = true;
+	settings.reorder = 0.5f;
+	NetworkSimulator stream{ settings };
+	for (uint32_t i = 0; i < 1000; ++i)
+		stream.Submit(reinterpret_cast<const uint8_t*>(&i), sizeof(i), i * 0.001);
+	uint32_t expected = 0;
+	stream.Poll(10.0,
+		[&](const uint8_t* data, std::size_t size)
+		{
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			EXPECT_EQ(value, expected);
+			++expected;
+		}
+	);
+	EXPECT_EQ(expected, 1000u);
+}
+
+TEST(NetworkSimulationTest, UdpServerAndClients)
+{
+	using namespace sh::network;
+	using namespace netSimTest;
+	constexpr std::size_t clientCount = 8;
+	constexpr uint32_t perClient = 200;
+
+	NetworkSimulator::Settings settings{};
+	settings.latency = 0.01;
+	settings.jitter = 0.005;
+	settings.loss = 0.05f;
+	settings.duplicate = 0.02f;
+	settings.reorder = 0.02f;
+	settings.seed = 7;
+	UdpLoopbackHarness harness{ clientCount, settings };
+	ASSERT_TRUE(harness.IsOpen());
+
+	SimTestPacket packet{};
+	packet.payload.resize(64);
+	std::vector<NetworkContext::Message> messages;
+	std::vector<uint32_t> serverReceived(clientCount, 0);
+	std::vector<uint32_t> clientReceived(clientCount, 0);
+
+	const auto process =
+		[&](double now)
+		{
+			harness.Update(now);
+			messages.clear();
+			harness.PollServer(messages);
+			for (auto& msg : messages)
+			{
+				const int client = harness.GetClientIndex(msg.sender);
+				ASSERT_GE(client, 0);
+				auto received = static_cast<SimTestPacket*>(msg.packet.get());
+				EXPECT_EQ(received->client, static_cast<uint32_t>(client));
+				++serverReceived[client];
+				// 서버는 받은 패킷을 되돌려 보낸다.
+				harness.SendToClient(client, *received, now);
+			}
+			for (std::size_t i = 0; i < clientCount; ++i)
+			{
+				messages.clear();
+				clientReceived[i] += static_cast<uint32_t>(harness.PollClient(i, messages));
+			}
+		};
+
+	for (uint32_t seq = 0; seq < perClient; ++seq)
+	{
+		const double now = harness.Now();
+		for (std::size_t i = 0; i < clientCount; ++i)
+		{
+			packet.client = static_cast<uint32_t>(i);
+			packet.seq = seq;
+			ASSERT_TRUE(harness.SendToServer(i, packet, now));
+		}
+		process(now);
+		std::this_thread::sleep_for(std::chrono::microseconds{ 200 });
+	}
+
+	const auto isDone =
+		[&]()
+		{
+			for (std::size_t i = 0; i < clientCount; ++i)
+			{
+				const auto& client = harness.GetClient(i);
+				if (serverReceived[i] < client.up->GetStats().delivered ||
+					clientReceived[i] < client.down->GetStats().delivered ||
+					client.up->GetInFlightCount() > 0 || client.down->GetInFlightCount() > 0)
+					return false;
+			}
+			return true;
+		};
+	const auto deadline = Clock::now() + std::chrono::seconds{ 3 };
+	while (!isDone() && Clock::now() < deadline)
+	{
+		process(harness.Now());
+		std::this_thread::sleep_for(std::chrono::microseconds{ 200 });
+	}
+
+	// 시뮬레이터가 내보낸 만큼 정확히 도착해야 한다. (루프백 자체는 손실이 없다고 가정)
+	for (std::size_t i = 0; i < clientCount; ++i)
+	{
+		const auto& up = harness.GetClient(i).up->GetStats();
+		const auto& down = harness.GetClient(i).down->GetStats();
+		EXPECT_EQ(up.submitted, perClient);
+		EXPECT_EQ(serverReceived[i], up.delivered);
+		EXPECT_EQ(up.delivered, up.submitted - up.dropped + up.duplicated);
+		EXPECT_EQ(down.submitted, serverReceived[i]);
+		EXPECT_EQ(clientReceived[i], down.delivered);
+	}
+}
+
+TEST(NetworkSimulationTest, TcpServerAndClients)
+{
+	using namespace sh::network;
+	using namespace netSimTest;
+	constexpr std::size_t clientCount = 4;
+	constexpr uint32_t perClient = 100;
+
+	NetworkSimulator::Settings settings{};
+	settings.latency = 0.02;
+	settings.jitter = 0.01;
+	// 스트림에서는 무시된다.
+	settings.loss = 0.5f;
+	TcpLoopbackHarness harness{ clientCount, settings };
+	ASSERT_TRUE(harness.IsOpen());
+
+	SimTestPacket packet{};
+	std::vector<double> sendTimes(perClient);
+	const double start = harness.Now();
+	for (uint32_t seq = 0; seq < perClient; ++seq)
+	{
+		sendTimes[seq] = harness.Now();
+		for (std::size_t i = 0; i < clientCount; ++i)
+		{
+			packet.client = static_cast<uint32_t>(i);
+			packet.seq = seq;
+			ASSERT_TRUE(harness.SendToServer(i, packet, sendTimes[seq]));
+		}
+		harness.Update(harness.Now());
+	}
+
+	std::vector<uint32_t> nextSeq(clientCount, 0);
+	std::vector<NetworkContext::Message> messages;
+	double minLatency = 1.0;
+	std::size_t received = 0;
+	const auto deadline = Clock::now() + std::chrono::seconds{ 3 };
+	while (received < clientCount * perClient && Clock::now() < deadline)
+	{
+		const double now = harness.Now();
+		harness.Update(now);
+		messages.clear();
+		harness.PollServer(messages);
+		for (auto& msg : messages)
+		{
+			const int client = harness.GetClientIndex(msg.sender);
+			ASSERT_GE(client, 0);
+			auto receivedPacket = static_cast<SimTestPacket*>(msg.packet.get());
+			EXPECT_EQ(receivedPacket->client, static_cast<uint32_t>(client));
+			EXPECT_EQ(receivedPacket->seq, nextSeq[client]);
+			nextSeq[client] = receivedPacket->seq + 1;
+			minLatency = std::min(minLatency, now - sendTimes[receivedPacket->seq]);
+			++received;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds{ 200 });
+	}
+	EXPECT_EQ(received, clientCount * perClient);
+	EXPECT_GE(minLatency, settings.latency);
+	EXPECT_GT(harness.Now() - start, settings.latency);
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+#include "Physics/PhysWorld.h"
+#include "Core/ThreadPool.h"
+
+#include "reactphysics3d/reactphysics3d.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace physWorldTest
+{
+	inline void InitThreadPool()
+	{
+		auto threadPool = sh::core::ThreadPool::GetInstance();
+		if (!threadPool->IsInit())
+			threadPool->Init(4);
+	}
+}//namespace
+
+TEST(PhysWorldTest, AsyncStepWriteOrder)
+{
+	using namespace sh;
+	physWorldTest::InitThreadPool();
+
+	phys::PhysWorld physWorld;
+	physWorld.SetAsyncStep(true);
+
+	std::vector<int> order;
+	physWorld.BeginStep(0.0166f);
+	physWorld.Write([&] { order.push_back(0); });
+	physWorld.EndStep();
+	// EndStep에서 밀린 쓰기가 반영되어야 이후 쓰기보다 먼저 적용된다.
+	physWorld.Write([&] { order.push_back(1); });
+
+	physWorld.BeginStep(0.0166f);
+	physWorld.Write([&] { order.push_back(2); });
+	physWorld.WaitForStep();
+	physWorld.Write([&] { order.push_back(3); });
+	physWorld.EndStep();
+	physWorld.WaitForStep();
+
+	ASSERT_EQ(order.size(), 4);
+	for (int i = 0; i < 4; ++i)
+		EXPECT_EQ(order[i], i);
+}
+
+TEST(PhysWorldTest, ReadAfterWriteDuringStep)
+{
+	using namespace sh;
+	physWorldTest::InitThreadPool();
+
+	phys::PhysWorld physWorld;
+	physWorld.SetAsyncStep(true);
+	auto world = reinterpret_cast<reactphysics3d::PhysicsWorld*>(physWorld.GetNative());
+	auto body = world->createRigidBody(reactphysics3d::Transform::identity());
+	body->setType(reactphysics3d::BodyType::DYNAMIC);
+	body->enableGravity(false);
+
+	// 스텝 도중의 쓰기는 밀리고, 읽기는 스텝을 끝내고 밀린 쓰기를 반영한 값을 본다.
+	physWorld.BeginStep(0.0166f);
+	ASSERT_TRUE(physWorld.IsStepping());
+	physWorld.Write([body] { body->setLinearVelocity({ 1.f, 2.f, 3.f }); });
+	phys::PhysWorld::BodyState state{};
+	physWorld.ReadBodyState(body, state);
+	EXPECT_FALSE(physWorld.IsStepping());
+	EXPECT_FLOAT_EQ(state.linearVelocity.x, 1.f);
+	EXPECT_FLOAT_EQ(state.linearVelocity.y, 2.f);
+	EXPECT_FLOAT_EQ(state.linearVelocity.z, 3.f);
+
+	// 스텝이 끝났으므로 이후 쓰기는 바로 적용된다.
+	physWorld.Write([body] { body->setLinearVelocity({ 4.f, 5.f, 6.f }); });
+	physWorld.ReadBodyState(body, state);
+	EXPECT_FLOAT_EQ(state.linearVelocity.x, 4.f);
+
+	// WaitForStep()도 스텝을 끝내고 스냅샷을 교체한다.
+	physWorld.BeginStep(0.0166f);
+	physWorld.Write([body] { body->setLinearVelocity({ 7.f, 8.f, 9.f }); });
+	physWorld.WaitForStep();
+	EXPECT_FALSE(physWorld.IsStepping());
+	const phys::PhysWorld::BodyState* const snapshot = physWorld.GetBodyState(body);
+	ASSERT_NE(snapshot, nullptr);
+	EXPECT_FLOAT_EQ(snapshot->linearVelocity.x, 4.f);
+	physWorld.ReadBodyState(body, state);
+	EXPECT_FLOAT_EQ(state.linearVelocity.x, 7.f);
+	EXPECT_FLOAT_EQ(state.linearVelocity.z, 9.f);
+
+	// 이미 끝난 스텝에는 아무것도 하지 않는다.
+	physWorld.EndStep();
+	physWorld.ReadBodyState(body, state);
+	EXPECT_FLOAT_EQ(state.linearVelocity.y, 8.f);
+}
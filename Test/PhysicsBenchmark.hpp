@@ -0,0 +1,47 @@
+﻿#pragma once
+#include "PhysicsQueryTest.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+
+TEST(PhysicsBenchmark, RayCastBatch)
+{
+	using namespace sh;
+	constexpr int bodyCount = 5000;
+	constexpr int rayCount = 10000;
+
+	auto threadPool = core::ThreadPool::GetInstance();
+	if (!threadPool->IsInit())
+		threadPool->Init(4);
+
+	phys::PhysWorld physWorld;
+	std::mt19937 rng{ 4026 };
+	CreateRandomBodies(physWorld, bodyCount, rng);
+	physWorld.Update(0.0166f);
+
+	const auto queries = MakeRandomRays(rayCount, rng);
+	std::vector<phys::HitPoint> results(rayCount);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	const std::vector<void*> expected = RayCastEach(physWorld, queries);
+	auto singleTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	// 첫 호출은 스냅샷을 만든다.
+	start = std::chrono::high_resolution_clock::now();
+	physWorld.RayCastBatch({ queries.data(), queries.size() }, { results.data(), results.size() });
+	auto firstBatchTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	uint32_t hitCount = physWorld.RayCastBatch({ queries.data(), queries.size() }, { results.data(), results.size() });
+	auto batchTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << "[PhysicsBenchmark] " << rayCount << " rays, " << bodyCount << " bodies\n";
+	std::cout << "  RayCast loop: " << singleTime << "us\n";
+	std::cout << "  RayCastBatch (with snapshot build): " << firstBatchTime << "us\n";
+	std::cout << "  RayCastBatch: " << batchTime << "us\n";
+
+	ExpectSameHits(expected, results, hitCount);
+}
@@ -0,0 +1,178 @@
+﻿#pragma once
+#include "Physics/PhysWorld.h"
+#include "Physics/QuerySnapshot.h"
+#include "Core/ThreadPool.h"
+
+#include "reactphysics3d/reactphysics3d.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace
+{
+	auto MakeSphereShape(const glm::vec3& pos, float radius, void* handle) -> sh::phys::QuerySnapshot::Shape
+	{
+		sh::phys::QuerySnapshot::Shape shape{};
+		shape.type = sh::phys::QuerySnapshot::ShapeType::Sphere;
+		shape.position = pos;
+		shape.rotation = glm::quat{ 1.f, 0.f, 0.f, 0.f };
+		shape.extents = { radius, 0.f, 0.f };
+		shape.aabbMin = pos - glm::vec3{ radius };
+		shape.aabbMax = pos + glm::vec3{ radius };
+		shape.rigidBodyHandle = handle;
+		return shape;
+	}
+	auto MakeBoxShape(const glm::vec3& pos, const glm::vec3& half, void* handle) -> sh::phys::QuerySnapshot::Shape
+	{
+		sh::phys::QuerySnapshot::Shape shape{};
+		shape.type = sh::phys::QuerySnapshot::ShapeType::Box;
+		shape.position = pos;
+		shape.rotation = glm::quat{ 1.f, 0.f, 0.f, 0.f };
+		shape.extents = half;
+		shape.aabbMin = pos - half;
+		shape.aabbMax = pos + half;
+		shape.rigidBodyHandle = handle;
+		return shape;
+	}
+	/// @brief 구, 박스, 캡슐을 번갈아 가진 정적 바디들을 -200 ~ 200 범위의 무작위 위치에 만든다.
+	void CreateRandomBodies(sh::phys::PhysWorld& physWorld, int count, std::mt19937& rng)
+	{
+		auto ctx = reinterpret_cast<reactphysics3d::PhysicsCommon*>(physWorld.GetContext());
+		auto world = reinterpret_cast<reactphysics3d::PhysicsWorld*>(physWorld.GetNative());
+		std::uniform_real_distribution<float> posDist{ -200.f, 200.f };
+
+		reactphysics3d::CollisionShape* const shapes[3] = {
+			ctx->createSphereShape(1.5f),
+			ctx->createBoxShape({ 1.f, 2.f, 1.5f }),
+			ctx->createCapsuleShape(0.5f, 2.f)
+		};
+		for (int i = 0; i < count; ++i)
+		{
+			reactphysics3d::Transform transform{ { posDist(rng), posDist(rng), posDist(rng) }, reactphysics3d::Quaternion::identity() };
+			auto body = world->createRigidBody(transform);
+			body->setType(reactphysics3d::BodyType::STATIC);
+			body->addCollider(shapes[i % 3], reactphysics3d::Transform::identity());
+		}
+	}
+	auto MakeRandomRays(int count, std::mt19937& rng) -> std::vector<sh::phys::RayQuery>
+	{
+		std::uniform_real_distribution<float> posDist{ -200.f, 200.f };
+		std::uniform_real_distribution<float> dirDist{ -1.f, 1.f };
+		std::vector<sh::phys::RayQuery> queries(count);
+		for (auto& query : queries)
+		{
+			query.origin = { posDist(rng), posDist(rng), posDist(rng) };
+			query.direction = glm::vec3{ dirDist(rng), dirDist(rng), dirDist(rng) } + glm::vec3{ 0.f, 0.f, 1e-3f };
+			query.distance = 300.f;
+		}
+		return queries;
+	}
+	/// @brief 레이마다 RayCast를 호출해 가장 가까운 바디를 구한다. 맞은 것이 없으면 nullptr
+	auto RayCastEach(sh::phys::PhysWorld& physWorld, const std::vector<sh::phys::RayQuery>& queries) -> std::vector<void*>
+	{
+		std::vector<void*> closest(queries.size(), nullptr);
+		for (std::size_t i = 0; i < queries.size(); ++i)
+		{
+			const auto& q = queries[i];
+			sh::phys::Ray ray{ sh::game::Vec3{ q.origin }, sh::game::Vec3{ q.direction }, q.distance };
+			auto hits = physWorld.RayCast(ray);
+			if (!hits.empty())
+				closest[i] = hits.front().rigidBodyHandle;
+		}
+		return closest;
+	}
+	/// @brief RayCastBatch 결과가 RayCast를 하나씩 호출한 결과와 같은지 확인한다.
+	void ExpectSameHits(const std::vector<void*>& expected, const std::vector<sh::phys::HitPoint>& results, uint32_t hitCount)
+	{
+		const int rayCount = static_cast<int>(expected.size());
+		uint32_t expectedHitCount = 0;
+		int mismatch = 0;
+		for (int i = 0; i < rayCount; ++i)
+		{
+			if (expected[i] != nullptr)
+				++expectedHitCount;
+			if (expected[i] != results[i].rigidBodyHandle)
+				++mismatch;
+		}
+		// 부동소수 오차로 경계에서 스치는 레이만 다를 수 있다.
+		EXPECT_LE(std::abs(static_cast<int>(hitCount) - static_cast<int>(expectedHitCount)), rayCount / 1000);
+		EXPECT_LE(mismatch, rayCount / 1000);
+	}
+}
+
+TEST(PhysicsQueryTest, SnapshotRayCastFindsClosestShape)
+{
+	using namespace sh::phys;
+	int nearHandle = 0, farHandle = 0;
+	QuerySnapshot snapshot;
+	snapshot.AddShape(MakeSphereShape({ 0.f, 0.f, 20.f }, 1.f, &farHandle));
+	snapshot.AddShape(MakeBoxShape({ 0.f, 0.f, 10.f }, { 1.f, 1.f, 1.f }, &nearHandle));
+	snapshot.Build();
+
+	HitPoint hit{};
+	ASSERT_TRUE(snapshot.RayCast(RayQuery{ { 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, 100.f }, hit));
+	EXPECT_EQ(hit.rigidBodyHandle, &nearHandle);
+	EXPECT_NEAR(hit.fraction, 0.09f, 1e-4f);
+	EXPECT_NEAR(hit.hitNormal.z, -1.f, 1e-4f);
+
+	// 태그로 걸러지면 뒤의 구에 닿는다.
+	QuerySnapshot tagged;
+	auto box = MakeBoxShape({ 0.f, 0.f, 10.f }, { 1.f, 1.f, 1.f }, &nearHandle);
+	box.category = Tag::Tag2;
+	tagged.AddShape(box);
+	tagged.AddShape(MakeSphereShape({ 0.f, 0.f, 20.f }, 1.f, &farHandle));
+	tagged.Build();
+	ASSERT_TRUE(tagged.RayCast(RayQuery{ { 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, 100.f, Tag::Tag1 }, hit));
+	EXPECT_EQ(hit.rigidBodyHandle, &farHandle);
+	EXPECT_NEAR(hit.hitPoint.z, 19.f, 1e-4f);
+
+	EXPECT_FALSE(snapshot.RayCast(RayQuery{ { 0.f, 5.f, 0.f }, { 0.f, 0.f, 1.f }, 100.f }, hit));
+}
+
+TEST(PhysicsQueryTest, SnapshotSphereCastAndOverlap)
+{
+	using namespace sh::phys;
+	int boxHandle = 0, sphereHandle = 0;
+	QuerySnapshot snapshot;
+	snapshot.AddShape(MakeBoxShape({ 0.f, 0.f, 10.f }, { 1.f, 1.f, 1.f }, &boxHandle));
+	snapshot.AddShape(MakeSphereShape({ 5.f, 0.f, 0.f }, 1.f, &sphereHandle));
+	snapshot.Build();
+
+	HitPoint hit{};
+	// 면에 닿는 경우
+	ASSERT_TRUE(snapshot.SphereCast(SphereCastQuery{ { 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, 0.5f, 100.f }, hit));
+	EXPECT_EQ(hit.rigidBodyHandle, &boxHandle);
+	EXPECT_NEAR(hit.fraction * 100.f, 8.5f, 1e-3f);
+	// 모서리를 스치는 경우: 확장된 박스의 꼭짓점 영역이 아니라 둥근 모서리에 닿아야 한다.
+	ASSERT_TRUE(snapshot.SphereCast(SphereCastQuery{ { 1.3f, 1.3f, 0.f }, { 0.f, 0.f, 1.f }, 0.5f, 100.f }, hit));
+	EXPECT_GT(hit.fraction * 100.f, 8.5f);
+	EXPECT_FALSE(snapshot.SphereCast(SphereCastQuery{ { 1.3f, 1.3f, 0.f }, { 0.f, 0.f, 1.f }, 0.5f, 5.f }, hit));
+
+	void* bodies[4]{};
+	EXPECT_EQ(snapshot.Overlap(OverlapQuery{ { 3.5f, 0.f, 0.f }, 1.f }, bodies, 4), 1u);
+	EXPECT_EQ(bodies[0], &sphereHandle);
+	EXPECT_EQ(snapshot.Overlap(OverlapQuery{ { 2.5f, 0.f, 5.f }, 100.f }, bodies, 4), 2u);
+	EXPECT_EQ(snapshot.Overlap(OverlapQuery{ { 2.5f, 0.f, 5.f }, 100.f }, bodies, 1), 1u);
+}
+
+TEST(PhysicsQueryTest, RayCastBatchMatchesRayCast)
+{
+	using namespace sh;
+	auto threadPool = core::ThreadPool::GetInstance();
+	if (!threadPool->IsInit())
+		threadPool->Init(4);
+
+	phys::PhysWorld physWorld;
+	std::mt19937 rng{ 4026 };
+	CreateRandomBodies(physWorld, 1000, rng);
+	physWorld.Update(0.0166f);
+
+	// 여러 구간으로 나눠 처리되도록 충분히 많은 레이를 쏜다.
+	const auto queries = MakeRandomRays(2000, rng);
+	const std::vector<void*> expected = RayCastEach(physWorld, queries);
+	std::vector<phys::HitPoint> results(queries.size());
+	const uint32_t hitCount = physWorld.RayCastBatch({ queries.data(), queries.size() }, { results.data(), results.size() });
+	ExpectSameHits(expected, results, hitCount);
+}
@@ -0,0 +1,394 @@
+﻿#pragma once
+#include "Network/Connection.h"
+#include "Network/ConnectionPacket.h"
+#include "Network/ConnectionHost.h"
+#include "Network/UdpSocket.h"
+#include "Network/NetworkContext.h"
+#include "Network/PacketCodec.h"
+#include "Network/BitStream.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+namespace reliableTest
+{
+	/// @brief 지연, 지터, 손실을 흉내 내는 단방향 링크. bReorder가 false면 실제 경로처럼 보낸 순서대로 도착한다.
+	struct LossyLink
+	{
+		struct InFlight
+		{
+			double arriveTime;
+			std::vector<uint8_t> data;
+		};
+		double latency = 0.05;
+		double jitter = 0.01;
+		double loss = 0.2;
+		bool bReorder = false;
+		double lastArriveTime = 0.0;
+		std::mt19937 rng;
+		std::vector<InFlight> inFlight;
+
+		LossyLink(uint32_t seed, double latency, double jitter, double loss) :
+			latency(latency), jitter(jitter), loss(loss), rng(seed)
+		{
+		}
+		void Send(const uint8_t* data, std::size_t size, double now)
+		{
+			std::uniform_real_distribution<double> dist{ 0.0, 1.0 };
+			if (dist(rng) < loss)
+				return;
+			double arriveTime = now + latency + dist(rng) * jitter;
+			if (!bReorder)
+				arriveTime = std::max(arriveTime, lastArriveTime);
+			lastArriveTime = arriveTime;
+			inFlight.push_back(InFlight{ arriveTime, std::vector<uint8_t>(data, data + size) });
+		}
+		void Deliver(sh::network::Connection& to, double now)
+		{
+			for (std::size_t i = 0; i < inFlight.size();)
+			{
+				if (inFlight[i].arriveTime <= now)
+				{
+					to.Receive(inFlight[i].data.data(), inFlight[i].data.size(), now);
+					inFlight[i] = std::move(inFlight.back());
+					inFlight.pop_back();
+				}
+				else
+					++i;
+			}
+		}
+	};
+	struct Pair
+	{
+		sh::network::Connection a;
+		sh::network::Connection b;
+		LossyLink ab;
+		LossyLink ba;
+		double now = 0.0;
+
+		Pair(double latency, double jitter, double loss) :
+			ab(7, latency, jitter, loss), ba(9, latency, jitter, loss)
+		{
+		}
+		void Step(double dt)
+		{
+			now += dt;
+			a.Update(now, [&](const uint8_t* data, std::size_t size) { ab.Send(data, size, now); });
+			b.Update(now, [&](const uint8_t* data, std::size_t size) { ba.Send(data, size, now); });
+			ab.Deliver(b, now);
+			ba.Deliver(a, now);
+		}
+	};
+	constexpr uint8_t UNRELIABLE_SEQUENCED = 1;
+	constexpr uint8_t RELIABLE_ORDERED = 2;
+	constexpr uint8_t RELIABLE_UNORDERED = 3;
+
+	inline auto ReadU32(const std::vector<uint8_t>& data) -> uint32_t
+	{
+		uint32_t value = 0;
+		std::memcpy(&value, data.data(), sizeof(uint32_t));
+		return value;
+	}
+	/// @brief 조각 하나만 담은 데이터그램을 직접 만든다.
+	inline auto MakeFragmentDatagram(uint16_t sequence, uint8_t channel, uint16_t messageId, uint32_t fragmentIndex, uint32_t fragmentCount,
+		const std::vector<uint8_t>& payload) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> datagram(payload.size() + 32);
+		sh::network::BitWriter writer{ datagram.data(), datagram.size() };
+		writer.WriteBits(sequence, 16);
+		writer.WriteBits(0, 8);
+		writer.WriteBits(0, 16);
+		writer.WriteBits(0, 32);
+		writer.WriteBits(channel | 0x80, 8);
+		writer.WriteBits(messageId, 16);
+		writer.Varint(fragmentIndex);
+		writer.Varint(fragmentCount);
+		uint32_t length = static_cast<uint32_t>(payload.size());
+		writer.Varint(length);
+		writer.WriteBytes(payload.data(), payload.size());
+		datagram.resize(writer.Flush());
+		return datagram;
+	}
+}//namespace
+
+TEST(ReliableUdpTest, ReliableOrderedWithFragments)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Pair pair{ 0.05, 0.01, 0.2 };
+
+	constexpr uint32_t count = 300;
+	std::vector<uint8_t> big(50 * 1024);
+	for (std::size_t i = 0; i < big.size(); ++i)
+		big[i] = static_cast<uint8_t>(i * 31);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		ASSERT_TRUE(pair.a.Send(RELIABLE_ORDERED, reinterpret_cast<const uint8_t*>(&i), sizeof(i)));
+		if (i == count / 2)
+			ASSERT_TRUE(pair.a.Send(RELIABLE_ORDERED, big.data(), big.size()));
+	}
+
+	std::vector<Connection::ReceivedMessage> messages;
+	uint32_t expected = 0;
+	bool bBigReceived = false;
+	for (int step = 0; step < 10000 && (expected < count || pair.a.HasPendingData()); ++step)
+	{
+		pair.Step(0.001);
+		messages.clear();
+		pair.b.PollMessages(messages);
+		for (auto& msg : messages)
+		{
+			ASSERT_EQ(msg.channel, RELIABLE_ORDERED);
+			if (msg.data.size() == big.size())
+			{
+				EXPECT_EQ(expected, count / 2 + 1);
+				EXPECT_TRUE(msg.data == big);
+				bBigReceived = true;
+				continue;
+			}
+			ASSERT_EQ(msg.data.size(), sizeof(uint32_t));
+			EXPECT_EQ(ReadU32(msg.data), expected);
+			++expected;
+		}
+	}
+	EXPECT_EQ(expected, count);
+	EXPECT_TRUE(bBigReceived);
+	EXPECT_FALSE(pair.a.HasPendingData());
+	EXPECT_GT(pair.a.GetStats().resentFragments, 0u);
+	EXPECT_GT(pair.a.GetPacketLoss(), 0.05f);
+}
+
+TEST(ReliableUdpTest, ReliableUnorderedExactlyOnce)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Pair pair{ 0.03, 0.03, 0.3 };
+
+	constexpr uint32_t count = 500;
+	for (uint32_t i = 0; i < count; ++i)
+		ASSERT_TRUE(pair.a.Send(RELIABLE_UNORDERED, reinterpret_cast<const uint8_t*>(&i), sizeof(i)));
+
+	std::vector<int> receivedCount(count, 0);
+	std::vector<Connection::ReceivedMessage> messages;
+	for (int step = 0; step < 10000 && pair.a.HasPendingData(); ++step)
+	{
+		pair.Step(0.001);
+		messages.clear();
+		pair.b.PollMessages(messages);
+		for (auto& msg : messages)
+		{
+			const uint32_t value = ReadU32(msg.data);
+			ASSERT_LT(value, count);
+			++receivedCount[value];
+		}
+	}
+	for (uint32_t i = 0; i < count; ++i)
+		EXPECT_EQ(receivedCount[i], 1) << i;
+}
+
+TEST(ReliableUdpTest, UnreliableSequenced)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	// 지터가 지연보다 커서 데이터그램 순서가 자주 뒤바뀐다.
+	Pair pair{ 0.01, 0.05, 0.1 };
+	pair.ab.bReorder = true;
+
+	std::vector<Connection::ReceivedMessage> messages;
+	uint32_t last = 0;
+	uint32_t received = 0;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		pair.a.Send(UNRELIABLE_SEQUENCED, reinterpret_cast<const uint8_t*>(&i), sizeof(i));
+		pair.Step(0.002);
+		messages.clear();
+		pair.b.PollMessages(messages);
+		for (auto& msg : messages)
+		{
+			const uint32_t value = ReadU32(msg.data);
+			if (received > 0)
+				EXPECT_GT(value, last);
+			last = value;
+			++received;
+		}
+	}
+	EXPECT_GT(received, 0u);
+	EXPECT_LT(received, 1000u);
+}
+
+TEST(ReliableUdpTest, RttAndTimeout)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Pair pair{ 0.05, 0.0, 0.0 };
+
+	for (int step = 0; step < 2000; ++step)
+		pair.Step(0.001);
+	// 왕복 100ms + ack를 모아 보내는 지연
+	EXPECT_NEAR(pair.a.GetRtt(), 0.1, 0.02);
+	EXPECT_NEAR(pair.b.GetRtt(), 0.1, 0.02);
+	EXPECT_FALSE(pair.a.IsTimedOut(pair.now));
+	EXPECT_TRUE(pair.a.IsTimedOut(pair.now + pair.a.GetConfig().timeout + 1.0));
+}
+
+TEST(ReliableUdpTest, TinyDatagramSize)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	// 헤더보다 작은 크기는 조각 크기 계산이 감싸지지 않도록 최소 크기로 맞춰진다.
+	Connection::Config config{};
+	config.maxDatagramSize = 8;
+	Connection a{ config };
+	Connection b{ config };
+	EXPECT_EQ(a.GetConfig().maxDatagramSize, Connection::MIN_DATAGRAM_SIZE);
+	EXPECT_EQ(a.GetConfig().fragmentSize, 1u);
+
+	const std::vector<uint8_t> data{ 1, 2, 3, 4, 5, 6, 7 };
+	ASSERT_TRUE(a.Send(RELIABLE_ORDERED, data.data(), data.size()));
+	std::vector<Connection::ReceivedMessage> messages;
+	double now = 0.0;
+	for (int step = 0; step < 1000 && messages.empty(); ++step)
+	{
+		now += 0.001;
+		a.Update(now, [&](const uint8_t* datagram, std::size_t size)
+			{
+				EXPECT_LE(size, Connection::MIN_DATAGRAM_SIZE);
+				b.Receive(datagram, size, now);
+			});
+		b.Update(now, [&](const uint8_t* datagram, std::size_t size) { a.Receive(datagram, size, now); });
+		b.PollMessages(messages);
+	}
+	ASSERT_EQ(messages.size(), 1);
+	EXPECT_EQ(messages[0].data, data);
+}
+
+TEST(ReliableUdpTest, ConnectionPacket)
+{
+	using namespace sh::network;
+	std::vector<uint8_t> payload(1000);
+	for (std::size_t i = 0; i < payload.size(); ++i)
+		payload[i] = static_cast<uint8_t>(i);
+
+	ConnectionPacket packet{};
+	packet.SetPayload(payload.data(), payload.size());
+
+	std::vector<uint8_t> bytes;
+	ASSERT_TRUE(PacketCodec::EncodeAny(packet, bytes));
+	EXPECT_LE(bytes.size(), Packet::MAX_PACKET_SIZE);
+
+	auto decoded = PacketCodec::DecodeAny(bytes.data(), bytes.size());
+	ASSERT_NE(decoded, nullptr);
+	ASSERT_EQ(decoded->GetId(), ConnectionPacket::ID);
+	EXPECT_TRUE(static_cast<ConnectionPacket&>(*decoded).GetPayload() == payload);
+}
+
+TEST(ReliableUdpTest, FragmentOutsideReceiveWindow)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Connection connection{};
+	const uint32_t fragmentSize = connection.GetConfig().fragmentSize;
+	const std::vector<uint8_t> first(fragmentSize, 1);
+	const std::vector<uint8_t> last(10, 2);
+	uint16_t sequence = 0;
+	auto receive = [&](uint8_t channel, uint16_t messageId, uint32_t fragmentIndex, const std::vector<uint8_t>& payload)
+		{
+			const auto datagram = MakeFragmentDatagram(sequence++, channel, messageId, fragmentIndex, 2, payload);
+			connection.Receive(datagram.data(), datagram.size(), 0.0);
+		};
+
+	// 받을 수 있는 범위 밖의 신뢰성 메시지는 재조립을 시작하지 않는다.
+	for (uint8_t channel : { RELIABLE_ORDERED, RELIABLE_UNORDERED })
+	{
+		receive(channel, 2000, 0, first);
+		receive(channel, 2000, 1, last);
+	}
+	EXPECT_EQ(connection.GetReassemblyCount(), 0u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), 0u);
+
+	receive(RELIABLE_UNORDERED, 5, 1, last);
+	EXPECT_EQ(connection.GetReassemblyCount(), 1u);
+	receive(RELIABLE_UNORDERED, 5, 0, first);
+	EXPECT_EQ(connection.GetReassemblyCount(), 0u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), 0u);
+
+	std::vector<Connection::ReceivedMessage> messages;
+	connection.PollMessages(messages);
+	ASSERT_EQ(messages.size(), 1);
+	EXPECT_EQ(messages[0].data.size(), fragmentSize + last.size());
+	EXPECT_EQ(messages[0].data.front(), 1);
+	EXPECT_EQ(messages[0].data.back(), 2);
+}
+
+TEST(ReliableUdpTest, ReassemblyLimits)
+{
+	using namespace sh::network;
+	using namespace reliableTest;
+	Connection::Config config{};
+	config.maxReassemblies = 2;
+	config.maxReassemblyBytes = 1000;
+	Connection connection{ config };
+	const uint32_t fragmentSize = connection.GetConfig().fragmentSize;
+	const std::vector<uint8_t> payload(fragmentSize, 3);
+	uint16_t sequence = 0;
+	auto receive = [&](uint16_t messageId, uint32_t fragmentIndex, double now)
+		{
+			const auto datagram = MakeFragmentDatagram(sequence++, 0, messageId, fragmentIndex, 100, payload);
+			connection.Receive(datagram.data(), datagram.size(), now);
+		};
+
+	// 메시지 전체 크기가 아니라 도착한 조각만큼만 잡는다.
+	receive(0, 0, 0.0);
+	EXPECT_EQ(connection.GetReassemblyCount(), 1u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), fragmentSize);
+
+	// 바이트 제한을 넘는 조각은 버린다.
+	receive(0, 1, 0.0);
+	receive(1, 0, 0.0);
+	EXPECT_EQ(connection.GetReassemblyCount(), 2u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), fragmentSize);
+
+	// 재조립 수 제한을 넘는 새 메시지는 시작하지 않는다.
+	receive(2, 0, 0.0);
+	EXPECT_EQ(connection.GetReassemblyCount(), 2u);
+
+	// 시간이 지나 버려진 재조립은 제한에서 빠진다.
+	connection.Update(10.0, [](const uint8_t*, std::size_t) {});
+	EXPECT_EQ(connection.GetReassemblyCount(), 0u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), 0u);
+	receive(3, 0, 10.0);
+	EXPECT_EQ(connection.GetReassemblyCount(), 1u);
+	EXPECT_EQ(connection.GetReassemblyBytes(), fragmentSize);
+}
+
+TEST(ReliableUdpTest, MaxIncomingConnections)
+{
+	using namespace sh::network;
+	NetworkContext ctx{};
+	UdpSocket socket{ ctx };
+	ConnectionHost host{ socket };
+	host.SetAcceptIncoming(true);
+	host.SetMaxConnections(2);
+
+	auto makeMessage = [](uint16_t port)
+		{
+			auto packet = std::make_unique<ConnectionPacket>();
+			const std::vector<uint8_t> datagram(9, 0);
+			packet->SetPayload(datagram.data(), datagram.size());
+			return NetworkContext::Message{ Endpoint::FromIPv4(0x7f000001, port), std::move(packet) };
+		};
+	for (uint16_t port = 1000; port < 1010; ++port)
+		EXPECT_TRUE(host.HandleMessage(makeMessage(port), 0.0));
+	EXPECT_EQ(host.GetConnectionCount(), 2u);
+	EXPECT_NE(host.GetConnection(Endpoint::FromIPv4(0x7f000001, 1000)), nullptr);
+	EXPECT_EQ(host.GetConnection(Endpoint::FromIPv4(0x7f000001, 1002)), nullptr);
+
+	// 연결이 끊기면 다시 받는다.
+	host.Disconnect(Endpoint::FromIPv4(0x7f000001, 1000));
+	EXPECT_TRUE(host.HandleMessage(makeMessage(1002), 0.0));
+	EXPECT_NE(host.GetConnection(Endpoint::FromIPv4(0x7f000001, 1002)), nullptr);
+}
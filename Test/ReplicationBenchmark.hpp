@@ -0,0 +1,73 @@
+﻿#pragma once
+#include "ReplicationTest.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+
+TEST(ReplicationBenchmark, Snapshot)
+{
+	using namespace sh;
+	constexpr int ENTITY_COUNT = 2000;
+	constexpr int CLIENT_COUNT = 64;
+	constexpr int TICKS = 60;
+	constexpr float WORLD_SIZE = 1000.f;
+
+	std::mt19937 rng{ 1234 };
+	std::uniform_real_distribution<float> posDist{ 0.f, WORLD_SIZE };
+	std::uniform_real_distribution<float> moveDist{ -1.f, 1.f };
+
+	game::ReplicationServer server{};
+	std::vector<ReplicationTestObject*> objs;
+	std::vector<uint32_t> ids;
+	for (int i = 0; i < ENTITY_COUNT; ++i)
+	{
+		auto obj = core::SObject::Create<ReplicationTestObject>();
+		obj->x = posDist(rng);
+		obj->z = posDist(rng);
+		ids.push_back(RegisterTestObject(server, obj));
+		objs.push_back(obj);
+	}
+	std::vector<uint32_t> clients;
+	for (int i = 0; i < CLIENT_COUNT; ++i)
+	{
+		const uint32_t clientId = server.AddClient();
+		server.SetClientView(clientId, glm::vec3{ posDist(rng), 0.f, posDist(rng) }, 150.f);
+		clients.push_back(clientId);
+	}
+
+	std::vector<uint8_t> data;
+	uint64_t totalBytes = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int tick = 0; tick < TICKS; ++tick)
+	{
+		// 1/4의 객체가 움직인다.
+		for (int i = tick % 4; i < ENTITY_COUNT; i += 4)
+		{
+			objs[i]->x += moveDist(rng);
+			objs[i]->z += moveDist(rng);
+			server.SetEntityPosition(ids[i], glm::vec3{ objs[i]->x, 0.f, objs[i]->z });
+		}
+		server.Update();
+		for (uint32_t clientId : clients)
+		{
+			const uint32_t snapshot = server.WriteSnapshot(clientId, data);
+			totalBytes += data.size();
+			server.Acknowledge(clientId, snapshot);
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+	std::cout << "[ReplicationBenchmark] " << ENTITY_COUNT << " entities, " << CLIENT_COUNT << " clients: "
+		<< static_cast<double>(totalBytes) / (CLIENT_COUNT * TICKS) << " bytes/client/tick, "
+		<< ms / TICKS << "ms/tick\n";
+
+	for (auto obj : objs)
+		obj->Destroy();
+	auto gc = core::GarbageCollection::GetInstance();
+	gc->Collect();
+	gc->DestroyPendingKillObjs();
+}
@@ -0,0 +1,296 @@
+﻿#pragma once
+#include "Core/SObject.h"
+#include "Core/Reflection.hpp"
+#include "Core/GarbageCollection.h"
+#include "Game/Replication.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+class ReplicationTestObject : public sh::core::SObject
+{
+	SCLASS(ReplicationTestObject)
+public:
+	PROPERTY(x, sh::core::PropertyOption::replicated)
+	float x = 0.f;
+	PROPERTY(z, sh::core::PropertyOption::replicated)
+	float z = 0.f;
+	PROPERTY(hp, sh::core::PropertyOption::replicated)
+	int hp = 100;
+	PROPERTY(team, sh::core::PropertyOption::replicated)
+	uint32_t team = 0;
+	PROPERTY(bAlive, sh::core::PropertyOption::replicated)
+	bool bAlive = true;
+	// 복제되지 않는다.
+	PROPERTY(localValue)
+	float localValue = 0.f;
+
+	int changedCount = 0;
+
+	void OnPropertyChanged(const sh::core::reflection::Property& prop) override
+	{
+		++changedCount;
+	}
+};
+
+namespace
+{
+	struct ReplicationTestClient
+	{
+		sh::game::ReplicationClient client;
+		std::unordered_map<uint32_t, ReplicationTestObject*> objects;
+		std::vector<uint32_t> despawned;
+
+		ReplicationTestClient()
+		{
+			client.SetSpawnFunction(
+				[this](uint32_t id, uint32_t archetype, std::vector<sh::core::SObject*>& parts)
+				{
+					auto obj = sh::core::SObject::Create<ReplicationTestObject>();
+					objects[id] = obj;
+					parts.push_back(obj);
+					return true;
+				}
+			);
+			client.SetDespawnFunction(
+				[this](uint32_t id)
+				{
+					auto it = objects.find(id);
+					if (it != objects.end())
+					{
+						it->second->Destroy();
+						objects.erase(it);
+					}
+					despawned.push_back(id);
+				}
+			);
+		}
+	};
+	auto RegisterTestObject(sh::game::ReplicationServer& server, ReplicationTestObject* obj, float priority = 1.f) -> uint32_t
+	{
+		sh::core::SObject* parts[] = { obj };
+		const uint32_t id = server.Register({ parts, 1 }, sh::game::ReplicationServer::EntitySettings{ 0, priority, false });
+		server.SetEntityPosition(id, glm::vec3{ obj->x, 0.f, obj->z });
+		return id;
+	}
+	void DestroyTestObjects(const std::vector<ReplicationTestObject*>& objs, ReplicationTestClient& client)
+	{
+		for (auto obj : objs)
+			obj->Destroy();
+		for (auto& [id, obj] : client.objects)
+			obj->Destroy();
+		auto gc = sh::core::GarbageCollection::GetInstance();
+		gc->Collect();
+		gc->DestroyPendingKillObjs();
+	}
+}
+
+TEST(ReplicationTest, SpawnAndDelta)
+{
+	using namespace sh;
+	auto obj = core::SObject::Create<ReplicationTestObject>();
+	obj->x = 1.5f;
+	obj->hp = 80;
+	obj->team = 3;
+	obj->localValue = 7.f;
+
+	game::ReplicationServer server{};
+	const uint32_t id = RegisterTestObject(server, obj);
+	const uint32_t clientId = server.AddClient();
+	server.SetClientView(clientId, glm::vec3{ 0.f }, 100.f);
+
+	ReplicationTestClient client{};
+	std::vector<uint8_t> data;
+
+	server.Update();
+	uint32_t snapshot = server.WriteSnapshot(clientId, data);
+	const std::size_t spawnSize = data.size();
+	auto acked = client.client.ReadSnapshot(data.data(), data.size());
+	ASSERT_TRUE(acked.has_value());
+	EXPECT_EQ(acked.value(), snapshot);
+	server.Acknowledge(clientId, acked.value());
+
+	ASSERT_EQ(client.objects.count(id), 1);
+	ReplicationTestObject* replica = client.objects[id];
+	EXPECT_NEAR(replica->x, 1.5f, 0.001f);
+	EXPECT_EQ(replica->hp, 80);
+	EXPECT_EQ(replica->team, 3u);
+	EXPECT_TRUE(replica->bAlive);
+	EXPECT_FLOAT_EQ(replica->localValue, 0.f);
+
+	// 바뀐 필드만 보낸다.
+	obj->hp = 75;
+	server.Update();
+	snapshot = server.WriteSnapshot(clientId, data);
+	EXPECT_LT(data.size(), spawnSize);
+	EXPECT_EQ(server.GetClientStats(clientId)->sentEntities, 1u);
+	const int changedCount = replica->changedCount;
+	acked = client.client.ReadSnapshot(data.data(), data.size());
+	ASSERT_TRUE(acked.has_value());
+	server.Acknowledge(clientId, acked.value());
+	EXPECT_EQ(replica->hp, 75);
+	EXPECT_EQ(replica->changedCount, changedCount + 1);
+
+	// 바뀐 것이 없으면 스냅샷 번호만 보낸다.
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	EXPECT_EQ(server.GetClientStats(clientId)->sentEntities, 0u);
+	EXPECT_LE(data.size(), 2u);
+
+	DestroyTestObjects({ obj }, client);
+}
+
+TEST(ReplicationTest, LostSnapshotIsResent)
+{
+	using namespace sh;
+	auto obj = core::SObject::Create<ReplicationTestObject>();
+
+	game::ReplicationServer server{};
+	const uint32_t id = RegisterTestObject(server, obj);
+	const uint32_t clientId = server.AddClient();
+	server.SetClientView(clientId, glm::vec3{ 0.f }, 100.f);
+
+	ReplicationTestClient client{};
+	std::vector<uint8_t> data;
+
+	// 생성 스냅샷이 유실돼도 다음 스냅샷이 다시 생성을 보낸다.
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	auto acked = client.client.ReadSnapshot(data.data(), data.size());
+	ASSERT_TRUE(acked.has_value());
+	server.Acknowledge(clientId, acked.value());
+	ASSERT_EQ(client.objects.count(id), 1);
+
+	obj->hp = 10;
+	server.Update();
+	const uint32_t lost = server.WriteSnapshot(clientId, data);
+	std::vector<uint8_t> lostData = data;
+
+	// 값은 그대로지만 확인되지 않았으므로 다시 보낸다.
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	EXPECT_EQ(server.GetClientStats(clientId)->sentEntities, 1u);
+	acked = client.client.ReadSnapshot(data.data(), data.size());
+	ASSERT_TRUE(acked.has_value());
+	server.Acknowledge(clientId, acked.value());
+	EXPECT_EQ(client.objects[id]->hp, 10);
+
+	// 늦게 도착한 예전 스냅샷은 적용되지 않는다.
+	obj->hp = 20;
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	acked = client.client.ReadSnapshot(data.data(), data.size());
+	server.Acknowledge(clientId, acked.value());
+	EXPECT_EQ(client.objects[id]->hp, 20);
+	client.client.ReadSnapshot(lostData.data(), lostData.size());
+	server.Acknowledge(clientId, lost);
+	EXPECT_EQ(client.objects[id]->hp, 20);
+
+	server.Update();
+	server.WriteSnapshot(clientId, data);
+	EXPECT_EQ(server.GetClientStats(clientId)->sentEntities, 0u);
+
+	DestroyTestObjects({ obj }, client);
+}
+
+TEST(ReplicationTest, InterestManagement)
+{
+	using namespace sh;
+	auto nearObj = core::SObject::Create<ReplicationTestObject>();
+	nearObj->x = 10.f;
+	auto farObj = core::SObject::Create<ReplicationTestObject>();
+	farObj->x = 500.f;
+
+	game::ReplicationServer server{};
+	const uint32_t nearId = RegisterTestObject(server, nearObj);
+	const uint32_t farId = RegisterTestObject(server, farObj);
+	const uint32_t clientId = server.AddClient();
+	server.SetClientView(clientId, glm::vec3{ 0.f }, 100.f);
+
+	ReplicationTestClient client{};
+	std::vector<uint8_t> data;
+	const auto tick =
+		[&]()
+		{
+			server.Update();
+			server.WriteSnapshot(clientId, data);
+			auto acked = client.client.ReadSnapshot(data.data(), data.size());
+			ASSERT_TRUE(acked.has_value());
+			server.Acknowledge(clientId, acked.value());
+		};
+
+	tick();
+	EXPECT_EQ(client.objects.count(nearId), 1);
+	EXPECT_EQ(client.objects.count(farId), 0);
+	EXPECT_EQ(server.GetClientStats(clientId)->relevantEntities, 1u);
+
+	// 시야 경계를 조금 넘어도 바로 사라지지 않는다.
+	server.SetClientView(clientId, glm::vec3{ -95.f, 0.f, 0.f }, 100.f);
+	tick();
+	EXPECT_EQ(client.objects.count(nearId), 1);
+
+	// 시야를 벗어나면 제거된다.
+	server.SetClientView(clientId, glm::vec3{ 450.f, 0.f, 0.f }, 100.f);
+	tick();
+	EXPECT_EQ(client.objects.count(nearId), 0);
+	EXPECT_EQ(client.objects.count(farId), 1);
+	ASSERT_EQ(client.despawned.size(), 1);
+	EXPECT_EQ(client.despawned[0], nearId);
+
+	// 등록 해제도 제거로 전달된다.
+	server.Unregister(farId);
+	tick();
+	EXPECT_EQ(client.objects.count(farId), 0);
+	EXPECT_EQ(client.client.GetEntityCount(), 0);
+	EXPECT_EQ(server.GetEntityCount(), 1);
+
+	// 다시 시야에 들어오면 새로 만든다.
+	server.SetClientView(clientId, glm::vec3{ 0.f }, 100.f);
+	tick();
+	EXPECT_EQ(client.objects.count(nearId), 1);
+
+	DestroyTestObjects({ nearObj, farObj }, client);
+}
+
+TEST(ReplicationTest, SnapshotBudgetAndPriority)
+{
+	using namespace sh;
+	game::ReplicationServer::Settings settings{};
+	settings.maxSnapshotBytes = 200;
+	game::ReplicationServer server{ settings };
+
+	std::vector<ReplicationTestObject*> objs;
+	for (int i = 0; i < 100; ++i)
+	{
+		auto obj = core::SObject::Create<ReplicationTestObject>();
+		obj->x = static_cast<float>(i % 10);
+		obj->z = static_cast<float>(i / 10);
+		RegisterTestObject(server, obj);
+		objs.push_back(obj);
+	}
+	const uint32_t clientId = server.AddClient();
+	server.SetClientView(clientId, glm::vec3{ 0.f }, 100.f);
+
+	ReplicationTestClient client{};
+	std::vector<uint8_t> data;
+	int ticks = 0;
+	while (client.client.GetEntityCount() < objs.size() && ticks < 100)
+	{
+		server.Update();
+		server.WriteSnapshot(clientId, data);
+		EXPECT_LE(data.size(), settings.maxSnapshotBytes);
+		auto acked = client.client.ReadSnapshot(data.data(), data.size());
+		ASSERT_TRUE(acked.has_value());
+		server.Acknowledge(clientId, acked.value());
+		++ticks;
+	}
+	// 한 스냅샷에 다 들어가지 않으므로 여러 틱에 나눠서 보낸다.
+	EXPECT_GT(ticks, 1);
+	EXPECT_EQ(client.client.GetEntityCount(), objs.size());
+
+	DestroyTestObjects(objs, client);
+}
@@ -0,0 +1,52 @@
+﻿#pragma once
+#include "RollbackTest.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+
+TEST(RollbackBenchmark, Snapshot)
+{
+	using namespace sh;
+	using namespace rollbackTest;
+	constexpr int objCount = 5000;
+	constexpr int tickCount = 120;
+	constexpr int restoreTick = tickCount - 10;
+	Scene scene{ objCount };
+	std::mt19937 rng{ 4026 };
+
+	game::RollbackBuffer buffer{ game::RollbackBuffer::Settings{ 128, 16 } };
+	std::vector<float> expectedX;
+
+	std::size_t totalSize = 0;
+	std::size_t keyFrameSize = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int tick = 1; tick <= tickCount; ++tick)
+	{
+		scene.MoveSome(rng);
+		buffer.Capture(tick, { scene.objs.data(), scene.objs.size() });
+		totalSize += buffer.GetFrameSize(tick);
+		if (buffer.IsKeyFrame(tick))
+			keyFrameSize += buffer.GetFrameSize(tick);
+		if (tick == restoreTick)
+			expectedX = scene.GetX();
+	}
+	auto captureTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	ASSERT_TRUE(buffer.Restore(restoreTick));
+	auto restoreTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	const std::size_t rawSize = buffer.GetRawFrameSize(restoreTick);
+	std::cout << "[RollbackBenchmark] " << objCount << " objects, " << tickCount << " ticks\n";
+	std::cout << "  raw frame: " << rawSize << " bytes\n";
+	std::cout << "  average stored frame: " << totalSize / tickCount << " bytes\n";
+	std::cout << "  key frames total: " << keyFrameSize << " bytes\n";
+	std::cout << "  capture: " << captureTime / tickCount << "us/tick\n";
+	std::cout << "  restore (up to " << buffer.GetSettings().keyFrameInterval << " deltas): " << restoreTime << "us\n";
+
+	EXPECT_EQ(scene.GetX(), expectedX);
+	EXPECT_LT(totalSize / tickCount, rawSize / 2);
+}
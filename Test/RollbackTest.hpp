@@ -0,0 +1,163 @@
+﻿#pragma once
+#include "Core/SObject.h"
+#include "Core/Reflection.hpp"
+#include "Core/GarbageCollection.h"
+#include "Game/RollbackBuffer.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <string>
+
+class RollbackTestObject : public sh::core::SObject
+{
+	SCLASS(RollbackTestObject)
+public:
+	PROPERTY(x)
+	float x = 0.f;
+	PROPERTY(y)
+	float y = 0.f;
+	PROPERTY(z)
+	float z = 0.f;
+	PROPERTY(hp)
+	int hp = 100;
+	PROPERTY(bAlive)
+	bool bAlive = true;
+	// 바이트 복사가 불가능한 프로퍼티는 저장되지 않는다.
+	PROPERTY(tag)
+	std::string tag = "unit";
+
+	int changedCount = 0;
+
+	void OnPropertyChanged(const sh::core::reflection::Property& prop) override
+	{
+		++changedCount;
+	}
+};
+
+namespace rollbackTest
+{
+	/// @brief 테스트 객체들을 만들고 끝나면 파괴한다.
+	struct Scene
+	{
+		std::vector<RollbackTestObject*> testObjs;
+		std::vector<sh::core::SObject*> objs;
+
+		explicit Scene(int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				testObjs.push_back(sh::core::SObject::Create<RollbackTestObject>());
+				objs.push_back(testObjs.back());
+			}
+		}
+		~Scene()
+		{
+			for (auto obj : testObjs)
+				obj->Destroy();
+			auto gc = sh::core::GarbageCollection::GetInstance();
+			gc->Collect();
+			gc->DestroyPendingKillObjs();
+		}
+		/// @brief 객체의 10%만 움직인다.
+		void MoveSome(std::mt19937& rng)
+		{
+			std::uniform_int_distribution<int> idxDist{ 0, static_cast<int>(testObjs.size()) - 1 };
+			for (std::size_t i = 0; i < testObjs.size() / 10; ++i)
+			{
+				auto obj = testObjs[idxDist(rng)];
+				obj->x += 1.f;
+				obj->z -= 0.5f;
+			}
+		}
+		auto GetX() const -> std::vector<float>
+		{
+			std::vector<float> x(testObjs.size());
+			for (std::size_t i = 0; i < testObjs.size(); ++i)
+				x[i] = testObjs[i]->x;
+			return x;
+		}
+	};
+}//namespace
+
+TEST(RollbackTest, CaptureAndRestore)
+{
+	using namespace sh;
+	auto a = core::SObject::Create<RollbackTestObject>();
+	auto b = core::SObject::Create<RollbackTestObject>();
+	std::vector<core::SObject*> objs{ a, b };
+
+	game::RollbackBuffer buffer{ game::RollbackBuffer::Settings{ 8, 4 } };
+	for (uint64_t tick = 1; tick <= 6; ++tick)
+	{
+		a->x = static_cast<float>(tick);
+		b->hp = 100 - static_cast<int>(tick);
+		buffer.Capture(tick, { objs.data(), objs.size() });
+	}
+	EXPECT_TRUE(buffer.IsKeyFrame(1));
+	EXPECT_FALSE(buffer.IsKeyFrame(2));
+	EXPECT_TRUE(buffer.IsKeyFrame(5));
+	// 델타 프레임은 원본보다 작아야 한다.
+	EXPECT_LT(buffer.GetFrameSize(3), buffer.GetRawFrameSize(3));
+
+	a->tag = "changed";
+	ASSERT_TRUE(buffer.Restore(3));
+	EXPECT_FLOAT_EQ(a->x, 3.f);
+	EXPECT_EQ(b->hp, 97);
+	EXPECT_EQ(a->tag, "changed");
+	EXPECT_EQ(a->changedCount, 1);
+	EXPECT_EQ(b->changedCount, 1);
+	// 복원한 틱 이후는 버려진다.
+	EXPECT_FALSE(buffer.HasFrame(4));
+	EXPECT_EQ(buffer.GetLatestTick(), 3u);
+
+	// 다른 결과로 다시 진행
+	a->x = 40.f;
+	buffer.Capture(4, { objs.data(), objs.size() });
+	a->x = 0.f;
+	ASSERT_TRUE(buffer.Restore(4));
+	EXPECT_FLOAT_EQ(a->x, 40.f);
+
+	// 객체 구성이 바뀌면 키 프레임
+	objs.pop_back();
+	buffer.Capture(5, { objs.data(), objs.size() });
+	EXPECT_TRUE(buffer.IsKeyFrame(5));
+
+	// 링 버퍼에서 밀려난 틱은 복원할 수 없다.
+	for (uint64_t tick = 6; tick <= 20; ++tick)
+		buffer.Capture(tick, { objs.data(), objs.size() });
+	EXPECT_FALSE(buffer.Restore(3));
+
+	a->Destroy();
+	b->Destroy();
+	auto gc = core::GarbageCollection::GetInstance();
+	gc->Collect();
+	gc->DestroyPendingKillObjs();
+}
+
+TEST(RollbackTest, RestoreAcrossDeltaFrames)
+{
+	using namespace sh;
+	using namespace rollbackTest;
+	constexpr int tickCount = 40;
+	constexpr int restoreTick = tickCount - 10;
+	Scene scene{ 500 };
+	std::mt19937 rng{ 4026 };
+
+	game::RollbackBuffer buffer{ game::RollbackBuffer::Settings{ 64, 16 } };
+	std::vector<float> expectedX;
+	std::size_t totalSize = 0;
+	for (int tick = 1; tick <= tickCount; ++tick)
+	{
+		scene.MoveSome(rng);
+		buffer.Capture(tick, { scene.objs.data(), scene.objs.size() });
+		totalSize += buffer.GetFrameSize(tick);
+		if (tick == restoreTick)
+			expectedX = scene.GetX();
+	}
+	// 키 프레임 뒤에 델타가 여러 개 쌓인 틱을 복원한다.
+	ASSERT_FALSE(buffer.IsKeyFrame(restoreTick));
+	ASSERT_TRUE(buffer.Restore(restoreTick));
+	EXPECT_EQ(scene.GetX(), expectedX);
+	EXPECT_LT(totalSize / tickCount, buffer.GetRawFrameSize(restoreTick) / 2);
+}
@@ -0,0 +1,115 @@
+﻿#pragma once
+#include "Render/ShaderCompiler.h"
+
+#include "Core/ThreadPool.h"
+
+#include <gtest/gtest.h>
+#include <fmt/core.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace shaderCompilerTest
+{
+	constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+	inline auto GetCachePath() -> std::filesystem::path
+	{
+		return std::filesystem::temp_directory_path() / "ShellEngineShaderCompilerTest";
+	}
+	inline auto IsSpirv(const std::vector<uint8_t>& spirv) -> bool
+	{
+		if (spirv.size() < sizeof(uint32_t) || spirv.size() % sizeof(uint32_t) != 0)
+			return false;
+		uint32_t magic = 0;
+		std::memcpy(&magic, spirv.data(), sizeof(uint32_t));
+		return magic == SPIRV_MAGIC;
+	}
+
+	constexpr const char* vertCode = R"(
+#version 430 core
+layout(location = 0) in vec3 pos;
+void main()
+{
+	gl_Position = vec4(pos, 1.0);
+}
+)";
+	constexpr const char* fragCode = R"(
+#version 430 core
+layout(location = 0) out vec4 color;
+void main()
+{
+	color = vec4(1.0);
+}
+)";
+}//namespace
+
+TEST(ShaderCompilerTest, CompileAndCache)
+{
+	using namespace shaderCompilerTest;
+	using namespace sh::render;
+	std::filesystem::remove_all(GetCachePath());
+
+	ShaderCompiler compiler{};
+	compiler.SetCachePath(GetCachePath());
+
+	auto spirv = compiler.Compile(vertCode, ShaderCompiler::Stage::Vertex, "test.vert");
+	ASSERT_TRUE(spirv.has_value());
+	EXPECT_TRUE(IsSpirv(spirv.value()));
+
+	const auto cacheFile = GetCachePath() / fmt::format("{:016x}.spv", compiler.GetCacheKey(vertCode, ShaderCompiler::Stage::Vertex));
+	ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+	// 같은 코드라도 스테이지가 다르면 다른 키
+	EXPECT_NE(compiler.GetCacheKey(vertCode, ShaderCompiler::Stage::Vertex), compiler.GetCacheKey(vertCode, ShaderCompiler::Stage::Fragment));
+	// 옵션이 다르면 다른 키
+	ShaderCompiler::Options options{};
+	options.bOptimize = true;
+	ShaderCompiler optimizedCompiler{ options };
+	EXPECT_NE(compiler.GetCacheKey(vertCode, ShaderCompiler::Stage::Vertex), optimizedCompiler.GetCacheKey(vertCode, ShaderCompiler::Stage::Vertex));
+
+	// 캐시가 있으면 컴파일하지 않고 캐시를 반환한다.
+	ShaderCompiler other{};
+	other.SetCachePath(GetCachePath());
+	auto cached = other.Compile(vertCode, ShaderCompiler::Stage::Vertex, "test.vert");
+	ASSERT_TRUE(cached.has_value());
+	EXPECT_EQ(cached.value(), spirv.value());
+
+	std::filesystem::remove_all(GetCachePath());
+}
+
+TEST(ShaderCompilerTest, CompileError)
+{
+	using namespace sh::render;
+	ShaderCompiler compiler{};
+	auto spirv = compiler.Compile("#version 430 core\nvoid main() { undefinedFunc(); }", ShaderCompiler::Stage::Fragment, "error.frag");
+	EXPECT_FALSE(spirv.has_value());
+}
+
+TEST(ShaderCompilerTest, CompileAll)
+{
+	using namespace shaderCompilerTest;
+	using namespace sh::render;
+	// 스레드 풀이 없으면 순차로 컴파일하므로 병렬 경로를 타도록 초기화한다.
+	sh::core::ThreadPool& threadPool = *sh::core::ThreadPool::GetInstance();
+	if (!threadPool.IsInit())
+		threadPool.Init(4);
+	ShaderCompiler compiler{};
+
+	std::vector<ShaderCompiler::Source> sources;
+	for (int i = 0; i < 8; ++i)
+	{
+		sources.push_back(ShaderCompiler::Source{ vertCode, ShaderCompiler::Stage::Vertex, "test.vert" });
+		sources.push_back(ShaderCompiler::Source{ fragCode, ShaderCompiler::Stage::Fragment, "test.frag" });
+	}
+	auto results = compiler.CompileAll(sources);
+	ASSERT_EQ(results.size(), sources.size());
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		ASSERT_TRUE(results[i].has_value());
+		EXPECT_TRUE(IsSpirv(results[i].value()));
+		EXPECT_EQ(results[i].value(), results[i % 2].value());
+	}
+	EXPECT_NE(results[0].value(), results[1].value());
+}
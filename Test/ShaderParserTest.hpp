@@ -3,7 +3,6 @@
 
 #include "Render/ShaderLexer.h"
 #include "Render/ShaderParser.h"
-#include "Render/ShaderGenerator.h"
 #include "Render/VulkanImpl/VulkanShaderPassBuilder.h"
 
 #include "Game/Asset/ShaderLoader.h"
@@ -134,8 +133,6 @@ Shader "Outline Shader"
 	auto tokens = lexer.Lex(shaderCode);
 	shaderNode = parser.Parse(tokens);
 
-	render::ShaderGenerator::GenerateShaderFile(shaderNode.shaderName, shaderNode.passes[0], std::filesystem::current_path());
-
 	EXPECT_EQ(shaderNode.shaderName, "Outline Shader");
 	EXPECT_EQ(shaderNode.version.versionNumber, 430);
 	EXPECT_EQ(shaderNode.version.profile, "core");
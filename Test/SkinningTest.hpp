@@ -0,0 +1,133 @@
+﻿#pragma once
+#include "Game/SkinningSystem.h"
+#include "Game/Component/Render/SkinnedMeshRenderer.h"
+
+#include "Render/SkinPaletteBuffer.h"
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace skinningTest
+{
+	inline auto Translate(float x, float y, float z) -> glm::mat4
+	{
+		glm::mat4 m{ 1.f };
+		m[3] = glm::vec4{ x, y, z, 1.f };
+		return m;
+	}
+	inline auto Scale(float s) -> glm::mat4
+	{
+		glm::mat4 m{ s };
+		m[3][3] = 1.f;
+		return m;
+	}
+	inline void ExpectMatEq(const glm::mat4& a, const glm::mat4& b)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+				EXPECT_FLOAT_EQ(a[c][r], b[c][r]) << "column " << c << ", row " << r;
+		}
+	}
+}//namespace
+
+TEST(SkinningTest, Offsets)
+{
+	using namespace sh::game;
+	std::vector<uint32_t> offsets;
+	EXPECT_EQ(SkinningSystem::CalcOffsets({ 4, 1, 7, 2 }, offsets), 14);
+	EXPECT_EQ(offsets, (std::vector<uint32_t>{ 0, 4, 5, 12 }));
+
+	// 이전 프레임보다 렌더러가 줄어든 경우
+	EXPECT_EQ(SkinningSystem::CalcOffsets({ 3, 3 }, offsets), 6);
+	EXPECT_EQ(offsets, (std::vector<uint32_t>{ 0, 3 }));
+	EXPECT_EQ(SkinningSystem::CalcOffsets({}, offsets), 0);
+	EXPECT_TRUE(offsets.empty());
+}
+
+TEST(SkinningTest, Overflow)
+{
+	using namespace sh::game;
+	using sh::render::SkinPaletteBuffer;
+	const std::vector<std::size_t> jointCounts{ 4, 1, 7, 2 };
+	std::vector<uint32_t> offsets;
+	const std::size_t total = SkinningSystem::CalcOffsets(jointCounts, offsets);
+
+	EXPECT_EQ(SkinningSystem::ClipOffsets(jointCounts, total, offsets), 0);
+	EXPECT_EQ(offsets, (std::vector<uint32_t>{ 0, 4, 5, 12 }));
+
+	// 구간이 잡은 공간 끝에 딱 맞는 렌더러는 그대로, 넘는 렌더러만 그리지 않는다.
+	SkinningSystem::CalcOffsets(jointCounts, offsets);
+	EXPECT_EQ(SkinningSystem::ClipOffsets(jointCounts, 12, offsets), 1);
+	EXPECT_EQ(offsets, (std::vector<uint32_t>{ 0, 4, 5, SkinPaletteBuffer::INVALID_OFFSET }));
+
+	SkinningSystem::CalcOffsets(jointCounts, offsets);
+	EXPECT_EQ(SkinningSystem::ClipOffsets(jointCounts, 8, offsets), 2);
+	EXPECT_EQ(offsets, (std::vector<uint32_t>{ 0, 4, SkinPaletteBuffer::INVALID_OFFSET, SkinPaletteBuffer::INVALID_OFFSET }));
+
+	// 공간을 전혀 잡지 못함
+	SkinningSystem::CalcOffsets(jointCounts, offsets);
+	EXPECT_EQ(SkinningSystem::ClipOffsets(jointCounts, 0, offsets), jointCounts.size());
+	for (uint32_t offset : offsets)
+		EXPECT_EQ(offset, SkinPaletteBuffer::INVALID_OFFSET);
+
+	// 공유 버퍼 용량을 넘으면 넘친 렌더러 뒤의 작은 렌더러도 들어가지 못한다.
+	const std::vector<std::size_t> largeCounts{ SkinPaletteBuffer::CAPACITY - 10, 20, 5 };
+	SkinningSystem::CalcOffsets(largeCounts, offsets);
+	EXPECT_EQ(SkinningSystem::ClipOffsets(largeCounts, SkinPaletteBuffer::CAPACITY, offsets), 2);
+	EXPECT_EQ(offsets[0], 0);
+	EXPECT_EQ(offsets[1], SkinPaletteBuffer::INVALID_OFFSET);
+	EXPECT_EQ(offsets[2], SkinPaletteBuffer::INVALID_OFFSET);
+}
+
+TEST(SkinningTest, ComputeSkinMatricesWithAnimator)
+{
+	using namespace skinningTest;
+	using sh::game::SkinnedMeshRenderer;
+	const std::vector<glm::mat4> modelMatrices{ Translate(1.f, 0.f, 0.f), Translate(0.f, 2.f, 0.f) };
+	const std::vector<glm::mat4> inverseBindMatrices{ Scale(2.f), Translate(-1.f, 0.f, 0.f), Scale(3.f) };
+	const glm::mat4 toRenderer = Translate(0.f, 0.f, 5.f);
+
+	// 조인트 수보다 하나 더 잡아 범위 밖은 건드리지 않는지 본다.
+	std::vector<glm::mat4> out(inverseBindMatrices.size() + 1, Scale(7.f));
+	SkinnedMeshRenderer::ComputeSkinMatrices(modelMatrices, toRenderer, inverseBindMatrices, out.data());
+
+	glm::mat4 expected0 = Scale(2.f);
+	expected0[3] = glm::vec4{ 1.f, 0.f, 5.f, 1.f };
+	ExpectMatEq(out[0], expected0);
+	ExpectMatEq(out[1], Translate(-1.f, 2.f, 5.f));
+	// Animator의 조인트가 모자라면 단위 행렬
+	ExpectMatEq(out[2], glm::mat4{ 1.f });
+	ExpectMatEq(out[3], Scale(7.f));
+
+	// Animator의 조인트가 더 많아도 렌더러의 조인트 수만큼만 쓴다.
+	const std::vector<glm::mat4> shortInverseBindMatrices{ Scale(2.f) };
+	std::fill(out.begin(), out.end(), Scale(7.f));
+	SkinnedMeshRenderer::ComputeSkinMatrices(modelMatrices, toRenderer, shortInverseBindMatrices, out.data());
+	ExpectMatEq(out[0], expected0);
+	ExpectMatEq(out[1], Scale(7.f));
+}
+
+TEST(SkinningTest, ComputeSkinMatricesWithBones)
+{
+	using namespace skinningTest;
+	using sh::game::SkinnedMeshRenderer;
+	const glm::mat4 bone0 = Translate(1.f, 2.f, 3.f);
+	const glm::mat4 bone2 = Scale(2.f);
+	// 1번 본은 지워진 트랜스폼
+	const std::vector<const glm::mat4*> boneMatrices{ &bone0, nullptr, &bone2 };
+	const std::vector<glm::mat4> inverseBindMatrices{ Translate(-1.f, 0.f, 0.f), Scale(5.f), Translate(0.f, 1.f, 0.f), Scale(3.f) };
+
+	std::vector<glm::mat4> out(inverseBindMatrices.size(), Scale(7.f));
+	SkinnedMeshRenderer::ComputeSkinMatrices(boneMatrices, inverseBindMatrices, out.data());
+
+	ExpectMatEq(out[0], Translate(0.f, 2.f, 3.f));
+	ExpectMatEq(out[1], glm::mat4{ 1.f });
+	glm::mat4 expected2 = Scale(2.f);
+	expected2[3] = glm::vec4{ 0.f, 2.f, 0.f, 1.f };
+	ExpectMatEq(out[2], expected2);
+	// 본이 모자라면 단위 행렬
+	ExpectMatEq(out[3], glm::mat4{ 1.f });
+}
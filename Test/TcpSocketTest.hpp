@@ -0,0 +1,289 @@
+﻿#pragma once
+#include "Network/NetworkContext.h"
+#include "Network/TcpSocket.h"
+#include "Network/TcpListener.h"
+#include "Network/MessageQueue.h"
+#include "Network/Packet.h"
+#include "Network/StringPacket.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <string>
+
+/// @brief 바이너리 코덱을 쓰는 큰 패킷
+class TcpBlobPacket : public sh::network::Packet
+{
+	SPACKET(TcpBlobPacket, 102)
+	SPACKET_CODEC()
+public:
+	auto GetId() const -> uint32_t override { return 102; }
+	auto Serialize() const -> sh::core::Json override
+	{
+		sh::core::Json json = Packet::Serialize();
+		json["seq"] = seq;
+		json["payload"] = sh::core::Json::binary(payload);
+		return json;
+	}
+	void Deserialize(const sh::core::Json& json) override
+	{
+		Packet::Deserialize(json);
+		seq = json["seq"];
+		payload = json["payload"].get_binary();
+	}
+
+	template<typename Stream>
+	void Codec(Stream& stream)
+	{
+		stream.Varint(seq);
+		stream.Bytes(payload, 512 * 1024);
+	}
+public:
+	uint32_t seq = 0;
+	std::vector<uint8_t> payload;
+};
+/// @brief 코덱이 없어서 BSON으로 보내지는 패킷
+class TcpJsonPacket : public sh::network::Packet
+{
+	SPACKET(TcpJsonPacket, 103)
+public:
+	auto GetId() const -> uint32_t override { return 103; }
+	auto Serialize() const -> sh::core::Json override
+	{
+		sh::core::Json json = Packet::Serialize();
+		json["seq"] = seq;
+		json["text"] = text;
+		return json;
+	}
+	void Deserialize(const sh::core::Json& json) override
+	{
+		Packet::Deserialize(json);
+		seq = json["seq"];
+		text = json["text"];
+	}
+public:
+	uint32_t seq = 0;
+	std::string text;
+};
+
+namespace tcpTest
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// @brief localhost로 연결된 클라이언트, 서버 소켓 한 쌍
+	class TcpPair
+	{
+	public:
+		TcpPair() :
+			listener(ctx),
+			clientQueue(std::make_shared<sh::network::MessageQueue>()),
+			serverQueue(std::make_shared<sh::network::MessageQueue>())
+		{
+			using namespace sh::network;
+			bOpen = listener.Listen(0);
+			networkThread = std::thread{ [this]() { ctx.Update(); } };
+			if (!bOpen)
+				return;
+
+			client = std::make_unique<TcpSocket>(ctx);
+			client->SetReceiveQueue(clientQueue);
+			client->Connect("127.0.0.1", listener.GetLocalPort());
+
+			std::optional<TcpSocket> joined;
+			const auto deadline = Clock::now() + std::chrono::seconds{ 2 };
+			while (!joined.has_value() && Clock::now() < deadline)
+			{
+				joined = listener.GetJoinedSocket();
+				std::this_thread::yield();
+			}
+			if (!joined.has_value())
+			{
+				bOpen = false;
+				return;
+			}
+			server = std::make_unique<TcpSocket>(std::move(joined.value()));
+			server->SetReceiveQueue(serverQueue);
+			server->ReadStart();
+		}
+		~TcpPair()
+		{
+			if (client != nullptr)
+				client->Close();
+			if (server != nullptr)
+				server->Close();
+			ctx.Stop();
+			networkThread.join();
+		}
+		auto IsOpen() const -> bool { return bOpen; }
+
+		/// @brief count개가 도착하거나 시간이 다 될 때 까지 큐를 비운다.
+		static auto Receive(sh::network::MessageQueue& queue, std::size_t count, std::vector<std::unique_ptr<sh::network::Packet>>& out) -> std::size_t
+		{
+			const auto deadline = Clock::now() + std::chrono::seconds{ 5 };
+			while (out.size() < count && Clock::now() < deadline)
+			{
+				while (auto msg = queue.Pop())
+					out.push_back(std::move(msg->packet));
+				std::this_thread::yield();
+			}
+			return out.size();
+		}
+	public:
+		sh::network::NetworkContext ctx;
+		sh::network::TcpListener listener;
+		std::unique_ptr<sh::network::TcpSocket> client;
+		std::unique_ptr<sh::network::TcpSocket> server;
+		std::shared_ptr<sh::network::MessageQueue> clientQueue;
+		std::shared_ptr<sh::network::MessageQueue> serverQueue;
+		std::thread networkThread;
+		bool bOpen = false;
+	};
+}//namespace
+
+TEST(TcpSocketTest, MixedSizesArriveInOrder)
+{
+	using namespace sh::network;
+	using namespace tcpTest;
+	TcpPair pair{};
+	ASSERT_TRUE(pair.IsOpen());
+
+	// 수신 버퍼(64KB)보다 큰 메시지와 여러 메시지가 한 번에 읽히는 경우를 섞는다.
+	const std::vector<std::size_t> sizes{ 0, 1, 100, 1000, 5000, 70000, 3, 200000, 65530, 65536, 10, 400000, 7 };
+	for (std::size_t i = 0; i < sizes.size(); ++i)
+	{
+		if (i % 2 == 0)
+		{
+			TcpBlobPacket packet{};
+			packet.seq = static_cast<uint32_t>(i);
+			packet.payload.resize(sizes[i]);
+			for (std::size_t j = 0; j < sizes[i]; ++j)
+				packet.payload[j] = static_cast<uint8_t>(j * 7 + i);
+			pair.client->Send(packet);
+		}
+		else
+		{
+			TcpJsonPacket packet{};
+			packet.seq = static_cast<uint32_t>(i);
+			packet.text.assign(sizes[i], static_cast<char>('a' + i));
+			pair.client->Send(packet);
+		}
+	}
+
+	std::vector<std::unique_ptr<Packet>> received;
+	ASSERT_EQ(TcpPair::Receive(*pair.serverQueue, sizes.size(), received), sizes.size());
+	for (std::size_t i = 0; i < sizes.size(); ++i)
+	{
+		if (i % 2 == 0)
+		{
+			auto packet = dynamic_cast<TcpBlobPacket*>(received[i].get());
+			ASSERT_NE(packet, nullptr);
+			EXPECT_EQ(packet->seq, i);
+			ASSERT_EQ(packet->payload.size(), sizes[i]);
+			bool bSame = true;
+			for (std::size_t j = 0; j < sizes[i]; ++j)
+				bSame &= packet->payload[j] == static_cast<uint8_t>(j * 7 + i);
+			EXPECT_TRUE(bSame);
+		}
+		else
+		{
+			auto packet = dynamic_cast<TcpJsonPacket*>(received[i].get());
+			ASSERT_NE(packet, nullptr);
+			EXPECT_EQ(packet->seq, i);
+			EXPECT_EQ(packet->text, std::string(sizes[i], static_cast<char>('a' + i)));
+		}
+	}
+}
+
+TEST(TcpSocketTest, OversizedJsonIsDropped)
+{
+	using namespace sh::network;
+	using namespace tcpTest;
+	TcpPair pair{};
+	ASSERT_TRUE(pair.IsOpen());
+
+	// 최대 크기를 넘는 BSON 본문은 보내지 않고, 연결은 그대로 유지된다.
+	TcpJsonPacket big{};
+	big.seq = 1;
+	big.text.assign(TcpSocket::MAX_BODY_SIZE + 1, 'x');
+	pair.client->Send(big);
+
+	TcpJsonPacket small{};
+	small.seq = 2;
+	small.text = "ok";
+	pair.client->Send(small);
+
+	std::vector<std::unique_ptr<Packet>> received;
+	ASSERT_EQ(TcpPair::Receive(*pair.serverQueue, 1, received), 1);
+	auto packet = dynamic_cast<TcpJsonPacket*>(received[0].get());
+	ASSERT_NE(packet, nullptr);
+	EXPECT_EQ(packet->seq, 2);
+	EXPECT_EQ(packet->text, "ok");
+}
+
+TEST(TcpSocketTest, LongStringPacket)
+{
+	using namespace sh::network;
+	using namespace tcpTest;
+	TcpPair pair{};
+	ASSERT_TRUE(pair.IsOpen());
+
+	// 바이너리 코덱으로도 MAX_PACKET_SIZE보다 긴 문자열이 잘리지 않고 전달되어야 한다.
+	std::string text(100000, 'a');
+	for (std::size_t i = 0; i < text.size(); ++i)
+		text[i] = static_cast<char>('a' + i % 26);
+	StringPacket packet{};
+	packet.SetString(text);
+	pair.client->Send(packet);
+
+	std::vector<std::unique_ptr<Packet>> received;
+	ASSERT_EQ(TcpPair::Receive(*pair.serverQueue, 1, received), 1);
+	auto str = dynamic_cast<StringPacket*>(received[0].get());
+	ASSERT_NE(str, nullptr);
+	EXPECT_EQ(str->GetString(), text);
+}
+
+TEST(TcpSocketTest, ManySendsFromManyThreads)
+{
+	using namespace sh::network;
+	using namespace tcpTest;
+	constexpr uint32_t threadCount = 4;
+	constexpr uint32_t perThread = 5000;
+	TcpPair pair{};
+	ASSERT_TRUE(pair.IsOpen());
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back(
+			[&pair, t]()
+			{
+				TcpBlobPacket packet{};
+				packet.payload.resize(1, static_cast<uint8_t>(t));
+				for (uint32_t seq = 0; seq < perThread; ++seq)
+				{
+					packet.seq = seq;
+					pair.server->Send(packet);
+				}
+			}
+		);
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	std::vector<std::unique_ptr<Packet>> received;
+	ASSERT_EQ(TcpPair::Receive(*pair.clientQueue, threadCount * perThread, received), threadCount * perThread);
+	// 스레드 사이의 순서는 정해지지 않지만 한 스레드가 보낸 순서는 지켜진다.
+	std::vector<uint32_t> nextSeq(threadCount, 0);
+	for (auto& packet : received)
+	{
+		auto blob = static_cast<TcpBlobPacket*>(packet.get());
+		ASSERT_EQ(blob->payload.size(), 1);
+		const uint8_t thread = blob->payload[0];
+		ASSERT_LT(thread, threadCount);
+		EXPECT_EQ(blob->seq, nextSeq[thread]);
+		nextSeq[thread] = blob->seq + 1;
+	}
+}
@@ -0,0 +1,315 @@
+﻿#pragma once
+#include "Render/TextureCompressor.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace textureCompressorTest
+{
+	using Block = std::array<uint8_t, 64>;
+
+	inline auto Expand565(uint16_t c) -> std::array<int, 3>
+	{
+		const int r = (c >> 11) & 31;
+		const int g = (c >> 5) & 63;
+		const int b = c & 31;
+		return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+	}
+	/// @brief 4색 모드 BC1 블록을 RGB로 복원한다.
+	inline void DecodeBC1(const uint8_t* in, Block& out)
+	{
+		const uint16_t c0 = in[0] | (in[1] << 8);
+		const uint16_t c1 = in[2] | (in[3] << 8);
+		const auto e0 = Expand565(c0);
+		const auto e1 = Expand565(c1);
+		std::array<std::array<int, 3>, 4> palette{ e0, e1 };
+		for (int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+			palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+		}
+		const uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+		for (int i = 0; i < 16; ++i)
+		{
+			const auto& color = palette[(indices >> (i * 2)) & 3];
+			for (int c = 0; c < 3; ++c)
+				out[i * 4 + c] = static_cast<uint8_t>(color[c]);
+		}
+	}
+	/// @brief BC4 블록을 한 채널로 복원한다.
+	inline void DecodeBC4(const uint8_t* in, int channel, Block& out)
+	{
+		const int r0 = in[0];
+		const int r1 = in[1];
+		int palette[8] = { r0, r1 };
+		for (int i = 1; i < 7; ++i)
+			palette[i + 1] = r0 > r1 ? ((7 - i) * r0 + i * r1) / 7 : 0;
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; ++i)
+			indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+		for (int i = 0; i < 16; ++i)
+			out[i * 4 + channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+	}
+	/// @brief BC7 모드 6 블록을 RGBA로 복원한다.
+	inline void DecodeBC7Mode6(const uint8_t* in, Block& out)
+	{
+		int pos = 0;
+		auto read = [&](int bits)
+			{
+				int value = 0;
+				for (int i = 0; i < bits; ++i, ++pos)
+					value |= ((in[pos / 8] >> (pos % 8)) & 1) << i;
+				return value;
+			};
+		ASSERT_EQ(read(7), 1 << 6);
+		int e[2][4];
+		for (int c = 0; c < 4; ++c)
+		{
+			e[0][c] = read(7);
+			e[1][c] = read(7);
+		}
+		const int p0 = read(1);
+		const int p1 = read(1);
+		for (int c = 0; c < 4; ++c)
+		{
+			e[0][c] = (e[0][c] << 1) | p0;
+			e[1][c] = (e[1][c] << 1) | p1;
+		}
+		constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		for (int i = 0; i < 16; ++i)
+		{
+			const int w = weights[read(i == 0 ? 3 : 4)];
+			for (int c = 0; c < 4; ++c)
+				out[i * 4 + c] = static_cast<uint8_t>(((64 - w) * e[0][c] + w * e[1][c] + 32) >> 6);
+		}
+	}
+	inline auto MaxError(const Block& a, const Block& b, int channels) -> int
+	{
+		int error = 0;
+		for (int i = 0; i < 16; ++i)
+			for (int c = 0; c < channels; ++c)
+				error = std::max(error, std::abs(a[i * 4 + c] - b[i * 4 + c]));
+		return error;
+	}
+	inline auto MakeGradient() -> Block
+	{
+		Block block{};
+		for (int i = 0; i < 16; ++i)
+		{
+			block[i * 4 + 0] = static_cast<uint8_t>(40 + i * 12);
+			block[i * 4 + 1] = static_cast<uint8_t>(200 - i * 8);
+			block[i * 4 + 2] = static_cast<uint8_t>(90 + i * 4);
+			block[i * 4 + 3] = static_cast<uint8_t>(255 - i * 10);
+		}
+		return block;
+	}
+}//namespace
+
+TEST(TextureCompressorTest, FormatSize)
+{
+	using namespace sh::render;
+	EXPECT_EQ(GetTextureFormatBlockSize(TextureFormat::BC1), 8);
+	EXPECT_EQ(GetTextureFormatBlockSize(TextureFormat::BC4), 8);
+	EXPECT_EQ(GetTextureFormatBlockSize(TextureFormat::BC3_SRGB), 16);
+	EXPECT_EQ(GetTextureFormatBlockSize(TextureFormat::BC7), 16);
+	EXPECT_EQ(GetTextureFormatBlockSize(TextureFormat::RGBA32), 0);
+	// 4의 배수가 아니면 블록 단위로 올림
+	EXPECT_EQ(GetTextureFormatMipSize(TextureFormat::BC1, 5, 5), 2 * 2 * 8);
+	EXPECT_EQ(GetTextureFormatMipSize(TextureFormat::BC7, 1, 1), 16);
+	EXPECT_EQ(GetTextureFormatMipSize(TextureFormat::RGBA32, 5, 5), 5 * 5 * 4);
+
+	EXPECT_EQ(TextureCompressor::GetCompressedFormat(TextureCompression::Color, true, false), TextureFormat::BC1_SRGB);
+	EXPECT_EQ(TextureCompressor::GetCompressedFormat(TextureCompression::Color, false, true), TextureFormat::BC3);
+	EXPECT_EQ(TextureCompressor::GetCompressedFormat(TextureCompression::NormalMap, true, false), TextureFormat::BC5);
+	EXPECT_EQ(TextureCompressor::GetCompression(TextureFormat::BC7_SRGB), TextureCompression::ColorHighQuality);
+}
+
+TEST(TextureCompressorTest, BC1)
+{
+	using namespace textureCompressorTest;
+	using namespace sh::render;
+
+	Block solid{};
+	for (int i = 0; i < 16; ++i)
+	{
+		solid[i * 4 + 0] = 200;
+		solid[i * 4 + 1] = 100;
+		solid[i * 4 + 2] = 50;
+		solid[i * 4 + 3] = 255;
+	}
+	uint8_t encoded[8];
+	TextureCompressor::CompressBlock(solid.data(), TextureFormat::BC1, encoded);
+	Block decoded = solid;
+	DecodeBC1(encoded, decoded);
+	EXPECT_LE(MaxError(solid, decoded, 3), 4);
+
+	const Block gradient = MakeGradient();
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC1, encoded);
+	// 4색 모드여야 한다.
+	EXPECT_GT(encoded[0] | (encoded[1] << 8), encoded[2] | (encoded[3] << 8));
+	decoded = gradient;
+	DecodeBC1(encoded, decoded);
+	EXPECT_LE(MaxError(gradient, decoded, 3), 32);
+}
+
+TEST(TextureCompressorTest, BC3AndBC5)
+{
+	using namespace textureCompressorTest;
+	using namespace sh::render;
+	const Block gradient = MakeGradient();
+
+	uint8_t encoded[16];
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC3, encoded);
+	Block decoded = gradient;
+	DecodeBC4(encoded, 3, decoded);
+	DecodeBC1(encoded + 8, decoded);
+	EXPECT_LE(MaxError(gradient, decoded, 4), 32);
+
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC5, encoded);
+	decoded = gradient;
+	DecodeBC4(encoded, 0, decoded);
+	DecodeBC4(encoded + 8, 1, decoded);
+	EXPECT_LE(MaxError(gradient, decoded, 2), 12);
+}
+
+TEST(TextureCompressorTest, BC7)
+{
+	using namespace textureCompressorTest;
+	using namespace sh::render;
+	const Block gradient = MakeGradient();
+
+	uint8_t encoded[16];
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC7, encoded);
+	EXPECT_EQ(encoded[0] & 0x7f, 0x40);
+	Block decoded{};
+	DecodeBC7Mode6(encoded, decoded);
+	EXPECT_LE(MaxError(gradient, decoded, 4), 16);
+}
+
+TEST(TextureCompressorTest, Compress)
+{
+	using namespace textureCompressorTest;
+	using namespace sh::render;
+	constexpr uint32_t width = 130;
+	constexpr uint32_t height = 66;
+
+	std::vector<std::vector<uint8_t>> mips;
+	for (uint32_t w = width, h = height;; w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+	{
+		std::vector<uint8_t> mip(w * h * 4);
+		for (uint32_t i = 0; i < w * h; ++i)
+		{
+			mip[i * 4 + 0] = static_cast<uint8_t>(i % w);
+			mip[i * 4 + 1] = static_cast<uint8_t>(i / w);
+			mip[i * 4 + 2] = 128;
+			mip[i * 4 + 3] = 255;
+		}
+		mips.push_back(std::move(mip));
+		if (w == 1 && h == 1)
+			break;
+	}
+	const auto compressed = TextureCompressor::Compress(mips, width, height, TextureFormat::BC7);
+	ASSERT_EQ(compressed.size(), mips.size());
+	for (std::size_t m = 0; m < mips.size(); ++m)
+	{
+		const uint32_t w = std::max(1u, width >> m);
+		const uint32_t h = std::max(1u, height >> m);
+		EXPECT_EQ(compressed[m].size(), GetTextureFormatMipSize(TextureFormat::BC7, w, h));
+	}
+	// 병렬로 나눠서 처리해도 블록 단위 결과와 같아야 한다.
+	Block first{};
+	for (int y = 0; y < 4; ++y)
+		std::copy_n(mips[0].begin() + y * width * 4, 16, first.begin() + y * 16);
+	uint8_t encoded[16];
+	TextureCompressor::CompressBlock(first.data(), TextureFormat::BC7, encoded);
+	EXPECT_TRUE(std::equal(encoded, encoded + 16, compressed[0].begin()));
+
+	EXPECT_FALSE(TextureCompressor::HasAlpha(mips[0]));
+}
+
+TEST(TextureCompressorTest, Decompress)
+{
+	using namespace textureCompressorTest;
+	using namespace sh::render;
+	const Block gradient = MakeGradient();
+
+	// 블록 단위 복원은 참조 디코더와 같아야 한다.
+	uint8_t encoded[16];
+	Block expected{};
+	Block decoded{};
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC7, encoded);
+	DecodeBC7Mode6(encoded, expected);
+	TextureCompressor::DecompressBlock(encoded, TextureFormat::BC7, decoded.data());
+	EXPECT_EQ(decoded, expected);
+
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC3, encoded);
+	expected = gradient;
+	DecodeBC4(encoded, 3, expected);
+	DecodeBC1(encoded + 8, expected);
+	TextureCompressor::DecompressBlock(encoded, TextureFormat::BC3, decoded.data());
+	EXPECT_EQ(decoded, expected);
+
+	TextureCompressor::CompressBlock(gradient.data(), TextureFormat::BC5, encoded);
+	TextureCompressor::DecompressBlock(encoded, TextureFormat::BC5, decoded.data());
+	EXPECT_LE(MaxError(gradient, decoded, 2), 12);
+	for (int i = 0; i < 16; ++i)
+	{
+		EXPECT_EQ(decoded[i * 4 + 2], 0);
+		EXPECT_EQ(decoded[i * 4 + 3], 255);
+	}
+
+	// 3색 모드 BC1의 마지막 인덱스는 투명한 검은색
+	const uint8_t threeColor[8] = { 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	TextureCompressor::DecompressBlock(threeColor, TextureFormat::BC1, decoded.data());
+	EXPECT_EQ(decoded[0], 0);
+	EXPECT_EQ(decoded[3], 0);
+
+	EXPECT_EQ(TextureCompressor::GetDecompressedFormat(TextureFormat::BC7_SRGB), TextureFormat::SRGBA32);
+	EXPECT_EQ(TextureCompressor::GetDecompressedFormat(TextureFormat::BC5), TextureFormat::RGBA32);
+	EXPECT_EQ(TextureCompressor::GetDecompressedFormat(TextureFormat::RGBA32), TextureFormat::RGBA32);
+}
+
+TEST(TextureCompressorTest, DecompressMips)
+{
+	using namespace sh::render;
+	constexpr uint32_t width = 10;
+	constexpr uint32_t height = 6;
+
+	std::vector<std::vector<uint8_t>> mips;
+	for (uint32_t w = width, h = height;; w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+	{
+		std::vector<uint8_t> mip(w * h * 4);
+		for (uint32_t i = 0; i < w * h; ++i)
+		{
+			mip[i * 4 + 0] = static_cast<uint8_t>((i % w) * 8);
+			mip[i * 4 + 1] = static_cast<uint8_t>(255 - (i / w) * 8);
+			mip[i * 4 + 2] = 128;
+			mip[i * 4 + 3] = 255;
+		}
+		mips.push_back(std::move(mip));
+		if (w == 1 && h == 1)
+			break;
+	}
+	auto compressed = TextureCompressor::Compress(mips, width, height, TextureFormat::BC7);
+	ASSERT_EQ(compressed.size(), mips.size());
+	// 스트리밍으로 해제된 밉
+	std::vector<uint8_t>{}.swap(compressed[0]);
+
+	const auto decompressed = TextureCompressor::Decompress(compressed, width, height, TextureFormat::BC7);
+	ASSERT_EQ(decompressed.size(), mips.size());
+	EXPECT_TRUE(decompressed[0].empty());
+	for (std::size_t m = 1; m < mips.size(); ++m)
+	{
+		ASSERT_EQ(decompressed[m].size(), mips[m].size());
+		int error = 0;
+		for (std::size_t i = 0; i < mips[m].size(); ++i)
+			error = std::max(error, std::abs(decompressed[m][i] - mips[m][i]));
+		EXPECT_LE(error, 32);
+	}
+	// 크기가 맞지 않는 밉
+	compressed[1].pop_back();
+	EXPECT_TRUE(TextureCompressor::Decompress(compressed, width, height, TextureFormat::BC7).empty());
+}
@@ -0,0 +1,359 @@
+﻿#pragma once
+#include "Game/TextureStreamer.h"
+#include "Game/Asset/TextureAsset.h"
+
+#include "Core/SObject.h"
+#include "Core/AssetExporter.h"
+#include "Core/AssetImporter.h"
+#include "Core/ThreadPool.h"
+
+#include "Render/Texture.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace textureStreamerTest
+{
+	constexpr uint32_t TEX_SIZE = 256;
+	constexpr uint32_t TAIL_SIZE = 64;
+	constexpr uint32_t TAIL_MIP = 2;
+
+	/// @brief TEX_SIZE 크기의 RGBA32 텍스쳐를 firstMip부터의 크기
+	inline auto MipsSize(uint32_t firstMip) -> std::size_t
+	{
+		std::size_t size = 0;
+		for (uint32_t size2 = TEX_SIZE >> firstMip; size2 > 0; size2 >>= 1)
+			size += static_cast<std::size_t>(size2) * size2 * 4;
+		return size;
+	}
+	/// @brief 밉 꼬리는 GPU와 CPU에 하나씩 있다.
+	inline auto TailSize() -> std::size_t
+	{
+		return MipsSize(TAIL_MIP) * 2;
+	}
+	inline auto PixelValue(uint32_t mip, std::size_t i) -> uint8_t
+	{
+		return static_cast<uint8_t>(mip * 16 + i % 7);
+	}
+
+	/// @brief 에셋 파일 대신 메모리의 텍스쳐 에셋을 돌려주는 소스. 막아두면 워커 스레드에서 풀릴 때까지 기다린다.
+	class FakeSource
+	{
+	public:
+		void Add(const sh::core::UUID& uuid, std::vector<uint8_t> blob)
+		{
+			blobs.insert_or_assign(uuid, std::move(blob));
+		}
+		auto Load(const sh::core::UUID& uuid) -> std::unique_ptr<sh::core::Asset>
+		{
+			++calls;
+			{
+				std::unique_lock<std::mutex> lock{ mu };
+				cv.wait(lock, [this] { return !bBlocked; });
+			}
+			std::unique_ptr<sh::core::Asset> asset;
+			auto it = blobs.find(uuid);
+			if (it != blobs.end())
+				asset = sh::core::AssetImporter::LoadFromMemory(it->second);
+			++completed;
+			return asset;
+		}
+		void SetBlocked(bool bBlocked)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ mu };
+				this->bBlocked = bBlocked;
+			}
+			cv.notify_all();
+		}
+	public:
+		std::atomic<int> calls = 0;
+		std::atomic<int> completed = 0;
+	private:
+		std::unordered_map<sh::core::UUID, std::vector<uint8_t>> blobs;
+		std::mutex mu;
+		std::condition_variable cv;
+		bool bBlocked = false;
+	};
+
+	/// @brief TextureLoader처럼 모든 밉을 에셋으로 저장하고 밉 꼬리만 남긴 텍스쳐를 만든다.
+	inline auto MakeTexture(FakeSource& source) -> sh::render::Texture*
+	{
+		using namespace sh;
+		render::Texture* const texture = core::SObject::Create<render::Texture>(render::TextureFormat::RGBA32, TEX_SIZE, TEX_SIZE, true);
+		for (uint32_t mip = 0; mip < texture->GetMipLevel(); ++mip)
+		{
+			std::vector<uint8_t> pixels(texture->GetPixelData(mip).size());
+			for (std::size_t i = 0; i < pixels.size(); ++i)
+				pixels[i] = PixelValue(mip, i);
+			texture->SetPixelData(std::move(pixels), mip);
+		}
+		source.Add(texture->GetUUID(), core::AssetExporter::SaveToMemory(game::TextureAsset{ *texture }, false));
+		texture->SetResidentMips(TAIL_MIP, {});
+		return texture;
+	}
+	inline auto MakeStreamer(const std::shared_ptr<FakeSource>& source, std::size_t budget) -> std::unique_ptr<sh::game::TextureStreamer>
+	{
+		using namespace sh;
+		if (!core::ThreadPool::GetInstance()->IsInit())
+			core::ThreadPool::GetInstance()->Init(4);
+		auto streamer = std::make_unique<game::TextureStreamer>([source](const core::UUID& uuid) { return source->Load(uuid); });
+		game::TextureStreamer::Settings settings{};
+		settings.tailSize = TAIL_SIZE;
+		settings.memoryBudget = budget;
+		streamer->SetSettings(settings);
+		return streamer;
+	}
+	/// @brief 요청 없이 읽고 있는 밉이 모두 반영될 때까지 Update를 반복한다.
+	inline auto WaitLoads(sh::game::TextureStreamer& streamer) -> bool
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			streamer.Update();
+			if (streamer.GetLoadingSize() == 0)
+				return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		return false;
+	}
+	inline void Request(sh::game::TextureStreamer& streamer, const sh::render::Texture& texture, uint32_t mip)
+	{
+		streamer.RequestMip(texture, mip);
+		streamer.Update();
+	}
+}//namespace
+
+TEST(TextureStreamerTest, CalcMip)
+{
+	using namespace sh::game;
+	// 화면에서 텍스쳐보다 크게 보이면 원본 밉
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 2048.f), 0);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 1024.f), 0);
+	// 절반 크기로 보일 때마다 한 단계씩 내려간다.
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 512.f), 1);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 300.f), 1);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 256.f), 2);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 1.f), 10);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 512.f, 1.f), 2);
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 512.f, -2.f), 0);
+	// 보이지 않으면 요청하지 않는다.
+	EXPECT_EQ(TextureStreamer::CalcMip(1024, 0.f), std::numeric_limits<uint32_t>::max());
+}
+
+TEST(TextureStreamerTest, TailMip)
+{
+	using namespace sh::game;
+	TextureStreamer streamer{ nullptr };
+	TextureStreamer::Settings settings{};
+	settings.tailSize = 128;
+	streamer.SetSettings(settings);
+
+	EXPECT_EQ(streamer.GetTailMip(1024, 1024, 11), 3);
+	EXPECT_EQ(streamer.GetTailMip(2048, 512, 12), 4);
+	EXPECT_EQ(streamer.GetTailMip(128, 128, 8), 0);
+	// 밉이 없으면 스트리밍하지 않는다.
+	EXPECT_EQ(streamer.GetTailMip(1024, 1024, 1), 0);
+	EXPECT_EQ(streamer.GetTailMip(1024, 1024, 0), 0);
+	EXPECT_EQ(streamer.GetTextureCount(), 0);
+}
+
+TEST(TextureStreamerTest, Update)
+{
+	using namespace textureStreamerTest;
+	auto source = std::make_shared<FakeSource>();
+	auto streamer = MakeStreamer(source, std::numeric_limits<std::size_t>::max());
+
+	sh::render::Texture* const texture = MakeTexture(*source);
+	streamer->Register(*texture, texture->GetUUID());
+	EXPECT_EQ(streamer->GetTextureCount(), 1);
+	EXPECT_EQ(texture->GetResidentMip(), TAIL_MIP);
+
+	// 요청이 없으면 읽지 않는다.
+	streamer->Update();
+	EXPECT_EQ(source->calls, 0);
+	EXPECT_EQ(streamer->GetResidentSize(), TailSize());
+
+	Request(*streamer, *texture, 0);
+	EXPECT_EQ(streamer->GetLoadingSize(), MipsSize(0) - MipsSize(TAIL_MIP));
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(source->calls, 1);
+	EXPECT_EQ(texture->GetResidentMip(), 0);
+	for (uint32_t mip = 0; mip < TAIL_MIP; ++mip)
+	{
+		const auto& pixels = texture->GetPixelData(mip);
+		ASSERT_EQ(pixels.size(), MipsSize(mip) - MipsSize(mip + 1));
+		EXPECT_EQ(pixels[0], PixelValue(mip, 0));
+		EXPECT_EQ(pixels[pixels.size() - 1], PixelValue(mip, pixels.size() - 1));
+	}
+	streamer->Update();
+	EXPECT_EQ(streamer->GetResidentSize(), MipsSize(0) + MipsSize(TAIL_MIP));
+
+	// 이미 올라간 밉은 다시 읽지 않는다.
+	Request(*streamer, *texture, 1);
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+	EXPECT_EQ(source->calls, 1);
+
+	texture->Destroy();
+}
+
+TEST(TextureStreamerTest, Budget)
+{
+	using namespace textureStreamerTest;
+	auto source = std::make_shared<FakeSource>();
+	// 밉 꼬리(GPU, CPU)와 1번 밉까지만 들어가는 예산
+	const std::size_t budget = TailSize() + MipsSize(1) - MipsSize(TAIL_MIP);
+	auto streamer = MakeStreamer(source, budget);
+
+	sh::render::Texture* const texture = MakeTexture(*source);
+	streamer->Register(*texture, texture->GetUUID());
+
+	// 0번 밉은 예산을 넘으므로 들어가는 가장 높은 해상도를 읽는다.
+	Request(*streamer, *texture, 0);
+	EXPECT_EQ(streamer->GetLoadingSize(), MipsSize(1) - MipsSize(TAIL_MIP));
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(texture->GetResidentMip(), 1);
+	EXPECT_EQ(streamer->GetResidentSize(), budget);
+
+	// 더 들어갈 곳이 없다.
+	Request(*streamer, *texture, 0);
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+	EXPECT_EQ(source->calls, 1);
+
+	// 밉 꼬리는 해제되지 않으므로 텍스쳐가 늘어나면 예산을 넘을 수 있다.
+	sh::render::Texture* const other = MakeTexture(*source);
+	streamer->Register(*other, other->GetUUID());
+	streamer->Update();
+	EXPECT_EQ(streamer->GetResidentSize(), budget + TailSize());
+	// 오래된 텍스쳐를 내려도 자리가 없으면 읽지 않는다.
+	Request(*streamer, *other, 1);
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+	EXPECT_EQ(texture->GetResidentMip(), TAIL_MIP);
+	EXPECT_EQ(other->GetResidentMip(), TAIL_MIP);
+
+	texture->Destroy();
+	other->Destroy();
+}
+
+TEST(TextureStreamerTest, EvictLeastRecentlyUsed)
+{
+	using namespace textureStreamerTest;
+	auto source = std::make_shared<FakeSource>();
+	// 세 텍스쳐 중 둘만 0번 밉까지 올라갈 수 있다.
+	const std::size_t budget = TailSize() * 3 + (MipsSize(0) - MipsSize(TAIL_MIP)) * 2;
+	auto streamer = MakeStreamer(source, budget);
+
+	sh::render::Texture* const a = MakeTexture(*source);
+	sh::render::Texture* const b = MakeTexture(*source);
+	sh::render::Texture* const c = MakeTexture(*source);
+	streamer->Register(*a, a->GetUUID());
+	streamer->Register(*b, b->GetUUID());
+	streamer->Register(*c, c->GetUUID());
+
+	Request(*streamer, *a, 0);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	Request(*streamer, *c, 0);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(a->GetResidentMip(), 0);
+	EXPECT_EQ(c->GetResidentMip(), 0);
+
+	// 가장 오래 쓰이지 않은 a만 밉 꼬리로 내려간다.
+	Request(*streamer, *b, 0);
+	EXPECT_EQ(a->GetResidentMip(), TAIL_MIP);
+	EXPECT_EQ(c->GetResidentMip(), 0);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(b->GetResidentMip(), 0);
+	EXPECT_LE(streamer->GetResidentSize(), budget);
+
+	// 이번 프레임에 쓰인 텍스쳐는 내리지 않는다.
+	streamer->RequestMip(*b, 0);
+	streamer->RequestMip(*c, 0);
+	Request(*streamer, *a, 0);
+	EXPECT_EQ(b->GetResidentMip(), 0);
+	EXPECT_EQ(c->GetResidentMip(), 0);
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+	EXPECT_EQ(a->GetResidentMip(), TAIL_MIP);
+
+	a->Destroy();
+	b->Destroy();
+	c->Destroy();
+}
+
+TEST(TextureStreamerTest, EvictSkipsLoading)
+{
+	using namespace textureStreamerTest;
+	auto source = std::make_shared<FakeSource>();
+	const std::size_t mip0 = MipsSize(0) - MipsSize(1);
+	const std::size_t mip1 = MipsSize(1) - MipsSize(TAIL_MIP);
+	const std::size_t budget = TailSize() * 2 + mip0 + mip1 * 2;
+	auto streamer = MakeStreamer(source, budget);
+
+	sh::render::Texture* const a = MakeTexture(*source);
+	sh::render::Texture* const b = MakeTexture(*source);
+	streamer->Register(*a, a->GetUUID());
+	streamer->Register(*b, b->GetUUID());
+
+	Request(*streamer, *a, 1);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(a->GetResidentMip(), 1);
+
+	// a가 0번 밉을 읽는 동안에는 a를 내리지 않고 b는 예산 안의 밉을 읽는다.
+	source->SetBlocked(true);
+	Request(*streamer, *a, 0);
+	EXPECT_EQ(streamer->GetLoadingSize(), mip0);
+	Request(*streamer, *b, 0);
+	EXPECT_EQ(a->GetResidentMip(), 1);
+	EXPECT_EQ(streamer->GetLoadingSize(), mip0 + mip1);
+
+	source->SetBlocked(false);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(a->GetResidentMip(), 0);
+	EXPECT_EQ(b->GetResidentMip(), 1);
+	EXPECT_LE(streamer->GetResidentSize(), budget);
+
+	a->Destroy();
+	b->Destroy();
+}
+
+TEST(TextureStreamerTest, StaleTicket)
+{
+	using namespace textureStreamerTest;
+	auto source = std::make_shared<FakeSource>();
+	auto streamer = MakeStreamer(source, std::numeric_limits<std::size_t>::max());
+
+	sh::render::Texture* const texture = MakeTexture(*source);
+	streamer->Register(*texture, texture->GetUUID());
+
+	source->SetBlocked(true);
+	Request(*streamer, *texture, 0);
+	EXPECT_GT(streamer->GetLoadingSize(), 0);
+
+	// 읽는 중에 다시 등록되면 이전 요청의 결과는 버려진다.
+	streamer->Register(*texture, texture->GetUUID());
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+	source->SetBlocked(false);
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+	while (source->completed < 1 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	ASSERT_EQ(source->completed, 1);
+	std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+	streamer->Update();
+	EXPECT_EQ(texture->GetResidentMip(), TAIL_MIP);
+	EXPECT_EQ(streamer->GetLoadingSize(), 0);
+
+	// 새 요청은 정상적으로 반영된다.
+	Request(*streamer, *texture, 0);
+	ASSERT_TRUE(WaitLoads(*streamer));
+	EXPECT_EQ(texture->GetResidentMip(), 0);
+	EXPECT_EQ(source->calls, 2);
+
+	texture->Destroy();
+}
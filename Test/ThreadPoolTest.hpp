@@ -2,6 +2,60 @@
 #include "Core/ThreadPool.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threadPoolTest
+{
+	struct Chunk
+	{
+		std::size_t begin;
+		std::size_t end;
+		std::thread::id thread;
+	};
+	/// @brief ParallelFor가 모든 인덱스를 한 번씩, 스레드 수 + 1개 이하이면서 minChunk 이상인 연속 구간으로 나눠 실행했는지 검사한다.
+	inline void ExpectChunked(std::size_t count, std::size_t minChunk)
+	{
+		std::vector<std::atomic<int>> visits(count);
+		std::mutex mu;
+		std::vector<Chunk> chunks;
+		sh::core::ThreadPool::GetInstance()->ParallelFor(count,
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					visits[i].fetch_add(1);
+				std::lock_guard<std::mutex> lock{ mu };
+				chunks.push_back(Chunk{ begin, end, std::this_thread::get_id() });
+			},
+			minChunk
+		);
+		for (std::size_t i = 0; i < count; ++i)
+			EXPECT_EQ(visits[i].load(), 1) << "count " << count << ", index " << i;
+		if (count == 0)
+		{
+			EXPECT_TRUE(chunks.empty());
+			return;
+		}
+
+		const std::size_t maxChunkCount = sh::core::ThreadPool::GetInstance()->GetThreadNum() + 1;
+		EXPECT_LE(chunks.size(), maxChunkCount) << "count " << count;
+		for (const Chunk& chunk : chunks)
+		{
+			EXPECT_LT(chunk.begin, chunk.end);
+			// 나눌 수 있을 만큼 크지 않으면 한 구간으로 실행된다.
+			EXPECT_GE(chunk.end - chunk.begin, std::min(count, minChunk)) << "count " << count << ", minChunk " << minChunk;
+		}
+		if (count >= minChunk * 2)
+			EXPECT_GT(chunks.size(), 1u) << "count " << count << ", minChunk " << minChunk;
+		// 마지막 구간은 호출한 스레드가 맡는다.
+		auto last = std::find_if(chunks.begin(), chunks.end(), [count](const Chunk& chunk) { return chunk.end == count; });
+		ASSERT_NE(last, chunks.end());
+		EXPECT_EQ(last->thread, std::this_thread::get_id());
+	}
+}//namespace
 
 TEST(ThreadPoolTest, ThreadPoolTest)
 {
@@ -22,4 +76,28 @@ TEST(ThreadPoolTest, ThreadPoolTest)
 	int result1 = future1.get();
 	int result2 = future2.get();
 	EXPECT_NE(result1, result2); // 낮은 확률로 같을지도
-}
\ No newline at end of file
+}
+
+TEST(ThreadPoolTest, ParallelFor)
+{
+	sh::core::ThreadPool& threadPool = *sh::core::ThreadPool::GetInstance();
+	if (!threadPool.IsInit())
+		threadPool.Init(4);
+
+	for (std::size_t count : { 0, 1, 2, 3, 5, 64, 1001 })
+		threadPoolTest::ExpectChunked(count, 1);
+	for (std::size_t count : { 100, 255, 256, 511, 512, 1000, 10000 })
+		threadPoolTest::ExpectChunked(count, 256);
+
+	// 워커 스레드에서 호출하면 교착되지 않도록 그 스레드에서 한 번에 실행한다.
+	threadPool.AddTask(
+		[&threadPool]
+		{
+			std::vector<std::pair<std::size_t, std::size_t>> calls;
+			threadPool.ParallelFor(100, [&](std::size_t begin, std::size_t end) { calls.push_back({ begin, end }); });
+			ASSERT_EQ(calls.size(), 1);
+			EXPECT_EQ(calls[0].first, 0);
+			EXPECT_EQ(calls[0].second, 100);
+		}
+	).get();
+}
@@ -0,0 +1,200 @@
+﻿#pragma once
+#include "Network/NetworkContext.h"
+#include "Network/UdpSocket.h"
+#include "Network/Endpoint.h"
+#include "Network/StringPacket.h"
+#include "Network/NetworkService.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+#include <atomic>
+
+TEST(UdpSocketTest, Endpoint)
+{
+	using namespace sh::network;
+	const Endpoint a = Endpoint::FromString("127.0.0.1", 4026);
+	EXPECT_EQ(a, Endpoint::FromIPv4(0x7f000001, 4026));
+	EXPECT_EQ(a.GetIp(), "127.0.0.1");
+	EXPECT_NE(a, Endpoint::FromString("127.0.0.1", 4027));
+
+	const Endpoint v6 = Endpoint::FromString("::1", 4026);
+	EXPECT_TRUE(v6.bV6);
+	EXPECT_EQ(v6.GetIp(), "::1");
+
+	std::unordered_set<Endpoint> set{ a, v6 };
+	EXPECT_EQ(set.count(Endpoint::FromString("127.0.0.1", 4026)), 1u);
+}
+
+TEST(UdpSocketTest, BatchedLoopback)
+{
+	using namespace sh::network;
+	constexpr std::size_t count = 20000;
+
+	NetworkContext ctx{};
+	UdpSocket receiver{ ctx };
+	UdpSocket sender{ ctx };
+	ASSERT_TRUE(receiver.Bind());
+	ASSERT_TRUE(sender.Bind());
+	const Endpoint target = Endpoint::FromIPv4(0x7f000001, receiver.GetLocalPort());
+
+	std::thread networkThread{ [&ctx]() { ctx.Update(); } };
+
+	StringPacket packet{};
+	packet.SetString("ping");
+
+	std::vector<NetworkContext::Message> messages;
+	std::size_t received = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		sender.Enqueue(packet, target);
+		// 소켓 버퍼가 넘치지 않도록 중간에 받아간다.
+		if (i % UdpSocket::SEND_BATCH == 0)
+		{
+			sender.Flush();
+			received += receiver.GetReceivedMessages(messages);
+			messages.clear();
+		}
+	}
+	sender.Flush();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+	while (received < count && std::chrono::steady_clock::now() < deadline)
+	{
+		received += receiver.GetReceivedMessages(messages);
+		if (!messages.empty())
+		{
+			EXPECT_EQ(messages.back().sender.GetPort(), sender.GetLocalPort());
+			EXPECT_EQ(static_cast<StringPacket*>(messages.back().packet.get())->GetString(), "ping");
+		}
+		messages.clear();
+		std::this_thread::yield();
+	}
+
+	receiver.Close();
+	sender.Close();
+	ctx.Stop();
+	networkThread.join();
+
+	// 루프백이라도 커널 버퍼가 넘치면 유실될 수 있으므로 대부분 도착했는지만 확인한다.
+	EXPECT_GT(received, count / 2);
+}
+
+TEST(UdpSocketTest, NetworkService)
+{
+	using namespace sh::network;
+	constexpr std::size_t count = 256;
+
+	auto service = NetworkService::GetInstance();
+	service->Start(2);
+	EXPECT_EQ(service->GetThreadCount(), 2u);
+
+	std::size_t received = 0;
+	const auto receiverId = service->RegisterReceiver(
+		[&received](std::vector<NetworkContext::Message>& messages)
+		{
+			received += messages.size();
+		}
+	);
+	{
+		UdpSocket receiver{ service->GetContext() };
+		UdpSocket sender{ service->GetContext() };
+		receiver.SetReceiveCallback(
+			[receiverId](std::vector<NetworkContext::Message>&& messages)
+			{
+				NetworkService::GetInstance()->Post(receiverId, std::move(messages));
+			}
+		);
+		ASSERT_TRUE(receiver.Bind());
+		ASSERT_TRUE(sender.Bind());
+
+		StringPacket packet{};
+		packet.SetString("service");
+		const Endpoint target = Endpoint::FromIPv4(0x7f000001, receiver.GetLocalPort());
+		for (std::size_t i = 0; i < count; ++i)
+			sender.Enqueue(packet, target);
+		sender.Flush();
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+		while (received < count && std::chrono::steady_clock::now() < deadline)
+		{
+			service->Dispatch();
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		// 소켓은 네트워크 스레드가 실행 중일 때 파괴된다.
+	}
+	service->UnregisterReceiver(receiverId);
+	EXPECT_EQ(received, count);
+
+	// 해제된 수신자에게 온 메시지는 버려진다.
+	std::vector<NetworkContext::Message> late(1);
+	service->Post(receiverId, std::move(late));
+	EXPECT_EQ(service->Dispatch(), 0u);
+
+	service->Stop();
+	EXPECT_FALSE(service->IsRunning());
+}
+
+TEST(UdpSocketTest, CloseWhileReceiving)
+{
+	using namespace sh::network;
+	auto service = NetworkService::GetInstance();
+	service->Start(2);
+
+	UdpSocket receiver{ service->GetContext() };
+	UdpSocket sender{ service->GetContext() };
+	std::atomic<std::size_t> received{ 0 };
+	std::atomic<bool> bClosed{ false };
+	std::atomic<bool> bCalledAfterClose{ false };
+	std::vector<NetworkContext::Message> unused;
+	receiver.SetReceiveCallback(
+		[&](std::vector<NetworkContext::Message>&& messages)
+		{
+			if (bClosed.load())
+				bCalledAfterClose = true;
+			// 콜백은 수신 목록의 락 밖에서 불리므로 같은 소켓에 접근해도 막히지 않는다.
+			receiver.GetReceivedMessages(unused);
+			received += messages.size();
+		}
+	);
+	ASSERT_TRUE(receiver.Bind());
+	ASSERT_TRUE(sender.Bind());
+
+	StringPacket packet{};
+	packet.SetString("close");
+	const Endpoint target = Endpoint::FromIPv4(0x7f000001, receiver.GetLocalPort());
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+	while (received.load() < 1000 && std::chrono::steady_clock::now() < deadline)
+	{
+		for (uint32_t i = 0; i < UdpSocket::SEND_BATCH; ++i)
+			sender.Enqueue(packet, target);
+		sender.Flush();
+	}
+	// 계속 보내는 도중에 닫는다.
+	for (uint32_t i = 0; i < UdpSocket::SEND_BATCH; ++i)
+		sender.Enqueue(packet, target);
+	sender.Flush();
+	receiver.Close();
+	bClosed = true;
+	EXPECT_FALSE(receiver.IsOpen());
+	for (uint32_t i = 0; i < UdpSocket::SEND_BATCH; ++i)
+		sender.Enqueue(packet, target);
+	sender.Flush();
+	std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+	EXPECT_GT(received.load(), 0u);
+	EXPECT_FALSE(bCalledAfterClose.load());
+
+	// 열린 소켓에 이동 대입하면 이전 소켓이 먼저 닫힌다.
+	UdpSocket other{ service->GetContext() };
+	ASSERT_TRUE(other.Bind());
+	const uint16_t oldPort = sender.GetLocalPort();
+	sender = std::move(other);
+	EXPECT_TRUE(sender.IsOpen());
+	EXPECT_NE(sender.GetLocalPort(), oldPort);
+	UdpSocket rebound{ service->GetContext() };
+	EXPECT_TRUE(rebound.Bind(oldPort));
+
+	service->Stop();
+}
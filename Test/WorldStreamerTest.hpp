@@ -0,0 +1,186 @@
+﻿#pragma once
+#include "Game/WorldStreamer.h"
+#include "Game/Asset/WorldCellAsset.h"
+
+#include "Core/UUID.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace worldStreamerTest
+{
+	/// @brief Transform 컴포넌트 하나만 가진 직렬화 오브젝트
+	inline auto MakeObj(const std::string& name, const std::string& transformUUID, float x, float z, const std::string& parent = {}) -> sh::core::Json
+	{
+		sh::core::Json transformJson{};
+		transformJson["vPosition"] = sh::core::Json::array({ x, 0.f, z });
+		if (!parent.empty())
+			transformJson["parent"] = parent;
+
+		sh::core::Json compJson{};
+		compJson["type"] = "Transform";
+		compJson["uuid"] = transformUUID;
+		compJson["Transform"] = std::move(transformJson);
+
+		sh::core::Json objJson{};
+		objJson["name"] = name;
+		objJson["Components"] = sh::core::Json::array({ std::move(compJson) });
+		return objJson;
+	}
+	inline auto MakeWorld() -> sh::core::Json
+	{
+		sh::core::Json worldJson{};
+		worldJson["uuid"] = "0123456789abcdef0123456789abcdef";
+		worldJson["objs"] = sh::core::Json::array({
+			MakeObj("a", "t0", 10.f, 10.f),
+			// 자식은 자기 위치와 상관없이 루트의 셀에 속한다.
+			MakeObj("a_child", "t1", 500.f, 500.f, "t0"),
+			MakeObj("b", "t2", 70.f, -10.f),
+			MakeObj("c", "t3", -1.f, 130.f),
+			MakeObj("sky", "t4", 1000.f, 1000.f)
+		});
+		return worldJson;
+	}
+	inline auto FindCell(const sh::game::WorldStreamer::PartitionResult& result, int32_t x, int32_t z) -> const sh::game::WorldCellAsset*
+	{
+		for (const auto& cell : result.cells)
+		{
+			const sh::core::Json& data = cell->GetCellData();
+			if (data["x"].get<int32_t>() == x && data["z"].get<int32_t>() == z)
+				return cell.get();
+		}
+		return nullptr;
+	}
+}//namespace
+
+TEST(WorldStreamerTest, Partition)
+{
+	using namespace sh::game;
+	WorldStreamer::Settings settings{};
+	settings.cellSize = 64.f;
+	const sh::core::Json worldJson = worldStreamerTest::MakeWorld();
+	const WorldStreamer::PartitionResult result = WorldStreamer::Partition(worldJson, settings, { "sky" });
+
+	ASSERT_EQ(result.persistentWorld["objs"].size(), 1);
+	EXPECT_EQ(result.persistentWorld["objs"][0]["name"], "sky");
+	ASSERT_EQ(result.cells.size(), 3);
+
+	const WorldCellAsset* const cellA = worldStreamerTest::FindCell(result, 0, 0);
+	const WorldCellAsset* const cellB = worldStreamerTest::FindCell(result, 1, -1);
+	const WorldCellAsset* const cellC = worldStreamerTest::FindCell(result, -1, 2);
+	ASSERT_NE(cellA, nullptr);
+	ASSERT_NE(cellB, nullptr);
+	ASSERT_NE(cellC, nullptr);
+	EXPECT_EQ(cellA->GetCellData()["objs"].size(), 2);
+	EXPECT_EQ(cellB->GetCellData()["objs"].size(), 1);
+
+	const sh::core::Json& cellsJson = result.persistentWorld["streaming"]["cells"];
+	ASSERT_EQ(cellsJson.size(), 3);
+	for (const auto& cellJson : cellsJson)
+	{
+		const WorldCellAsset* const cell = worldStreamerTest::FindCell(result, cellJson["x"].get<int32_t>(), cellJson["z"].get<int32_t>());
+		ASSERT_NE(cell, nullptr);
+		EXPECT_EQ(cell->GetAssetUUID().ToString(), cellJson["uuid"].get<std::string>());
+	}
+}
+
+TEST(WorldStreamerTest, DeterministicCellUUID)
+{
+	using namespace sh::game;
+	const sh::core::Json worldJson = worldStreamerTest::MakeWorld();
+	const WorldStreamer::PartitionResult first = WorldStreamer::Partition(worldJson, WorldStreamer::Settings{});
+	const WorldStreamer::PartitionResult second = WorldStreamer::Partition(worldJson, WorldStreamer::Settings{});
+	// 다시 나눠도 셀 테이블과 UUID가 같아야 번들과 메타가 바뀌지 않는다.
+	EXPECT_EQ(first.persistentWorld["streaming"], second.persistentWorld["streaming"]);
+
+	const sh::core::UUID world{ worldJson["uuid"].get<std::string>() };
+	const sh::core::UUID otherWorld{ "fedcba9876543210fedcba9876543210" };
+	EXPECT_EQ(WorldStreamer::MakeCellUUID(world, { 1, 2 }), WorldStreamer::MakeCellUUID(world, { 1, 2 }));
+	EXPECT_NE(WorldStreamer::MakeCellUUID(world, { 1, 2 }), WorldStreamer::MakeCellUUID(world, { 2, 1 }));
+	EXPECT_NE(WorldStreamer::MakeCellUUID(world, { 1, 2 }), WorldStreamer::MakeCellUUID(otherWorld, { 1, 2 }));
+	EXPECT_FALSE(WorldStreamer::MakeCellUUID(world, { 0, 0 }).IsEmpty());
+}
+
+TEST(WorldStreamerTest, CellCoord)
+{
+	using namespace sh::game;
+	const WorldStreamer::CellCoord a = WorldStreamer::ToCellCoord(Vec3{ 63.9f, 0.f, 0.f }, 64.f);
+	const WorldStreamer::CellCoord b = WorldStreamer::ToCellCoord(Vec3{ -0.1f, 0.f, 64.f }, 64.f);
+	EXPECT_EQ(a.x, 0);
+	EXPECT_EQ(a.z, 0);
+	EXPECT_EQ(b.x, -1);
+	EXPECT_EQ(b.z, 1);
+	EXPECT_FLOAT_EQ(WorldStreamer::DistanceToCell(Vec3{ 32.f, 100.f, 32.f }, { 0, 0 }, 64.f), 0.f);
+	EXPECT_FLOAT_EQ(WorldStreamer::DistanceToCell(Vec3{ 32.f, 0.f, 32.f }, { 1, 0 }, 64.f), 64.f);
+}
+
+TEST(WorldStreamerTest, LoadAndUnloadRadius)
+{
+	using namespace sh::game;
+	WorldStreamer::Settings settings{};
+	settings.cellSize = 10.f;
+	settings.loadRadius = 20.f;
+	settings.unloadRadius = 30.f;
+
+	// x축을 따라 늘어선 셀. 중심은 5, 15, 25, ...
+	std::vector<WorldStreamer::CellCoord> coords;
+	for (int32_t x = 0; x < 8; ++x)
+		coords.push_back({ x, 0 });
+	std::vector<uint8_t> resident(coords.size(), 0);
+
+	WorldStreamer::CellPlan plan{};
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 5.f, 0.f, 5.f }, settings, 8, plan);
+	// 20 이내: 0, 1, 2번 셀. 가까운 순서
+	ASSERT_EQ(plan.loads.size(), 3);
+	EXPECT_EQ(plan.loads[0], 0);
+	EXPECT_EQ(plan.loads[1], 1);
+	EXPECT_EQ(plan.loads[2], 2);
+	EXPECT_TRUE(plan.unloads.empty());
+
+	// 동시 로드 수 제한
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 5.f, 0.f, 5.f }, settings, 2, plan);
+	ASSERT_EQ(plan.loads.size(), 2);
+	EXPECT_EQ(plan.loads[1], 1);
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 5.f, 0.f, 5.f }, settings, 0, plan);
+	EXPECT_TRUE(plan.loads.empty());
+
+	// 이미 상주하는 셀은 다시 요청하지 않는다.
+	resident[0] = resident[1] = resident[2] = 1;
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 5.f, 0.f, 5.f }, settings, 8, plan);
+	EXPECT_TRUE(plan.loads.empty());
+	EXPECT_TRUE(plan.unloads.empty());
+}
+
+TEST(WorldStreamerTest, Hysteresis)
+{
+	using namespace sh::game;
+	WorldStreamer::Settings settings{};
+	settings.cellSize = 10.f;
+	settings.loadRadius = 20.f;
+	settings.unloadRadius = 30.f;
+
+	const std::vector<WorldStreamer::CellCoord> coords{ { 0, 0 } };
+	std::vector<uint8_t> resident{ 1 };
+	WorldStreamer::CellPlan plan{};
+
+	// 불러오는 반경과 해제하는 반경 사이에서는 상주 셀이 유지된다.
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 30.f, 0.f, 5.f }, settings, 8, plan);
+	EXPECT_TRUE(plan.unloads.empty());
+	EXPECT_TRUE(plan.loads.empty());
+	// 같은 위치에서 해제된 셀은 다시 불러오지 않는다.
+	resident[0] = 0;
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 30.f, 0.f, 5.f }, settings, 8, plan);
+	EXPECT_TRUE(plan.loads.empty());
+
+	resident[0] = 1;
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 36.f, 0.f, 5.f }, settings, 8, plan);
+	ASSERT_EQ(plan.unloads.size(), 1);
+	EXPECT_EQ(plan.unloads[0], 0);
+
+	resident[0] = 0;
+	WorldStreamer::PlanCells(coords, resident, Vec3{ 24.f, 0.f, 5.f }, settings, 8, plan);
+	ASSERT_EQ(plan.loads.size(), 1);
+	EXPECT_EQ(plan.loads[0], 0);
+}
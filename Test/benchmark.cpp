@@ -0,0 +1,17 @@
+﻿#include "NetworkBenchmark.hpp"
+#include "PhysicsBenchmark.hpp"
+#include "RollbackBenchmark.hpp"
+#include "ReplicationBenchmark.hpp"
+#include "AssetBundleBenchmark.hpp"
+#ifdef Bool
+#undef Bool
+#endif
+
+#include <gtest/gtest.h>
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    int result = RUN_ALL_TESTS();
+    return result;
+}
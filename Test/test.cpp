@@ -7,9 +7,32 @@
 #include "AABBTest.hpp"
 #include "OctreeTest.hpp"
 #include "ShaderParserTest.hpp"
+#include "ShaderCompilerTest.hpp"
+#include "TextureCompressorTest.hpp"
+#include "TextureStreamerTest.hpp"
+#include "MeshOptimizerTest.hpp"
+#include "MeshSimplifierTest.hpp"
+#include "ModelLoaderTest.hpp"
+#include "AnimationTest.hpp"
+#include "SkinningTest.hpp"
 #include "SpinLockTest.hpp"
 #include "ThreadPoolTest.hpp"
 #include "EventBusTest.hpp"
+#include "PhysicsQueryTest.hpp"
+#include "PhysWorldTest.hpp"
+#include "ContactBufferTest.hpp"
+#include "RollbackTest.hpp"
+#include "WorldStreamerTest.hpp"
+#include "NetworkCodecTest.hpp"
+#include "UdpSocketTest.hpp"
+#include "ReliableUdpTest.hpp"
+#include "NetworkSimulationTest.hpp"
+#include "TcpSocketTest.hpp"
+#include "MessageBatcherTest.hpp"
+#include "ReplicationTest.hpp"
+#include "AsyncAssetLoaderTest.hpp"
+#include "AssetBundleTest.hpp"
+#include "ImportCacheTest.hpp"
 #ifdef Bool
 #undef Bool
 #endif
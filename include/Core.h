@@ -4,6 +4,7 @@
 #include "Core/ArrayView.hpp"
 #include "Core/Asset.h"
 #include "Core/AssetBundle.h"
+#include "Core/AssetBundleLayout.h"
 #include "Core/AssetExporter.h"
 #include "Core/AssetImporter.h"
 #include "Core/AssetResolver.h"
@@ -21,6 +22,7 @@
 #include "Core/IEvent.h"
 #include "Core/ISyncable.h"
 #include "Core/LockFreeMPSCQueue.h"
+#include "Core/MappedFile.h"
 #include "Core/ModuleLoader.h"
 #include "Core/NonCopyable.h"
 #include "Core/Observer.hpp"
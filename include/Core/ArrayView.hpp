@@ -18,6 +18,7 @@ namespace sh::core
 
 		auto operator[](int i) const noexcept -> T const& { return ptr[i]; }
 		auto size() const noexcept -> std::size_t { return len; }
+		auto data() const noexcept -> T* { return ptr; }
 
 		auto begin() noexcept -> T* { return ptr; }
 		auto end() noexcept -> T* { return ptr + len; }
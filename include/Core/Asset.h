@@ -2,6 +2,7 @@
 #include "Export.h"
 #include "UUID.h"
 #include "Factory.hpp"
+#include "ISerializable.h"
 
 #include <vector>
 #include <filesystem>
@@ -35,6 +36,10 @@ namespace sh::core
 		SH_CORE_API virtual ~Asset() = default;
 
 		SH_CORE_API virtual void SetAsset(const core::SObject& obj) = 0;
+		/// @brief 이 에셋을 불러올 때 먼저 필요한 다른 에셋들의 UUID를 반환한다. 파싱된 에셋에서만 유효하다.
+		/// @brief 에셋이 아닌 오브젝트의 UUID가 섞여 있을 수 있으므로 사용하는 쪽에서 걸러야 한다.
+		/// @return 기본적으로 빈 벡터
+		SH_CORE_API virtual auto GetDependencies() const -> std::vector<UUID>;
 
 		/// @brief 마지막 쓰기 시간을 해당 경로에 있는 파일의 마지막 쓰기 시간으로 변경한다. 파일이 없으면 아무 일도 일어나지 않는다.
 		/// @param filePath 파일 경로
@@ -59,6 +64,9 @@ namespace sh::core
 		SH_CORE_API auto IsEmpty() const -> bool { return data.empty(); }
 	public:
 		constexpr static uint32_t VERSION = 2;
+	protected:
+		/// @brief json 안의 UUID 형식 문자열들을 중복 없이 모은다. 자기 자신의 UUID는 제외한다.
+		SH_CORE_API auto CollectUUIDs(const Json& json) const -> std::vector<UUID>;
 	protected:
 		UUID assetUUID;
 		mutable std::vector<uint8_t> data;
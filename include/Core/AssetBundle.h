@@ -3,6 +3,8 @@
 #include "UUID.h"
 #include "Asset.h"
 #include "NonCopyable.h"
+#include "MappedFile.h"
+#include "ArrayView.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -11,9 +13,11 @@
 #include <filesystem>
 #include <memory>
 #include <fstream>
+#include <mutex>
 namespace sh::core
 {
 	/// @brief 에셋들의 묶음을 나타내는 클래스
+	/// @brief 불러온 번들은 기본적으로 메모리에 매핑되며 LoadAsset()은 잠금 없이 여러 스레드에서 동시에 호출할 수 있다.
 	class AssetBundle : core::INonCopyable
 	{
     private:
@@ -32,14 +36,27 @@ namespace sh::core
         };
         std::filesystem::path bundlePath;
 
-        std::unordered_map<UUID, AssetEntry> assetEntries;
+        /// @brief 저장하기 위해 추가된 에셋들. 오프셋은 bundleData 안의 위치다.
+        std::unordered_map<UUID, AssetEntry> addedEntries;
         std::vector<uint8_t> bundleData;
-        
-        std::size_t nextAssetDataOffset = 0;
+        std::vector<UUID> layoutOrder;
+
+        /// @brief 열린 번들의 에셋 목록. UUID 순으로 정렬돼 있어 이진 탐색으로 찾는다.
+        /// @brief 매핑된 번들이면 파일 안을 그대로 가리킨다.
+        const AssetEntry* toc = nullptr;
+        std::size_t tocSize = 0;
+        /// @brief 파일 안의 목록을 그대로 쓸 수 없을 때(스트림, 이전 버전, 잘린 파일) 쓰이는 목록
+        std::vector<AssetEntry> tocStorage;
 
         mutable std::fstream bundleStream;
+        /// @brief 매핑하지 않고 연 번들에서 스트림을 읽을 때 쓰인다.
+        mutable std::mutex streamMutex;
+
+        MappedFile mappedFile;
+        std::size_t dataSectionOffset = 0;
     public:
-        constexpr static uint32_t VERSION = 1;
+        /// @brief 2: 에셋 목록이 UUID 순으로 정렬되고 데이터가 레이아웃 순서로 저장된다.
+        constexpr static uint32_t VERSION = 2;
     public:
         SH_CORE_API AssetBundle();
         SH_CORE_API AssetBundle(AssetBundle&& other) noexcept;
@@ -65,23 +82,49 @@ namespace sh::core
         /// @return 에셋 UUID 벡터
         SH_CORE_API auto GetAllAssetUUIDs() const -> std::vector<UUID>;
 
+        /// @brief 저장할 때 에셋 데이터를 쓸 순서를 지정한다. 순서에 없는 에셋들은 그 뒤에 추가된 순서대로 쓰인다.
+        /// @param order 에셋 UUID 순서. 번들에 없는 UUID는 무시된다. (AssetBundleLayout::Build())
+        SH_CORE_API void SetLayoutOrder(const std::vector<UUID>& order);
         /// @brief 번들 파일을 저장하고 번들을 닫는다.
         /// @param bundlePath 경로
         /// @return 성공 시 true, 실패 시 false
         SH_CORE_API auto SaveBundle(const std::filesystem::path& bundlePath) const -> bool;
         /// @brief 번들 파일을 불러온다. 에셋은 메모리에 올라오지 않는다.
         /// @param bundlePath 경로
-        SH_CORE_API auto LoadBundle(const std::filesystem::path& bundlePath) -> bool;
+        /// @param bMemoryMapped 파일을 메모리에 매핑할지. false거나 매핑에 실패하면 파일 스트림으로 읽는다.
+        SH_CORE_API auto LoadBundle(const std::filesystem::path& bundlePath, bool bMemoryMapped = true) -> bool;
+        /// @brief 번들이 메모리에 매핑됐는지 반환한다.
+        SH_CORE_API auto IsMemoryMapped() const -> bool;
 
-        /// @brief 열린 번들에서 에셋을 메모리로 불러온다.
+        /// @brief 열린 번들에서 에셋을 메모리로 불러온다. 여러 스레드에서 동시에 호출할 수 있다.
+        /// @brief 매핑된 번들이면 잠금 없이 매핑된 메모리에서 바로 Asset::data로 압축을 해제한다.
         /// @param uuid 에셋 UUID
         /// @return 실패 시 nullptr 반환
-        SH_CORE_API auto LoadAsset(const core::UUID& uuid) -> std::unique_ptr<Asset>;
+        SH_CORE_API auto LoadAsset(const core::UUID& uuid) const -> std::unique_ptr<Asset>;
+        /// @brief 열린 번들에서 에셋의 헤더와 (압축된) 데이터를 그대로 복사한다.
+        /// @param uuid 에셋 UUID
+        /// @param out 읽은 데이터
+        /// @return 실패 시 false
+        SH_CORE_API auto ReadAssetData(const core::UUID& uuid, std::vector<uint8_t>& out) const -> bool;
+        /// @brief 매핑된 번들에서 에셋의 헤더와 (압축된) 데이터가 있는 읽기 전용 메모리를 반환한다.
+        /// @brief 번들이 닫히기 전까지 유효하다.
+        /// @param uuid 에셋 UUID
+        /// @return 매핑되지 않았거나 에셋이 없다면 크기가 0인 뷰
+        SH_CORE_API auto GetAssetView(const core::UUID& uuid) const -> ArrayView<const uint8_t>;
+        /// @brief 곧 불러올 에셋들의 데이터를 미리 메모리에 올려두도록 운영체제에 요청한다. 기다리지 않고 바로 반환한다.
+        /// @brief 매핑되지 않은 번들에서는 아무것도 하지 않는다.
+        /// @param uuids 에셋 UUID들. 번들에 없는 UUID는 무시된다.
+        SH_CORE_API void Prefetch(const std::vector<UUID>& uuids) const;
 
         /// @brief 열린 번들의 버전을 반환 한다.
         /// @return 번들 버전
         SH_CORE_API auto GetVersion() const -> uint32_t;
 
-        SH_CORE_API auto GetAssetEntries() const -> const std::unordered_map<UUID, AssetEntry>&;
+        /// @brief 열린 번들의 에셋 목록을 UUID 순으로 반환한다.
+        SH_CORE_API auto GetAssetEntries() const -> ArrayView<const AssetEntry>;
+    private:
+        auto FindEntry(const UUID& uuid) const -> const AssetEntry*;
+        /// @brief 파일에서 읽은 목록을 검사한다. 그대로 쓸 수 없다면 쓸 수 있는 항목만 tocStorage에 정렬해서 담는다.
+        void SetupTOC(const AssetEntry* entries, std::size_t count, std::size_t dataSectionSize);
 	};
 }//namespace
\ No newline at end of file
@@ -0,0 +1,30 @@
+﻿#pragma once
+#include "Export.h"
+#include "UUID.h"
+
+#include <vector>
+#include <unordered_map>
+namespace sh::core
+{
+	/// @brief 번들에 에셋 데이터를 쓸 순서를 정하는 클래스.
+	/// @brief 같이 불러와지는 에셋들이 파일에서 붙어있도록 루트(월드 등)마다 로더가 요청하는 순서대로 나열한다.
+	/// @brief 로더는 에셋을 읽은 뒤 발견한 의존성을 요청하므로 루트에서 너비 우선으로 나열한 순서가 읽는 순서다.
+	class AssetBundleLayout
+	{
+	public:
+		/// @brief 에셋이 직접 참조하는 에셋들을 추가한다. 여러 번 호출하면 뒤에 이어 붙는다.
+		/// @param uuid 에셋 UUID
+		/// @param deps 참조하는 UUID들. 참조하는 순서대로 나열된다.
+		SH_CORE_API void AddDependencies(const UUID& uuid, const std::vector<UUID>& deps);
+		/// @brief 한번에 불러와지는 묶음의 시작 에셋을 추가한다. 먼저 추가한 루트가 파일 앞에 온다.
+		/// @param root 루트 에셋 UUID
+		SH_CORE_API void AddRoot(const UUID& root);
+
+		/// @brief 루트마다 너비 우선으로 나열한 순서를 반환한다. 여러 루트가 공유하는 에셋은 처음 도달한 루트 쪽에 놓인다.
+		/// @return 에셋 UUID 순서. 에셋이 아닌 UUID가 섞여 있을 수 있다. (AssetBundle::SetLayoutOrder()에서 걸러진다)
+		SH_CORE_API auto Build() const -> std::vector<UUID>;
+	private:
+		std::unordered_map<UUID, std::vector<UUID>> dependencies;
+		std::vector<UUID> roots;
+	};
+}//namespace
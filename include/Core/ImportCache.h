@@ -0,0 +1,61 @@
+﻿#pragma once
+#include "Export.h"
+#include "Asset.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+namespace sh::core
+{
+	/// @brief 원본과 임포트 설정이 같으면 이전 임포트 결과(Asset 파일)를 재사용하기 위한 내용 주소 캐시.
+	/// @brief 키는 원본 해시, 메타 파일, 임포터 버전, Asset 포맷 버전을 섞어 만든다.
+	/// @brief 캐시 파일에는 키와 Asset 파일의 해시가 같이 기록되며, 맞지 않는 파일은 손상된 것으로 보고 지운다.
+	class ImportCache
+	{
+	private:
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint64_t blobHash;
+			uint64_t blobSize;
+		};
+	public:
+		constexpr static uint32_t MAGIC = 0x43494853; // "SHIC"
+		constexpr static uint32_t VERSION = 1;
+	public:
+		/// @brief 임포트 캐시 키를 만든다.
+		/// @param sourceHash 원본 파일의 Hash64
+		/// @param meta 메타 파일(임포트 설정)의 내용
+		/// @param metaSize 메타 파일 크기
+		/// @param importerVersion 임포터 버전
+		/// @return 키
+		SH_CORE_API static auto MakeKey(uint64_t sourceHash, const uint8_t* meta, std::size_t metaSize, uint32_t importerVersion) -> uint64_t;
+
+		/// @brief 캐시 디렉토리를 지정한다. 없으면 만든다.
+		SH_CORE_API void SetPath(const std::filesystem::path& dir);
+		SH_CORE_API auto GetPath() const -> const std::filesystem::path& { return cachePath; }
+		SH_CORE_API auto GetFile(uint64_t key) const -> std::filesystem::path;
+
+		/// @brief Asset 파일의 내용을 키로 저장한다.
+		/// @return 성공 시 true
+		SH_CORE_API auto Store(uint64_t key, const std::vector<uint8_t>& assetBlob) const -> bool;
+		/// @brief 디스크에 있는 Asset 파일을 키로 저장한다.
+		/// @return 성공 시 true
+		SH_CORE_API auto StoreFile(uint64_t key, const std::filesystem::path& assetFile) const -> bool;
+		/// @brief 키에 해당하는 Asset 파일의 내용을 읽는다. 다른 스레드에서 호출해도 된다.
+		/// @return 없거나 손상됐다면 nullopt
+		SH_CORE_API auto LoadBlob(uint64_t key) const -> std::optional<std::vector<uint8_t>>;
+		/// @brief 키에 해당하는 에셋을 읽고 해석한다. 다른 스레드에서 호출해도 된다.
+		/// @return 없거나 손상됐다면 nullptr
+		SH_CORE_API auto Load(uint64_t key) const -> std::unique_ptr<Asset>;
+		/// @brief 캐시된 Asset 파일을 지정한 경로에 기록한다.
+		/// @return 성공 시 true
+		SH_CORE_API auto Restore(uint64_t key, const std::filesystem::path& assetFile) const -> bool;
+	private:
+		std::filesystem::path cachePath;
+	};
+}//namespace
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include "Export.h"
+#include "NonCopyable.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+namespace sh::core
+{
+	/// @brief 파일을 읽기 전용으로 메모리에 매핑하는 크로스 플랫폼 클래스.
+	/// @brief 매핑된 메모리는 읽기만 하므로 여러 스레드에서 동시에 접근해도 안전하다.
+	class MappedFile : public INonCopyable
+	{
+	public:
+		SH_CORE_API MappedFile();
+		SH_CORE_API MappedFile(MappedFile&& other) noexcept;
+		SH_CORE_API ~MappedFile();
+
+		SH_CORE_API auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+		/// @brief 파일을 매핑한다. 이미 열려있다면 닫고 다시 연다.
+		/// @param path 경로
+		/// @return 성공 시 true, 실패 시 false
+		SH_CORE_API auto Open(const std::filesystem::path& path) -> bool;
+		SH_CORE_API void Close();
+
+		SH_CORE_API auto IsOpen() const -> bool { return data != nullptr; }
+		SH_CORE_API auto GetData() const -> const uint8_t* { return data; }
+		SH_CORE_API auto GetSize() const -> std::size_t { return size; }
+
+		/// @brief 해당 범위를 곧 읽을 것이라고 운영체제에 알려 미리 페이지를 올려두게 한다. (madvise(MADV_WILLNEED), PrefetchVirtualMemory)
+		/// @brief 비동기로 진행되며 결과를 기다리지 않는다.
+		/// @param offset 파일 시작으로부터의 위치
+		/// @param len 크기
+		SH_CORE_API void Prefetch(std::size_t offset, std::size_t len) const;
+	private:
+		const uint8_t* data = nullptr;
+		std::size_t size = 0;
+#if _WIN32
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+#endif
+	};
+}//namespace
@@ -34,6 +34,8 @@ namespace sh::core
 		static constexpr const char* noSave = "noSave";
 		static constexpr const char* sync = "sync";
 		static constexpr const char* sobjPtr = "sobjPtr";
+		/// @brief 네트워크로 복제되는 프로퍼티. (game::ReplicationServer)
+		static constexpr const char* replicated = "replicated";
 	};
 }//namespace
 
@@ -361,6 +363,8 @@ namespace sh::core::reflection
 	{
 	public:
 		virtual auto GetType() const -> const TypeInfo& = 0;
+		virtual auto GetAddress(void* sobject) const -> void* = 0;
+		virtual auto GetAddress(const void* sobject) const -> const void* = 0;
 		virtual auto Begin(void* sobject) const -> PropertyIteratorT = 0;
 		virtual auto Begin(const void* sobject) const -> ConstPropertyIteratorT = 0;
 		virtual auto End(void* sobject) const -> PropertyIteratorT = 0;
@@ -377,6 +381,14 @@ namespace sh::core::reflection
 		{
 			return reflection::GetType<T>();
 		}
+		auto GetAddress(void* sobject) const -> void* override
+		{
+			return const_cast<std::remove_const_t<T>*>(&Get(sobject));
+		}
+		auto GetAddress(const void* sobject) const -> const void* override
+		{
+			return &Get(sobject);
+		}
 		virtual auto Get(void* sobject) const -> T& = 0;
 		virtual auto Get(const void* sobject) const -> const T& = 0;
 	};
@@ -562,6 +574,7 @@ namespace sh::core::reflection
 			bool bVisible = true;
 			bool bNoSave = false;
 			bool bSObjPtr = false;
+			bool bReplicated = false;
 		} option;
 
 		const std::string_view name;
@@ -579,6 +592,8 @@ namespace sh::core::reflection
 					retOption.bNoSave = true;
 				else if (option == "sobjPtr")
 					retOption.bSObjPtr = true;
+				else if (option == "replicated")
+					retOption.bReplicated = true;
 			}
 			return retOption;
 		}
@@ -602,13 +617,15 @@ namespace sh::core::reflection
 			bConstProperty(createInfo.option.bConst),
 			bVisibleProperty(createInfo.option.bVisible),
 			bNoSaveProperty(createInfo.option.bNoSave),
+			bReplicatedProperty(createInfo.option.bReplicated),
 			isConst(std::is_const_v<T>),
 			isPointer(std::is_pointer_v<T>),
 			isContainer(IsContainer<T>::value),
 			isSObject(IsSObject<T>::value),
 			isSObjectPointer(createInfo.option.bSObjPtr & !reflection::IsContainer<T>::value || std::is_convertible_v<T, const SObject*>),
 			isSObjectPointerContainer(createInfo.option.bSObjPtr || reflection::IsContainer<T>::value && std::is_convertible_v<typename reflection::GetContainerLastType<T>::type, const SObject*>),
-			isEnum(std::is_enum_v<T>)
+			isEnum(std::is_enum_v<T>),
+			isTriviallyCopyable(std::is_trivially_copyable_v<T> && !std::is_const_v<T> && !std::is_pointer_v<T> && !IsContainer<T>::value)
 		{
 			// 메모) 템플릿 인자로 인해 클래스 맴버 변수 별로 메모리 상에 하나만 존재하게 된다.
 			static PropertyData<ThisType, T, VariablePointer, ptr> data{};
@@ -637,6 +654,17 @@ namespace sh::core::reflection
 		{
 			return &static_cast<IPropertyData<T>*>(data)->Get(&sobject);
 		}
+		/// @brief 프로퍼티 값의 주소를 타입 없이 반환하는 함수. 크기는 type.size를 사용한다.
+		/// @brief isTriviallyCopyable인 프로퍼티는 이 주소로 memcpy해도 안전하다.
+		/// @param sobject 해당 프로퍼티를 가지고 있는 SObject객체
+		auto GetRaw(SObject& sobject) const -> void*
+		{
+			return data->GetAddress(static_cast<void*>(&sobject));
+		}
+		auto GetRaw(const SObject& sobject) const -> const void*
+		{
+			return data->GetAddress(static_cast<const void*>(&sobject));
+		}
 		template<typename T>
 		auto GetSafe(SObject& sobject) const -> T*
 		{
@@ -691,6 +719,7 @@ namespace sh::core::reflection
 		const bool bConstProperty;
 		const bool bVisibleProperty;
 		const bool bNoSaveProperty;
+		const bool bReplicatedProperty;
 		const bool isConst;
 		const bool isPointer;
 		const bool isContainer;
@@ -698,6 +727,8 @@ namespace sh::core::reflection
 		const bool isSObjectPointer;
 		const bool isSObjectPointerContainer;
 		const bool isEnum;
+		/// @brief const, 포인터, 컨테이너가 아니며 바이트 단위 복사가 가능한 타입인지
+		const bool isTriviallyCopyable;
 	private:
 		PropertyDataBase* data;
 
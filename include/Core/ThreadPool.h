@@ -27,12 +27,20 @@ namespace sh::core
 		SH_CORE_API auto GetThreads() const -> const std::vector<std::thread>&;
 		SH_CORE_API auto GetThreadNum() const -> uint32_t;
 		SH_CORE_API auto IsInit() const -> bool;
+		/// @brief 현재 스레드가 스레드 풀의 스레드인지. 작업 안에서 다른 작업을 기다리면 교착될 수 있으므로 확인용으로 쓴다.
+		SH_CORE_API auto IsWorkerThread() const -> bool;
 
 		template<typename F, typename... Args>
 		auto AddTask(F&& func, Args&&... args) -> std::future<typename std::invoke_result_t<F, Args...>>;
 		/// @brief 해당 함수로 작업을 추가하면 동기화 타이밍에 해당 작업이 끝날 때까지 기다리지 않게 한다.
 		template<typename F, typename... Args>
 		auto AddContinousTask(F&& func, Args&&... args) -> std::future<typename std::invoke_result_t<F, Args...>>;
+		/// @brief [0, count)를 최대 (스레드 수 + 1)개의 연속된 구간으로 나눠 스레드 풀과 현재 스레드에서 fn(begin, end)를 실행하고 모두 끝날 때까지 기다린다.
+		/// @brief 마지막 구간은 현재 스레드가 맡는다. 스레드 풀이 초기화되지 않았거나 워커 스레드에서 호출되면 교착을 피하려 현재 스레드에서 fn(0, count)를 실행한다.
+		/// @param count 처리할 항목 수
+		/// @param fn [begin, end) 구간을 처리하는 함수. 여러 스레드에서 동시에 호출된다.
+		/// @param minChunk 구간 하나의 최소 항목 수. 항목당 비용이 작을 때 작업을 너무 잘게 나누지 않도록 한다.
+		SH_CORE_API void ParallelFor(std::size_t count, const std::function<void(std::size_t begin, std::size_t end)>& fn, std::size_t minChunk = 1);
 	protected:
 		SH_CORE_API ThreadPool();
 	private:
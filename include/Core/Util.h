@@ -104,6 +104,13 @@ namespace sh::core
 			return hash;
 		}
 
+		/// @brief 바이트 배열의 64비트 해시(XXH64)를 반환한다. 파일 내용 비교 같이 큰 데이터에 쓴다.
+		/// @param data 데이터
+		/// @param size 바이트 크기
+		/// @param seed 시드
+		/// @return 해시
+		SH_CORE_API static auto Hash64(const void* data, std::size_t size, uint64_t seed = 0) -> uint64_t;
+
 		SH_CORE_API static auto RandomRange(uint32_t min, uint32_t max) -> uint32_t;
 		SH_CORE_API static auto RandomRange(int min, int max) -> int;
 		SH_CORE_API static auto RandomRange(float min, float max) -> float;
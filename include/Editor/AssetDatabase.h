@@ -9,6 +9,8 @@
 #include "Core/SContainer.hpp"
 #include "Core/UUID.h"
 #include "Core/Observer.hpp"
+#include "Core/Asset.h"
+#include "Core/ImportCache.h"
 
 #include <filesystem>
 #include <optional>
@@ -39,6 +41,16 @@ namespace sh::editor
 			std::filesystem::path originalPath; // ProjectPath의 상대 경로로 저장해야함!
 			std::filesystem::path cachePath; // ProjectPath의 상대 경로로 저장해야함!
 		};
+		/// @brief 마지막 LoadAllAssets()의 단계별 소요 시간(ms)과 임포트 캐시 적중 수
+		struct ImportStats
+		{
+			float scanMs = 0.f;
+			float prepareMs = 0.f;
+			float importMs = 0.f;
+			float saveMs = 0.f;
+			std::size_t cacheHit = 0;
+			std::size_t cacheMiss = 0;
+		};
 	public:
 		SH_EDITOR_API void Init(const std::filesystem::path& projectPath, const render::IRenderContext& ctx, const game::ImGUImpl& imgui);
 
@@ -49,12 +61,14 @@ namespace sh::editor
 		/// @brief SetDirty()를 통해 알려줘야 한다.
 		SH_EDITOR_API void SaveAllAssets();
 		/// @brief 해당 경로에 있는 에셋을 모두 불러오는 함수
+		/// @brief 파일 읽기, 해싱, 캐시 해석은 스레드 풀에서 병렬로 처리하고 객체 생성은 의존성 순서대로 메인 스레드에서 한다.
 		/// @param dir 경로
 		/// @param recursive 하위 경로도 포함 할 것인지
 		/// @param bOverLoad 이미 불러온 객체가 있다면 새로 로드 할 것인지
 		SH_EDITOR_API void LoadAllAssets(const std::filesystem::path& dir, bool recursive, bool bOverLoad = false);
 		/// @brief 경로에서 에셋을 임포트 하여 SObject객체를 생성하는 함수.
 		/// @brief 이전에 로드한적이 있는 에셋은 변경 사항이 없으면 캐싱된 Asset파일로 불러온다.
+		/// @brief 원본, 메타 파일, 임포터 버전이 같은 에셋이 임포트 캐시에 있다면 임포트 하지 않고 캐시를 사용한다.
 		/// @param dir 에셋 경로(절대 경로 / 상대 경로)
 		/// @param bOverLoad 이미 불러온 객체가 있다면 새로 로드 할 것인지
 		/// @return SObject로 인스턴스화 된 에셋 객체. bOverLoad가 false고 이미 불러온 객체가 있다면 해당 객체를 반환
@@ -94,6 +108,13 @@ namespace sh::editor
 		SH_EDITOR_API auto GetAssetImporter(AssetExtensions::Type type) const -> const AssetLoaderRegistry::Importer*;
 
 		SH_EDITOR_API auto GetGUIContext() const -> const game::ImGUImpl* { return guiCtx; }
+
+		/// @brief 임포트 캐시 경로를 지정한다. 기본 값은 Library/ImportCache
+		/// @brief 캐시는 내용의 해시로 찾으므로 여러 프로젝트나 새로 받은 저장소끼리 공유해도 된다.
+		/// @param dir 경로
+		SH_EDITOR_API void SetImportCachePath(const std::filesystem::path& dir);
+		SH_EDITOR_API auto GetImportCachePath() const -> const std::filesystem::path& { return importCache.GetPath(); }
+		SH_EDITOR_API auto GetImportStats() const -> const ImportStats& { return importStats; }
 	protected:
 		SH_EDITOR_API AssetDatabase();
 		/// @brief 파일의 메타 파일이 존재 하는지?
@@ -102,6 +123,23 @@ namespace sh::editor
 		auto HasMetaFile(const std::filesystem::path& dir) -> std::optional<std::filesystem::path>;\
 		void LoadAllAssetsHelper(const std::filesystem::path& dir, bool recursive);
 		auto LoadAsset(const std::filesystem::path& path, core::IAssetLoader& loader, bool bMetaSaveWithObj) -> core::SObject*;
+	private:
+		/// @brief 메인 스레드가 아니어도 되는 임포트 준비 작업의 결과
+		struct PreparedImport
+		{
+			std::filesystem::path path;
+			const AssetLoaderRegistry::Importer* importer = nullptr;
+			uint64_t sourceHash = 0;
+			uint64_t cacheKey = 0;
+			std::unique_ptr<core::Asset> cachedAsset;
+			std::vector<core::UUID> dependencies;
+		};
+		/// @brief 원본과 메타 파일을 읽어 캐시 키를 만들고 캐시가 있다면 해석까지 한다. 멤버를 수정하지 않으므로 다른 스레드에서 호출해도 된다.
+		auto PrepareImport(const std::filesystem::path& path, const AssetLoaderRegistry::Importer& importer) const -> PreparedImport;
+		auto ImportPrepared(PreparedImport& prepared, bool bOverLoad) -> core::SObject*;
+		auto LoadCachedAsset(const PreparedImport& prepared) -> core::SObject*;
+		void StoreImportCache(const PreparedImport& prepared, const core::SObject& obj);
+		auto FindLoadedObject(const std::filesystem::path& path) -> core::SObject*;
 	public:
 		core::Observer<false, core::SObject*> onAssetImported;
 		core::Observer<false, core::UUID> onAssetRemoved;
@@ -110,15 +148,16 @@ namespace sh::editor
 		{
 			int priority = 0;
 			std::filesystem::path path;
+			const AssetLoaderRegistry::Importer* importer = nullptr;
 
-			AssetLoadData(int priority, const std::filesystem::path& path) :
-				priority(priority), path(path)
+			AssetLoadData(int priority, const std::filesystem::path& path, const AssetLoaderRegistry::Importer* importer) :
+				priority(priority), path(path), importer(importer)
 			{}
 			AssetLoadData(const AssetLoadData& other) :
-				priority(other.priority), path(other.path)
+				priority(other.priority), path(other.path), importer(other.importer)
 			{}
 			AssetLoadData(AssetLoadData&& other) noexcept :
-				priority(other.priority), path(std::move(other.path))
+				priority(other.priority), path(std::move(other.path)), importer(other.importer)
 			{}
 
 			bool operator<(const AssetLoadData& other) const
@@ -129,12 +168,14 @@ namespace sh::editor
 			{
 				priority = other.priority;
 				path = std::move(other.path);
+				importer = other.importer;
 				return *this;
 			}
 			auto operator=(const AssetLoadData& other) -> AssetLoadData&
 			{
 				priority = other.priority;
 				path = other.path;
+				importer = other.importer;
 				return *this;
 			}
 		};
@@ -142,6 +183,7 @@ namespace sh::editor
 
 		std::filesystem::path projectPath;
 		std::filesystem::path libPath;
+		core::ImportCache importCache;
 
 		std::unordered_map<std::filesystem::path, core::UUID> uuids{}; // ProjectPath의 상대 경로로 저장해야함!
 		std::unordered_map<core::UUID, AssetInfo> paths{}; // ProjectPath의 상대 경로로 저장해야함!
@@ -151,5 +193,7 @@ namespace sh::editor
 		core::Observer<false, const core::SObject*>::Listener onDestroyListener;
 
 		AssetLoaderRegistry assetLoaders;
+
+		ImportStats importStats{};
 	};
 }//namespace
\ No newline at end of file
@@ -24,6 +24,7 @@ namespace sh::editor
 			Sound,
 			ScriptableObject,
 			ComputeShader,
+			AnimationClip,
 		};
 	public:
 		SH_EDITOR_API static void AddExtension(const std::string& ext, Type type);
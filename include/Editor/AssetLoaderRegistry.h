@@ -17,9 +17,11 @@ namespace sh::editor
 			std::unique_ptr<core::IAssetLoader> loader;
 			int priority;
 			bool bObjDataInMeta;
+			/// @brief 임포터의 출력이 바뀌면 올려야 하는 값. 임포트 캐시의 키에 포함된다.
+			uint32_t version = 1;
 		};
 	public:
-		SH_EDITOR_API void RegisterLoader(AssetExtensions::Type ext, std::unique_ptr<core::IAssetLoader> loader, int priority, bool bObjDataInMeta);
+		SH_EDITOR_API void RegisterLoader(AssetExtensions::Type ext, std::unique_ptr<core::IAssetLoader> loader, int priority, bool bObjDataInMeta, uint32_t version = 1);
 		SH_EDITOR_API auto GetLoader(const char* assetType) const -> const Importer*;
 		SH_EDITOR_API auto GetLoader(AssetExtensions::Type ext) const -> const Importer*;
 		SH_EDITOR_API void Clear();
@@ -12,6 +12,7 @@
 namespace sh::core
 {
 	class AssetBundle;
+	class AssetBundleLayout;
 }
 namespace sh::game
 {
@@ -30,7 +31,9 @@ namespace sh::editor
 		SH_EDITOR_API void Build(Project& project, const std::filesystem::path& outputPath);
 	private:
 		void ExtractUUIDs(std::unordered_set<std::string>& set, const core::Json& world);
-		void PackingAssets(core::AssetBundle& bundle, game::World& world);
+		/// @brief json 안의 UUID 형식 문자열들을 나오는 순서대로 모은다.
+		void CollectReferences(const core::Json& json, std::vector<core::UUID>& out);
+		void PackingAssets(core::AssetBundle& bundle, core::AssetBundleLayout& layout, game::World& world, const core::Json& worldJson);
 		void ExportGameManager(const std::filesystem::path& outputPath);
 		void CopyRuntimeBinaries(const std::filesystem::path& outputPath);
 	private:
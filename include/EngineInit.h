@@ -27,6 +27,8 @@ namespace sh
 		class GameThread;
 		class RenderThread;
 		class GameManager;
+		class AsyncAssetLoader;
+		class TextureStreamer;
 	}
 
 	class EngineInit
@@ -58,6 +60,8 @@ namespace sh
 		std::unique_ptr<editor::Project> project;
 #else
 		std::unique_ptr<core::AssetBundle> assetBundle;
+		std::unique_ptr<game::AsyncAssetLoader> assetLoader;
+		std::unique_ptr<game::TextureStreamer> textureStreamer;
 #endif
 		std::unique_ptr<render::Renderer> renderer;
 
@@ -0,0 +1,42 @@
+﻿#pragma once
+#include "../Export.h"
+
+#include "Core/Asset.h"
+#include "Core/SContainer.hpp"
+
+#include "Render/AnimationClip.h"
+namespace sh::game
+{
+	/// @brief 애니메이션 클립 에셋 클래스
+	/// @brief 데이터 구조
+	/// @brief 헤더 | (이름 길이 | 트랙 이름)... | 상수 채널 대상 | 상수 채널 값 | 애니메이션 채널 대상 | 최소값 | 크기 | 프레임
+	class AnimationClipAsset : public core::Asset
+	{
+		SASSET(AnimationClipAsset, "anim")
+	public:
+		struct Header
+		{
+			float duration = 0.f;
+			float sampleRate = 0.f;
+			uint64_t frameCount = 0;
+			uint64_t trackCount = 0;
+			uint64_t constantCount = 0;
+			uint64_t animatedCount = 0;
+		};
+	public:
+		SH_GAME_API AnimationClipAsset();
+		SH_GAME_API AnimationClipAsset(const render::AnimationClip& clip);
+
+		SH_GAME_API void SetAsset(const core::SObject& obj) override;
+
+		SH_GAME_API auto GetClipData() const -> const render::AnimationClip::Data&;
+	protected:
+		SH_GAME_API void SetAssetData() const override;
+		SH_GAME_API auto ParseAssetData() -> bool override;
+	public:
+		constexpr static const char* ASSET_NAME = "anim";
+	private:
+		core::SObjWeakPtr<const render::AnimationClip> clipPtr;
+		render::AnimationClip::Data clipData;
+	};
+}//namespace
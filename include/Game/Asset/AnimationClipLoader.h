@@ -0,0 +1,18 @@
+﻿#pragma once
+#include "../Export.h"
+
+#include "Core/IAssetLoader.h"
+
+#include <filesystem>
+namespace sh::game
+{
+	class AnimationClipLoader : public core::IAssetLoader
+	{
+	public:
+		SH_GAME_API AnimationClipLoader();
+
+		SH_GAME_API auto Load(const std::filesystem::path& filePath) const -> core::SObject* override;
+		SH_GAME_API auto Load(const core::Asset& asset) const -> core::SObject* override;
+		SH_GAME_API auto GetAssetName() const -> const char* override;
+	};
+}//namespace
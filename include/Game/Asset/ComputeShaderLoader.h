@@ -5,6 +5,7 @@
 #include "Core/IAssetLoader.h"
 
 #include "Render/ComputeShader.h"
+#include "Render/ShaderCompiler.h"
 
 #include <filesystem>
 
@@ -21,7 +22,8 @@ namespace sh::game
 		SH_GAME_API ComputeShaderLoader(const render::IRenderContext& ctx);
 		SH_GAME_API ~ComputeShaderLoader();
 
-		SH_GAME_API void SetCachePath(const std::filesystem::path& path) { cachePath = path; }
+		/// @brief 컴파일된 SPIR-V를 저장할 캐시 경로를 지정한다.
+		SH_GAME_API void SetCachePath(const std::filesystem::path& path) { cachePath = path; compiler.SetCachePath(path); }
 		
 		SH_GAME_API auto Load(const std::filesystem::path& filePath) const -> core::SObject* override;
 		SH_GAME_API auto Load(const core::Asset& asset) const -> core::SObject* override;
@@ -33,5 +35,6 @@ namespace sh::game
 		const render::IRenderContext& ctx;
 
 		std::filesystem::path cachePath;
+		render::ShaderCompiler compiler;
 	};
 }//namespace
@@ -18,6 +18,7 @@ namespace sh::game
 		SH_GAME_API MaterialAsset(const render::Material& mat);
 		SH_GAME_API void SetAsset(const core::SObject& obj) override;
 		SH_GAME_API auto GetMaterialData() const -> const core::Json&;
+		SH_GAME_API auto GetDependencies() const -> std::vector<core::UUID> override;
 	protected:
 		SH_GAME_API void SetAssetData() const override;
 		SH_GAME_API auto ParseAssetData() -> bool override;
@@ -19,6 +19,16 @@ namespace sh::game
 			uint64_t boneVertexCount = 0; // 0이면 일반 메쉬
 			uint64_t subMeshCount = 0;
 			uint64_t ibmCount = 0;
+			uint64_t bQuantize = 0; // 0이 아니면 GPU에 양자화된 버텍스로 올린다.
+			uint64_t lodCount = 0; // 원본을 제외한 LOD 수
+			uint64_t lodIndexCount = 0;
+		};
+		/// @brief LOD 인덱스 뒤에 LOD마다 이 헤더와 서브 메쉬 범위가 이어진다.
+		struct LodHeader
+		{
+			float ratio = 1.f;
+			float screenSize = 0.f;
+			uint64_t subMeshCount = 0;
 		};
 		struct MeshData
 		{
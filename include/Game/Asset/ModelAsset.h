@@ -12,7 +12,7 @@ namespace sh::game
 {
 	/// @brief 모델 에셋 클래스
 	/// @brief 데이터 구조
-	///	@brief 모델 헤더 | (노드 헤더 | 노드 데이터)... | (스켈레톤 헤더 | 스켈레톤 데이터)...
+	///	@brief 모델 헤더 | (노드 헤더 | 노드 데이터)... | (스켈레톤 헤더 | 스켈레톤 데이터)... | 애니메이션 수 | 애니메이션 UUID...
 	class ModelAsset : public core::Asset
 	{
 		SASSET(ModelAsset, "mdel")
@@ -25,6 +25,7 @@ namespace sh::game
 
 		SH_GAME_API auto GetData() const -> const std::vector<render::Model::Node>&;
 		SH_GAME_API auto GetSkeletonData() const -> const std::vector<render::Skeleton>&;
+		SH_GAME_API auto GetAnimationData() const -> std::vector<render::AnimationClip*>;
 	protected:
 		SH_GAME_API void SetAssetData() const override;
 		SH_GAME_API auto ParseAssetData() -> bool override;
@@ -52,5 +53,6 @@ namespace sh::game
 		core::SObjWeakPtr<const render::Model> modelPtr;
 		std::vector<render::Model::Node> nodeData;
 		std::vector<render::Skeleton> skeletonData;
+		std::vector<render::AnimationClip*> animationData;
 	};
 }//namespace
\ No newline at end of file
@@ -14,13 +14,20 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
 
+#include <string>
 #include <string_view>
 #include <filesystem>
+#include <vector>
 namespace sh::render
 {
 	class IRenderContext;
 	class Model;
 }
+namespace tinygltf
+{
+	class Model;
+	struct Accessor;
+}
 namespace sh::game
 {
 	class ModelLoader : public core::IAssetLoader
@@ -51,6 +58,11 @@ namespace sh::game
 	protected:
 		SH_GAME_API auto LoadObj(const std::filesystem::path& dir) const -> render::Model*;
 		SH_GAME_API auto LoadGLTF(const std::filesystem::path& dir) const -> render::Model*;
+		/// @brief 파싱된 glTF 모델을 변환한다. 메쉬는 스레드 풀에서 동시에 변환된다.
+		/// @param name 모델 이름. 오류 로그에도 쓰인다.
+		/// @param bBuild false면 메쉬를 GPU에 올리지 않는다.
+		/// @return 변환할 수 없으면 nullptr
+		SH_GAME_API auto LoadGLTF(const tinygltf::Model& gltfModel, const std::string& name, bool bBuild) const -> render::Model*;
 	public:
 		SH_GAME_API ModelLoader(const render::IRenderContext& context);
 
@@ -58,6 +70,19 @@ namespace sh::game
 		SH_GAME_API auto Load(const core::Asset& asset) const -> core::SObject* override;
 
 		SH_GAME_API auto GetAssetName() const -> const char*;
+
+		/// @brief glTF 액세서를 요소마다 성분 수만큼 빽빽하게 채운 float 배열로 읽는다.
+		/// @brief byteStride로 섞여있는 버퍼와 정규화된 정수 성분을 처리한다. 희소(sparse) 액세서는 지원하지 않는다.
+		/// @return 버퍼 범위를 벗어나거나 지원하지 않는 타입이면 false
+		SH_GAME_API static auto ReadGLTFAccessor(const tinygltf::Model& model, const tinygltf::Accessor& accessor, std::vector<float>& out) -> bool;
+
+		/// @brief 임포트 시 메쉬의 인덱스와 버텍스 순서를 최적화할지. 기본값 true
+		SH_GAME_API void SetOptimizeMesh(bool bOptimize) { bOptimizeMesh = bOptimize; }
+		/// @brief 임포트 시 메쉬의 lodRatios 설정대로 LOD를 만들지. 기본값 true
+		SH_GAME_API void SetGenerateLods(bool bGenerate) { bGenerateLods = bGenerate; }
+	private:
+		bool bOptimizeMesh = true;
+		bool bGenerateLods = true;
 	};
 }//namespace
 
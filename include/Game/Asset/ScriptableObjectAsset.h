@@ -17,6 +17,7 @@ namespace sh::game
 
 		SH_GAME_API void SetAsset(const core::SObject& obj) override;
 		SH_GAME_API auto GetSerializationData() const -> const core::Json& { return serializationData; }
+		SH_GAME_API auto GetDependencies() const -> std::vector<core::UUID> override;
 	protected:
 		SH_GAME_API void SetAssetData() const override;
 		SH_GAME_API auto ParseAssetData() -> bool override;
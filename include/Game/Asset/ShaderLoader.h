@@ -5,6 +5,7 @@
 #include "Core/IAssetLoader.h"
 
 #include "Render/Shader.h"
+#include "Render/ShaderCompiler.h"
 
 #include <filesystem>
 
@@ -21,6 +22,7 @@ namespace sh::game
 		SH_GAME_API ShaderLoader(render::ShaderPassBuilder* builder);
 		SH_GAME_API ~ShaderLoader();
 
+		/// @brief 컴파일된 SPIR-V를 저장할 캐시 경로를 지정한다.
 		SH_GAME_API void SetCachePath(const std::filesystem::path& path);
 		SH_GAME_API auto GetCachePath() const -> const std::filesystem::path&;
 
@@ -32,5 +34,6 @@ namespace sh::game
 
 		std::filesystem::path cachePath;
 		render::ShaderPassBuilder* passBuilder;
+		render::ShaderCompiler compiler;
 	};
 }
\ No newline at end of file
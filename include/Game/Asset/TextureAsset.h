@@ -10,6 +10,7 @@
 namespace sh::game
 {
 	/// @brief 텍스쳐 에셋 클래스
+	/// @brief 블록 압축된 텍스쳐는 압축된 밉 데이터를 그대로 저장한다.
 	class TextureAsset : public core::Asset
 	{
 		SASSET(TextureAsset, "tex")
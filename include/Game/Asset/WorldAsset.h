@@ -16,9 +16,13 @@ namespace sh::game
 		SH_GAME_API WorldAsset(const World& world);
 		SH_GAME_API void SetAsset(const core::SObject& obj) override;
 		SH_GAME_API void ConvertToGameWorldType(bool bConvert = true);
+		/// @brief 월드를 직렬화 하는 대신 저장 될 데이터를 직접 지정한다. (스트리밍 셀로 나뉜 월드 등)
+		/// @param json 직렬화 된 월드
+		SH_GAME_API void SetWorldData(core::Json&& json);
 
 		SH_GAME_API auto GetWorldData() const -> const core::Json&;
 		SH_GAME_API auto ReleaseWorldData() -> core::Json&&;
+		SH_GAME_API auto GetDependencies() const -> std::vector<core::UUID> override;
 	protected:
 		SH_GAME_API void SetAssetData() const override;
 		SH_GAME_API auto ParseAssetData() -> bool override;
@@ -0,0 +1,35 @@
+﻿#pragma once
+#include "../Export.h"
+
+#include "Core/Asset.h"
+#include "Core/ISerializable.h"
+
+#include <cstdint>
+namespace sh::game
+{
+	/// @brief 스트리밍 월드의 한 공간 셀에 속한 오브젝트들을 담는 하위 에셋.
+	/// @brief 셀은 SObject가 아니므로 SetAsset()은 아무 일도 하지 않는다. 데이터는 생성자나 SetCellData()로 지정한다.
+	class WorldCellAsset : public core::Asset
+	{
+		SASSET(WorldCellAsset, "wcel")
+	public:
+		SH_GAME_API WorldCellAsset();
+		/// @param uuid 셀 에셋 UUID
+		/// @param worldUUID 셀이 속한 월드 UUID
+		/// @param x 셀 X 좌표
+		/// @param z 셀 Z 좌표
+		/// @param objsJson 셀에 속한 오브젝트들의 직렬화 배열
+		SH_GAME_API WorldCellAsset(const core::UUID& uuid, const core::UUID& worldUUID, int32_t x, int32_t z, core::Json&& objsJson);
+		SH_GAME_API void SetAsset(const core::SObject& obj) override;
+
+		SH_GAME_API auto GetCellData() const -> const core::Json&;
+		SH_GAME_API auto ReleaseCellData() -> core::Json&&;
+	protected:
+		SH_GAME_API void SetAssetData() const override;
+		SH_GAME_API auto ParseAssetData() -> bool override;
+	public:
+		constexpr static const char* ASSET_NAME = "wcel";
+	private:
+		core::Json cellData;
+	};
+}//namespace
@@ -0,0 +1,163 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/UUID.h"
+#include "Core/NonCopyable.h"
+#include "Core/GCObject.h"
+#include "Core/LockFreeMPSCQueue.h"
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+namespace sh::core
+{
+	class Asset;
+	class SObject;
+	class GarbageCollection;
+}
+namespace sh::game
+{
+	/// @brief 에셋과 그 에셋이 의존하는 에셋들을 비동기로 불러오는 클래스.
+	/// @brief 에셋 읽기, 압축 해제, 파싱과 의존성 수집은 스레드 풀에서 수행되며 의존하는 에셋은 발견 즉시 요청된다.
+	/// @brief SObject 생성과 Build 같은 게임 스레드 전용 작업은 Update()에서 의존성이 먼저 오도록 프레임당 예산 안에서 수행된다.
+	/// @brief 핸들과 Load(), Update(), Wait(), Resolve()는 게임 스레드에서만 사용해야 한다.
+	class AsyncAssetLoader : public core::INonCopyable, public core::GCObject
+	{
+	public:
+		/// @brief 에셋을 UUID로 불러오는 함수. 워커 스레드에서 호출되므로 스레드 안전해야 한다.
+		using SourceFn = std::function<std::unique_ptr<core::Asset>(const core::UUID&)>;
+		/// @brief 불러올 수 있는 에셋인지 확인하는 함수. 워커 스레드에서 호출되므로 스레드 안전해야 한다.
+		using ContainsFn = std::function<bool(const core::UUID&)>;
+
+		enum class State
+		{
+			/// @brief 워커 스레드에서 읽고 있다.
+			Loading,
+			/// @brief 파싱이 끝나고 의존하는 에셋들의 통합을 기다리고 있다.
+			Waiting,
+			/// @brief 게임 스레드에서 오브젝트를 만들고 있다.
+			Integrating,
+			Ready,
+			Failed
+		};
+		struct Settings
+		{
+			/// @brief 프레임당 통합 작업에 쓸 수 있는 시간(ms)
+			float integrationBudgetMs = 4.f;
+			/// @brief 동시에 워커 스레드에서 진행 될 수 있는 로드 수
+			uint32_t maxConcurrentLoads = 16;
+		};
+	private:
+		struct Entry
+		{
+			core::UUID uuid;
+			State state = State::Loading;
+			core::SObject* obj = nullptr;
+			std::unique_ptr<core::Asset> asset;
+			/// @brief 이 에셋보다 먼저 통합돼야 하는 에셋들. 이 에셋이 통합될 때 까지 같이 유지된다.
+			std::vector<std::shared_ptr<Entry>> deps;
+			bool bDispatched = false;
+			/// @brief Finish()에서 순환 참조를 끊는데 쓰인다.
+			bool bVisiting = false;
+
+			explicit Entry(const core::UUID& uuid) : uuid(uuid) {}
+		};
+	public:
+		/// @brief 불러오기 요청의 핸들. 핸들이 살아있는 동안 불러온 에셋과 의존하는 에셋들은 쓰레기 수집되지 않는다.
+		class Handle
+		{
+			friend AsyncAssetLoader;
+		public:
+			Handle() = default;
+
+			SH_GAME_API auto IsValid() const -> bool { return entry != nullptr; }
+			SH_GAME_API auto GetState() const -> State;
+			/// @brief 준비됐거나 실패했다면 true
+			SH_GAME_API auto IsDone() const -> bool;
+			SH_GAME_API auto GetUUID() const -> const core::UUID&;
+			/// @brief 불러온 오브젝트를 반환한다.
+			/// @return 준비되지 않았거나 실패했다면 nullptr
+			SH_GAME_API auto Get() const -> core::SObject*;
+		private:
+			explicit Handle(std::shared_ptr<Entry> entry) : entry(std::move(entry)) {}
+		private:
+			std::shared_ptr<Entry> entry;
+		};
+	public:
+		/// @param source 에셋을 불러오는 함수
+		/// @param contains 의존성 중 에셋이 아닌 UUID를 거르는 함수. nullptr면 걸러지지 않는다.
+		SH_GAME_API AsyncAssetLoader(SourceFn source, ContainsFn contains = nullptr);
+		SH_GAME_API ~AsyncAssetLoader();
+
+		/// @brief 에셋을 비동기로 불러오도록 요청한다. 이미 요청됐거나 불러와진 에셋이면 같은 결과를 가리키는 핸들을 반환한다.
+		/// @param uuid 에셋 UUID
+		SH_GAME_API auto Load(const core::UUID& uuid) -> Handle;
+		/// @brief 워커 스레드의 결과를 받고, 의존성이 모두 준비된 에셋들을 예산 안에서 통합한다. 매 프레임 호출한다.
+		SH_GAME_API void Update();
+		/// @brief 핸들의 에셋과 의존하는 에셋들이 준비될 때 까지 기다리며 예산 없이 통합한다.
+		SH_GAME_API void Wait(const Handle& handle);
+		/// @brief 에셋을 즉시 불러온다. 진행 중인 요청이 있다면 그 결과를 기다려서 쓰므로 같은 에셋을 두 번 읽지 않는다.
+		/// @brief 에셋 리졸버에서 사용된다.
+		/// @return 실패 시 nullptr
+		SH_GAME_API auto Resolve(const core::UUID& uuid) -> core::SObject*;
+
+		SH_GAME_API void SetSettings(const Settings& settings) { this->settings = settings; }
+		SH_GAME_API auto GetSettings() const -> const Settings& { return settings; }
+		/// @brief 아직 준비되지 않은 요청 수
+		SH_GAME_API auto GetPendingCount() const -> std::size_t;
+
+		SH_GAME_API void PushReferenceObjects(core::GarbageCollection& gc) override;
+	private:
+		struct LoadResult
+		{
+			core::UUID uuid;
+			std::unique_ptr<core::Asset> asset;
+			std::vector<core::UUID> deps;
+		};
+		/// @brief 워커 스레드와 공유되는 상태. 로더가 먼저 파괴돼도 작업이 안전하게 끝날 수 있도록 공유 포인터로 둔다.
+		struct SharedState
+		{
+			core::LockFreeMPSCQueue<LoadResult> resultQueue;
+			std::mutex mu;
+			std::condition_variable cv;
+			/// @brief 끝난 작업 수. Wait()가 새 결과를 기다리는데 쓰인다.
+			std::atomic<uint64_t> completed{ 0 };
+		};
+	private:
+		auto GetOrCreateEntry(const core::UUID& uuid) -> std::shared_ptr<Entry>;
+		void Dispatch(Entry& entry);
+		void DispatchPending();
+		void ReceiveResults();
+		/// @brief 워커 스레드(또는 Resolve())에서 읽은 결과를 엔트리에 반영하고 의존하는 에셋들을 요청한다.
+		void ApplyResult(const std::shared_ptr<Entry>& entry, std::unique_ptr<core::Asset>&& asset, const std::vector<core::UUID>& deps);
+		/// @brief 엔트리가 워커 스레드에서 돌아올 때 까지 기다린다.
+		void WaitForResult(Entry& entry);
+		/// @brief 엔트리와 의존성들을 예산 없이 통합한다.
+		void Finish(Entry& entry);
+		void Integrate(Entry& entry);
+		auto IsIntegrable(const Entry& entry) const -> bool;
+		/// @brief 핸들과 다른 엔트리가 더 이상 가리키지 않는 끝난 엔트리를 제거한다.
+		void ReleaseUnused();
+	private:
+		SourceFn source;
+		ContainsFn contains;
+
+		Settings settings;
+
+		std::unordered_map<core::UUID, std::shared_ptr<Entry>> entries;
+		/// @brief 동시 로드 수 제한 때문에 아직 워커에 넘기지 못한 엔트리들
+		std::deque<std::shared_ptr<Entry>> pending;
+		/// @brief 의존성 통합을 기다리는 엔트리들. 도착한 순서대로 있다.
+		std::vector<std::shared_ptr<Entry>> waiting;
+
+		std::shared_ptr<SharedState> shared;
+
+		uint32_t loadingCount = 0;
+	};
+}//namespace
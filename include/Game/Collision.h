@@ -2,31 +2,42 @@
 #include "Export.h"
 
 #include "Core/GCObject.h"
+#include "Core/ArrayView.hpp"
 
 #include "Physics/ContactPoint.h"
+#include "Physics/ContactBuffer.h"
 
-#include <array>
-#include <vector>
-#include <variant>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
 namespace sh::game
 {
 	class Collider;
+	/// @brief 충돌 정보. 접촉점은 복사하지 않고 물리 세계의 접촉 버퍼를 가리킨다.
+	/// @brief 접촉점은 해당 버퍼가 비워지기 전(다음 프레임의 고정 업데이트 전)까지만 유효하다.
 	struct Collision : core::GCObject
 	{
-		static constexpr std::size_t ARRAY_SIZE = 6;
-
-		SH_GAME_API Collision(const std::array<phys::ContactPoint, ARRAY_SIZE>& contactPoints);
-		SH_GAME_API Collision(std::vector<phys::ContactPoint>&& contactPoints);
+		SH_GAME_API Collision(const phys::ContactBuffer& buffer, uint32_t pairIdx);
 		SH_GAME_API Collision(Collision&& other) noexcept;
 		SH_GAME_API auto operator=(Collision&& other) noexcept -> Collision&;
 
 		SH_GAME_API void PushReferenceObjects(core::GarbageCollection& gc) override;
 
-		SH_GAME_API auto GetContactPoint(uint32_t idx) const -> const phys::ContactPoint&;
+		/// @brief 접촉점을 가리키는 버퍼가 아직 유효한지
+		SH_GAME_API auto IsContactValid() const -> bool;
+		SH_GAME_API auto GetContactPoint(uint32_t idx) const -> phys::ContactPoint;
+
+		/// @brief 유효하지 않으면 빈 뷰를 반환한다.
+		SH_GAME_API auto GetWorldNormals() const -> core::ArrayView<const glm::vec3>;
+		SH_GAME_API auto GetLocalPointsOnCollider1() const -> core::ArrayView<const glm::vec3>;
+		SH_GAME_API auto GetLocalPointsOnCollider2() const -> core::ArrayView<const glm::vec3>;
+		SH_GAME_API auto GetPenetrationDepths() const -> core::ArrayView<const float>;
 
 		Collider* collider = nullptr;
 		uint32_t contactCount = 0;
 	private:
-		std::variant<std::array<phys::ContactPoint, ARRAY_SIZE>, std::vector<phys::ContactPoint>> contacts;
+		const phys::ContactBuffer* buffer = nullptr;
+		uint32_t contactBegin = 0;
+		uint64_t generation = 0;
 	};
 }//namespace
\ No newline at end of file
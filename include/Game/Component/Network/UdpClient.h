@@ -3,9 +3,10 @@
 #include "NetworkComponent.h"
 
 #include "Network/UdpSocket.h"
+#include "Network/NetworkService.h"
 
 #include <string>
-#include <thread>
+#include <vector>
 namespace sh::game
 {
 	/// @brief 에코 클라이언트 컴포넌트
@@ -24,7 +25,9 @@ namespace sh::game
 		SH_GAME_API auto GetServerIP() const -> const std::string& { return serverIp; }
 		SH_GAME_API auto GetServerPort() const -> int { return serverPort; }
 	protected:
-		network::NetworkContext ctx;
+		/// @brief 받은 메시지 묶음. NetworkService::Dispatch()에서 호출된다.
+		SH_GAME_API virtual void OnReceived(std::vector<network::NetworkContext::Message>& messages);
+	protected:
 		network::UdpSocket socket;
 	private:
 		PROPERTY(serverIp)
@@ -32,6 +35,6 @@ namespace sh::game
 		PROPERTY(serverPort)
 		int serverPort = 4026;
 
-		std::thread networkThread;
+		network::NetworkService::ReceiverId receiverId = network::NetworkService::INVALID_RECEIVER;
 	};
 }//namespace
\ No newline at end of file
@@ -4,9 +4,9 @@
 
 #include "Network/UdpSocket.h"
 #include "Network/Packet.h"
+#include "Network/NetworkService.h"
 
 #include <vector>
-#include <thread>
 namespace sh::game
 {
 	/// @brief UDP 에코 서버 컴포넌트
@@ -26,12 +26,14 @@ namespace sh::game
 
 		SH_GAME_API auto GetPort() const -> int { return port; }
 	protected:
-		network::NetworkContext ctx;
+		/// @brief 받은 메시지 묶음. NetworkService::Dispatch()에서 호출된다.
+		SH_GAME_API virtual void OnReceived(std::vector<network::NetworkContext::Message>& messages);
+	protected:
 		network::UdpSocket socket;
 	private:
 		PROPERTY(port)
 		int port = 4026;
 
-		std::thread networkThread;
+		network::NetworkService::ReceiverId receiverId = network::NetworkService::INVALID_RECEIVER;
 	};
 }//namespace
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Core/Observer.hpp"
 
 #include "Physics/CollisionTag.hpp"
+#include "Physics/ContactBuffer.h"
 
 #include <vector>
 #include <unordered_map>
@@ -56,6 +57,8 @@ namespace sh::game
 		PROPERTY(rigidBody, core::PropertyOption::sobjPtr, core::PropertyOption::invisible)
 		RigidBody* rigidBody = nullptr;
 		void* nativeCollider = nullptr;
+		/// @brief 물리 세계에 등록된 인덱스. 접촉 버퍼에서 이 충돌체를 가리킨다.
+		uint32_t physIdx = phys::ContactBuffer::INVALID_INDEX;
 
 		phys::Tag tag = phys::Tag::Tag1;
 		phys::Tagbit allowed = 0xffff;
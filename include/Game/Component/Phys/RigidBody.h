@@ -70,6 +70,8 @@ namespace sh::game
 		/// @brief 물리 객체의 transform을 현재 오브젝트의 transform으로 초기화 하는 코드
 		SH_GAME_API void ResetPhysicsTransform();
 		SH_GAME_API void ResetInterpolationState();
+		/// @brief 보간 상태를 주어진 물리 상태로 맞춘다. 롤백으로 상태를 되돌린 뒤 이전 틱과 섞이지 않도록 쓴다.
+		SH_GAME_API void ResetInterpolationState(const glm::vec3& pos, const glm::quat& rot);
 
 		/// @brief 물리 엔진에서 연산에 사용하는 월드 좌표를 가져오는 함수
 		/// @return 월드 좌표
@@ -80,10 +82,15 @@ namespace sh::game
 		SH_GAME_API static auto GetRigidBodyUsingHandle(RigidBodyHandle handle) -> RigidBody*;
 	private:
 		void Interpolate();
+		/// @brief 물리 스텝이 진행 중이면 스텝이 끝난 뒤에 반영되도록 쓰기를 미룬다.
+		template<typename F>
+		void PhysWrite(F&& fn);
 	private:
 		struct Impl;
 
 		std::unique_ptr<Impl> impl;
+		/// @brief 물리 세계에 등록된 인덱스. 접촉 버퍼에서 이 강체를 가리킨다.
+		uint32_t physIdx = 0;
 
 		PROPERTY(angularLock)
 		game::Vec3 angularLock{ 0.f, 0.f, 0.f };
@@ -0,0 +1,88 @@
+﻿#pragma once
+#include "Game/Export.h"
+#include "Game/Component/Component.h"
+
+#include "Render/Model.h"
+#include "Render/AnimationClip.h"
+#include "Render/AnimationPose.h"
+
+#include <glm/mat4x4.hpp>
+#include <string>
+#include <vector>
+namespace sh::game
+{
+	/// @brief 모델 스켈레톤의 포즈를 애니메이션 클립으로 계산하는 컴포넌트.
+	/// @brief 레이어마다 1차원 블렌드 트리를 평가하고, 두번째 레이어부터는 가중치와 조인트 마스크로 아래 레이어를 덮어쓴다.
+	/// @brief 결과는 모델 공간 조인트 행렬이며 SkinnedMeshRenderer가 트랜스폼 없이 바로 스키닝 행렬로 쓴다.
+	class Animator : public Component
+	{
+		COMPONENT(Animator)
+	public:
+		/// @brief 블렌드 트리의 모션
+		struct Motion
+		{
+			int clipIdx = 0;
+			float threshold = 0.f; // 파라미터가 이 값일 때 이 모션만 재생된다.
+			float speed = 1.f;
+		};
+		struct Layer
+		{
+			std::string name;
+			std::vector<Motion> motions; // threshold 오름차순
+			float parameter = 0.f;
+			float weight = 1.f; // 첫번째 레이어는 항상 1로 취급한다.
+			std::string maskRoot; // 이 조인트와 자손만 덮어쓴다. 비어있으면 전체.
+			bool bLoop = true;
+		};
+	public:
+		SH_GAME_API Animator(GameObject& owner);
+		SH_GAME_API ~Animator();
+
+		SH_GAME_API void Awake() override;
+		SH_GAME_API void Update() override;
+		SH_GAME_API void OnPropertyChanged(const core::reflection::Property& prop) override;
+		SH_GAME_API auto Serialize() const -> core::Json override;
+		SH_GAME_API void Deserialize(const core::Json& json) override;
+
+		SH_GAME_API void SetModel(render::Model* model, int skeletonIdx = 0);
+		SH_GAME_API void SetClips(std::vector<render::AnimationClip*> clips);
+		SH_GAME_API void SetLayers(std::vector<Layer> layers);
+		SH_GAME_API void SetParameter(std::size_t layerIdx, float value);
+		SH_GAME_API void SetLayerWeight(std::size_t layerIdx, float weight);
+
+		/// @brief 시간을 dt만큼 진행하고 포즈와 모델 공간 조인트 행렬을 계산한다. 매 프레임 World의 SkinningSystem이 호출한다.
+		/// @brief 이 Animator의 데이터만 쓰므로 서로 다른 Animator는 동시에 평가해도 된다.
+		SH_GAME_API void Evaluate(float dt);
+
+		SH_GAME_API auto GetModel() const -> render::Model* { return model; }
+		SH_GAME_API auto GetSkeleton() const -> const render::Skeleton*;
+		SH_GAME_API auto GetClips() const -> const std::vector<render::AnimationClip*>& { return clips; }
+		SH_GAME_API auto GetLayers() const -> const std::vector<Layer>& { return layers; }
+		/// @brief 스켈레톤 조인트 순서의 모델 공간 행렬. 아직 평가되지 않았다면 비어있다.
+		SH_GAME_API auto GetModelMatrices() const -> const std::vector<glm::mat4>& { return modelMatrices; }
+	private:
+		/// @brief 레이어의 블렌드 트리를 평가해 pose에 쓴다.
+		void EvaluateLayer(std::size_t layerIdx, float dt, render::AnimationPose& pose);
+		void Rebind();
+	private:
+		PROPERTY(model)
+		render::Model* model = nullptr;
+		PROPERTY(skeletonIdx)
+		int skeletonIdx = 0;
+		PROPERTY(clips)
+		std::vector<render::AnimationClip*> clips;
+		PROPERTY(speed)
+		float speed = 1.f;
+
+		std::vector<Layer> layers;
+		std::vector<float> layerTimes; // 레이어별 정규화된 재생 시간 [0, 1)
+		std::vector<std::vector<float>> layerMasks;
+		std::vector<render::AnimationClip::Binding> bindings; // 클립별
+
+		render::AnimationPose pose;
+		render::AnimationPose layerPose;
+		render::AnimationPose blendPose;
+		std::vector<glm::mat4> modelMatrices;
+		bool bDirty = true;
+	};
+}//namespace
@@ -16,6 +16,7 @@
 namespace sh::game
 {
 	class Camera;
+	class TextureStreamer;
 
 	class MeshRenderer : public Component
 	{
@@ -70,6 +71,10 @@ namespace sh::game
 		}
 
 		void FillLightStruct(render::Drawable& drawable, render::Shader& shader);
+		/// @brief 카메라들에서 보이는 크기에 맞는 밉을 머티리얼의 텍스쳐들에 요청한다.
+		void RequestTextureMips(TextureStreamer& streamer) const;
+		/// @brief 카메라별로 보이는 크기에 맞는 LOD를 골라 Drawable에 넘긴다.
+		void UpdateLods();
 	protected:
 		PROPERTY(drawables, core::PropertyOption::invisible, core::PropertyOption::noSave)
 		std::vector<render::Drawable*> drawables;
@@ -98,5 +103,16 @@ namespace sh::game
 
 		PROPERTY(renderTag)
 		uint32_t renderTag = 1;
+		/// @brief LOD를 고를 때 화면 크기에 곱해진다. 작을수록 더 가까이서부터 낮은 LOD를 쓴다.
+		PROPERTY(lodBias)
+		float lodBias = 1.f;
+		/// @brief 그림자 패스의 LOD를 고를 때 화면 크기에 곱해진다.
+		PROPERTY(shadowLodBias)
+		float shadowLodBias = 0.5f;
+
+		/// @brief World::GetCameras() 순서의 카메라별 현재 LOD
+		std::vector<uint8_t> cameraLods;
+		/// @brief 카메라별 그림자 LOD. 그림자 맵은 카메라들이 공유하므로 이 중 가장 높은 상세도를 쓴다.
+		std::vector<uint8_t> cameraShadowLods;
 	};
 }//namespace
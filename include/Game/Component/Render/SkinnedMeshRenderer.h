@@ -4,15 +4,18 @@
 
 #include "Render/SkinnedMesh.h"
 
-#include <array>
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 
 namespace sh::game
 {
 	class Transform;
+	class Animator;
 
 	/// @brief 스켈레탈 메쉬 렌더러
+	/// @brief Animator가 있으면 Animator가 계산한 조인트 행렬을, 없으면 bones 트랜스폼을 쓴다.
+	/// @brief 스키닝 행렬은 World의 SkinningSystem이 다른 렌더러들과 함께 계산해 공유 버퍼에 쓴다.
 	class SkinnedMeshRenderer : public MeshRenderer
 	{
 		COMPONENT(SkinnedMeshRenderer)
@@ -25,19 +28,35 @@ namespace sh::game
 
 		SH_GAME_API void SetSkinnedMesh(render::SkinnedMesh* mesh);
 		SH_GAME_API void SetBones(std::vector<Transform*> bones);
+		SH_GAME_API void SetAnimator(Animator* animator);
 
 		SH_GAME_API auto GetBones() const -> const std::vector<Transform*>& { return bones; }
+		SH_GAME_API auto GetAnimator() const -> Animator* { return animator; }
 		SH_GAME_API auto GetInverseBindMatrices() const -> const std::vector<glm::mat4>& { return inverseBindMatrices; }
+		/// @brief 스키닝 행렬 수
+		SH_GAME_API auto GetJointCount() const -> std::size_t { return inverseBindMatrices.size(); }
+
+		/// @brief 렌더러 공간의 스키닝 행렬을 out에 GetJointCount()개 쓴다. 트랜스폼과 Animator를 읽기만 하므로 렌더러끼리 동시에 호출해도 된다.
+		SH_GAME_API void ComputeSkinMatrices(glm::mat4* out) const;
+		/// @brief Animator의 모델 공간 조인트 행렬로 스키닝 행렬을 inverseBindMatrices.size()개 쓴다. 모자란 조인트는 단위 행렬이 된다.
+		/// @param toRenderer Animator 공간에서 렌더러 공간으로의 변환
+		SH_GAME_API static void ComputeSkinMatrices(const std::vector<glm::mat4>& modelMatrices, const glm::mat4& toRenderer,
+			const std::vector<glm::mat4>& inverseBindMatrices, glm::mat4* out);
+		/// @brief 본의 월드 행렬로 스키닝 행렬을 inverseBindMatrices.size()개 쓴다. nullptr인 본과 모자란 조인트는 단위 행렬이 된다.
+		SH_GAME_API static void ComputeSkinMatrices(const std::vector<const glm::mat4*>& boneMatrices,
+			const std::vector<glm::mat4>& inverseBindMatrices, glm::mat4* out);
+		/// @brief 공유 스키닝 버퍼에서 이 렌더러의 행렬이 시작하는 인덱스를 Drawable들에 넘긴다.
+		SH_GAME_API void SetSkinOffset(uint32_t offset);
 	protected:
 		SH_GAME_API void UpdateDrawable() override;
 	private:
-		void ComputeBoneMatrices();
-		void UploadBoneMatrices();
 		void InitIBM();
 	private:
 		PROPERTY(bones, core::PropertyOption::invisible)
 		std::vector<Transform*> bones;
+		PROPERTY(animator, core::PropertyOption::sobjPtr)
+		Animator* animator = nullptr;
 		std::vector<glm::mat4> inverseBindMatrices;
-		std::vector<glm::mat4> finalBoneMatrices;
+		mutable std::vector<const glm::mat4*> boneMatrices; // ComputeSkinMatrices에서 재사용. 렌더러마다 따로라서 동시에 호출해도 된다.
 	};
 }//namespace
@@ -24,6 +24,8 @@ namespace sh::render
 namespace sh::game
 {
 	class ImGUImpl;
+	class AsyncAssetLoader;
+	class TextureStreamer;
 
 	class GameManager : public core::Singleton<GameManager>
 	{
@@ -66,6 +68,15 @@ namespace sh::game
 
 		SH_GAME_API auto LoadGame(const std::filesystem::path& managerPath, core::AssetBundle& bundle) -> bool;
 
+		/// @brief 비동기 에셋 로더를 지정한다. 지정된 로더는 UpdateWorlds()에서 매 프레임 갱신되며 LoadGame()에서 시작 월드를 불러오는데 쓰인다.
+		/// @param loader 로더. 소유권은 넘어오지 않는다.
+		SH_GAME_API void SetAssetLoader(AsyncAssetLoader* loader);
+		SH_GAME_API auto GetAssetLoader() const -> AsyncAssetLoader* { return assetLoader; }
+		/// @brief 텍스쳐 스트리머를 지정한다. 지정된 스트리머는 UpdateWorlds()에서 월드들이 갱신된 후 매 프레임 갱신된다.
+		/// @param streamer 스트리머. 소유권은 넘어오지 않는다.
+		SH_GAME_API void SetTextureStreamer(TextureStreamer* streamer);
+		SH_GAME_API auto GetTextureStreamer() const -> TextureStreamer* { return textureStreamer; }
+
 		/// @brief 월드가 변경 돼도 유지 되는 오브젝트를 생성한다.
 		/// @param name 이름
 		/// @return 게임 오브젝트
@@ -87,6 +98,8 @@ namespace sh::game
 	private:
 		render::Renderer* renderer = nullptr;
 		ImGUImpl* gui = nullptr;
+		AsyncAssetLoader* assetLoader = nullptr;
+		TextureStreamer* textureStreamer = nullptr;
 
 		core::SObjWeakPtr<World> mainWorld = nullptr;
 
@@ -0,0 +1,217 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/NonCopyable.h"
+#include "Core/ArrayView.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+namespace sh::core
+{
+	class SObject;
+	namespace reflection
+	{
+		class Property;
+	}
+}
+namespace sh::game
+{
+	class GameObject;
+
+	/// @brief 복제 값의 양자화 정밀도. 서버와 클라이언트가 같은 값을 써야 한다.
+	struct ReplicationQuantization
+	{
+		/// @brief float 프로퍼티의 최소 단위
+		float floatPrecision = 0.001f;
+		/// @brief 벡터 프로퍼티와 Transform 위치, 크기의 최소 단위
+		float vectorPrecision = 0.01f;
+	};
+
+	/// @brief 복제 객체를 이루는 SObject들(파트)의 복제 필드 배치.
+	/// @brief 파트의 타입 순서가 같으면 서버와 클라이언트에서 같은 배치가 만들어진다.
+	/// @brief PropertyOption::replicated가 붙은 프로퍼티 중 bool, int32, uint32, float, 벡터, 쿼터니언, 그 외 바이트 복사 가능한 타입을 지원하며
+	/// @brief 파트가 Transform이면 위치, 회전, 크기가 필드로 추가된다.
+	struct ReplicationLayout
+	{
+		enum class FieldKind : uint8_t
+		{
+			Bool,
+			Int,
+			UInt,
+			Float,
+			Vector,
+			Quat,
+			Raw,
+			TransformPosition,
+			TransformRotation,
+			TransformScale
+		};
+		struct Field
+		{
+			FieldKind kind;
+			uint32_t part;
+			/// @brief Transform 필드라면 nullptr
+			const core::reflection::Property* prop;
+			/// @brief 양자화 상태에서의 위치와 크기
+			uint32_t offset;
+			uint32_t size;
+		};
+		std::vector<Field> fields;
+		uint32_t stateSize = 0;
+		/// @brief 타입 이름, 프로퍼티 이름, 필드 종류로 만든 해시. 서버와 클라이언트의 배치가 같은지 확인한다.
+		uint32_t hash = 0;
+
+		SH_GAME_API static auto Build(core::ArrayView<core::SObject* const> parts) -> ReplicationLayout;
+		/// @brief 게임 오브젝트의 Transform과 컴포넌트들을 순서대로 out에 넣는다.
+		SH_GAME_API static void CollectParts(GameObject& obj, std::vector<core::SObject*>& out);
+	};
+
+	/// @brief 서버 쪽 상태 복제.
+	/// @brief Update()마다 등록된 객체들의 복제 필드를 양자화해 두고, 클라이언트별로 시야 범위 안의 객체를 격자로 찾아
+	/// @brief 우선순위가 높은 순서대로 클라이언트가 마지막으로 확인(ack)한 값과 다른 필드만 비트 단위로 기록한다.
+	/// @brief 스냅샷은 비신뢰성 채널로 보내는 것을 전제로 하며, 확인되지 않은 필드는 확인될 때 까지 다시 보낸다.
+	/// @brief 전송 계층과 분리돼 있다. WriteSnapshot()의 결과를 보내고 클라이언트가 돌려준 번호를 Acknowledge()로 넘긴다.
+	class ReplicationServer : public core::INonCopyable
+	{
+	public:
+		using NetId = uint32_t;
+		using ClientId = uint32_t;
+		static constexpr NetId INVALID_NET_ID = 0;
+
+		struct Settings
+		{
+			ReplicationQuantization quantization;
+			/// @brief 스냅샷 하나의 최대 바이트 수. 데이터그램 하나에 들어가도록 잡는다.
+			uint32_t maxSnapshotBytes = 900;
+			/// @brief 관련성 조회에 쓰는 XZ 격자의 셀 크기
+			float cellSize = 32.f;
+			/// @brief 이미 보이던 객체는 시야 반경 * 이 값을 벗어나야 사라진다. 경계에서 생성과 제거가 반복되지 않게 한다.
+			float relevanceHysteresis = 1.1f;
+		};
+		struct EntitySettings
+		{
+			/// @brief 클라이언트가 객체를 만들 때 쓰는 종류 번호 (예: 프리팹 번호)
+			uint32_t archetype = 0;
+			/// @brief 틱마다 쌓이는 우선순위. 클수록 자주 보내진다.
+			float priority = 1.f;
+			/// @brief 시야와 상관없이 모든 클라이언트에 보낸다. (예: 게임 상태 객체)
+			bool bAlwaysRelevant = false;
+		};
+		struct ClientStats
+		{
+			/// @brief 마지막 스냅샷 기준
+			uint32_t relevantEntities = 0;
+			uint32_t sentEntities = 0;
+			uint32_t snapshotBytes = 0;
+			uint64_t totalBytes = 0;
+		};
+	public:
+		SH_GAME_API ReplicationServer();
+		SH_GAME_API explicit ReplicationServer(const Settings& settings);
+		SH_GAME_API ~ReplicationServer();
+
+		/// @brief 게임 오브젝트를 복제 대상으로 등록한다. 위치는 Transform의 월드 위치를 쓴다.
+		SH_GAME_API auto Register(GameObject& obj, const EntitySettings& entitySettings) -> NetId;
+		/// @brief SObject들을 하나의 복제 객체로 등록한다. 위치는 SetEntityPosition()으로 정한다.
+		SH_GAME_API auto Register(core::ArrayView<core::SObject* const> parts, const EntitySettings& entitySettings) -> NetId;
+		/// @brief 등록을 해제한다. 객체를 알고 있는 클라이언트에게는 제거가 전달된다.
+		SH_GAME_API void Unregister(NetId id);
+		SH_GAME_API void SetEntityPosition(NetId id, const glm::vec3& pos);
+
+		SH_GAME_API auto AddClient() -> ClientId;
+		SH_GAME_API void RemoveClient(ClientId client);
+		/// @brief 클라이언트의 시야. 중심에서 radius 안의 객체만 보낸다.
+		SH_GAME_API void SetClientView(ClientId client, const glm::vec3& pos, float radius);
+
+		/// @brief 틱마다 한 번 호출한다. 객체들의 상태를 양자화하고 관련성 격자를 다시 만든다. 파괴된 객체는 등록 해제된다.
+		SH_GAME_API void Update();
+		/// @brief 클라이언트에게 보낼 스냅샷을 out에 기록한다.
+		/// @return 스냅샷 번호
+		SH_GAME_API auto WriteSnapshot(ClientId client, std::vector<uint8_t>& out) -> uint32_t;
+		/// @brief 클라이언트가 스냅샷을 받았음을 알린다. 그 스냅샷에 담긴 값이 이후 비교의 기준이 된다.
+		SH_GAME_API void Acknowledge(ClientId client, uint32_t snapshot);
+
+		SH_GAME_API auto GetClientStats(ClientId client) const -> const ClientStats*;
+		auto GetEntityCount() const -> std::size_t { return entities.size(); }
+		auto GetSettings() const -> const Settings& { return settings; }
+	private:
+		struct Entity;
+		struct Client;
+		struct ClientEntity;
+		struct SnapshotRecord;
+
+		auto FindEntity(NetId id) -> Entity*;
+		void CaptureState(Entity& entity);
+		void QueryRelevant(const Client& client, std::vector<uint32_t>& out) const;
+		static auto CellKey(int32_t x, int32_t z) -> uint64_t;
+	private:
+		Settings settings;
+
+		std::vector<std::unique_ptr<Entity>> entities;
+		std::unordered_map<NetId, uint32_t> entityIndices;
+		NetId nextNetId = 1;
+
+		std::unordered_map<ClientId, std::unique_ptr<Client>> clients;
+		ClientId nextClientId = 1;
+
+		/// @brief 셀 -> 엔티티 인덱스
+		std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+		std::vector<uint32_t> alwaysRelevant;
+
+		std::vector<uint32_t> queryScratch;
+		std::vector<std::pair<float, uint32_t>> priorityScratch;
+		std::vector<uint8_t> blockScratch;
+		std::vector<uint8_t> maskScratch;
+	};
+
+	/// @brief 클라이언트 쪽 상태 복제. ReplicationServer가 만든 스냅샷을 읽어 객체를 만들고, 지우고, 값을 적용한다.
+	/// @brief 순서가 뒤바뀐 스냅샷이 와도 객체마다 더 최신 값만 적용한다.
+	class ReplicationClient : public core::INonCopyable
+	{
+	public:
+		using NetId = ReplicationServer::NetId;
+		/// @brief 새 객체를 만들고 파트들을 parts에 넣는다. 서버와 같은 타입 순서여야 한다.
+		/// @return 만들지 못했다면 false
+		using SpawnFunction = std::function<bool(NetId id, uint32_t archetype, std::vector<core::SObject*>& parts)>;
+		using DespawnFunction = std::function<void(NetId id)>;
+	public:
+		SH_GAME_API explicit ReplicationClient(const ReplicationQuantization& quantization = ReplicationQuantization{});
+		SH_GAME_API ~ReplicationClient();
+
+		SH_GAME_API void SetSpawnFunction(SpawnFunction&& fn);
+		SH_GAME_API void SetDespawnFunction(DespawnFunction&& fn);
+
+		/// @brief 스냅샷을 적용한다.
+		/// @return 서버에 확인을 보낼 스냅샷 번호. 데이터가 잘못됐다면 nullopt
+		SH_GAME_API auto ReadSnapshot(const uint8_t* data, std::size_t size) -> std::optional<uint32_t>;
+
+		/// @return 없으면 nullptr
+		SH_GAME_API auto GetParts(NetId id) const -> const std::vector<core::SObject*>*;
+		auto GetEntityCount() const -> std::size_t { return entities.size(); }
+	private:
+		struct Entity
+		{
+			std::vector<core::SObject*> parts;
+			ReplicationLayout layout;
+			uint32_t lastSnapshot = 0;
+			bool bLayoutMismatch = false;
+		};
+	private:
+		ReplicationQuantization quantization;
+		SpawnFunction spawnFn;
+		DespawnFunction despawnFn;
+
+		std::unordered_map<NetId, Entity> entities;
+		/// @brief 제거된 객체 -> 제거된 스냅샷 번호. 늦게 도착한 예전 스냅샷이 객체를 되살리지 않게 한다.
+		std::unordered_map<NetId, uint32_t> tombstones;
+		std::vector<uint8_t> stateScratch;
+		std::vector<uint8_t> maskScratch;
+		uint32_t latestSnapshot = 0;
+	};
+}//namespace
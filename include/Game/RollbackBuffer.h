@@ -0,0 +1,116 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/UUID.h"
+#include "Core/NonCopyable.h"
+#include "Core/ArrayView.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+namespace sh::core
+{
+	class SObject;
+	namespace reflection
+	{
+		class Property;
+		class STypeInfo;
+	}
+}
+namespace sh::game
+{
+	/// @brief 롤백을 위해 틱마다 게임플레이 상태를 저장하는 링 버퍼.
+	/// @brief 객체의 바이트 복사 가능한 프로퍼티와 Transform의 회전, RigidBody의 물리 상태를 하나의 바이너리 프레임으로 만들고
+	/// @brief 직전 프레임과의 XOR 결과를 0 구간 길이로 압축해 저장한다. 객체 구성이 바뀌거나 일정 간격마다 키 프레임을 저장한다.
+	/// @brief 객체의 생성과 파괴는 되돌리지 않는다. 복원 시점에 살아 있는 객체만 복원된다.
+	class RollbackBuffer : public core::INonCopyable
+	{
+	public:
+		struct Settings
+		{
+			/// @brief 저장할 최대 프레임 수
+			uint32_t capacity = 64;
+			/// @brief 키 프레임 사이의 최대 델타 프레임 수. 복원 시 풀어야 하는 프레임 수의 상한이 된다.
+			uint32_t keyFrameInterval = 16;
+		};
+	public:
+		SH_GAME_API RollbackBuffer();
+		SH_GAME_API explicit RollbackBuffer(const Settings& settings);
+		SH_GAME_API ~RollbackBuffer();
+
+		/// @brief 객체들의 상태를 tick 프레임으로 저장한다. 마지막으로 저장한 틱 이하라면 그 이후의 프레임들은 버려진다.
+		/// @param tick 틱 번호
+		/// @param objs 저장할 객체들. 순서가 바뀌면 객체 구성이 바뀐 것으로 본다.
+		SH_GAME_API void Capture(uint64_t tick, core::ArrayView<core::SObject* const> objs);
+		/// @brief tick 프레임의 상태로 객체들을 되돌린다. 값이 바뀐 프로퍼티는 OnPropertyChanged()가 호출된다.
+		/// @brief 복원에 성공하면 tick 이후의 프레임들은 버려진다.
+		/// @return 해당 프레임이 없거나 키 프레임까지 이어지지 않으면 false
+		SH_GAME_API auto Restore(uint64_t tick) -> bool;
+		SH_GAME_API void Clear();
+
+		SH_GAME_API auto HasFrame(uint64_t tick) const -> bool;
+		/// @brief 압축된 프레임의 바이트 수. 없으면 0
+		SH_GAME_API auto GetFrameSize(uint64_t tick) const -> std::size_t;
+		/// @brief 압축 전 프레임의 바이트 수. 없으면 0
+		SH_GAME_API auto GetRawFrameSize(uint64_t tick) const -> std::size_t;
+		SH_GAME_API auto IsKeyFrame(uint64_t tick) const -> bool;
+		auto GetLatestTick() const -> uint64_t { return latestTick; }
+		auto GetSettings() const -> const Settings& { return settings; }
+	private:
+		struct TypeLayout
+		{
+			std::vector<const core::reflection::Property*> props;
+			uint32_t size = 0;
+			uint8_t extra = 0;
+		};
+		struct Entry
+		{
+			core::SObject* obj;
+			core::UUID uuid;
+			const TypeLayout* type;
+			uint32_t offset;
+		};
+		struct Layout
+		{
+			std::vector<Entry> entries;
+			uint32_t size = 0;
+		};
+		struct Frame
+		{
+			uint64_t tick = 0;
+			/// @brief 키 프레임이면 tick과 같다.
+			uint64_t baseTick = 0;
+			std::shared_ptr<const Layout> layout;
+			std::vector<uint8_t> data;
+			bool bValid = false;
+		};
+	private:
+		auto GetTypeLayout(const core::reflection::STypeInfo& type) -> const TypeLayout*;
+		auto FindFrame(uint64_t tick) const -> const Frame*;
+		auto IsSameLayout(core::ArrayView<core::SObject* const> objs) const -> bool;
+		void BuildLayout(core::ArrayView<core::SObject* const> objs);
+		void WriteRaw(const Layout& layout, std::vector<uint8_t>& raw) const;
+		void ApplyRaw(const Layout& layout, const std::vector<uint8_t>& raw) const;
+		void InvalidateAfter(uint64_t tick);
+
+		/// @brief raw와 base의 XOR를 (0 구간 길이, 리터럴 길이, 리터럴) 순으로 기록한다. base가 nullptr이면 0과 비교한다.
+		static void Encode(const std::vector<uint8_t>& raw, const uint8_t* base, std::vector<uint8_t>& out);
+		/// @brief Encode()의 역연산. raw에 결과를 XOR한다.
+		static void DecodeXor(const std::vector<uint8_t>& encoded, std::vector<uint8_t>& raw);
+	private:
+		Settings settings;
+
+		std::vector<Frame> frames;
+		std::unordered_map<const core::reflection::STypeInfo*, std::unique_ptr<TypeLayout>> typeLayouts;
+
+		std::shared_ptr<const Layout> currentLayout;
+		/// @brief 마지막으로 저장 또는 복원한 프레임의 원본
+		std::vector<uint8_t> lastRaw;
+		std::vector<uint8_t> scratchRaw;
+
+		uint64_t latestTick = 0;
+		uint64_t lastKeyTick = 0;
+		bool bHasLast = false;
+	};
+}//namespace
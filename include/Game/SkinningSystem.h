@@ -0,0 +1,51 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/NonCopyable.h"
+
+#include <cstdint>
+#include <vector>
+namespace sh::render
+{
+	class SkinPaletteBuffer;
+}
+namespace sh::game
+{
+	class Animator;
+	class SkinnedMeshRenderer;
+
+	/// @brief 월드의 스키닝 단계. 한 프레임 동안 제출된 Animator의 포즈와 SkinnedMeshRenderer의 스키닝 행렬을 캐릭터 단위로 나눠 스레드 풀에서 계산한다.
+	/// @brief 모든 렌더러의 행렬은 렌더 컨텍스트의 공유 스키닝 버퍼 한 곳에 이어서 쓰이고, 렌더러는 시작 위치만 Drawable에 넘긴다.
+	class SkinningSystem : public core::INonCopyable
+	{
+	public:
+		SH_GAME_API SkinningSystem();
+		SH_GAME_API ~SkinningSystem();
+
+		/// @brief 이번 프레임에 포즈를 계산할 Animator. Animator::Update()에서 호출된다.
+		SH_GAME_API void Submit(Animator& animator);
+		/// @brief 이번 프레임에 그려질 렌더러. SkinnedMeshRenderer가 LateUpdate()에서 호출한다.
+		SH_GAME_API void Submit(SkinnedMeshRenderer& renderer);
+		/// @brief 제출된 Animator들을 평가한 뒤 렌더러들의 스키닝 행렬을 palette에 쓰고 제출 목록을 비운다.
+		/// @brief 모든 LateUpdate가 끝난 뒤 메인 스레드에서 호출해야 한다.
+		/// @param dt Animator를 진행할 시간
+		/// @param palette 렌더 컨텍스트의 공유 스키닝 버퍼
+		/// @brief 공유 버퍼에 다 들어가지 못한 렌더러는 SkinPaletteBuffer::INVALID_OFFSET을 받아 그 프레임에 그려지지 않는다.
+		SH_GAME_API void Update(float dt, render::SkinPaletteBuffer& palette);
+		SH_GAME_API void Clear();
+
+		/// @brief 렌더러별 조인트 수를 이어 붙인 시작 인덱스(누적 합)를 구한다.
+		/// @return 전체 행렬 수
+		SH_GAME_API static auto CalcOffsets(const std::vector<std::size_t>& jointCounts, std::vector<uint32_t>& offsets) -> std::size_t;
+		/// @brief 잡은 행렬 수에 다 들어가지 못한 렌더러의 시작 인덱스를 SkinPaletteBuffer::INVALID_OFFSET으로 바꾼다.
+		/// @param allocated 실제로 잡은 행렬 수
+		/// @return 들어가지 못한 렌더러 수
+		SH_GAME_API static auto ClipOffsets(const std::vector<std::size_t>& jointCounts, std::size_t allocated, std::vector<uint32_t>& offsets) -> std::size_t;
+	private:
+		std::vector<Animator*> animators;
+		std::vector<SkinnedMeshRenderer*> renderers;
+		std::vector<std::size_t> jointCounts; // 렌더러별 조인트 수
+		std::vector<uint32_t> offsets; // 렌더러별 공유 버퍼 시작 인덱스
+		bool bOverflowLogged = false;
+	};
+}//namespace
@@ -0,0 +1,148 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/UUID.h"
+#include "Core/NonCopyable.h"
+#include "Core/SContainer.hpp"
+#include "Core/LockFreeMPSCQueue.h"
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+namespace sh::core
+{
+	class Asset;
+}
+namespace sh::render
+{
+	class Texture;
+}
+namespace sh::game
+{
+	class TextureAsset;
+
+	/// @brief 텍스쳐의 밉을 화면에 보이는 크기에 맞춰 비동기로 불러오고 해제하는 클래스.
+	/// @brief 시작 시에는 작은 밉 꼬리만 불러오고, 렌더러들이 요청한 해상도의 밉은 스레드 풀에서 에셋을 읽어 채운다.
+	/// @brief 올라간 밉들이 예산을 넘으면 가장 오래 쓰이지 않은 텍스쳐부터 밉 꼬리만 남기고 해제한다.
+	/// @brief 게임 스레드에서만 사용해야 한다.
+	class TextureStreamer : public core::INonCopyable
+	{
+	public:
+		/// @brief 텍스쳐 에셋을 UUID로 불러오는 함수. 워커 스레드에서 호출되므로 스레드 안전해야 한다.
+		using SourceFn = std::function<std::unique_ptr<core::Asset>(const core::UUID&)>;
+
+		struct Settings
+		{
+			/// @brief 긴 변이 이 값 이하인 밉들(밉 꼬리)은 처음부터 불러오며 해제되지 않는다.
+			uint32_t tailSize = 128;
+			/// @brief 스트리밍 텍스쳐의 밉들이 차지할 수 있는 최대 크기(바이트). 올라간 밉, 읽고 있는 밉, CPU 메모리에 남는 밉 꼬리를 합한 크기다.
+			std::size_t memoryBudget = 512ull * 1024 * 1024;
+			/// @brief 화면 크기로 구한 밉에 더해진다. 양수면 더 낮은 해상도를 쓴다.
+			float mipBias = 0.f;
+			/// @brief 동시에 진행 될 수 있는 비동기 밉 로드 수
+			uint32_t maxConcurrentLoads = 4;
+		};
+	public:
+		/// @param source 높은 해상도의 밉을 읽을 텍스쳐 에셋을 불러오는 함수
+		SH_GAME_API explicit TextureStreamer(SourceFn source);
+		SH_GAME_API ~TextureStreamer();
+
+		/// @brief 밉 꼬리가 시작되는 밉을 반환한다.
+		/// @param width 0번 밉의 너비
+		/// @param height 0번 밉의 높이
+		/// @param mipCount 밉 수
+		SH_GAME_API auto GetTailMip(uint32_t width, uint32_t height, uint32_t mipCount) const -> uint32_t;
+		/// @brief 텍스쳐를 스트리밍 대상으로 등록한다. 밉 꼬리보다 높은 해상도의 밉은 GPU에 올라간 후 CPU 메모리에서 해제된다.
+		/// @param texture 텍스쳐
+		/// @param assetUUID 높은 해상도의 밉을 읽을 텍스쳐 에셋 UUID
+		SH_GAME_API void Register(render::Texture& texture, const core::UUID& assetUUID);
+		/// @brief 이번 프레임에 필요한 밉을 요청한다. 여러번 요청되면 가장 높은 해상도를 쓴다. 등록되지 않은 텍스쳐는 무시된다.
+		/// @param texture 텍스쳐
+		/// @param mip 필요한 밉
+		SH_GAME_API void RequestMip(const render::Texture& texture, uint32_t mip);
+		/// @brief 화면에 보이는 크기로 필요한 밉을 요청한다.
+		/// @param texture 텍스쳐
+		/// @param screenSize 화면에 보이는 크기(픽셀)
+		SH_GAME_API void RequestScreenSize(const render::Texture& texture, float screenSize);
+		/// @brief 읽은 밉을 텍스쳐에 반영하고 이번 프레임의 요청에 따라 로드와 해제를 진행한다.
+		/// @brief 렌더러들의 요청이 끝난 후 동기화 전에 매 프레임 호출한다.
+		SH_GAME_API void Update();
+
+		SH_GAME_API void SetSettings(const Settings& settings) { this->settings = settings; }
+		SH_GAME_API auto GetSettings() const -> const Settings& { return settings; }
+		SH_GAME_API auto GetTextureCount() const -> std::size_t { return entries.size(); }
+		/// @brief 스트리밍 텍스쳐들의 올라간 밉과 CPU 메모리에 남은 밉 꼬리 크기의 합(바이트). Update()에서 갱신된다.
+		SH_GAME_API auto GetResidentSize() const -> std::size_t { return residentSize; }
+		/// @brief 읽고 있는 밉 크기의 합(바이트)
+		SH_GAME_API auto GetLoadingSize() const -> std::size_t { return loadingSize; }
+
+		/// @brief 화면에 보이는 크기에 맞는 밉을 구한다.
+		/// @param textureSize 텍스쳐의 긴 변
+		/// @param screenSize 화면에 보이는 크기(픽셀)
+		/// @param bias 구한 밉에 더할 값
+		SH_GAME_API static auto CalcMip(uint32_t textureSize, float screenSize, float bias = 0.f) -> uint32_t;
+		/// @brief 텍스쳐 에셋에서 밉 데이터를 꺼낸다.
+		/// @param asset 텍스쳐 에셋
+		/// @param firstMip 꺼낼 첫 밉
+		/// @param lastMip 꺼낼 마지막 밉의 다음
+		/// @return 실패 시 빈 벡터
+		SH_GAME_API static auto ExtractMips(const TextureAsset& asset, uint32_t firstMip, uint32_t lastMip) -> std::vector<std::vector<uint8_t>>;
+	private:
+		struct Entry
+		{
+			core::SObjWeakPtr<render::Texture> texture;
+			core::UUID assetUUID;
+			uint32_t tailMip = 0;
+			/// @brief CPU 메모리에 남는 밉 꼬리의 크기
+			std::size_t tailSize = 0;
+			/// @brief 이번 프레임에 요청된 가장 높은 해상도의 밉. 요청이 없다면 tailMip
+			uint32_t requestedMip = 0;
+			uint64_t lastUsedFrame = 0;
+
+			bool bLoading = false;
+			uint32_t loadingMip = 0;
+			std::size_t loadingSize = 0;
+			/// @brief 로드 요청마다 바뀐다. 취소된 요청의 결과를 거르는데 쓰인다.
+			uint32_t ticket = 0;
+
+			Entry(render::Texture& texture, const core::UUID& assetUUID);
+		};
+		struct LoadedMips
+		{
+			const render::Texture* texture;
+			uint32_t ticket;
+			uint32_t firstMip;
+			std::vector<std::vector<uint8_t>> mips;
+		};
+		/// @brief 워커 스레드와 공유되는 상태. 스트리머가 먼저 파괴돼도 작업이 안전하게 끝날 수 있도록 공유 포인터로 둔다.
+		struct SharedState
+		{
+			core::LockFreeMPSCQueue<LoadedMips> loadedQueue;
+		};
+	private:
+		void ReceiveLoadedMips();
+		void RequestLoad(Entry& entry, uint32_t mip, std::size_t size);
+		/// @brief 이번 프레임에 쓰이지 않은 텍스쳐들을 오래된 순서로 밉 꼬리까지 내려서 required 만큼의 예산을 확보한다.
+		/// @return 확보했다면 true
+		auto Evict(std::size_t required, const Entry& except) -> bool;
+		auto IsOverBudget(std::size_t required) const -> bool;
+		/// @brief 텍스쳐가 firstMip부터 올라가 있을 때의 크기
+		static auto GetMipsSize(const render::Texture& texture, uint32_t firstMip) -> std::size_t;
+	private:
+		SourceFn source;
+
+		Settings settings;
+
+		std::unordered_map<const render::Texture*, Entry> entries;
+
+		std::shared_ptr<SharedState> shared;
+
+		uint64_t frame = 0;
+		uint32_t nextTicket = 0;
+		uint32_t loadingCount = 0;
+		std::size_t residentSize = 0;
+		std::size_t loadingSize = 0;
+	};
+}//namespace
@@ -19,7 +19,6 @@
 #include "Render/Texture.h"
 
 #include "Physics/PhysWorld.h"
-#include "Physics/PhysicsEvent.h"
 
 #include <string>
 #include <vector>
@@ -45,6 +44,9 @@ namespace sh::game
 	class Component;
 	class ImGUImpl;
 	class Camera;
+	class WorldStreamer;
+	class RollbackBuffer;
+	class SkinningSystem;
 
 	class World : public sh::core::SObject, public sh::core::INonCopyable
 	{
@@ -70,6 +72,11 @@ namespace sh::game
 		/// @brief 게임 오브젝트를 추가한다.
 		/// @param name 오브젝트 이름
 		SH_GAME_API virtual auto AddGameObject(std::string_view name) -> GameObject*;
+		/// @brief 직렬화 된 오브젝트로부터 게임 오브젝트와 컴포넌트를 생성하는 함수. 역직렬화는 하지 않는다.
+		/// @brief 이미 월드 상에 같은 UUID의 오브젝트가 존재하면 그 오브젝트의 컴포넌트를 새로 만든다.
+		/// @param objJson 직렬화 된 게임 오브젝트
+		/// @return 게임 오브젝트 포인터
+		SH_GAME_API auto CreateGameObjectFromJson(const core::Json& objJson) -> GameObject*;
 		SH_GAME_API void DestroyGameObject(std::string_view name);
 		SH_GAME_API void DestroyGameObject(GameObject& obj);
 		/// @brief 가장 먼저 발견 된 해당 이름을 가진 게임 오브젝트를 반환하는 함수 O(N)
@@ -114,6 +121,17 @@ namespace sh::game
 
 		SH_GAME_API virtual void ReallocateUUIDS();
 
+		/// @brief 결정론적 모드를 설정한다. 켜면 지정한 틱 속도로 고정 업데이트가 진행되고 물리는 항상 동기로 스텝하며,
+		/// @brief 플레이 중 매 틱이 끝날 때 게임플레이 상태가 롤백 버퍼에 저장된다.
+		/// @param bDeterministic 결정론적 모드 여부
+		/// @param tickRate 초당 틱 수
+		SH_GAME_API void SetDeterministic(bool bDeterministic, uint32_t tickRate = 60);
+		/// @brief 저장된 틱의 상태로 되돌린다. 이후 틱의 저장 상태는 버려진다.
+		/// @return 결정론적 모드가 아니거나 해당 틱이 버퍼에 없으면 false
+		SH_GAME_API auto Rollback(uint64_t tick) -> bool;
+		/// @brief 렌더링과 Update, LateUpdate 없이 고정 틱만 ticks번 진행한다. 충돌 함수는 매 틱 호출된다.
+		SH_GAME_API void Resimulate(uint32_t ticks);
+
 		auto GetUiContext() const -> ImGUImpl& { return *imgui; }
 		auto GetPhysWorld() -> phys::PhysWorld& { return physWorld; }
 		auto GetLightOctree() -> Octree& { return lightOctree; }
@@ -121,6 +139,7 @@ namespace sh::game
 		auto GetMainCamera() const -> Camera* { return mainCamera; }
 		auto GetShadowMapManager() -> render::ShadowMapManager& { return *shadowMapManager; }
 		auto GetShadowMapManager() const -> const render::ShadowMapManager& { return *shadowMapManager; }
+		auto GetSkinningSystem() -> SkinningSystem& { return *skinningSystem; }
 		auto GetGameObjects() const -> const std::vector<GameObject*>& { return objs; }
 		auto GetGameObjectPool() -> core::memory::MemoryPool<GameObject>& { return objPool; }
 		auto GetCameras() const -> const std::vector<Camera*>& { return cameras; }
@@ -128,10 +147,30 @@ namespace sh::game
 		auto IsStart() const -> bool { return bOnStart; }
 		auto IsLoaded() const -> bool { return bLoaded; }
 		auto GetFixedAccumulator() const -> double { return dtAccumulator; }
+		/// @brief 스트리밍 월드가 아니라면 nullptr
+		auto GetStreamer() const -> WorldStreamer* { return streamer.get(); }
+		auto GetStreamingCellSize() const -> float { return streamingCellSize; }
+		auto GetStreamingLoadRadius() const -> float { return streamingLoadRadius; }
+		auto IsAsyncPhysics() const -> bool { return bAsyncPhysics; }
+		/// @brief 켜면 물리 스텝이 워커 스레드에서 게임 업데이트와 겹쳐 실행된다. 다음 Update()부터 적용된다.
+		void SetAsyncPhysics(bool bAsync) { bAsyncPhysics = bAsync; }
+		auto IsDeterministic() const -> bool { return bDeterministic; }
+		auto GetTickRate() const -> uint32_t { return tickRate; }
+		/// @brief 고정 업데이트 한 번의 시간(초). 결정론적 모드가 아니면 FIXED_TIME
+		auto GetFixedDeltaTime() const -> float { return bDeterministic ? 1.f / static_cast<float>(tickRate) : FIXED_TIME; }
+		/// @brief 플레이 후 진행된 고정 틱 수
+		auto GetTick() const -> uint64_t { return tick; }
+		/// @brief 결정론적 모드가 아니면 nullptr
+		auto GetRollbackBuffer() const -> RollbackBuffer* { return rollbackBuffer.get(); }
 	protected:
 		SH_GAME_API void CleanObjs();
 	private:
 		auto AllocateGameObject() -> GameObject*;
+		/// @brief 물리 세계의 접촉 버퍼에서 아직 전달하지 않은 쌍들을 게임 오브젝트에 전달한다.
+		void DispatchContacts();
+		/// @brief 고정 틱 하나를 진행한다. 물리 스텝, 충돌 전달, FixedUpdate, 롤백 저장 순이다.
+		void FixedTick(float fixedDt, bool bAsyncStep);
+		void CaptureRollback();
 	public:
 		render::Renderer& renderer;
 		const double& deltaTime = dt;
@@ -145,6 +184,9 @@ namespace sh::game
 
 		std::unique_ptr<render::ScriptableRenderer> customRenderer;
 		std::unique_ptr<render::ShadowMapManager> shadowMapManager;
+		std::unique_ptr<SkinningSystem> skinningSystem;
+		std::unique_ptr<WorldStreamer> streamer;
+		std::unique_ptr<RollbackBuffer> rollbackBuffer;
 	private:
 		core::GarbageCollection* gc;
 		ImGUImpl* imgui = nullptr;
@@ -158,6 +200,21 @@ namespace sh::game
 
 		PROPERTY(mainCamera, core::PropertyOption::sobjPtr)
 		Camera* mainCamera = nullptr;
+		/// @brief 0보다 크면 빌드 시 월드를 해당 크기의 셀로 나눠 스트리밍한다.
+		PROPERTY(streamingCellSize)
+		float streamingCellSize = 0.f;
+		PROPERTY(streamingLoadRadius)
+		float streamingLoadRadius = 128.f;
+		PROPERTY(bAsyncPhysics)
+		bool bAsyncPhysics = false;
+		PROPERTY(bDeterministic)
+		bool bDeterministic = false;
+		PROPERTY(tickRate)
+		uint32_t tickRate = 60;
+
+		uint64_t tick = 0;
+		/// @brief 롤백 저장 대상 객체 목록. 매 틱 재사용한다.
+		std::vector<core::SObject*> rollbackObjs;
 
 		phys::PhysWorld physWorld;
 
@@ -169,7 +226,8 @@ namespace sh::game
 
 		std::unordered_map<std::string, core::Json> savePoints;
 
-		core::EventSubscriber<phys::PhysicsEvent> physEventSubscriber;
+		/// @brief 접촉 버퍼에서 이미 게임 오브젝트로 전달한 쌍 수
+		uint32_t dispatchedContactPairs = 0;
 
 		bool bStartLoop = false;
 		bool bWaitPlaying = false;
@@ -0,0 +1,174 @@
+﻿#pragma once
+#include "Export.h"
+#include "Vector.h"
+
+#include "Core/UUID.h"
+#include "Core/ISerializable.h"
+#include "Core/NonCopyable.h"
+#include "Core/SContainer.hpp"
+#include "Core/LockFreeMPSCQueue.h"
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+namespace sh::core
+{
+	class Asset;
+}
+namespace sh::game
+{
+	class World;
+	class GameObject;
+	class WorldCellAsset;
+
+	/// @brief 월드를 XZ 평면의 공간 셀로 나누고, 카메라 근처의 셀만 비동기로 불러오고 해제하는 클래스.
+	/// @brief 셀 데이터의 읽기, 압축 해제, 파싱은 스레드 풀에서 수행되며
+	/// @brief 오브젝트 생성과 역직렬화(리소스 생성 포함)는 게임 스레드에서 프레임당 예산 안에서 나눠서 수행된다.
+	class WorldStreamer : public core::INonCopyable
+	{
+	public:
+		/// @brief 셀 에셋을 UUID로 불러오는 함수. 워커 스레드에서 호출되므로 스레드 안전해야 한다.
+		using CellSourceFn = std::function<std::unique_ptr<core::Asset>(const core::UUID&)>;
+
+		struct CellCoord
+		{
+			int32_t x = 0;
+			int32_t z = 0;
+
+			auto operator==(const CellCoord& other) const -> bool { return x == other.x && z == other.z; }
+		};
+		struct Settings
+		{
+			float cellSize = 64.f;
+			/// @brief 셀 중심까지의 거리가 이 값 이하면 불러온다.
+			float loadRadius = 128.f;
+			/// @brief 셀 중심까지의 거리가 이 값을 넘으면 해제한다. loadRadius보다 커야 셀이 경계에서 깜빡이지 않는다.
+			float unloadRadius = 160.f;
+			/// @brief 프레임당 통합 작업에 쓸 수 있는 시간(ms)
+			float integrationBudgetMs = 2.f;
+			/// @brief 동시에 진행 될 수 있는 비동기 셀 로드 수
+			uint32_t maxConcurrentLoads = 4;
+		};
+		/// @brief 관찰자 위치에서 고른 셀 로드/언로드 목록. 셀 인덱스로 나타낸다.
+		struct CellPlan
+		{
+			/// @brief 새로 불러올 셀. 가까운 순서
+			std::vector<std::size_t> loads;
+			std::vector<std::size_t> unloads;
+		};
+		/// @brief 빌드 시 월드를 셀로 나눈 결과
+		struct PartitionResult
+		{
+			core::Json persistentWorld;
+			std::vector<std::unique_ptr<WorldCellAsset>> cells;
+		};
+	public:
+		SH_GAME_API WorldStreamer(World& world);
+		SH_GAME_API ~WorldStreamer();
+
+		/// @brief 직렬화 된 월드의 "streaming" 항목으로 셀 테이블과 설정을 초기화 한다.
+		/// @param streamingJson Partition()이 만든 "streaming" json
+		SH_GAME_API void Setup(const core::Json& streamingJson);
+
+		/// @brief 관찰자 위치에 따라 셀 로드/언로드를 요청하고, 로드가 끝난 셀을 예산 안에서 월드에 통합한다.
+		/// @param viewPos 관찰자(카메라) 월드 좌표
+		SH_GAME_API void Update(const Vec3& viewPos);
+
+		/// @brief 불러온 모든 셀의 오브젝트를 제거하고 진행 중인 로드 결과를 버린다.
+		SH_GAME_API void UnloadAll();
+
+		SH_GAME_API void SetSettings(const Settings& settings);
+		SH_GAME_API auto GetSettings() const -> const Settings& { return settings; }
+		SH_GAME_API auto GetCellCount() const -> std::size_t { return cells.size(); }
+		SH_GAME_API auto GetLoadedCellCount() const -> std::size_t;
+		SH_GAME_API auto GetPendingIntegrationCount() const -> std::size_t { return integrations.size(); }
+
+		/// @brief 셀 에셋을 불러올 함수를 지정한다. (런타임에서는 에셋 번들)
+		SH_GAME_API static void SetCellSource(CellSourceFn fn);
+		SH_GAME_API static auto GetCellSource() -> const CellSourceFn&;
+
+		/// @brief 직렬화 된 월드를 루트 오브젝트의 위치 기준으로 셀로 나눈다. 자식 오브젝트는 루트와 같은 셀에 속한다.
+		/// @param worldJson 직렬화 된 월드
+		/// @param settings 스트리밍 설정
+		/// @param persistentNames 셀로 나누지 않고 항상 월드에 남아있을 루트 오브젝트 이름들
+		/// @return 셀 오브젝트가 제거되고 "streaming" 항목이 추가된 월드와 셀 에셋들
+		SH_GAME_API static auto Partition(const core::Json& worldJson, const Settings& settings, const std::vector<std::string>& persistentNames = {}) -> PartitionResult;
+		SH_GAME_API static auto ToCellCoord(const Vec3& pos, float cellSize) -> CellCoord;
+		/// @brief 셀 중심까지의 XZ 평면 거리
+		SH_GAME_API static auto DistanceToCell(const Vec3& viewPos, const CellCoord& coord, float cellSize) -> float;
+		/// @brief 관찰자 위치에서 불러올 셀과 해제할 셀을 고른다.
+		/// @brief loadRadius 안의 해제된 셀을 가까운 순서로 최대 loadSlots개 고르고, unloadRadius 밖의 상주 셀을 해제한다.
+		/// @param coords 셀 좌표
+		/// @param resident 셀별로 불러왔거나 불러오는 중인지 여부
+		/// @param plan 결과. 기존 내용은 지워진다.
+		SH_GAME_API static void PlanCells(const std::vector<CellCoord>& coords, const std::vector<uint8_t>& resident,
+			const Vec3& viewPos, const Settings& settings, std::size_t loadSlots, CellPlan& plan);
+		/// @brief 월드와 셀 좌표로 정해지는 셀 에셋 UUID. 다시 나눠도 같은 셀은 같은 UUID를 갖는다.
+		SH_GAME_API static auto MakeCellUUID(const core::UUID& worldUUID, const CellCoord& coord) -> core::UUID;
+	private:
+		enum class CellState
+		{
+			Unloaded,
+			Loading,
+			Integrating,
+			Loaded
+		};
+		struct Cell
+		{
+			CellCoord coord;
+			core::UUID assetUUID = core::UUID::GenerateEmptyUUID();
+			CellState state = CellState::Unloaded;
+			/// @brief 로드 요청마다 증가한다. 취소된 요청의 결과를 거르는데 쓰인다.
+			uint32_t ticket = 0;
+			std::vector<core::SObjWeakPtr<GameObject>> objs;
+		};
+		struct LoadedCell
+		{
+			std::size_t cellIdx;
+			uint32_t ticket;
+			core::Json objs;
+		};
+		/// @brief 워커 스레드와 공유되는 상태. 스트리머가 먼저 파괴돼도 작업이 안전하게 끝날 수 있도록 공유 포인터로 둔다.
+		struct SharedState
+		{
+			core::LockFreeMPSCQueue<LoadedCell> loadedQueue;
+		};
+		struct Integration
+		{
+			enum class Phase
+			{
+				Create,
+				Deserialize,
+				Finish
+			} phase = Phase::Create;
+
+			std::size_t cellIdx;
+			core::Json objs;
+			std::size_t cursor = 0;
+			std::vector<GameObject*> created;
+		};
+	private:
+		void RequestLoad(std::size_t cellIdx);
+		void Unload(std::size_t cellIdx);
+		void ReceiveLoadedCells();
+		void Integrate();
+	private:
+		World& world;
+
+		Settings settings;
+
+		std::vector<Cell> cells;
+		std::vector<CellCoord> cellCoords;
+		std::vector<uint8_t> cellResident;
+		CellPlan plan;
+		std::deque<Integration> integrations;
+
+		std::shared_ptr<SharedState> shared;
+
+		uint32_t loadingCount = 0;
+
+		static CellSourceFn cellSource;
+	};
+}//namespace
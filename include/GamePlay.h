@@ -49,9 +49,10 @@
 #include "Game/Component/Render/TextRenderer.h"
 #include "Game/Component/Sound/AudioSource.h"
 
+#include "Physics/ContactBuffer.h"
 #include "Physics/ContactPoint.h"
 #include "Physics/HitPoint.h"
-#include "Physics/PhysicsEvent.h"
+#include "Physics/PhysicsQuery.h"
 #include "Physics/PhysWorld.h"
 #include "Physics/Ray.h"
 
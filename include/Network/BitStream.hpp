@@ -0,0 +1,360 @@
+﻿#pragma once
+#include "Core/ArrayView.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <algorithm>
+namespace sh::network
+{
+	namespace detail
+	{
+		inline constexpr float QUAT_COMPONENT_MAX = 0.70710678f; // 1 / sqrt(2)
+
+		inline auto BitMask(uint32_t bits) -> uint32_t
+		{
+			return bits >= 32 ? 0xffffffffu : ((1u << bits) - 1u);
+		}
+		inline auto Quantize(float value, float min, float max, uint32_t bits) -> uint32_t
+		{
+			const double range = static_cast<double>(max) - static_cast<double>(min);
+			const double normalized = std::clamp((static_cast<double>(value) - min) / range, 0.0, 1.0);
+			return static_cast<uint32_t>(normalized * BitMask(bits) + 0.5);
+		}
+		inline auto Dequantize(uint32_t value, float min, float max, uint32_t bits) -> float
+		{
+			const double range = static_cast<double>(max) - static_cast<double>(min);
+			return static_cast<float>(min + static_cast<double>(value) / BitMask(bits) * range);
+		}
+	}//namespace
+
+	/// @brief 호출자가 준 버퍼에 비트 단위로 기록하는 스트림. 메모리를 할당하지 않는다.
+	/// @brief 버퍼가 부족하거나 값이 허용 범위를 넘으면 이후 기록은 무시되고 IsOverflow()가 true가 된다.
+	/// @brief BitReader와 같은 이름의 함수(Bits, Varint, QuantizedFloat 등)를 제공하므로 하나의 템플릿 함수로 읽기와 쓰기를 모두 표현할 수 있다.
+	class BitWriter
+	{
+	public:
+		static constexpr bool IS_WRITING = true;
+		static constexpr bool IS_READING = false;
+	public:
+		explicit BitWriter(core::ArrayView<uint8_t> buffer) :
+			buffer(buffer.data()), capacity(buffer.size())
+		{}
+		BitWriter(uint8_t* buffer, std::size_t capacity) :
+			buffer(buffer), capacity(capacity)
+		{}
+
+		/// @brief 값의 하위 bits 비트를 기록한다.
+		/// @param bits 1 ~ 32
+		void WriteBits(uint32_t value, uint32_t bits)
+		{
+			assert(bits > 0 && bits <= 32);
+			scratch |= static_cast<uint64_t>(value & detail::BitMask(bits)) << scratchBits;
+			scratchBits += bits;
+			while (scratchBits >= 8)
+			{
+				if (bytePos < capacity)
+					buffer[bytePos++] = static_cast<uint8_t>(scratch);
+				else
+					bOverflow = true;
+				scratch >>= 8;
+				scratchBits -= 8;
+			}
+		}
+		/// @brief 남은 비트를 0으로 채워 바이트 경계에 맞춘다.
+		void Align()
+		{
+			if (scratchBits > 0)
+				WriteBits(0, 8 - scratchBits);
+		}
+		void WriteBytes(const uint8_t* data, std::size_t size)
+		{
+			Align();
+			if (bytePos + size > capacity)
+			{
+				bOverflow = true;
+				return;
+			}
+			if (size > 0)
+				std::memcpy(buffer + bytePos, data, size);
+			bytePos += size;
+		}
+
+		auto Bits(uint32_t& value, uint32_t bits) -> bool { WriteBits(value, bits); return !bOverflow; }
+		auto Boolean(bool& value) -> bool { WriteBits(value ? 1 : 0, 1); return !bOverflow; }
+		auto Byte(uint8_t& value) -> bool { WriteBits(value, 8); return !bOverflow; }
+		/// @brief 7비트씩 끊어 기록한다. 작은 값일수록 적은 비트를 쓴다.
+		auto Varint(uint64_t& value) -> bool
+		{
+			uint64_t v = value;
+			while (v >= 0x80)
+			{
+				WriteBits(static_cast<uint32_t>(v & 0x7f) | 0x80, 8);
+				v >>= 7;
+			}
+			WriteBits(static_cast<uint32_t>(v), 8);
+			return !bOverflow;
+		}
+		auto Varint(uint32_t& value) -> bool
+		{
+			uint64_t v = value;
+			return Varint(v);
+		}
+		/// @brief 부호 있는 정수는 지그재그 인코딩 후 기록한다.
+		auto Varint(int32_t& value) -> bool
+		{
+			uint64_t v = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+			return Varint(v);
+		}
+		auto Float(float& value) -> bool
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(float));
+			WriteBits(bits, 32);
+			return !bOverflow;
+		}
+		/// @brief [min, max] 범위의 실수를 bits 비트로 양자화해서 기록한다. 범위를 넘는 값은 잘린다.
+		auto QuantizedFloat(float& value, float min, float max, uint32_t bits) -> bool
+		{
+			WriteBits(detail::Quantize(value, min, max, bits), bits);
+			return !bOverflow;
+		}
+		auto QuantizedVec3(glm::vec3& value, float min, float max, uint32_t bits) -> bool
+		{
+			QuantizedFloat(value.x, min, max, bits);
+			QuantizedFloat(value.y, min, max, bits);
+			return QuantizedFloat(value.z, min, max, bits);
+		}
+		/// @brief 가장 큰 성분을 제외한 세 성분만 기록한다. (2 + 3 * bits 비트)
+		auto Quaternion(glm::quat& value, uint32_t bits = 10) -> bool
+		{
+			const float components[4] = { value.x, value.y, value.z, value.w };
+			uint32_t largest = 0;
+			for (uint32_t i = 1; i < 4; ++i)
+			{
+				if (std::abs(components[i]) > std::abs(components[largest]))
+					largest = i;
+			}
+			// q와 -q는 같은 회전이므로 가장 큰 성분이 양수가 되도록 맞춘다.
+			const float sign = components[largest] < 0.f ? -1.f : 1.f;
+			WriteBits(largest, 2);
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				if (i == largest)
+					continue;
+				WriteBits(detail::Quantize(components[i] * sign, -detail::QUAT_COMPONENT_MAX, detail::QUAT_COMPONENT_MAX, bits), bits);
+			}
+			return !bOverflow;
+		}
+		/// @brief 길이가 maxLength를 넘으면 자르지 않고 기록에 실패한다. (BitReader::String과 같은 제한)
+		auto String(std::string& value, uint32_t maxLength = 0xffff) -> bool
+		{
+			if (value.size() > maxLength)
+			{
+				bOverflow = true;
+				return false;
+			}
+			uint32_t len = static_cast<uint32_t>(value.size());
+			Varint(len);
+			WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), len);
+			return !bOverflow;
+		}
+		auto Bytes(std::vector<uint8_t>& value, uint32_t maxLength = 0xffff) -> bool
+		{
+			if (value.size() > maxLength)
+			{
+				bOverflow = true;
+				return false;
+			}
+			uint32_t len = static_cast<uint32_t>(value.size());
+			Varint(len);
+			WriteBytes(value.data(), len);
+			return !bOverflow;
+		}
+
+		/// @brief 남은 비트를 버퍼에 기록하고 기록된 바이트 수를 반환한다.
+		auto Flush() -> std::size_t
+		{
+			Align();
+			return bytePos;
+		}
+		auto GetBitsWritten() const -> std::size_t { return bytePos * 8 + scratchBits; }
+		auto GetBytesWritten() const -> std::size_t { return bytePos + (scratchBits > 0 ? 1 : 0); }
+		auto IsOverflow() const -> bool { return bOverflow; }
+	private:
+		uint8_t* const buffer;
+		const std::size_t capacity;
+		std::size_t bytePos = 0;
+		uint64_t scratch = 0;
+		uint32_t scratchBits = 0;
+		bool bOverflow = false;
+	};
+
+	/// @brief BitWriter로 기록된 데이터를 읽는 스트림. 메모리를 할당하지 않는다. (String, Bytes 제외)
+	/// @brief 데이터가 부족하거나 값이 허용 범위를 넘으면 IsOverflow()가 true가 되고 이후 읽는 값은 0이 된다.
+	class BitReader
+	{
+	public:
+		static constexpr bool IS_WRITING = false;
+		static constexpr bool IS_READING = true;
+	public:
+		explicit BitReader(core::ArrayView<const uint8_t> buffer) :
+			buffer(buffer.data()), size(buffer.size())
+		{}
+		BitReader(const uint8_t* buffer, std::size_t size) :
+			buffer(buffer), size(size)
+		{}
+
+		/// @param bits 1 ~ 32
+		auto ReadBits(uint32_t bits) -> uint32_t
+		{
+			assert(bits > 0 && bits <= 32);
+			while (scratchBits < bits)
+			{
+				if (bytePos >= size)
+				{
+					bOverflow = true;
+					return 0;
+				}
+				scratch |= static_cast<uint64_t>(buffer[bytePos++]) << scratchBits;
+				scratchBits += 8;
+			}
+			const uint32_t value = static_cast<uint32_t>(scratch) & detail::BitMask(bits);
+			scratch >>= bits;
+			scratchBits -= bits;
+			return value;
+		}
+		/// @brief 현재 바이트의 남은 비트를 버린다.
+		void Align()
+		{
+			scratch = 0;
+			scratchBits = 0;
+		}
+		/// @brief 바이트 경계에 맞춘 뒤 size 바이트를 복사 없이 가리킨다.
+		/// @return 데이터가 부족하면 nullptr
+		auto ReadBytes(std::size_t count) -> const uint8_t*
+		{
+			Align();
+			if (bytePos + count > size)
+			{
+				bOverflow = true;
+				return nullptr;
+			}
+			const uint8_t* ptr = buffer + bytePos;
+			bytePos += count;
+			return ptr;
+		}
+
+		auto Bits(uint32_t& value, uint32_t bits) -> bool { value = ReadBits(bits); return !bOverflow; }
+		auto Boolean(bool& value) -> bool { value = ReadBits(1) != 0; return !bOverflow; }
+		auto Byte(uint8_t& value) -> bool { value = static_cast<uint8_t>(ReadBits(8)); return !bOverflow; }
+		auto Varint(uint64_t& value) -> bool
+		{
+			value = 0;
+			for (uint32_t shift = 0; shift < 64; shift += 7)
+			{
+				const uint32_t byte = ReadBits(8);
+				if (bOverflow)
+					return false;
+				value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			bOverflow = true;
+			return false;
+		}
+		auto Varint(uint32_t& value) -> bool
+		{
+			uint64_t v = 0;
+			Varint(v);
+			if (v > 0xffffffffull)
+				bOverflow = true;
+			value = bOverflow ? 0 : static_cast<uint32_t>(v);
+			return !bOverflow;
+		}
+		auto Varint(int32_t& value) -> bool
+		{
+			uint32_t v = 0;
+			Varint(v);
+			value = static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+			return !bOverflow;
+		}
+		auto Float(float& value) -> bool
+		{
+			const uint32_t bits = ReadBits(32);
+			std::memcpy(&value, &bits, sizeof(float));
+			return !bOverflow;
+		}
+		auto QuantizedFloat(float& value, float min, float max, uint32_t bits) -> bool
+		{
+			value = detail::Dequantize(ReadBits(bits), min, max, bits);
+			return !bOverflow;
+		}
+		auto QuantizedVec3(glm::vec3& value, float min, float max, uint32_t bits) -> bool
+		{
+			QuantizedFloat(value.x, min, max, bits);
+			QuantizedFloat(value.y, min, max, bits);
+			return QuantizedFloat(value.z, min, max, bits);
+		}
+		auto Quaternion(glm::quat& value, uint32_t bits = 10) -> bool
+		{
+			const uint32_t largest = ReadBits(2);
+			float components[4];
+			float sum = 0.f;
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				if (i == largest)
+					continue;
+				components[i] = detail::Dequantize(ReadBits(bits), -detail::QUAT_COMPONENT_MAX, detail::QUAT_COMPONENT_MAX, bits);
+				sum += components[i] * components[i];
+			}
+			components[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+			value = glm::quat{ components[3], components[0], components[1], components[2] };
+			return !bOverflow;
+		}
+		auto String(std::string& value, uint32_t maxLength = 0xffff) -> bool
+		{
+			uint32_t len = 0;
+			if (!Varint(len) || len > maxLength)
+			{
+				bOverflow = true;
+				return false;
+			}
+			const uint8_t* data = ReadBytes(len);
+			if (data == nullptr)
+				return false;
+			value.assign(reinterpret_cast<const char*>(data), len);
+			return true;
+		}
+		auto Bytes(std::vector<uint8_t>& value, uint32_t maxLength = 0xffff) -> bool
+		{
+			uint32_t len = 0;
+			if (!Varint(len) || len > maxLength)
+			{
+				bOverflow = true;
+				return false;
+			}
+			const uint8_t* data = ReadBytes(len);
+			if (data == nullptr)
+				return false;
+			value.assign(data, data + len);
+			return true;
+		}
+
+		auto GetBytesRead() const -> std::size_t { return bytePos; }
+		auto IsOverflow() const -> bool { return bOverflow; }
+	private:
+		const uint8_t* const buffer;
+		const std::size_t size;
+		std::size_t bytePos = 0;
+		uint64_t scratch = 0;
+		uint32_t scratchBits = 0;
+		bool bOverflow = false;
+	};
+}//namespace
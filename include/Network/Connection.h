@@ -0,0 +1,223 @@
+﻿#pragma once
+#include "Export.h"
+#include "Packet.h"
+
+#include "Core/NonCopyable.h"
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+namespace sh::network
+{
+	/// @brief 데이터그램 위에서 순번, ack 비트필드, RTT 측정, 채널별 신뢰성, 분할/재조립, 송신 속도 조절을 제공하는 연결.
+	/// @brief 전송 계층과 분리돼 있어 Receive()로 받은 데이터그램을 넣고, Update()가 보낼 데이터그램을 콜백으로 내보낸다.
+	/// @brief 시간은 호출자가 초 단위로 넘겨준다. 스레드 안전하지 않다.
+	class Connection : public core::INonCopyable
+	{
+	public:
+		enum class ChannelType : uint8_t
+		{
+			/// @brief 한 번만 보낸다. 유실, 중복 제거, 순서 보장 없음
+			Unreliable,
+			/// @brief 한 번만 보낸다. 이전에 받은 것보다 오래된 메시지는 버린다.
+			UnreliableSequenced,
+			/// @brief 도착할 때 까지 재전송하며 보낸 순서대로 전달한다.
+			ReliableOrdered,
+			/// @brief 도착할 때 까지 재전송하며 도착한 순서대로 전달한다.
+			ReliableUnordered
+		};
+		struct Config
+		{
+			/// @brief 채널 번호 = 인덱스. 최대 127개
+			std::vector<ChannelType> channels{ ChannelType::Unreliable, ChannelType::UnreliableSequenced, ChannelType::ReliableOrdered, ChannelType::ReliableUnordered };
+			/// @brief 데이터그램 하나의 최대 크기. 헤더와 조각 하나가 들어갈 수 있도록 MIN_DATAGRAM_SIZE 이상으로 맞춰진다.
+			uint32_t maxDatagramSize = 1000;
+			/// @brief 이 크기를 넘는 메시지는 나눠서 보낸다.
+			uint32_t fragmentSize = 900;
+			/// @brief 메시지 하나의 최대 크기
+			uint32_t maxMessageSize = 256 * 1024;
+			/// @brief 채널당 응답을 기다리는 신뢰성 메시지의 최대 수
+			uint32_t maxReliableInFlight = 512;
+			/// @brief 동시에 재조립 중일 수 있는 메시지의 최대 수 (모든 채널 합계). 넘으면 새 메시지의 조각은 버린다.
+			uint32_t maxReassemblies = 64;
+			/// @brief 재조립 중인 조각들이 차지할 수 있는 최대 바이트 (모든 채널 합계). 넘으면 조각을 버린다.
+			uint32_t maxReassemblyBytes = 1024 * 1024;
+			/// @brief 송신 속도(바이트/초)의 시작값과 범위
+			float initialSendRate = 256.f * 1024.f;
+			float minSendRate = 16.f * 1024.f;
+			float maxSendRate = 8.f * 1024.f * 1024.f;
+			/// @brief 이 시간 동안 받은 데이터그램이 없으면 연결이 끊긴 것으로 본다.
+			double timeout = 10.0;
+			/// @brief 보낼 것이 없어도 이 간격으로 빈 데이터그램을 보낸다. (ack, RTT 측정용)
+			double keepAliveInterval = 0.1;
+		};
+		struct Stats
+		{
+			uint64_t sentDatagrams = 0;
+			uint64_t receivedDatagrams = 0;
+			uint64_t sentBytes = 0;
+			uint64_t receivedBytes = 0;
+			/// @brief 재전송된 메시지 조각 수
+			uint64_t resentFragments = 0;
+			uint64_t droppedDatagrams = 0;
+			uint64_t deliveredMessages = 0;
+		};
+		struct ReceivedMessage
+		{
+			uint8_t channel;
+			std::vector<uint8_t> data;
+		};
+		using SendFunction = std::function<void(const uint8_t* data, std::size_t size)>;
+	public:
+		SH_NET_API Connection();
+		SH_NET_API explicit Connection(const Config& config);
+		SH_NET_API ~Connection();
+
+		/// @brief 메시지를 채널에 넣는다. 실제 전송은 Update()에서 일어난다.
+		/// @return 크기가 너무 크거나 신뢰성 채널의 대기열이 가득 찼다면 false
+		SH_NET_API auto Send(uint8_t channel, const uint8_t* data, std::size_t size) -> bool;
+		/// @brief 패킷을 PacketCodec으로 인코딩해서 보낸다.
+		SH_NET_API auto Send(uint8_t channel, const Packet& packet) -> bool;
+		/// @brief 전송 계층에서 받은 데이터그램을 처리한다.
+		SH_NET_API void Receive(const uint8_t* data, std::size_t size, double now);
+		/// @brief 재전송, 송신 속도 조절, 손실 추정을 처리하고 보낼 데이터그램들을 send로 내보낸다.
+		SH_NET_API void Update(double now, const SendFunction& send);
+		/// @brief 전달 가능한 메시지들을 out 뒤에 옮긴다.
+		/// @return 옮긴 메시지 수
+		SH_NET_API auto PollMessages(std::vector<ReceivedMessage>& out) -> std::size_t;
+
+		/// @brief 초 단위 왕복 시간. 측정 전이면 0
+		auto GetRtt() const -> double { return rtt; }
+		/// @brief 0 ~ 1 사이의 데이터그램 손실률 추정값
+		auto GetPacketLoss() const -> float { return packetLoss; }
+		/// @brief 현재 송신 속도 (바이트/초)
+		auto GetSendRate() const -> float { return sendRate; }
+		auto GetStats() const -> const Stats& { return stats; }
+		auto GetConfig() const -> const Config& { return config; }
+		/// @brief 재조립 중인 메시지 수
+		auto GetReassemblyCount() const -> uint32_t { return reassemblyCount; }
+		/// @brief 재조립 중인 조각들이 차지하는 바이트
+		auto GetReassemblyBytes() const -> std::size_t { return reassemblyBytes; }
+		SH_NET_API auto IsTimedOut(double now) const -> bool;
+		/// @brief 응답을 기다리거나 아직 보내지 않은 메시지가 있는지
+		SH_NET_API auto HasPendingData() const -> bool;
+	private:
+		struct FragmentRef
+		{
+			uint8_t channel;
+			uint16_t messageId;
+			uint16_t fragmentIndex;
+		};
+		struct SentDatagram
+		{
+			uint16_t sequence = 0;
+			bool bValid = false;
+			bool bAcked = false;
+			double sendTime = 0.0;
+			std::vector<FragmentRef> fragments;
+		};
+		struct OutMessage
+		{
+			uint16_t messageId = 0;
+			std::shared_ptr<const std::vector<uint8_t>> data;
+			uint16_t fragmentCount = 1;
+			uint16_t ackedCount = 0;
+			/// @brief 조각별 마지막 전송 시간. 아직 안 보냈으면 음수
+			std::vector<double> lastSendTimes;
+			std::vector<bool> acked;
+			/// @brief 비신뢰성 메시지가 버려지는 시간
+			double expireTime = 0.0;
+		};
+		struct Reassembly
+		{
+			/// @brief 도착한 조각 중 가장 뒤에 있는 조각의 끝까지만 늘어난다.
+			std::vector<uint8_t> data;
+			std::vector<bool> received;
+			uint32_t size = 0;
+			uint16_t fragmentCount = 0;
+			uint16_t receivedCount = 0;
+			double lastTime = 0.0;
+		};
+		struct Channel
+		{
+			ChannelType type = ChannelType::Unreliable;
+			uint16_t nextSendId = 0;
+			/// @brief 신뢰성: 응답을 기다리는 메시지들 (messageId가 연속). 비신뢰성: 보낼 메시지들
+			std::deque<OutMessage> sendQueue;
+
+			/// @brief Sequenced: 마지막으로 전달한 id
+			uint16_t lastDeliveredId = 0;
+			bool bDeliveredAny = false;
+			/// @brief 신뢰성: 아직 받지 못한 가장 작은 id. 이 id부터 RECEIVE_WINDOW 안의 메시지만 받는다.
+			uint16_t nextDeliverId = 0;
+			/// @brief Ordered: 도착했지만 순서를 기다리는 메시지
+			std::vector<std::vector<uint8_t>> orderedBuffer;
+			/// @brief Ordered: 버퍼에 있는 메시지 id, Unordered: 최근에 받은 메시지 id. (id % RECEIVE_WINDOW 위치, 없으면 INVALID_ID)
+			std::vector<uint32_t> receivedIds;
+
+			std::unordered_map<uint16_t, Reassembly> reassemblies;
+		};
+	private:
+		void ProcessAck(uint16_t ack, uint32_t ackBits, double now);
+		void OnDatagramAcked(SentDatagram& datagram, double now);
+		void OnMessageReceived(uint8_t channelIdx, uint16_t messageId, std::vector<uint8_t>&& data);
+		auto IsDuplicate(const Channel& channel, uint16_t messageId) const -> bool;
+		/// @brief 신뢰성 채널이면 messageId가 받을 수 있는 범위 안에 있는지. 비신뢰성 채널은 항상 true
+		auto IsInReceiveWindow(const Channel& channel, uint16_t messageId) const -> bool;
+		/// @brief 재조립을 목록에서 빼고 모인 데이터를 반환한다.
+		auto RemoveReassembly(Channel& channel, std::unordered_map<uint16_t, Reassembly>::iterator it) -> std::vector<uint8_t>;
+		void UpdateLoss(double now);
+		void UpdateSendRate(double now);
+		/// @brief 데이터그램 하나를 채워 보낸다.
+		/// @return 보낸 데이터그램이 없으면 false
+		auto WriteDatagram(double now, bool bForce, const SendFunction& send) -> bool;
+		auto GetResendTimeout() const -> double;
+	private:
+		static constexpr uint32_t SENT_BUFFER_SIZE = 1024;
+		static constexpr uint32_t RECEIVE_WINDOW = 1024;
+		static constexpr uint32_t INVALID_ID = 0xffffffff;
+		/// @brief 순번(2) + ack 유무(1) + ack(2) + ack 비트필드(4)
+		static constexpr uint32_t HEADER_SIZE = 9;
+		/// @brief 채널(1) + 메시지 id(2) + 조각 번호, 조각 수, 길이 (각각 varint 최대 3)
+		static constexpr uint32_t BLOCK_HEADER_MAX_SIZE = 12;
+	public:
+		/// @brief 헤더와 1바이트 조각 하나가 들어가는 크기
+		static constexpr uint32_t MIN_DATAGRAM_SIZE = HEADER_SIZE + BLOCK_HEADER_MAX_SIZE + 1;
+	private:
+		Config config;
+		std::vector<Channel> channels;
+
+		std::vector<SentDatagram> sentDatagrams;
+		uint16_t nextSequence = 0;
+		uint16_t lossCheckSequence = 0;
+
+		uint16_t remoteSequence = 0;
+		uint32_t remoteAckBits = 0;
+		bool bReceivedAny = false;
+		bool bAckPending = false;
+		uint32_t unackedReceiveCount = 0;
+
+		std::vector<ReceivedMessage> delivered;
+		std::vector<uint8_t> scratch;
+		uint32_t reassemblyCount = 0;
+		std::size_t reassemblyBytes = 0;
+
+		double rtt = 0.0;
+		double rttVar = 0.0;
+		double minRtt = 0.0;
+		float packetLoss = 0.f;
+		float sendRate = 0.f;
+		double tokens = 0.0;
+		bool bRateLimited = false;
+
+		double lastUpdateTime = -1.0;
+		double lastSendTime = -1.0;
+		double lastReceiveTime = -1.0;
+		double lastRateUpdateTime = 0.0;
+
+		Stats stats;
+	};
+}//namespace
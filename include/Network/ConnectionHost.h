@@ -0,0 +1,63 @@
+﻿#pragma once
+#include "Export.h"
+#include "Connection.h"
+#include "ConnectionPacket.h"
+#include "NetworkContext.h"
+#include "Endpoint.h"
+
+#include "Core/NonCopyable.h"
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+namespace sh::network
+{
+	class UdpSocket;
+
+	/// @brief UdpSocket 하나 위에서 상대 주소별 Connection들을 관리한다.
+	/// @brief 받은 메시지 중 ConnectionPacket은 HandleMessage()로 넘기고, Update()에서 나갈 데이터그램을 소켓의 송신 묶음으로 보낸다.
+	/// @brief 게임 스레드에서만 사용한다.
+	class ConnectionHost : public core::INonCopyable
+	{
+	public:
+		struct ChannelPacket
+		{
+			Endpoint sender;
+			uint8_t channel;
+			std::unique_ptr<Packet> packet;
+		};
+	public:
+		SH_NET_API ConnectionHost(UdpSocket& socket);
+		SH_NET_API ConnectionHost(UdpSocket& socket, const Connection::Config& config);
+		SH_NET_API ~ConnectionHost();
+
+		/// @brief 상대와의 연결을 만든다. 이미 있다면 그 연결을 반환한다.
+		SH_NET_API auto Connect(const Endpoint& endpoint) -> Connection&;
+		SH_NET_API void Disconnect(const Endpoint& endpoint);
+		/// @return 없으면 nullptr
+		SH_NET_API auto GetConnection(const Endpoint& endpoint) -> Connection*;
+		SH_NET_API auto GetConnectionCount() const -> std::size_t;
+		/// @brief 모르는 주소에서 온 데이터그램으로 새 연결을 만들지 여부. 서버는 true, 클라이언트는 false
+		SH_NET_API void SetAcceptIncoming(bool bAccept);
+		/// @brief 모르는 주소에서 온 데이터그램으로 만들 수 있는 연결의 최대 수. 가득 차면 새 주소의 데이터그램은 버린다.
+		SH_NET_API void SetMaxConnections(std::size_t count);
+
+		/// @brief 소켓에서 받은 메시지가 ConnectionPacket이면 해당 연결에 넣는다.
+		/// @return 처리된 메시지라면 true. false면 일반 패킷이다.
+		SH_NET_API auto HandleMessage(const NetworkContext::Message& message, double now) -> bool;
+		/// @brief 모든 연결을 갱신하고 나갈 데이터그램을 보낸다. 시간 초과된 연결은 제거한다.
+		SH_NET_API void Update(double now);
+		/// @brief 모든 연결에서 전달 가능한 메시지를 패킷으로 만들어 out 뒤에 옮긴다.
+		/// @return 옮긴 패킷 수
+		SH_NET_API auto PollPackets(std::vector<ChannelPacket>& out) -> std::size_t;
+	private:
+		UdpSocket& socket;
+		Connection::Config config;
+		std::unordered_map<Endpoint, std::unique_ptr<Connection>> connections;
+		std::size_t maxConnections = 64;
+		bool bAcceptIncoming = false;
+
+		ConnectionPacket sendPacket;
+		std::vector<Connection::ReceivedMessage> receivedScratch;
+	};
+}//namespace
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include "Export.h"
+#include "Packet.h"
+
+#include <cstdint>
+#include <vector>
+namespace sh::network
+{
+	/// @brief Connection이 만든 데이터그램을 UdpSocket으로 실어 나르는 패킷. id 1은 이 패킷이 예약한다.
+	class ConnectionPacket : public Packet
+	{
+		SPACKET(ConnectionPacket, 1)
+		SPACKET_CODEC()
+	public:
+		static constexpr uint32_t ID = 1;
+	public:
+		SH_NET_API auto GetId() const -> uint32_t override;
+		SH_NET_API auto Serialize() const -> core::Json override;
+		SH_NET_API void Deserialize(const core::Json& json) override;
+
+		/// @brief 기존 버퍼를 재사용해서 복사한다.
+		SH_NET_API void SetPayload(const uint8_t* data, std::size_t size);
+		SH_NET_API auto GetPayload() const -> const std::vector<uint8_t>&;
+
+		template<typename Stream>
+		void Codec(Stream& stream)
+		{
+			stream.Bytes(payload, MAX_PACKET_SIZE);
+		}
+	private:
+		std::vector<uint8_t> payload;
+	};
+}//namespace
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include "Export.h"
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <string>
+#include <functional>
+namespace sh::network
+{
+	/// @brief 문자열 변환 없이 비교, 해시가 가능한 주소 + 포트. IPv4는 앞 4바이트만 사용한다.
+	struct Endpoint
+	{
+		std::array<uint8_t, 16> address{};
+		uint16_t port = 0;
+		bool bV6 = false;
+
+		/// @brief 문자열 주소로부터 만든다. 잘못된 주소면 0.0.0.0이 된다.
+		SH_NET_API static auto FromString(const std::string& ip, uint16_t port) -> Endpoint;
+		static auto FromIPv4(uint32_t hostOrderIp, uint16_t port) -> Endpoint
+		{
+			Endpoint ep{};
+			ep.address[0] = static_cast<uint8_t>(hostOrderIp >> 24);
+			ep.address[1] = static_cast<uint8_t>(hostOrderIp >> 16);
+			ep.address[2] = static_cast<uint8_t>(hostOrderIp >> 8);
+			ep.address[3] = static_cast<uint8_t>(hostOrderIp);
+			ep.port = port;
+			return ep;
+		}
+		/// @brief 주소를 문자열로 변환한다. 로그, 표시용
+		SH_NET_API auto GetIp() const -> std::string;
+		auto GetPort() const -> uint16_t { return port; }
+
+		auto operator==(const Endpoint& other) const -> bool
+		{
+			return port == other.port && bV6 == other.bV6 && address == other.address;
+		}
+		auto operator!=(const Endpoint& other) const -> bool { return !operator==(other); }
+	};
+}//namespace
+
+namespace std
+{
+	template<>
+	struct hash<sh::network::Endpoint>
+	{
+		auto operator()(const sh::network::Endpoint& ep) const -> std::size_t
+		{
+			uint64_t lo, hi;
+			std::memcpy(&lo, ep.address.data(), sizeof(uint64_t));
+			std::memcpy(&hi, ep.address.data() + 8, sizeof(uint64_t));
+			uint64_t h = lo * 0x9E3779B97F4A7C15ull;
+			h ^= hi + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+			h ^= (static_cast<uint64_t>(ep.port) << 1 | (ep.bV6 ? 1 : 0)) * 0xC2B2AE3D27D4EB4Full;
+			return static_cast<std::size_t>(h ^ (h >> 29));
+		}
+	};
+}//namespace
@@ -0,0 +1,95 @@
+﻿#pragma once
+#include "Export.h"
+#include "Packet.h"
+#include "Endpoint.h"
+
+#include "Core/NonCopyable.h"
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+namespace sh::network
+{
+	/// @brief 한 프레임 동안 상대별로 보낼 메시지들을 모아 maxDatagramSize 이하의 데이터그램으로 묶는다.
+	/// @brief 압축을 쓰면 압축한 결과가 maxDatagramSize에 들어가는 동안 원본은 그보다 커질 수 있다.
+	/// @brief 형식: 매직(2바이트) + [압축했다면 원본 크기(varint)] + (길이(varint) + 메시지)의 반복. 압축은 본문에 LZ4를 쓴다.
+	/// @brief 첫 바이트는 PacketCodec과 같고 둘째 바이트가 달라서 받는 쪽은 IsBatch()로 일반 패킷과 구분한다. 스레드 안전하지 않다.
+	class MessageBatcher : public core::INonCopyable
+	{
+	public:
+		static constexpr uint8_t MAGIC_RAW = 0xB2;
+		static constexpr uint8_t MAGIC_LZ4 = 0xB3;
+		/// @brief 압축을 풀었을 때 허용하는 최대 크기
+		static constexpr uint32_t MAX_UNPACKED_SIZE = 64 * 1024;
+
+		struct Config
+		{
+			/// @brief 데이터그램 하나의 최대 크기
+			uint32_t maxDatagramSize = Packet::MAX_PACKET_SIZE;
+			bool bCompress = true;
+			/// @brief 본문이 이 크기 이상일 때만 압축해서 보낸다. 압축해서 작아지지 않으면 그대로 보낸다.
+			uint32_t compressThreshold = 256;
+		};
+		struct Stats
+		{
+			uint64_t messages = 0;
+			uint64_t datagrams = 0;
+			uint64_t compressedDatagrams = 0;
+			/// @brief 압축 전 데이터그램 크기의 합
+			uint64_t rawBytes = 0;
+			uint64_t sentBytes = 0;
+		};
+		using SendFunction = std::function<void(const Endpoint& peer, const uint8_t* data, std::size_t size)>;
+		using MessageFunction = std::function<void(const uint8_t* data, std::size_t size)>;
+	public:
+		SH_NET_API MessageBatcher();
+		SH_NET_API explicit MessageBatcher(const Config& config);
+
+		/// @brief 상대에게 보낼 메시지를 현재 데이터그램 뒤에 붙인다. 자리가 없으면 새 데이터그램을 시작한다.
+		/// @return 데이터그램 하나에 들어가지 않는 크기라면 false
+		SH_NET_API auto Add(const Endpoint& peer, const uint8_t* data, std::size_t size) -> bool;
+		/// @brief 패킷을 PacketCodec::EncodeAny()로 인코딩해서 붙인다.
+		SH_NET_API auto Add(const Endpoint& peer, const Packet& packet) -> bool;
+		/// @brief 모아둔 데이터그램들을 마무리해서 send로 내보낸다. 보통 프레임 끝에 한 번 호출한다.
+		/// @return 보낸 데이터그램 수
+		SH_NET_API auto Flush(const SendFunction& send) -> std::size_t;
+		/// @brief 상대의 보내지 않은 메시지와 버퍼를 버린다.
+		SH_NET_API void RemovePeer(const Endpoint& peer);
+
+		/// @brief MessageBatcher로 만들어진 데이터그램인지 확인한다.
+		SH_NET_API static auto IsBatch(const uint8_t* data, std::size_t size) -> bool;
+		/// @brief 데이터그램을 메시지들로 나눠 차례대로 fn을 호출한다. 넘겨지는 포인터는 data(압축했다면 scratch)의 일부다.
+		/// @return 형식이 잘못됐다면 false. 잘못된 곳 전까지의 메시지는 이미 전달됐다.
+		SH_NET_API static auto Unpack(const uint8_t* data, std::size_t size, std::vector<uint8_t>& scratch, const MessageFunction& fn) -> bool;
+
+		auto GetConfig() const -> const Config& { return config; }
+		auto GetStats() const -> const Stats& { return stats; }
+	private:
+		struct Peer
+		{
+			/// @brief 앞의 count개가 사용 중이다. 나머지는 재사용을 위해 남겨둔 버퍼
+			std::vector<std::vector<uint8_t>> datagrams;
+			std::size_t count = 0;
+			/// @brief 마지막 데이터그램에 더 붙일 수 있다고 보장되는 바이트 수
+			uint32_t room = 0;
+		};
+		/// @brief 마지막 데이터그램에 blockSize 바이트를 더 붙여도 보낼 수 있는지 확인한다. 필요하면 압축해서 남은 자리를 다시 잰다.
+		auto Fits(Peer& peer, uint32_t blockSize) -> bool;
+		/// @brief 데이터그램의 본문을 압축해서 compressBuffer에 압축된 데이터그램을 만든다.
+		/// @return 압축 결과가 원본보다 크거나 maxDatagramSize에 들어가지 않으면 false
+		auto Compress(const std::vector<uint8_t>& datagram) -> bool;
+		/// @brief 압축해도 들어가지 않는 데이터그램을 압축하지 않은 데이터그램들로 나눠 보낸다.
+		/// @return 보낸 데이터그램 수
+		auto SendSplit(const Endpoint& peer, const std::vector<uint8_t>& datagram, const SendFunction& send) -> std::size_t;
+	private:
+		static constexpr uint32_t HEADER_SIZE = 2;
+
+		Config config;
+		Stats stats;
+
+		std::unordered_map<Endpoint, Peer> peers;
+		std::vector<uint8_t> encodeBuffer;
+		std::vector<uint8_t> compressBuffer;
+	};
+}//namespace
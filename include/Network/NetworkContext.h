@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Export.h"
 #include "Packet.h"
+#include "Endpoint.h"
 
 #include <memory>
 #include <string>
@@ -19,8 +20,7 @@ namespace sh::network
 	public:
 		struct Message
 		{
-			std::string senderIp;
-			uint16_t senderPort;
+			Endpoint sender;
 			std::unique_ptr<Packet> packet;
 		};
 	private:
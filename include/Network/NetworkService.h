@@ -0,0 +1,69 @@
+﻿#pragma once
+#include "Export.h"
+#include "NetworkContext.h"
+
+#include "Core/Singleton.hpp"
+#include "Core/LockFreeMPSCQueue.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+namespace sh::network
+{
+	/// @brief 프로세스 전체가 공유하는 네트워크 서비스.
+	/// @brief 하나의 io_context를 고정된 수의 스레드가 실행하며, 작업이 없어도 스레드는 바쁜 대기 없이 잠든다.
+	/// @brief 소켓들이 받은 메시지는 Post()로 락 없는 큐에 쌓이고, 게임 스레드에서 프레임마다 Dispatch()로 수신자에게 전달된다.
+	class NetworkService : public core::Singleton<NetworkService>
+	{
+		friend core::Singleton<NetworkService>;
+	public:
+		using ReceiverId = uint32_t;
+		using Receiver = std::function<void(std::vector<NetworkContext::Message>& messages)>;
+		static constexpr ReceiverId INVALID_RECEIVER = 0;
+	public:
+		/// @brief 네트워크 스레드들을 시작한다. 이미 실행 중이면 무시된다.
+		/// @param threadCount 스레드 수. 0이면 코어 수에 맞춰 정한다. (최대 2)
+		SH_NET_API void Start(uint32_t threadCount = 0);
+		/// @brief 스레드들을 멈추고 기다린다. 남아 있는 비동기 작업은 다음 Start() 때 이어서 실행된다.
+		SH_NET_API void Stop();
+		SH_NET_API auto IsRunning() const -> bool;
+		SH_NET_API auto GetThreadCount() const -> uint32_t;
+		SH_NET_API auto GetContext() -> NetworkContext& { return ctx; }
+
+		/// @brief 수신자를 등록한다. 게임 스레드에서 호출해야 한다.
+		SH_NET_API auto RegisterReceiver(Receiver&& receiver) -> ReceiverId;
+		/// @brief 수신자를 해제한다. 아직 전달되지 않은 메시지는 버려진다. 게임 스레드에서 호출해야 한다.
+		SH_NET_API void UnregisterReceiver(ReceiverId id);
+		/// @brief 메시지 묶음을 수신자에게 보낸다. 아무 스레드에서나 호출 할 수 있다.
+		SH_NET_API void Post(ReceiverId id, std::vector<NetworkContext::Message>&& messages);
+		/// @brief 쌓인 메시지 묶음들을 수신자에게 전달한다. 게임 스레드에서 프레임마다 호출한다.
+		/// @return 전달한 메시지 수
+		SH_NET_API auto Dispatch() -> std::size_t;
+	protected:
+		SH_NET_API NetworkService();
+		SH_NET_API ~NetworkService();
+	private:
+		struct Delivery
+		{
+			ReceiverId id;
+			std::vector<NetworkContext::Message> messages;
+		};
+		struct Impl;
+	private:
+		NetworkContext ctx;
+		std::unique_ptr<Impl> impl;
+
+		std::vector<std::thread> threads;
+		mutable std::mutex threadMu;
+
+		core::LockFreeMPSCQueue<Delivery> deliveries;
+		std::unordered_map<ReceiverId, Receiver> receivers;
+		std::vector<ReceiverId> pendingUnregister;
+		ReceiverId nextReceiverId = 1;
+		bool bDispatching = false;
+	};
+}//namespace
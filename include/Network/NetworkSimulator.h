@@ -0,0 +1,84 @@
+﻿#pragma once
+#include "Export.h"
+
+#include "Core/NonCopyable.h"
+
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <functional>
+namespace sh::network
+{
+	/// @brief 단방향 링크를 흉내 내서 지연, 지터, 손실, 중복, 순서 뒤바뀜을 넣는다.
+	/// @brief 같은 시드와 같은 입력 순서라면 어느 플랫폼에서든 같은 데이터그램이 같은 순서로 버려지고 도착한다.
+	/// @brief 시간은 호출자가 초 단위로 넘겨준다. 데이터 버퍼는 재사용하므로 처음 이후에는 할당이 거의 없다. 스레드 안전하지 않다.
+	class NetworkSimulator : public core::INonCopyable
+	{
+	public:
+		struct Settings
+		{
+			/// @brief 편도 지연 (초)
+			double latency = 0.0;
+			/// @brief 지연에 더해지는 0 ~ jitter 사이의 값 (초)
+			double jitter = 0.0;
+			/// @brief 0 ~ 1 확률
+			float loss = 0.f;
+			float duplicate = 0.f;
+			/// @brief reorderDelay만큼 더 늦게 도착해서 뒤에 보낸 데이터그램에 추월당할 확률
+			float reorder = 0.f;
+			double reorderDelay = 0.01;
+			/// @brief true면 손실, 중복, 순서 뒤바뀜을 무시하고 보낸 순서대로 지연만 준다. (TCP 같은 스트림)
+			bool bStream = false;
+			uint32_t seed = 1;
+		};
+		struct Stats
+		{
+			uint64_t submitted = 0;
+			uint64_t dropped = 0;
+			uint64_t duplicated = 0;
+			uint64_t reordered = 0;
+			uint64_t delivered = 0;
+		};
+		using DeliverFunction = std::function<void(const uint8_t* data, std::size_t size)>;
+	public:
+		SH_NET_API NetworkSimulator();
+		SH_NET_API explicit NetworkSimulator(const Settings& settings);
+
+		/// @brief 데이터그램을 링크에 넣는다.
+		SH_NET_API void Submit(const uint8_t* data, std::size_t size, double now);
+		/// @brief now까지 도착한 데이터그램들을 도착 시간 순서대로 deliver로 내보낸다.
+		/// @return 내보낸 수
+		SH_NET_API auto Poll(double now, const DeliverFunction& deliver) -> std::size_t;
+		/// @brief 링크에 있는 데이터그램을 모두 버리고 난수 상태를 처음으로 되돌린다.
+		SH_NET_API void Reset();
+
+		/// @brief 다음 데이터그램이 도착하는 시간. 없으면 음수
+		SH_NET_API auto GetNextArriveTime() const -> double;
+		auto GetInFlightCount() const -> std::size_t { return inFlight.size(); }
+		auto GetSettings() const -> const Settings& { return settings; }
+		auto GetStats() const -> const Stats& { return stats; }
+	private:
+		struct InFlight
+		{
+			double arriveTime;
+			/// @brief 같은 시간에 도착하면 넣은 순서대로
+			uint64_t order;
+			std::vector<uint8_t> data;
+		};
+		/// @brief 0 이상 1 미만. 표준 분포 클래스는 구현마다 결과가 달라서 직접 만든다.
+		auto NextUnit() -> double;
+		void Push(const uint8_t* data, std::size_t size, double arriveTime);
+		static auto IsLater(const InFlight& a, const InFlight& b) -> bool;
+	private:
+		Settings settings;
+		Stats stats;
+
+		std::mt19937 rng;
+		/// @brief arriveTime 기준 최소 힙
+		std::vector<InFlight> inFlight;
+		std::vector<std::vector<uint8_t>> bufferPool;
+		uint64_t nextOrder = 0;
+		/// @brief 순서를 지키는 데이터그램의 마지막 도착 시간. 지터만으로는 순서가 바뀌지 않는다.
+		double lastArriveTime = 0.0;
+	};
+}//namespace
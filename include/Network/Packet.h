@@ -1,11 +1,13 @@
 ﻿#pragma once
 #include "Export.h"
+#include "BitStream.hpp"
 
 #include "Core/ISerializable.h"
 #include "Core/Factory.hpp"
 #include "Core/UUID.h"
 
 #include <cstdint>
+#include <type_traits>
 
 #define SPACKET(PacketClass, id)\
 struct PacketRegister##PacketClass\
@@ -37,6 +39,18 @@ struct PacketRegister##PacketClass\
 };\
 static inline PacketRegister##PacketClass* _packetRegister = PacketRegister##PacketClass::Get();
 
+/// @brief 패킷의 바이너리 코덱을 선언한다. 클래스에는 필드를 한 번만 나열하는 멤버 함수 템플릿
+/// @brief template<typename Stream> void Codec(Stream& stream)이 있어야 하며, 이 함수가 BitWriter와 BitReader로 각각 인스턴스화 된다.
+#define SPACKET_CODEC()\
+public:\
+	auto HasBinaryCodec() const -> bool override { return true; }\
+	void Encode(sh::network::BitWriter& writer) const override\
+	{\
+		using Self = std::remove_const_t<std::remove_pointer_t<decltype(this)>>;\
+		const_cast<Self*>(this)->Codec(writer);\
+	}\
+	void Decode(sh::network::BitReader& reader) override { Codec(reader); }
+
 namespace sh::network
 {
 	class Packet : public core::ISerializable
@@ -53,6 +67,12 @@ namespace sh::network
 
 		SH_NET_API auto Serialize() const->core::Json override;
 		SH_NET_API void Deserialize(const core::Json& json) override;
+
+		/// @brief SPACKET_CODEC()으로 바이너리 코덱을 선언했는지. 코덱이 없는 패킷은 Json(BSON)으로 전송된다.
+		virtual auto HasBinaryCodec() const -> bool { return false; }
+		/// @brief 바이너리 코덱으로 필드를 기록한다. packetUUID는 기록되지 않는다.
+		virtual void Encode(BitWriter& writer) const {}
+		virtual void Decode(BitReader& reader) {}
 	private:
 		core::UUID packetUUID;
 	};
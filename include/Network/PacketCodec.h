@@ -0,0 +1,39 @@
+﻿#pragma once
+#include "Export.h"
+#include "Packet.h"
+
+#include "Core/ArrayView.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+namespace sh::network
+{
+	/// @brief 바이너리 코덱을 가진 패킷을 바이트 배열로 변환한다.
+	/// @brief 형식: 매직(2바이트) + 패킷 id(varint) + Packet::Encode()로 기록된 필드
+	class PacketCodec
+	{
+	public:
+		static constexpr uint8_t MAGIC0 = 0x53;
+		static constexpr uint8_t MAGIC1 = 0xB1;
+	public:
+		/// @brief 패킷을 out에 기록한다.
+		/// @return 기록된 바이트 수. 코덱이 없거나 버퍼가 부족하면 0
+		SH_NET_API static auto Encode(const Packet& packet, core::ArrayView<uint8_t> out) -> std::size_t;
+		/// @brief 바이너리 코덱으로 만들어진 데이터인지 확인한다.
+		SH_NET_API static auto IsBinary(const uint8_t* data, std::size_t size) -> bool;
+		/// @brief 데이터를 읽어 Packet::Factory로 패킷을 만든다.
+		/// @return 등록되지 않은 id거나 데이터가 잘못됐다면 nullptr
+		SH_NET_API static auto Decode(const uint8_t* data, std::size_t size) -> std::unique_ptr<Packet>;
+		/// @brief 이미 있는 패킷 객체에 데이터를 읽어 들인다. 할당이 일어나지 않는다.
+		/// @return id가 다르거나 데이터가 잘못됐다면 false
+		SH_NET_API static auto Decode(const uint8_t* data, std::size_t size, Packet& packet) -> bool;
+
+		/// @brief 코덱이 있으면 바이너리로, 없으면 BSON으로 out에 기록한다.
+		/// @return 실패하면 false
+		SH_NET_API static auto EncodeAny(const Packet& packet, std::vector<uint8_t>& out) -> bool;
+		/// @brief 바이너리 또는 BSON 데이터로 패킷을 만든다. 실패 원인은 로그로 남긴다.
+		/// @return 실패하면 nullptr
+		SH_NET_API static auto DecodeAny(const uint8_t* data, std::size_t size) -> std::unique_ptr<Packet>;
+	};
+}//namespace
@@ -8,6 +8,10 @@ namespace sh::network
 	class StringPacket : public Packet
 	{
 		SPACKET(StringPacket, 0)
+		SPACKET_CODEC()
+	public:
+		/// @brief 문자열의 최대 길이. 코덱 헤더를 더해도 TcpSocket::MAX_BODY_SIZE(1MiB) 안에 들어가는 크기
+		static constexpr uint32_t MAX_LENGTH = 1 * 1024 * 1024 - 16;
 	public:
 		SH_NET_API auto GetId() const -> uint32_t override;
 		SH_NET_API auto Serialize() const -> core::Json override;
@@ -16,6 +20,12 @@ namespace sh::network
 		SH_NET_API void SetString(const std::string& str);
 		SH_NET_API void SetString(std::string&& str);
 		SH_NET_API auto GetString() const -> const std::string&;
+
+		template<typename Stream>
+		void Codec(Stream& stream)
+		{
+			stream.String(str, MAX_LENGTH);
+		}
 	private:
 		std::string str;
 	};
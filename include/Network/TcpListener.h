@@ -17,7 +17,10 @@ namespace sh::network
 		SH_NET_API TcpListener(const NetworkContext& ctx);
 		SH_NET_API ~TcpListener();
 
+		/// @param port 포트, 0이면 OS에서 지정해준다.
 		SH_NET_API auto Listen(uint16_t port) -> bool;
+		/// @return 열려 있지 않다면 0
+		SH_NET_API auto GetLocalPort() const -> uint16_t;
 
 		SH_NET_API auto GetJoinedSocket() -> std::optional<TcpSocket>;
 	private:
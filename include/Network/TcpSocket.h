@@ -3,19 +3,28 @@
 #include "NetworkContext.h"
 #include "Packet.h"
 #include "MessageQueue.h"
+#include "Endpoint.h"
 
 #include "Core/EventBus.h"
 
 #include <memory>
 #include <array>
 #include <vector>
-#include <deque>
 #include <mutex>
 namespace sh::network
 {
+	/// @brief 길이 헤더(4바이트, 리틀엔디안) + 본문 형식으로 패킷을 주고 받는 TCP 소켓.
+	/// @brief 바이너리 코덱을 가진 패킷은 헤더의 최상위 비트(BINARY_FLAG)를 세우고 PacketCodec 형식으로 보낸다.
+	/// @brief Send()는 본문을 재사용 버퍼에 기록해 두기만 하고, 네트워크 스레드가 그 사이 쌓인 메시지들을 헤더와 본문 버퍼 목록으로 묶어 async_write 한 번에 보낸다.
+	/// @brief 수신은 큰 버퍼 하나에 읽을 수 있는 만큼 읽어 그 안의 메시지들을 복사 없이 해석한다.
 	class TcpSocket
 	{
 		friend class TcpListener;
+	public:
+		static constexpr uint32_t BINARY_FLAG = 0x80000000u;
+		static constexpr uint32_t MAX_BODY_SIZE = 1 * 1024 * 1024;
+		/// @brief 수신 버퍼의 기본 크기. 더 큰 메시지가 오면 그 메시지가 들어갈 만큼 늘어난다.
+		static constexpr uint32_t RECV_BUFFER_SIZE = 64 * 1024;
 	public:
 		SH_NET_API TcpSocket(const NetworkContext& ctx);
 		SH_NET_API TcpSocket(TcpSocket&& other) noexcept;
@@ -24,6 +33,7 @@ namespace sh::network
 		SH_NET_API auto operator=(TcpSocket&& other) noexcept -> TcpSocket&;
 
 		SH_NET_API void Connect(const std::string& ip, uint16_t port);
+		/// @brief 메시지를 송신 대기열에 넣는다. 같은 틱에 넣은 메시지들은 네트워크 스레드에서 한 번에 보내진다. 스레드 안전하다.
 		SH_NET_API void Send(const Packet& packet);
 		SH_NET_API void SendBlocking(const Packet& packet);
 		SH_NET_API void Close();
@@ -36,12 +46,29 @@ namespace sh::network
 		SH_NET_API auto GetIp() const -> const std::string& { return ip; }
 		SH_NET_API auto GetPort() const-> uint16_t { return port; }
 		SH_NET_API auto IsOpen() const -> bool;
+	private:
+		struct Frame
+		{
+			std::array<uint8_t, 4> header;
+			std::vector<uint8_t> body;
+		};
 	private:
 		explicit TcpSocket(void* nativeSocketPtr);
 
+		/// @brief 패킷의 헤더와 본문을 frame에 기록한다. 본문은 재사용 버퍼를 쓴다.
+		/// @return 실패하면 false
+		auto MakeFrame(const Packet& packet, Frame& frame) -> bool;
+		auto AcquireBuffer() -> std::vector<uint8_t>;
+		/// @brief mu를 잡은 상태에서 호출해야 한다.
+		void ReleaseBuffer(std::vector<uint8_t>&& buffer);
+
+		/// @brief 대기 중인 메시지들을 모아 보낸다. 네트워크 스레드에서만 호출된다.
 		void WriteNext();
-		void ReadHeader();
-		void ReadBody();
+		void Read();
+		/// @brief 수신 버퍼에 모인 완성된 메시지들을 처리하고 남은 부분을 앞으로 당긴다.
+		/// @return 잘못된 헤더를 받았다면 false
+		auto ProcessReceived() -> bool;
+		void OnMessage(const uint8_t* data, uint32_t size, bool bBinary);
 	public:
 		core::EventBus bus;
 	private:
@@ -51,9 +78,17 @@ namespace sh::network
 		std::string ip;
 		uint16_t port = 0;
 
-		std::array<uint8_t, 4> header{};
-		std::vector<uint8_t> body;
-		std::deque<std::vector<uint8_t>> sendQueue;
+		Endpoint remoteEndpoint;
+		std::vector<uint8_t> recvBuffer;
+		std::size_t recvSize = 0;
+
+		/// @brief Send()로 쌓인 메시지들. 다음 쓰기에서 한 번에 나간다.
+		std::vector<Frame> pendingFrames;
+		/// @brief 쓰는 중인 메시지들. 쓰기가 끝날 때 까지 바뀌지 않는다.
+		std::vector<Frame> writingFrames;
+		std::vector<std::vector<uint8_t>> bufferPool;
+		/// @brief 쓰기가 예약됐거나 진행 중
+		bool bWriting = false;
 
 		std::shared_ptr<MessageQueue> receivedQueue;
 
@@ -2,16 +2,25 @@
 #include "Export.h"
 #include "NetworkContext.h"
 #include "Packet.h"
+#include "Endpoint.h"
 
 #include <memory>
 #include <array>
-#include <queue>
-#include <mutex>
-#include <optional>
+#include <vector>
+#include <functional>
 namespace sh::network
 {
+	/// @brief UDP 소켓. 받은 데이터그램은 미리 할당된 수신 슬롯 링에 모아 한 번에 해석하고, 메시지는 묶음 단위로 게임 스레드에 넘긴다.
+	/// @brief 리눅스에서는 recvmmsg/sendmmsg로 시스템 콜 한 번에 여러 데이터그램을 주고 받는다.
+	/// @brief 수신 상태는 비동기 핸들러와 공유되므로 다른 스레드가 컨텍스트를 실행 중이어도 소켓을 파괴할 수 있다.
 	class UdpSocket
 	{
+	public:
+		using ReceiveCallback = std::function<void(std::vector<NetworkContext::Message>&& messages)>;
+		/// @brief 시스템 콜 한 번에 받을 수 있는 최대 데이터그램 수 (수신 슬롯 수)
+		static constexpr uint32_t RECV_BATCH = 64;
+		/// @brief Flush() 없이 쌓아 둘 수 있는 최대 송신 데이터그램 수. 넘치면 자동으로 Flush()된다.
+		static constexpr uint32_t SEND_BATCH = 64;
 	public:
 		SH_NET_API UdpSocket(const NetworkContext& ctx);
 		SH_NET_API UdpSocket(UdpSocket&& other) noexcept;
@@ -23,21 +32,39 @@ namespace sh::network
 		/// @param port 포트, 0이면 OS에서 지정해준다.
 		/// @return 성공 여부
 		SH_NET_API auto Bind(uint16_t port = 0) -> bool;
+		/// @brief 네트워크 스레드에서 소켓을 닫고 끝날 때 까지 기다린다. 반환 후에는 수신 콜백이 호출되지 않는다.
 		SH_NET_API void Close();
+		/// @brief 즉시 전송한다.
 		SH_NET_API void Send(const Packet& packet, const std::string& ip, uint16_t port);
+		SH_NET_API void Send(const Packet& packet, const Endpoint& endpoint);
+		/// @brief 패킷을 송신 슬롯에 기록만 해두고 Flush()에서 한 번에 보낸다. Flush()와 같은 스레드에서 호출해야 한다.
+		/// @return 인코딩에 실패하면 false
+		SH_NET_API auto Enqueue(const Packet& packet, const Endpoint& endpoint) -> bool;
+		/// @brief 이미 인코딩된 데이터그램을 송신 슬롯에 기록한다. (예: 중계, 네트워크 시뮬레이션)
+		/// @return Packet::MAX_PACKET_SIZE보다 크면 false
+		SH_NET_API auto Enqueue(const uint8_t* data, std::size_t size, const Endpoint& endpoint) -> bool;
+		/// @brief Enqueue()로 쌓인 데이터그램들을 보낸다.
+		/// @return 보낸 데이터그램 수
+		SH_NET_API auto Flush() -> std::size_t;
 
-		SH_NET_API auto GetReceivedMessage() -> std::optional<NetworkContext::Message>;
+		/// @brief 지금까지 받은 메시지들을 out 뒤에 옮긴다. 락은 한 번만 잡는다.
+		/// @return 옮긴 메시지 수
+		SH_NET_API auto GetReceivedMessages(std::vector<NetworkContext::Message>& out) -> std::size_t;
+		/// @brief 받은 메시지 묶음을 쌓아두지 않고 네트워크 스레드에서 바로 callback으로 넘긴다. (예: NetworkService::Post)
+		/// @brief nullptr이면 다시 GetReceivedMessages()로 가져가는 방식이 된다.
+		/// @brief 콜백은 수신 목록의 락 없이 호출되지만 교체와는 직렬화되므로, 콜백 안에서 SetReceiveCallback()을 부르면 안 된다.
+		SH_NET_API void SetReceiveCallback(ReceiveCallback&& callback);
 
 		SH_NET_API auto IsOpen() const -> bool;
-	private:
-		void Receive();
+		SH_NET_API auto GetLocalPort() const -> uint16_t;
 	private:
 		struct Impl;
-		std::unique_ptr<Impl> impl;
-
-		std::array<uint8_t, Packet::MAX_PACKET_SIZE> buffer;
-		std::queue<NetworkContext::Message> receivedMessage;
+		std::shared_ptr<Impl> impl;
 
-		std::mutex mu;
+		/// @brief SEND_BATCH개의 송신 슬롯
+		std::vector<uint8_t> sendSlots;
+		std::array<uint32_t, SEND_BATCH> sendSizes{};
+		std::array<Endpoint, SEND_BATCH> sendEndpoints{};
+		uint32_t sendCount = 0;
 	};
-}//namespace
\ No newline at end of file
+}//namespace
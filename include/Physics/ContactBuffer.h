@@ -0,0 +1,73 @@
+﻿#pragma once
+#include "Export.h"
+#include "ContactPoint.h"
+
+#include "Core/ArrayView.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+namespace sh::phys
+{
+	/// @brief 스텝에서 발생한 충돌/트리거 쌍과 접촉점을 SoA 형태로 담는 버퍼.
+	/// @brief 리스너가 한 번 채우고 게임 쪽은 인덱스와 뷰로만 읽는다. 버퍼는 재사용되므로 정상 상태에서는 할당이 일어나지 않는다.
+	/// @brief 강체와 충돌체는 PhysWorld에 등록할 때 받은 안정적인 인덱스로 기록된다.
+	class ContactBuffer
+	{
+	public:
+		enum class PairType : uint8_t
+		{
+			CollisionEnter,
+			CollisionStay,
+			CollisionExit,
+			TriggerEnter,
+			TriggerExit
+		};
+		static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+	public:
+		/// @brief 버퍼를 비우고 세대를 올린다. 이전 세대를 가리키는 뷰는 더 이상 유효하지 않다.
+		SH_PHYS_API void Clear();
+		/// @brief 쌍을 추가한다. 이후 AddContact()로 추가하는 접촉점은 이 쌍에 속한다.
+		SH_PHYS_API void AddPair(PairType type, uint32_t body1Idx, uint32_t body2Idx, uint32_t collider1Idx, uint32_t collider2Idx);
+		SH_PHYS_API void AddContact(const glm::vec3& localPointOnCollider1, const glm::vec3& localPointOnCollider2, const glm::vec3& worldNormal, float penetrationDepth);
+		/// @brief 다른 버퍼의 내용을 뒤에 이어 붙인다. 세대는 바뀌지 않는다.
+		SH_PHYS_API void Append(const ContactBuffer& other);
+
+		auto GetPairCount() const -> uint32_t { return static_cast<uint32_t>(types.size()); }
+		auto GetContactCount() const -> uint32_t { return static_cast<uint32_t>(worldNormals.size()); }
+		auto GetGeneration() const -> uint64_t { return generation; }
+
+		auto GetTypes() const -> core::ArrayView<const PairType> { return { types.data(), types.size() }; }
+		auto GetBody1Idxs() const -> core::ArrayView<const uint32_t> { return { body1Idxs.data(), body1Idxs.size() }; }
+		auto GetBody2Idxs() const -> core::ArrayView<const uint32_t> { return { body2Idxs.data(), body2Idxs.size() }; }
+		auto GetCollider1Idxs() const -> core::ArrayView<const uint32_t> { return { collider1Idxs.data(), collider1Idxs.size() }; }
+		auto GetCollider2Idxs() const -> core::ArrayView<const uint32_t> { return { collider2Idxs.data(), collider2Idxs.size() }; }
+		auto GetContactBegins() const -> core::ArrayView<const uint32_t> { return { contactBegins.data(), contactBegins.size() }; }
+		auto GetContactCounts() const -> core::ArrayView<const uint32_t> { return { contactCounts.data(), contactCounts.size() }; }
+
+		/// @brief [begin, begin + count) 범위의 접촉점 뷰. 버퍼가 바뀌기 전까지만 유효하다.
+		auto GetLocalPointsOnCollider1(uint32_t begin, uint32_t count) const -> core::ArrayView<const glm::vec3> { return { localPointsOnCollider1.data() + begin, count }; }
+		auto GetLocalPointsOnCollider2(uint32_t begin, uint32_t count) const -> core::ArrayView<const glm::vec3> { return { localPointsOnCollider2.data() + begin, count }; }
+		auto GetWorldNormals(uint32_t begin, uint32_t count) const -> core::ArrayView<const glm::vec3> { return { worldNormals.data() + begin, count }; }
+		auto GetPenetrationDepths(uint32_t begin, uint32_t count) const -> core::ArrayView<const float> { return { penetrationDepths.data() + begin, count }; }
+
+		SH_PHYS_API auto GetContactPoint(uint32_t contactIdx) const -> ContactPoint;
+	private:
+		// 쌍
+		std::vector<PairType> types;
+		std::vector<uint32_t> body1Idxs;
+		std::vector<uint32_t> body2Idxs;
+		std::vector<uint32_t> collider1Idxs;
+		std::vector<uint32_t> collider2Idxs;
+		std::vector<uint32_t> contactBegins;
+		std::vector<uint32_t> contactCounts;
+		// 접촉점
+		std::vector<glm::vec3> localPointsOnCollider1;
+		std::vector<glm::vec3> localPointsOnCollider2;
+		std::vector<glm::vec3> worldNormals;
+		std::vector<float> penetrationDepths;
+
+		uint64_t generation = 0;
+	};
+}//namespace
@@ -3,15 +3,19 @@
 #include "Ray.h"
 #include "HitPoint.h"
 #include "CollisionTag.hpp"
+#include "PhysicsQuery.h"
+#include "ContactBuffer.h"
 
-#include "Core/EventBus.h"
+#include "Core/ArrayView.hpp"
 
 #include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <memory>
 #include <optional>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 namespace sh::phys
 {
 	class PhysWorld
@@ -19,6 +23,15 @@ namespace sh::phys
 	public:
 		using ContextHandle = void*;
 		using PhysicsWorldHandle = void*;
+		/// @brief 스텝이 끝난 시점의 강체 상태. 비동기 스텝 도중 게임 스레드에서 읽는 용도.
+		struct BodyState
+		{
+			glm::vec3 position;
+			glm::quat rotation;
+			glm::vec3 linearVelocity;
+			glm::vec3 angularVelocity;
+			bool bSleeping = false;
+		};
 	public:
 		SH_PHYS_API PhysWorld();
 		SH_PHYS_API PhysWorld(PhysWorld&& other) noexcept;
@@ -28,16 +41,75 @@ namespace sh::phys
 
 		SH_PHYS_API void Update(float deltaTime);
 
-		SH_PHYS_API auto RayCastHit(const Ray& ray, Tagbit allowedTag = 0xffff) const -> bool;
-		SH_PHYS_API auto RayCast(const Ray& ray, Tagbit allowedTag = 0xffff) const -> std::vector<HitPoint>;
+		/// @brief 비동기 스텝 모드를 설정한다. 켜져 있으면 BeginStep()으로 시작한 스텝이 스레드 풀에서 진행되는 동안
+		/// @brief 게임 스레드는 이전 스텝의 결과(스냅샷)로 게임플레이를 진행한다.
+		/// @brief 충돌 쌍은 스텝 전용 버퍼에 기록됐다가 EndStep()에서 GetContacts() 버퍼로 옮겨진다.
+		SH_PHYS_API void SetAsyncStep(bool bAsync);
+		SH_PHYS_API auto IsAsyncStep() const -> bool;
+		/// @brief 스텝을 시작한다. 비동기 모드가 아니거나 스레드 풀이 없다면 즉시 Update()를 수행한다.
+		/// @brief 이전 스텝이 진행 중이라면 먼저 EndStep()을 호출한다.
+		SH_PHYS_API void BeginStep(float deltaTime);
+		/// @brief 진행 중인 스텝이 끝날 때까지 기다린 후 강체 상태 스냅샷과 이벤트 버퍼를 교체하고 밀린 쓰기를 반영한다.
+		SH_PHYS_API void EndStep();
+		/// @brief 진행 중인 스텝을 끝낸다. EndStep()과 같이 스냅샷과 이벤트 버퍼를 교체하고 밀린 쓰기를 반영하므로
+		/// @brief 반환 후에는 IsStepping()이 거짓이고 이후 읽기와 쓰기는 물리 세계에 바로 적용된다.
+		SH_PHYS_API void WaitForStep();
+		/// @brief 워커 스레드에서 스텝이 진행 중인지
+		SH_PHYS_API auto IsStepping() const -> bool;
+		/// @brief 마지막 ClearContacts() 이후 끝난 스텝들에서 발생한 충돌/트리거 쌍. 기록된 순서가 유지된다.
+		SH_PHYS_API auto GetContacts() const -> const ContactBuffer&;
+		/// @brief 접촉 버퍼를 비운다. 이전 버퍼를 가리키던 뷰는 무효화 된다.
+		SH_PHYS_API void ClearContacts();
 
-		SH_PHYS_API auto GetContext() const -> ContextHandle;
-		SH_PHYS_API auto GetNative() const -> PhysicsWorldHandle;
+		/// @brief 강체에 안정적인 인덱스를 부여하고 사용자 데이터를 연결한다. 접촉 버퍼에는 이 인덱스가 기록된다.
+		/// @brief 해제된 인덱스는 그 인덱스가 남아 있을 수 있는 버퍼가 모두 비워진 뒤에 재사용된다.
+		SH_PHYS_API auto RegisterBody(void* rigidBodyHandle, void* userData) -> uint32_t;
+		SH_PHYS_API void UnregisterBody(uint32_t idx);
+		/// @return 해제된 인덱스면 nullptr
+		SH_PHYS_API auto GetBodyUserData(uint32_t idx) const -> void*;
+		/// @brief 충돌체에 안정적인 인덱스를 부여하고 사용자 데이터를 연결한다. 규칙은 RegisterBody()와 같다.
+		SH_PHYS_API auto RegisterCollider(void* colliderHandle, void* userData) -> uint32_t;
+		SH_PHYS_API void UnregisterCollider(uint32_t idx);
+		SH_PHYS_API auto GetColliderUserData(uint32_t idx) const -> void*;
+		/// @brief 물리 세계를 변경하는 작업. 스텝이 진행 중이라면 다음 스텝 시작 전에 실행되고, 아니라면 즉시 실행된다.
+		SH_PHYS_API void Write(std::function<void()>&& fn);
+		/// @brief 마지막으로 끝난 스텝의 강체 상태를 반환한다.
+		/// @param rigidBodyHandle 강체 핸들
+		/// @return 스냅샷에 없으면 nullptr
+		SH_PHYS_API auto GetBodyState(void* rigidBodyHandle) const -> const BodyState*;
+		/// @brief 강체의 현재 상태를 읽는다. 진행 중인 스텝이 있다면 WaitForStep()으로 끝내고 밀린 쓰기를 반영한 뒤 읽는다.
+		SH_PHYS_API void ReadBodyState(void* rigidBodyHandle, BodyState& state);
+		/// @brief 강체의 상태를 덮어쓴다. 롤백에 사용하며 진행 중인 스텝이 있다면 먼저 끝낸다.
+		SH_PHYS_API void WriteBodyState(void* rigidBodyHandle, const BodyState& state);
+
+		/// @brief 진행 중인 스텝이 있다면 먼저 끝낸다.
+		SH_PHYS_API auto RayCastHit(const Ray& ray, Tagbit allowedTag = 0xffff) -> bool;
+		/// @brief 진행 중인 스텝이 있다면 먼저 끝낸다.
+		SH_PHYS_API auto RayCast(const Ray& ray, Tagbit allowedTag = 0xffff) -> std::vector<HitPoint>;
+
+		/// @brief 여러 레이를 스레드 풀에서 나눠 검사하고 각 레이의 가장 가까운 충돌 지점을 results에 기록한다.
+		/// @brief 마지막 스텝이 끝난 시점의 읽기 전용 스냅샷을 대상으로 하므로 비동기 스텝이 진행 중이어도 기다리지 않는다. 게임 스레드에서 호출해야 한다.
+		/// @brief 스냅샷이 낡았다면(스텝 밖에서 세계가 바뀐 경우) 진행 중인 스텝을 끝내고 다시 만든다.
+		/// @param queries 레이 질의들
+		/// @param results queries와 같은 크기의 버퍼. 충돌하지 않은 질의는 rigidBodyHandle이 nullptr이 된다.
+		/// @return 충돌한 질의 수
+		SH_PHYS_API auto RayCastBatch(core::ArrayView<const RayQuery> queries, core::ArrayView<HitPoint> results) -> uint32_t;
+		/// @brief 여러 구체 스윕을 일괄로 수행한다. 규칙은 RayCastBatch()와 같다.
+		SH_PHYS_API auto SphereCastBatch(core::ArrayView<const SphereCastQuery> queries, core::ArrayView<HitPoint> results) -> uint32_t;
+		/// @brief 여러 구체 겹침 검사를 일괄로 수행한다.
+		/// @param queries 겹침 질의들
+		/// @param bodies 결과 강체 핸들 버퍼. i번째 질의는 [i * n, i * n + n) 구간에 기록한다. (n = bodies.size() / queries.size())
+		/// @param counts queries와 같은 크기의 버퍼. 각 질의에서 기록된 강체 수
+		/// @return 모든 질의에서 기록된 강체 수의 합
+		SH_PHYS_API auto OverlapBatch(core::ArrayView<const OverlapQuery> queries, core::ArrayView<void*> bodies, core::ArrayView<uint32_t> counts) -> uint32_t;
+
+		/// @brief 진행 중인 스텝이 있다면 먼저 끝낸 후 반환한다.
+		SH_PHYS_API auto GetContext() -> ContextHandle;
+		/// @brief 진행 중인 스텝이 있다면 먼저 끝낸 후 반환한다.
+		SH_PHYS_API auto GetNative() -> PhysicsWorldHandle;
 
 		SH_PHYS_API void SetGravity(const glm::vec3& gravity);
-		SH_PHYS_API auto GetGravity() const -> glm::vec3;
-	public:
-		core::EventBus bus;
+		SH_PHYS_API auto GetGravity() -> glm::vec3;
 	private:
 		struct Impl;
 		
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+
+#include "CollisionTag.hpp"
+namespace sh::phys
+{
+	/// @brief 일괄 레이캐스트 질의
+	struct RayQuery
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		float distance = 1000.f;
+		Tagbit allowedTag = 0xffff;
+	};
+	/// @brief 일괄 구체 스윕 질의. origin에서 direction으로 distance만큼 구체를 밀었을 때 처음 닿는 지점을 찾는다.
+	struct SphereCastQuery
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		float radius = 0.5f;
+		float distance = 1000.f;
+		Tagbit allowedTag = 0xffff;
+	};
+	/// @brief 일괄 구체 겹침 질의
+	struct OverlapQuery
+	{
+		glm::vec3 center;
+		float radius = 0.5f;
+		Tagbit allowedTag = 0xffff;
+	};
+}//namespace
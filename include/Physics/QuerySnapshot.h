@@ -0,0 +1,86 @@
+﻿#pragma once
+#include "Export.h"
+#include "HitPoint.h"
+#include "PhysicsQuery.h"
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <vector>
+namespace sh::phys
+{
+	/// @brief 일괄 질의를 위한 읽기 전용 충돌체 스냅샷.
+	/// @brief 충돌체들의 모양과 월드 트랜스폼을 복사해 BVH로 묶어두며, Build() 이후에는 여러 스레드에서 동시에 질의해도 안전하다.
+	/// @brief 질의 도중에는 메모리를 할당하지 않는다.
+	class QuerySnapshot
+	{
+	public:
+		enum class ShapeType : uint8_t
+		{
+			Sphere,
+			Box,
+			Capsule,
+			/// @brief 해석적으로 다루지 않는 모양. 레이캐스트는 네이티브 함수로, 나머지는 AABB로 처리한다.
+			Bounds
+		};
+		struct Shape
+		{
+			glm::vec3 aabbMin;
+			glm::vec3 aabbMax;
+			glm::vec3 position;
+			glm::quat rotation;
+			/// @brief Sphere: x = 반지름, Box: 절반 크기, Capsule: x = 반지름, y = 절반 높이
+			glm::vec3 extents;
+			ShapeType type = ShapeType::Bounds;
+			Tagbit category = 0xffff;
+			void* rigidBodyHandle = nullptr;
+			void* nativeCollider = nullptr;
+		};
+		/// @brief Bounds 모양에 대한 레이캐스트 함수. 여러 스레드에서 호출되므로 스레드 안전해야 한다.
+		using NativeRayCastFn = bool(*)(void* nativeCollider, const glm::vec3& from, const glm::vec3& to, HitPoint& hit);
+	public:
+		SH_PHYS_API void Clear();
+		SH_PHYS_API void AddShape(const Shape& shape);
+		/// @brief 추가된 모양들로 BVH를 만든다. 질의 전에 반드시 호출해야 한다.
+		SH_PHYS_API void Build();
+
+		void SetNativeRayCast(NativeRayCastFn fn) { nativeRayCast = fn; }
+
+		/// @brief 가장 가까운 충돌 지점을 찾는다. 충돌체 안에서 시작한 레이는 그 충돌체와 충돌하지 않는다.
+		SH_PHYS_API auto RayCast(const RayQuery& query, HitPoint& hit) const -> bool;
+		/// @brief 구체를 밀었을 때 가장 먼저 닿는 지점을 찾는다. 시작부터 겹쳐 있다면 fraction 0으로 보고한다.
+		SH_PHYS_API auto SphereCast(const SphereCastQuery& query, HitPoint& hit) const -> bool;
+		/// @brief 구체와 겹치는 강체들을 중복 없이 bodies에 최대 maxBodies개 기록한다.
+		/// @return 기록된 강체 수
+		SH_PHYS_API auto Overlap(const OverlapQuery& query, void** bodies, uint32_t maxBodies) const -> uint32_t;
+
+		auto GetShapeCount() const -> std::size_t { return shapes.size(); }
+		auto HasBoundsShapes() const -> bool { return bHasBoundsShapes; }
+	private:
+		struct Node
+		{
+			glm::vec3 min;
+			/// @brief 내부 노드면 왼쪽 자식 인덱스(오른쪽은 +1), 리프면 첫 모양 인덱스
+			uint32_t leftOrFirst = 0;
+			glm::vec3 max;
+			/// @brief 0이면 내부 노드
+			uint32_t count = 0;
+		};
+	private:
+		void BuildNode(uint32_t nodeIdx, uint32_t first, uint32_t count);
+
+		template<typename NodeTestFn, typename LeafFn>
+		void Traverse(NodeTestFn&& nodeTest, LeafFn&& leafFn) const;
+	private:
+		static constexpr uint32_t LEAF_SIZE = 4;
+		static constexpr uint32_t STACK_SIZE = 64;
+
+		std::vector<Shape> shapes;
+		std::vector<Node> nodes;
+		std::vector<uint32_t> shapeIdxs;
+
+		NativeRayCastFn nativeRayCast = nullptr;
+		bool bHasBoundsShapes = false;
+	};
+}//namespace
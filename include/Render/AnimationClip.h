@@ -0,0 +1,91 @@
+﻿#pragma once
+#include "Export.h"
+#include "AnimationPose.h"
+
+#include "Core/SObject.h"
+
+#include <glm/vec4.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+namespace sh::render
+{
+	struct Skeleton;
+
+	/// @brief 조인트 로컬 포즈 애니메이션.
+	/// @brief 키프레임을 일정한 간격으로 다시 샘플링한 뒤 성분(채널)마다 변하지 않는 채널은 값 하나로 줄이고
+	/// @brief 나머지는 채널별 범위로 16비트 양자화해 프레임 단위로 이어 붙여 저장한다.
+	class AnimationClip : public core::SObject
+	{
+		SCLASS(AnimationClip)
+	public:
+		/// @brief 압축 전 키프레임 커브. values는 이동/크기면 xyz, 회전이면 쿼터니언 xyzw다.
+		struct RawCurve
+		{
+			std::vector<float> times;
+			std::vector<glm::vec4> values;
+			bool bStep = false;
+		};
+		/// @brief 압축 전 조인트 하나의 트랙. 비어있는 커브는 애니메이션 되지 않는다.
+		struct RawTrack
+		{
+			std::string name; // 대상 조인트(노드) 이름
+			RawCurve translation;
+			RawCurve rotation;
+			RawCurve scale;
+		};
+		/// @brief 트랙의 한 채널
+		struct CurveTarget
+		{
+			uint32_t track = 0;
+			uint32_t channel = 0; // AnimationPose::Channel
+		};
+		/// @brief 압축된 클립 데이터
+		struct Data
+		{
+			float duration = 0.f;
+			float sampleRate = DEFAULT_SAMPLE_RATE;
+			uint32_t frameCount = 0;
+			std::vector<std::string> trackNames;
+			std::vector<CurveTarget> constantTargets;
+			std::vector<float> constantValues;
+			std::vector<CurveTarget> animatedTargets;
+			std::vector<float> animatedMin;
+			std::vector<float> animatedScale; // 양자화 값 1당 크기
+			std::vector<uint16_t> frames; // frameCount * animatedTargets.size(). 프레임마다 애니메이션 채널 값이 이어진다.
+		};
+		/// @brief 클립의 채널을 특정 스켈레톤 포즈 배열의 위치로 연결한 결과. 스켈레톤에 없는 트랙은 INVALID다.
+		struct Binding
+		{
+			std::vector<uint32_t> constantDst;
+			std::vector<uint32_t> animatedDst;
+			std::size_t poseStride = 0;
+		};
+		static constexpr float DEFAULT_SAMPLE_RATE = 30.f;
+		static constexpr float DEFAULT_TOLERANCE = 1e-4f;
+		static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+	public:
+		SH_RENDER_API AnimationClip();
+		SH_RENDER_API ~AnimationClip();
+
+		/// @brief 키프레임 트랙을 압축해 클립 데이터로 쓴다.
+		/// @param duration 클립 길이(초). 0 이하면 트랙의 마지막 키 시간을 쓴다.
+		/// @param sampleRate 초당 샘플 수
+		/// @param tolerance 채널 값의 범위가 이 이하면 상수 채널로 저장한다.
+		SH_RENDER_API void Compress(const std::vector<RawTrack>& tracks, float duration = 0.f, float sampleRate = DEFAULT_SAMPLE_RATE, float tolerance = DEFAULT_TOLERANCE);
+		SH_RENDER_API void SetData(Data data);
+		SH_RENDER_API auto GetData() const -> const Data& { return data; }
+
+		/// @brief 트랙 이름과 스켈레톤 조인트 이름을 맞춰 채널을 포즈 배열에 연결한다.
+		SH_RENDER_API auto Bind(const Skeleton& skeleton) const -> Binding;
+		/// @brief time의 포즈를 pose에 쓴다. 클립에 없는 조인트와 채널은 그대로 둔다.
+		/// @param bLoop true면 time을 길이로 나눈 나머지를, 아니면 [0, 길이]로 자른 시간을 쓴다.
+		SH_RENDER_API void Sample(float time, bool bLoop, const Binding& binding, AnimationPose& pose) const;
+
+		SH_RENDER_API auto GetDuration() const -> float { return data.duration; }
+		SH_RENDER_API auto GetFrameCount() const -> uint32_t { return data.frameCount; }
+	private:
+		Data data;
+	};
+}//namespace
@@ -0,0 +1,55 @@
+﻿#pragma once
+#include "Export.h"
+#include "Skeleton.h"
+
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <vector>
+namespace sh::render
+{
+	/// @brief 스켈레톤 조인트들의 로컬 포즈(이동, 회전, 크기)를 채널별 연속 배열(SoA)로 담는 클래스.
+	/// @brief 채널마다 조인트 수를 4의 배수로 올린 stride만큼 자리를 잡아두고 SIMD로 조인트 4개씩 처리한다.
+	class AnimationPose
+	{
+	public:
+		enum Channel : uint32_t
+		{
+			TranslationX, TranslationY, TranslationZ,
+			RotationX, RotationY, RotationZ, RotationW,
+			ScaleX, ScaleY, ScaleZ,
+			ChannelCount
+		};
+	public:
+		SH_RENDER_API AnimationPose() = default;
+		SH_RENDER_API explicit AnimationPose(std::size_t jointCount);
+
+		/// @brief 조인트 수를 바꾸고 모든 조인트를 항등 포즈로 만든다.
+		SH_RENDER_API void Resize(std::size_t jointCount);
+		/// @brief 모든 조인트를 스켈레톤의 기본 포즈로 되돌린다. 조인트 수가 다르면 스켈레톤에 맞춘다.
+		SH_RENDER_API void SetRestPose(const Skeleton& skeleton);
+		/// @brief 회전 채널의 쿼터니언들을 정규화한다.
+		SH_RENDER_API void NormalizeRotations();
+		/// @brief 로컬 포즈를 스켈레톤 계층을 따라 모델 공간 행렬로 바꾼다.
+		/// @param out 스켈레톤 조인트 수 만큼의 공간이 있어야 한다.
+		SH_RENDER_API void ComputeModelMatrices(const Skeleton& skeleton, glm::mat4* out) const;
+
+		/// @brief a와 b를 weight로 섞어 out에 쓴다. 회전은 같은 반구로 맞춘 뒤 선형 보간하고 정규화한다(nlerp).
+		/// @brief out은 a나 b와 같은 객체여도 된다.
+		/// @param jointWeights nullptr가 아니면 조인트별로 weight에 곱해진다. stride 길이여야 한다.
+		SH_RENDER_API static void Blend(const AnimationPose& a, const AnimationPose& b, float weight, AnimationPose& out, const float* jointWeights = nullptr);
+		/// @brief 조인트 수에 맞는 채널당 자리 수(4의 배수)
+		SH_RENDER_API static auto CalcStride(std::size_t jointCount) -> std::size_t;
+
+		SH_RENDER_API auto GetJointCount() const -> std::size_t { return jointCount; }
+		SH_RENDER_API auto GetStride() const -> std::size_t { return stride; }
+		SH_RENDER_API auto GetChannel(uint32_t channel) -> float* { return data.data() + channel * stride; }
+		SH_RENDER_API auto GetChannel(uint32_t channel) const -> const float* { return data.data() + channel * stride; }
+		/// @brief 모든 채널이 이어진 배열. 채널 c, 조인트 j의 값은 [c * stride + j]에 있다.
+		SH_RENDER_API auto GetData() -> float* { return data.data(); }
+		SH_RENDER_API auto GetData() const -> const float* { return data.data(); }
+	private:
+		std::vector<float> data;
+		std::size_t jointCount = 0;
+		std::size_t stride = 0;
+	};
+}//namespace
@@ -35,6 +35,13 @@ namespace sh::render
 		SH_RENDER_API void SetTopology(Mesh::Topology topology);
 		SH_RENDER_API void SetPriority(int priority);
 		SH_RENDER_API void SetSubMeshIndex(uint32_t idx);
+		/// @brief 카메라별로 그릴 LOD를 지정한다. 동기화 시점에 렌더 스레드에 반영된다.
+		/// @param lods RenderViewer::lodSlot번째 카메라의 LOD
+		/// @param shadowLod 그림자 패스에서 쓸 LOD
+		SH_RENDER_API void SetLods(const std::vector<uint8_t>& lods, uint8_t shadowLod);
+		/// @brief 공유 스키닝 버퍼(SkinPaletteBuffer)에서 이 메쉬의 조인트 행렬이 시작하는 인덱스를 지정한다.
+		/// @brief SkinPaletteBuffer::INVALID_OFFSET이면 그려지지 않는다.
+		SH_RENDER_API void SetSkinOffset(uint32_t offset);
 
 		SH_RENDER_API auto CheckAssetValid() const -> bool;
 
@@ -48,6 +55,10 @@ namespace sh::render
 		SH_RENDER_API auto GetPriority(core::ThreadType thr = core::ThreadType::Game) const -> int { return priority[thr]; }
 		SH_RENDER_API auto GetSubMeshIndex() const -> uint32_t { return subMeshIndex; }
 		SH_RENDER_API auto IsSkinnedMesh() const -> bool { return bSkinned; }
+		SH_RENDER_API auto GetSkinOffset(core::ThreadType thr) const -> uint32_t { return skinOffset[thr]; }
+		/// @brief 렌더 스레드에서 뷰어가 그릴 LOD를 반환한다. 지정되지 않은 뷰어는 0(원본)
+		/// @param lodSlot RenderViewer::lodSlot
+		SH_RENDER_API auto GetLod(uint32_t lodSlot) const -> uint32_t;
 	protected:
 		SH_RENDER_API void SyncDirty() override;
 		SH_RENDER_API void Sync() override;
@@ -65,6 +76,9 @@ namespace sh::render
 		uint32_t renderTag = 1;
 		core::SyncArray<Mesh::Topology> topology;
 		core::SyncArray<int> priority;
+		core::SyncArray<std::vector<uint8_t>> lods;
+		core::SyncArray<uint8_t> shadowLod;
+		core::SyncArray<uint32_t> skinOffset;
 
 		struct SyncData
 		{
@@ -77,5 +91,7 @@ namespace sh::render
 		bool bSkinned = false;
 		bool bDirty = false;
 		bool bMatrixDirty = false;
+		bool bLodDirty = false;
+		bool bSkinOffsetDirty = false;
 	};
 }//namespace
\ No newline at end of file
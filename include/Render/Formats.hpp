@@ -22,21 +22,65 @@ namespace sh::render
 		D24S8,
 		D16S8,
 		D32,
-		D16
+		D16,
+		// 블록 압축 포맷 (4x4 픽셀 블록 단위)
+		BC1,
+		BC1_SRGB,
+		BC3,
+		BC3_SRGB,
+		BC4,
+		BC5,
+		BC7,
+		BC7_SRGB
+	};
+	/// @brief 텍스쳐 임포트 시 적용할 블록 압축 설정
+	enum class TextureCompression
+	{
+		None,
+		Color, // 알파가 없으면 BC1, 있으면 BC3
+		ColorHighQuality, // BC7
+		NormalMap, // BC5 (RG)
+		SingleChannel // BC4 (R)
 	};
 
 	inline static auto GetTextureFormatChannel(TextureFormat format) -> int
 	{
 		switch (format)
 		{
-		case TextureFormat::RG32F:
+		case TextureFormat::RG32F: [[fallthrough]];
+		case TextureFormat::BC5:
 			return 2;
-		case TextureFormat::R8:
+		case TextureFormat::R8: [[fallthrough]];
+		case TextureFormat::BC4:
 			return 1;
 		}
 		return 4;
 	}
 
+	inline static auto IsCompressedTextureFormat(TextureFormat format) -> bool
+	{
+		return format >= TextureFormat::BC1 && format <= TextureFormat::BC7_SRGB;
+	}
+	/// @brief 압축 포맷의 4x4 블록 하나의 바이트 수를 반환한다. 압축 포맷이 아니면 0
+	inline static auto GetTextureFormatBlockSize(TextureFormat format) -> std::size_t
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1: [[fallthrough]];
+		case TextureFormat::BC1_SRGB: [[fallthrough]];
+		case TextureFormat::BC4:
+			return 8;
+		case TextureFormat::BC3: [[fallthrough]];
+		case TextureFormat::BC3_SRGB: [[fallthrough]];
+		case TextureFormat::BC5: [[fallthrough]];
+		case TextureFormat::BC7: [[fallthrough]];
+		case TextureFormat::BC7_SRGB:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
 	inline static auto GetTextureFormatPixelSize(TextureFormat format) -> std::size_t
 	{
 		switch (format)
@@ -49,6 +93,17 @@ namespace sh::render
 			return 4;
 		}
 	}
+	/// @brief 해당 크기의 밉 하나가 차지하는 바이트 수를 반환한다. 압축 포맷은 블록 단위로 올림 한다.
+	inline static auto GetTextureFormatMipSize(TextureFormat format, uint32_t width, uint32_t height) -> std::size_t
+	{
+		if (IsCompressedTextureFormat(format))
+		{
+			const std::size_t blocksX = (width + 3) / 4;
+			const std::size_t blocksY = (height + 3) / 4;
+			return blocksX * blocksY * GetTextureFormatBlockSize(format);
+		}
+		return static_cast<std::size_t>(width) * height * GetTextureFormatPixelSize(format);
+	}
 
 	inline static auto IsDepthTexture(TextureFormat format) -> bool
 	{
@@ -79,6 +134,14 @@ namespace sh::render
 		case TextureFormat::D16S8: return "D16S8";
 		case TextureFormat::D32: return "D32";
 		case TextureFormat::D16: return "D16";
+		case TextureFormat::BC1: return "BC1";
+		case TextureFormat::BC1_SRGB: return "BC1_SRGB";
+		case TextureFormat::BC3: return "BC3";
+		case TextureFormat::BC3_SRGB: return "BC3_SRGB";
+		case TextureFormat::BC4: return "BC4";
+		case TextureFormat::BC5: return "BC5";
+		case TextureFormat::BC7: return "BC7";
+		case TextureFormat::BC7_SRGB: return "BC7_SRGB";
 		default: return "None";
 		}
 	}
@@ -9,6 +9,7 @@
 namespace sh::render
 {
 	class RenderDataManager;
+	class SkinPaletteBuffer;
 
 	enum class RenderAPI
 	{
@@ -34,5 +35,9 @@ namespace sh::render
 
 		virtual auto GetRenderDataManager() const -> const RenderDataManager& = 0;
 		virtual auto GetRenderDataManager() -> RenderDataManager& = 0;
+		virtual auto GetSkinPaletteBuffer() const -> const SkinPaletteBuffer& = 0;
+		virtual auto GetSkinPaletteBuffer() -> SkinPaletteBuffer& = 0;
+		/// @brief 장치가 BC 블록 압축 텍스쳐를 샘플링 할 수 있는지
+		virtual auto IsTextureCompressionSupported() const -> bool = 0;
 	};
 }//namespace
\ No newline at end of file
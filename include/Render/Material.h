@@ -70,6 +70,8 @@ namespace sh::render
 					  auto GetProperty(const std::string& name) const -> std::optional<T>;
 
 		SH_RENDER_API auto GetMaterialData() const -> const MaterialData&;
+		/// @brief 머티리얼이 참조하는 텍스쳐들을 반환한다.
+		SH_RENDER_API auto GetTextureProperties() const -> const std::unordered_map<std::string, const Texture*>& { return propertyBlock.GetTextureProperties(); }
 		              template<typename T>
 		              void SetConstant(const std::string& name, const T& value);
 		SH_RENDER_API auto GetConstantData(const ShaderPass& pass) const -> const std::vector<uint8_t>*;
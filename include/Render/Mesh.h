@@ -36,6 +36,35 @@ namespace sh::render
 			glm::vec3 normal;
 			glm::vec3 tangent;
 		};
+		/// @brief GPU에 올라가는 양자화된 버텍스 (20바이트)
+		struct QuantizedVertex
+		{
+			/// @brief AABB 기준 UNORM16 위치. w는 사용하지 않는다.
+			std::array<uint16_t, 4> vertex;
+			/// @brief 반정밀도 UV
+			std::array<uint16_t, 2> uv;
+			/// @brief 팔면체 인코딩된 SNORM16 노말
+			std::array<int16_t, 2> normal;
+			/// @brief 팔면체 인코딩된 SNORM16 탄젠트
+			std::array<int16_t, 2> tangent;
+		};
+		/// @brief 셰이더에서 양자화된 버텍스를 복원하는 값. 위치 = offset + 양자화 값 * scale
+		struct Dequantization
+		{
+			glm::vec4 offset{ 0.f };
+			/// @brief w가 0이 아니면 노말과 탄젠트가 팔면체 인코딩 돼있다는 뜻이다.
+			glm::vec4 scale{ 1.f, 1.f, 1.f, 0.f };
+		};
+		/// @brief 원본(LOD 0)보다 삼각형이 적은 상세 단계. 원본과 같은 버텍스를 쓴다.
+		struct Lod
+		{
+			/// @brief 원본 대비 목표 삼각형 비율
+			float ratio = 1.f;
+			/// @brief 화면 크기(바운딩 구의 지름 / 화면 높이)가 이 값보다 작아지면 이 LOD를 쓴다.
+			float screenSize = 0.f;
+			/// @brief 서브 메쉬별 인덱스 범위. 오프셋은 GetLodIndices() 기준이다. 서브 메쉬가 없다면 하나다.
+			std::vector<SubMesh> subMeshes;
+		};
 		struct Face
 		{
 			std::array<uint32_t, 3> vertexIdx;
@@ -69,9 +98,32 @@ namespace sh::render
 
 		SH_RENDER_API void Build(const IRenderContext& context) override;
 
+		/// @brief LOD 설정(lodRatios)이 생성된 LOD와 다르면 LOD를 다시 만든다. 임포트 시 메타의 설정을 반영하기 위함이다.
+		SH_RENDER_API void Deserialize(const core::Json& json) override;
+
 		SH_RENDER_API void SetTopology(Topology topology) { this->topology = topology; }
+		/// @brief Build시 버텍스를 양자화해서 올릴지. 스킨 메쉬는 양자화되지 않는다.
+		/// @brief 이미 Build된 메쉬라면 바뀐 설정으로 다시 Build한다.
+		SH_RENDER_API void SetQuantize(bool bQuantize);
 
 		SH_RENDER_API void CalculateTangents();
+		/// @brief lodRatios, lodScreenSizes 설정대로 LOD들을 만든다. Build 전에 호출 해야 GPU에 반영된다.
+		/// @brief 각 LOD는 이전 LOD를 서브 메쉬 단위로 단순화 해서 만든다.
+		SH_RENDER_API void GenerateLods();
+		/// @brief 미리 만들어둔 LOD를 지정한다. LOD 설정도 LOD에 맞춰 바뀐다.
+		/// @param lodIndices 모든 LOD의 인덱스
+		/// @param lods LOD 정보
+		SH_RENDER_API void SetLods(std::vector<uint32_t> lodIndices, std::vector<Lod> lods);
+		/// @brief 화면 크기에 맞는 LOD를 고른다. 경계 근처에서 LOD가 계속 바뀌지 않도록 현재 LOD에서 벗어나려면 경계를 hysteresis 비율만큼 넘어야 한다.
+		/// @param screenSize 화면 크기 (바운딩 구의 지름 / 화면 높이)
+		/// @param currentLod 현재 LOD
+		/// @param hysteresis 경계의 여유 비율
+		/// @return 0이면 원본
+		SH_RENDER_API auto SelectLod(float screenSize, uint32_t currentLod, float hysteresis = 0.1f) const -> uint32_t;
+		/// @brief GPU 인덱스 버퍼에서 서브 메쉬의 LOD가 차지하는 범위
+		/// @param subMeshIdx 서브 메쉬 번호. 범위를 벗어나면 메쉬 전체
+		/// @param lod LOD. 범위를 벗어나면 가장 낮은 LOD
+		SH_RENDER_API auto GetIndexRange(uint32_t subMeshIdx, uint32_t lod) const -> SubMesh;
 
 		SH_RENDER_API auto GetVertex() const -> const std::vector<Vertex>& { return verts; }
 		SH_RENDER_API auto GetVertexCount() const -> size_t { return verts.size(); }
@@ -82,21 +134,43 @@ namespace sh::render
 		SH_RENDER_API auto GetBoundingBox() const -> const AABB& { return bounding; }
 		SH_RENDER_API auto GetBoundingBox() -> AABB& { return bounding; }
 		SH_RENDER_API auto GetSubMeshes() const -> const std::vector<SubMesh>& { return subMeshes; }
+		SH_RENDER_API auto IsQuantized() const -> bool { return bQuantize; }
+		SH_RENDER_API auto GetDequantization() const -> const Dequantization& { return dequantization; }
+		/// @brief 원본을 포함한 LOD 수
+		SH_RENDER_API auto GetLodCount() const -> uint32_t { return static_cast<uint32_t>(lods.size() + 1); }
+		/// @brief 원본을 제외한 LOD들
+		SH_RENDER_API auto GetLods() const -> const std::vector<Lod>& { return lods; }
+		/// @brief 모든 LOD의 인덱스. GPU에서는 원본 인덱스 뒤에 붙는다.
+		SH_RENDER_API auto GetLodIndices() const -> const std::vector<uint32_t>& { return lodIndices; }
 	protected:
 		SH_RENDER_API void SetVertexBuffer(std::unique_ptr<IVertexBuffer> buf);
 		SH_RENDER_API void CreateFace();
 	public:
 		float lineWidth = 1.f;
+		/// @brief LOD별 목표 삼각형 비율. 임포트 설정이라 바꾸면 다시 임포트 할 때 반영된다.
+		PROPERTY(lodRatios)
+		std::vector<float> lodRatios{ 0.5f, 0.25f, 0.125f };
+		/// @brief LOD별 전환 화면 크기 (임포트 설정). 부족하면 앞 LOD의 절반을 쓴다.
+		PROPERTY(lodScreenSizes)
+		std::vector<float> lodScreenSizes{ 0.5f, 0.25f, 0.1f };
+	protected:
+		/// @brief 마지막으로 Build에 쓰인 컨텍스트. LOD를 다시 만들 때 쓰인다.
+		const IRenderContext* context = nullptr;
 	private:
 		std::vector<Vertex> verts;
 		std::vector<uint32_t> indices;
 		std::vector<Face> faces;
 		std::vector<SubMesh> subMeshes;
+		std::vector<uint32_t> lodIndices;
+		std::vector<Lod> lods;
 
 		std::unique_ptr<IVertexBuffer> buffer;
 
 		AABB bounding;
 
 		Topology topology;
+
+		Dequantization dequantization;
+		bool bQuantize = false;
 	};//Mesh
 }//namespace
\ No newline at end of file
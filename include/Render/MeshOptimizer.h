@@ -0,0 +1,98 @@
+﻿#pragma once
+#include "Export.h"
+#include "Mesh.h"
+#include "SkinnedMesh.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <limits>
+namespace sh::render
+{
+	/// @brief 임포트 시점에 메쉬의 인덱스와 버텍스를 GPU가 읽기 좋은 순서로 재배치하고 버텍스를 양자화하는 클래스.
+	/// @brief 인덱스는 변환 후 버텍스 캐시 효율(Forsyth)을 높인 뒤 오버드로우가 줄도록 클러스터 단위로 정렬하고,
+	/// @brief 버텍스는 인덱스에서 처음 참조되는 순서로 재배치한다.
+	class MeshOptimizer
+	{
+	public:
+		/// @brief FIFO 버텍스 캐시 시뮬레이션 결과
+		struct CacheStatistics
+		{
+			/// @brief 삼각형 당 평균 캐시 미스 수 (0.5 ~ 3)
+			float acmr = 0.f;
+			/// @brief 버텍스 당 평균 변환 횟수 (1이 최적)
+			float atvr = 0.f;
+		};
+		static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+	public:
+		/// @brief FIFO 캐시로 인덱스 순서의 버텍스 캐시 효율을 측정한다.
+		/// @param indices 삼각형 인덱스
+		/// @param indexCount 인덱스 수
+		/// @param vertexCount 버텍스 수
+		/// @param cacheSize 캐시 크기
+		SH_RENDER_API static auto AnalyzeVertexCache(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, uint32_t cacheSize = 16) -> CacheStatistics;
+		/// @brief 변환 후 버텍스 캐시 적중률이 높아지도록 삼각형 순서를 바꾼다. (Tom Forsyth, Linear-Speed Vertex Cache Optimisation)
+		/// @param indices 삼각형 인덱스
+		/// @param indexCount 인덱스 수
+		/// @param vertexCount 버텍스 수
+		SH_RENDER_API static void OptimizeVertexCache(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+		/// @brief 캐시 최적화된 삼각형들을 클러스터로 나누고 바깥을 향하는 클러스터부터 그려지도록 정렬한다. (Sander et al. 2007)
+		/// @param indices OptimizeVertexCache를 거친 삼각형 인덱스
+		/// @param indexCount 인덱스 수
+		/// @param verts 버텍스
+		/// @param threshold 허용하는 ACMR 증가 비율. 클수록 클러스터가 작아져 오버드로우는 줄고 캐시 효율은 떨어진다.
+		SH_RENDER_API static void OptimizeOverdraw(uint32_t* indices, std::size_t indexCount, const std::vector<Mesh::Vertex>& verts, float threshold = 1.05f);
+		/// @brief 인덱스에서 처음 참조되는 순서대로 버텍스 번호를 다시 매긴다. 참조되지 않는 버텍스는 버려진다.
+		/// @param indices 삼각형 인덱스. 새 번호로 바뀐다.
+		/// @param vertexCount 버텍스 수
+		/// @return 기존 번호 -> 새 번호 테이블. 버려진 버텍스는 INVALID_INDEX
+		SH_RENDER_API static auto OptimizeVertexFetch(std::vector<uint32_t>& indices, std::size_t vertexCount) -> std::vector<uint32_t>;
+		/// @brief OptimizeVertexFetch의 테이블로 버텍스 데이터를 재배치한다.
+		/// @param verts 버텍스 데이터
+		/// @param remap 기존 번호 -> 새 번호 테이블
+		template<typename T>
+		static void RemapVertices(std::vector<T>& verts, const std::vector<uint32_t>& remap);
+		/// @brief 서브 메쉬별로 캐시와 오버드로우 최적화를 거친 후 버텍스를 재배치한다. 서브 메쉬의 인덱스 범위는 유지된다.
+		/// @param verts 버텍스
+		/// @param indices 삼각형 인덱스
+		/// @param subMeshes 서브 메쉬. 비어있으면 전체를 하나로 본다.
+		/// @param boneVerts 스킨 메쉬의 본 버텍스. 버텍스와 같이 재배치된다. 버텍스 수와 다르면 아무것도 하지 않는다.
+		SH_RENDER_API static void Optimize(std::vector<Mesh::Vertex>& verts, std::vector<uint32_t>& indices, const std::vector<SubMesh>& subMeshes,
+			std::vector<SkinnedMesh::BoneVertex>* boneVerts = nullptr);
+
+		/// @brief 버텍스들의 AABB로 양자화 복원 값을 구한다.
+		SH_RENDER_API static auto CalcDequantization(const std::vector<Mesh::Vertex>& verts) -> Mesh::Dequantization;
+		/// @brief 버텍스를 양자화한다. 위치는 AABB 기준 UNORM16, UV는 반정밀도, 노말과 탄젠트는 팔면체 SNORM16
+		/// @param verts 버텍스
+		/// @param dequantization CalcDequantization()로 구한 값
+		SH_RENDER_API static auto Quantize(const std::vector<Mesh::Vertex>& verts, const Mesh::Dequantization& dequantization) -> std::vector<Mesh::QuantizedVertex>;
+		/// @brief 단위 벡터를 팔면체 인코딩해서 SNORM16 두개로 만든다.
+		SH_RENDER_API static auto EncodeOctahedral(const glm::vec3& dir) -> std::array<int16_t, 2>;
+		/// @brief EncodeOctahedral()의 역변환. 셰이더의 복원 코드와 같다.
+		SH_RENDER_API static auto DecodeOctahedral(const std::array<int16_t, 2>& encoded) -> glm::vec3;
+		/// @brief 32비트 부동소수점을 반정밀도로 바꾼다.
+		SH_RENDER_API static auto FloatToHalf(float value) -> uint16_t;
+		/// @brief 반정밀도를 32비트 부동소수점으로 바꾼다.
+		SH_RENDER_API static auto HalfToFloat(uint16_t value) -> float;
+	};
+
+	template<typename T>
+	inline void MeshOptimizer::RemapVertices(std::vector<T>& verts, const std::vector<uint32_t>& remap)
+	{
+		std::size_t count = 0;
+		for (uint32_t idx : remap)
+		{
+			if (idx != INVALID_INDEX)
+				count = std::max(count, static_cast<std::size_t>(idx) + 1);
+		}
+		std::vector<T> result(count);
+		for (std::size_t i = 0; i < verts.size() && i < remap.size(); ++i)
+		{
+			if (remap[i] != INVALID_INDEX)
+				result[remap[i]] = std::move(verts[i]);
+		}
+		verts = std::move(result);
+	}
+}//namespace
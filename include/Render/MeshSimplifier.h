@@ -0,0 +1,26 @@
+﻿#pragma once
+#include "Export.h"
+#include "Mesh.h"
+
+#include <cstdint>
+#include <vector>
+namespace sh::render
+{
+	/// @brief 이차 오차 행렬(Garland-Heckbert)로 간선을 붕괴시켜 삼각형 수를 줄이는 클래스.
+	/// @brief 버텍스는 새로 만들지 않고 기존 버텍스 중 하나로 붕괴시키므로 결과 인덱스는 원본과 같은 버텍스 버퍼를 쓸 수 있다.
+	/// @brief 열린 경계와 UV/노말 이음새에 있는 버텍스는 움직이지 않는다.
+	class MeshSimplifier
+	{
+	public:
+		/// @brief 삼각형 수를 줄인 인덱스를 만든다.
+		/// @param verts 버텍스
+		/// @param indices 삼각형 인덱스
+		/// @param indexCount 인덱스 수
+		/// @param targetIndexCount 목표 인덱스 수. 오차 한계나 잠긴 버텍스 때문에 도달하지 못할 수 있다.
+		/// @param maxError 허용하는 최대 오차. 메쉬 AABB의 가장 긴 변에 대한 거리 비율이다.
+		/// @param outError nullptr가 아니면 실제로 생긴 최대 오차(비율)가 들어간다.
+		/// @return 줄어든 삼각형 인덱스
+		SH_RENDER_API static auto Simplify(const std::vector<Mesh::Vertex>& verts, const uint32_t* indices, std::size_t indexCount,
+			std::size_t targetIndexCount, float maxError = 1.f, float* outError = nullptr) -> std::vector<uint32_t>;
+	};
+}//namespace
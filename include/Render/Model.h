@@ -2,6 +2,7 @@
 #include "Export.h"
 #include "Mesh.h"
 #include "Skeleton.h"
+#include "AnimationClip.h"
 
 #include "Core/SObject.h"
 #include "Core/SContainer.hpp"
@@ -29,19 +30,32 @@ namespace sh::render
 		std::vector<Node> nodes;
 		core::SVector<Mesh*> meshes;
 		std::vector<Skeleton> skeletons;
+		core::SVector<AnimationClip*> animations;
 	public:
 		SH_RENDER_API Model(std::vector<Node> nodes);
 		SH_RENDER_API ~Model();
 
 		SH_RENDER_API void Destroy() override;
 
-		SH_RENDER_API void SetSkeletons(std::vector<Skeleton> skeletons) { this->skeletons = std::move(skeletons); }
+		/// @brief 스켈레톤을 설정하고 노드 계층으로 조인트 계층(Skeleton::BuildHierarchy)을 만든다.
+		SH_RENDER_API void SetSkeletons(std::vector<Skeleton> skeletons);
+		SH_RENDER_API void SetAnimations(std::vector<AnimationClip*> animations);
+		/// @brief 스킨 메쉬가 아닌 메쉬들을 양자화된 버텍스로 올릴지 지정한다. 이미 Build된 메쉬는 다시 Build된다.
+		SH_RENDER_API void SetQuantizeMeshes(bool bQuantize);
 
 		SH_RENDER_API auto GetMeshes() const -> const core::SVector<Mesh*>& { return meshes; }
 		SH_RENDER_API auto GetNodes() const -> const std::vector<Node>& { return nodes; }
 		SH_RENDER_API auto GetSkeletons() const -> const std::vector<Skeleton>& { return skeletons; }
+		SH_RENDER_API auto GetAnimations() const -> const core::SVector<AnimationClip*>& { return animations; }
+		SH_RENDER_API auto IsQuantizeMeshes() const -> bool { return bQuantizeMeshes; }
 
 		SH_RENDER_API auto Serialize() const -> core::Json override;
+		/// @brief 메타에 저장된 임포트 설정(메쉬 설정, 양자화 여부)을 반영한다.
 		SH_RENDER_API void Deserialize(const core::Json& json) override;
+		SH_RENDER_API void OnPropertyChanged(const core::reflection::Property& prop) override;
+	private:
+		/// @brief 스킨 메쉬가 아닌 메쉬들을 양자화된 버텍스로 올릴지 (임포트 설정). 모델마다 메타 파일에 저장된다.
+		PROPERTY(bQuantizeMeshes)
+		bool bQuantizeMeshes = true;
 	};
 }//namespace
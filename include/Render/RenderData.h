@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <variant>
 #include <vector>
 
@@ -36,6 +37,10 @@ namespace sh::render
 		glm::uvec4 viewportRect;
 		glm::uvec4 viewportScissor;
 		std::size_t offset = 0;
+		/// @brief Drawable에서 LOD를 고를 때 쓰는 번호(카메라 번호). SHADOW_LOD_SLOT이면 그림자 LOD를 쓴다.
+		uint32_t lodSlot = 0;
+
+		static constexpr uint32_t SHADOW_LOD_SLOT = std::numeric_limits<uint32_t>::max();
 	};
 
 	class RenderData
@@ -57,6 +57,7 @@ namespace sh::render
 			const Material* material;
 			Mesh::Topology topology;
 			bool bSkinned = false;
+			bool bQuantized = false;
 			std::vector<const Drawable*> drawables;
 		};
 		SH_RENDER_API ScriptableRenderPass(const core::Name& passName, RenderQueue renderQueue);
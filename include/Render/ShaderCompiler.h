@@ -0,0 +1,68 @@
+﻿#pragma once
+#include "Export.h"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+namespace sh::render
+{
+	/// @brief GLSL을 SPIR-V로 컴파일하는 클래스. 외부 프로세스를 실행하지 않고 프로세스 내에서 컴파일한다.
+	/// @brief 결과는 GLSL과 컴파일 옵션의 해시를 키로 캐시 경로에 저장되며 입력이 같다면 다시 컴파일하지 않는다.
+	class ShaderCompiler
+	{
+	public:
+		enum class Stage
+		{
+			Vertex,
+			Fragment,
+			Compute
+		};
+		struct Options
+		{
+			bool bOptimize = false;
+			bool bDebugInfo = false;
+		};
+		struct Source
+		{
+			std::string_view code;
+			Stage stage;
+			std::string name; // 에러 메시지에 표시될 이름
+		};
+		using Spirv = std::vector<uint8_t>;
+	public:
+		SH_RENDER_API ShaderCompiler();
+		SH_RENDER_API explicit ShaderCompiler(const Options& options);
+		SH_RENDER_API ~ShaderCompiler();
+
+		/// @brief SPIR-V 캐시 경로를 지정한다. 비어있으면 캐시를 사용하지 않는다.
+		/// @param path 디렉토리 경로
+		SH_RENDER_API void SetCachePath(const std::filesystem::path& path);
+		SH_RENDER_API auto GetCachePath() const -> const std::filesystem::path& { return cachePath; }
+
+		/// @brief GLSL을 컴파일한다. 여러 스레드에서 동시에 호출해도 된다.
+		/// @param code GLSL 코드
+		/// @param stage 셰이더 스테이지
+		/// @param name 에러 메시지에 표시될 이름
+		/// @return 실패 시 nullopt
+		SH_RENDER_API auto Compile(std::string_view code, Stage stage, const std::string& name) const -> std::optional<Spirv>;
+		/// @brief 여러 소스를 스레드 풀에서 동시에 컴파일한다. 스레드 풀의 작업 안에서 호출되면 그 스레드에서 순서대로 컴파일한다.
+		/// @param sources 소스 목록
+		/// @return 소스와 같은 순서의 결과. 실패한 소스는 nullopt
+		SH_RENDER_API auto CompileAll(const std::vector<Source>& sources) const -> std::vector<std::optional<Spirv>>;
+
+		SH_RENDER_API auto GetCacheKey(std::string_view code, Stage stage) const -> uint64_t;
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> impl;
+
+		Options options;
+		std::filesystem::path cachePath;
+	public:
+		/// @brief 컴파일러나 타겟 환경이 바뀌면 올려서 기존 캐시를 무효화 한다.
+		constexpr static uint32_t VERSION = 1;
+	};
+}//namespace
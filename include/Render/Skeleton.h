@@ -8,16 +8,39 @@
 namespace sh::render
 {
 	/// @brief SkinnedMeshRenderer가 런타임에 사용하는 스킨 바인드 포즈 데이터.
-	/// 조인트 트랜스폼은 실제 씬의 bone GameObject(Transform)에서 읽는다.
+	/// 조인트 트랜스폼은 실제 씬의 bone GameObject(Transform)에서 읽거나 Animator가 계산한 포즈를 쓴다.
 	struct Skeleton
 	{
 		struct Joint
 		{
 			int nodeIdx = -1;
 			glm::mat4 inverseBindMat{ 1.f };
+
+			// 아래는 BuildHierarchy()가 모델 노드로부터 채운다.
+			std::string name;
+			/// @brief 부모 조인트 인덱스. -1이면 모델 공간의 루트다.
+			int parentIdx = -1;
+			/// @brief 부모 조인트(루트면 모델)와 이 조인트 사이에 있는 조인트가 아닌 노드들의 행렬
+			glm::mat4 parentMat{ 1.f };
+			glm::vec3 restTranslation{ 0.f };
+			/// @brief 쿼터니언 (x, y, z, w)
+			glm::vec4 restRotation{ 0.f, 0.f, 0.f, 1.f };
+			glm::vec3 restScale{ 1.f };
 		};
 		std::vector<Joint> joints;
+		/// @brief 부모가 자식보다 먼저 오는 조인트 순서
+		std::vector<uint32_t> order;
 
 		auto GetJointCount() const -> std::size_t { return joints.size(); }
+
+		/// @brief 모델 노드 계층으로부터 조인트의 부모, 이름, 기본 로컬 TRS와 계산 순서를 채운다.
+		/// @param nodeParents 노드별 부모 노드 인덱스. 루트는 -1
+		/// @param nodeMatrices 노드별 부모 기준 로컬 행렬
+		/// @param nodeNames 노드별 이름
+		SH_RENDER_API void BuildHierarchy(const std::vector<int>& nodeParents, const std::vector<glm::mat4>& nodeMatrices, const std::vector<std::string>& nodeNames);
+		/// @brief 조인트 이름으로 인덱스를 찾는다. 없으면 -1
+		SH_RENDER_API auto FindJoint(const std::string& name) const -> int;
+		/// @brief 전단(shear)이 없는 행렬을 이동, 회전(x, y, z, w), 크기로 분해한다.
+		SH_RENDER_API static void DecomposeMatrix(const glm::mat4& mat, glm::vec3& translation, glm::vec4& rotation, glm::vec3& scale);
 	};
 }//namespace
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include "Export.h"
+#include "IBuffer.h"
+#include "IRenderThrMethod.h"
+
+#include "Core/ISyncable.h"
+
+#include "glm/mat4x4.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+namespace sh::render
+{
+	class IRenderContext;
+
+	/// @brief 한 프레임에 쓰이는 모든 스키닝 행렬을 모아두는 공유 스토리지 버퍼.
+	/// @brief 게임 스레드에서 한 번에 채우고 동기화 시점에 렌더 스레드로 넘긴다. 셰이더의 SKIN 버퍼가 이 버퍼에 연결되며 메쉬마다 시작 인덱스(Drawable::SetSkinOffset)로 구분한다.
+	class SkinPaletteBuffer : public core::ISyncable
+	{
+	public:
+		/// @brief 한 프레임에 담을 수 있는 최대 행렬 수 (4MB)
+		constexpr static std::size_t CAPACITY = 65536;
+		/// @brief 행렬 공간을 잡지 못한 메쉬의 시작 인덱스. 이 인덱스를 가진 스킨 메쉬는 그려지지 않는다.
+		constexpr static uint32_t INVALID_OFFSET = std::numeric_limits<uint32_t>::max();
+	public:
+		SH_RENDER_API SkinPaletteBuffer();
+		SH_RENDER_API ~SkinPaletteBuffer();
+
+		SH_RENDER_API void Init(const IRenderContext& ctx);
+
+		/// @brief 게임 스레드에서 이번 프레임에 쓸 행렬 공간을 이어서 잡는다. 잡은 공간은 동기화 시점까지 유지된다.
+		/// @brief 반환된 주소는 다음 Allocate 호출 전까지 유효하며, 서로 겹치지 않는 구간은 여러 스레드에서 동시에 채워도 된다.
+		/// @param count 행렬 수. 남은 공간을 넘으면 잘리며, 잘렸는지는 GetCount()로 확인한다.
+		/// @param offset 잡은 공간의 시작 인덱스
+		/// @return 잡은 공간의 시작 주소. 잡지 못했다면 nullptr
+		SH_RENDER_API auto Allocate(std::size_t count, uint32_t& offset) -> glm::mat4*;
+
+		SH_RENDER_API auto GetBuffer() const -> const IBuffer* { return buffer.get(); }
+		/// @brief 게임 스레드에서 이번 프레임에 잡은 행렬 수
+		SH_RENDER_API auto GetCount() const -> std::size_t { return palettes[core::ThreadType::Game].size(); }
+	protected:
+		SH_RENDER_API void SyncDirty() override;
+		SH_RENDER_API void Sync() override;
+
+		SH_RENDER_API void ClearBuffer();
+		SH_RENDER_API void UploadToGPU();
+	private:
+		friend struct IRenderThrMethod<SkinPaletteBuffer>;
+
+		std::unique_ptr<IBuffer> buffer;
+		core::SyncArray<std::vector<glm::mat4>> palettes;
+
+		bool bDirty = false;
+		bool bUploaded = true;
+	};
+
+	template<>
+	struct IRenderThrMethod<SkinPaletteBuffer>
+	{
+		static void ClearBuffer(SkinPaletteBuffer& palette) { palette.ClearBuffer(); }
+		static void UploadToGPU(SkinPaletteBuffer& palette) { palette.UploadToGPU(); }
+	};
+}//namespace
@@ -67,20 +67,43 @@ namespace sh::render
 
 		SH_RENDER_API void SetSRGB(bool bSRGB);
 		SH_RENDER_API void SetFiltering(Filtering filter);
+		/// @brief 블록 압축 설정을 지정한다. 압축되지 않은 RGBA8 텍스쳐라면 모든 밉을 압축하고 포맷을 변경한다.
+		/// @brief 이미 압축된 텍스쳐는 설정만 바뀌며 원본에서 다시 임포트 할 때 적용된다.
+		/// @param compression 압축 설정
+		SH_RENDER_API void SetCompression(TextureCompression compression);
+
+		/// @brief GPU에 올라갈 가장 높은 해상도의 밉을 바꾼다. 그보다 높은 해상도의 밉은 메모리에서 해제된다.
+		/// @brief [주의] 동기화 타이밍에 텍스쳐 버퍼가 재설정됨.
+		/// @param firstMip 올라갈 가장 높은 해상도의 밉
+		/// @param mips firstMip부터 차례대로의 밉 데이터. 이미 메모리에 있는 밉은 생략할 수 있다.
+		/// @return firstMip부터 마지막 밉까지의 데이터가 모두 준비되지 않았다면 false
+		SH_RENDER_API auto SetResidentMips(uint32_t firstMip, std::vector<std::vector<Byte>> mips) -> bool;
+		/// @brief GPU에 올린 후 CPU 메모리에서 해제할 밉을 지정한다. keepMip부터 마지막 밉까지는 메모리에 남는다.
+		/// @param keepMip 메모리에 남길 가장 높은 해상도의 밉. 0이면 모든 밉을 남긴다.
+		SH_RENDER_API void SetPixelDataKeepMip(uint32_t keepMip);
 
 		SH_RENDER_API void ExportToPNG(const std::filesystem::path& path);
 
 		SH_RENDER_API auto GetMipLevel() const -> uint32_t;
+		/// @brief GPU에 올라간 밉들이 차지하는 바이트 수
+		SH_RENDER_API auto GetResidentSize() const -> std::size_t;
+		auto GetResidentMip() const -> uint32_t { return residentMip; }
+		auto GetPixelDataKeepMip() const -> uint32_t { return keepMip; }
 		auto GetContext() const -> const IRenderContext* { return context; }
 		auto GetTextureFormat() const -> TextureFormat { return format; }
 		auto GetWidth() const -> uint32_t { return width; }
 		auto GetHeight() const -> uint32_t { return height; }
 		auto GetFiltering() const -> Filtering { return filtering; }
+		auto GetCompression() const -> TextureCompression { return compression; }
 		auto IsSRGB() const -> bool { return bSRGB; }
 		auto GetAnisoLevel() const -> uint32_t { return aniso; }
 		auto IsGenerateMipmap() const -> bool { return bGenerateMipmap; }
 	private:
 		void CreateTextureBuffer();
+		/// @brief 장치가 블록 압축을 지원하지 않을 때 밉을 RGBA8로 풀고 포맷을 바꾼다.
+		void DecompressForContext();
+		/// @brief 업로드 된 밉 중 keepMip보다 해상도가 높은 밉을 CPU 메모리에서 해제한다.
+		void ReleaseUploadedPixelData();
 		auto CheckSRGB() const -> bool;
 	public:
 		mutable core::Observer<false, const Texture*> onBufferUpdate;
@@ -107,6 +130,13 @@ namespace sh::render
 		bool bSRGB = false;
 		PROPERTY(bGenerateMipmap)
 		bool bGenerateMipmap = true;
+		PROPERTY(compression)
+		TextureCompression compression = TextureCompression::None;
 		bool bSetDataDirty = false;
+
+		/// @brief GPU에 올라간 가장 높은 해상도의 밉
+		uint32_t residentMip = 0;
+		/// @brief 업로드 후에도 CPU 메모리에 남는 가장 높은 해상도의 밉
+		uint32_t keepMip = 0;
 	};
 }//namespace
\ No newline at end of file
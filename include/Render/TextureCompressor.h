@@ -0,0 +1,54 @@
+﻿#pragma once
+#include "Export.h"
+#include "Formats.hpp"
+
+#include <cstdint>
+#include <vector>
+namespace sh::render
+{
+	/// @brief RGBA8 픽셀을 BC1/BC3/BC4/BC5/BC7 블록으로 압축하는 CPU 인코더. 블록 압축을 지원하지 않는 장치를 위해 푸는 기능도 있다.
+	/// @brief 블록 끝점은 채널 범위(바운딩 박스)에서 구하고 인덱스는 끝점을 잇는 축에 투영해서 고른다. 가능하면 SSE2를 사용한다.
+	class TextureCompressor
+	{
+	public:
+		/// @brief 압축 설정에 맞는 압축 포맷을 반환한다.
+		/// @param compression 압축 설정
+		/// @param bSRGB SRGB 텍스쳐인지
+		/// @param bHasAlpha 알파 값을 사용하는지
+		/// @return 압축 포맷. 압축하지 않는 설정이면 TextureFormat::None
+		SH_RENDER_API static auto GetCompressedFormat(TextureCompression compression, bool bSRGB, bool bHasAlpha) -> TextureFormat;
+		/// @brief 압축 포맷에 대응하는 압축 설정을 반환한다.
+		SH_RENDER_API static auto GetCompression(TextureFormat format) -> TextureCompression;
+		/// @brief 불투명하지 않은 픽셀이 있는지 검사한다.
+		/// @param rgba RGBA8 픽셀
+		SH_RENDER_API static auto HasAlpha(const std::vector<uint8_t>& rgba) -> bool;
+
+		/// @brief 모든 밉을 압축한다. 밉과 블록 줄 단위로 작업을 나눠 스레드 풀에서 병렬로 처리한다.
+		/// @param mips RGBA8 밉 데이터. 0번이 원본 크기
+		/// @param width 0번 밉의 너비
+		/// @param height 0번 밉의 높이
+		/// @param format 압축 포맷
+		/// @return 압축된 밉 데이터
+		SH_RENDER_API static auto Compress(const std::vector<std::vector<uint8_t>>& mips, uint32_t width, uint32_t height, TextureFormat format) -> std::vector<std::vector<uint8_t>>;
+		/// @brief 4x4 블록 하나를 압축한다.
+		/// @param block 행 우선으로 나열된 16개의 RGBA8 픽셀 (64바이트)
+		/// @param format 압축 포맷
+		/// @param out 출력 (GetTextureFormatBlockSize(format) 바이트)
+		SH_RENDER_API static void CompressBlock(const uint8_t* block, TextureFormat format, uint8_t* out);
+
+		/// @brief 압축 포맷을 풀었을 때의 RGBA8 포맷을 반환한다.
+		SH_RENDER_API static auto GetDecompressedFormat(TextureFormat format) -> TextureFormat;
+		/// @brief 모든 밉을 RGBA8로 푼다. 장치가 블록 압축을 지원하지 않을 때 쓴다.
+		/// @param mips 압축된 밉 데이터. 비어있는 밉은 결과에서도 비어있다.
+		/// @param width 0번 밉의 너비
+		/// @param height 0번 밉의 높이
+		/// @param format 압축 포맷
+		/// @return RGBA8 밉 데이터. 실패 시 빈 배열
+		SH_RENDER_API static auto Decompress(const std::vector<std::vector<uint8_t>>& mips, uint32_t width, uint32_t height, TextureFormat format) -> std::vector<std::vector<uint8_t>>;
+		/// @brief 4x4 블록 하나를 RGBA8로 푼다. BC7은 CompressBlock이 만드는 모드 6만 해석한다.
+		/// @param in 압축된 블록 (GetTextureFormatBlockSize(format) 바이트)
+		/// @param format 압축 포맷
+		/// @param block 출력. 행 우선으로 나열된 16개의 RGBA8 픽셀 (64바이트)
+		SH_RENDER_API static void DecompressBlock(const uint8_t* in, TextureFormat format, uint8_t* block);
+	};
+}//namespace
@@ -83,7 +83,7 @@ namespace sh::render::vk
         void BindCameraSet(const Material& mat, const ShaderPass& pass, VkPipelineLayout pipelineLayout, uint32_t cameraOffset);
         void BindMaterialSet(const Material& mat, const ShaderPass& pass, VkPipelineLayout pipelineLayout);
         void BindObjectSet(const Drawable& drawable, const ShaderPass& pass, VkPipelineLayout pipelineLayout);
-        void BindMesh(const Mesh& mesh, uint32_t subMeshIdx, bool bSkinned);
+        void BindMesh(const Mesh& mesh, uint32_t subMeshIdx, uint32_t lod, bool bSkinned);
     private:
         struct RenderState
         {
@@ -2,6 +2,7 @@
 #include "Render/Export.h"
 #include "Render/IRenderContext.h"
 #include "Render/RenderDataManager.h"
+#include "Render/SkinPaletteBuffer.h"
 #include "VulkanConfig.h"
 
 #include "Core/ISyncable.h"
@@ -51,6 +52,9 @@ namespace sh::render::vk
 		              auto GetViewportEnd() const -> const glm::vec2& override { return viewportEnd; }
 					  auto GetRenderDataManager() const -> const RenderDataManager & override { return renderDataManager; }
 					  auto GetRenderDataManager() -> RenderDataManager& override { return renderDataManager; }
+					  auto GetSkinPaletteBuffer() const -> const SkinPaletteBuffer& override { return skinPaletteBuffer; }
+					  auto GetSkinPaletteBuffer() -> SkinPaletteBuffer& override { return skinPaletteBuffer; }
+					  auto IsTextureCompressionSupported() const -> bool override { return bTextureCompressionBC; }
 
 		SH_RENDER_API auto ReSizing() -> bool;
 
@@ -141,9 +145,11 @@ namespace sh::render::vk
 		mutable std::shared_mutex commandBufferMutex;
 
 		RenderDataManager renderDataManager;
+		SkinPaletteBuffer skinPaletteBuffer;
 
 		bool bInit = false;
 		bool bFindValidationLayer = false;
 		bool bEnableValidationLayers = false;
+		bool bTextureCompressionBC = false;
 	};
 }//namespace
\ No newline at end of file
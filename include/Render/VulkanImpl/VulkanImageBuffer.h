@@ -56,6 +56,8 @@ namespace sh::render::vk
 		SH_RENDER_API static auto ConvertTextureFormat(TextureFormat format) -> VkFormat;
 	private:
 		static auto GetFormatPixelSize(VkFormat format) -> uint32_t;
+		/// @brief 블록 압축 포맷의 4x4 블록 바이트 수. 압축 포맷이 아니면 0
+		static auto GetFormatBlockSize(VkFormat format) -> uint32_t;
 	private:
 		const VulkanContext* ctx = nullptr;
 
@@ -47,6 +47,7 @@ namespace sh::render::vk
 		/// @param renderTargetLayout 렌더 타겟
 		/// @param topology 메쉬 토폴로지
 		/// @param bSkinned 스키닝 메쉬인지
+		/// @param bQuantized 양자화된 버텍스 레이아웃인지. 스키닝 메쉬면 무시된다.
 		/// @param constPtr 상수 데이터 포인터
 		/// @return 파이프라인 핸들
 		SH_RENDER_API auto GetOrCreatePipelineHandle(
@@ -54,6 +55,7 @@ namespace sh::render::vk
 			const RenderTargetLayout& renderTargetLayout,
 			Mesh::Topology topology,
 			bool bSkinned = false,
+			bool bQuantized = false,
 			const std::vector<uint8_t>* constDataPtr = nullptr) -> PipelineHandle;
 
 		/// @brief vkCmdBindPipeline()의 래퍼 함수. 스레드 안전하다.
@@ -66,6 +68,7 @@ namespace sh::render::vk
 			const RenderTargetLayout& renderTargetLayout,
 			Mesh::Topology topology,
 			bool bSkinned,
+			bool bQuantized,
 			const std::vector<uint8_t>* constDataPtr) -> std::unique_ptr<VulkanPipeline>;
 
 		auto ConvertStencilState(const StencilState& stencilState) const->VkStencilOpState;
@@ -77,10 +80,11 @@ namespace sh::render::vk
 			Mesh::Topology topology;
 			std::size_t constantHash = 0;
 			bool bSkinned = false;
+			bool bQuantized = false;
 
 			bool operator==(const PipelineInfo& other) const
 			{
-				return renderTargetLayout == other.renderTargetLayout && shader == other.shader && topology == other.topology && constantHash == other.constantHash && bSkinned == other.bSkinned;
+				return renderTargetLayout == other.renderTargetLayout && shader == other.shader && topology == other.topology && constantHash == other.constantHash && bSkinned == other.bSkinned && bQuantized == other.bQuantized;
 			}
 		};
 		struct PipelineInfoHasher
@@ -98,6 +102,7 @@ namespace sh::render::vk
 				hash = Util::CombineHash(hash, intHasher(static_cast<int>(info.topology)));
 				hash = Util::CombineHash(hash, sizeHasher(info.constantHash));
 				hash = Util::CombineHash(hash, std::hash<bool>{}(info.bSkinned));
+				hash = Util::CombineHash(hash, std::hash<bool>{}(info.bQuantized));
 
 				return hash;
 			}
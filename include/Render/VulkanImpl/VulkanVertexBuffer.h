@@ -26,8 +26,10 @@ namespace sh::render::vk
 
 		SH_RENDER_API auto Clone() const -> std::unique_ptr<IVertexBuffer> override;
 
-		SH_RENDER_API static auto GetBindingDescription() -> VkVertexInputBindingDescription;
-		SH_RENDER_API static auto GetAttributeDescriptions() -> std::vector<VkVertexInputAttributeDescription>;
+		/// @param bQuantized Mesh::QuantizedVertex 레이아웃인지
+		SH_RENDER_API static auto GetBindingDescription(bool bQuantized = false) -> VkVertexInputBindingDescription;
+		/// @param bQuantized Mesh::QuantizedVertex 레이아웃인지
+		SH_RENDER_API static auto GetAttributeDescriptions(bool bQuantized = false) -> std::vector<VkVertexInputAttributeDescription>;
 
 		SH_RENDER_API auto GetVertexBuffer() const -> const VulkanBuffer& { return vertexBuffer; }
 		SH_RENDER_API auto GetIndexBuffer() const -> const VulkanBuffer& { return indexBuffer; }
@@ -40,5 +42,6 @@ namespace sh::render::vk
 		VulkanBuffer indexBuffer;
 
 		SH_RENDER_API static inline std::vector<VkVertexInputAttributeDescription> attribDescriptions;
+		SH_RENDER_API static inline std::vector<VkVertexInputAttributeDescription> quantizedAttribDescriptions;
 	};
 }
\ No newline at end of file
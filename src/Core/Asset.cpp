@@ -1,6 +1,40 @@
 ﻿#include "Asset.h"
+
+#include <unordered_set>
 namespace sh::core
 {
+	namespace
+	{
+		inline auto IsUUIDString(const std::string& str) -> bool
+		{
+			if (str.size() != 32)
+				return false;
+			for (char c : str)
+			{
+				if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+					return false;
+			}
+			return true;
+		}
+		void CollectUUIDsRecursive(const Json& json, std::unordered_set<UUID>& set, std::vector<UUID>& out)
+		{
+			if (json.is_object() || json.is_array())
+			{
+				for (const auto& item : json)
+					CollectUUIDsRecursive(item, set, out);
+			}
+			else if (json.is_string())
+			{
+				const std::string& str = json.get_ref<const std::string&>();
+				if (!IsUUIDString(str))
+					return;
+				UUID uuid{ str };
+				if (set.insert(uuid).second)
+					out.push_back(std::move(uuid));
+			}
+		}
+	}//namespace
+
 	Asset::Asset(const char* type) :
 		assetUUID(UUID::Generate()), type(type)
 	{
@@ -26,4 +60,15 @@ namespace sh::core
 	{
 		writeTime = time;
 	}
+	SH_CORE_API auto Asset::GetDependencies() const -> std::vector<UUID>
+	{
+		return {};
+	}
+	SH_CORE_API auto Asset::CollectUUIDs(const Json& json) const -> std::vector<UUID>
+	{
+		std::unordered_set<UUID> set{ assetUUID };
+		std::vector<UUID> uuids;
+		CollectUUIDsRecursive(json, set, uuids);
+		return uuids;
+	}
 }//namespace
\ No newline at end of file
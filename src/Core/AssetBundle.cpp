@@ -2,6 +2,11 @@
 #include "AssetExporter.h"
 #include "AssetImporter.h"
 #include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <unordered_set>
 namespace sh::core
 {
 	AssetBundle::AssetBundle()
@@ -12,24 +17,34 @@ namespace sh::core
 	AssetBundle::AssetBundle(AssetBundle&& other) noexcept :
 		header(other.header),
 		bundlePath(std::move(other.bundlePath)),
-		assetEntries(std::move(other.assetEntries)),
+		addedEntries(std::move(other.addedEntries)),
 		bundleData(std::move(other.bundleData)),
-		nextAssetDataOffset(other.nextAssetDataOffset),
-		bundleStream(std::move(other.bundleStream))
+		layoutOrder(std::move(other.layoutOrder)),
+		toc(std::exchange(other.toc, nullptr)),
+		tocSize(std::exchange(other.tocSize, 0)),
+		tocStorage(std::move(other.tocStorage)),
+		bundleStream(std::move(other.bundleStream)),
+		mappedFile(std::move(other.mappedFile)),
+		dataSectionOffset(other.dataSectionOffset)
 	{
 	}
 	SH_CORE_API void AssetBundle::Clear()
 	{
 		bundleStream.clear();
 		bundleStream.close();
+		mappedFile.Close();
+
+		toc = nullptr;
+		tocSize = 0;
+		tocStorage.clear();
 
-		assetEntries.clear();
+		addedEntries.clear();
 		bundleData.clear();
-		nextAssetDataOffset = 0;
+		layoutOrder.clear();
 	}
 	SH_CORE_API auto AssetBundle::AddAsset(const Asset& asset, bool bCompress) -> bool
 	{
-		if (assetEntries.find(asset.GetAssetUUID()) != assetEntries.end())
+		if (addedEntries.find(asset.GetAssetUUID()) != addedEntries.end())
 			return false;
 
 		std::size_t lastOffset = bundleData.size();
@@ -46,26 +61,38 @@ namespace sh::core
 		bundleData.resize(bundleData.size() + assetData.size());
 		std::memcpy(bundleData.data() + lastOffset, assetData.data(), assetData.size());
 
-		assetEntries.insert_or_assign(asset.GetAssetUUID(), entry);
+		addedEntries.insert_or_assign(asset.GetAssetUUID(), entry);
 		return true;
 	}
 	SH_CORE_API auto AssetBundle::HasAsset(const UUID& uuid) const -> bool
 	{
-		return assetEntries.find(uuid) != assetEntries.end();
+		if (IsLoaded())
+			return FindEntry(uuid) != nullptr;
+		return addedEntries.find(uuid) != addedEntries.end();
 	}
 	SH_CORE_API auto AssetBundle::IsLoaded() const -> bool
 	{
-		return bundleStream.is_open();
+		return mappedFile.IsOpen() || bundleStream.is_open();
 	}
 	SH_CORE_API auto AssetBundle::GetAllAssetUUIDs() const -> std::vector<UUID>
 	{
 		std::vector<UUID> uuids;
-		uuids.reserve(assetEntries.size());
-
-		for (const auto& pair : assetEntries)
+		if (IsLoaded())
+		{
+			uuids.reserve(tocSize);
+			for (std::size_t i = 0; i < tocSize; ++i)
+				uuids.push_back(UUID{ toc[i].uuid });
+			return uuids;
+		}
+		uuids.reserve(addedEntries.size());
+		for (const auto& pair : addedEntries)
 			uuids.push_back(pair.first);
 		return uuids;
 	}
+	SH_CORE_API void AssetBundle::SetLayoutOrder(const std::vector<UUID>& order)
+	{
+		layoutOrder = order;
+	}
 	SH_CORE_API auto AssetBundle::SaveBundle(const std::filesystem::path& path) const -> bool
 	{
 		bundleStream.clear();
@@ -80,45 +107,93 @@ namespace sh::core
 			return false;
 		}
 
+		// 레이아웃 순서에 있는 에셋들을 먼저, 나머지는 추가된 순서대로 쓴다.
+		std::vector<const AssetEntry*> dataOrder;
+		dataOrder.reserve(addedEntries.size());
+		std::unordered_set<UUID> written;
+		for (const UUID& uuid : layoutOrder)
+		{
+			auto it = addedEntries.find(uuid);
+			if (it == addedEntries.end() || !written.insert(uuid).second)
+				continue;
+			dataOrder.push_back(&it->second);
+		}
+		std::vector<const AssetEntry*> rest;
+		for (const auto& [uuid, entry] : addedEntries)
+		{
+			if (written.find(uuid) == written.end())
+				rest.push_back(&entry);
+		}
+		std::sort(rest.begin(), rest.end(), [](const AssetEntry* a, const AssetEntry* b) { return a->dataOffset < b->dataOffset; });
+		dataOrder.insert(dataOrder.end(), rest.begin(), rest.end());
+
+		std::vector<AssetEntry> entries;
+		entries.reserve(dataOrder.size());
+		uint64_t offset = 0;
+		for (const AssetEntry* entry : dataOrder)
+		{
+			entries.push_back(*entry);
+			entries.back().dataOffset = offset;
+			offset += entry->dataSize;
+		}
+		std::sort(entries.begin(), entries.end(), [](const AssetEntry& a, const AssetEntry& b) { return a.uuid < b.uuid; });
+
 		Header header{};
 		header.version = VERSION;
-		header.numAssets = static_cast<uint32_t>(assetEntries.size());
+		header.numAssets = static_cast<uint32_t>(entries.size());
 
 		bundleStream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		if (!entries.empty())
+			bundleStream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetEntry));
+		for (const AssetEntry* entry : dataOrder)
+			bundleStream.write(reinterpret_cast<const char*>(bundleData.data() + entry->dataOffset), entry->dataSize);
 
-		for (const auto& pair : assetEntries)
-		{
-			const AssetEntry& entry = pair.second;
-			bundleStream.write(reinterpret_cast<const char*>(&entry), sizeof(AssetEntry));
-		}
-		if (!bundleData.empty())
-		{
-			bundleStream.write(reinterpret_cast<const char*>(bundleData.data()), bundleData.size());
-		}
+		const bool bSuccess = static_cast<bool>(bundleStream);
 		bundleStream.close();
-		return true;
+		return bSuccess;
 	}
-	SH_CORE_API auto AssetBundle::LoadBundle(const std::filesystem::path& path) -> bool
+	SH_CORE_API auto AssetBundle::LoadBundle(const std::filesystem::path& path, bool bMemoryMapped) -> bool
 	{
-		bundleStream.clear();
+		if (IsLoaded())
+			Clear();
 
-		if (!bundleStream.is_open())
+		if (bMemoryMapped && mappedFile.Open(path))
 		{
-			bundleStream.open(path, std::ios::binary | std::ios::in);
-			if (!bundleStream.is_open())
+			const uint8_t* ptr = mappedFile.GetData();
+			const std::size_t size = mappedFile.GetSize();
+			if (size < sizeof(Header))
 			{
-				SH_ERROR_FORMAT("Could not open file for reading: {}", path.u8string());
+				SH_ERROR_FORMAT("Invalid bundle file: {}", path.u8string());
+				Clear();
 				return false;
 			}
+			std::memcpy(&header, ptr, sizeof(Header));
+			if (header.version != VERSION)
+			{
+				SH_WARN_FORMAT("AssetBundle version mismatch. Expected {}, found {}. Loading might fail.", VERSION, header.version);
+			}
+
+			dataSectionOffset = sizeof(Header) + static_cast<std::size_t>(header.numAssets) * sizeof(AssetEntry);
+			if (dataSectionOffset > size)
+			{
+				SH_ERROR_FORMAT("Invalid bundle file: {}", path.u8string());
+				Clear();
+				return false;
+			}
+			bundlePath = path;
+			// 매핑의 시작은 페이지 경계이고 헤더가 8바이트이므로 목록은 정렬돼 있다.
+			SetupTOC(reinterpret_cast<const AssetEntry*>(ptr + sizeof(Header)), header.numAssets, size - dataSectionOffset);
+			return true;
 		}
-		else
+
+		bundleStream.clear();
+		bundleStream.open(path, std::ios::binary | std::ios::in);
+		if (!bundleStream.is_open())
 		{
-			Clear();
-			return LoadBundle(path);
+			SH_ERROR_FORMAT("Could not open file for reading: {}", path.u8string());
+			return false;
 		}
 
-		assetEntries.clear();
-
 		bundleStream.read(reinterpret_cast<char*>(&header), sizeof(Header));
 
 		if (header.version != VERSION)
@@ -126,49 +201,170 @@ namespace sh::core
 			SH_WARN_FORMAT("AssetBundle version mismatch. Expected {}, found {}. Loading might fail.", VERSION, header.version);
 		}
 
-		for (uint32_t i = 0; i < header.numAssets; ++i)
+		std::vector<AssetEntry> entries(header.numAssets);
+		if (!entries.empty())
+			bundleStream.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(AssetEntry));
+		if (!bundleStream)
 		{
-			AssetEntry entry{};
-			bundleStream.read(reinterpret_cast<char*>(&entry), sizeof(AssetEntry));
-			assetEntries.insert_or_assign(UUID{ entry.uuid }, entry);
+			SH_ERROR_FORMAT("Invalid bundle file: {}", path.u8string());
+			Clear();
+			return false;
 		}
+		dataSectionOffset = sizeof(Header) + static_cast<std::size_t>(header.numAssets) * sizeof(AssetEntry);
 
+		std::error_code ec;
+		const auto fileSize = std::filesystem::file_size(path, ec);
+		const std::size_t dataSectionSize = !ec && fileSize > dataSectionOffset ? static_cast<std::size_t>(fileSize) - dataSectionOffset : 0;
 		bundlePath = path;
+		tocStorage = std::move(entries);
+		SetupTOC(tocStorage.data(), tocStorage.size(), dataSectionSize);
 		return true;
 	}
-	SH_CORE_API auto AssetBundle::LoadAsset(const core::UUID& uuid) -> std::unique_ptr<Asset>
+	SH_CORE_API auto AssetBundle::IsMemoryMapped() const -> bool
 	{
-		assert(!bundlePath.empty());
-
-		bundleStream.clear();
-
-		if (!bundleStream.is_open())
+		return mappedFile.IsOpen();
+	}
+	SH_CORE_API auto AssetBundle::LoadAsset(const core::UUID& uuid) const -> std::unique_ptr<Asset>
+	{
+		if (mappedFile.IsOpen())
 		{
-			SH_ERROR("Call LoadBundle() first");
+			const ArrayView<const uint8_t> view = GetAssetView(uuid);
+			if (view.size() == 0)
+				return nullptr;
+			return AssetImporter::LoadFromMemory(view.data(), view.size());
+		}
+		std::vector<uint8_t> data;
+		if (!ReadAssetData(uuid, data))
 			return nullptr;
+		return AssetImporter::LoadFromMemory(data);
+	}
+	SH_CORE_API auto AssetBundle::ReadAssetData(const core::UUID& uuid, std::vector<uint8_t>& out) const -> bool
+	{
+		if (!IsLoaded())
+		{
+			SH_ERROR("Call LoadBundle() first");
+			return false;
 		}
-		auto it = assetEntries.find(uuid);
-		if (it == assetEntries.end())
+		if (mappedFile.IsOpen())
+		{
+			const ArrayView<const uint8_t> view = GetAssetView(uuid);
+			if (view.size() == 0)
+				return false;
+			out.assign(view.data(), view.data() + view.size());
+			return true;
+		}
+
+		const AssetEntry* entry = FindEntry(uuid);
+		if (entry == nullptr)
 		{
 			SH_ERROR_FORMAT("Asset({}) is not exist in bundle", uuid.ToString());
-			return nullptr;
+			return false;
 		}
-		const AssetEntry& entry = it->second;
 
-		auto dataSectionOffset = sizeof(Header) + assetEntries.size() * sizeof(AssetEntry);
-		bundleStream.seekg(dataSectionOffset + static_cast<std::streampos>(entry.dataOffset));
+		out.resize(entry->dataSize);
 
-		std::vector<uint8_t> data(entry.dataSize);
-		bundleStream.read(reinterpret_cast<char*>(data.data()), entry.dataSize);
+		std::lock_guard<std::mutex> lock{ streamMutex };
+		bundleStream.clear();
+		bundleStream.seekg(dataSectionOffset + static_cast<std::streampos>(entry->dataOffset));
+		bundleStream.read(reinterpret_cast<char*>(out.data()), entry->dataSize);
+		return static_cast<bool>(bundleStream);
+	}
+	SH_CORE_API auto AssetBundle::GetAssetView(const core::UUID& uuid) const -> ArrayView<const uint8_t>
+	{
+		if (!mappedFile.IsOpen())
+			return ArrayView<const uint8_t>{ nullptr, 0 };
 
-		return AssetImporter::LoadFromMemory(data);
+		const AssetEntry* entry = FindEntry(uuid);
+		if (entry == nullptr)
+		{
+			SH_ERROR_FORMAT("Asset({}) is not exist in bundle", uuid.ToString());
+			return ArrayView<const uint8_t>{ nullptr, 0 };
+		}
+		return ArrayView<const uint8_t>{ mappedFile.GetData() + dataSectionOffset + entry->dataOffset, static_cast<std::size_t>(entry->dataSize) };
+	}
+	SH_CORE_API void AssetBundle::Prefetch(const std::vector<UUID>& uuids) const
+	{
+		if (!mappedFile.IsOpen())
+			return;
+
+		std::vector<std::pair<std::size_t, std::size_t>> ranges;
+		ranges.reserve(uuids.size());
+		for (const UUID& uuid : uuids)
+		{
+			const AssetEntry* entry = FindEntry(uuid);
+			if (entry == nullptr)
+				continue;
+			ranges.push_back({ dataSectionOffset + entry->dataOffset, static_cast<std::size_t>(entry->dataSize) });
+		}
+		std::sort(ranges.begin(), ranges.end());
+
+		// 붙어있는 에셋들은 한 번에 요청해서 시스템 콜 수를 줄인다.
+		std::size_t begin = 0;
+		std::size_t end = 0;
+		for (const auto& [offset, size] : ranges)
+		{
+			if (end != 0 && offset <= end)
+			{
+				end = std::max(end, offset + size);
+				continue;
+			}
+			if (end != 0)
+				mappedFile.Prefetch(begin, end - begin);
+			begin = offset;
+			end = offset + size;
+		}
+		if (end != 0)
+			mappedFile.Prefetch(begin, end - begin);
 	}
 	SH_CORE_API auto AssetBundle::GetVersion() const -> uint32_t
 	{
 		return header.version;
 	}
-	SH_CORE_API auto AssetBundle::GetAssetEntries() const -> const std::unordered_map<UUID, AssetEntry>&
+	SH_CORE_API auto AssetBundle::GetAssetEntries() const -> ArrayView<const AssetEntry>
+	{
+		return ArrayView<const AssetEntry>{ toc, tocSize };
+	}
+
+	auto AssetBundle::FindEntry(const UUID& uuid) const -> const AssetEntry*
 	{
-		return assetEntries;
+		const std::array<uint32_t, 4>& raw = uuid.GetRawData();
+		const AssetEntry* end = toc + tocSize;
+		const AssetEntry* it = std::lower_bound(toc, end, raw, [](const AssetEntry& entry, const std::array<uint32_t, 4>& raw) { return entry.uuid < raw; });
+		if (it == end || it->uuid != raw)
+			return nullptr;
+		return it;
+	}
+	void AssetBundle::SetupTOC(const AssetEntry* entries, std::size_t count, std::size_t dataSectionSize)
+	{
+		const auto isInRange =
+			[dataSectionSize](const AssetEntry& entry)
+			{
+				return entry.dataOffset <= dataSectionSize && entry.dataSize <= dataSectionSize - entry.dataOffset;
+			};
+		const auto isLess = [](const AssetEntry& a, const AssetEntry& b) { return a.uuid < b.uuid; };
+
+		const bool bSorted = std::is_sorted(entries, entries + count, isLess);
+		const bool bInRange = std::all_of(entries, entries + count, isInRange);
+		if (bSorted && bInRange)
+		{
+			toc = entries;
+			tocSize = count;
+			return;
+		}
+
+		// 이전 버전의 번들이거나 잘린 파일이다. 쓸 수 있는 항목만 따로 정렬해둔다.
+		std::vector<AssetEntry> valid;
+		valid.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (isInRange(entries[i]))
+				valid.push_back(entries[i]);
+			else
+				SH_ERROR_FORMAT("Asset({}) is out of bundle range: {}", UUID{ entries[i].uuid }.ToString(), bundlePath.u8string());
+		}
+		std::sort(valid.begin(), valid.end(), isLess);
+		tocStorage = std::move(valid);
+		toc = tocStorage.data();
+		tocSize = tocStorage.size();
 	}
-}//namespace
\ No newline at end of file
+}//namespace
@@ -0,0 +1,46 @@
+﻿#include "AssetBundleLayout.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+namespace sh::core
+{
+	SH_CORE_API void AssetBundleLayout::AddDependencies(const UUID& uuid, const std::vector<UUID>& deps)
+	{
+		std::vector<UUID>& list = dependencies[uuid];
+		list.insert(list.end(), deps.begin(), deps.end());
+	}
+	SH_CORE_API void AssetBundleLayout::AddRoot(const UUID& root)
+	{
+		if (std::find(roots.begin(), roots.end(), root) == roots.end())
+			roots.push_back(root);
+	}
+	SH_CORE_API auto AssetBundleLayout::Build() const -> std::vector<UUID>
+	{
+		std::vector<UUID> order;
+		std::unordered_set<UUID> visited;
+		std::deque<UUID> queue;
+		for (const UUID& root : roots)
+		{
+			if (!visited.insert(root).second)
+				continue;
+			queue.push_back(root);
+			while (!queue.empty())
+			{
+				const UUID uuid = queue.front();
+				queue.pop_front();
+				order.push_back(uuid);
+
+				auto it = dependencies.find(uuid);
+				if (it == dependencies.end())
+					continue;
+				for (const UUID& dep : it->second)
+				{
+					if (visited.insert(dep).second)
+						queue.push_back(dep);
+				}
+			}
+		}
+		return order;
+	}
+}//namespace
@@ -26,6 +26,8 @@ namespace sh::core
 	}
 	SH_CORE_API auto AssetImporter::LoadFromMemory(const uint8_t* ptr, std::size_t size) -> std::unique_ptr<Asset>
 	{
+		if (ptr == nullptr || size < sizeof(Asset::Header))
+			return nullptr;
 		Asset::Header header{};
 		std::memcpy(&header, ptr, sizeof(Asset::Header));
 
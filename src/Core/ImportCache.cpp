@@ -0,0 +1,113 @@
+﻿#include "ImportCache.h"
+#include "AssetImporter.h"
+#include "FileSystem.h"
+#include "Logger.h"
+#include "Util.h"
+
+#include "fmt/core.h"
+
+#include <cstring>
+namespace sh::core
+{
+	SH_CORE_API auto ImportCache::MakeKey(uint64_t sourceHash, const uint8_t* meta, std::size_t metaSize, uint32_t importerVersion) -> uint64_t
+	{
+		const uint64_t metaHash = Util::Hash64(meta, metaSize, sourceHash);
+		const uint32_t versions[2] = { importerVersion, Asset::VERSION };
+		return Util::Hash64(versions, sizeof(versions), metaHash);
+	}
+	SH_CORE_API void ImportCache::SetPath(const std::filesystem::path& dir)
+	{
+		cachePath = dir;
+		std::error_code ec;
+		if (!std::filesystem::exists(cachePath, ec))
+			std::filesystem::create_directories(cachePath, ec);
+		if (ec)
+			SH_ERROR_FORMAT("Can't create import cache directory ({}): {}", ec.message(), cachePath.u8string());
+	}
+	SH_CORE_API auto ImportCache::GetFile(uint64_t key) const -> std::filesystem::path
+	{
+		return cachePath / fmt::format("{:016x}.asset", key);
+	}
+	SH_CORE_API auto ImportCache::Store(uint64_t key, const std::vector<uint8_t>& assetBlob) const -> bool
+	{
+		Header header{};
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.key = key;
+		header.blobHash = Util::Hash64(assetBlob.data(), assetBlob.size());
+		header.blobSize = assetBlob.size();
+
+		std::vector<uint8_t> file(sizeof(Header) + assetBlob.size());
+		std::memcpy(file.data(), &header, sizeof(Header));
+		if (!assetBlob.empty())
+			std::memcpy(file.data() + sizeof(Header), assetBlob.data(), assetBlob.size());
+
+		// 쓰다가 중단돼도 반쯤 쓰인 파일이 키 이름으로 남지 않도록 임시 파일에 쓰고 옮긴다.
+		const std::filesystem::path path = GetFile(key);
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+		if (!FileSystem::SaveBinary(file, tempPath))
+		{
+			SH_ERROR_FORMAT("Failed to write import cache: {}", path.u8string());
+			return false;
+		}
+		std::error_code ec;
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec)
+		{
+			SH_ERROR_FORMAT("Failed to write import cache ({}): {}", ec.message(), path.u8string());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		return true;
+	}
+	SH_CORE_API auto ImportCache::StoreFile(uint64_t key, const std::filesystem::path& assetFile) const -> bool
+	{
+		auto blobOpt = FileSystem::LoadBinary(assetFile);
+		if (!blobOpt.has_value())
+			return false;
+		return Store(key, blobOpt.value());
+	}
+	SH_CORE_API auto ImportCache::LoadBlob(uint64_t key) const -> std::optional<std::vector<uint8_t>>
+	{
+		const std::filesystem::path path = GetFile(key);
+		std::error_code ec;
+		if (!std::filesystem::exists(path, ec))
+			return {};
+		auto fileOpt = FileSystem::LoadBinary(path);
+		if (!fileOpt.has_value())
+			return {};
+		const std::vector<uint8_t>& file = fileOpt.value();
+
+		Header header{};
+		bool bValid = file.size() >= sizeof(Header);
+		if (bValid)
+		{
+			std::memcpy(&header, file.data(), sizeof(Header));
+			bValid = header.magic == MAGIC && header.version == VERSION && header.key == key &&
+				header.blobSize == file.size() - sizeof(Header) &&
+				header.blobHash == Util::Hash64(file.data() + sizeof(Header), file.size() - sizeof(Header));
+		}
+		if (!bValid)
+		{
+			SH_ERROR_FORMAT("Corrupted import cache: {}", path.u8string());
+			std::filesystem::remove(path, ec);
+			return {};
+		}
+		return std::vector<uint8_t>(file.begin() + sizeof(Header), file.end());
+	}
+	SH_CORE_API auto ImportCache::Load(uint64_t key) const -> std::unique_ptr<Asset>
+	{
+		auto blobOpt = LoadBlob(key);
+		if (!blobOpt.has_value())
+			return nullptr;
+		return AssetImporter::LoadFromMemory(blobOpt.value());
+	}
+	SH_CORE_API auto ImportCache::Restore(uint64_t key, const std::filesystem::path& assetFile) const -> bool
+	{
+		auto blobOpt = LoadBlob(key);
+		if (!blobOpt.has_value())
+			return false;
+		return FileSystem::SaveBinary(blobOpt.value(), assetFile);
+	}
+}//namespace
@@ -0,0 +1,156 @@
+﻿#include "MappedFile.h"
+#include "Logger.h"
+
+#include <utility>
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace sh::core
+{
+	namespace
+	{
+		inline auto GetPageSize() -> std::size_t
+		{
+#if _WIN32
+			SYSTEM_INFO info{};
+			GetSystemInfo(&info);
+			return static_cast<std::size_t>(info.dwPageSize);
+#else
+			return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+	}//namespace
+
+	SH_CORE_API MappedFile::MappedFile() = default;
+	SH_CORE_API MappedFile::MappedFile(MappedFile&& other) noexcept :
+		data(std::exchange(other.data, nullptr)),
+		size(std::exchange(other.size, 0))
+#if _WIN32
+		, fileHandle(std::exchange(other.fileHandle, nullptr)),
+		mappingHandle(std::exchange(other.mappingHandle, nullptr))
+#endif
+	{
+	}
+	SH_CORE_API MappedFile::~MappedFile()
+	{
+		Close();
+	}
+	SH_CORE_API auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+	{
+		if (this == &other)
+			return *this;
+		Close();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+#if _WIN32
+		fileHandle = std::exchange(other.fileHandle, nullptr);
+		mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+		return *this;
+	}
+	SH_CORE_API auto MappedFile::Open(const std::filesystem::path& path) -> bool
+	{
+		Close();
+#if _WIN32
+		HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			SH_ERROR_FORMAT("Could not open file for mapping: {}", path.u8string());
+			return false;
+		}
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			// 크기가 0인 파일은 매핑할 수 없다.
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			SH_ERROR_FORMAT("CreateFileMapping failed ({}): {}", GetLastError(), path.u8string());
+			CloseHandle(file);
+			return false;
+		}
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			SH_ERROR_FORMAT("MapViewOfFile failed ({}): {}", GetLastError(), path.u8string());
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+		fileHandle = file;
+		mappingHandle = mapping;
+		data = static_cast<const uint8_t*>(view);
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+		return true;
+#else
+		const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			SH_ERROR_FORMAT("Could not open file for mapping: {}", path.u8string());
+			return false;
+		}
+		struct stat st{};
+		if (fstat(fd, &st) == -1 || st.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+		void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		// 매핑은 파일 디스크립터를 닫아도 유지된다.
+		close(fd);
+		if (view == MAP_FAILED)
+		{
+			SH_ERROR_FORMAT("mmap failed: {}", path.u8string());
+			return false;
+		}
+		data = static_cast<const uint8_t*>(view);
+		size = static_cast<std::size_t>(st.st_size);
+		return true;
+#endif
+	}
+	SH_CORE_API void MappedFile::Close()
+	{
+		if (data == nullptr)
+			return;
+#if _WIN32
+		UnmapViewOfFile(data);
+		CloseHandle(static_cast<HANDLE>(mappingHandle));
+		CloseHandle(static_cast<HANDLE>(fileHandle));
+		mappingHandle = nullptr;
+		fileHandle = nullptr;
+#else
+		munmap(const_cast<uint8_t*>(data), size);
+#endif
+		data = nullptr;
+		size = 0;
+	}
+	SH_CORE_API void MappedFile::Prefetch(std::size_t offset, std::size_t len) const
+	{
+		if (data == nullptr || offset >= size || len == 0)
+			return;
+		if (len > size - offset)
+			len = size - offset;
+
+		// 페이지 경계에 맞춰야 한다.
+		static const std::size_t pageSize = GetPageSize();
+		const std::size_t begin = offset - offset % pageSize;
+		const std::size_t end = offset + len;
+#if _WIN32
+		WIN32_MEMORY_RANGE_ENTRY range{};
+		range.VirtualAddress = const_cast<uint8_t*>(data + begin);
+		range.NumberOfBytes = end - begin;
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+		madvise(const_cast<uint8_t*>(data + begin), end - begin, MADV_WILLNEED);
+#endif
+	}
+}//namespace
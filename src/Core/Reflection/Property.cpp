@@ -13,13 +13,15 @@ namespace sh::core::reflection
 		bConstProperty(other.bConstProperty),
 		bVisibleProperty(other.bVisibleProperty),
 		bNoSaveProperty(other.bNoSaveProperty),
+		bReplicatedProperty(other.bReplicatedProperty),
 		isConst(other.isConst),
 		isPointer(other.isPointer),
 		isContainer(other.isContainer),
 		isSObject(other.isSObject),
 		isSObjectPointer(other.isSObjectPointer),
 		isSObjectPointerContainer(other.isSObjectPointerContainer),
-		isEnum(other.isEnum)
+		isEnum(other.isEnum),
+		isTriviallyCopyable(other.isTriviallyCopyable)
 	{
 	}
 	SH_CORE_API auto Property::operator==(const Property& other) -> bool
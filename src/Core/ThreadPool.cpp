@@ -1,5 +1,6 @@
 ﻿#include "ThreadPool.h"
 
+#include <algorithm>
 namespace sh::core
 {
 	ThreadPool::ThreadPool()
@@ -60,6 +61,34 @@ namespace sh::core
 		std::unique_lock<std::mutex> lock{ mu };
 		cvDone.wait(lock, [this] {return tasks.empty() && counter == 0; });
 	}
+	SH_CORE_API void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t begin, std::size_t end)>& fn, std::size_t minChunk)
+	{
+		if (count == 0)
+			return;
+		// 모든 구간이 minChunk 이상이 되도록 나눈다.
+		const std::size_t chunkCount = std::min<std::size_t>(GetThreadNum() + 1, count / std::max<std::size_t>(minChunk, 1));
+		if (chunkCount <= 1 || !IsInit() || IsWorkerThread())
+		{
+			fn(0, count);
+			return;
+		}
+		const std::size_t perChunk = count / chunkCount;
+		const std::size_t rest = count % chunkCount;
+
+		// 호출한 스레드가 직접 기다리므로 WaitAllTask()가 기다릴 필요는 없다.
+		std::vector<std::future<void>> futures;
+		futures.reserve(chunkCount - 1);
+		std::size_t begin = 0;
+		for (std::size_t chunk = 0; chunk < chunkCount - 1; ++chunk)
+		{
+			const std::size_t end = begin + perChunk + (chunk < rest ? 1 : 0);
+			futures.push_back(AddContinousTask([&fn, begin, end] { fn(begin, end); }));
+			begin = end;
+		}
+		fn(begin, count);
+		for (auto& future : futures)
+			future.wait();
+	}
 	SH_CORE_API void ThreadPool::Lock()
 	{
 		mu.lock();
@@ -81,4 +110,14 @@ namespace sh::core
 	{
 		return threads.size() > 1;
 	}
+	SH_CORE_API auto ThreadPool::IsWorkerThread() const -> bool
+	{
+		const std::thread::id id = std::this_thread::get_id();
+		for (const auto& thread : threads)
+		{
+			if (thread.get_id() == id)
+				return true;
+		}
+		return false;
+	}
 }//namepsace
\ No newline at end of file
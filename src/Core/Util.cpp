@@ -6,6 +6,7 @@
 #include <sstream>
 #include <iomanip>
 #include <regex>
+#include <cstring>
 
 #ifdef max
 #undef max
@@ -56,6 +57,66 @@ namespace sh::core {
 		return result;
 	}
 
+	auto Util::Hash64(const void* data, std::size_t size, uint64_t seed) -> uint64_t
+	{
+		constexpr uint64_t prime1 = 11400714785074694791ULL;
+		constexpr uint64_t prime2 = 14029467366897019727ULL;
+		constexpr uint64_t prime3 = 1609587929392839161ULL;
+		constexpr uint64_t prime4 = 9650029242287828579ULL;
+		constexpr uint64_t prime5 = 2870177450012600261ULL;
+
+		const auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+		const auto read64 = [](const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; };
+		const auto read32 = [](const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; };
+		const auto round = [&](uint64_t acc, uint64_t input) { return rotl(acc + input * prime2, 31) * prime1; };
+		const auto merge = [&](uint64_t acc, uint64_t val) { return (acc ^ round(0, val)) * prime1 + prime4; };
+
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + size;
+		uint64_t h;
+		if (size >= 32)
+		{
+			// 4개의 독립된 누산기로 처리한다.
+			uint64_t v1 = seed + prime1 + prime2;
+			uint64_t v2 = seed + prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - prime1;
+			const uint8_t* const limit = end - 32;
+			do
+			{
+				v1 = round(v1, read64(p));
+				v2 = round(v2, read64(p + 8));
+				v3 = round(v3, read64(p + 16));
+				v4 = round(v4, read64(p + 24));
+				p += 32;
+			} while (p <= limit);
+			h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+			h = merge(h, v1);
+			h = merge(h, v2);
+			h = merge(h, v3);
+			h = merge(h, v4);
+		}
+		else
+			h = seed + prime5;
+		h += static_cast<uint64_t>(size);
+
+		for (; p + 8 <= end; p += 8)
+			h = rotl(h ^ round(0, read64(p)), 27) * prime1 + prime4;
+		if (p + 4 <= end)
+		{
+			h = rotl(h ^ (static_cast<uint64_t>(read32(p)) * prime1), 23) * prime2 + prime3;
+			p += 4;
+		}
+		for (; p < end; ++p)
+			h = rotl(h ^ (*p * prime5), 11) * prime1;
+
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		h *= prime3;
+		h ^= h >> 32;
+		return h;
+	}
 	auto Util::AlignTo(uint32_t value, uint32_t alignment) -> uint32_t
 	{
 		// ex) value = 20, alignment = 16
@@ -8,6 +8,8 @@
 #include "Core/AssetImporter.h"
 #include "Core/AssetExporter.h"
 #include "Core/Logger.h"
+#include "Core/Util.h"
+#include "Core/ThreadPool.h"
 
 #include "Render/Renderer.h"
 #include "Render/Model.h"
@@ -31,6 +33,7 @@
 #include "Game/Asset/FontLoader.h"
 #include "Game/Asset/ScriptableObjectLoader.h"
 #include "Game/Asset/ComputeShaderLoader.h"
+#include "Game/Asset/AnimationClipLoader.h"
 
 #include "Game/Asset/TextureAsset.h"
 #include "Game/Asset/ModelAsset.h"
@@ -45,6 +48,7 @@
 #include "Game/Asset/FontAsset.h"
 #include "Game/Asset/ScriptableObjectAsset.h"
 #include "Game/Asset/ComputeShaderAsset.h"
+#include "Game/Asset/AnimationClipAsset.h"
 
 #include "Sound/SoundClip.h"
 
@@ -55,8 +59,18 @@
 #include <fstream>
 #include <cstdint>
 #include <chrono>
+#include <unordered_map>
+#include <future>
 namespace sh::editor
 {
+	namespace
+	{
+		inline auto ElapsedMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) -> float
+		{
+			return std::chrono::duration<float, std::milli>(end - start).count();
+		}
+	}//namespace
+
 	AssetDatabase::AssetDatabase()
 	{
 		projectPath = std::filesystem::current_path();
@@ -78,6 +92,7 @@ namespace sh::editor
 		libPath = projectPath / "Library";
 		if (!std::filesystem::exists(libPath))
 			std::filesystem::create_directories(libPath);
+		SetImportCachePath(libPath / "ImportCache");
 
 		assert(ctx.GetRenderAPIType() == render::RenderAPI::Vulkan); // TODO
 		static render::vk::VulkanShaderPassBuilder passBuilder{ static_cast<const render::vk::VulkanContext&>(ctx) };
@@ -88,11 +103,12 @@ namespace sh::editor
 		computeShaderLoader->SetCachePath(projectPath / "temp");
 
 		assetLoaders.Clear();
-		assetLoaders.RegisterLoader(AssetExtensions::Type::Model, std::make_unique<game::ModelLoader>(ctx), 2, true);
-		assetLoaders.RegisterLoader(AssetExtensions::Type::Mesh, std::make_unique<game::MeshLoader>(ctx), 2, true);
+		assetLoaders.RegisterLoader(AssetExtensions::Type::Model, std::make_unique<game::ModelLoader>(ctx), 2, true, 4);
+		assetLoaders.RegisterLoader(AssetExtensions::Type::Mesh, std::make_unique<game::MeshLoader>(ctx), 2, true, 3);
+		assetLoaders.RegisterLoader(AssetExtensions::Type::AnimationClip, std::make_unique<game::AnimationClipLoader>(), 2, true);
 		assetLoaders.RegisterLoader(AssetExtensions::Type::Texture, std::make_unique<game::TextureLoader>(ctx), 2, true);
 		assetLoaders.RegisterLoader(AssetExtensions::Type::ComputeShader, std::move(computeShaderLoader), 2, false);
-		assetLoaders.RegisterLoader(AssetExtensions::Type::Shader, std::move(shaderLoader), 2, false);
+		assetLoaders.RegisterLoader(AssetExtensions::Type::Shader, std::move(shaderLoader), 2, false, 2);
 		assetLoaders.RegisterLoader(AssetExtensions::Type::Binary, std::make_unique<game::BinaryLoader>(), 2, false);
 		assetLoaders.RegisterLoader(AssetExtensions::Type::Sound, std::make_unique<game::SoundLoader>(), 2, false);
 		assetLoaders.RegisterLoader(AssetExtensions::Type::Text, std::make_unique<game::TextLoader>(), 2, false);
@@ -198,16 +214,104 @@ namespace sh::editor
 	}
 	SH_EDITOR_API void AssetDatabase::LoadAllAssets(const std::filesystem::path& dir, bool recursive, bool bOverLoad)
 	{
+		using Clock = std::chrono::steady_clock;
+		importStats = ImportStats{};
+
+		const auto scanStart = Clock::now();
 		LoadAllAssetsHelper(dir, recursive);
 
+		std::vector<AssetLoadData> loadDatas;
+		loadDatas.reserve(loadingAssetsQueue.size());
 		while (!loadingAssetsQueue.empty())
 		{
-			AssetLoadData data = std::move(const_cast<AssetLoadData&>(loadingAssetsQueue.top()));
+			loadDatas.push_back(std::move(const_cast<AssetLoadData&>(loadingAssetsQueue.top())));
 			loadingAssetsQueue.pop();
+		}
+
+		// 준비 단계: 파일 읽기, 해싱, 캐시 해석은 다른 에셋과 무관하므로 병렬로 처리한다.
+		const auto prepareStart = Clock::now();
+		std::vector<PreparedImport> prepared(loadDatas.size());
+		core::ThreadPool* const threadPool = core::ThreadPool::GetInstance();
+		if (threadPool->IsInit() && loadDatas.size() > 1)
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(loadDatas.size());
+			for (std::size_t i = 0; i < loadDatas.size(); ++i)
+			{
+				if (loadDatas[i].importer == nullptr)
+					continue;
+				futures.push_back(threadPool->AddTask(
+					[this, &prepared, &loadDatas, i]
+					{
+						prepared[i] = PrepareImport(loadDatas[i].path, *loadDatas[i].importer);
+					}
+				));
+			}
+			for (auto& future : futures)
+				future.wait();
+		}
+		else
+		{
+			for (std::size_t i = 0; i < loadDatas.size(); ++i)
+			{
+				if (loadDatas[i].importer != nullptr)
+					prepared[i] = PrepareImport(loadDatas[i].path, *loadDatas[i].importer);
+			}
+		}
 
-			ImportAsset(data.path, bOverLoad);
+		// 임포트 단계: 객체 생성은 메인 스레드에서 한다.
+		// 우선순위 순서를 기본으로 하되 캐시에서 알 수 있는 의존성은 먼저 불러온다. 캐시가 없는 에셋의 의존성은 로더가 임포트 중에 요청한다.
+		const auto importStart = Clock::now();
+		std::unordered_map<core::UUID, std::size_t> batchIdx;
+		for (std::size_t i = 0; i < prepared.size(); ++i)
+		{
+			if (prepared[i].cachedAsset != nullptr)
+				batchIdx.insert({ prepared[i].cachedAsset->GetAssetUUID(), i });
+		}
+		std::vector<bool> visited(prepared.size(), false);
+		std::vector<std::pair<std::size_t, std::size_t>> stack; // (인덱스, 다음에 볼 의존성)
+		for (std::size_t root = 0; root < prepared.size(); ++root)
+		{
+			if (visited[root])
+				continue;
+			visited[root] = true;
+			stack.push_back({ root, 0 });
+			while (!stack.empty())
+			{
+				auto& [idx, depIdx] = stack.back();
+				const std::vector<core::UUID>& deps = prepared[idx].dependencies;
+				if (depIdx < deps.size())
+				{
+					auto it = batchIdx.find(deps[depIdx++]);
+					if (it != batchIdx.end() && !visited[it->second])
+					{
+						visited[it->second] = true;
+						stack.push_back({ it->second, 0 });
+					}
+					continue;
+				}
+				const std::size_t current = idx;
+				stack.pop_back();
+
+				if (prepared[current].importer == nullptr)
+					ImportAsset(loadDatas[current].path, bOverLoad);
+				else
+					ImportPrepared(prepared[current], bOverLoad);
+				prepared[current].cachedAsset.reset();
+			}
 		}
+
+		const auto saveStart = Clock::now();
 		SaveDatabase(libPath / "AssetDB.json");
+		const auto end = Clock::now();
+
+		importStats.scanMs = ElapsedMs(scanStart, prepareStart);
+		importStats.prepareMs = ElapsedMs(prepareStart, importStart);
+		importStats.importMs = ElapsedMs(importStart, saveStart);
+		importStats.saveMs = ElapsedMs(saveStart, end);
+		SH_INFO_FORMAT("Asset import: {} files (cache hit: {}, miss: {}) scan {:.2f}ms, prepare {:.2f}ms, import {:.2f}ms, save {:.2f}ms",
+			loadDatas.size(), importStats.cacheHit, importStats.cacheMiss,
+			importStats.scanMs, importStats.prepareMs, importStats.importMs, importStats.saveMs);
 	}
 	SH_EDITOR_API auto AssetDatabase::ImportAsset(const std::filesystem::path& dir, bool bOverLoad) -> core::SObject*
 	{
@@ -217,13 +321,9 @@ namespace sh::editor
 
 		if (!bOverLoad)
 		{
-			auto uuidOpt = GetAssetUUID(abPath);
-			if (uuidOpt.has_value())
-			{
-				core::SObject* const sobjPtr = core::SObjectManager::GetInstance()->GetSObject(uuidOpt.value());
-				if (sobjPtr != nullptr)
-					return sobjPtr;
-			}
+			core::SObject* const sobjPtr = FindLoadedObject(abPath);
+			if (sobjPtr != nullptr)
+				return sobjPtr;
 		}
 
 		if (!std::filesystem::exists(abPath))
@@ -239,30 +339,8 @@ namespace sh::editor
 			if (importerPtr == nullptr)
 				return nullptr;
 
-			const bool bAssetChanged = IsAssetChanged(abPath);
-
-			core::SObject* const objPtr = LoadAsset(abPath, *importerPtr->loader, importerPtr->bObjDataInMeta);
-
-			// 모델 파일은 특수처리 필요
-			if (type == AssetExtensions::Type::Model)
-			{
-				if (objPtr != nullptr && bAssetChanged)
-				{
-					render::Model* const modelPtr = static_cast<render::Model*>(objPtr);
-					for (const auto& mesh : modelPtr->GetMeshes())
-					{
-						if (mesh == nullptr)
-							continue;
-						const std::filesystem::path cachePath{ libPath / fmt::format("{}.asset", mesh->GetUUID().ToString()) };
-						ExportAsset(*mesh, cachePath);
-						paths.insert_or_assign(mesh->GetUUID(), AssetInfo{ std::filesystem::relative(cachePath, projectPath), std::filesystem::relative(cachePath, projectPath) });
-					}
-				}
-			}
-			if (objPtr != nullptr)
-				onAssetImported.Notify(objPtr);
-
-			return objPtr;
+			PreparedImport prepared = PrepareImport(abPath, *importerPtr);
+			return ImportPrepared(prepared, true);
 		}
 		// .asset파일의 경우 그냥 불러오고 포인터 반환
 		std::unique_ptr<core::Asset> asset = core::AssetImporter::Load(projectPath / abPath);
@@ -431,6 +509,8 @@ namespace sh::editor
 			assetType = game::MeshAsset::ASSET_NAME;
 		else if (obj.GetType() == render::SkinnedMesh::GetStaticType())
 			assetType = game::MeshAsset::ASSET_NAME;
+		else if (obj.GetType() == render::AnimationClip::GetStaticType())
+			assetType = game::AnimationClipAsset::ASSET_NAME;
 		else if (obj.GetType() == render::Shader::GetStaticType())
 			assetType = game::ShaderAsset::ASSET_NAME;
 		else if (obj.GetType() == game::Prefab::GetStaticType())
@@ -510,6 +590,10 @@ namespace sh::editor
 
 		return (assetWriteTime != writeTime) || bMetaChanged;
 	}
+	SH_EDITOR_API void AssetDatabase::SetImportCachePath(const std::filesystem::path& dir)
+	{
+		importCache.SetPath(dir);
+	}
 	SH_EDITOR_API auto AssetDatabase::GetAssetImporter(AssetExtensions::Type type) const -> const AssetLoaderRegistry::Importer*
 	{
 		return assetLoaders.GetLoader(type);
@@ -543,7 +627,7 @@ namespace sh::editor
 				const auto importer = assetLoaders.GetLoader(type);
 				if (importer != nullptr)
 					priority = importer->priority;
-				loadingAssetsQueue.push(AssetLoadData{ priority, entry.path() });
+				loadingAssetsQueue.push(AssetLoadData{ priority, entry.path(), importer });
 			}
 		}
 	}
@@ -608,4 +692,147 @@ namespace sh::editor
 
 		return objPtr;
 	}
+	auto AssetDatabase::PrepareImport(const std::filesystem::path& path, const AssetLoaderRegistry::Importer& importer) const -> PreparedImport
+	{
+		PreparedImport prepared{};
+		prepared.path = path;
+		prepared.importer = &importer;
+
+		auto sourceOpt = core::FileSystem::LoadBinary(path);
+		if (!sourceOpt.has_value())
+			return prepared;
+		prepared.sourceHash = core::Util::Hash64(sourceOpt->data(), sourceOpt->size());
+
+		// 메타 파일이 없으면 UUID가 아직 정해지지 않았으므로 새로 임포트 해야 한다.
+		auto metaOpt = core::FileSystem::LoadBinary(Meta::CreateMetaDirectory(path));
+		if (!metaOpt.has_value())
+			return prepared;
+		prepared.cacheKey = core::ImportCache::MakeKey(prepared.sourceHash, metaOpt->data(), metaOpt->size(), importer.version);
+
+		// 손상된 캐시 파일은 Load에서 걸러지고 지워지므로 새로 임포트하게 된다.
+		prepared.cachedAsset = importCache.Load(prepared.cacheKey);
+		if (prepared.cachedAsset != nullptr)
+			prepared.dependencies = prepared.cachedAsset->GetDependencies();
+		return prepared;
+	}
+	auto AssetDatabase::ImportPrepared(PreparedImport& prepared, bool bOverLoad) -> core::SObject*
+	{
+		if (!bOverLoad)
+		{
+			core::SObject* const sobjPtr = FindLoadedObject(prepared.path);
+			if (sobjPtr != nullptr)
+				return sobjPtr;
+		}
+		const AssetLoaderRegistry::Importer& importer = *prepared.importer;
+		const AssetExtensions::Type type = AssetExtensions::CheckType(prepared.path.extension().u8string());
+
+		core::SObject* objPtr = nullptr;
+		if (prepared.cachedAsset != nullptr)
+			objPtr = LoadCachedAsset(prepared);
+
+		if (objPtr != nullptr)
+			++importStats.cacheHit;
+		else
+		{
+			++importStats.cacheMiss;
+			const bool bAssetChanged = IsAssetChanged(prepared.path);
+
+			objPtr = LoadAsset(prepared.path, *importer.loader, importer.bObjDataInMeta);
+
+			// 모델 파일은 특수처리 필요
+			if (type == AssetExtensions::Type::Model)
+			{
+				if (objPtr != nullptr && bAssetChanged)
+				{
+					render::Model* const modelPtr = static_cast<render::Model*>(objPtr);
+					for (const auto& mesh : modelPtr->GetMeshes())
+					{
+						if (mesh == nullptr)
+							continue;
+						const std::filesystem::path cachePath{ libPath / fmt::format("{}.asset", mesh->GetUUID().ToString()) };
+						ExportAsset(*mesh, cachePath);
+						paths.insert_or_assign(mesh->GetUUID(), AssetInfo{ std::filesystem::relative(cachePath, projectPath), std::filesystem::relative(cachePath, projectPath) });
+					}
+					for (const auto& animation : modelPtr->GetAnimations())
+					{
+						if (animation == nullptr)
+							continue;
+						const std::filesystem::path cachePath{ libPath / fmt::format("{}.asset", animation->GetUUID().ToString()) };
+						ExportAsset(*animation, cachePath);
+						paths.insert_or_assign(animation->GetUUID(), AssetInfo{ std::filesystem::relative(cachePath, projectPath), std::filesystem::relative(cachePath, projectPath) });
+					}
+				}
+			}
+			if (objPtr != nullptr)
+				StoreImportCache(prepared, *objPtr);
+		}
+		if (objPtr != nullptr)
+			onAssetImported.Notify(objPtr);
+
+		return objPtr;
+	}
+	auto AssetDatabase::LoadCachedAsset(const PreparedImport& prepared) -> core::SObject*
+	{
+		core::SObject* const objPtr = prepared.importer->loader->Load(*prepared.cachedAsset);
+		if (objPtr == nullptr)
+			return nullptr;
+		objPtr->SetName(prepared.path.stem().u8string());
+
+		// 다른 코드는 Library의 Asset파일을 참조하므로 없다면(새로 받은 저장소) 캐시를 복사해둔다.
+		const std::filesystem::path relativePath{ std::filesystem::relative(prepared.path, projectPath) };
+		const std::filesystem::path cachePath{ libPath / fmt::format("{}.asset", objPtr->GetUUID().ToString()) };
+		std::error_code ec;
+		if (!std::filesystem::exists(cachePath, ec))
+		{
+			if (!importCache.Restore(prepared.cacheKey, cachePath))
+				SH_ERROR_FORMAT("Failed to copy import cache: {}", cachePath.u8string());
+		}
+		uuids.insert_or_assign(relativePath, objPtr->GetUUID());
+		paths.insert_or_assign(objPtr->GetUUID(), AssetInfo{ relativePath, std::filesystem::relative(cachePath, projectPath) });
+
+		if (objPtr->GetType() == render::Model::GetStaticType())
+		{
+			render::Model* const modelPtr = static_cast<render::Model*>(objPtr);
+			for (const auto& mesh : modelPtr->GetMeshes())
+			{
+				if (mesh == nullptr)
+					continue;
+				const std::filesystem::path meshCachePath{ libPath / fmt::format("{}.asset", mesh->GetUUID().ToString()) };
+				if (!std::filesystem::exists(meshCachePath, ec))
+					ExportAsset(*mesh, meshCachePath);
+				paths.insert_or_assign(mesh->GetUUID(), AssetInfo{ std::filesystem::relative(meshCachePath, projectPath), std::filesystem::relative(meshCachePath, projectPath) });
+			}
+			for (const auto& animation : modelPtr->GetAnimations())
+			{
+				if (animation == nullptr)
+					continue;
+				const std::filesystem::path animationCachePath{ libPath / fmt::format("{}.asset", animation->GetUUID().ToString()) };
+				if (!std::filesystem::exists(animationCachePath, ec))
+					ExportAsset(*animation, animationCachePath);
+				paths.insert_or_assign(animation->GetUUID(), AssetInfo{ std::filesystem::relative(animationCachePath, projectPath), std::filesystem::relative(animationCachePath, projectPath) });
+			}
+		}
+		return objPtr;
+	}
+	void AssetDatabase::StoreImportCache(const PreparedImport& prepared, const core::SObject& obj)
+	{
+		// 임포트 중에 메타 파일이 다시 써지므로 키를 다시 계산한다. 원본은 그대로라 해시를 재사용한다.
+		auto metaOpt = core::FileSystem::LoadBinary(Meta::CreateMetaDirectory(prepared.path));
+		if (!metaOpt.has_value() || prepared.sourceHash == 0)
+			return;
+		const uint64_t key = core::ImportCache::MakeKey(prepared.sourceHash, metaOpt->data(), metaOpt->size(), prepared.importer->version);
+
+		const std::filesystem::path cachePath{ libPath / fmt::format("{}.asset", obj.GetUUID().ToString()) };
+		std::error_code ec;
+		if (!std::filesystem::exists(cachePath, ec))
+			return;
+		importCache.StoreFile(key, cachePath);
+	}
+	auto AssetDatabase::FindLoadedObject(const std::filesystem::path& path) -> core::SObject*
+	{
+		auto uuidOpt = GetAssetUUID(path);
+		if (!uuidOpt.has_value())
+			return nullptr;
+		return core::SObjectManager::GetInstance()->GetSObject(uuidOpt.value());
+	}
 }//namespace
@@ -63,6 +63,8 @@ namespace sh::editor
 			return "ScriptableObject";
 		case Type::ComputeShader:
 			return "ComputeShader";
+		case Type::AnimationClip:
+			return "AnimationClip";
 		}
 		return "None";
 	}
@@ -3,7 +3,7 @@
 #include "Core/Logger.h"
 namespace sh::editor
 {
-	SH_EDITOR_API void AssetLoaderRegistry::RegisterLoader(AssetExtensions::Type ext, std::unique_ptr<core::IAssetLoader> loader, int priority, bool bObjDataInMeta)
+	SH_EDITOR_API void AssetLoaderRegistry::RegisterLoader(AssetExtensions::Type ext, std::unique_ptr<core::IAssetLoader> loader, int priority, bool bObjDataInMeta, uint32_t version)
 	{
 		auto it = loaders.find(ext);
 		if (it != loaders.end())
@@ -18,6 +18,7 @@ namespace sh::editor
 		importer.loader = std::move(loader);
 		importer.priority = priority;
 		importer.bObjDataInMeta = bObjDataInMeta;
+		importer.version = version;
 		loaders.insert({ ext, std::move(importer) });
 	}
 	SH_EDITOR_API auto AssetLoaderRegistry::GetLoader(const char* assetType) const -> const Importer*
@@ -5,13 +5,17 @@
 #include "EditorResource.h"
 
 #include "Core/AssetBundle.h"
+#include "Core/AssetBundleLayout.h"
 #include "Core/FileSystem.h"
 
 #include "Game/World.h"
 #include "Game/GameObject.h"
 #include "Game/GameManager.h"
+#include "Game/WorldStreamer.h"
+#include "Game/Component/Render/Camera.h"
 
 #include "Game/Asset/WorldAsset.h"
+#include "Game/Asset/WorldCellAsset.h"
 #include "Game/Asset/ShaderAsset.h"
 #include "Game/Asset/MaterialAsset.h"
 #include "Game/Asset/MeshAsset.h"
@@ -33,6 +37,7 @@ namespace sh::editor
         currentProject = &project;
 
         core::AssetBundle bundle;
+        core::AssetBundleLayout layout;
 
         std::vector<game::World*> worldPtrs;
 
@@ -79,9 +84,11 @@ namespace sh::editor
                     }
                 }
             }
-            PackingAssets(bundle, *worldPtr);
+            PackingAssets(bundle, layout, *worldPtr, worldJson);
         }
 
+        // 시작 월드부터 월드마다 불러오는 순서대로 데이터를 모아 써서 읽을 때 탐색을 줄인다.
+        bundle.SetLayoutOrder(layout.Build());
         bundle.SaveBundle(outputPath / "assets.bundle");
 
         ExportGameManager(outputPath / "gameManager.bin");
@@ -210,7 +217,27 @@ namespace sh::editor
         }
     }
 
-    void BuildSystem::PackingAssets(core::AssetBundle& bundle, game::World& world)
+    void BuildSystem::CollectReferences(const core::Json& json, std::vector<core::UUID>& out)
+    {
+        if (json.is_object())
+        {
+            for (auto const& [key, val] : json.items())
+                CollectReferences(val, out);
+        }
+        else if (json.is_array())
+        {
+            for (const auto& item : json)
+                CollectReferences(item, out);
+        }
+        else if (json.is_string())
+        {
+            const std::string& value = json.get_ref<const std::string&>();
+            if (std::regex_match(value, uuidRegex))
+                out.push_back(core::UUID{ value });
+        }
+    }
+
+    void BuildSystem::PackingAssets(core::AssetBundle& bundle, core::AssetBundleLayout& layout, game::World& world, const core::Json& worldJson)
     {
         auto editorResource = EditorResource::GetInstance();
         game::ShaderAsset errorShaderAsset{ *editorResource->GetShader("ErrorShader") };
@@ -238,6 +265,16 @@ namespace sh::editor
         game::TextureAsset blackTex{ *editorResource->GetTexture("BlackTexture") };
         bundle.AddAsset(blackTex, true);
 
+        // 기본 에셋들은 월드보다 먼저 불러와진다. (GameManager::LoadDefaultAsset())
+        for (const core::Asset* asset : std::initializer_list<const core::Asset*>{ &errorShaderAsset, &lineShaderAsset, &uiTextShaderAsset, &ssaoShaderAsset,
+            &errorMatAsset, &lineMatAsset, &uiTextMatAsset, &cubeMesh, &sphereMesh, &planeMesh, &blackTex })
+            layout.AddRoot(asset->GetAssetUUID());
+
+        std::vector<core::UUID> refs;
+        CollectReferences(worldJson, refs);
+        layout.AddRoot(world.GetUUID());
+        layout.AddDependencies(world.GetUUID(), refs);
+
         for (const auto& uuid : uuids)
         {
             auto obj = core::SObjectManager::GetInstance()->GetSObject(core::UUID{ uuid });
@@ -247,12 +284,47 @@ namespace sh::editor
                     continue;
             }
             auto asset = AssetDatabase::GetInstance()->GetAsset(core::UUID{ uuid });
-            if (asset != nullptr)
-                bundle.AddAsset(*asset, true);
+            if (asset != nullptr && bundle.AddAsset(*asset, true) && core::IsValid(obj))
+            {
+                refs.clear();
+                CollectReferences(obj->Serialize(), refs);
+                layout.AddDependencies(core::UUID{ uuid }, refs);
+            }
         }
 
         game::WorldAsset worldAsset{ world };
         worldAsset.ConvertToGameWorldType();
+        if (world.GetStreamingCellSize() > 0.f)
+        {
+            // 스트리밍 월드는 셀마다 하위 에셋으로 나눠 저장한다.
+            game::WorldStreamer::Settings settings{};
+            settings.cellSize = world.GetStreamingCellSize();
+            settings.loadRadius = world.GetStreamingLoadRadius();
+            settings.unloadRadius = settings.loadRadius + settings.cellSize * 0.5f;
+
+            std::vector<std::string> persistentNames{};
+            if (core::IsValid(world.GetMainCamera()))
+            {
+                // 카메라가 속한 계층은 항상 남아있어야 한다.
+                game::Transform* root = world.GetMainCamera()->gameObject.transform;
+                while (root->GetParent() != nullptr)
+                    root = root->GetParent();
+                persistentNames.push_back(root->gameObject.GetName().ToString());
+            }
+
+            auto partition = game::WorldStreamer::Partition(worldJson, settings, persistentNames);
+            refs.clear();
+            for (auto& cellAsset : partition.cells)
+            {
+                bundle.AddAsset(*cellAsset, true);
+                refs.push_back(cellAsset->GetAssetUUID());
+            }
+            // 셀은 월드가 직접 참조하는 에셋들 뒤에 모아둔다.
+            layout.AddDependencies(world.GetUUID(), refs);
+            SH_INFO_FORMAT("World({}) is partitioned into {} cells", world.GetUUID().ToString(), partition.cells.size());
+
+            worldAsset.SetWorldData(std::move(partition.persistentWorld));
+        }
         bundle.AddAsset(worldAsset, true);
     }
 
@@ -30,9 +30,9 @@ namespace sh::editor
                             if (bundle.LoadBundle(path))
                             {
                                 AssetInfo info{};
-                                for (const auto& [uuid, entry] : bundle.GetAssetEntries())
+                                for (const auto& entry : bundle.GetAssetEntries())
                                 {
-                                    info.uuid = uuid.ToString();
+                                    info.uuid = core::UUID{ entry.uuid }.ToString();
                                     info.type = entry.type;
                                     info.offset = entry.dataOffset;
                                     info.size = entry.dataSize;
@@ -4,6 +4,7 @@
 #include "Game/GameObject.h"
 #include "Game/Component/Render/MeshRenderer.h"
 #include "Game/Component/Render/SkinnedMeshRenderer.h"
+#include "Game/Component/Render/Animator.h"
 
 #include "Render/SkinnedMesh.h"
 
@@ -72,9 +73,30 @@ namespace sh::editor
 				nodeQ.push({ childIdx, meshObj });
 		}
 
+		// 애니메이션이 있으면 스켈레톤마다 Animator를 루트에 두고 첫 클립을 재생한다.
+		std::vector<game::Animator*> animators(skeletons.size(), nullptr);
+		const auto& animations = model.GetAnimations();
+		std::vector<render::AnimationClip*> clips(animations.begin(), animations.end());
+
 		// 모든 GameObject 생성 후 bone Transform 연결
 		for (auto& setup : skinnedSetups)
 		{
+			if (!clips.empty())
+			{
+				game::Animator*& animator = animators[setup.skeletonIdx];
+				if (animator == nullptr)
+				{
+					animator = rootObj->AddComponent<game::Animator>();
+					animator->SetModel(&model, setup.skeletonIdx);
+					animator->SetClips(clips);
+					game::Animator::Layer baseLayer{};
+					baseLayer.name = "Base";
+					baseLayer.motions.push_back(game::Animator::Motion{ 0, 0.f, 1.f });
+					animator->SetLayers({ std::move(baseLayer) });
+				}
+				setup.renderer->SetAnimator(animator);
+			}
+
 			const render::Skeleton& skeleton = skeletons[setup.skeletonIdx];
 
 			std::vector<game::Transform*> bones;
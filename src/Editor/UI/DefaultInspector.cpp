@@ -317,26 +317,7 @@ namespace sh::editor
 
 		bool bChanged = false;
 
-		std::string formatText = "";
-		switch (format)
-		{
-		case TextureFormat::RGB24:
-			formatText = "RGB24";
-			break;
-		case TextureFormat::RGBA32:
-			formatText = "RGBA32";
-			break;
-		case TextureFormat::SRGB24:
-			formatText = "SRGB24";
-			break;
-		case TextureFormat::SRGBA32:
-			formatText = "SRGBA32";
-			break;
-		case TextureFormat::R8:
-			formatText = "R8";
-			break;
-		}
-		ImGui::Text("format: %s", formatText.c_str());
+		ImGui::Text("format: %s", TextureFormatToString(format));
 		ImGui::Text("width: %d", texture->GetWidth());
 		ImGui::Text("height: %d", texture->GetHeight());
 		ImGui::Text("mipLevel: %d", texture->GetMipLevel());
@@ -347,36 +328,9 @@ namespace sh::editor
 		bool bSRGB = texture->IsSRGB();
 		if (ImGui::Checkbox("##SRGB", &bSRGB))
 		{
-			if (bSRGB)
-			{
-				if (format == TextureFormat::RGB24)
-				{
-					for (auto texPtr : textures)
-						if (texPtr != nullptr)
-							texPtr->ChangeTextureFormat(TextureFormat::SRGB24);
-				}
-				else if(format == TextureFormat::RGBA32)
-				{
-					for (auto texPtr : textures)
-						if (texPtr != nullptr)
-							texPtr->ChangeTextureFormat(TextureFormat::SRGBA32);
-				}
-			}
-			else
-			{
-				if (format == TextureFormat::SRGB24)
-				{
-					for (auto texPtr : textures)
-						if (texPtr != nullptr)
-							texPtr->ChangeTextureFormat(TextureFormat::RGB24);
-				}
-				else if (format == TextureFormat::SRGBA32)
-				{
-					for (auto texPtr : textures)
-						if (texPtr != nullptr)
-							texPtr->ChangeTextureFormat(TextureFormat::RGBA32);
-				}
-			}
+			for (auto texPtr : textures)
+				if (texPtr != nullptr)
+					texPtr->SetSRGB(bSRGB);
 			bChanged = true;
 		}
 		bool bGenerateMipmap = texture->IsGenerateMipmap();
@@ -411,6 +365,18 @@ namespace sh::editor
 				bChanged = true;
 			}
 		}
+		ImGui::Text("Compression");
+		{
+			const char* compressions[] = { "None", "Color", "Color (HQ)", "Normal map", "Single channel" };
+			int current = static_cast<int>(texture->GetCompression());
+			if (ImGui::ListBox(fmt::format("##compression{}", idx).c_str(), &current, compressions, IM_ARRAYSIZE(compressions), 5))
+			{
+				for (auto texPtr : textures)
+					if (texPtr != nullptr)
+						texPtr->SetCompression(static_cast<render::TextureCompression>(current));
+				bChanged = true;
+			}
+		}
 		ImGui::Separator();
 
 		if (core::IsValid(texture) && lastTex != texture)
@@ -32,7 +32,10 @@
 #include "Render/VulkanImpl/VulkanContext.h"
 
 #include "Game/World.h"
+#include "Game/WorldStreamer.h"
 #include "Game/AssetLoaderFactory.h"
+#include "Game/AsyncAssetLoader.h"
+#include "Game/TextureStreamer.h"
 #include "Game/Asset/TextureLoader.h"
 #include "Game/Asset/ModelLoader.h"
 #include "Game/Asset/MeshLoader.h"
@@ -46,6 +49,7 @@
 #include "Game/Asset/SoundLoader.h"
 #include "Game/Asset/ScriptableObjectLoader.h"
 #include "Game/Asset/ComputeShaderLoader.h"
+#include "Game/Asset/AnimationClipLoader.h"
 
 #include "Game/Asset/TextureAsset.h"
 #include "Game/Asset/MaterialAsset.h"
@@ -60,6 +64,7 @@
 #include "Game/Asset/SoundAsset.h"
 #include "Game/Asset/ScriptableObjectAsset.h"
 #include "Game/Asset/ComputeShaderAsset.h"
+#include "Game/Asset/AnimationClipAsset.h"
 #endif
 
 namespace sh
@@ -75,6 +80,13 @@ namespace sh
 	void EngineInit::Clean()
 	{
 		SH_INFO("Engine shutdown");
+#if !SH_EDITOR
+		// 로더가 쥐고 있는 에셋들이 아래의 수집에서 지워질 수 있도록 먼저 해제한다.
+		gameManager->SetAssetLoader(nullptr);
+		assetLoader.reset();
+		gameManager->SetTextureStreamer(nullptr);
+		textureStreamer.reset();
+#endif
 		gameManager->Destroy();
 #if SH_EDITOR
 		project.reset();
@@ -230,6 +242,7 @@ namespace sh
 		assetLoaderFactory->RegisterLoader(game::TextureAsset::ASSET_NAME, std::make_unique<game::TextureLoader>(*renderer->GetContext()));
 		assetLoaderFactory->RegisterLoader(game::ModelAsset::ASSET_NAME, std::make_unique<game::ModelLoader>(*renderer->GetContext()));
 		assetLoaderFactory->RegisterLoader(game::MeshAsset::ASSET_NAME, std::make_unique<game::MeshLoader>(*renderer->GetContext()));
+		assetLoaderFactory->RegisterLoader(game::AnimationClipAsset::ASSET_NAME, std::make_unique<game::AnimationClipLoader>());
 		assetLoaderFactory->RegisterLoader(game::MaterialAsset::ASSET_NAME, std::make_unique<game::MaterialLoader>(*renderer->GetContext()));
 		assetLoaderFactory->RegisterLoader(game::ShaderAsset::ASSET_NAME, std::make_unique<game::ShaderLoader>(&vkShaderPassBuilder));
 		assetLoaderFactory->RegisterLoader(game::WorldAsset::ASSET_NAME, std::make_unique<game::WorldLoader>());
@@ -241,24 +254,34 @@ namespace sh
 		assetLoaderFactory->RegisterLoader(game::ScriptableObjectAsset::ASSET_NAME, std::make_unique<game::ScriptableObjectLoader>());
 		assetLoaderFactory->RegisterLoader(game::ComputeShaderAsset::ASSET_NAME, std::make_unique<game::ComputeShaderLoader>(*renderer->GetContext()));
 
+		assetBundle = std::make_unique<core::AssetBundle>();
+		if (!assetBundle->LoadBundle("assets.bundle"))
+			return;
+		// 번들은 메모리에 매핑돼 있으므로 워커 스레드들이 잠금 없이 동시에 읽는다.
+		auto bundleSourceFn =
+			[bundle = assetBundle.get()](const core::UUID& uuid) -> std::unique_ptr<core::Asset>
+			{
+				return bundle->LoadAsset(uuid);
+			};
+		// 번들의 에셋 목록은 불러온 뒤로 바뀌지 않으므로 잠금 없이 확인한다.
+		assetLoader = std::make_unique<game::AsyncAssetLoader>(bundleSourceFn,
+			[bundle = assetBundle.get()](const core::UUID& uuid) { return bundle->HasAsset(uuid); });
+		gameManager->SetAssetLoader(assetLoader.get());
+		// 텍스쳐는 밉 꼬리만 불러오고 높은 해상도의 밉은 보이는 크기에 맞춰 번들에서 다시 읽는다.
+		textureStreamer = std::make_unique<game::TextureStreamer>(bundleSourceFn);
+		gameManager->SetTextureStreamer(textureStreamer.get());
+
+		// 불러오지 않은 에셋을 참조하면 호출된다. 비동기로 진행 중인 에셋이면 그 결과를 기다려서 쓴다.
 		core::AssetResolverRegistry::SetResolver(
 			[this](const core::UUID& uuid) -> core::SObject*
 			{
-				auto asset = assetBundle->LoadAsset(uuid);
-				if (asset == nullptr)
-					return nullptr;
-				static game::AssetLoaderFactory& factory = *game::AssetLoaderFactory::GetInstance();
-				auto assetLoader = factory.GetLoader(asset->GetType());
 				if (assetLoader == nullptr)
 					return nullptr;
-				core::SObject* assetPtr = assetLoader->Load(*asset);
-				return assetPtr;
+				return assetLoader->Resolve(uuid);
 			}
 		);
-
-		assetBundle = std::make_unique<core::AssetBundle>();
-		if (!assetBundle->LoadBundle("assets.bundle"))
-			return;
+		// 스트리밍 셀은 워커 스레드에서 읽는다.
+		game::WorldStreamer::SetCellSource(bundleSourceFn);
 		if (!gameManager->LoadGame("gameManager.bin", *assetBundle))
 			return;
  #endif
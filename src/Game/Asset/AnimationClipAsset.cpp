@@ -0,0 +1,128 @@
+﻿#include "Asset/AnimationClipAsset.h"
+
+#include <cstring>
+namespace sh::game
+{
+	namespace
+	{
+		template<typename T>
+		void Write(std::vector<uint8_t>& data, const T* src, std::size_t count)
+		{
+			const std::size_t bytes = sizeof(T) * count;
+			const std::size_t offset = data.size();
+			data.resize(offset + bytes);
+			if (bytes > 0)
+				std::memcpy(data.data() + offset, src, bytes);
+		}
+		template<typename T>
+		auto Read(const std::vector<uint8_t>& data, std::size_t& cursor, std::vector<T>& dst, std::size_t count) -> bool
+		{
+			const std::size_t bytes = sizeof(T) * count;
+			if (count > data.size() || cursor + bytes > data.size())
+				return false;
+			dst.resize(count);
+			if (bytes > 0)
+				std::memcpy(dst.data(), data.data() + cursor, bytes);
+			cursor += bytes;
+			return true;
+		}
+	}//namespace
+
+	AnimationClipAsset::AnimationClipAsset() :
+		Asset(ASSET_NAME)
+	{
+	}
+	AnimationClipAsset::AnimationClipAsset(const render::AnimationClip& clip) :
+		Asset(ASSET_NAME),
+		clipPtr(&clip)
+	{
+		assetUUID = clipPtr->GetUUID();
+	}
+	SH_GAME_API void AnimationClipAsset::SetAsset(const core::SObject& obj)
+	{
+		if (obj.GetType() != render::AnimationClip::GetStaticType())
+			return;
+
+		clipPtr = static_cast<const render::AnimationClip*>(&obj);
+		assetUUID = clipPtr->GetUUID();
+	}
+	SH_GAME_API auto AnimationClipAsset::GetClipData() const -> const render::AnimationClip::Data&
+	{
+		if (clipPtr.IsValid())
+			return clipPtr->GetData();
+		return clipData;
+	}
+	SH_GAME_API void AnimationClipAsset::SetAssetData() const
+	{
+		if (!clipPtr.IsValid())
+			return;
+
+		const render::AnimationClip::Data& clip = clipPtr->GetData();
+
+		Header header{};
+		header.duration = clip.duration;
+		header.sampleRate = clip.sampleRate;
+		header.frameCount = clip.frameCount;
+		header.trackCount = clip.trackNames.size();
+		header.constantCount = clip.constantTargets.size();
+		header.animatedCount = clip.animatedTargets.size();
+
+		data.clear();
+		Write(data, &header, 1);
+		for (const std::string& name : clip.trackNames)
+		{
+			const uint32_t nameSize = static_cast<uint32_t>(name.size());
+			Write(data, &nameSize, 1);
+			Write(data, name.data(), name.size());
+		}
+		Write(data, clip.constantTargets.data(), clip.constantTargets.size());
+		Write(data, clip.constantValues.data(), clip.constantValues.size());
+		Write(data, clip.animatedTargets.data(), clip.animatedTargets.size());
+		Write(data, clip.animatedMin.data(), clip.animatedMin.size());
+		Write(data, clip.animatedScale.data(), clip.animatedScale.size());
+		Write(data, clip.frames.data(), clip.frames.size());
+	}
+	SH_GAME_API auto AnimationClipAsset::ParseAssetData() -> bool
+	{
+		clipPtr.Reset();
+		clipData = render::AnimationClip::Data{};
+
+		if (data.size() < sizeof(Header))
+			return false;
+
+		Header header{};
+		std::memcpy(&header, data.data(), sizeof(Header));
+		std::size_t cursor = sizeof(Header);
+
+		clipData.duration = header.duration;
+		clipData.sampleRate = header.sampleRate;
+		clipData.frameCount = static_cast<uint32_t>(header.frameCount);
+
+		if (header.trackCount > data.size())
+			return false;
+		clipData.trackNames.resize(header.trackCount);
+		for (std::string& name : clipData.trackNames)
+		{
+			uint32_t nameSize = 0;
+			if (cursor + sizeof(uint32_t) > data.size())
+				return false;
+			std::memcpy(&nameSize, data.data() + cursor, sizeof(uint32_t));
+			cursor += sizeof(uint32_t);
+
+			if (cursor + nameSize > data.size())
+				return false;
+			name.assign(reinterpret_cast<const char*>(data.data() + cursor), nameSize);
+			cursor += nameSize;
+		}
+
+		if (!Read(data, cursor, clipData.constantTargets, header.constantCount) ||
+			!Read(data, cursor, clipData.constantValues, header.constantCount) ||
+			!Read(data, cursor, clipData.animatedTargets, header.animatedCount) ||
+			!Read(data, cursor, clipData.animatedMin, header.animatedCount) ||
+			!Read(data, cursor, clipData.animatedScale, header.animatedCount))
+			return false;
+		if (header.frameCount > 0 && header.animatedCount > (data.size() - cursor) / sizeof(uint16_t) / header.frameCount)
+			return false;
+		return Read(data, cursor, clipData.frames, header.frameCount * header.animatedCount);
+	}
+}//namespace
@@ -0,0 +1,32 @@
+﻿#include "Asset/AnimationClipLoader.h"
+#include "Asset/AnimationClipAsset.h"
+
+#include "Render/AnimationClip.h"
+
+#include <cstring>
+namespace sh::game
+{
+	SH_GAME_API AnimationClipLoader::AnimationClipLoader()
+	{
+	}
+	SH_GAME_API auto AnimationClipLoader::Load(const std::filesystem::path& filePath) const -> core::SObject*
+	{
+		return nullptr;
+	}
+	SH_GAME_API auto AnimationClipLoader::Load(const core::Asset& asset) const -> core::SObject*
+	{
+		if (std::strcmp(asset.GetType(), GetAssetName()) != 0)
+			return nullptr;
+
+		const AnimationClipAsset& clipAsset = static_cast<const AnimationClipAsset&>(asset);
+
+		render::AnimationClip* const clip = core::SObject::Create<render::AnimationClip>();
+		clip->SetUUID(asset.GetAssetUUID());
+		clip->SetData(clipAsset.GetClipData());
+		return clip;
+	}
+	SH_GAME_API auto AnimationClipLoader::GetAssetName() const -> const char*
+	{
+		return AnimationClipAsset::ASSET_NAME;
+	}
+}//namespace
@@ -3,7 +3,6 @@
 
 #include "Core/FileSystem.h"
 #include "Core/Logger.h"
-#include "Core/ExecuteProcess.h"
 
 #include "Render/ComputeShader.h"
 #include "Render/ComputeShaderCreateInfo.h"
@@ -34,9 +33,7 @@ namespace sh::game
 	ComputeShaderLoader::ComputeShaderLoader(const render::IRenderContext& ctx) :
 		ctx(ctx)
 	{
-		cachePath = std::filesystem::current_path() / "cache";
-		if (!std::filesystem::exists(cachePath))
-			std::filesystem::create_directory(cachePath);
+		SetCachePath(std::filesystem::current_path() / "cache");
 	}
 	ComputeShaderLoader::~ComputeShaderLoader() = default;
 
@@ -48,9 +45,6 @@ namespace sh::game
 			SH_ERROR_FORMAT("Can't load file: {}", path.string());
 			return nullptr;
 		}
-		if (!std::filesystem::exists(cachePath))
-			std::filesystem::create_directory(cachePath);
-
 		render::ComputeShaderLexer lexer{};
 		render::ComputeShaderParser parser{};
 
@@ -74,47 +68,12 @@ namespace sh::game
 		if (csCI.shaderNode.shaderName.empty())
 			csCI.shaderNode.shaderName = path.stem().string();
 
-		// GLSL 파일 작성
-		const std::string fileName = ReplaceSpaceString(csCI.shaderNode.shaderName) + ".comp";
-		const std::filesystem::path glslPath = cachePath / fileName;
-		if (!core::FileSystem::SaveText(csCI.shaderNode.code, glslPath))
-		{
-			SH_ERROR_FORMAT("Can't write compute shader source: {}", glslPath.string());
-			return nullptr;
-		}
-
 		// SPIR-V 컴파일
-		const std::filesystem::path spirvPath = cachePath / (fileName + ".spv");
-
-		std::string output;
-		std::string compiler = "glslc";
-#if _WIN32
-		std::vector<std::string> args = {
-			"-fshader-stage=compute",
-			fmt::format("\"{}\"", glslPath.u8string()),
-			"-o",
-			fmt::format("\"{}\"", spirvPath.u8string())
-		};
-		compiler += ".exe";
-#else
-		std::vector<std::string> args = {
-			"-fshader-stage=compute",
-			fmt::format("{}", glslPath.u8string()),
-			"-o",
-			fmt::format("{}", spirvPath.u8string())
-		};
-#endif
-		if (!core::ExecuteProcess::Execute(compiler, args, output))
-		{
-			SH_ERROR_FORMAT("Compute shader compile error: {}", output);
-			return nullptr;
-		}
-
-		// SPIR-V 로드
-		auto spirvOpt = core::FileSystem::LoadBinary(spirvPath);
+		const std::string name = ReplaceSpaceString(csCI.shaderNode.shaderName) + ".comp";
+		auto spirvOpt = compiler.Compile(csCI.shaderNode.code, render::ShaderCompiler::Stage::Compute, name);
 		if (!spirvOpt.has_value())
 		{
-			SH_ERROR_FORMAT("Compute shader spirv load error: {}", spirvPath.string());
+			SH_ERROR_FORMAT("Compute shader compile error: {}", name);
 			return nullptr;
 		}
 		csCI.spirv = std::move(spirvOpt.value());
@@ -39,4 +39,8 @@ namespace sh::game
 
 		return !matData.is_discarded();
 	}
+	SH_GAME_API auto MaterialAsset::GetDependencies() const -> std::vector<core::UUID>
+	{
+		return CollectUUIDs(matData);
+	}
 }//namespace
\ No newline at end of file
@@ -54,14 +54,21 @@ namespace sh::game
 		header.boneVertexCount = bSkinned ? skinnedPtr->GetBoneVertices().size() : 0;
 		header.subMeshCount = meshPtr->GetSubMeshes().size();
 		header.ibmCount = bSkinned ? skinnedPtr->GetInverseBindMatrices().size() : 0;
+		header.bQuantize = meshPtr->IsQuantized() ? 1 : 0;
+		header.lodCount = meshPtr->GetLods().size();
+		header.lodIndexCount = meshPtr->GetLodIndices().size();
 
 		const size_t vertexBytes = header.vertexCount * sizeof(render::Mesh::Vertex);
 		const size_t indexBytes = header.indexCount * sizeof(uint32_t);
 		const size_t boneVertexBytes = header.boneVertexCount * sizeof(render::SkinnedMesh::BoneVertex);
 		const size_t subMeshBytes = header.subMeshCount * sizeof(render::SubMesh);
 		const size_t ibmBytes = header.ibmCount * sizeof(glm::mat4);
+		const size_t lodIndexBytes = header.lodIndexCount * sizeof(uint32_t);
+		size_t lodBytes = 0;
+		for (const render::Mesh::Lod& lod : meshPtr->GetLods())
+			lodBytes += sizeof(LodHeader) + lod.subMeshes.size() * sizeof(render::SubMesh);
 
-		data.resize(sizeof(Header) + vertexBytes + indexBytes + boneVertexBytes + subMeshBytes + ibmBytes);
+		data.resize(sizeof(Header) + vertexBytes + indexBytes + boneVertexBytes + subMeshBytes + ibmBytes + lodIndexBytes + lodBytes);
 
 		uint8_t* cursor = data.data();
 		std::memcpy(cursor, &header, sizeof(Header));
@@ -78,7 +85,23 @@ namespace sh::game
 		std::memcpy(cursor, meshPtr->GetSubMeshes().data(), subMeshBytes);
 		cursor += subMeshBytes;
 		if (bSkinned && header.ibmCount > 0)
+		{
 			std::memcpy(cursor, skinnedPtr->GetInverseBindMatrices().data(), ibmBytes);
+			cursor += ibmBytes;
+		}
+		std::memcpy(cursor, meshPtr->GetLodIndices().data(), lodIndexBytes);
+		cursor += lodIndexBytes;
+		for (const render::Mesh::Lod& lod : meshPtr->GetLods())
+		{
+			LodHeader lodHeader{};
+			lodHeader.ratio = lod.ratio;
+			lodHeader.screenSize = lod.screenSize;
+			lodHeader.subMeshCount = lod.subMeshes.size();
+			std::memcpy(cursor, &lodHeader, sizeof(LodHeader));
+			cursor += sizeof(LodHeader);
+			std::memcpy(cursor, lod.subMeshes.data(), lod.subMeshes.size() * sizeof(render::SubMesh));
+			cursor += lod.subMeshes.size() * sizeof(render::SubMesh);
+		}
 	}
 	SH_GAME_API auto MeshAsset::ParseAssetData() -> bool
 	{
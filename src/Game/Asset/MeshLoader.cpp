@@ -29,8 +29,9 @@ namespace sh::game
 		const size_t boneVertexBytes = header.boneVertexCount * sizeof(render::SkinnedMesh::BoneVertex);
 		const size_t subMeshBytes = header.subMeshCount * sizeof(render::SubMesh);
 		const size_t ibmBytes = header.ibmCount * sizeof(glm::mat4);
+		const size_t lodIndexBytes = header.lodIndexCount * sizeof(uint32_t);
 
-		if (data.size < vertexBytes + indexBytes + boneVertexBytes + subMeshBytes + ibmBytes)
+		if (data.size < vertexBytes + indexBytes + boneVertexBytes + subMeshBytes + ibmBytes + lodIndexBytes)
 		{
 			SH_ERROR_FORMAT("Invalid mesh asset!: {}", asset.GetAssetUUID().ToString());
 			return nullptr;
@@ -70,14 +71,58 @@ namespace sh::game
 				std::vector<glm::mat4> ibms(header.ibmCount);
 				std::memcpy(ibms.data(), cursor, ibmBytes);
 				skinnedMesh->SetInverseBindMatrices(std::move(ibms));
+				cursor += ibmBytes;
 			}
 		}
 		else
 		{
 			std::memcpy(subMeshes.data(), cursor, subMeshBytes);
+			cursor += subMeshBytes;
 		}
 
+		if (header.lodCount > 0)
+		{
+			std::vector<uint32_t> lodIndices(header.lodIndexCount);
+			std::memcpy(lodIndices.data(), cursor, lodIndexBytes);
+			cursor += lodIndexBytes;
+
+			// LOD 정보가 깨졌다면 원본만 쓴다.
+			const uint8_t* const end = data.dataPtr + data.size;
+			bool bLodValid = true;
+			std::vector<render::Mesh::Lod> lods(header.lodCount);
+			for (render::Mesh::Lod& lod : lods)
+			{
+				MeshAsset::LodHeader lodHeader{};
+				if (static_cast<std::size_t>(end - cursor) < sizeof(MeshAsset::LodHeader))
+				{
+					bLodValid = false;
+					break;
+				}
+				std::memcpy(&lodHeader, cursor, sizeof(MeshAsset::LodHeader));
+				cursor += sizeof(MeshAsset::LodHeader);
+
+				const std::size_t lodSubMeshBytes = lodHeader.subMeshCount * sizeof(render::SubMesh);
+				if (static_cast<std::size_t>(end - cursor) < lodSubMeshBytes)
+				{
+					bLodValid = false;
+					break;
+				}
+				lod.ratio = lodHeader.ratio;
+				lod.screenSize = lodHeader.screenSize;
+				lod.subMeshes.resize(lodHeader.subMeshCount);
+				std::memcpy(lod.subMeshes.data(), cursor, lodSubMeshBytes);
+				cursor += lodSubMeshBytes;
+			}
+			if (bLodValid)
+				mesh->SetLods(std::move(lodIndices), std::move(lods));
+			else
+				SH_ERROR_FORMAT("Invalid mesh asset LOD!: {}", asset.GetAssetUUID().ToString());
+		}
+		else
+			mesh->SetLods({}, {}); // LOD 설정도 에셋과 맞춘다.
+
 		mesh->SetSubMeshes(std::move(subMeshes));
+		mesh->SetQuantize(header.bQuantize != 0);
 		mesh->Build(ctx);
 
 		return mesh;
@@ -35,6 +35,12 @@ namespace sh::game
             return modelPtr->GetSkeletons();
         return skeletonData;
     }
+    SH_GAME_API auto ModelAsset::GetAnimationData() const -> std::vector<render::AnimationClip*>
+    {
+        if (modelPtr.IsValid())
+            return std::vector<render::AnimationClip*>(modelPtr->GetAnimations().begin(), modelPtr->GetAnimations().end());
+        return animationData;
+    }
 
     SH_GAME_API void ModelAsset::SetAssetData() const
     {
@@ -105,6 +111,21 @@ namespace sh::game
                 cursor = totalSize;
             }
         }
+
+        const core::SVector<render::AnimationClip*>& animations = modelPtr->GetAnimations();
+        const uint64_t animationCount = animations.size();
+        totalSize += sizeof(uint64_t) + sizeof(std::array<uint32_t, 4>) * animationCount;
+        data.resize(totalSize);
+        std::memcpy(data.data() + cursor, &animationCount, sizeof(uint64_t));
+        cursor += sizeof(uint64_t);
+        for (const render::AnimationClip* animation : animations)
+        {
+            std::array<uint32_t, 4> uuid{};
+            if (animation != nullptr)
+                uuid = animation->GetUUID();
+            std::memcpy(data.data() + cursor, uuid.data(), sizeof(uuid));
+            cursor += sizeof(uuid);
+        }
     }
     SH_GAME_API auto ModelAsset::ParseAssetData() -> bool
     {
@@ -171,6 +192,29 @@ namespace sh::game
             }
         }
 
+        // 애니메이션이 없던 때의 에셋은 스켈레톤에서 끝난다.
+        animationData.clear();
+        uint64_t animationCount = 0;
+        if (cursor + sizeof(uint64_t) > data.size())
+            return true;
+        std::memcpy(&animationCount, data.data() + cursor, sizeof(uint64_t));
+        cursor += sizeof(uint64_t);
+        if (animationCount > (data.size() - cursor) / sizeof(std::array<uint32_t, 4>))
+            return false;
+        animationData.reserve(animationCount);
+        for (uint64_t i = 0; i < animationCount; ++i)
+        {
+            std::array<uint32_t, 4> uuid{};
+            std::memcpy(uuid.data(), data.data() + cursor, sizeof(uuid));
+            cursor += sizeof(uuid);
+            const core::UUID animationUUID{ uuid };
+            if (animationUUID.IsEmpty())
+                continue;
+            render::AnimationClip* const animation = static_cast<render::AnimationClip*>(core::SObject::GetSObjectUsingResolver(animationUUID));
+            if (animation != nullptr)
+                animationData.push_back(animation);
+        }
+
         return true;
     }
 }//namespace
\ No newline at end of file
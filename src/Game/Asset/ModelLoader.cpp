@@ -4,9 +4,11 @@
 #include "Core/SObject.h"
 #include "Core/Logger.h"
 #include "Core/FileSystem.h"
+#include "Core/ThreadPool.h"
 
 #include "Render/Model.h"
 #include "Render/SkinnedMesh.h"
+#include "Render/MeshOptimizer.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "External/tinyobjloader/tiny_obj_loader.h"
@@ -17,15 +19,267 @@
 #include "glm/gtc/type_ptr.hpp"
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <string>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <limits>
 #include <unordered_map>
 #include <map>
 #include <queue>
 #include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SH_MODEL_LOADER_SSE2 1
+#include <emmintrin.h>
+#endif
 namespace sh::game
 {
+	namespace
+	{
+		/// @brief glTF 메쉬 하나를 병렬로 변환할 때 쓰는 데이터
+		struct GLTFMeshJob
+		{
+			int gltfNodeIdx = -1;
+			int nodeIdx = -1;
+			bool bSkinned = false;
+			bool bHasBones = false;
+
+			std::vector<render::Mesh::Vertex> verts;
+			std::vector<uint32_t> indices;
+			std::vector<render::SkinnedMesh::BoneVertex> boneVerts;
+			std::vector<render::SubMesh> subMeshes;
+			std::vector<uint32_t> vertexStarts; // 프리미티브별 첫 버텍스
+			std::vector<uint32_t> vertexCounts; // 프리미티브별 버텍스 수
+
+			render::Mesh* mesh = nullptr;
+		};
+
+#if SH_MODEL_LOADER_SSE2
+		template<bool bSigned>
+		inline auto WidenLo8(__m128i v) -> __m128i
+		{
+			if constexpr (bSigned)
+				return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+			else
+				return _mm_unpacklo_epi8(v, _mm_setzero_si128());
+		}
+		template<bool bSigned>
+		inline auto WidenHi8(__m128i v) -> __m128i
+		{
+			if constexpr (bSigned)
+				return _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+			else
+				return _mm_unpackhi_epi8(v, _mm_setzero_si128());
+		}
+		template<bool bSigned>
+		inline auto WidenLo16(__m128i v) -> __m128i
+		{
+			if constexpr (bSigned)
+				return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			else
+				return _mm_unpacklo_epi16(v, _mm_setzero_si128());
+		}
+		template<bool bSigned>
+		inline auto WidenHi16(__m128i v) -> __m128i
+		{
+			if constexpr (bSigned)
+				return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+			else
+				return _mm_unpackhi_epi16(v, _mm_setzero_si128());
+		}
+		/// @brief 32비트 정수 4개를 float로 바꿔 정규화 계수를 곱하고 저장한다.
+		inline void StoreFloats(__m128i v, __m128 scale, __m128 minValue, float* dst)
+		{
+			_mm_storeu_ps(dst, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(v), scale), minValue));
+		}
+#endif
+		/// @brief 정수 성분 count개를 float로 바꾼다.
+		/// @brief 정규화된 성분은 glTF 규칙대로 부호 없는 타입은 [0, 1], 부호 있는 타입은 [-1, 1]로 바뀐다.
+		template<typename T>
+		void ConvertComponents(const uint8_t* src, std::size_t count, bool bNormalized, float* dst)
+		{
+			constexpr bool bSigned = std::is_signed_v<T>;
+			const float scale = bNormalized ? 1.f / static_cast<float>(std::numeric_limits<T>::max()) : 1.f;
+			const float minValue = (bNormalized && bSigned) ? -1.f : std::numeric_limits<float>::lowest();
+
+			std::size_t i = 0;
+#if SH_MODEL_LOADER_SSE2
+			if constexpr (sizeof(T) <= 2)
+			{
+				constexpr std::size_t LANES = 16 / sizeof(T);
+				const __m128 scaleVec = _mm_set1_ps(scale);
+				const __m128 minVec = _mm_set1_ps(minValue);
+				for (; i + LANES <= count; i += LANES)
+				{
+					const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(T)));
+					if constexpr (sizeof(T) == 1)
+					{
+						const __m128i lo = WidenLo8<bSigned>(packed);
+						const __m128i hi = WidenHi8<bSigned>(packed);
+						StoreFloats(WidenLo16<bSigned>(lo), scaleVec, minVec, dst + i);
+						StoreFloats(WidenHi16<bSigned>(lo), scaleVec, minVec, dst + i + 4);
+						StoreFloats(WidenLo16<bSigned>(hi), scaleVec, minVec, dst + i + 8);
+						StoreFloats(WidenHi16<bSigned>(hi), scaleVec, minVec, dst + i + 12);
+					}
+					else
+					{
+						StoreFloats(WidenLo16<bSigned>(packed), scaleVec, minVec, dst + i);
+						StoreFloats(WidenHi16<bSigned>(packed), scaleVec, minVec, dst + i + 4);
+					}
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				T value;
+				std::memcpy(&value, src + i * sizeof(T), sizeof(T));
+				dst[i] = std::max(static_cast<float>(value) * scale, minValue);
+			}
+		}
+		auto FindAccessor(const tinygltf::Model& model, const tinygltf::Primitive& primitive, const char* name) -> const tinygltf::Accessor*
+		{
+			auto it = primitive.attributes.find(name);
+			if (it == primitive.attributes.end() || it->second < 0 || it->second >= static_cast<int>(model.accessors.size()))
+				return nullptr;
+			return &model.accessors[it->second];
+		}
+		/// @brief 인덱스 액세서를 읽어 vertexStart를 더한 뒤 dst에 쓴다.
+		template<typename T>
+		auto ReadIndices(const uint8_t* src, std::size_t count, uint32_t vertexStart, uint32_t vertexCount, uint32_t* dst) -> bool
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				T index;
+				std::memcpy(&index, src + i * sizeof(T), sizeof(T));
+				if (index >= vertexCount)
+					return false;
+				dst[i] = static_cast<uint32_t>(index) + vertexStart;
+			}
+			return true;
+		}
+		/// @brief 프리미티브 하나를 job의 미리 잡아둔 범위에 변환한다. 프리미티브마다 범위가 겹치지 않으므로 동시에 호출해도 된다.
+		auto ConvertPrimitive(const tinygltf::Model& model, const tinygltf::Primitive& primitive, GLTFMeshJob& job, std::size_t primitiveIdx) -> bool
+		{
+			const uint32_t vertexStart = job.vertexStarts[primitiveIdx];
+			const uint32_t vertexCount = job.vertexCounts[primitiveIdx];
+			render::Mesh::Vertex* const verts = job.verts.data() + vertexStart;
+
+			std::vector<float> data;
+			if (const tinygltf::Accessor* accessor = FindAccessor(model, primitive, "POSITION"))
+			{
+				if (!ModelLoader::ReadGLTFAccessor(model, *accessor, data) || data.size() < vertexCount * 3)
+					return false;
+				for (uint32_t v = 0; v < vertexCount; ++v)
+					verts[v].vertex = glm::make_vec3(&data[v * 3]);
+			}
+			if (const tinygltf::Accessor* accessor = FindAccessor(model, primitive, "NORMAL"))
+			{
+				if (!ModelLoader::ReadGLTFAccessor(model, *accessor, data) || data.size() < vertexCount * 3)
+					return false;
+				for (uint32_t v = 0; v < vertexCount; ++v)
+					verts[v].normal = glm::normalize(glm::make_vec3(&data[v * 3]));
+			}
+			if (const tinygltf::Accessor* accessor = FindAccessor(model, primitive, "TEXCOORD_0"))
+			{
+				if (!ModelLoader::ReadGLTFAccessor(model, *accessor, data) || data.size() < vertexCount * 2)
+					return false;
+				for (uint32_t v = 0; v < vertexCount; ++v)
+					verts[v].uv = glm::make_vec2(&data[v * 2]);
+			}
+			if (job.bHasBones)
+			{
+				const tinygltf::Accessor* joints = FindAccessor(model, primitive, "JOINTS_0");
+				const tinygltf::Accessor* weights = FindAccessor(model, primitive, "WEIGHTS_0");
+				if (joints != nullptr && weights != nullptr)
+				{
+					render::SkinnedMesh::BoneVertex* const boneVerts = job.boneVerts.data() + vertexStart;
+					if (!ModelLoader::ReadGLTFAccessor(model, *joints, data) || data.size() < vertexCount * 4)
+						return false;
+					for (uint32_t v = 0; v < vertexCount; ++v)
+						boneVerts[v].boneIndices = glm::ivec4{ glm::make_vec4(&data[v * 4]) };
+					if (!ModelLoader::ReadGLTFAccessor(model, *weights, data) || data.size() < vertexCount * 4)
+						return false;
+					for (uint32_t v = 0; v < vertexCount; ++v)
+						boneVerts[v].boneWeights = glm::make_vec4(&data[v * 4]);
+				}
+			}
+
+			const render::SubMesh& subMesh = job.subMeshes[primitiveIdx];
+			uint32_t* const indices = job.indices.data() + subMesh.indexOffset;
+			if (primitive.indices < 0)
+			{
+				std::iota(indices, indices + subMesh.indexCount, vertexStart);
+				return true;
+			}
+			const tinygltf::Accessor& accessor = model.accessors[primitive.indices];
+			if (accessor.bufferView < 0)
+				return false;
+			const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
+			const tinygltf::Buffer& buffer = model.buffers[view.buffer];
+			const int compSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+			const std::size_t offset = view.byteOffset + accessor.byteOffset;
+			if (compSize <= 0 || offset + accessor.count * compSize > buffer.data.size())
+				return false;
+
+			const uint8_t* src = buffer.data.data() + offset;
+			switch (accessor.componentType)
+			{
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+				return ReadIndices<uint32_t>(src, accessor.count, vertexStart, vertexCount, indices);
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+				return ReadIndices<uint16_t>(src, accessor.count, vertexStart, vertexCount, indices);
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
+				return ReadIndices<uint8_t>(src, accessor.count, vertexStart, vertexCount, indices);
+			default:
+				return false;
+			}
+		}
+		auto ReadMatrices(const tinygltf::Model& model, int accessorIdx) -> std::vector<glm::mat4>
+		{
+			std::vector<glm::mat4> result;
+			std::vector<float> data;
+			if (accessorIdx < 0 || !ModelLoader::ReadGLTFAccessor(model, model.accessors[accessorIdx], data))
+				return result;
+			result.resize(data.size() / 16);
+			for (std::size_t i = 0; i < result.size(); ++i)
+				result[i] = glm::make_mat4x4(&data[i * 16]);
+			return result;
+		}
+		/// @brief glTF 애니메이션 샘플러를 커브로 읽는다. CUBICSPLINE은 탄젠트를 버리고 키 값만 쓴다.
+		/// @param compCount 이동, 크기는 3, 회전은 4
+		auto ReadAnimationCurve(const tinygltf::Model& model, const tinygltf::AnimationSampler& sampler, int compCount, render::AnimationClip::RawCurve& curve) -> bool
+		{
+			const int accessorCount = static_cast<int>(model.accessors.size());
+			if (sampler.input < 0 || sampler.input >= accessorCount || sampler.output < 0 || sampler.output >= accessorCount)
+				return false;
+			std::vector<float> values;
+			if (!ModelLoader::ReadGLTFAccessor(model, model.accessors[sampler.input], curve.times) || !ModelLoader::ReadGLTFAccessor(model, model.accessors[sampler.output], values))
+				return false;
+
+			const bool bCubic = sampler.interpolation == "CUBICSPLINE";
+			const std::size_t elementsPerKey = bCubic ? 3 : 1; // 입력 탄젠트, 값, 출력 탄젠트
+			const std::size_t keyCount = std::min(curve.times.size(), values.size() / (compCount * elementsPerKey));
+			curve.times.resize(keyCount);
+			curve.values.assign(keyCount, glm::vec4{ 0.f });
+			for (std::size_t key = 0; key < keyCount; ++key)
+			{
+				const float* const src = values.data() + (key * elementsPerKey + (bCubic ? 1 : 0)) * compCount;
+				for (int c = 0; c < compCount; ++c)
+					curve.values[key][c] = src[c];
+			}
+			curve.bStep = sampler.interpolation == "STEP";
+			return true;
+		}
+		/// @brief 모델 임포트는 이미지 픽셀을 쓰지 않으므로 tinygltf가 이미지를 디코딩하지 않게 건너뛴다.
+		auto SkipImage(tinygltf::Image* image, const int imageIdx, std::string* err, std::string* warn,
+			int reqWidth, int reqHeight, const unsigned char* bytes, int size, void* userData) -> bool
+		{
+			return true;
+		}
+	}//namespace
+
 	SH_GAME_API auto ModelLoader::LoadObj(const std::filesystem::path& path) const -> render::Model*
 	{
 		tinyobj::attrib_t attrib;
@@ -95,6 +349,8 @@ namespace sh::game
 		}
 
 		CreateTangents(verts, indices);
+		if (bOptimizeMesh)
+			render::MeshOptimizer::Optimize(verts, indices, {});
 
 		auto mesh = core::SObject::Create<render::Mesh>();
 		mesh->GetBoundingBox().Set(min, max);
@@ -102,6 +358,10 @@ namespace sh::game
 
 		mesh->SetVertex(std::move(verts));
 		mesh->SetIndices(std::move(indices));
+		// 양자화 여부는 모델마다의 임포트 설정이다. 메타에서 끄면 Model::Deserialize에서 다시 Build된다.
+		mesh->SetQuantize(true);
+		if (bGenerateLods)
+			mesh->GenerateLods();
 
 		mesh->Build(context);
 
@@ -120,25 +380,93 @@ namespace sh::game
 	}
 	SH_GAME_API auto ModelLoader::LoadGLTF(const std::filesystem::path& dir) const -> render::Model*
 	{
-		static tinygltf::TinyGLTF gltfContext;
+		tinygltf::TinyGLTF gltfContext;
 		tinygltf::Model gltfModel;
 		std::string error, warning;
 
 		auto binary = core::FileSystem::LoadBinary(dir);
 		if (!binary.has_value())
 			return nullptr;
+
+		// 메쉬와 애니메이션만 변환하므로 .glb에 들어있는 이미지는 디코딩하지 않는다.
+		gltfContext.SetImageLoader(SkipImage, nullptr);
 		
 		if (!gltfContext.LoadBinaryFromMemory(&gltfModel, &error, &warning, binary.value().data(), binary.value().size()))
 		{
 			SH_ERROR_FORMAT("{}", error);
 			return nullptr;
 		}
+
+		return LoadGLTF(gltfModel, dir.filename().u8string(), true);
+	}
+	SH_GAME_API auto ModelLoader::ReadGLTFAccessor(const tinygltf::Model& model, const tinygltf::Accessor& accessor, std::vector<float>& out) -> bool
+	{
+		const int compCount = tinygltf::GetNumComponentsInType(accessor.type);
+		const int compSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+		if (compCount <= 0 || compSize <= 0)
+			return false;
+
+		const std::size_t scalarCount = accessor.count * compCount;
+		out.resize(scalarCount);
+		if (accessor.bufferView < 0)
+		{
+			std::fill(out.begin(), out.end(), 0.f);
+			return true;
+		}
+		const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
+		const tinygltf::Buffer& buffer = model.buffers[view.buffer];
+
+		const std::size_t elementSize = static_cast<std::size_t>(compCount) * compSize;
+		const int byteStride = accessor.ByteStride(view);
+		if (byteStride < 0 || static_cast<std::size_t>(byteStride) < elementSize)
+			return false;
+		const std::size_t stride = static_cast<std::size_t>(byteStride);
+		const std::size_t offset = view.byteOffset + accessor.byteOffset;
+		if (accessor.count > 0 && offset + stride * (accessor.count - 1) + elementSize > buffer.data.size())
+			return false;
+
+		const uint8_t* src = buffer.data.data() + offset;
+		// 섞여있는 버퍼는 먼저 요소만 모아 빽빽하게 만든 뒤 한번에 변환한다.
+		std::vector<uint8_t> packed;
+		if (stride != elementSize)
+		{
+			packed.resize(elementSize * accessor.count);
+			for (std::size_t i = 0; i < accessor.count; ++i)
+				std::memcpy(packed.data() + i * elementSize, src + i * stride, elementSize);
+			src = packed.data();
+		}
+
+		switch (accessor.componentType)
+		{
+		case TINYGLTF_COMPONENT_TYPE_FLOAT:
+			std::memcpy(out.data(), src, scalarCount * sizeof(float));
+			return true;
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+			ConvertComponents<uint8_t>(src, scalarCount, accessor.normalized, out.data());
+			return true;
+		case TINYGLTF_COMPONENT_TYPE_BYTE:
+			ConvertComponents<int8_t>(src, scalarCount, accessor.normalized, out.data());
+			return true;
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+			ConvertComponents<uint16_t>(src, scalarCount, accessor.normalized, out.data());
+			return true;
+		case TINYGLTF_COMPONENT_TYPE_SHORT:
+			ConvertComponents<int16_t>(src, scalarCount, accessor.normalized, out.data());
+			return true;
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+			ConvertComponents<uint32_t>(src, scalarCount, accessor.normalized, out.data());
+			return true;
+		default:
+			return false;
+		}
+	}
+	SH_GAME_API auto ModelLoader::LoadGLTF(const tinygltf::Model& gltfModel, const std::string& name, bool bBuild) const -> render::Model*
+	{
 		if (gltfModel.scenes.empty())
 		{
-			SH_ERROR_FORMAT("Scene is empty: {}", dir.u8string());
+			SH_ERROR_FORMAT("Scene is empty: {}", name);
 			return nullptr;
 		}
-
 		const auto& scene = gltfModel.scenes[0];
 
 		std::vector<render::Model::Node> nodes;
@@ -150,6 +478,7 @@ namespace sh::game
 		using GLTFNodeIdx = int;
 		using NodeIdx = int;
 		std::map<GLTFNodeIdx, NodeIdx> nodeMap;
+		std::vector<GLTFMeshJob> meshJobs;
 
 		std::queue<std::pair<GLTFNodeIdx, NodeIdx>> nodeQ{}; // 노드idx, 부모idx
 		for (int nodeIdx : scene.nodes)
@@ -165,7 +494,7 @@ namespace sh::game
 
 			nodes[parentNodeIdx].childrenIdx.push_back(idx);
 
-			tinygltf::Node& gltfNode = gltfModel.nodes[gltfNodeIdx];
+			const tinygltf::Node& gltfNode = gltfModel.nodes[gltfNodeIdx];
 
 			for (int childIdx : gltfNode.children)
 				nodeQ.push({ childIdx, idx });
@@ -197,182 +526,132 @@ namespace sh::game
 
 			if (gltfNode.mesh >= 0)
 			{
-				const float minLimit = std::numeric_limits<float>::min();
-				const float maxLimit = std::numeric_limits<float>::max();
-				glm::vec3 min{ maxLimit, maxLimit, maxLimit }, max{ minLimit, minLimit, minLimit };
-
-				std::vector<render::Mesh::Vertex> verts;
-				std::vector<uint32_t> indices;
-				std::vector<render::SkinnedMesh::BoneVertex> boneVerts;
-				std::vector<render::SubMesh> subMeshes;
-				bool bSkinned = (gltfNode.skin >= 0);
+				// 프리미티브마다 버텍스, 인덱스 범위를 미리 잡아둬야 프리미티브를 동시에 변환할 수 있다.
+				GLTFMeshJob& job = meshJobs.emplace_back();
+				job.gltfNodeIdx = gltfNodeIdx;
+				job.nodeIdx = idx;
+				job.bSkinned = (gltfNode.skin >= 0);
+
+				uint32_t vertexCount = 0;
+				std::size_t indexCount = 0;
+				for (const tinygltf::Primitive& primitive : gltfModel.meshes[gltfNode.mesh].primitives)
+				{
+					const tinygltf::Accessor* position = FindAccessor(gltfModel, primitive, "POSITION");
+					const uint32_t primVertexCount = position != nullptr ? static_cast<uint32_t>(position->count) : 0;
+					const std::size_t primIndexCount = primitive.indices >= 0 ? gltfModel.accessors[primitive.indices].count : primVertexCount;
 
-				const tinygltf::Mesh& gltfMesh = gltfModel.meshes[gltfNode.mesh];
+					job.vertexStarts.push_back(vertexCount);
+					job.vertexCounts.push_back(primVertexCount);
+					render::SubMesh& subMesh = job.subMeshes.emplace_back();
+					subMesh.indexOffset = indexCount;
+					subMesh.indexCount = static_cast<uint32_t>(primIndexCount);
 
-				for (auto& primitive : gltfMesh.primitives)
-				{
-					render::SubMesh& subMesh = subMeshes.emplace_back();
+					if (job.bSkinned && FindAccessor(gltfModel, primitive, "JOINTS_0") != nullptr && FindAccessor(gltfModel, primitive, "WEIGHTS_0") != nullptr)
+						job.bHasBones = true;
 
-					uint32_t firstIndex = static_cast<uint32_t>(indices.size());
-					uint32_t vertexStart = static_cast<uint32_t>(verts.size());
+					vertexCount += primVertexCount;
+					indexCount += primIndexCount;
+				}
+				job.verts.resize(vertexCount, render::Mesh::Vertex{});
+				job.indices.resize(indexCount);
+				if (job.bHasBones)
+					job.boneVerts.resize(vertexCount);
+			}
+		} // while (!nodeQ.empty())
 
-					const float* positionBuffer = nullptr;
-					const float* normalsBuffer = nullptr;
-					const float* texCoordsBuffer = nullptr;
-					const uint8_t* jointsBuffer = nullptr;
-					const float* weightsBuffer = nullptr;
-					int jointsCompType = 0;
-					std::size_t vertexCount = 0;
+		// 모든 메쉬의 프리미티브를 동시에 변환한다.
+		std::vector<std::pair<std::size_t, std::size_t>> primitiveTasks; // job idx, 프리미티브 idx
+		for (std::size_t jobIdx = 0; jobIdx < meshJobs.size(); ++jobIdx)
+		{
+			for (std::size_t primIdx = 0; primIdx < meshJobs[jobIdx].subMeshes.size(); ++primIdx)
+				primitiveTasks.push_back({ jobIdx, primIdx });
+		}
+		std::vector<uint8_t> primitiveResults(primitiveTasks.size(), 0);
+		core::ThreadPool::GetInstance()->ParallelFor(primitiveTasks.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					auto [jobIdx, primIdx] = primitiveTasks[i];
+					GLTFMeshJob& job = meshJobs[jobIdx];
+					const tinygltf::Primitive& primitive = gltfModel.meshes[gltfModel.nodes[job.gltfNodeIdx].mesh].primitives[primIdx];
+					primitiveResults[i] = ConvertPrimitive(gltfModel, primitive, job, primIdx) ? 1 : 0;
+				}
+			}
+		);
+		for (std::size_t i = 0; i < primitiveTasks.size(); ++i)
+		{
+			if (primitiveResults[i] == 0)
+			{
+				const GLTFMeshJob& job = meshJobs[primitiveTasks[i].first];
+				SH_ERROR_FORMAT("Unsupported or invalid primitive {} in mesh {}: {}", primitiveTasks[i].second, gltfModel.nodes[job.gltfNodeIdx].name, name);
+				return nullptr;
+			}
+		}
 
-					if (auto it = primitive.attributes.find("POSITION"); it != primitive.attributes.end())
-					{
-						const tinygltf::Accessor& accessor = gltfModel.accessors[it->second];
-						const tinygltf::BufferView& view = gltfModel.bufferViews[accessor.bufferView];
-						positionBuffer = reinterpret_cast<const float*>(&(gltfModel.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]));
-						vertexCount = accessor.count;
-					}
-					if (auto it = primitive.attributes.find("NORMAL"); it != primitive.attributes.end())
-					{
-						const tinygltf::Accessor& accessor = gltfModel.accessors[it->second];
-						const tinygltf::BufferView& view = gltfModel.bufferViews[accessor.bufferView];
-						normalsBuffer = reinterpret_cast<const float*>(&(gltfModel.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]));
-					}
-					if (auto it = primitive.attributes.find("TEXCOORD_0"); it != primitive.attributes.end())
-					{
-						const tinygltf::Accessor& accessor = gltfModel.accessors[it->second];
-						const tinygltf::BufferView& view = gltfModel.bufferViews[accessor.bufferView];
-						texCoordsBuffer = reinterpret_cast<const float*>(&(gltfModel.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]));
-					}
-					if (bSkinned)
+		// SObject 생성은 메인 스레드에서 하고 탄젠트, 최적화, LOD 생성은 메쉬마다 동시에 한다.
+		for (GLTFMeshJob& job : meshJobs)
+		{
+			if (job.bSkinned)
+				job.mesh = core::SObject::Create<render::SkinnedMesh>();
+			else
+				job.mesh = core::SObject::Create<render::Mesh>();
+			job.mesh->SetName(gltfModel.nodes[job.gltfNodeIdx].name);
+		}
+		core::ThreadPool::GetInstance()->ParallelFor(meshJobs.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					GLTFMeshJob& job = meshJobs[i];
+					CreateTangents(job.verts, job.indices);
+					if (bOptimizeMesh)
 					{
-						if (auto it = primitive.attributes.find("JOINTS_0"); it != primitive.attributes.end())
-						{
-							const tinygltf::Accessor& accessor = gltfModel.accessors[it->second];
-							const tinygltf::BufferView& view = gltfModel.bufferViews[accessor.bufferView];
-							jointsBuffer = &gltfModel.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset];
-							jointsCompType = accessor.componentType;
-						}
-						if (auto it = primitive.attributes.find("WEIGHTS_0"); it != primitive.attributes.end())
-						{
-							const tinygltf::Accessor& accessor = gltfModel.accessors[it->second];
-							const tinygltf::BufferView& view = gltfModel.bufferViews[accessor.bufferView];
-							weightsBuffer = reinterpret_cast<const float*>(&gltfModel.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
-						}
+						// 본 버텍스가 없는 스킨 메쉬는 버텍스 순서를 바꾸면 안 된다.
+						if (!job.bSkinned)
+							render::MeshOptimizer::Optimize(job.verts, job.indices, job.subMeshes);
+						else if (job.boneVerts.size() == job.verts.size())
+							render::MeshOptimizer::Optimize(job.verts, job.indices, job.subMeshes, &job.boneVerts);
 					}
 
-					for (size_t v = 0; v < vertexCount; v++)
+					const float maxLimit = std::numeric_limits<float>::max();
+					const float minLimit = std::numeric_limits<float>::lowest();
+					glm::vec3 min{ maxLimit, maxLimit, maxLimit }, max{ minLimit, minLimit, minLimit };
+					for (const render::Mesh::Vertex& vert : job.verts)
 					{
-						render::Mesh::Vertex vert{};
-						vert.vertex = glm::make_vec3(&positionBuffer[v * 3]);
-						vert.normal = glm::normalize(glm::vec3(normalsBuffer ? glm::make_vec3(&normalsBuffer[v * 3]) : glm::vec3(0.0f)));
-						vert.uv = texCoordsBuffer ? glm::make_vec2(&texCoordsBuffer[v * 2]) : glm::vec2(0.0f);
-						verts.push_back(vert);
-
-						min.x = std::min(min.x, vert.vertex.x);
-						min.y = std::min(min.y, vert.vertex.y);
-						min.z = std::min(min.z, vert.vertex.z);
-						max.x = std::max(max.x, vert.vertex.x);
-						max.y = std::max(max.y, vert.vertex.y);
-						max.z = std::max(max.z, vert.vertex.z);
-
-						if (bSkinned && jointsBuffer != nullptr && weightsBuffer != nullptr)
-						{
-							render::SkinnedMesh::BoneVertex bv{};
-							if (jointsCompType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-							{
-								const uint8_t* j = jointsBuffer + v * 4;
-								bv.boneIndices = glm::ivec4{ j[0], j[1], j[2], j[3] };
-							}
-							else // UNSIGNED_SHORT
-							{
-								const uint16_t* j = reinterpret_cast<const uint16_t*>(jointsBuffer) + v * 4;
-								bv.boneIndices = glm::ivec4{ j[0], j[1], j[2], j[3] };
-							}
-							bv.boneWeights = glm::make_vec4(&weightsBuffer[v * 4]);
-							boneVerts.push_back(bv);
-						}
+						min = glm::min(min, vert.vertex);
+						max = glm::max(max, vert.vertex);
 					}
-					// indices
-					{
-						const tinygltf::Accessor& accessor = gltfModel.accessors[primitive.indices];
-						const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
-						const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
-
-						subMesh.indexOffset = indices.size();
-						subMesh.indexCount = static_cast<uint32_t>(accessor.count);
-
-						switch (accessor.componentType)
-						{
-						case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
-						{
-							const uint32_t* buf = reinterpret_cast<const uint32_t*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
-							for (size_t index = 0; index < accessor.count; index++)
-								indices.push_back(buf[index] + vertexStart);
-							break;
-						}
-						case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
-						{
-							const uint16_t* buf = reinterpret_cast<const uint16_t*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
-							for (size_t index = 0; index < accessor.count; index++)
-								indices.push_back(buf[index] + vertexStart);
-							break;
-						}
-						case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
-						{
-							const uint8_t* buf = reinterpret_cast<const uint8_t*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
-							for (size_t index = 0; index < accessor.count; index++)
-								indices.push_back(buf[index] + vertexStart);
-							break;
-						}
-						default:
-							std::cerr << "Index component type " << accessor.componentType << " not supported!" << std::endl;
-							return nullptr;
-						}
-					}
-				} // for (auto& primitive : gltfMesh.primitives)
-				CreateTangents(verts, indices);
+					if (job.verts.empty())
+						min = max = glm::vec3{ 0.f };
 
-				render::Mesh* meshPtr = nullptr;
-				if (bSkinned)
-				{
-					auto skinnedMesh = core::SObject::Create<render::SkinnedMesh>();
-					skinnedMesh->SetName(gltfNode.name);
-					skinnedMesh->GetBoundingBox().Set(min, max);
-					skinnedMesh->SetVertex(std::move(verts));
-					skinnedMesh->SetIndices(std::move(indices));
-					skinnedMesh->SetBoneVertices(std::move(boneVerts));
-					skinnedMesh->SetSubMeshes(std::move(subMeshes));
-
-					const tinygltf::Skin& gltfSkin = gltfModel.skins[gltfNode.skin];
-					if (gltfSkin.inverseBindMatrices >= 0)
+					render::Mesh* const mesh = job.mesh;
+					mesh->GetBoundingBox().Set(min, max);
+					mesh->SetVertex(std::move(job.verts));
+					mesh->SetIndices(std::move(job.indices));
+					mesh->SetSubMeshes(std::move(job.subMeshes));
+					if (job.bSkinned)
 					{
-						const tinygltf::Accessor& acc = gltfModel.accessors[gltfSkin.inverseBindMatrices];
-						const tinygltf::BufferView& bv = gltfModel.bufferViews[acc.bufferView];
-						const float* ibmData = reinterpret_cast<const float*>(
-							&gltfModel.buffers[bv.buffer].data[acc.byteOffset + bv.byteOffset]);
-						std::vector<glm::mat4> ibms(acc.count);
-						for (std::size_t i = 0; i < acc.count; ++i)
-							ibms[i] = glm::make_mat4x4(ibmData + i * 16);
-						skinnedMesh->SetInverseBindMatrices(std::move(ibms));
-					}
+						auto skinnedMesh = static_cast<render::SkinnedMesh*>(mesh);
+						skinnedMesh->SetBoneVertices(std::move(job.boneVerts));
 
-					skinnedMesh->Build(context);
-					meshPtr = skinnedMesh;
-				}
-				else
-				{
-					auto mesh = core::SObject::Create<render::Mesh>();
-					mesh->SetName(gltfNode.name);
-					mesh->GetBoundingBox().Set(min, max);
-					mesh->SetVertex(std::move(verts));
-					mesh->SetIndices(std::move(indices));
-					mesh->SetSubMeshes(std::move(subMeshes));
-					mesh->Build(context);
-					meshPtr = mesh;
+						const tinygltf::Skin& gltfSkin = gltfModel.skins[gltfModel.nodes[job.gltfNodeIdx].skin];
+						if (gltfSkin.inverseBindMatrices >= 0)
+							skinnedMesh->SetInverseBindMatrices(ReadMatrices(gltfModel, gltfSkin.inverseBindMatrices));
+					}
+					else
+						mesh->SetQuantize(true);
+					if (bGenerateLods)
+						mesh->GenerateLods();
 				}
-				node.mesh = meshPtr;
 			}
-		} // while (!nodeQ.empty())
+		);
+		for (GLTFMeshJob& job : meshJobs)
+		{
+			if (bBuild)
+				job.mesh->Build(context);
+			nodes[job.nodeIdx].mesh = job.mesh;
+		}
 
 		// 스킨 데이터
 		std::vector<render::Skeleton> skeletons;
@@ -391,22 +670,69 @@ namespace sh::game
 					skeleton.joints[i].nodeIdx = it->second;
 			}
 
-			if (gltfSkin.inverseBindMatrices >= 0)
+			const std::vector<glm::mat4> ibms = ReadMatrices(gltfModel, gltfSkin.inverseBindMatrices);
+			for (std::size_t i = 0; i < jointCount && i < ibms.size(); ++i)
+				skeleton.joints[i].inverseBindMat = ibms[i];
+		}
+
+		// 애니메이션. 트랙은 대상 노드 이름으로 스켈레톤 조인트와 연결된다.
+		std::vector<std::vector<render::AnimationClip::RawTrack>> animationTracks;
+		std::vector<render::AnimationClip*> animations;
+		for (std::size_t animIdx = 0; animIdx < gltfModel.animations.size(); ++animIdx)
+		{
+			const tinygltf::Animation& gltfAnim = gltfModel.animations[animIdx];
+			std::vector<render::AnimationClip::RawTrack> tracks;
+			std::unordered_map<GLTFNodeIdx, std::size_t> trackMap;
+			for (const tinygltf::AnimationChannel& channel : gltfAnim.channels)
 			{
-				const tinygltf::Accessor& acc = gltfModel.accessors[gltfSkin.inverseBindMatrices];
-				const tinygltf::BufferView& bv = gltfModel.bufferViews[acc.bufferView];
-				const float* ibmData = reinterpret_cast<const float*>(
-					&gltfModel.buffers[bv.buffer].data[acc.byteOffset + bv.byteOffset]);
-				for (std::size_t i = 0; i < jointCount && i < acc.count; ++i)
+				if (channel.target_node < 0 || channel.target_node >= static_cast<int>(gltfModel.nodes.size()) ||
+					channel.sampler < 0 || channel.sampler >= static_cast<int>(gltfAnim.samplers.size()))
+					continue;
+
+				auto [it, bInserted] = trackMap.insert({ channel.target_node, tracks.size() });
+				if (bInserted)
+					tracks.emplace_back().name = gltfModel.nodes[channel.target_node].name;
+				render::AnimationClip::RawTrack& track = tracks[it->second];
+
+				render::AnimationClip::RawCurve* curve = nullptr;
+				int compCount = 3;
+				if (channel.target_path == "translation")
+					curve = &track.translation;
+				else if (channel.target_path == "rotation")
 				{
-					skeleton.joints[i].inverseBindMat = glm::make_mat4x4(ibmData + i * 16);
+					curve = &track.rotation;
+					compCount = 4;
 				}
+				else if (channel.target_path == "scale")
+					curve = &track.scale;
+				else
+					continue; // 모프 타겟 가중치는 지원하지 않는다.
+
+				if (!ReadAnimationCurve(gltfModel, gltfAnim.samplers[channel.sampler], compCount, *curve))
+					SH_ERROR_FORMAT("Invalid animation channel({}) in {}: {}", channel.target_path, gltfAnim.name, name);
 			}
+			if (tracks.empty())
+				continue;
+
+			render::AnimationClip* const clip = core::SObject::Create<render::AnimationClip>();
+			clip->SetName(gltfAnim.name.empty() ? fmt::format("Animation{}", animIdx) : gltfAnim.name);
+			animations.push_back(clip);
+			animationTracks.push_back(std::move(tracks));
 		}
+		core::ThreadPool::GetInstance()->ParallelFor(animations.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					animations[i]->Compress(animationTracks[i]);
+				}
+			}
+		);
 
 		auto model = core::SObject::Create<render::Model>(std::move(nodes));
-		model->SetName(dir.filename().u8string());
+		model->SetName(name);
 		model->SetSkeletons(std::move(skeletons));
+		model->SetAnimations(std::move(animations));
 		return model;
 	}
 	auto ModelLoader::CalculateTangent(
@@ -480,6 +806,7 @@ namespace sh::game
 		auto model = core::SObject::Create<render::Model>(modelAsset.GetData());
 		model->SetUUID(asset.GetAssetUUID());
 		model->SetSkeletons(modelAsset.GetSkeletonData());
+		model->SetAnimations(modelAsset.GetAnimationData());
 		return model;
 	}
 
@@ -37,4 +37,8 @@ namespace sh::game
 
 		return !prefabData.is_discarded();
 	}
+	SH_GAME_API auto PrefabAsset::GetDependencies() const -> std::vector<core::UUID>
+	{
+		return CollectUUIDs(prefabData);
+	}
 }//namespace
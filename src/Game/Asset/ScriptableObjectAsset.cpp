@@ -41,4 +41,8 @@ namespace sh::game
 
 		return true;
 	}
+	SH_GAME_API auto ScriptableObjectAsset::GetDependencies() const -> std::vector<core::UUID>
+	{
+		return CollectUUIDs(serializationData);
+	}
 }//namespace
\ No newline at end of file
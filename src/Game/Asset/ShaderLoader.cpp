@@ -3,12 +3,10 @@
 
 #include "Core/FileSystem.h"
 #include "Core/Logger.h"
-#include "Core/ExecuteProcess.h"
 
 #include "Render/Shader.h"
 #include "Render/ShaderPassBuilder.h"
 #include "Render/ShaderParser.h"
-#include "Render/ShaderGenerator.h"
 #include "Render/ShaderCreateInfo.h"
 
 #include <string>
@@ -19,9 +17,7 @@ namespace sh::game
 	ShaderLoader::ShaderLoader(render::ShaderPassBuilder* builder) :
 		passBuilder(builder)
 	{
-		cachePath = fs::current_path() / "cache";
-		if (!fs::exists(cachePath))
-			fs::create_directory(cachePath);
+		SetCachePath(fs::current_path() / "cache");
 	}
 	ShaderLoader::~ShaderLoader()
 	{
@@ -30,6 +26,7 @@ namespace sh::game
 	SH_GAME_API void ShaderLoader::SetCachePath(const std::filesystem::path& path)
 	{
 		cachePath = path;
+		compiler.SetCachePath(cachePath);
 	}
 
 	SH_GAME_API auto ShaderLoader::GetCachePath() const -> const std::filesystem::path&
@@ -45,9 +42,6 @@ namespace sh::game
 			SH_ERROR_FORMAT("Can't load file: {}", path.string());
 			return nullptr;
 		}
-		if (!std::filesystem::exists(cachePath))
-			std::filesystem::create_directory(cachePath);
-
 		render::ShaderLexer lexer{};
 		render::ShaderParser parser{};
 
@@ -61,41 +55,40 @@ namespace sh::game
 			SH_ERROR_FORMAT("Shader parsing error: {}", e.what());
 			return nullptr;
 		}
+		// 모든 패스의 스테이지를 한번에 컴파일한다.
+		std::vector<render::ShaderCompiler::Source> sources;
 		for (const render::ShaderAST::PassNode& passNode : shaderCI.shaderNode.passes)
 		{
-			std::vector<std::filesystem::path> shaderPaths = render::ShaderGenerator::GenerateShaderFile(shaderCI.shaderNode.shaderName, passNode, cachePath);
-
-			for (const std::filesystem::path& shaderPath : shaderPaths)
+			for (const render::ShaderAST::StageNode& stage : passNode.stages)
 			{
-				std::string name = shaderPath.filename().string() + ".spv";
-				std::filesystem::path spirvPath = (shaderPath.parent_path() / name);
-
-				render::ShaderPassBuilder::shaderType stageType = render::ShaderPassBuilder::shaderType::Vertex;
-				if (shaderPath.extension() == ".frag")
-					stageType = render::ShaderPassBuilder::shaderType::Fragment;
-
-				// 컴파일
-				
-				std::string output;
-				std::string compiler = "glslc";
-#if _WIN32
-				std::vector<std::string> args = { fmt::format("\"{}\"", shaderPath.u8string()), "-o", fmt::format("\"{}\"", spirvPath.u8string()) };
-				compiler += ".exe";
-#else
-				std::vector<std::string> args = { fmt::format("{}", shaderPath.u8string()), "-o", fmt::format("{}", spirvPath.u8string()) };
-#endif
-				if (!core::ExecuteProcess::Execute(compiler, args, output))
+				render::ShaderCompiler::Source source{};
+				source.code = stage.code;
+				source.name = fmt::format("{}_{}", shaderCI.shaderNode.shaderName, passNode.name);
+				if (stage.type == render::ShaderAST::StageType::Vertex)
+					source.stage = render::ShaderCompiler::Stage::Vertex;
+				else if (stage.type == render::ShaderAST::StageType::Fragment)
+					source.stage = render::ShaderCompiler::Stage::Fragment;
+				else
 				{
-					SH_ERROR_FORMAT("Shader compile error: {}", output);
+					SH_ERROR_FORMAT("Unknown shader stage: {}", source.name);
 					return nullptr;
 				}
-				// spir-v 불러오기
-				std::optional<std::vector<uint8_t>> spirv = core::FileSystem::LoadBinary(spirvPath);
+				sources.push_back(std::move(source));
+			}
+		}
+		std::vector<std::optional<render::ShaderCompiler::Spirv>> spirvs = compiler.CompileAll(sources);
+
+		std::size_t sourceIdx = 0;
+		for (const render::ShaderAST::PassNode& passNode : shaderCI.shaderNode.passes)
+		{
+			for (const render::ShaderAST::StageNode& stage : passNode.stages)
+			{
+				std::optional<render::ShaderCompiler::Spirv>& spirv = spirvs[sourceIdx++];
 				if (!spirv.has_value())
-				{
-					SH_ERROR_FORMAT("Temp shader load error: {}", spirvPath.string());
 					return nullptr;
-				}
+
+				const render::ShaderPassBuilder::shaderType stageType = stage.type == render::ShaderAST::StageType::Fragment ?
+					render::ShaderPassBuilder::shaderType::Fragment : render::ShaderPassBuilder::shaderType::Vertex;
 				passBuilder->SetData(stageType, std::move(spirv.value()));
 			}
 
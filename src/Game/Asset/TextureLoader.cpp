@@ -1,10 +1,14 @@
 ﻿#define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include "Asset/TextureLoader.h"
+#include "GameManager.h"
+#include "TextureStreamer.h"
 
 #include "Core/SObject.h"
 #include "Core/Logger.h"
 
+#include "Render/IRenderContext.h"
+
 #include "External/stb/stb_image.h"
 #include "External/stb/stb_image_resize2.h"
 
@@ -82,12 +86,24 @@ namespace sh::game
 		texture->SetAnisoLevel(header.aniso);
 		texture->SetUUID(asset.GetAssetUUID());
 
-		std::size_t offset = 0;
-		for (uint32_t mip = 0; mip < texture->GetMipLevel(); ++mip)
+		// 스트리밍 중이면 밉 꼬리만 올리고 높은 해상도의 밉은 화면에 보이는 크기에 따라 TextureStreamer가 읽는다.
+		// 블록 압축을 지원하지 않는 장치에서는 Build에서 풀린 포맷으로 바뀌어 압축된 밉을 나중에 받을 수 없으므로 스트리밍하지 않는다.
+		TextureStreamer* const streamer = GameManager::GetInstance()->GetTextureStreamer();
+		const bool bCanStream = !render::IsCompressedTextureFormat(header.format) || context.IsTextureCompressionSupported();
+		const uint32_t tailMip = streamer != nullptr && bCanStream ? streamer->GetTailMip(header.width, header.height, texture->GetMipLevel()) : 0;
+		if (tailMip > 0 && texture->SetResidentMips(tailMip, TextureStreamer::ExtractMips(texAsset, tailMip, texture->GetMipLevel())))
+		{
+			streamer->Register(*texture, asset.GetAssetUUID());
+		}
+		else
 		{
-			std::size_t size = texture->GetPixelData(mip).size();
-			texture->SetPixelData(pixelData.pixelDataPtr + offset, size, mip);
-			offset += size;
+			std::size_t offset = 0;
+			for (uint32_t mip = 0; mip < texture->GetMipLevel(); ++mip)
+			{
+				std::size_t size = texture->GetPixelData(mip).size();
+				texture->SetPixelData(pixelData.pixelDataPtr + offset, size, mip);
+				offset += size;
+			}
 		}
 		texture->Build(context);
 
@@ -30,12 +30,17 @@ namespace sh::game
 		bConvertWorldType = bConvert;
 	}
 
+	SH_GAME_API void WorldAsset::SetWorldData(core::Json&& json)
+	{
+		worldData = std::move(json);
+	}
+
 	void WorldAsset::SetAssetData() const
 	{
-		if (!core::IsValid(worldPtr))
+		if (worldData.empty() && !core::IsValid(worldPtr))
 			return;
 
-		auto json = worldPtr->Serialize();
+		auto json = worldData.empty() ? worldPtr->Serialize() : worldData;
 		if (json.empty() || json.is_discarded())
 			return;
 
@@ -59,4 +64,8 @@ namespace sh::game
 	{
 		return std::move(worldData);
 	}
+	SH_GAME_API auto WorldAsset::GetDependencies() const -> std::vector<core::UUID>
+	{
+		return CollectUUIDs(worldData);
+	}
 }
@@ -0,0 +1,42 @@
+﻿#include "Asset/WorldCellAsset.h"
+
+namespace sh::game
+{
+	WorldCellAsset::WorldCellAsset() :
+		Asset(ASSET_NAME)
+	{
+	}
+	WorldCellAsset::WorldCellAsset(const core::UUID& uuid, const core::UUID& worldUUID, int32_t x, int32_t z, core::Json&& objsJson) :
+		Asset(ASSET_NAME)
+	{
+		assetUUID = uuid;
+		cellData["world"] = worldUUID.ToString();
+		cellData["x"] = x;
+		cellData["z"] = z;
+		cellData["objs"] = std::move(objsJson);
+	}
+	SH_GAME_API void WorldCellAsset::SetAsset(const core::SObject& obj)
+	{
+	}
+	SH_GAME_API auto WorldCellAsset::GetCellData() const -> const core::Json&
+	{
+		return cellData;
+	}
+	SH_GAME_API auto WorldCellAsset::ReleaseCellData() -> core::Json&&
+	{
+		return std::move(cellData);
+	}
+	SH_GAME_API void WorldCellAsset::SetAssetData() const
+	{
+		if (cellData.empty())
+			return;
+		data = core::Json::to_bson(cellData);
+	}
+	SH_GAME_API auto WorldCellAsset::ParseAssetData() -> bool
+	{
+		cellData = core::Json::from_bson(data, true, false);
+		if (cellData.is_discarded())
+			return false;
+		return cellData.contains("objs") && cellData["objs"].is_array();
+	}
+}//namespace
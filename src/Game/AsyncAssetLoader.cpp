@@ -0,0 +1,334 @@
+﻿#include "AsyncAssetLoader.h"
+#include "AssetLoaderFactory.h"
+
+#include "Core/Asset.h"
+#include "Core/SObject.h"
+#include "Core/SObjectManager.h"
+#include "Core/GarbageCollection.h"
+#include "Core/ThreadPool.h"
+#include "Core/Logger.h"
+
+#include <chrono>
+#include <algorithm>
+namespace sh::game
+{
+	namespace
+	{
+		/// @brief 에셋의 의존성 중 불러올 수 있는 것만 남긴다.
+		inline auto CollectDependencies(const core::Asset& asset, const AsyncAssetLoader::ContainsFn& contains) -> std::vector<core::UUID>
+		{
+			std::vector<core::UUID> deps = asset.GetDependencies();
+			if (contains != nullptr)
+				deps.erase(std::remove_if(deps.begin(), deps.end(), [&](const core::UUID& uuid) { return !contains(uuid); }), deps.end());
+			return deps;
+		}
+	}//namespace
+
+	SH_GAME_API auto AsyncAssetLoader::Handle::GetState() const -> State
+	{
+		return entry != nullptr ? entry->state : State::Failed;
+	}
+	SH_GAME_API auto AsyncAssetLoader::Handle::IsDone() const -> bool
+	{
+		const State state = GetState();
+		return state == State::Ready || state == State::Failed;
+	}
+	SH_GAME_API auto AsyncAssetLoader::Handle::GetUUID() const -> const core::UUID&
+	{
+		assert(entry != nullptr);
+		return entry->uuid;
+	}
+	SH_GAME_API auto AsyncAssetLoader::Handle::Get() const -> core::SObject*
+	{
+		if (entry == nullptr || entry->state != State::Ready)
+			return nullptr;
+		return entry->obj;
+	}
+
+	SH_GAME_API AsyncAssetLoader::AsyncAssetLoader(SourceFn source, ContainsFn contains) :
+		source(std::move(source)),
+		contains(std::move(contains)),
+		shared(std::make_shared<SharedState>())
+	{
+	}
+	SH_GAME_API AsyncAssetLoader::~AsyncAssetLoader()
+	{
+		// 진행 중인 작업은 shared만 참조하므로 결과는 버려진다.
+		shared->resultQueue.Clear();
+		waiting.clear();
+		pending.clear();
+		entries.clear();
+	}
+	SH_GAME_API auto AsyncAssetLoader::Load(const core::UUID& uuid) -> Handle
+	{
+		return Handle{ GetOrCreateEntry(uuid) };
+	}
+	SH_GAME_API void AsyncAssetLoader::Update()
+	{
+		ReceiveResults();
+
+		using Clock = std::chrono::steady_clock;
+		const auto deadline = Clock::now() + std::chrono::microseconds{ static_cast<int64_t>(settings.integrationBudgetMs * 1000.f) };
+
+		// 예산을 넘더라도 프레임당 최소 한 에셋은 진행해서 굶주림을 막는다.
+		bool bProgressed = false;
+		const auto hasBudgetFn = [&]() { return !bProgressed || Clock::now() < deadline; };
+
+		bool bIntegrated = true;
+		while (bIntegrated && hasBudgetFn())
+		{
+			bIntegrated = false;
+			// 통합 중 리졸버를 거쳐 waiting에 엔트리가 추가될 수 있으므로 인덱스로 순회한다.
+			for (std::size_t i = 0; i < waiting.size() && hasBudgetFn(); ++i)
+			{
+				std::shared_ptr<Entry> entry = waiting[i];
+				if (entry->state != State::Waiting || !IsIntegrable(*entry))
+					continue;
+				Integrate(*entry);
+				bProgressed = bIntegrated = true;
+			}
+			waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+				[](const std::shared_ptr<Entry>& entry) { return entry->state != State::Waiting; }), waiting.end());
+
+			// 더 받을 결과가 없는데 통합할 수 있는 것이 없다면 순환 참조다. 먼저 도착한 것부터 통합하고 나머지는 리졸버가 채운다.
+			if (!bIntegrated && !waiting.empty() && loadingCount == 0 && hasBudgetFn())
+			{
+				std::shared_ptr<Entry> entry = waiting.front();
+				waiting.erase(waiting.begin());
+				Integrate(*entry);
+				bProgressed = bIntegrated = true;
+			}
+		}
+		ReleaseUnused();
+	}
+	SH_GAME_API void AsyncAssetLoader::Wait(const Handle& handle)
+	{
+		if (!handle.IsValid())
+			return;
+		ReceiveResults();
+		Finish(*handle.entry);
+	}
+	SH_GAME_API auto AsyncAssetLoader::Resolve(const core::UUID& uuid) -> core::SObject*
+	{
+		auto it = entries.find(uuid);
+		if (it == entries.end())
+		{
+			if (contains != nullptr && !contains(uuid))
+				return nullptr;
+			// 요청된 적 없는 에셋은 지금 스레드에서 읽는다. 의존하는 에셋들은 그 동안 워커 스레드에서 읽힌다.
+			auto entry = std::make_shared<Entry>(uuid);
+			entry->bDispatched = true;
+			entries.insert({ uuid, entry });
+
+			std::unique_ptr<core::Asset> asset = source(uuid);
+			std::vector<core::UUID> deps;
+			if (asset != nullptr)
+				deps = CollectDependencies(*asset, contains);
+			ApplyResult(entry, std::move(asset), deps);
+			Finish(*entry);
+			return entry->state == State::Ready ? entry->obj : nullptr;
+		}
+
+		std::shared_ptr<Entry> entry = it->second;
+		if (entry->bVisiting)
+		{
+			// 이 에셋의 의존성을 통합하다가 다시 이 에셋이 필요해졌다(순환 참조). 기존 동기 로드처럼 지금 만든다.
+			if (entry->state == State::Waiting)
+				Integrate(*entry);
+		}
+		else
+			Finish(*entry);
+		return entry->state == State::Ready ? entry->obj : nullptr;
+	}
+	SH_GAME_API auto AsyncAssetLoader::GetPendingCount() const -> std::size_t
+	{
+		return std::count_if(entries.begin(), entries.end(),
+			[](const auto& pair) { return pair.second->state != State::Ready && pair.second->state != State::Failed; });
+	}
+	SH_GAME_API void AsyncAssetLoader::PushReferenceObjects(core::GarbageCollection& gc)
+	{
+		for (auto& [uuid, entry] : entries)
+			gc.PushReferenceObject(entry->obj);
+	}
+
+	auto AsyncAssetLoader::GetOrCreateEntry(const core::UUID& uuid) -> std::shared_ptr<Entry>
+	{
+		auto it = entries.find(uuid);
+		if (it != entries.end())
+			return it->second;
+
+		auto entry = std::make_shared<Entry>(uuid);
+		entries.insert({ uuid, entry });
+
+		core::SObject* obj = core::SObjectManager::GetInstance()->GetSObject(uuid);
+		if (core::IsValid(obj))
+		{
+			entry->obj = obj;
+			entry->state = State::Ready;
+			return entry;
+		}
+		pending.push_back(entry);
+		DispatchPending();
+		return entry;
+	}
+	void AsyncAssetLoader::Dispatch(Entry& entry)
+	{
+		if (source == nullptr)
+		{
+			SH_ERROR("AsyncAssetLoader: source is not set!");
+			entry.bDispatched = true;
+			entry.state = State::Failed;
+			return;
+		}
+		entry.bDispatched = true;
+		++loadingCount;
+
+		// 파일 읽기, 압축 해제, 파싱, 의존성 수집은 워커 스레드에서 수행
+		core::ThreadPool::GetInstance()->AddContinousTask(
+			[shared = shared, source = source, contains = contains, uuid = entry.uuid]()
+			{
+				LoadResult result{ uuid, source(uuid), {} };
+				if (result.asset != nullptr)
+					result.deps = CollectDependencies(*result.asset, contains);
+				else
+					SH_ERROR_FORMAT("AsyncAssetLoader: failed to load asset({})", uuid.ToString());
+
+				shared->resultQueue.Push(std::move(result));
+				{
+					std::lock_guard<std::mutex> lock{ shared->mu };
+					shared->completed.fetch_add(1, std::memory_order_release);
+				}
+				shared->cv.notify_all();
+			}
+		);
+	}
+	void AsyncAssetLoader::DispatchPending()
+	{
+		while (loadingCount < settings.maxConcurrentLoads && !pending.empty())
+		{
+			std::shared_ptr<Entry> entry = std::move(pending.front());
+			pending.pop_front();
+			if (!entry->bDispatched)
+				Dispatch(*entry);
+		}
+	}
+	void AsyncAssetLoader::ReceiveResults()
+	{
+		shared->resultQueue.Drain(
+			[this](LoadResult& result)
+			{
+				--loadingCount;
+				auto it = entries.find(result.uuid);
+				if (it == entries.end())
+					return;
+				ApplyResult(it->second, std::move(result.asset), result.deps);
+			}
+		);
+		DispatchPending();
+	}
+	void AsyncAssetLoader::ApplyResult(const std::shared_ptr<Entry>& entryPtr, std::unique_ptr<core::Asset>&& asset, const std::vector<core::UUID>& deps)
+	{
+		// GetOrCreateEntry()가 entries를 바꾸므로 엔트리는 복사해서 쥔다.
+		std::shared_ptr<Entry> entry = entryPtr;
+		if (asset == nullptr)
+		{
+			entry->state = State::Failed;
+			return;
+		}
+		entry->asset = std::move(asset);
+		entry->deps.reserve(deps.size());
+		for (const core::UUID& dep : deps)
+			entry->deps.push_back(GetOrCreateEntry(dep));
+		entry->state = State::Waiting;
+		waiting.push_back(std::move(entry));
+	}
+	void AsyncAssetLoader::WaitForResult(Entry& entry)
+	{
+		if (entry.state != State::Loading)
+			return;
+		if (!entry.bDispatched)
+			Dispatch(entry); // 기다리는 에셋은 동시 로드 수 제한을 받지 않는다.
+
+		while (entry.state == State::Loading)
+		{
+			const uint64_t seen = shared->completed.load(std::memory_order_acquire);
+			ReceiveResults();
+			if (entry.state != State::Loading)
+				break;
+			std::unique_lock<std::mutex> lock{ shared->mu };
+			shared->cv.wait(lock, [&]() { return shared->completed.load(std::memory_order_acquire) != seen; });
+		}
+	}
+	void AsyncAssetLoader::Finish(Entry& entry)
+	{
+		if (entry.bVisiting)
+			return;
+		WaitForResult(entry);
+		if (entry.state != State::Waiting)
+			return;
+
+		entry.bVisiting = true;
+		for (std::size_t i = 0; i < entry.deps.size(); ++i)
+		{
+			std::shared_ptr<Entry> dep = entry.deps[i];
+			Finish(*dep);
+		}
+		entry.bVisiting = false;
+
+		if (entry.state == State::Waiting)
+			Integrate(entry);
+	}
+	void AsyncAssetLoader::Integrate(Entry& entry)
+	{
+		static AssetLoaderFactory& factory = *AssetLoaderFactory::GetInstance();
+
+		entry.state = State::Integrating;
+		core::IAssetLoader* loader = factory.GetLoader(entry.asset->GetType());
+		// SObject 생성, 역직렬화, Build(context)는 게임 스레드에서만 할 수 있다.
+		core::SObject* obj = loader != nullptr ? loader->Load(*entry.asset) : nullptr;
+		entry.asset.reset();
+
+		if (core::IsValid(obj))
+		{
+			entry.obj = obj;
+			entry.state = State::Ready;
+		}
+		else
+		{
+			SH_ERROR_FORMAT("AsyncAssetLoader: failed to integrate asset({})", entry.uuid.ToString());
+			entry.state = State::Failed;
+		}
+		// 통합된 오브젝트가 의존하는 오브젝트를 직접 참조하므로 더 붙잡을 필요가 없다. 순환 의존이면 서로를 붙잡아 해제되지 않는다.
+		entry.deps.clear();
+		entry.deps.shrink_to_fit();
+	}
+	auto AsyncAssetLoader::IsIntegrable(const Entry& entry) const -> bool
+	{
+		for (const auto& dep : entry.deps)
+		{
+			if (dep->state != State::Ready && dep->state != State::Failed)
+				return false;
+		}
+		return true;
+	}
+	void AsyncAssetLoader::ReleaseUnused()
+	{
+		// 엔트리가 지워지면 그 엔트리의 의존성들도 풀려날 수 있으므로 더 지울 것이 없을 때 까지 반복한다.
+		bool bReleased = true;
+		while (bReleased)
+		{
+			bReleased = false;
+			for (auto it = entries.begin(); it != entries.end();)
+			{
+				const Entry& entry = *it->second;
+				if ((entry.state == State::Ready || entry.state == State::Failed) && it->second.use_count() == 1)
+				{
+					it = entries.erase(it);
+					bReleased = true;
+				}
+				else
+					++it;
+			}
+		}
+	}
+}//namespace
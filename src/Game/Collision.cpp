@@ -1,38 +1,68 @@
 ﻿#include "Collision.h"
 #include "Component/Phys/Collider.h"
 
+#include <cassert>
 namespace sh::game
 {
-	Collision::Collision(const std::array<phys::ContactPoint, ARRAY_SIZE>& contactPoints)
+	Collision::Collision(const phys::ContactBuffer& buffer, uint32_t pairIdx) :
+		buffer(&buffer),
+		generation(buffer.GetGeneration())
 	{
-		contacts = contactPoints;
-	}
-	Collision::Collision(std::vector<phys::ContactPoint>&& contactPoints)
-	{
-		contacts = std::move(contactPoints);
+		contactBegin = buffer.GetContactBegins()[pairIdx];
+		contactCount = buffer.GetContactCounts()[pairIdx];
 	}
 	Collision::Collision(Collision&& other) noexcept :
 		collider(other.collider),
 		contactCount(other.contactCount),
-		contacts(std::move(other.contacts))
+		buffer(other.buffer),
+		contactBegin(other.contactBegin),
+		generation(other.generation)
 	{
 	}
 	SH_GAME_API auto Collision::operator=(Collision&& other) noexcept -> Collision&
 	{
 		collider = other.collider;
 		contactCount = other.contactCount;
-		contacts = std::move(other.contacts);
+		buffer = other.buffer;
+		contactBegin = other.contactBegin;
+		generation = other.generation;
 		return *this;
 	}
 	SH_GAME_API void Collision::PushReferenceObjects(core::GarbageCollection& gc)
 	{
 		gc.PushReferenceObject(collider);
 	}
-	SH_GAME_API auto Collision::GetContactPoint(uint32_t idx) const -> const phys::ContactPoint&
+	SH_GAME_API auto Collision::IsContactValid() const -> bool
+	{
+		return buffer != nullptr && buffer->GetGeneration() == generation;
+	}
+	SH_GAME_API auto Collision::GetContactPoint(uint32_t idx) const -> phys::ContactPoint
+	{
+		assert(IsContactValid() && idx < contactCount);
+		return buffer->GetContactPoint(contactBegin + idx);
+	}
+	SH_GAME_API auto Collision::GetWorldNormals() const -> core::ArrayView<const glm::vec3>
+	{
+		if (!IsContactValid())
+			return { nullptr, 0 };
+		return buffer->GetWorldNormals(contactBegin, contactCount);
+	}
+	SH_GAME_API auto Collision::GetLocalPointsOnCollider1() const -> core::ArrayView<const glm::vec3>
+	{
+		if (!IsContactValid())
+			return { nullptr, 0 };
+		return buffer->GetLocalPointsOnCollider1(contactBegin, contactCount);
+	}
+	SH_GAME_API auto Collision::GetLocalPointsOnCollider2() const -> core::ArrayView<const glm::vec3>
+	{
+		if (!IsContactValid())
+			return { nullptr, 0 };
+		return buffer->GetLocalPointsOnCollider2(contactBegin, contactCount);
+	}
+	SH_GAME_API auto Collision::GetPenetrationDepths() const -> core::ArrayView<const float>
 	{
-		if (contacts.index() == 0)
-			return std::get<0>(contacts)[idx];
-		else
-			return std::get<1>(contacts)[idx];
+		if (!IsContactValid())
+			return { nullptr, 0 };
+		return buffer->GetPenetrationDepths(contactBegin, contactCount);
 	}
 }//namespace
\ No newline at end of file
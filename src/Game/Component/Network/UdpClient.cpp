@@ -10,29 +10,35 @@ namespace sh::game
 {
 	SH_GAME_API UdpClient::UdpClient(GameObject& owner) :
 		NetworkComponent(owner),
-		socket(ctx)
+		socket(network::NetworkService::GetInstance()->GetContext())
 	{
 	}
 	SH_GAME_API void UdpClient::OnDestroy()
 	{
 		socket.Close();
-		if (networkThread.joinable())
-			networkThread.join();
+		socket.SetReceiveCallback(nullptr);
+		network::NetworkService::GetInstance()->UnregisterReceiver(receiverId);
+		receiverId = network::NetworkService::INVALID_RECEIVER;
 
 		Super::OnDestroy();
 	}
 	SH_GAME_API void UdpClient::Start()
 	{
-		socket.Bind();
-		networkThread = std::thread(
-			[this]()
+		auto service = network::NetworkService::GetInstance();
+		service->Start();
+		receiverId = service->RegisterReceiver(
+			[this](std::vector<network::NetworkContext::Message>& messages)
 			{
-				while (socket.IsOpen())
-				{
-					ctx.Update();
-				}
+				OnReceived(messages);
 			}
 		);
+		socket.SetReceiveCallback(
+			[id = receiverId](std::vector<network::NetworkContext::Message>&& messages)
+			{
+				network::NetworkService::GetInstance()->Post(id, std::move(messages));
+			}
+		);
+		socket.Bind();
 	}
 	SH_GAME_API void UdpClient::Update()
 	{
@@ -42,17 +48,13 @@ namespace sh::game
 			packet.SetString("hello?");
 			socket.Send(packet, serverIp, serverPort);
 		}
-
-		if (socket.IsOpen())
+	}
+	SH_GAME_API void UdpClient::OnReceived(std::vector<network::NetworkContext::Message>& messages)
+	{
+		for (auto& message : messages)
 		{
-			auto opt = socket.GetReceivedMessage();
-			while (opt.has_value())
-			{
-				auto& message = opt.value();
-				if (message.packet->GetId() == 0)
-					SH_INFO_FORMAT("Received packet (id:0, {}) from server!", static_cast<network::StringPacket*>(message.packet.get())->GetString());
-				opt = socket.GetReceivedMessage();
-			}
+			if (message.packet->GetId() == 0)
+				SH_INFO_FORMAT("Received packet (id:0, {}) from server!", static_cast<network::StringPacket*>(message.packet.get())->GetString());
 		}
 	}
 	SH_GAME_API void UdpClient::SendPacket(const network::Packet& packet)
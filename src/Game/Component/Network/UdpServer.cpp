@@ -7,9 +7,8 @@ namespace sh::game
 {
 	UdpServer::UdpServer(GameObject& owner) :
 		NetworkComponent(owner),
-		socket(ctx)
+		socket(network::NetworkService::GetInstance()->GetContext())
 	{
-
 	}
 	SH_GAME_API void UdpServer::Send(const network::Packet& packet, const std::string& ip, uint16_t port)
 	{
@@ -18,41 +17,46 @@ namespace sh::game
 	SH_GAME_API void UdpServer::OnDestroy()
 	{
 		socket.Close();
-		if (networkThread.joinable())
-			networkThread.join();
+		socket.SetReceiveCallback(nullptr);
+		network::NetworkService::GetInstance()->UnregisterReceiver(receiverId);
+		receiverId = network::NetworkService::INVALID_RECEIVER;
 		Super::OnDestroy();
 	}
 	SH_GAME_API void UdpServer::Start()
 	{
-		socket.Bind(port);
-		networkThread = std::thread(
-			[this]()
+		auto service = network::NetworkService::GetInstance();
+		service->Start();
+		receiverId = service->RegisterReceiver(
+			[this](std::vector<network::NetworkContext::Message>& messages)
+			{
+				OnReceived(messages);
+			}
+		);
+		socket.SetReceiveCallback(
+			[id = receiverId](std::vector<network::NetworkContext::Message>&& messages)
 			{
-				while (socket.IsOpen())
-				{
-					ctx.Update();
-				}
+				network::NetworkService::GetInstance()->Post(id, std::move(messages));
 			}
 		);
+		socket.Bind(port);
 	}
 	SH_GAME_API void UdpServer::Update()
 	{
 		if (socket.IsOpen())
+			socket.Flush();
+	}
+	SH_GAME_API void UdpServer::OnReceived(std::vector<network::NetworkContext::Message>& messages)
+	{
+		for (auto& message : messages)
 		{
-			auto opt = socket.GetReceivedMessage();
-			while (opt.has_value())
+			if (message.packet->GetId() == 0)
 			{
-				auto& message = opt.value();
-				if (message.packet->GetId() == 0)
-				{
-					std::string str = static_cast<network::StringPacket*>(message.packet.get())->GetString();
-					SH_INFO_FORMAT("Received packet (id: 0, {}) from {}", str, message.senderIp);
+				std::string str = static_cast<network::StringPacket*>(message.packet.get())->GetString();
+				SH_INFO_FORMAT("Received packet (id: 0, {}) from {}", str, message.sender.GetIp());
 
-					network::StringPacket packet{};
-					packet.SetString(std::move(str));
-					socket.Send(packet, message.senderIp, message.senderPort);
-				}
-				opt = socket.GetReceivedMessage();
+				network::StringPacket packet{};
+				packet.SetString(std::move(str));
+				socket.Enqueue(packet, message.sender);
 			}
 		}
 	}
@@ -18,6 +18,8 @@ namespace sh::game
 				rigidBody = nullptr;
 				nativeColliderMap.erase(nativeCollider);
 				nativeCollider = nullptr;
+				gameObject.world.GetPhysWorld().UnregisterCollider(physIdx);
+				physIdx = phys::ContactBuffer::INVALID_INDEX;
 
 				if (core::IsValid(this))
 					Setup();
@@ -154,6 +156,7 @@ namespace sh::game
 		}
 		nativeCollider = rbHandle->addCollider(shape, transform);
 		nativeColliderMap.insert({ nativeCollider, this });
+		physIdx = gameObject.world.GetPhysWorld().RegisterCollider(nativeCollider, this);
 		reinterpret_cast<reactphysics3d::Collider*>(nativeCollider)->getMaterial().setBounciness(bouncy);
 	}
 	void Collider::RemoveCollider()
@@ -164,6 +167,8 @@ namespace sh::game
 			rbHandle->removeCollider(reinterpret_cast<reactphysics3d::Collider*>(nativeCollider));
 			nativeColliderMap.erase(nativeCollider);
 			nativeCollider = nullptr;
+			gameObject.world.GetPhysWorld().UnregisterCollider(physIdx);
+			physIdx = phys::ContactBuffer::INVALID_INDEX;
 		}
 	}
 	void Collider::Setup()
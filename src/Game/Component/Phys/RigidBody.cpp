@@ -13,6 +13,14 @@ namespace sh::game
 {
 	std::unordered_map<RigidBody::RigidBodyHandle, RigidBody*> RigidBody::nativeMap{};
 
+	/// @brief 스텝이 진행 중이면 마지막 스텝의 스냅샷을, 아니면 nullptr을 반환한다.
+	static auto GetSnapshotState(const phys::PhysWorld& physWorld, RigidBody::RigidBodyHandle handle) -> const phys::PhysWorld::BodyState*
+	{
+		if (!physWorld.IsStepping())
+			return nullptr;
+		return physWorld.GetBodyState(handle);
+	}
+
 	struct RigidBody::Impl
 	{
 		reactphysics3d::RigidBody* rigidbody = nullptr;
@@ -37,6 +45,7 @@ namespace sh::game
 		impl->rigidbody->setIsActive(false);
 
 		nativeMap.insert({ impl->rigidbody, this });
+		physIdx = gameObject.world.GetPhysWorld().RegisterBody(impl->rigidbody, this);
 
 		lastState.torque = { 0.f, 0.f, 0.f };
 		lastState.vel = { 0.f, 0.f, 0.f };
@@ -48,6 +57,7 @@ namespace sh::game
 	}
 	SH_GAME_API void RigidBody::Start()
 	{
+		gameObject.world.GetPhysWorld().WaitForStep();
 		impl->rigidbody->setIsActive(true);
 
 		ResetPhysicsTransform();
@@ -60,6 +70,7 @@ namespace sh::game
 	}
 	SH_GAME_API void RigidBody::OnEnable()
 	{
+		gameObject.world.GetPhysWorld().WaitForStep();
 		impl->rigidbody->setIsActive(true);
 		impl->rigidbody->setIsSleeping(false);
 		impl->rigidbody->applyWorldTorque({ lastState.torque.x, lastState.torque.y, lastState.torque.z });
@@ -68,6 +79,7 @@ namespace sh::game
 	}
 	SH_GAME_API void RigidBody::OnDisable()
 	{
+		gameObject.world.GetPhysWorld().WaitForStep();
 		impl->rigidbody->setIsActive(false);
 		const auto& torque = impl->rigidbody->getTorque();
 		const auto vel = impl->rigidbody->getLinearVelocity();
@@ -79,7 +91,10 @@ namespace sh::game
 	SH_GAME_API void RigidBody::OnDestroy()
 	{
 		nativeMap.erase(impl->rigidbody);
+		gameObject.world.GetPhysWorld().UnregisterBody(physIdx);
 
+		// 이 강체를 대상으로 밀려 있는 쓰기가 파괴된 핸들에 적용되지 않도록 먼저 반영한다.
+		gameObject.world.GetPhysWorld().WaitForStep();
 		auto physWorld = reinterpret_cast<reactphysics3d::PhysicsWorld*>(gameObject.world.GetPhysWorld().GetNative());
 		physWorld->destroyRigidBody(impl->rigidbody);
 		impl->rigidbody = nullptr;
@@ -127,10 +142,8 @@ namespace sh::game
 		if (bSet)
 			bKinematic = false;
 
-		if (bStatic)
-			impl->rigidbody->setType(reactphysics3d::BodyType::STATIC);
-		else
-			impl->rigidbody->setType(reactphysics3d::BodyType::DYNAMIC);
+		const auto type = bStatic ? reactphysics3d::BodyType::STATIC : reactphysics3d::BodyType::DYNAMIC;
+		PhysWrite([type](reactphysics3d::RigidBody* body) { body->setType(type); });
 	}
 	SH_GAME_API void RigidBody::SetKinematic(bool bSet)
 	{
@@ -138,63 +151,61 @@ namespace sh::game
 		if (bSet)
 			bStatic = false;
 
-		if (bKinematic)
-			impl->rigidbody->setType(reactphysics3d::BodyType::KINEMATIC);
-		else
-			impl->rigidbody->setType(reactphysics3d::BodyType::DYNAMIC);
+		const auto type = bKinematic ? reactphysics3d::BodyType::KINEMATIC : reactphysics3d::BodyType::DYNAMIC;
+		PhysWrite([type](reactphysics3d::RigidBody* body) { body->setType(type); });
 	}
 	SH_GAME_API void RigidBody::SetUsingGravity(bool use)
 	{
 		bGravity = use;
-		impl->rigidbody->enableGravity(bGravity);
+		PhysWrite([use](reactphysics3d::RigidBody* body) { body->enableGravity(use); });
 	}
 
 	SH_GAME_API void RigidBody::SetMass(float mass)
 	{
 		this->mass = mass;
-		impl->rigidbody->setMass(mass);
+		PhysWrite([mass](reactphysics3d::RigidBody* body) { body->setMass(mass); });
 	}
 
 	SH_GAME_API void RigidBody::SetLinearVelocity(const game::Vec3& v)
 	{
-		impl->rigidbody->setLinearVelocity({ v.x, v.y, v.z });
+		PhysWrite([v](reactphysics3d::RigidBody* body) { body->setLinearVelocity({ v.x, v.y, v.z }); });
 	}
 
 	SH_GAME_API void RigidBody::SetAngularVelocity(const game::Vec3& v)
 	{
-		impl->rigidbody->setAngularVelocity({ v.x, v.y, v.z });
+		PhysWrite([v](reactphysics3d::RigidBody* body) { body->setAngularVelocity({ v.x, v.y, v.z }); });
 	}
 
 	SH_GAME_API void RigidBody::SetLinearDamping(float damping)
 	{
 		linearDamping = damping;
-		impl->rigidbody->setLinearDamping(damping);
+		PhysWrite([damping](reactphysics3d::RigidBody* body) { body->setLinearDamping(damping); });
 	}
 
 	SH_GAME_API void RigidBody::SetAngularDamping(float damping)
 	{
 		angularDamping = damping;
-		impl->rigidbody->setAngularDamping(damping);
+		PhysWrite([damping](reactphysics3d::RigidBody* body) { body->setAngularDamping(damping); });
 	}
 
 	SH_GAME_API void RigidBody::AddWorldTorque(const game::Vec3& torque)
 	{
-		impl->rigidbody->applyWorldTorque({ torque.x, torque.y, torque.z });
+		PhysWrite([torque](reactphysics3d::RigidBody* body) { body->applyWorldTorque({ torque.x, torque.y, torque.z }); });
 	}
 
 	SH_GAME_API void RigidBody::AddWorldForce(const game::Vec3& force)
 	{
-		impl->rigidbody->applyWorldForceAtCenterOfMass({ force.x, force.y, force.z });
+		PhysWrite([force](reactphysics3d::RigidBody* body) { body->applyWorldForceAtCenterOfMass({ force.x, force.y, force.z }); });
 	}
 
 	SH_GAME_API void RigidBody::AddTorque(const game::Vec3& torque)
 	{
-		impl->rigidbody->applyLocalTorque({ torque.x, torque.y, torque.z });
+		PhysWrite([torque](reactphysics3d::RigidBody* body) { body->applyLocalTorque({ torque.x, torque.y, torque.z }); });
 	}
 
 	SH_GAME_API void RigidBody::AddForce(const game::Vec3& force)
 	{
-		impl->rigidbody->applyLocalForceAtCenterOfMass({ force.x, force.y, force.z });
+		PhysWrite([force](reactphysics3d::RigidBody* body) { body->applyLocalForceAtCenterOfMass({ force.x, force.y, force.z }); });
 	}
 
 	SH_GAME_API void RigidBody::SetAngularLock(const game::Vec3& dir)
@@ -205,7 +216,8 @@ namespace sh::game
 		angularLock.z = std::clamp(std::roundf(angularLock.z), 0.f, 1.f);
 
 		// reactPhysics에선 0이 허용, 1이 잠금이기 때문에 반전 시켜야함.
-		impl->rigidbody->setAngularLockAxisFactor({ 1.0f - angularLock.x , 1.0f - angularLock.y, 1.0f - angularLock.z });
+		const reactphysics3d::Vector3 factor{ 1.0f - angularLock.x , 1.0f - angularLock.y, 1.0f - angularLock.z };
+		PhysWrite([factor](reactphysics3d::RigidBody* body) { body->setAngularLockAxisFactor(factor); });
 	}
 	SH_GAME_API void RigidBody::SetAxisLock(const game::Vec3& dir)
 	{
@@ -215,11 +227,12 @@ namespace sh::game
 		axisLock.z = std::clamp(std::roundf(axisLock.z), 0.f, 1.f);
 
 		// reactPhysics에선 0이 허용, 1이 잠금이기 때문에 반전 시켜야함.
-		impl->rigidbody->setLinearLockAxisFactor({ 1.0f - axisLock.x, 1.0f - axisLock.y, 1.0f - axisLock.z });
+		const reactphysics3d::Vector3 factor{ 1.0f - axisLock.x, 1.0f - axisLock.y, 1.0f - axisLock.z };
+		PhysWrite([factor](reactphysics3d::RigidBody* body) { body->setLinearLockAxisFactor(factor); });
 	}
 	SH_GAME_API void RigidBody::SetSleep()
 	{
-		impl->rigidbody->setIsSleeping(true);
+		PhysWrite([](reactphysics3d::RigidBody* body) { body->setIsSleeping(true); });
 	}
 	SH_GAME_API void RigidBody::SetInterpolation(bool bUse)
 	{
@@ -235,21 +248,28 @@ namespace sh::game
 	}
 	SH_GAME_API auto RigidBody::GetLinearVelocity() const -> game::Vec3
 	{
+		if (const auto state = GetSnapshotState(gameObject.world.GetPhysWorld(), impl->rigidbody); state != nullptr)
+			return game::Vec3{ state->linearVelocity };
 		auto v = impl->rigidbody->getLinearVelocity();
 		return game::Vec3{ v.x, v.y, v.z };
 	}
 	SH_GAME_API auto RigidBody::GetAngularVelocity() const -> game::Vec3
 	{
+		if (const auto state = GetSnapshotState(gameObject.world.GetPhysWorld(), impl->rigidbody); state != nullptr)
+			return game::Vec3{ state->angularVelocity };
 		auto v = impl->rigidbody->getAngularVelocity();
 		return game::Vec3{ v.x, v.y, v.z };
 	}
 	SH_GAME_API auto RigidBody::GetForce() const -> game::Vec3
 	{
+		gameObject.world.GetPhysWorld().WaitForStep();
 		const auto& f = impl->rigidbody->getForce();
 		return game::Vec3{ f.x, f.y, f.z };
 	}
 	SH_GAME_API auto RigidBody::GetNativeHandle() const -> RigidBodyHandle
 	{
+		// 핸들로 직접 물리 세계를 건드릴 수 있으므로 진행 중인 스텝을 기다린다.
+		gameObject.world.GetPhysWorld().WaitForStep();
 		return impl->rigidbody;
 	}
 	SH_GAME_API void RigidBody::ResetPhysicsTransform()
@@ -260,12 +280,11 @@ namespace sh::game
 		const glm::quat& worldQuat = gameObject.transform->GetWorldQuat();
 
 		// rb 월드 트랜스폼 리셋
-		impl->rigidbody->setTransform(
-			reactphysics3d::Transform{
-				reactphysics3d::Vector3{ worldPos.x, worldPos.y, worldPos.z },
-				reactphysics3d::Quaternion{ worldQuat.x, worldQuat.y, worldQuat.z, worldQuat.w }
-			}
-		);
+		const reactphysics3d::Transform transform{
+			reactphysics3d::Vector3{ worldPos.x, worldPos.y, worldPos.z },
+			reactphysics3d::Quaternion{ worldQuat.x, worldQuat.y, worldQuat.z, worldQuat.w }
+		};
+		PhysWrite([transform](reactphysics3d::RigidBody* body) { body->setTransform(transform); });
 
 		ResetInterpolationState();
 	}
@@ -274,13 +293,19 @@ namespace sh::game
 		const Vec3& objPos = gameObject.transform->GetWorldPosition();
 		const auto& objQuat = gameObject.transform->GetWorldQuat();
 
-		prevPos = objPos;
-		prevRot = objQuat;
-		currPos = objPos;
-		currRot = objQuat;
+		ResetInterpolationState(objPos, objQuat);
+	}
+	SH_GAME_API void RigidBody::ResetInterpolationState(const glm::vec3& pos, const glm::quat& rot)
+	{
+		prevPos = pos;
+		prevRot = rot;
+		currPos = pos;
+		currRot = rot;
 	}
 	SH_GAME_API auto RigidBody::GetPhysicsPosition() const -> game::Vec3
 	{
+		if (const auto state = GetSnapshotState(gameObject.world.GetPhysWorld(), impl->rigidbody); state != nullptr)
+			return game::Vec3{ state->position };
 		const auto& p = impl->rigidbody->getTransform().getPosition();
 		return { p.x, p.y, p.z };
 	}
@@ -300,6 +325,17 @@ namespace sh::game
 		return it->second;
 	}
 
+	template<typename F>
+	void RigidBody::PhysWrite(F&& fn)
+	{
+		gameObject.world.GetPhysWorld().Write(
+			[body = impl->rigidbody, fn = std::forward<F>(fn)]()
+			{
+				fn(body);
+			}
+		);
+	}
+
 	void RigidBody::Interpolate()
 	{
 		// 바뀌지 않았으니 보간x
@@ -308,7 +344,7 @@ namespace sh::game
 
 		if (!bKinematic && bInterpolation)
 		{
-			double alpha = std::clamp(gameObject.world.GetFixedAccumulator() / gameObject.world.FIXED_TIME, 0.0, 1.0);
+			double alpha = std::clamp(gameObject.world.GetFixedAccumulator() / gameObject.world.GetFixedDeltaTime(), 0.0, 1.0);
 			glm::vec3 interpPos = glm::mix(prevPos, currPos, alpha);
 			glm::quat interpRot = glm::slerp(prevRot, currRot, static_cast<float>(alpha));
 			interpRot = glm::normalize(interpRot);
@@ -0,0 +1,250 @@
+﻿#include "Component/Render/Animator.h"
+
+#include "World.h"
+#include "SkinningSystem.h"
+
+#include <algorithm>
+#include <cmath>
+namespace sh::game
+{
+	Animator::Animator(GameObject& owner) :
+		Component(owner)
+	{
+	}
+	Animator::~Animator() = default;
+
+	SH_GAME_API void Animator::Awake()
+	{
+		Super::Awake();
+		bDirty = true;
+	}
+	SH_GAME_API void Animator::Update()
+	{
+		// 실제 평가는 LateUpdate 이후 다른 Animator들과 함께 이뤄진다.
+		world.GetSkinningSystem().Submit(*this);
+	}
+	SH_GAME_API void Animator::OnPropertyChanged(const core::reflection::Property& prop)
+	{
+		Super::OnPropertyChanged(prop);
+		if (prop.GetName() == core::Util::ConstexprHash("model") ||
+			prop.GetName() == core::Util::ConstexprHash("skeletonIdx") ||
+			prop.GetName() == core::Util::ConstexprHash("clips"))
+			bDirty = true;
+	}
+	SH_GAME_API auto Animator::Serialize() const -> core::Json
+	{
+		core::Json mainJson = Super::Serialize();
+		core::Json layersJson = core::Json::array();
+		for (const Layer& layer : layers)
+		{
+			core::Json layerJson;
+			layerJson["name"] = layer.name;
+			layerJson["parameter"] = layer.parameter;
+			layerJson["weight"] = layer.weight;
+			layerJson["maskRoot"] = layer.maskRoot;
+			layerJson["loop"] = layer.bLoop;
+			layerJson["motions"] = core::Json::array();
+			for (const Motion& motion : layer.motions)
+				layerJson["motions"].push_back({ motion.clipIdx, motion.threshold, motion.speed });
+			layersJson.push_back(std::move(layerJson));
+		}
+		mainJson["Animator"]["layers"] = std::move(layersJson);
+		return mainJson;
+	}
+	SH_GAME_API void Animator::Deserialize(const core::Json& json)
+	{
+		Super::Deserialize(json);
+		if (!json.contains("Animator") || !json["Animator"].contains("layers"))
+			return;
+
+		std::vector<Layer> loaded;
+		for (const core::Json& layerJson : json["Animator"]["layers"])
+		{
+			Layer& layer = loaded.emplace_back();
+			layer.name = layerJson.value("name", std::string{});
+			layer.parameter = layerJson.value("parameter", 0.f);
+			layer.weight = layerJson.value("weight", 1.f);
+			layer.maskRoot = layerJson.value("maskRoot", std::string{});
+			layer.bLoop = layerJson.value("loop", true);
+			if (!layerJson.contains("motions"))
+				continue;
+			for (const core::Json& motionJson : layerJson["motions"])
+			{
+				if (!motionJson.is_array() || motionJson.size() != 3)
+					continue;
+				layer.motions.push_back(Motion{ motionJson[0].get<int>(), motionJson[1].get<float>(), motionJson[2].get<float>() });
+			}
+		}
+		SetLayers(std::move(loaded));
+	}
+
+	SH_GAME_API void Animator::SetModel(render::Model* model, int skeletonIdx)
+	{
+		this->model = model;
+		this->skeletonIdx = skeletonIdx;
+		bDirty = true;
+	}
+	SH_GAME_API void Animator::SetClips(std::vector<render::AnimationClip*> clips)
+	{
+		this->clips = std::move(clips);
+		bDirty = true;
+	}
+	SH_GAME_API void Animator::SetLayers(std::vector<Layer> layers)
+	{
+		this->layers = std::move(layers);
+		for (Layer& layer : this->layers)
+		{
+			std::stable_sort(layer.motions.begin(), layer.motions.end(),
+				[](const Motion& a, const Motion& b) { return a.threshold < b.threshold; });
+		}
+		layerTimes.assign(this->layers.size(), 0.f);
+		bDirty = true;
+	}
+	SH_GAME_API void Animator::SetParameter(std::size_t layerIdx, float value)
+	{
+		if (layerIdx < layers.size())
+			layers[layerIdx].parameter = value;
+	}
+	SH_GAME_API void Animator::SetLayerWeight(std::size_t layerIdx, float weight)
+	{
+		if (layerIdx < layers.size())
+			layers[layerIdx].weight = weight;
+	}
+	SH_GAME_API auto Animator::GetSkeleton() const -> const render::Skeleton*
+	{
+		if (!core::IsValid(model) || skeletonIdx < 0 || skeletonIdx >= static_cast<int>(model->GetSkeletons().size()))
+			return nullptr;
+		return &model->GetSkeletons()[skeletonIdx];
+	}
+
+	SH_GAME_API void Animator::Evaluate(float dt)
+	{
+		if (bDirty)
+			Rebind();
+
+		const render::Skeleton* const skeleton = GetSkeleton();
+		if (skeleton == nullptr || modelMatrices.size() != skeleton->joints.size())
+			return;
+
+		dt *= speed;
+		pose.SetRestPose(*skeleton);
+		for (std::size_t i = 0; i < layers.size(); ++i)
+		{
+			const Layer& layer = layers[i];
+			if (layer.motions.empty())
+				continue;
+			if (i == 0)
+			{
+				EvaluateLayer(i, dt, pose);
+				continue;
+			}
+			if (layer.weight <= 0.f)
+				continue;
+
+			// 레이어가 애니메이션 하지 않는 채널은 아래 레이어의 값을 유지한다.
+			layerPose = pose;
+			EvaluateLayer(i, dt, layerPose);
+			const float* const mask = layerMasks[i].empty() ? nullptr : layerMasks[i].data();
+			render::AnimationPose::Blend(pose, layerPose, std::min(layer.weight, 1.f), pose, mask);
+		}
+		pose.ComputeModelMatrices(*skeleton, modelMatrices.data());
+	}
+	void Animator::EvaluateLayer(std::size_t layerIdx, float dt, render::AnimationPose& out)
+	{
+		const Layer& layer = layers[layerIdx];
+		const auto getClip =
+			[this](const Motion& motion) -> const render::AnimationClip*
+			{
+				if (motion.clipIdx < 0 || motion.clipIdx >= static_cast<int>(bindings.size()) || !core::IsValid(clips[motion.clipIdx]))
+					return nullptr;
+				return clips[motion.clipIdx];
+			};
+
+		// 파라미터를 사이에 둔 두 모션을 찾는다.
+		const auto it = std::lower_bound(layer.motions.begin(), layer.motions.end(), layer.parameter,
+			[](const Motion& motion, float value) { return motion.threshold < value; });
+		std::size_t a = 0, b = 0;
+		float alpha = 0.f;
+		if (it == layer.motions.end())
+			a = b = layer.motions.size() - 1;
+		else if (it != layer.motions.begin())
+		{
+			b = it - layer.motions.begin();
+			a = b - 1;
+			const float range = layer.motions[b].threshold - layer.motions[a].threshold;
+			alpha = range > 0.f ? (layer.parameter - layer.motions[a].threshold) / range : 1.f;
+		}
+		const Motion& motionA = layer.motions[a];
+		const Motion& motionB = layer.motions[b];
+		const render::AnimationClip* const clipA = getClip(motionA);
+		const render::AnimationClip* const clipB = getClip(motionB);
+
+		// 두 모션은 정규화된 시간을 공유하고 한 주기의 길이는 섞인 비율로 정해진다.
+		const auto cycleLength =
+			[](const render::AnimationClip* clip, const Motion& motion) -> float
+			{
+				if (clip == nullptr || motion.speed <= 0.f)
+					return 0.f;
+				return clip->GetDuration() / motion.speed;
+			};
+		const float cycle = cycleLength(clipA, motionA) + (cycleLength(clipB, motionB) - cycleLength(clipA, motionA)) * alpha;
+		float& time = layerTimes[layerIdx];
+		if (cycle > 0.f)
+		{
+			time += dt / cycle;
+			time = layer.bLoop ? time - std::floor(time) : std::clamp(time, 0.f, 1.f);
+		}
+
+		if (clipA != nullptr)
+			clipA->Sample(time * clipA->GetDuration(), false, bindings[motionA.clipIdx], out);
+		if (clipB == nullptr || b == a || alpha <= 0.f)
+			return;
+		blendPose = out;
+		clipB->Sample(time * clipB->GetDuration(), false, bindings[motionB.clipIdx], blendPose);
+		render::AnimationPose::Blend(out, blendPose, alpha, out);
+	}
+	void Animator::Rebind()
+	{
+		bDirty = false;
+		bindings.clear();
+		modelMatrices.clear();
+		layerMasks.assign(layers.size(), {});
+		layerTimes.resize(layers.size(), 0.f);
+
+		const render::Skeleton* const skeleton = GetSkeleton();
+		if (skeleton == nullptr)
+			return;
+
+		bindings.resize(clips.size());
+		for (std::size_t i = 0; i < clips.size(); ++i)
+		{
+			if (core::IsValid(clips[i]))
+				bindings[i] = clips[i]->Bind(*skeleton);
+		}
+
+		const std::size_t stride = render::AnimationPose::CalcStride(skeleton->joints.size());
+		for (std::size_t i = 0; i < layers.size(); ++i)
+		{
+			if (layers[i].maskRoot.empty())
+				continue;
+			const int root = skeleton->FindJoint(layers[i].maskRoot);
+			if (root < 0)
+			{
+				SH_WARN_FORMAT("Animator layer({}) mask root joint is not found: {}", layers[i].name, layers[i].maskRoot);
+				continue;
+			}
+			// 부모가 먼저 오는 순서라 부모의 마스크를 보고 자식을 정할 수 있다.
+			std::vector<float>& mask = layerMasks[i];
+			mask.assign(stride, 0.f);
+			for (uint32_t joint : skeleton->order)
+			{
+				const int parent = skeleton->joints[joint].parentIdx;
+				if (static_cast<int>(joint) == root || (parent >= 0 && mask[parent] > 0.f))
+					mask[joint] = 1.f;
+			}
+		}
+
+		pose.SetRestPose(*skeleton);
+		modelMatrices.resize(skeleton->joints.size(), glm::mat4{ 1.f });
+	}
+}//namespace
@@ -9,6 +9,7 @@
 
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <algorithm>
 #include <cstdint>
 namespace sh::game
 {
@@ -48,6 +49,9 @@ namespace sh::game
 		gameObject.transform->UpdateMatrix();
 		viewer.pos = gameObject.transform->GetWorldPosition();
 		viewer.to = lookPos;
+		// 렌더러들은 World의 카메라 순서대로 카메라별 LOD를 정한다.
+		const std::vector<Camera*>& cameras = world.GetCameras();
+		viewer.lodSlot = static_cast<uint32_t>(std::find(cameras.begin(), cameras.end(), this) - cameras.begin());
 		UpdateViewMatrix();
 		UpdateProjMatrix();
 
@@ -1,13 +1,17 @@
 ﻿#include "Component/Render/MeshRenderer.h"
 #include "Component/Render/PointLight.h"
 #include "Component/Render/DirectionalLight.h"
+#include "Component/Render/Camera.h"
 
 #include "World.h"
+#include "GameManager.h"
+#include "TextureStreamer.h"
 
 #include "Render/Renderer.h"
 
 #include <cstring>
 #include <algorithm>
+#include <limits>
 
 namespace sh::game
 {
@@ -87,9 +91,14 @@ namespace sh::game
 			mat->UpdateUniformBuffers();
 		}
 		UpdateDrawable();
+		UpdateLods();
 
 		for (render::Drawable* const drawable : drawables)
 			gameObject.world.renderer.PushDrawAble(drawable);
+
+		TextureStreamer* const streamer = GameManager::GetInstance()->GetTextureStreamer();
+		if (streamer != nullptr && streamer->GetTextureCount() > 0)
+			RequestTextureMips(*streamer);
 	}
 	SH_GAME_API void MeshRenderer::Deserialize(const core::Json& json)
 	{
@@ -428,6 +437,86 @@ namespace sh::game
 		}
 		UpdatePropertyBlockData();
 	}
+	void MeshRenderer::RequestTextureMips(TextureStreamer& streamer) const
+	{
+		// 모든 카메라 중 가장 크게 보이는 크기를 쓴다.
+		const glm::vec3& center = worldAABB.GetCenter();
+		const float radius = worldAABB.GetRadius();
+		float screenSize = 0.f;
+		for (Camera* const camera : gameObject.world.GetCameras())
+		{
+			if (!core::IsValid(camera) || !camera->IsActive())
+				continue;
+			const float distance = glm::distance(glm::vec3(camera->gameObject.transform->GetWorldPosition()), center);
+			// 직교 투영이거나 카메라가 안에 있으면 가장 높은 해상도를 쓴다.
+			if (camera->GetProjection() == Camera::Projection::Orthographic || distance <= radius)
+			{
+				screenSize = std::numeric_limits<float>::max();
+				break;
+			}
+			const float size = radius / (distance * glm::tan(glm::radians(camera->GetFov()) * 0.5f)) * camera->GetHeight();
+			screenSize = std::max(screenSize, size);
+		}
+		if (screenSize <= 0.f)
+			return;
+
+		for (std::size_t i = 0; i < mats.size(); ++i)
+		{
+			const render::Material* const mat = mats[i];
+			if (core::IsValid(mat))
+			{
+				for (const auto& [name, texture] : mat->GetTextureProperties())
+				{
+					if (core::IsValid(texture))
+						streamer.RequestScreenSize(*texture, screenSize);
+				}
+			}
+			if (i < propertyBlocks.size() && propertyBlocks[i] != nullptr)
+			{
+				for (const auto& [name, texture] : propertyBlocks[i]->GetTextureProperties())
+				{
+					if (core::IsValid(texture))
+						streamer.RequestScreenSize(*texture, screenSize);
+				}
+			}
+		}
+	}
+	void MeshRenderer::UpdateLods()
+	{
+		if (mesh->GetLodCount() <= 1)
+			return;
+
+		const glm::vec3& center = worldAABB.GetCenter();
+		const float radius = worldAABB.GetRadius();
+		const std::vector<Camera*>& cameras = gameObject.world.GetCameras();
+		cameraLods.resize(cameras.size(), 0);
+		cameraShadowLods.resize(cameras.size(), 0);
+
+		uint8_t shadowLod = std::numeric_limits<uint8_t>::max();
+		for (std::size_t i = 0; i < cameras.size(); ++i)
+		{
+			Camera* const camera = cameras[i];
+			if (!core::IsValid(camera) || !camera->IsActive())
+				continue;
+			const float distance = glm::distance(glm::vec3(camera->gameObject.transform->GetWorldPosition()), center);
+			// 직교 투영이거나 카메라가 안에 있으면 원본을 쓴다.
+			float screenSize = std::numeric_limits<float>::max();
+			if (camera->GetProjection() == Camera::Projection::Perspective && distance > radius)
+				screenSize = radius / (distance * glm::tan(glm::radians(camera->GetFov()) * 0.5f));
+
+			cameraLods[i] = static_cast<uint8_t>(mesh->SelectLod(screenSize * lodBias, cameraLods[i]));
+			cameraShadowLods[i] = static_cast<uint8_t>(mesh->SelectLod(screenSize * shadowLodBias, cameraShadowLods[i]));
+			shadowLod = std::min(shadowLod, cameraShadowLods[i]);
+		}
+		if (shadowLod == std::numeric_limits<uint8_t>::max())
+			shadowLod = 0;
+
+		for (render::Drawable* const drawable : drawables)
+		{
+			if (drawable != nullptr)
+				drawable->SetLods(cameraLods, shadowLod);
+		}
+	}
 	void MeshRenderer::FillLightStruct(render::Drawable& drawable, render::Shader& shader)
 	{
 		const std::vector<game::IOctreeElement*>& lights = world.GetLightOctree().Query(worldAABB);
@@ -1,12 +1,11 @@
 ﻿#include "Component/Render/SkinnedMeshRenderer.h"
 #include "Game/Component/Transform.h"
+#include "Game/Component/Render/Animator.h"
+#include "Game/GameObject.h"
+#include "Game/World.h"
+#include "Game/SkinningSystem.h"
 
-#include "Core/ThreadPool.h"
-
-#include "Render/UniformStructLayout.h"
-#include "Render/Shader.h"
-
-#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 
 namespace sh::game
 {
@@ -27,7 +26,7 @@ namespace sh::game
 	SH_GAME_API void SkinnedMeshRenderer::OnPropertyChanged(const core::reflection::Property& prop)
 	{
 		Super::OnPropertyChanged(prop);
-		if (prop.GetName() == core::Util::ConstexprHash("bones"))
+		if (prop.GetName() == core::Util::ConstexprHash("bones") || prop.GetName() == core::Util::ConstexprHash("animator"))
 			InitIBM();
 	}
 
@@ -41,95 +40,60 @@ namespace sh::game
 		InitIBM();
 	}
 
-	SH_GAME_API void SkinnedMeshRenderer::UpdateDrawable()
+	SH_GAME_API void SkinnedMeshRenderer::SetAnimator(Animator* animator)
 	{
-		ComputeBoneMatrices();
-		UploadBoneMatrices();
-		MeshRenderer::UpdateDrawable();
+		this->animator = animator;
+		InitIBM();
 	}
 
-	void SkinnedMeshRenderer::ComputeBoneMatrices()
+	SH_GAME_API void SkinnedMeshRenderer::ComputeSkinMatrices(glm::mat4* out) const
 	{
-		const std::size_t jointCount = std::min(bones.size(), inverseBindMatrices.size());
-		if (jointCount == 0)
-			return;
-
-		if (finalBoneMatrices.size() < bones.size())
-			finalBoneMatrices.resize(bones.size());
-
-		const auto calcMatricesFn =
-			[this](std::size_t start, std::size_t end)
-			{
-				for (std::size_t i = start; i < end; ++i)
-				{
-					if (!core::IsValid(bones[i]))
-						continue;
-					finalBoneMatrices[i] = bones[i]->localToWorldMatrix * inverseBindMatrices[i];
-				}
-			};
-
-		if (jointCount > 100)
+		if (core::IsValid(animator))
 		{
-			static core::ThreadPool& threadPool = *core::ThreadPool::GetInstance();
-			const std::size_t threadCount = 4;
-			std::vector<std::future<void>> futures(threadCount);
-			const std::size_t perTask = jointCount / threadCount;
-			const std::size_t rest = jointCount % threadCount;
-
-			std::size_t start = 0;
-			std::size_t futureIdx = 0;
-			for (int i = 0; i < rest; ++i)
-			{
-				futures[futureIdx++] = threadPool.AddTask(calcMatricesFn, start, start + perTask + 1);
-				start = start + perTask + 1;
-			}
-			for (int i = 0; i < threadCount - rest; ++i)
-			{
-				futures[futureIdx++] = threadPool.AddTask(calcMatricesFn, start, start + perTask);
-				start = start + perTask;
-			}
-			for (std::future<void>& future : futures)
-				future.get();
+			// 조인트 행렬은 Animator 기준 모델 공간이고 셰이더는 렌더러의 월드 행렬을 곱하므로 그 사이 변환을 앞에 곱한다.
+			const glm::mat4 toRenderer = glm::inverse(gameObject.transform->localToWorldMatrix) * animator->gameObject.transform->localToWorldMatrix;
+			ComputeSkinMatrices(animator->GetModelMatrices(), toRenderer, inverseBindMatrices, out);
+			return;
 		}
-		else
-			calcMatricesFn(0, jointCount);
+		boneMatrices.resize(bones.size());
+		for (std::size_t i = 0; i < bones.size(); ++i)
+			boneMatrices[i] = core::IsValid(bones[i]) ? &bones[i]->localToWorldMatrix : nullptr;
+		ComputeSkinMatrices(boneMatrices, inverseBindMatrices, out);
 	}
-	void SkinnedMeshRenderer::UploadBoneMatrices()
+	SH_GAME_API void SkinnedMeshRenderer::ComputeSkinMatrices(const std::vector<glm::mat4>& modelMatrices, const glm::mat4& toRenderer,
+		const std::vector<glm::mat4>& inverseBindMatrices, glm::mat4* out)
 	{
-		if (drawables.empty())
-			return;
-
-		const std::size_t dataSize = bones.size() * sizeof(glm::mat4);
-
-		for (std::size_t i = 0; i < drawables.size(); ++i)
+		const std::size_t jointCount = inverseBindMatrices.size();
+		const std::size_t count = std::min(modelMatrices.size(), jointCount);
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] = toRenderer * modelMatrices[i] * inverseBindMatrices[i];
+		std::fill(out + count, out + jointCount, glm::mat4{ 1.f });
+	}
+	SH_GAME_API void SkinnedMeshRenderer::ComputeSkinMatrices(const std::vector<const glm::mat4*>& boneMatrices,
+		const std::vector<glm::mat4>& inverseBindMatrices, glm::mat4* out)
+	{
+		const std::size_t jointCount = inverseBindMatrices.size();
+		const std::size_t count = std::min(boneMatrices.size(), jointCount);
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] = boneMatrices[i] != nullptr ? *boneMatrices[i] * inverseBindMatrices[i] : glm::mat4{ 1.f };
+		std::fill(out + count, out + jointCount, glm::mat4{ 1.f });
+	}
+	SH_GAME_API void SkinnedMeshRenderer::SetSkinOffset(uint32_t offset)
+	{
+		for (render::Drawable* const drawable : drawables)
 		{
-			render::Drawable* const drawable = drawables[i];
-			if (drawable == nullptr)
-				continue;
-			const render::Material* const mat = GetMaterial(i);
-			if (mat == nullptr || !mat->GetShader())
-				continue;
-
-			for (const render::Shader::LightingPassData& lightingPass : mat->GetShader()->GetAllShaderPass())
-			{
-				for (render::ShaderPass& pass : lightingPass.passes)
-				{
-					if (pass.IsPendingKill())
-						continue;
-					drawable->GetMaterialData().SetBindingData(
-						pass,
-						render::UniformStructLayout::Usage::Object,
-						pass.GetSkinBinding(),
-						finalBoneMatrices.data(),
-						dataSize);
-				}
-			}
+			if (drawable != nullptr)
+				drawable->SetSkinOffset(offset);
 		}
 	}
+
+	SH_GAME_API void SkinnedMeshRenderer::UpdateDrawable()
+	{
+		world.GetSkinningSystem().Submit(*this);
+		MeshRenderer::UpdateDrawable();
+	}
 	void SkinnedMeshRenderer::InitIBM()
 	{
-		finalBoneMatrices.resize(bones.size());
-
 		const render::SkinnedMesh* const skinnedMesh = static_cast<const render::SkinnedMesh*>(GetMesh());
 		if (core::IsValid(skinnedMesh))
 			inverseBindMatrices = skinnedMesh->GetInverseBindMatrices();
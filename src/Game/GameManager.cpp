@@ -6,6 +6,8 @@
 #include "Component/Render/Camera.h"
 
 #include "AssetLoaderFactory.h"
+#include "AsyncAssetLoader.h"
+#include "TextureStreamer.h"
 #include "Asset/WorldAsset.h"
 #include "Asset/ShaderAsset.h"
 #include "Asset/MaterialAsset.h"
@@ -22,6 +24,8 @@
 
 #include "Sound/SoundSystem.h"
 
+#include "Network/NetworkService.h"
+
 #include <algorithm>
 namespace sh::game
 {
@@ -72,6 +76,8 @@ namespace sh::game
 
 		componentLoader.UnloadPlugin();
 
+		network::NetworkService::GetInstance()->Stop();
+
 		worlds.clear();
 		mainWorld.Reset();
 	}
@@ -88,12 +94,21 @@ namespace sh::game
 	}
 	SH_GAME_API void GameManager::UpdateWorlds(double dt)
 	{
+		// 네트워크 스레드들이 받은 메시지를 프레임 시작에 한 번에 전달한다.
+		network::NetworkService::GetInstance()->Dispatch();
+		// 비동기로 불러온 에셋들은 월드가 갱신되기 전에 통합한다.
+		if (assetLoader != nullptr)
+			assetLoader->Update();
+
 		gui->Begin();
 		for (auto& [uuid, worldPtr] : worlds)
 			worldPtr->Update(dt);
 		immortalWorld->Update(dt);
 		gui->End();
 		renderer->PushRenderData(guiRenderData);
+		// 렌더러들이 LateUpdate()에서 요청한 밉을 동기화 전에 반영한다.
+		if (textureStreamer != nullptr)
+			textureStreamer->Update();
 
 		UpdateSoundListener();
 
@@ -221,19 +236,41 @@ namespace sh::game
 			}
 		}
 
+		// 시작 월드가 쓰는 에셋들은 기본 에셋과 유저 모듈을 불러오는 동안 미리 메모리에 올려둔다.
+		if (json.contains("starting"))
+		{
+			const core::UUID startingWorldUUID{ json["starting"].get_ref<const std::string&>() };
+			std::vector<core::UUID> prefetchUUIDs{ startingWorldUUID };
+			auto it = worldUUIDs.find(startingWorldUUID);
+			if (it != worldUUIDs.end())
+				prefetchUUIDs.insert(prefetchUUIDs.end(), it->second.begin(), it->second.end());
+			bundle.Prefetch(prefetchUUIDs);
+		}
+
 		LoadDefaultAsset(bundle);
 		LoadUserModule("ShellEngineUser");
 
 		if (json.contains("starting"))
 		{
 			const core::UUID startingWorldUUID{ json["starting"].get_ref<const std::string&>() };
-			auto worldAsset = bundle.LoadAsset(startingWorldUUID);
-			if (worldAsset == nullptr)
-				return false;
-
-			auto worldLoader = AssetLoaderFactory::GetInstance()->GetLoader(WorldAsset::ASSET_NAME);
+			game::World* world = nullptr;
+			// 월드가 참조하는 에셋들은 월드 오브젝트가 만들어지기 전에 워커 스레드에서 같이 읽힌다.
+			AsyncAssetLoader::Handle worldHandle{};
+			if (assetLoader != nullptr)
+			{
+				worldHandle = assetLoader->Load(startingWorldUUID);
+				assetLoader->Wait(worldHandle);
+				world = core::reflection::Cast<World>(worldHandle.Get());
+			}
+			else
+			{
+				auto worldAsset = bundle.LoadAsset(startingWorldUUID);
+				if (worldAsset == nullptr)
+					return false;
 
-			game::World* world = static_cast<game::World*>(worldLoader->Load(*worldAsset));
+				auto worldLoader = AssetLoaderFactory::GetInstance()->GetLoader(WorldAsset::ASSET_NAME);
+				world = static_cast<game::World*>(worldLoader->Load(*worldAsset));
+			}
 			if (world == nullptr)
 				return false;
 
@@ -250,6 +287,14 @@ namespace sh::game
 
 		return true;
 	}
+	SH_GAME_API void GameManager::SetAssetLoader(AsyncAssetLoader* loader)
+	{
+		assetLoader = loader;
+	}
+	SH_GAME_API void GameManager::SetTextureStreamer(TextureStreamer* streamer)
+	{
+		textureStreamer = streamer;
+	}
 	SH_GAME_API auto GameManager::CreateImmortalObject(std::string_view name) -> GameObject&
 	{
 		return *immortalWorld->AddGameObject(name);
@@ -465,6 +465,10 @@ namespace sh::game
 						return true;
 					}
 
+					// 이번 프레임에 갱신되지 않은 충돌은 접촉점이 없다.
+					if (!processingCollision.collision.IsContactValid())
+						processingCollision.collision.contactCount = 0;
+
 					bool bErase = false;
 					callCollisionFn(processingCollision.collision, processingCollision.state, bErase);
 
@@ -0,0 +1,987 @@
+﻿#include "Replication.h"
+#include "GameObject.h"
+#include "Vector.h"
+#include "Component/Transform.h"
+
+#include "Core/SObject.h"
+#include "Core/Reflection.hpp"
+#include "Core/Logger.h"
+
+#include "Network/BitStream.hpp"
+
+#include "glm/gtc/quaternion.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+namespace sh::game
+{
+	namespace
+	{
+		constexpr uint8_t FLAG_SPAWN = 1 << 0;
+		constexpr uint8_t FLAG_DESPAWN = 1 << 1;
+		/// @brief 확인을 기다릴 수 있는 스냅샷 수
+		constexpr uint32_t SNAPSHOT_HISTORY = 64;
+		/// @brief 공간이 부족해 건너뛴 객체가 이 수를 넘으면 스냅샷 작성을 멈춘다.
+		constexpr uint32_t MAX_SKIPPED_ENTITIES = 8;
+		/// @brief 이 만큼 오래된 제거 기록은 버린다.
+		constexpr uint32_t TOMBSTONE_LIFETIME = 1024;
+
+		auto VarintSize(uint32_t value) -> uint32_t
+		{
+			uint32_t size = 1;
+			while (value >= 0x80)
+			{
+				value >>= 7;
+				++size;
+			}
+			return size;
+		}
+		auto QuantizeScalar(float value, float precision) -> int32_t
+		{
+			if (!std::isfinite(value))
+				return 0;
+			const double scaled = std::round(static_cast<double>(value) / precision);
+			return static_cast<int32_t>(std::clamp(scaled, -2147483647.0, 2147483647.0));
+		}
+		auto DequantizeScalar(int32_t value, float precision) -> float
+		{
+			return static_cast<float>(value * static_cast<double>(precision));
+		}
+		void QuantizeVec3(const float* value, float precision, uint8_t* dst)
+		{
+			const int32_t q[3] = { QuantizeScalar(value[0], precision), QuantizeScalar(value[1], precision), QuantizeScalar(value[2], precision) };
+			std::memcpy(dst, q, sizeof(q));
+		}
+		auto DequantizeVec3(const uint8_t* src, float precision) -> glm::vec3
+		{
+			int32_t q[3];
+			std::memcpy(q, src, sizeof(q));
+			return glm::vec3{ DequantizeScalar(q[0], precision), DequantizeScalar(q[1], precision), DequantizeScalar(q[2], precision) };
+		}
+		/// @brief 가장 큰 성분을 빼고 나머지 세 성분을 10비트씩 담는다. (BitStream의 Quaternion과 같은 형식)
+		void PackQuat(glm::quat value, uint8_t* dst)
+		{
+			std::memset(dst, 0, sizeof(uint32_t));
+			network::BitWriter writer{ dst, sizeof(uint32_t) };
+			writer.Quaternion(value, 10);
+			writer.Flush();
+		}
+		auto UnpackQuat(const uint8_t* src) -> glm::quat
+		{
+			glm::quat value{ 1.f, 0.f, 0.f, 0.f };
+			network::BitReader reader{ src, sizeof(uint32_t) };
+			reader.Quaternion(value, 10);
+			return value;
+		}
+		auto GetFieldKind(const core::reflection::Property& prop) -> std::optional<ReplicationLayout::FieldKind>
+		{
+			using namespace core::reflection;
+			using Kind = ReplicationLayout::FieldKind;
+			if (prop.isConst || prop.isPointer || prop.isContainer)
+				return {};
+			if (prop.type == GetType<bool>())
+				return Kind::Bool;
+			if (prop.type == GetType<int32_t>())
+				return Kind::Int;
+			if (prop.type == GetType<uint32_t>())
+				return Kind::UInt;
+			if (prop.type == GetType<float>())
+				return Kind::Float;
+			if (prop.type == GetType<Vec3>() || prop.type == GetType<glm::vec3>())
+				return Kind::Vector;
+			if (prop.type == GetType<glm::quat>())
+				return Kind::Quat;
+			if (prop.isTriviallyCopyable)
+				return Kind::Raw;
+			return {};
+		}
+		auto GetStateSize(ReplicationLayout::FieldKind kind, const core::reflection::Property* prop) -> uint32_t
+		{
+			using Kind = ReplicationLayout::FieldKind;
+			switch (kind)
+			{
+			case Kind::Bool:
+				return 1;
+			case Kind::Int:
+			case Kind::UInt:
+			case Kind::Float:
+			case Kind::Quat:
+			case Kind::TransformRotation:
+				return 4;
+			case Kind::Vector:
+			case Kind::TransformPosition:
+			case Kind::TransformScale:
+				return 12;
+			case Kind::Raw:
+				return static_cast<uint32_t>(prop->type.size);
+			}
+			return 0;
+		}
+
+		void QuantizeField(const ReplicationLayout::Field& field, const core::SObject& part, const ReplicationQuantization& q, uint8_t* dst)
+		{
+			using Kind = ReplicationLayout::FieldKind;
+			switch (field.kind)
+			{
+			case Kind::Bool:
+			{
+				bool value;
+				std::memcpy(&value, field.prop->GetRaw(part), sizeof(bool));
+				dst[0] = value ? 1 : 0;
+				break;
+			}
+			case Kind::Int:
+			case Kind::UInt:
+			case Kind::Raw:
+				std::memcpy(dst, field.prop->GetRaw(part), field.size);
+				break;
+			case Kind::Float:
+			{
+				float value;
+				std::memcpy(&value, field.prop->GetRaw(part), sizeof(float));
+				const int32_t quantized = QuantizeScalar(value, q.floatPrecision);
+				std::memcpy(dst, &quantized, sizeof(int32_t));
+				break;
+			}
+			case Kind::Vector:
+			{
+				float value[3];
+				std::memcpy(value, field.prop->GetRaw(part), sizeof(value));
+				QuantizeVec3(value, q.vectorPrecision, dst);
+				break;
+			}
+			case Kind::Quat:
+				PackQuat(*field.prop->Get<glm::quat>(part), dst);
+				break;
+			case Kind::TransformPosition:
+			{
+				const glm::vec3 pos = static_cast<const Transform&>(part).position;
+				QuantizeVec3(&pos.x, q.vectorPrecision, dst);
+				break;
+			}
+			case Kind::TransformRotation:
+				PackQuat(static_cast<const Transform&>(part).GetQuat(), dst);
+				break;
+			case Kind::TransformScale:
+			{
+				const glm::vec3 scale = static_cast<const Transform&>(part).scale;
+				QuantizeVec3(&scale.x, q.vectorPrecision, dst);
+				break;
+			}
+			}
+		}
+		/// @brief 값이 다를 때만 쓰고 OnPropertyChanged()를 호출한다.
+		void ApplyRaw(const ReplicationLayout::Field& field, core::SObject& part, const void* value, std::size_t size)
+		{
+			void* const dst = field.prop->GetRaw(part);
+			if (std::memcmp(dst, value, size) == 0)
+				return;
+			std::memcpy(dst, value, size);
+			part.OnPropertyChanged(*field.prop);
+		}
+		void ApplyField(const ReplicationLayout::Field& field, core::SObject& part, const ReplicationQuantization& q, const uint8_t* src)
+		{
+			using Kind = ReplicationLayout::FieldKind;
+			switch (field.kind)
+			{
+			case Kind::Bool:
+			{
+				const bool value = src[0] != 0;
+				ApplyRaw(field, part, &value, sizeof(bool));
+				break;
+			}
+			case Kind::Int:
+			case Kind::UInt:
+			case Kind::Raw:
+				ApplyRaw(field, part, src, field.size);
+				break;
+			case Kind::Float:
+			{
+				int32_t quantized;
+				std::memcpy(&quantized, src, sizeof(int32_t));
+				const float value = DequantizeScalar(quantized, q.floatPrecision);
+				ApplyRaw(field, part, &value, sizeof(float));
+				break;
+			}
+			case Kind::Vector:
+			{
+				const glm::vec3 value = DequantizeVec3(src, q.vectorPrecision);
+				const float floats[3] = { value.x, value.y, value.z };
+				ApplyRaw(field, part, floats, sizeof(floats));
+				break;
+			}
+			case Kind::Quat:
+			{
+				const glm::quat value = UnpackQuat(src);
+				glm::quat& dst = *field.prop->Get<glm::quat>(part);
+				if (dst != value)
+				{
+					dst = value;
+					part.OnPropertyChanged(*field.prop);
+				}
+				break;
+			}
+			case Kind::TransformPosition:
+			{
+				const glm::vec3 value = DequantizeVec3(src, q.vectorPrecision);
+				static_cast<Transform&>(part).SetPosition(value.x, value.y, value.z);
+				break;
+			}
+			case Kind::TransformRotation:
+				static_cast<Transform&>(part).SetQuaternion(UnpackQuat(src));
+				break;
+			case Kind::TransformScale:
+			{
+				const glm::vec3 value = DequantizeVec3(src, q.vectorPrecision);
+				static_cast<Transform&>(part).SetScale(value.x, value.y, value.z);
+				break;
+			}
+			}
+		}
+		void WriteField(network::BitWriter& writer, const ReplicationLayout::Field& field, const uint8_t* src)
+		{
+			using Kind = ReplicationLayout::FieldKind;
+			switch (field.kind)
+			{
+			case Kind::Bool:
+				writer.WriteBits(src[0], 1);
+				break;
+			case Kind::Int:
+			case Kind::Float:
+			{
+				int32_t value;
+				std::memcpy(&value, src, sizeof(int32_t));
+				writer.Varint(value);
+				break;
+			}
+			case Kind::UInt:
+			{
+				uint32_t value;
+				std::memcpy(&value, src, sizeof(uint32_t));
+				writer.Varint(value);
+				break;
+			}
+			case Kind::Vector:
+			case Kind::TransformPosition:
+			case Kind::TransformScale:
+			{
+				int32_t value[3];
+				std::memcpy(value, src, sizeof(value));
+				writer.Varint(value[0]);
+				writer.Varint(value[1]);
+				writer.Varint(value[2]);
+				break;
+			}
+			case Kind::Quat:
+			case Kind::TransformRotation:
+			{
+				uint32_t value;
+				std::memcpy(&value, src, sizeof(uint32_t));
+				writer.WriteBits(value, 32);
+				break;
+			}
+			case Kind::Raw:
+				writer.WriteBytes(src, field.size);
+				break;
+			}
+		}
+		auto ReadField(network::BitReader& reader, const ReplicationLayout::Field& field, uint8_t* dst) -> bool
+		{
+			using Kind = ReplicationLayout::FieldKind;
+			switch (field.kind)
+			{
+			case Kind::Bool:
+				dst[0] = static_cast<uint8_t>(reader.ReadBits(1));
+				break;
+			case Kind::Int:
+			case Kind::Float:
+			{
+				int32_t value = 0;
+				reader.Varint(value);
+				std::memcpy(dst, &value, sizeof(int32_t));
+				break;
+			}
+			case Kind::UInt:
+			{
+				uint32_t value = 0;
+				reader.Varint(value);
+				std::memcpy(dst, &value, sizeof(uint32_t));
+				break;
+			}
+			case Kind::Vector:
+			case Kind::TransformPosition:
+			case Kind::TransformScale:
+			{
+				int32_t value[3]{};
+				reader.Varint(value[0]);
+				reader.Varint(value[1]);
+				reader.Varint(value[2]);
+				std::memcpy(dst, value, sizeof(value));
+				break;
+			}
+			case Kind::Quat:
+			case Kind::TransformRotation:
+			{
+				const uint32_t value = reader.ReadBits(32);
+				std::memcpy(dst, &value, sizeof(uint32_t));
+				break;
+			}
+			case Kind::Raw:
+			{
+				const uint8_t* data = reader.ReadBytes(field.size);
+				if (data == nullptr)
+					return false;
+				std::memcpy(dst, data, field.size);
+				break;
+			}
+			}
+			return !reader.IsOverflow();
+		}
+	}//namespace
+
+	SH_GAME_API auto ReplicationLayout::Build(core::ArrayView<core::SObject* const> parts) -> ReplicationLayout
+	{
+		ReplicationLayout layout{};
+		uint32_t hash = 2166136261u;
+		const auto mix =
+			[&](std::size_t value)
+			{
+				hash ^= static_cast<uint32_t>(value) ^ static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32);
+				hash *= 16777619u;
+			};
+		const auto addField =
+			[&](FieldKind kind, uint32_t part, const core::reflection::Property* prop)
+			{
+				const uint32_t size = GetStateSize(kind, prop);
+				layout.fields.push_back(Field{ kind, part, prop, layout.stateSize, size });
+				layout.stateSize += size;
+				mix(static_cast<std::size_t>(kind));
+			};
+
+		for (std::size_t i = 0; i < parts.size(); ++i)
+		{
+			const uint32_t partIdx = static_cast<uint32_t>(i);
+			const core::reflection::STypeInfo& type = parts[static_cast<int>(i)]->GetType();
+			mix(std::hash<core::Name>{}(type.name));
+			if (type.IsChildOf(Transform::GetStaticType()))
+			{
+				addField(FieldKind::TransformPosition, partIdx, nullptr);
+				addField(FieldKind::TransformRotation, partIdx, nullptr);
+				addField(FieldKind::TransformScale, partIdx, nullptr);
+			}
+			const core::reflection::STypeInfo* stype = &type;
+			while (stype != nullptr)
+			{
+				for (auto& prop : stype->GetProperties())
+				{
+					if (!prop->bReplicatedProperty)
+						continue;
+					const auto kind = GetFieldKind(*prop);
+					if (!kind.has_value())
+					{
+						SH_ERROR_FORMAT("{}::{} can't be replicated (unsupported type)", type.name.ToString(), prop->GetName().ToString());
+						continue;
+					}
+					mix(std::hash<core::Name>{}(prop->GetName()));
+					addField(kind.value(), partIdx, prop.get());
+				}
+				stype = stype->super;
+			}
+		}
+		layout.hash = hash;
+		return layout;
+	}
+	SH_GAME_API void ReplicationLayout::CollectParts(GameObject& obj, std::vector<core::SObject*>& out)
+	{
+		out.push_back(obj.transform);
+		for (Component* component : obj.GetComponents())
+		{
+			if (component != nullptr)
+				out.push_back(component);
+		}
+	}
+
+	struct ReplicationServer::Entity
+	{
+		NetId id = INVALID_NET_ID;
+		GameObject* gameObject = nullptr;
+		std::vector<core::SObject*> parts;
+		ReplicationLayout layout;
+		EntitySettings settings;
+		glm::vec3 position{ 0.f };
+		/// @brief 이번 틱의 양자화된 상태
+		std::vector<uint8_t> state;
+		bool bPendingRemove = false;
+	};
+	struct ReplicationServer::ClientEntity
+	{
+		/// @brief 클라이언트가 객체를 가지고 있는지 확인됐는지
+		bool bSpawnAcked = false;
+		bool bSpawnSent = false;
+		/// @brief 제거를 보내는 중. 확인되면 지워진다.
+		bool bDespawning = false;
+		uint32_t ackedSnapshot = 0;
+		uint32_t relevantSnapshot = 0;
+		float priority = 0.f;
+		/// @brief 클라이언트가 확인한 값
+		std::vector<uint8_t> baseline;
+		/// @brief 필드별 마지막으로 보낸 스냅샷. ackedSnapshot보다 크면 확인을 기다리는 필드다.
+		std::vector<uint32_t> fieldSentSnapshot;
+	};
+	struct ReplicationServer::SnapshotRecord
+	{
+		struct Sent
+		{
+			NetId id;
+			bool bDespawn;
+			uint32_t maskOffset;
+			uint32_t stateOffset;
+		};
+		uint32_t snapshot = 0;
+		std::vector<Sent> sent;
+		/// @brief 필드당 1바이트
+		std::vector<uint8_t> masks;
+		std::vector<uint8_t> states;
+	};
+	struct ReplicationServer::Client
+	{
+		glm::vec3 viewPos{ 0.f };
+		float viewRadius = 0.f;
+		uint32_t nextSnapshot = 1;
+		std::unordered_map<NetId, ClientEntity> entities;
+		std::array<SnapshotRecord, SNAPSHOT_HISTORY> records;
+		ClientStats stats;
+	};
+
+	SH_GAME_API ReplicationServer::ReplicationServer() :
+		ReplicationServer(Settings{})
+	{
+	}
+	SH_GAME_API ReplicationServer::ReplicationServer(const Settings& settings) :
+		settings(settings)
+	{
+		this->settings.cellSize = std::max(this->settings.cellSize, 1.f);
+		this->settings.relevanceHysteresis = std::max(this->settings.relevanceHysteresis, 1.f);
+		blockScratch.resize(this->settings.maxSnapshotBytes);
+	}
+	SH_GAME_API ReplicationServer::~ReplicationServer() = default;
+
+	SH_GAME_API auto ReplicationServer::Register(GameObject& obj, const EntitySettings& entitySettings) -> NetId
+	{
+		std::vector<core::SObject*> parts;
+		ReplicationLayout::CollectParts(obj, parts);
+		const NetId id = Register({ parts.data(), parts.size() }, entitySettings);
+		Entity& entity = *entities.back();
+		entity.gameObject = &obj;
+		entity.position = obj.transform->GetWorldPosition();
+		return id;
+	}
+	SH_GAME_API auto ReplicationServer::Register(core::ArrayView<core::SObject* const> parts, const EntitySettings& entitySettings) -> NetId
+	{
+		auto entity = std::make_unique<Entity>();
+		entity->id = nextNetId++;
+		entity->parts.assign(parts.begin(), parts.end());
+		entity->layout = ReplicationLayout::Build(parts);
+		entity->settings = entitySettings;
+		CaptureState(*entity);
+
+		const NetId id = entity->id;
+		entityIndices.insert({ id, static_cast<uint32_t>(entities.size()) });
+		entities.push_back(std::move(entity));
+		return id;
+	}
+	SH_GAME_API void ReplicationServer::Unregister(NetId id)
+	{
+		auto it = entityIndices.find(id);
+		if (it == entityIndices.end())
+			return;
+		// 격자가 인덱스를 가지고 있으므로 실제 제거는 다음 Update()에서 한다.
+		entities[it->second]->bPendingRemove = true;
+		entityIndices.erase(it);
+	}
+	SH_GAME_API void ReplicationServer::SetEntityPosition(NetId id, const glm::vec3& pos)
+	{
+		if (Entity* entity = FindEntity(id))
+			entity->position = pos;
+	}
+	SH_GAME_API auto ReplicationServer::AddClient() -> ClientId
+	{
+		const ClientId id = nextClientId++;
+		clients.insert({ id, std::make_unique<Client>() });
+		return id;
+	}
+	SH_GAME_API void ReplicationServer::RemoveClient(ClientId client)
+	{
+		clients.erase(client);
+	}
+	SH_GAME_API void ReplicationServer::SetClientView(ClientId client, const glm::vec3& pos, float radius)
+	{
+		auto it = clients.find(client);
+		if (it == clients.end())
+			return;
+		it->second->viewPos = pos;
+		it->second->viewRadius = std::max(radius, 0.f);
+	}
+	SH_GAME_API void ReplicationServer::Update()
+	{
+		// 파괴됐거나 등록 해제된 객체를 뒤에서부터 빼낸다.
+		for (std::size_t i = entities.size(); i-- > 0;)
+		{
+			Entity& entity = *entities[i];
+			bool bAlive = !entity.bPendingRemove && (entity.gameObject == nullptr || core::IsValid(entity.gameObject));
+			for (std::size_t p = 0; p < entity.parts.size() && bAlive; ++p)
+				bAlive = core::IsValid(entity.parts[p]);
+			if (bAlive)
+				continue;
+
+			if (!entity.bPendingRemove)
+				entityIndices.erase(entity.id);
+			if (i != entities.size() - 1)
+			{
+				entities[i] = std::move(entities.back());
+				entityIndices[entities[i]->id] = static_cast<uint32_t>(i);
+			}
+			entities.pop_back();
+		}
+
+		for (auto& [key, cell] : grid)
+			cell.clear();
+		// 비어 있는 셀이 쌓이지 않게 가끔 정리한다.
+		if (grid.size() > entities.size() * 2 + 64)
+		{
+			for (auto it = grid.begin(); it != grid.end();)
+			{
+				if (it->second.empty())
+					it = grid.erase(it);
+				else
+					++it;
+			}
+		}
+		alwaysRelevant.clear();
+
+		for (std::size_t i = 0; i < entities.size(); ++i)
+		{
+			Entity& entity = *entities[i];
+			if (entity.gameObject != nullptr)
+				entity.position = entity.gameObject->transform->GetWorldPosition();
+			CaptureState(entity);
+
+			if (entity.settings.bAlwaysRelevant)
+				alwaysRelevant.push_back(static_cast<uint32_t>(i));
+			else
+			{
+				const int32_t x = static_cast<int32_t>(std::floor(entity.position.x / settings.cellSize));
+				const int32_t z = static_cast<int32_t>(std::floor(entity.position.z / settings.cellSize));
+				grid[CellKey(x, z)].push_back(static_cast<uint32_t>(i));
+			}
+		}
+	}
+	SH_GAME_API auto ReplicationServer::WriteSnapshot(ClientId clientId, std::vector<uint8_t>& out) -> uint32_t
+	{
+		out.clear();
+		auto clientIt = clients.find(clientId);
+		if (clientIt == clients.end())
+			return 0;
+		Client& client = *clientIt->second;
+
+		const uint32_t snapshot = client.nextSnapshot++;
+		SnapshotRecord& record = client.records[snapshot % SNAPSHOT_HISTORY];
+		record.snapshot = snapshot;
+		record.sent.clear();
+		record.masks.clear();
+		record.states.clear();
+
+		// 시야 안의 객체들의 우선순위를 올린다. 가까울수록 많이 오른다.
+		QueryRelevant(client, queryScratch);
+		priorityScratch.clear();
+		for (uint32_t idx : queryScratch)
+		{
+			const Entity& entity = *entities[idx];
+			const float dist = glm::length(entity.position - client.viewPos);
+			auto ceIt = client.entities.find(entity.id);
+			if (!entity.settings.bAlwaysRelevant && dist > client.viewRadius && (ceIt == client.entities.end() || ceIt->second.bDespawning))
+				continue;
+			if (ceIt == client.entities.end())
+				ceIt = client.entities.insert({ entity.id, ClientEntity{} }).first;
+			ClientEntity& ce = ceIt->second;
+			// 제거가 확인되기 전에는 다시 만들지 않는다.
+			if (ce.bDespawning)
+				continue;
+			ce.relevantSnapshot = snapshot;
+
+			float weight = 1.f;
+			if (!entity.settings.bAlwaysRelevant && client.viewRadius > 0.f)
+				weight = 1.f - 0.9f * std::min(dist / client.viewRadius, 1.f);
+			ce.priority += entity.settings.priority * weight;
+			priorityScratch.push_back({ ce.priority, idx });
+		}
+
+		out.resize(settings.maxSnapshotBytes);
+		network::BitWriter writer{ out.data(), out.size() };
+		uint32_t snapshotValue = snapshot;
+		writer.Varint(snapshotValue);
+
+		ClientStats& stats = client.stats;
+		stats.relevantEntities = static_cast<uint32_t>(priorityScratch.size());
+		stats.sentEntities = 0;
+
+		// 제거를 먼저 기록한다.
+		for (auto it = client.entities.begin(); it != client.entities.end();)
+		{
+			const NetId id = it->first;
+			ClientEntity& ce = it->second;
+			if (!ce.bDespawning && (ce.relevantSnapshot != snapshot || FindEntity(id) == nullptr))
+			{
+				// 한 번도 보낸 적이 없다면 클라이언트는 모른다.
+				if (!ce.bSpawnSent)
+				{
+					it = client.entities.erase(it);
+					continue;
+				}
+				ce.bDespawning = true;
+			}
+			if (ce.bDespawning && writer.GetBytesWritten() + VarintSize(id) + 1 <= out.size())
+			{
+				uint32_t idValue = id;
+				uint8_t flags = FLAG_DESPAWN;
+				writer.Varint(idValue);
+				writer.Byte(flags);
+				record.sent.push_back(SnapshotRecord::Sent{ id, true, 0, 0 });
+			}
+			++it;
+		}
+
+		std::sort(priorityScratch.begin(), priorityScratch.end(),
+			[](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.first > b.first; });
+
+		uint32_t skipped = 0;
+		for (const auto& [priority, idx] : priorityScratch)
+		{
+			const Entity& entity = *entities[idx];
+			ClientEntity& ce = client.entities[entity.id];
+			const auto& fields = entity.layout.fields;
+			if (ce.fieldSentSnapshot.size() != fields.size())
+				ce.fieldSentSnapshot.assign(fields.size(), 0);
+
+			// 확인된 값과 다르거나, 확인을 기다리는 필드를 보낸다.
+			const bool bSpawn = !ce.bSpawnAcked;
+			bool bAnyField = false;
+			maskScratch.assign(fields.size(), 0);
+			for (std::size_t f = 0; f < fields.size(); ++f)
+			{
+				const auto& field = fields[f];
+				const bool bChanged = bSpawn ||
+					std::memcmp(entity.state.data() + field.offset, ce.baseline.data() + field.offset, field.size) != 0 ||
+					ce.fieldSentSnapshot[f] > ce.ackedSnapshot;
+				maskScratch[f] = bChanged ? 1 : 0;
+				bAnyField |= bChanged;
+			}
+			if (!bSpawn && !bAnyField)
+			{
+				ce.priority = 0.f;
+				continue;
+			}
+
+			network::BitWriter block{ blockScratch.data(), blockScratch.size() };
+			for (std::size_t f = 0; f < fields.size(); ++f)
+				block.WriteBits(maskScratch[f], 1);
+			for (std::size_t f = 0; f < fields.size(); ++f)
+			{
+				if (maskScratch[f])
+					WriteField(block, fields[f], entity.state.data() + fields[f].offset);
+			}
+			const uint32_t blockSize = static_cast<uint32_t>(block.Flush());
+
+			const uint32_t needed = VarintSize(entity.id) + 1 + (bSpawn ? VarintSize(entity.settings.archetype) + 4 : 0) + VarintSize(blockSize) + blockSize;
+			if (block.IsOverflow() || writer.GetBytesWritten() + needed > out.size())
+			{
+				// 남은 공간에 들어갈 작은 객체가 있을 수 있으니 몇 개는 더 시도한다. 우선순위는 계속 쌓인다.
+				if (++skipped >= MAX_SKIPPED_ENTITIES)
+					break;
+				continue;
+			}
+
+			uint32_t idValue = entity.id;
+			uint8_t flags = bSpawn ? FLAG_SPAWN : 0;
+			writer.Varint(idValue);
+			writer.Byte(flags);
+			if (bSpawn)
+			{
+				uint32_t archetype = entity.settings.archetype;
+				writer.Varint(archetype);
+				writer.WriteBits(entity.layout.hash, 32);
+			}
+			uint32_t blockSizeValue = blockSize;
+			writer.Varint(blockSizeValue);
+			writer.WriteBytes(blockScratch.data(), blockSize);
+
+			ce.bSpawnSent = true;
+			ce.priority = 0.f;
+			for (std::size_t f = 0; f < fields.size(); ++f)
+			{
+				if (maskScratch[f])
+					ce.fieldSentSnapshot[f] = snapshot;
+			}
+			record.sent.push_back(SnapshotRecord::Sent{ entity.id, false, static_cast<uint32_t>(record.masks.size()), static_cast<uint32_t>(record.states.size()) });
+			record.masks.insert(record.masks.end(), maskScratch.begin(), maskScratch.end());
+			record.states.insert(record.states.end(), entity.state.begin(), entity.state.end());
+			++stats.sentEntities;
+		}
+
+		out.resize(writer.Flush());
+		stats.snapshotBytes = static_cast<uint32_t>(out.size());
+		stats.totalBytes += out.size();
+		return snapshot;
+	}
+	SH_GAME_API void ReplicationServer::Acknowledge(ClientId clientId, uint32_t snapshot)
+	{
+		auto clientIt = clients.find(clientId);
+		if (clientIt == clients.end())
+			return;
+		Client& client = *clientIt->second;
+		SnapshotRecord& record = client.records[snapshot % SNAPSHOT_HISTORY];
+		if (record.snapshot != snapshot || snapshot == 0)
+			return;
+
+		for (const SnapshotRecord::Sent& sent : record.sent)
+		{
+			auto it = client.entities.find(sent.id);
+			if (it == client.entities.end())
+				continue;
+			ClientEntity& ce = it->second;
+			if (sent.bDespawn)
+			{
+				if (ce.bDespawning)
+					client.entities.erase(it);
+				continue;
+			}
+			// 더 최신 스냅샷이 이미 확인됐다면 그 스냅샷이 이 스냅샷의 필드를 모두 포함한다.
+			if (ce.bDespawning || snapshot <= ce.ackedSnapshot)
+				continue;
+			const Entity* entity = FindEntity(sent.id);
+			if (entity == nullptr)
+				continue;
+
+			const auto& fields = entity->layout.fields;
+			if (ce.baseline.size() != entity->layout.stateSize)
+				ce.baseline.assign(entity->layout.stateSize, 0);
+			for (std::size_t f = 0; f < fields.size(); ++f)
+			{
+				if (record.masks[sent.maskOffset + f] == 0)
+					continue;
+				std::memcpy(ce.baseline.data() + fields[f].offset, record.states.data() + sent.stateOffset + fields[f].offset, fields[f].size);
+			}
+			ce.bSpawnAcked = true;
+			ce.ackedSnapshot = snapshot;
+		}
+		// 같은 확인이 여러 번 와도 한 번만 처리한다.
+		record.snapshot = 0;
+	}
+	SH_GAME_API auto ReplicationServer::GetClientStats(ClientId client) const -> const ClientStats*
+	{
+		auto it = clients.find(client);
+		if (it == clients.end())
+			return nullptr;
+		return &it->second->stats;
+	}
+
+	auto ReplicationServer::FindEntity(NetId id) -> Entity*
+	{
+		auto it = entityIndices.find(id);
+		if (it == entityIndices.end())
+			return nullptr;
+		return entities[it->second].get();
+	}
+	void ReplicationServer::CaptureState(Entity& entity)
+	{
+		entity.state.resize(entity.layout.stateSize);
+		for (const auto& field : entity.layout.fields)
+			QuantizeField(field, *entity.parts[field.part], settings.quantization, entity.state.data() + field.offset);
+	}
+	void ReplicationServer::QueryRelevant(const Client& client, std::vector<uint32_t>& out) const
+	{
+		out.clear();
+		for (uint32_t idx : alwaysRelevant)
+		{
+			if (!entities[idx]->bPendingRemove)
+				out.push_back(idx);
+		}
+		if (client.viewRadius <= 0.f)
+			return;
+
+		// 이미 보이던 객체가 바로 사라지지 않도록 조금 더 넓게 찾는다.
+		const float radius = client.viewRadius * settings.relevanceHysteresis;
+		const float radiusSq = radius * radius;
+		const auto visit =
+			[&](const std::vector<uint32_t>& cell)
+			{
+				for (uint32_t idx : cell)
+				{
+					const Entity& entity = *entities[idx];
+					const glm::vec3 d = entity.position - client.viewPos;
+					if (!entity.bPendingRemove && glm::dot(d, d) <= radiusSq)
+						out.push_back(idx);
+				}
+			};
+
+		const int32_t minX = static_cast<int32_t>(std::floor((client.viewPos.x - radius) / settings.cellSize));
+		const int32_t maxX = static_cast<int32_t>(std::floor((client.viewPos.x + radius) / settings.cellSize));
+		const int32_t minZ = static_cast<int32_t>(std::floor((client.viewPos.z - radius) / settings.cellSize));
+		const int32_t maxZ = static_cast<int32_t>(std::floor((client.viewPos.z + radius) / settings.cellSize));
+		const uint64_t cellCount = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxZ - minZ + 1);
+		if (cellCount > grid.size())
+		{
+			// 시야가 월드보다 넓다면 셀을 하나씩 찾는 것보다 전부 훑는 편이 빠르다.
+			for (const auto& [key, cell] : grid)
+				visit(cell);
+			return;
+		}
+		for (int32_t x = minX; x <= maxX; ++x)
+		{
+			for (int32_t z = minZ; z <= maxZ; ++z)
+			{
+				auto it = grid.find(CellKey(x, z));
+				if (it != grid.end())
+					visit(it->second);
+			}
+		}
+	}
+	auto ReplicationServer::CellKey(int32_t x, int32_t z) -> uint64_t
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+	}
+
+	SH_GAME_API ReplicationClient::ReplicationClient(const ReplicationQuantization& quantization) :
+		quantization(quantization)
+	{
+	}
+	SH_GAME_API ReplicationClient::~ReplicationClient() = default;
+
+	SH_GAME_API void ReplicationClient::SetSpawnFunction(SpawnFunction&& fn)
+	{
+		spawnFn = std::move(fn);
+	}
+	SH_GAME_API void ReplicationClient::SetDespawnFunction(DespawnFunction&& fn)
+	{
+		despawnFn = std::move(fn);
+	}
+	SH_GAME_API auto ReplicationClient::ReadSnapshot(const uint8_t* data, std::size_t size) -> std::optional<uint32_t>
+	{
+		network::BitReader reader{ data, size };
+		uint32_t snapshot = 0;
+		if (!reader.Varint(snapshot) || snapshot == 0)
+			return {};
+
+		while (reader.GetBytesRead() < size)
+		{
+			uint32_t id = 0;
+			uint8_t flags = 0;
+			reader.Varint(id);
+			reader.Byte(flags);
+			if (reader.IsOverflow())
+				return {};
+
+			if (flags & FLAG_DESPAWN)
+			{
+				auto it = entities.find(id);
+				// 제거 뒤에 다시 만들어진 객체라면 예전 제거는 무시한다.
+				if (it != entities.end())
+				{
+					if (snapshot <= it->second.lastSnapshot)
+						continue;
+					entities.erase(it);
+					if (despawnFn)
+						despawnFn(id);
+				}
+				uint32_t& tombstone = tombstones[id];
+				tombstone = std::max(tombstone, snapshot);
+				continue;
+			}
+
+			uint32_t archetype = 0;
+			uint32_t layoutHash = 0;
+			if (flags & FLAG_SPAWN)
+			{
+				reader.Varint(archetype);
+				layoutHash = reader.ReadBits(32);
+			}
+			uint32_t blockSize = 0;
+			reader.Varint(blockSize);
+			const uint8_t* block = reader.ReadBytes(blockSize);
+			if (reader.IsOverflow())
+				return {};
+
+			auto it = entities.find(id);
+			if (it == entities.end())
+			{
+				if ((flags & FLAG_SPAWN) == 0 || !spawnFn)
+					continue;
+				auto tombIt = tombstones.find(id);
+				if (tombIt != tombstones.end() && tombIt->second >= snapshot)
+					continue;
+
+				Entity entity{};
+				if (!spawnFn(id, archetype, entity.parts))
+					continue;
+				entity.layout = ReplicationLayout::Build({ entity.parts.data(), entity.parts.size() });
+				if (entity.layout.hash != layoutHash)
+				{
+					SH_ERROR_FORMAT("Replicated entity {} (archetype {}) has a different layout from the server", id, archetype);
+					entity.bLayoutMismatch = true;
+				}
+				if (tombIt != tombstones.end())
+					tombstones.erase(tombIt);
+				it = entities.insert({ id, std::move(entity) }).first;
+			}
+			Entity& entity = it->second;
+			if (entity.bLayoutMismatch || snapshot <= entity.lastSnapshot)
+				continue;
+
+			const auto& fields = entity.layout.fields;
+			network::BitReader blockReader{ block, blockSize };
+			maskScratch.resize(fields.size());
+			for (std::size_t f = 0; f < fields.size(); ++f)
+				maskScratch[f] = static_cast<uint8_t>(blockReader.ReadBits(1));
+			stateScratch.resize(entity.layout.stateSize);
+			bool bValid = !blockReader.IsOverflow();
+			for (std::size_t f = 0; f < fields.size() && bValid; ++f)
+			{
+				if (maskScratch[f])
+					bValid = ReadField(blockReader, fields[f], stateScratch.data() + fields[f].offset);
+			}
+			if (!bValid)
+				continue;
+			for (std::size_t f = 0; f < fields.size(); ++f)
+			{
+				if (maskScratch[f])
+					ApplyField(fields[f], *entity.parts[fields[f].part], quantization, stateScratch.data() + fields[f].offset);
+			}
+			entity.lastSnapshot = snapshot;
+		}
+
+		if (snapshot > latestSnapshot)
+		{
+			latestSnapshot = snapshot;
+			if (latestSnapshot % 256 == 0)
+			{
+				for (auto it = tombstones.begin(); it != tombstones.end();)
+				{
+					if (it->second + TOMBSTONE_LIFETIME < latestSnapshot)
+						it = tombstones.erase(it);
+					else
+						++it;
+				}
+			}
+		}
+		return snapshot;
+	}
+	SH_GAME_API auto ReplicationClient::GetParts(NetId id) const -> const std::vector<core::SObject*>*
+	{
+		auto it = entities.find(id);
+		if (it == entities.end())
+			return nullptr;
+		return &it->second.parts;
+	}
+}//namespace
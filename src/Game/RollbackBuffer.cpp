@@ -0,0 +1,386 @@
+﻿#include "RollbackBuffer.h"
+#include "GameObject.h"
+#include "World.h"
+#include "Component/Transform.h"
+#include "Component/Phys/RigidBody.h"
+
+#include "Core/SObject.h"
+#include "Core/SObjectManager.h"
+#include "Core/Reflection.hpp"
+
+#include "Physics/PhysWorld.h"
+
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+namespace sh::game
+{
+	namespace
+	{
+		constexpr uint8_t EXTRA_TRANSFORM = 1 << 0;
+		constexpr uint8_t EXTRA_RIGIDBODY = 1 << 1;
+		// 회전(쿼터니언)
+		constexpr uint32_t TRANSFORM_EXTRA_SIZE = sizeof(float) * 4;
+		// 위치, 회전, 선속도, 각속도, 수면 여부. 패딩이 섞이지 않도록 필드 단위로 기록한다.
+		constexpr uint32_t RIGIDBODY_EXTRA_SIZE = sizeof(float) * (3 + 4 + 3 + 3) + 1;
+		/// @brief 복원 시 따라가는 프레임 체인의 최대 길이
+		constexpr uint32_t MAX_CHAIN = 256;
+
+		void WriteVarint(std::vector<uint8_t>& out, uint32_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(value));
+		}
+		auto ReadVarint(const uint8_t*& ptr) -> uint32_t
+		{
+			uint32_t value = 0;
+			uint32_t shift = 0;
+			while (*ptr & 0x80)
+			{
+				value |= static_cast<uint32_t>(*ptr & 0x7f) << shift;
+				shift += 7;
+				++ptr;
+			}
+			value |= static_cast<uint32_t>(*ptr) << shift;
+			++ptr;
+			return value;
+		}
+		void WriteBodyState(uint8_t* dst, const phys::PhysWorld::BodyState& state)
+		{
+			const float floats[13] = {
+				state.position.x, state.position.y, state.position.z,
+				state.rotation.x, state.rotation.y, state.rotation.z, state.rotation.w,
+				state.linearVelocity.x, state.linearVelocity.y, state.linearVelocity.z,
+				state.angularVelocity.x, state.angularVelocity.y, state.angularVelocity.z
+			};
+			std::memcpy(dst, floats, sizeof(floats));
+			dst[sizeof(floats)] = state.bSleeping ? 1 : 0;
+		}
+		void ReadBodyState(const uint8_t* src, phys::PhysWorld::BodyState& state)
+		{
+			float floats[13];
+			std::memcpy(floats, src, sizeof(floats));
+			state.position = { floats[0], floats[1], floats[2] };
+			state.rotation = glm::quat{ floats[6], floats[3], floats[4], floats[5] };
+			state.linearVelocity = { floats[7], floats[8], floats[9] };
+			state.angularVelocity = { floats[10], floats[11], floats[12] };
+			state.bSleeping = src[sizeof(floats)] != 0;
+		}
+	}//namespace
+
+	SH_GAME_API RollbackBuffer::RollbackBuffer() :
+		RollbackBuffer(Settings{})
+	{
+	}
+	SH_GAME_API RollbackBuffer::RollbackBuffer(const Settings& settings) :
+		settings(settings)
+	{
+		if (this->settings.capacity == 0)
+			this->settings.capacity = 1;
+		this->settings.keyFrameInterval = std::clamp(this->settings.keyFrameInterval, 1u, MAX_CHAIN - 1);
+		frames.resize(this->settings.capacity);
+	}
+	SH_GAME_API RollbackBuffer::~RollbackBuffer() = default;
+
+	SH_GAME_API void RollbackBuffer::Capture(uint64_t tick, core::ArrayView<core::SObject* const> objs)
+	{
+		if (bHasLast && tick <= latestTick)
+		{
+			InvalidateAfter(tick - 1);
+			bHasLast = false;
+		}
+
+		bool bKeyFrame = !bHasLast || tick - lastKeyTick >= settings.keyFrameInterval;
+		if (currentLayout == nullptr || !IsSameLayout(objs))
+		{
+			BuildLayout(objs);
+			bKeyFrame = true;
+		}
+
+		WriteRaw(*currentLayout, scratchRaw);
+
+		Frame& frame = frames[tick % settings.capacity];
+		frame.tick = tick;
+		frame.baseTick = bKeyFrame ? tick : latestTick;
+		frame.layout = currentLayout;
+		frame.bValid = true;
+		Encode(scratchRaw, bKeyFrame ? nullptr : lastRaw.data(), frame.data);
+
+		lastRaw.swap(scratchRaw);
+		latestTick = tick;
+		if (bKeyFrame)
+			lastKeyTick = tick;
+		bHasLast = true;
+	}
+	SH_GAME_API auto RollbackBuffer::Restore(uint64_t tick) -> bool
+	{
+		const Frame* frame = FindFrame(tick);
+		if (frame == nullptr)
+			return false;
+
+		// 키 프레임까지 거슬러 올라간 뒤 순서대로 델타를 적용한다.
+		const Frame* chain[MAX_CHAIN];
+		uint32_t chainCount = 0;
+		while (true)
+		{
+			if (chainCount >= MAX_CHAIN)
+				return false;
+			chain[chainCount++] = frame;
+			if (frame->baseTick == frame->tick)
+				break;
+			frame = FindFrame(frame->baseTick);
+			if (frame == nullptr)
+				return false;
+		}
+
+		const Frame& keyFrame = *chain[chainCount - 1];
+		scratchRaw.assign(keyFrame.layout->size, 0);
+		DecodeXor(keyFrame.data, scratchRaw);
+		for (int i = static_cast<int>(chainCount) - 2; i >= 0; --i)
+			DecodeXor(chain[i]->data, scratchRaw);
+
+		const Frame& target = *chain[0];
+		ApplyRaw(*target.layout, scratchRaw);
+
+		InvalidateAfter(tick);
+		currentLayout = target.layout;
+		lastRaw.swap(scratchRaw);
+		latestTick = tick;
+		lastKeyTick = keyFrame.tick;
+		bHasLast = true;
+		return true;
+	}
+	SH_GAME_API void RollbackBuffer::Clear()
+	{
+		for (auto& frame : frames)
+		{
+			frame.bValid = false;
+			frame.layout.reset();
+		}
+		currentLayout.reset();
+		lastRaw.clear();
+		latestTick = 0;
+		lastKeyTick = 0;
+		bHasLast = false;
+	}
+	SH_GAME_API auto RollbackBuffer::HasFrame(uint64_t tick) const -> bool
+	{
+		return FindFrame(tick) != nullptr;
+	}
+	SH_GAME_API auto RollbackBuffer::GetFrameSize(uint64_t tick) const -> std::size_t
+	{
+		const Frame* frame = FindFrame(tick);
+		return frame == nullptr ? 0 : frame->data.size();
+	}
+	SH_GAME_API auto RollbackBuffer::GetRawFrameSize(uint64_t tick) const -> std::size_t
+	{
+		const Frame* frame = FindFrame(tick);
+		return frame == nullptr ? 0 : frame->layout->size;
+	}
+	SH_GAME_API auto RollbackBuffer::IsKeyFrame(uint64_t tick) const -> bool
+	{
+		const Frame* frame = FindFrame(tick);
+		return frame != nullptr && frame->baseTick == frame->tick;
+	}
+
+	auto RollbackBuffer::GetTypeLayout(const core::reflection::STypeInfo& type) -> const TypeLayout*
+	{
+		auto it = typeLayouts.find(&type);
+		if (it != typeLayouts.end())
+			return it->second.get();
+
+		auto typeLayout = std::make_unique<TypeLayout>();
+		const core::reflection::STypeInfo* stype = &type;
+		while (stype != nullptr)
+		{
+			for (auto& prop : stype->GetProperties())
+			{
+				if (!prop->isTriviallyCopyable || prop->bConstProperty)
+					continue;
+				typeLayout->props.push_back(prop.get());
+				typeLayout->size += static_cast<uint32_t>(prop->type.size);
+			}
+			stype = stype->super;
+		}
+		if (type.IsChildOf(Transform::GetStaticType()))
+		{
+			typeLayout->extra |= EXTRA_TRANSFORM;
+			typeLayout->size += TRANSFORM_EXTRA_SIZE;
+		}
+		if (type.IsChildOf(RigidBody::GetStaticType()))
+		{
+			typeLayout->extra |= EXTRA_RIGIDBODY;
+			typeLayout->size += RIGIDBODY_EXTRA_SIZE;
+		}
+		return typeLayouts.insert({ &type, std::move(typeLayout) }).first->second.get();
+	}
+	auto RollbackBuffer::FindFrame(uint64_t tick) const -> const Frame*
+	{
+		const Frame& frame = frames[tick % settings.capacity];
+		if (!frame.bValid || frame.tick != tick)
+			return nullptr;
+		return &frame;
+	}
+	auto RollbackBuffer::IsSameLayout(core::ArrayView<core::SObject* const> objs) const -> bool
+	{
+		if (currentLayout->entries.size() != objs.size())
+			return false;
+		for (std::size_t i = 0; i < objs.size(); ++i)
+		{
+			if (currentLayout->entries[i].obj != objs[static_cast<int>(i)])
+				return false;
+		}
+		return true;
+	}
+	void RollbackBuffer::BuildLayout(core::ArrayView<core::SObject* const> objs)
+	{
+		auto layout = std::make_shared<Layout>();
+		layout->entries.reserve(objs.size());
+		for (std::size_t i = 0; i < objs.size(); ++i)
+		{
+			core::SObject* const obj = objs[static_cast<int>(i)];
+			const TypeLayout* typeLayout = GetTypeLayout(obj->GetType());
+			layout->entries.push_back(Entry{ obj, obj->GetUUID(), typeLayout, layout->size });
+			layout->size += typeLayout->size;
+		}
+		currentLayout = std::move(layout);
+	}
+	void RollbackBuffer::WriteRaw(const Layout& layout, std::vector<uint8_t>& raw) const
+	{
+		raw.resize(layout.size);
+		for (const Entry& entry : layout.entries)
+		{
+			uint8_t* dst = raw.data() + entry.offset;
+			for (const core::reflection::Property* prop : entry.type->props)
+			{
+				std::memcpy(dst, prop->GetRaw(*static_cast<const core::SObject*>(entry.obj)), prop->type.size);
+				dst += prop->type.size;
+			}
+			if (entry.type->extra & EXTRA_TRANSFORM)
+			{
+				const glm::quat& quat = static_cast<const Transform*>(entry.obj)->GetQuat();
+				const float floats[4] = { quat.x, quat.y, quat.z, quat.w };
+				std::memcpy(dst, floats, TRANSFORM_EXTRA_SIZE);
+				dst += TRANSFORM_EXTRA_SIZE;
+			}
+			if (entry.type->extra & EXTRA_RIGIDBODY)
+			{
+				const auto rb = static_cast<const RigidBody*>(entry.obj);
+				phys::PhysWorld::BodyState state{};
+				if (rb->GetNativeHandle() != nullptr)
+					rb->gameObject.world.GetPhysWorld().ReadBodyState(rb->GetNativeHandle(), state);
+				WriteBodyState(dst, state);
+				dst += RIGIDBODY_EXTRA_SIZE;
+			}
+		}
+	}
+	void RollbackBuffer::ApplyRaw(const Layout& layout, const std::vector<uint8_t>& raw) const
+	{
+		auto objManager = core::SObjectManager::GetInstance();
+		for (const Entry& entry : layout.entries)
+		{
+			// 파괴된 객체의 주소가 다른 객체에 재사용됐을 수 있으므로 UUID까지 확인한다.
+			if (!objManager->IsSObject(entry.obj) || entry.obj->IsPendingKill() || entry.obj->GetUUID() != entry.uuid)
+				continue;
+
+			const uint8_t* src = raw.data() + entry.offset;
+			for (const core::reflection::Property* prop : entry.type->props)
+			{
+				void* const dst = prop->GetRaw(*entry.obj);
+				if (std::memcmp(dst, src, prop->type.size) != 0)
+				{
+					std::memcpy(dst, src, prop->type.size);
+					entry.obj->OnPropertyChanged(*prop);
+				}
+				src += prop->type.size;
+			}
+			if (entry.type->extra & EXTRA_TRANSFORM)
+			{
+				float floats[4];
+				std::memcpy(floats, src, TRANSFORM_EXTRA_SIZE);
+				static_cast<Transform*>(entry.obj)->SetQuaternion(glm::quat{ floats[3], floats[0], floats[1], floats[2] });
+				src += TRANSFORM_EXTRA_SIZE;
+			}
+			if (entry.type->extra & EXTRA_RIGIDBODY)
+			{
+				auto rb = static_cast<RigidBody*>(entry.obj);
+				phys::PhysWorld::BodyState state{};
+				ReadBodyState(src, state);
+				if (rb->GetNativeHandle() != nullptr)
+					rb->gameObject.world.GetPhysWorld().WriteBodyState(rb->GetNativeHandle(), state);
+				// 되돌리기 전 틱의 위치로부터 보간되지 않게 한다.
+				rb->ResetInterpolationState(state.position, state.rotation);
+				src += RIGIDBODY_EXTRA_SIZE;
+			}
+		}
+	}
+	void RollbackBuffer::InvalidateAfter(uint64_t tick)
+	{
+		for (auto& frame : frames)
+		{
+			if (frame.bValid && frame.tick > tick)
+				frame.bValid = false;
+		}
+	}
+
+	void RollbackBuffer::Encode(const std::vector<uint8_t>& raw, const uint8_t* base, std::vector<uint8_t>& out)
+	{
+		out.clear();
+		const std::size_t size = raw.size();
+		const auto byteAt =
+			[&](std::size_t i) -> uint8_t
+			{
+				return base == nullptr ? raw[i] : static_cast<uint8_t>(raw[i] ^ base[i]);
+			};
+
+		std::size_t i = 0;
+		while (i < size)
+		{
+			std::size_t zeroBegin = i;
+			while (i < size && byteAt(i) == 0)
+				++i;
+			const std::size_t literalBegin = i;
+			// 짧은 0 구간은 토큰을 새로 만드는 것보다 리터럴에 포함시키는 편이 작다.
+			while (i < size)
+			{
+				if (byteAt(i) != 0)
+				{
+					++i;
+					continue;
+				}
+				std::size_t run = i;
+				while (run < size && run - i < 3 && byteAt(run) == 0)
+					++run;
+				if (run - i >= 3 || run == size)
+					break;
+				i = run;
+			}
+			if (literalBegin == i)
+				break; // 끝까지 0
+			WriteVarint(out, static_cast<uint32_t>(literalBegin - zeroBegin));
+			WriteVarint(out, static_cast<uint32_t>(i - literalBegin));
+			for (std::size_t j = literalBegin; j < i; ++j)
+				out.push_back(byteAt(j));
+		}
+	}
+	void RollbackBuffer::DecodeXor(const std::vector<uint8_t>& encoded, std::vector<uint8_t>& raw)
+	{
+		const uint8_t* ptr = encoded.data();
+		const uint8_t* const end = ptr + encoded.size();
+		std::size_t pos = 0;
+		while (ptr < end)
+		{
+			pos += ReadVarint(ptr);
+			const uint32_t literalCount = ReadVarint(ptr);
+			assert(pos + literalCount <= raw.size());
+			for (uint32_t i = 0; i < literalCount; ++i)
+				raw[pos + i] ^= ptr[i];
+			ptr += literalCount;
+			pos += literalCount;
+		}
+	}
+}//namespace
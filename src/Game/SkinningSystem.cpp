@@ -0,0 +1,109 @@
+﻿#include "SkinningSystem.h"
+#include "Component/Render/Animator.h"
+#include "Component/Render/SkinnedMeshRenderer.h"
+
+#include "Core/ThreadPool.h"
+#include "Core/Logger.h"
+
+#include "Render/SkinPaletteBuffer.h"
+
+#include <algorithm>
+namespace sh::game
+{
+	SH_GAME_API SkinningSystem::SkinningSystem() = default;
+	SH_GAME_API SkinningSystem::~SkinningSystem() = default;
+
+	SH_GAME_API void SkinningSystem::Submit(Animator& animator)
+	{
+		animators.push_back(&animator);
+	}
+	SH_GAME_API void SkinningSystem::Submit(SkinnedMeshRenderer& renderer)
+	{
+		renderers.push_back(&renderer);
+	}
+	SH_GAME_API void SkinningSystem::Update(float dt, render::SkinPaletteBuffer& palette)
+	{
+		core::ThreadPool& threadPool = *core::ThreadPool::GetInstance();
+		// Animator는 자기 데이터만 쓰므로 캐릭터끼리 동시에 평가한다.
+		threadPool.ParallelFor(animators.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					if (core::IsValid(animators[i]))
+						animators[i]->Evaluate(dt);
+				}
+			}
+		);
+		animators.clear();
+
+		// 렌더러별 구간을 정하고 공유 버퍼를 한 번에 잡는다.
+		renderers.erase(std::remove_if(renderers.begin(), renderers.end(),
+			[](SkinnedMeshRenderer* renderer) { return !core::IsValid(renderer) || renderer->GetJointCount() == 0; }),
+			renderers.end());
+		jointCounts.resize(renderers.size());
+		for (std::size_t i = 0; i < renderers.size(); ++i)
+			jointCounts[i] = renderers[i]->GetJointCount();
+		const std::size_t total = CalcOffsets(jointCounts, offsets);
+
+		uint32_t baseOffset = 0;
+		glm::mat4* const matrices = palette.Allocate(total, baseOffset);
+		const std::size_t allocated = matrices == nullptr ? 0 : palette.GetCount() - baseOffset;
+		const std::size_t overflowCount = ClipOffsets(jointCounts, allocated, offsets);
+		// 넘치는 동안에는 매 프레임 반복되므로 한 번만 알리고, 다시 들어가게 되면 다음 넘침을 또 알린다.
+		if (overflowCount > 0 && !bOverflowLogged)
+			SH_ERROR_FORMAT("Skin palette overflow! {} skinned mesh renderer(s) are not drawn. requested: {}, allocated: {}", overflowCount, total, allocated);
+		bOverflowLogged = overflowCount > 0;
+
+		threadPool.ParallelFor(renderers.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					if (offsets[i] != render::SkinPaletteBuffer::INVALID_OFFSET)
+						renderers[i]->ComputeSkinMatrices(matrices + offsets[i]);
+				}
+			}
+		);
+		// Drawable은 메인 스레드에서만 고칠 수 있다. 들어가지 못한 렌더러도 이전 프레임의 시작 인덱스가 남지 않도록 지정한다.
+		for (std::size_t i = 0; i < renderers.size(); ++i)
+		{
+			if (offsets[i] == render::SkinPaletteBuffer::INVALID_OFFSET)
+				renderers[i]->SetSkinOffset(render::SkinPaletteBuffer::INVALID_OFFSET);
+			else
+				renderers[i]->SetSkinOffset(baseOffset + offsets[i]);
+		}
+		renderers.clear();
+	}
+	SH_GAME_API void SkinningSystem::Clear()
+	{
+		animators.clear();
+		renderers.clear();
+		jointCounts.clear();
+		offsets.clear();
+		bOverflowLogged = false;
+	}
+	SH_GAME_API auto SkinningSystem::CalcOffsets(const std::vector<std::size_t>& jointCounts, std::vector<uint32_t>& offsets) -> std::size_t
+	{
+		offsets.resize(jointCounts.size());
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < jointCounts.size(); ++i)
+		{
+			offsets[i] = static_cast<uint32_t>(total);
+			total += jointCounts[i];
+		}
+		return total;
+	}
+	SH_GAME_API auto SkinningSystem::ClipOffsets(const std::vector<std::size_t>& jointCounts, std::size_t allocated, std::vector<uint32_t>& offsets) -> std::size_t
+	{
+		std::size_t overflowCount = 0;
+		for (std::size_t i = 0; i < offsets.size(); ++i)
+		{
+			if (offsets[i] + jointCounts[i] <= allocated)
+				continue;
+			offsets[i] = render::SkinPaletteBuffer::INVALID_OFFSET;
+			++overflowCount;
+		}
+		return overflowCount;
+	}
+}//namespace
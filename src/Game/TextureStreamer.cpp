@@ -0,0 +1,271 @@
+﻿#include "TextureStreamer.h"
+#include "Asset/TextureAsset.h"
+
+#include "Core/Asset.h"
+#include "Core/ThreadPool.h"
+#include "Core/Logger.h"
+
+#include "Render/Texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+namespace sh::game
+{
+	TextureStreamer::Entry::Entry(render::Texture& texture, const core::UUID& assetUUID) :
+		texture(&texture), assetUUID(assetUUID)
+	{
+	}
+
+	SH_GAME_API TextureStreamer::TextureStreamer(SourceFn source) :
+		source(std::move(source)),
+		shared(std::make_shared<SharedState>())
+	{
+	}
+	SH_GAME_API TextureStreamer::~TextureStreamer()
+	{
+		// 진행 중인 작업은 shared만 참조하므로 결과는 버려진다.
+		shared->loadedQueue.Clear();
+		entries.clear();
+	}
+
+	SH_GAME_API auto TextureStreamer::GetTailMip(uint32_t width, uint32_t height, uint32_t mipCount) const -> uint32_t
+	{
+		if (mipCount == 0)
+			return 0;
+		uint32_t mip = 0;
+		while (mip + 1 < mipCount && std::max(width >> mip, height >> mip) > settings.tailSize)
+			++mip;
+		return mip;
+	}
+	SH_GAME_API void TextureStreamer::Register(render::Texture& texture, const core::UUID& assetUUID)
+	{
+		auto it = entries.find(&texture);
+		if (it != entries.end())
+		{
+			if (it->second.bLoading)
+				loadingSize -= it->second.loadingSize;
+			entries.erase(it);
+		}
+		Entry entry{ texture, assetUUID };
+		entry.tailMip = GetTailMip(texture.GetWidth(), texture.GetHeight(), texture.GetMipLevel());
+		entry.tailSize = GetMipsSize(texture, entry.tailMip);
+		entry.requestedMip = entry.tailMip;
+		entry.lastUsedFrame = frame;
+
+		texture.SetPixelDataKeepMip(entry.tailMip);
+		entries.insert({ &texture, std::move(entry) });
+	}
+	SH_GAME_API void TextureStreamer::RequestMip(const render::Texture& texture, uint32_t mip)
+	{
+		auto it = entries.find(&texture);
+		if (it == entries.end())
+			return;
+		Entry& entry = it->second;
+		entry.requestedMip = std::min(entry.requestedMip, mip);
+		entry.lastUsedFrame = frame;
+	}
+	SH_GAME_API void TextureStreamer::RequestScreenSize(const render::Texture& texture, float screenSize)
+	{
+		auto it = entries.find(&texture);
+		if (it == entries.end())
+			return;
+		const uint32_t mip = CalcMip(std::max(texture.GetWidth(), texture.GetHeight()), screenSize, settings.mipBias);
+		Entry& entry = it->second;
+		entry.requestedMip = std::min(entry.requestedMip, mip);
+		entry.lastUsedFrame = frame;
+	}
+	SH_GAME_API void TextureStreamer::Update()
+	{
+		ReceiveLoadedMips();
+
+		residentSize = 0;
+		for (auto it = entries.begin(); it != entries.end();)
+		{
+			Entry& entry = it->second;
+			if (!entry.texture.IsValid())
+			{
+				if (entry.bLoading)
+					loadingSize -= entry.loadingSize;
+				it = entries.erase(it);
+				continue;
+			}
+			// 밉 꼬리는 GPU에 올라간 것과 별개로 CPU 메모리에도 남아있다.
+			residentSize += entry.texture->GetResidentSize() + entry.tailSize;
+			++it;
+		}
+
+		struct Upgrade
+		{
+			Entry* entry;
+			uint32_t mip;
+			uint32_t residentMip;
+		};
+		std::vector<Upgrade> upgrades;
+		for (auto& [texture, entry] : entries)
+		{
+			const uint32_t requestedMip = entry.requestedMip;
+			entry.requestedMip = entry.tailMip;
+
+			const uint32_t residentMip = entry.texture->GetResidentMip();
+			if (!entry.bLoading && requestedMip < residentMip)
+				upgrades.push_back(Upgrade{ &entry, requestedMip, residentMip });
+		}
+		// 요청과 차이가 큰(가장 흐리게 보이는) 텍스쳐부터 읽는다.
+		std::sort(upgrades.begin(), upgrades.end(),
+			[](const Upgrade& a, const Upgrade& b)
+			{
+				return a.residentMip - a.mip > b.residentMip - b.mip;
+			}
+		);
+		for (const Upgrade& upgrade : upgrades)
+		{
+			if (loadingCount >= settings.maxConcurrentLoads)
+				break;
+			Entry& entry = *upgrade.entry;
+			const std::size_t currentSize = GetMipsSize(*entry.texture, upgrade.residentMip);
+
+			uint32_t mip = upgrade.mip;
+			std::size_t required = GetMipsSize(*entry.texture, mip) - currentSize;
+			if (IsOverBudget(required))
+				Evict(required, entry);
+			// 예산 안에서 가능한 가장 높은 해상도를 읽는다.
+			while (mip < upgrade.residentMip && IsOverBudget(required))
+			{
+				++mip;
+				required = GetMipsSize(*entry.texture, mip) - currentSize;
+			}
+			if (mip >= upgrade.residentMip)
+				continue;
+			RequestLoad(entry, mip, required);
+		}
+		++frame;
+	}
+
+	SH_GAME_API auto TextureStreamer::CalcMip(uint32_t textureSize, float screenSize, float bias) -> uint32_t
+	{
+		if (screenSize <= 0.f)
+			return std::numeric_limits<uint32_t>::max();
+		const float mip = std::log2(static_cast<float>(textureSize) / screenSize) + bias;
+		if (mip <= 0.f)
+			return 0;
+		return static_cast<uint32_t>(mip);
+	}
+	SH_GAME_API auto TextureStreamer::ExtractMips(const TextureAsset& asset, uint32_t firstMip, uint32_t lastMip) -> std::vector<std::vector<uint8_t>>
+	{
+		const TextureAsset::TextureHeader header = asset.GetHeader();
+		const TextureAsset::PixelData pixelData = asset.GetPixelData();
+		const uint32_t mipCount = header.bMipmap ? static_cast<uint32_t>(std::floor(std::log2(std::max(header.width, header.height)))) + 1 : 1;
+		if (firstMip >= lastMip || lastMip > mipCount)
+			return {};
+
+		std::vector<std::vector<uint8_t>> mips;
+		mips.reserve(lastMip - firstMip);
+		std::size_t offset = 0;
+		for (uint32_t mip = 0; mip < lastMip; ++mip)
+		{
+			const std::size_t size = render::GetTextureFormatMipSize(header.format, std::max(1u, header.width >> mip), std::max(1u, header.height >> mip));
+			if (offset + size > pixelData.size)
+			{
+				SH_ERROR_FORMAT("Texture asset({}) is smaller than mip {}", asset.GetAssetUUID().ToString(), mip);
+				return {};
+			}
+			if (mip >= firstMip)
+				mips.emplace_back(pixelData.pixelDataPtr + offset, pixelData.pixelDataPtr + offset + size);
+			offset += size;
+		}
+		return mips;
+	}
+
+	void TextureStreamer::ReceiveLoadedMips()
+	{
+		shared->loadedQueue.Drain(
+			[this](LoadedMips& loaded)
+			{
+				--loadingCount;
+				auto it = entries.find(loaded.texture);
+				if (it == entries.end())
+					return;
+				Entry& entry = it->second;
+				if (!entry.bLoading || entry.ticket != loaded.ticket)
+					return;
+				entry.bLoading = false;
+				loadingSize -= entry.loadingSize;
+				entry.loadingSize = 0;
+
+				if (loaded.mips.empty() || !entry.texture.IsValid())
+					return;
+				// 읽는 동안 이미 더 높은 해상도가 올라갔다면 버린다.
+				if (entry.texture->GetResidentMip() <= loaded.firstMip)
+					return;
+				// 밉 꼬리는 메모리에 남아있으므로 그 위의 밉만 넘긴다.
+				entry.texture->SetResidentMips(loaded.firstMip, std::move(loaded.mips));
+			}
+		);
+	}
+	void TextureStreamer::RequestLoad(Entry& entry, uint32_t mip, std::size_t size)
+	{
+		if (source == nullptr)
+		{
+			SH_ERROR("TextureStreamer: source is not set!");
+			return;
+		}
+		entry.bLoading = true;
+		entry.loadingMip = mip;
+		entry.loadingSize = size;
+		entry.ticket = ++nextTicket;
+		loadingSize += size;
+		++loadingCount;
+
+		// 에셋 읽기, 압축 해제, 밉 추출은 워커 스레드에서 수행
+		core::ThreadPool::GetInstance()->AddContinousTask(
+			[shared = shared, source = source, uuid = entry.assetUUID, texture = entry.texture.Get(), ticket = entry.ticket, mip, lastMip = entry.tailMip]()
+			{
+				LoadedMips loaded{ texture, ticket, mip, {} };
+				std::unique_ptr<core::Asset> asset = source(uuid);
+				if (asset != nullptr && std::strcmp(asset->GetType(), TextureAsset::ASSET_NAME) == 0)
+					loaded.mips = ExtractMips(static_cast<const TextureAsset&>(*asset), mip, lastMip);
+				else
+					SH_ERROR_FORMAT("TextureStreamer: failed to load texture asset({})", uuid.ToString());
+				shared->loadedQueue.Push(std::move(loaded));
+			}
+		);
+	}
+	auto TextureStreamer::Evict(std::size_t required, const Entry& except) -> bool
+	{
+		std::vector<Entry*> candidates;
+		for (auto& [texture, entry] : entries)
+		{
+			if (&entry == &except || entry.bLoading || entry.lastUsedFrame == frame)
+				continue;
+			if (entry.texture->GetResidentMip() < entry.tailMip)
+				candidates.push_back(&entry);
+		}
+		std::sort(candidates.begin(), candidates.end(),
+			[](const Entry* a, const Entry* b) { return a->lastUsedFrame < b->lastUsedFrame; });
+
+		for (Entry* entry : candidates)
+		{
+			if (!IsOverBudget(required))
+				break;
+			const std::size_t before = entry->texture->GetResidentSize();
+			// 밉 꼬리는 CPU 메모리에 남아있으므로 다시 읽지 않고 내릴 수 있다.
+			if (!entry->texture->SetResidentMips(entry->tailMip, {}))
+				continue;
+			residentSize -= before - entry->texture->GetResidentSize();
+		}
+		return !IsOverBudget(required);
+	}
+	auto TextureStreamer::IsOverBudget(std::size_t required) const -> bool
+	{
+		return residentSize + loadingSize + required > settings.memoryBudget;
+	}
+	auto TextureStreamer::GetMipsSize(const render::Texture& texture, uint32_t firstMip) -> std::size_t
+	{
+		std::size_t size = 0;
+		for (uint32_t mip = firstMip; mip < texture.GetMipLevel(); ++mip)
+			size += render::GetTextureFormatMipSize(texture.GetTextureFormat(), std::max(1u, texture.GetWidth() >> mip), std::max(1u, texture.GetHeight() >> mip));
+		return size;
+	}
+}//namespace
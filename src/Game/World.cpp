@@ -4,6 +4,9 @@
 #include "WorldEvents.hpp"
 #include "AssetLoaderFactory.h"
 #include "GameRenderer.h"
+#include "WorldStreamer.h"
+#include "RollbackBuffer.h"
+#include "SkinningSystem.h"
 #include "Component/Phys/RigidBody.h"
 #include "Component/Phys/Collider.h"
 #include "Component/Render/Camera.h"
@@ -15,6 +18,7 @@
 
 #include "Render/Renderer.h"
 #include "Render/ShadowMapManager.h"
+#include "Render/SkinPaletteBuffer.h"
 
 #include <utility>
 #include <cstdint>
@@ -31,79 +35,12 @@ namespace sh::game
 		gc = core::GarbageCollection::GetInstance();
 
 		shadowMapManager = std::make_unique<render::ShadowMapManager>();
-
-		physEventSubscriber.SetCallback(
-			[](const phys::PhysicsEvent& evt)
-			{
-				const auto callCollisionFn =
-					[](const phys::PhysicsEvent& evt, RigidBody* rb1Ptr, Collider* collider2Ptr)
-					{
-						if (core::IsValid(rb1Ptr))
-						{
-							if (evt.type == phys::PhysicsEvent::Type::CollisionEnter ||
-								evt.type == phys::PhysicsEvent::Type::CollisionStay ||
-								evt.type == phys::PhysicsEvent::Type::CollisionExit)
-							{
-								if (evt.contactCount < Collision::ARRAY_SIZE)
-								{
-									std::array<phys::ContactPoint, Collision::ARRAY_SIZE> contactPoint;
-									for (uint32_t i = 0; i < evt.contactCount; ++i)
-										evt.getContactPointFn(contactPoint[i], i);
-
-									Collision collision{ contactPoint };
-									collision.collider = collider2Ptr;
-									collision.contactCount = evt.contactCount;
-									if (evt.type == phys::PhysicsEvent::Type::CollisionEnter)
-										rb1Ptr->gameObject.OnCollisionEnter(std::move(collision));
-									else if (evt.type == phys::PhysicsEvent::Type::CollisionStay)
-										rb1Ptr->gameObject.OnCollisionStay(std::move(collision));
-									else if (evt.type == phys::PhysicsEvent::Type::CollisionExit)
-										rb1Ptr->gameObject.OnCollisionExit(std::move(collision));
-								}
-								else
-								{
-									std::vector<phys::ContactPoint> contactPoint(evt.contactCount);
-									for (uint32_t i = 0; i < evt.contactCount; ++i)
-										evt.getContactPointFn(contactPoint[i], i);
-
-									Collision collision{ std::move(contactPoint) };
-									collision.collider = collider2Ptr;
-									collision.contactCount = evt.contactCount;
-									if (evt.type == phys::PhysicsEvent::Type::CollisionEnter)
-										rb1Ptr->gameObject.OnCollisionEnter(std::move(collision));
-									if (evt.type == phys::PhysicsEvent::Type::CollisionStay)
-										rb1Ptr->gameObject.OnCollisionStay(std::move(collision));
-									else if (evt.type == phys::PhysicsEvent::Type::CollisionExit)
-										rb1Ptr->gameObject.OnCollisionExit(std::move(collision));
-								}
-							}
-							else
-							{
-								if (!core::IsValid(collider2Ptr))
-									return;
-								if (evt.type == phys::PhysicsEvent::Type::TriggerEnter)
-									rb1Ptr->gameObject.OnTriggerEnter(*collider2Ptr);
-								else if (evt.type == phys::PhysicsEvent::Type::TriggerExit)
-									rb1Ptr->gameObject.OnTriggerExit(*collider2Ptr);
-							}
-						}
-					};
-				RigidBody* const rb1Ptr = RigidBody::GetRigidBodyUsingHandle(evt.rigidBody1Handle);
-				RigidBody* const rb2Ptr = RigidBody::GetRigidBodyUsingHandle(evt.rigidBody2Handle);
-				Collider* const collider1Ptr = Collider::GetColliderUsingHandle(evt.collider1Handle);
-				Collider* const collider2Ptr = Collider::GetColliderUsingHandle(evt.collider2Handle);
-
-				callCollisionFn(evt, rb1Ptr, collider2Ptr);
-				callCollisionFn(evt, rb2Ptr, collider1Ptr);
-			}
-		);
-		physWorld.bus.Subscribe(physEventSubscriber);
+		skinningSystem = std::make_unique<SkinningSystem>();
 	}
 	SH_GAME_API World::~World()
 	{
 		SH_INFO_FORMAT("~World {}", GetUUID().ToString());
 		Clear();
-		physWorld.bus.Unsubscribe(physEventSubscriber);
 		physWorld.Clean();
 	}
 
@@ -136,6 +73,8 @@ namespace sh::game
 	{
 		bLoaded = true;
 		Super::Deserialize(json);
+		// 프로퍼티로 불러온 설정에 맞춰 롤백 버퍼를 준비한다.
+		SetDeterministic(bDeterministic, tickRate);
 
 		if (!json.contains("objs"))
 		{
@@ -153,78 +92,7 @@ namespace sh::game
 		// 유효한 참조를 위해 두번 로드하는 과정을 거친다.
 		// 생성만 하는 과정
 		for (const auto& objJson : json["objs"])
-		{
-			const std::string& name = objJson["name"].get_ref<const std::string&>();
-			core::UUID objuuid{ objJson["uuid"].get_ref<const std::string&>() };
-
-			auto sobj = objManager->GetSObject(objuuid);
-			GameObject* gameObj = nullptr;
-			if (core::IsValid(sobj)) // 이미 월드 상에 존재 할 경우
-			{
-				gameObj = static_cast<GameObject*>(sobj);
-				// 모든 컴포넌트 제거
-				for (int i = 0; i < gameObj->GetComponents().size(); ++i)
-				{
-					Component* component = gameObj->GetComponents()[i];
-					if (component == nullptr)
-						continue;
-					component->SetUUID(core::UUID::Generate());
-					component->Destroy();
-				}
-			}
-			else
-			{
-				if (sobj != nullptr) // pending kill
-					sobj->SetUUID(core::UUID::Generate());
-				gameObj = this->AddGameObject(name);
-				gameObj->SetUUID(objuuid);
-			}
-
-			for (auto& compJson : objJson["Components"])
-			{
-				std::string name{ compJson["name"].get<std::string>() };
-				std::string type{ compJson["type"].get<std::string>() };
-				core::UUID uuid{ compJson["uuid"].get<std::string>() };
-				if (type == "Transform") // 트랜스폼은 게임오브젝트 생성 시 이미 만들어져있다.
-				{
-					if (gameObj->transform->GetUUID() != uuid)
-					{
-						// 실패 했다면 이미 해당 트랜스폼이 존재하는 상태
-						if (!gameObj->transform->SetUUID(uuid))
-						{
-							auto obj = core::SObjectManager::GetInstance()->GetSObject(uuid);
-							// 보류 상태라면 UUID 변경
-							if (obj != nullptr && obj->IsPendingKill())
-							{
-								obj->SetUUID(core::UUID::Generate());
-								gameObj->transform->SetUUID(uuid);
-							}
-						}
-					}
-					continue;
-				}
-
-				auto compType = ComponentModule::GetInstance()->GetComponent(name);
-				if (compType == nullptr)
-				{
-					SH_ERROR_FORMAT("Not found component - {}", type);
-					continue;
-				}
-				Component* component = compType->Create(*gameObj);
-				// 실패 했다면 이미 해당 컴포넌트가 존재하는 상태 (PendingKill상태 일 수도 있음)
-				if (!component->SetUUID(core::UUID{ uuid }))
-				{
-					auto obj = core::SObjectManager::GetInstance()->GetSObject(uuid);
-					// 보류 상태라면 UUID 변경
-					if (obj != nullptr && obj->IsPendingKill())
-					{
-						obj->SetUUID(core::UUID::Generate());
-						component->SetUUID(core::UUID{ uuid });
-					}
-				}
-				gameObj->AddComponent(component);
-			}
-		}
+			CreateGameObjectFromJson(objJson);
 		// 역 직렬화
 		for (const auto& objJson : json["objs"])
 		{
@@ -241,11 +109,21 @@ namespace sh::game
 			if (!obj->activeSelf)
 				obj->PropagateEnable();
 		}
+		// 빌드 시 셀로 나뉜 월드라면 나머지 오브젝트는 카메라 위치에 따라 스트리밍 된다.
+		if (json.contains("streaming"))
+		{
+			streamer = std::make_unique<WorldStreamer>(*this);
+			streamer->Setup(json["streaming"]);
+		}
 	}
 	SH_GAME_API void World::Clear()
 	{
 		if (shadowMapManager != nullptr)
 			shadowMapManager->Clear();
+		skinningSystem->Clear();
+		physWorld.EndStep();
+		physWorld.ClearContacts();
+		dispatchedContactPairs = 0;
 		CleanObjs();
 
 		while (!deallocatedObjs.empty())
@@ -274,6 +152,7 @@ namespace sh::game
 	}
 	SH_GAME_API void World::CleanObjs()
 	{
+		streamer.reset();
 		for (auto obj : objs)
 		{
 			if (core::IsValid(obj))
@@ -307,6 +186,82 @@ namespace sh::game
 		return obj;
 	}
 
+	SH_GAME_API auto World::CreateGameObjectFromJson(const core::Json& objJson) -> GameObject*
+	{
+		core::SObjectManager* objManager = core::SObjectManager::GetInstance();
+		const std::string& name = objJson["name"].get_ref<const std::string&>();
+		core::UUID objuuid{ objJson["uuid"].get_ref<const std::string&>() };
+
+		auto sobj = objManager->GetSObject(objuuid);
+		GameObject* gameObj = nullptr;
+		if (core::IsValid(sobj)) // 이미 월드 상에 존재 할 경우
+		{
+			gameObj = static_cast<GameObject*>(sobj);
+			// 모든 컴포넌트 제거
+			for (int i = 0; i < gameObj->GetComponents().size(); ++i)
+			{
+				Component* component = gameObj->GetComponents()[i];
+				if (component == nullptr)
+					continue;
+				component->SetUUID(core::UUID::Generate());
+				component->Destroy();
+			}
+		}
+		else
+		{
+			if (sobj != nullptr) // pending kill
+				sobj->SetUUID(core::UUID::Generate());
+			gameObj = this->AddGameObject(name);
+			gameObj->SetUUID(objuuid);
+		}
+
+		for (auto& compJson : objJson["Components"])
+		{
+			std::string name{ compJson["name"].get<std::string>() };
+			std::string type{ compJson["type"].get<std::string>() };
+			core::UUID uuid{ compJson["uuid"].get<std::string>() };
+			if (type == "Transform") // 트랜스폼은 게임오브젝트 생성 시 이미 만들어져있다.
+			{
+				if (gameObj->transform->GetUUID() != uuid)
+				{
+					// 실패 했다면 이미 해당 트랜스폼이 존재하는 상태
+					if (!gameObj->transform->SetUUID(uuid))
+					{
+						auto obj = core::SObjectManager::GetInstance()->GetSObject(uuid);
+						// 보류 상태라면 UUID 변경
+						if (obj != nullptr && obj->IsPendingKill())
+						{
+							obj->SetUUID(core::UUID::Generate());
+							gameObj->transform->SetUUID(uuid);
+						}
+					}
+				}
+				continue;
+			}
+
+			auto compType = ComponentModule::GetInstance()->GetComponent(name);
+			if (compType == nullptr)
+			{
+				SH_ERROR_FORMAT("Not found component - {}", type);
+				continue;
+			}
+			Component* component = compType->Create(*gameObj);
+			// 실패 했다면 이미 해당 컴포넌트가 존재하는 상태 (PendingKill상태 일 수도 있음)
+			if (!component->SetUUID(core::UUID{ uuid }))
+			{
+				auto obj = core::SObjectManager::GetInstance()->GetSObject(uuid);
+				// 보류 상태라면 UUID 변경
+				if (obj != nullptr && obj->IsPendingKill())
+				{
+					obj->SetUUID(core::UUID::Generate());
+					component->SetUUID(core::UUID{ uuid });
+				}
+			}
+			gameObj->AddComponent(component);
+		}
+		return gameObj;
+	}
+
 	SH_GAME_API void World::DestroyGameObject(std::string_view name)
 	{
 		GameObject* obj = GetGameObject(name);
@@ -382,6 +337,9 @@ namespace sh::game
 			eventBus.Publish(events::WorldEvent{ events::WorldEvent::Type::Play });
 		}
 
+		if (streamer != nullptr && core::IsValid(mainCamera))
+			streamer->Update(mainCamera->gameObject.transform->GetWorldPosition());
+
 		for (auto& addedObj : addedObjs)
 		{
 			if (addedObj.IsValid())
@@ -414,22 +372,19 @@ namespace sh::game
 				continue;
 			obj->BeginUpdate();
 		}
+		// 결정론적 모드에서는 스텝 결과가 틱 경계에 묶여야 하므로 비동기 스텝을 쓰지 않는다.
+		const bool bAsyncStep = bAsyncPhysics && !bDeterministic;
+		if (physWorld.IsAsyncStep() != bAsyncStep)
+			physWorld.SetAsyncStep(bAsyncStep);
+		// 지난 프레임의 충돌은 ProcessCollisionFunctions()에서 모두 처리됐다.
+		physWorld.ClearContacts();
+		dispatchedContactPairs = 0;
+		const float fixedDt = GetFixedDeltaTime();
 		dtAccumulator += dt;
-		while (dtAccumulator >= FIXED_TIME)
+		while (dtAccumulator >= fixedDt)
 		{
-			if (bPlaying)
-			{
-				physWorld.Update(FIXED_TIME);
-			}
-			for (auto& obj : objs)
-			{
-				if (!sh::core::IsValid(obj))
-					continue;
-				if (!obj->IsActive())
-					continue;
-				obj->FixedUpdate();
-			}
-			dtAccumulator -= FIXED_TIME;
+			FixedTick(fixedDt, bAsyncStep);
+			dtAccumulator -= fixedDt;
 		}
 		for (auto& obj : objs)
 		{
@@ -455,6 +410,7 @@ namespace sh::game
 				continue;
 			obj->LateUpdate();
 		}
+		skinningSystem->Update(static_cast<float>(dt), renderer.GetContext()->GetSkinPaletteBuffer());
 		if (shadowMapManager != nullptr)
 			shadowMapManager->Submit(renderer);
 	}
@@ -573,6 +529,150 @@ namespace sh::game
 	{
 		eventBus.Subscribe(subscriber);
 	}
+	void World::DispatchContacts()
+	{
+		const phys::ContactBuffer& contacts = physWorld.GetContacts();
+		const uint32_t pairCount = contacts.GetPairCount();
+		if (dispatchedContactPairs >= pairCount)
+			return;
+
+		const auto types = contacts.GetTypes();
+		const auto body1Idxs = contacts.GetBody1Idxs();
+		const auto body2Idxs = contacts.GetBody2Idxs();
+		const auto collider1Idxs = contacts.GetCollider1Idxs();
+		const auto collider2Idxs = contacts.GetCollider2Idxs();
+
+		const auto deliver =
+			[&](phys::ContactBuffer::PairType type, uint32_t pairIdx, RigidBody* rb, Collider* other)
+			{
+				if (!core::IsValid(rb))
+					return;
+				switch (type)
+				{
+				case phys::ContactBuffer::PairType::CollisionEnter:
+				case phys::ContactBuffer::PairType::CollisionStay:
+				case phys::ContactBuffer::PairType::CollisionExit:
+				{
+					Collision collision{ contacts, pairIdx };
+					collision.collider = other;
+					if (type == phys::ContactBuffer::PairType::CollisionEnter)
+						rb->gameObject.OnCollisionEnter(std::move(collision));
+					else if (type == phys::ContactBuffer::PairType::CollisionStay)
+						rb->gameObject.OnCollisionStay(std::move(collision));
+					else
+						rb->gameObject.OnCollisionExit(std::move(collision));
+					break;
+				}
+				case phys::ContactBuffer::PairType::TriggerEnter:
+					if (core::IsValid(other))
+						rb->gameObject.OnTriggerEnter(*other);
+					break;
+				case phys::ContactBuffer::PairType::TriggerExit:
+					if (core::IsValid(other))
+						rb->gameObject.OnTriggerExit(*other);
+					break;
+				}
+			};
+		for (uint32_t i = dispatchedContactPairs; i < pairCount; ++i)
+		{
+			// 해제된 인덱스는 버퍼가 비워지기 전까지 재사용되지 않으므로 nullptr이거나 원래 객체다.
+			RigidBody* const rb1Ptr = static_cast<RigidBody*>(physWorld.GetBodyUserData(body1Idxs[i]));
+			RigidBody* const rb2Ptr = static_cast<RigidBody*>(physWorld.GetBodyUserData(body2Idxs[i]));
+			Collider* const collider1Ptr = static_cast<Collider*>(physWorld.GetColliderUserData(collider1Idxs[i]));
+			Collider* const collider2Ptr = static_cast<Collider*>(physWorld.GetColliderUserData(collider2Idxs[i]));
+
+			deliver(types[i], i, rb1Ptr, collider2Ptr);
+			deliver(types[i], i, rb2Ptr, collider1Ptr);
+		}
+		dispatchedContactPairs = pairCount;
+	}
+	void World::FixedTick(float fixedDt, bool bAsyncStep)
+	{
+		if (bPlaying)
+		{
+			// 비동기 모드에서는 이전 틱에 시작한 스텝을 기다리고 결과를 반영한다.
+			if (bAsyncStep)
+				physWorld.EndStep();
+			else
+				physWorld.Update(fixedDt);
+			DispatchContacts();
+		}
+		for (auto& obj : objs)
+		{
+			if (!sh::core::IsValid(obj))
+				continue;
+			if (!obj->IsActive())
+				continue;
+			obj->FixedUpdate();
+		}
+		// 다음 스텝은 워커에서 진행되며 Update, LateUpdate와 겹쳐 실행된다.
+		if (bPlaying && bAsyncStep)
+			physWorld.BeginStep(fixedDt);
+		if (bPlaying)
+		{
+			++tick;
+			if (rollbackBuffer != nullptr)
+				CaptureRollback();
+		}
+	}
+	void World::CaptureRollback()
+	{
+		rollbackObjs.clear();
+		for (auto obj : objs)
+		{
+			if (!core::IsValid(obj))
+				continue;
+			rollbackObjs.push_back(obj);
+			for (auto component : obj->GetComponents())
+			{
+				if (core::IsValid(component))
+					rollbackObjs.push_back(component);
+			}
+		}
+		rollbackBuffer->Capture(tick, { rollbackObjs.data(), rollbackObjs.size() });
+	}
+	SH_GAME_API void World::SetDeterministic(bool bDeterministic, uint32_t tickRate)
+	{
+		this->bDeterministic = bDeterministic;
+		this->tickRate = tickRate == 0 ? 1 : tickRate;
+		if (bDeterministic)
+		{
+			if (rollbackBuffer == nullptr)
+				rollbackBuffer = std::make_unique<RollbackBuffer>();
+			else
+				rollbackBuffer->Clear();
+		}
+		else
+			rollbackBuffer.reset();
+	}
+	SH_GAME_API auto World::Rollback(uint64_t tick) -> bool
+	{
+		if (rollbackBuffer == nullptr)
+			return false;
+		physWorld.EndStep();
+		if (!rollbackBuffer->Restore(tick))
+			return false;
+		this->tick = tick;
+		return true;
+	}
+	SH_GAME_API void World::Resimulate(uint32_t ticks)
+	{
+		const float fixedDt = GetFixedDeltaTime();
+		for (uint32_t i = 0; i < ticks; ++i)
+		{
+			physWorld.ClearContacts();
+			dispatchedContactPairs = 0;
+			FixedTick(fixedDt, false);
+			for (auto& obj : objs)
+			{
+				if (!sh::core::IsValid(obj))
+					continue;
+				if (!obj->IsActive())
+					continue;
+				obj->ProcessCollisionFunctions();
+			}
+		}
+	}
 	SH_GAME_API void World::Play()
 	{
 		if (bPlaying || bWaitPlaying)
@@ -585,6 +685,11 @@ namespace sh::game
 		if (!bPlaying)
 			return;
 
+		physWorld.EndStep();
+		DispatchContacts();
+		tick = 0;
+		if (rollbackBuffer != nullptr)
+			rollbackBuffer->Clear();
 		bPlaying = false;
 		bOnStart = false;
 		eventBus.Publish(events::WorldEvent{ events::WorldEvent::Type::Stop });
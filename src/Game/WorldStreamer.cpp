@@ -0,0 +1,393 @@
+﻿#include "WorldStreamer.h"
+#include "World.h"
+#include "GameObject.h"
+#include "Asset/WorldCellAsset.h"
+
+#include "Core/ThreadPool.h"
+#include "Core/SObjectManager.h"
+#include "Core/Logger.h"
+
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <unordered_map>
+namespace sh::game
+{
+	WorldStreamer::CellSourceFn WorldStreamer::cellSource = nullptr;
+
+	SH_GAME_API WorldStreamer::WorldStreamer(World& world) :
+		world(world),
+		shared(std::make_shared<SharedState>())
+	{
+	}
+	SH_GAME_API WorldStreamer::~WorldStreamer()
+	{
+		// 진행 중인 작업은 shared만 참조하므로 결과는 버려진다.
+		shared->loadedQueue.Clear();
+	}
+	SH_GAME_API void WorldStreamer::Setup(const core::Json& streamingJson)
+	{
+		UnloadAll();
+		cells.clear();
+		cellCoords.clear();
+
+		if (streamingJson.contains("cellSize"))
+			settings.cellSize = streamingJson["cellSize"].get<float>();
+		if (streamingJson.contains("loadRadius"))
+			settings.loadRadius = streamingJson["loadRadius"].get<float>();
+		if (streamingJson.contains("unloadRadius"))
+			settings.unloadRadius = streamingJson["unloadRadius"].get<float>();
+		settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+
+		if (!streamingJson.contains("cells"))
+			return;
+
+		for (const auto& cellJson : streamingJson["cells"])
+		{
+			Cell cell{};
+			cell.coord.x = cellJson["x"].get<int32_t>();
+			cell.coord.z = cellJson["z"].get<int32_t>();
+			cell.assetUUID = core::UUID{ cellJson["uuid"].get_ref<const std::string&>() };
+
+			cellCoords.push_back(cell.coord);
+			cells.push_back(std::move(cell));
+		}
+		SH_INFO_FORMAT("World streaming: {} cells (cell size: {})", cells.size(), settings.cellSize);
+	}
+	SH_GAME_API void WorldStreamer::Update(const Vec3& viewPos)
+	{
+		ReceiveLoadedCells();
+
+		cellResident.resize(cells.size());
+		for (std::size_t i = 0; i < cells.size(); ++i)
+			cellResident[i] = cells[i].state != CellState::Unloaded;
+		const std::size_t loadSlots = loadingCount < settings.maxConcurrentLoads ? settings.maxConcurrentLoads - loadingCount : 0;
+		PlanCells(cellCoords, cellResident, viewPos, settings, loadSlots, plan);
+
+		for (std::size_t cellIdx : plan.loads)
+			RequestLoad(cellIdx);
+		for (std::size_t cellIdx : plan.unloads)
+			Unload(cellIdx);
+
+		Integrate();
+	}
+	SH_GAME_API void WorldStreamer::UnloadAll()
+	{
+		for (std::size_t i = 0; i < cells.size(); ++i)
+		{
+			if (cells[i].state != CellState::Unloaded)
+				Unload(i);
+		}
+		// 아직 실행 중인 작업의 결과는 이후 ReceiveLoadedCells에서 버려지며 loadingCount를 줄인다.
+		shared->loadedQueue.Drain([this](LoadedCell&) { --loadingCount; });
+	}
+	SH_GAME_API void WorldStreamer::SetSettings(const Settings& settings)
+	{
+		this->settings = settings;
+		this->settings.unloadRadius = std::max(this->settings.unloadRadius, this->settings.loadRadius);
+	}
+	SH_GAME_API auto WorldStreamer::GetLoadedCellCount() const -> std::size_t
+	{
+		return std::count_if(cells.begin(), cells.end(), [](const Cell& cell) { return cell.state == CellState::Loaded; });
+	}
+	SH_GAME_API void WorldStreamer::SetCellSource(CellSourceFn fn)
+	{
+		cellSource = std::move(fn);
+	}
+	SH_GAME_API auto WorldStreamer::GetCellSource() -> const CellSourceFn&
+	{
+		return cellSource;
+	}
+	SH_GAME_API auto WorldStreamer::Partition(const core::Json& worldJson, const Settings& settings, const std::vector<std::string>& persistentNames) -> PartitionResult
+	{
+		PartitionResult result{};
+		result.persistentWorld = worldJson;
+
+		if (!worldJson.contains("objs") || !worldJson["objs"].is_array() || settings.cellSize <= 0.f)
+			return result;
+
+		const core::Json& objsJson = worldJson["objs"];
+
+		// 트랜스폼 UUID -> 오브젝트 인덱스, 부모 트랜스폼 UUID
+		std::unordered_map<std::string, std::size_t> transformOwners;
+		std::vector<std::string> parents(objsJson.size());
+		std::vector<Vec3> positions(objsJson.size());
+		for (std::size_t i = 0; i < objsJson.size(); ++i)
+		{
+			for (const auto& compJson : objsJson[i]["Components"])
+			{
+				if (compJson["type"].get_ref<const std::string&>() != "Transform")
+					continue;
+				transformOwners[compJson["uuid"].get<std::string>()] = i;
+
+				if (compJson.contains("Transform"))
+				{
+					const core::Json& transformJson = compJson["Transform"];
+					if (transformJson.contains("parent"))
+						parents[i] = transformJson["parent"].get<std::string>();
+					core::DeserializeProperty(transformJson, "vPosition", positions[i]);
+				}
+				break;
+			}
+		}
+		const auto findRootFn =
+			[&](std::size_t idx) -> std::size_t
+			{
+				std::size_t cur = idx;
+				for (std::size_t depth = 0; depth < objsJson.size() && !parents[cur].empty(); ++depth)
+				{
+					auto it = transformOwners.find(parents[cur]);
+					if (it == transformOwners.end())
+						break;
+					cur = it->second;
+				}
+				return cur;
+			};
+
+		// 셀 순서가 실행마다 같도록 좌표 순으로 모은다.
+		std::map<std::pair<int32_t, int32_t>, core::Json> cellObjs;
+		core::Json persistentObjs = core::Json::array();
+		for (std::size_t i = 0; i < objsJson.size(); ++i)
+		{
+			const std::size_t root = findRootFn(i);
+			const std::string& rootName = objsJson[root]["name"].get_ref<const std::string&>();
+			if (std::find(persistentNames.begin(), persistentNames.end(), rootName) != persistentNames.end())
+			{
+				persistentObjs.push_back(objsJson[i]);
+				continue;
+			}
+			const CellCoord coord = ToCellCoord(positions[root], settings.cellSize);
+			core::Json& cellJson = cellObjs[{ coord.x, coord.z }];
+			if (cellJson.is_null())
+				cellJson = core::Json::array();
+			cellJson.push_back(objsJson[i]);
+		}
+
+		const core::UUID worldUUID = worldJson.contains("uuid") ? core::UUID{ worldJson["uuid"].get<std::string>() } : core::UUID::Generate();
+
+		core::Json streamingJson{};
+		streamingJson["cellSize"] = settings.cellSize;
+		streamingJson["loadRadius"] = settings.loadRadius;
+		streamingJson["unloadRadius"] = settings.unloadRadius;
+		core::Json& cellsJson = streamingJson["cells"];
+		cellsJson = core::Json::array();
+		for (auto& [xz, objs] : cellObjs)
+		{
+			const CellCoord coord{ xz.first, xz.second };
+			const core::UUID cellUUID = MakeCellUUID(worldUUID, coord);
+
+			core::Json cellEntry{};
+			cellEntry["x"] = coord.x;
+			cellEntry["z"] = coord.z;
+			cellEntry["uuid"] = cellUUID.ToString();
+			cellsJson.push_back(std::move(cellEntry));
+
+			result.cells.push_back(std::make_unique<WorldCellAsset>(cellUUID, worldUUID, coord.x, coord.z, std::move(objs)));
+		}
+		result.persistentWorld["objs"] = std::move(persistentObjs);
+		result.persistentWorld["streaming"] = std::move(streamingJson);
+
+		return result;
+	}
+	SH_GAME_API auto WorldStreamer::ToCellCoord(const Vec3& pos, float cellSize) -> CellCoord
+	{
+		return CellCoord{ static_cast<int32_t>(std::floor(pos.x / cellSize)), static_cast<int32_t>(std::floor(pos.z / cellSize)) };
+	}
+	SH_GAME_API auto WorldStreamer::DistanceToCell(const Vec3& viewPos, const CellCoord& coord, float cellSize) -> float
+	{
+		const float cx = (static_cast<float>(coord.x) + 0.5f) * cellSize;
+		const float cz = (static_cast<float>(coord.z) + 0.5f) * cellSize;
+		const float dx = viewPos.x - cx;
+		const float dz = viewPos.z - cz;
+		return std::sqrt(dx * dx + dz * dz);
+	}
+	SH_GAME_API void WorldStreamer::PlanCells(const std::vector<CellCoord>& coords, const std::vector<uint8_t>& resident,
+		const Vec3& viewPos, const Settings& settings, std::size_t loadSlots, CellPlan& plan)
+	{
+		plan.loads.clear();
+		plan.unloads.clear();
+
+		thread_local std::vector<std::pair<float, std::size_t>> candidates;
+		candidates.clear();
+		const std::size_t count = std::min(coords.size(), resident.size());
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float distance = DistanceToCell(viewPos, coords[i], settings.cellSize);
+			// 불러오는 반경과 해제하는 반경 사이의 셀은 상태를 유지한다.
+			if (resident[i] == 0 && distance <= settings.loadRadius)
+				candidates.push_back({ distance, i });
+			else if (resident[i] != 0 && distance > settings.unloadRadius)
+				plan.unloads.push_back(i);
+		}
+		// 가까운 셀부터 요청
+		const std::size_t loadCount = std::min(loadSlots, candidates.size());
+		std::partial_sort(candidates.begin(), candidates.begin() + loadCount, candidates.end());
+		for (std::size_t i = 0; i < loadCount; ++i)
+			plan.loads.push_back(candidates[i].second);
+	}
+	SH_GAME_API auto WorldStreamer::MakeCellUUID(const core::UUID& worldUUID, const CellCoord& coord) -> core::UUID
+	{
+		struct
+		{
+			std::array<uint32_t, 4> world;
+			int32_t x;
+			int32_t z;
+		} key{ worldUUID.GetRawData(), coord.x, coord.z };
+		const uint64_t lo = core::Util::Hash64(&key, sizeof(key), 0);
+		const uint64_t hi = core::Util::Hash64(&key, sizeof(key), lo);
+		return core::UUID{ std::array<uint32_t, 4>{ static_cast<uint32_t>(lo), static_cast<uint32_t>(lo >> 32), static_cast<uint32_t>(hi), static_cast<uint32_t>(hi >> 32) } };
+	}
+
+	void WorldStreamer::RequestLoad(std::size_t cellIdx)
+	{
+		Cell& cell = cells[cellIdx];
+		if (cellSource == nullptr)
+		{
+			SH_ERROR("World streaming: cell source is not set!");
+			return;
+		}
+		cell.state = CellState::Loading;
+		++cell.ticket;
+		++loadingCount;
+
+		// 파일 읽기, 압축 해제, BSON 파싱은 워커 스레드에서 수행
+		core::ThreadPool::GetInstance()->AddContinousTask(
+			[shared = shared, source = cellSource, uuid = cell.assetUUID, cellIdx, ticket = cell.ticket]()
+			{
+				LoadedCell loaded{};
+				loaded.cellIdx = cellIdx;
+				loaded.ticket = ticket;
+
+				std::unique_ptr<core::Asset> asset = source(uuid);
+				if (asset != nullptr && std::strcmp(asset->GetType(), WorldCellAsset::ASSET_NAME) == 0)
+				{
+					auto& cellAsset = static_cast<WorldCellAsset&>(*asset);
+					core::Json cellJson = cellAsset.ReleaseCellData();
+					loaded.objs = std::move(cellJson["objs"]);
+				}
+				else
+					SH_ERROR_FORMAT("World streaming: failed to load cell({})", uuid.ToString());
+
+				shared->loadedQueue.Push(std::move(loaded));
+			}
+		);
+	}
+	void WorldStreamer::Unload(std::size_t cellIdx)
+	{
+		Cell& cell = cells[cellIdx];
+		// 로드 중인 셀의 작업은 계속 실행되므로 loadingCount는 버려질 결과를 받을 때 줄인다.
+		if (cell.state == CellState::Integrating)
+		{
+			auto it = std::find_if(integrations.begin(), integrations.end(), [cellIdx](const Integration& integration) { return integration.cellIdx == cellIdx; });
+			if (it != integrations.end())
+			{
+				for (GameObject* obj : it->created)
+					cell.objs.push_back(obj);
+				integrations.erase(it);
+			}
+		}
+
+		for (auto& obj : cell.objs)
+		{
+			if (obj.IsValid())
+				world.DestroyGameObject(*obj);
+		}
+		cell.objs.clear();
+		cell.state = CellState::Unloaded;
+		++cell.ticket; // 진행 중인 로드 결과 무효화
+	}
+	void WorldStreamer::ReceiveLoadedCells()
+	{
+		shared->loadedQueue.Drain(
+			[this](LoadedCell& loaded)
+			{
+				// 취소된 요청도 결과를 받을 때까지 작업 슬롯을 차지한다.
+				--loadingCount;
+				if (loaded.cellIdx >= cells.size())
+					return;
+				Cell& cell = cells[loaded.cellIdx];
+				if (cell.ticket != loaded.ticket || cell.state != CellState::Loading)
+					return;
+
+				if (!loaded.objs.is_array())
+				{
+					// 실패한 셀은 다시 요청하지 않도록 빈 셀로 취급한다.
+					cell.state = CellState::Loaded;
+					return;
+				}
+				cell.state = CellState::Integrating;
+
+				Integration integration{};
+				integration.cellIdx = loaded.cellIdx;
+				integration.objs = std::move(loaded.objs);
+				integration.created.reserve(integration.objs.size());
+				integrations.push_back(std::move(integration));
+			}
+		);
+	}
+	void WorldStreamer::Integrate()
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto deadline = Clock::now() + std::chrono::microseconds{ static_cast<int64_t>(settings.integrationBudgetMs * 1000.f) };
+
+		// 예산을 넘더라도 프레임당 최소 한 오브젝트는 진행해서 굶주림을 막는다.
+		bool bProgressed = false;
+		while (!integrations.empty())
+		{
+			Integration& integration = integrations.front();
+			const core::Json& objs = integration.objs;
+
+			switch (integration.phase)
+			{
+			case Integration::Phase::Create:
+				// 유효한 참조를 위해 World::Deserialize와 같이 생성과 역직렬화를 나눠서 진행한다.
+				while (integration.cursor < objs.size())
+				{
+					if (bProgressed && Clock::now() >= deadline)
+						return;
+					GameObject* obj = world.CreateGameObjectFromJson(objs[integration.cursor++]);
+					if (obj != nullptr)
+						integration.created.push_back(obj);
+					bProgressed = true;
+				}
+				integration.phase = Integration::Phase::Deserialize;
+				integration.cursor = 0;
+				[[fallthrough]];
+			case Integration::Phase::Deserialize:
+			{
+				static core::SObjectManager& objManager = *core::SObjectManager::GetInstance();
+				while (integration.cursor < objs.size())
+				{
+					if (bProgressed && Clock::now() >= deadline)
+						return;
+					const core::Json& objJson = objs[integration.cursor++];
+					auto obj = static_cast<GameObject*>(objManager.GetSObject(core::UUID{ objJson["uuid"].get_ref<const std::string&>() }));
+					if (core::IsValid(obj))
+						obj->Deserialize(objJson); // 참조하는 에셋의 로드와 GPU 리소스 생성도 여기서 일어난다.
+					bProgressed = true;
+				}
+				integration.phase = Integration::Phase::Finish;
+				[[fallthrough]];
+			}
+			case Integration::Phase::Finish:
+			{
+				Cell& cell = cells[integration.cellIdx];
+				for (GameObject* obj : integration.created)
+				{
+					if (!core::IsValid(obj))
+						continue;
+					if (!obj->activeSelf)
+						obj->PropagateEnable();
+					cell.objs.push_back(obj);
+				}
+				cell.state = CellState::Loaded;
+				integrations.pop_front();
+				break;
+			}
+			}
+		}
+	}
+}//namespace
@@ -0,0 +1,595 @@
+﻿#include "Connection.h"
+#include "PacketCodec.h"
+#include "BitStream.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <cassert>
+namespace sh::network
+{
+	namespace
+	{
+		/// @brief 16비트 순번이 한 바퀴 돌아도 a가 b보다 나중인지 판단한다.
+		inline auto SequenceGreater(uint16_t a, uint16_t b) -> bool
+		{
+			return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+		}
+		inline auto IsReliable(Connection::ChannelType type) -> bool
+		{
+			return type == Connection::ChannelType::ReliableOrdered || type == Connection::ChannelType::ReliableUnordered;
+		}
+		/// @brief 비신뢰성 메시지가 보내지지 못하고 대기할 수 있는 시간
+		constexpr double UNRELIABLE_EXPIRE_TIME = 1.0;
+		/// @brief 비신뢰성 메시지의 조각이 모이길 기다리는 시간
+		constexpr double UNRELIABLE_REASSEMBLY_TIME = 2.0;
+		/// @brief 받은 데이터그램에 대한 ack만 보내는 최소 간격
+		constexpr double ACK_INTERVAL = 0.01;
+		/// @brief ack 비트필드(32)를 넘기 전에 ack를 보내도록, 이 수 만큼 받으면 간격과 상관없이 바로 보낸다.
+		constexpr uint32_t ACK_IMMEDIATE_COUNT = 16;
+		/// @brief Update() 한 번에 보내는 최대 데이터그램 수.
+		/// @brief 상대의 ack 비트필드(32)보다 많이 몰아 보내면 ack를 받지 못한 데이터그램이 생겨 불필요한 재전송이 일어난다.
+		constexpr uint32_t MAX_DATAGRAMS_PER_UPDATE = 16;
+	}//namespace
+
+	SH_NET_API Connection::Connection() :
+		Connection(Config{})
+	{
+	}
+	SH_NET_API Connection::Connection(const Config& config) :
+		config(config)
+	{
+		assert(config.channels.size() <= 127);
+		this->config.maxReliableInFlight = std::min(config.maxReliableInFlight, RECEIVE_WINDOW / 2);
+		// 헤더보다 작으면 조각 크기 계산이 음수가 되어 감싸지므로 최소 크기로 맞춘다.
+		this->config.maxDatagramSize = std::max(config.maxDatagramSize, MIN_DATAGRAM_SIZE);
+		this->config.fragmentSize = std::clamp(config.fragmentSize, 1u, this->config.maxDatagramSize - HEADER_SIZE - BLOCK_HEADER_MAX_SIZE);
+		this->config.maxMessageSize = std::min(config.maxMessageSize, this->config.fragmentSize * 0xffffu);
+
+		channels.resize(config.channels.size());
+		for (std::size_t i = 0; i < channels.size(); ++i)
+		{
+			Channel& channel = channels[i];
+			channel.type = config.channels[i];
+			if (channel.type == ChannelType::ReliableOrdered)
+				channel.orderedBuffer.resize(RECEIVE_WINDOW);
+			if (IsReliable(channel.type))
+				channel.receivedIds.assign(RECEIVE_WINDOW, INVALID_ID);
+		}
+		sentDatagrams.resize(SENT_BUFFER_SIZE);
+		scratch.resize(this->config.maxDatagramSize);
+		sendRate = std::clamp(config.initialSendRate, config.minSendRate, config.maxSendRate);
+	}
+	SH_NET_API Connection::~Connection() = default;
+
+	SH_NET_API auto Connection::Send(uint8_t channelIdx, const uint8_t* data, std::size_t size) -> bool
+	{
+		if (channelIdx >= channels.size() || size > config.maxMessageSize)
+			return false;
+
+		Channel& channel = channels[channelIdx];
+		if (IsReliable(channel.type) && channel.sendQueue.size() >= config.maxReliableInFlight)
+			return false;
+
+		OutMessage msg{};
+		msg.messageId = channel.nextSendId++;
+		msg.data = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+		msg.fragmentCount = static_cast<uint16_t>(std::max<std::size_t>(1, (size + config.fragmentSize - 1) / config.fragmentSize));
+		msg.lastSendTimes.assign(msg.fragmentCount, -1.0);
+		msg.acked.assign(msg.fragmentCount, false);
+		msg.expireTime = -1.0;
+		channel.sendQueue.push_back(std::move(msg));
+		return true;
+	}
+	SH_NET_API auto Connection::Send(uint8_t channelIdx, const Packet& packet) -> bool
+	{
+		std::vector<uint8_t> data;
+		if (!PacketCodec::EncodeAny(packet, data))
+			return false;
+		return Send(channelIdx, data.data(), data.size());
+	}
+	SH_NET_API void Connection::Receive(const uint8_t* data, std::size_t size, double now)
+	{
+		stats.receivedBytes += size;
+
+		BitReader reader{ data, size };
+		const uint16_t sequence = static_cast<uint16_t>(reader.ReadBits(16));
+		const bool bHasAck = reader.ReadBits(8) != 0;
+		const uint16_t ack = static_cast<uint16_t>(reader.ReadBits(16));
+		const uint32_t ackBits = reader.ReadBits(32);
+		if (reader.IsOverflow())
+		{
+			++stats.droppedDatagrams;
+			return;
+		}
+		if (bHasAck)
+			ProcessAck(ack, ackBits, now);
+
+		// 중복되거나 ack 범위를 벗어난 데이터그램은 버린다. 신뢰성 메시지는 상대가 다시 보낸다.
+		if (!bReceivedAny)
+		{
+			remoteSequence = sequence;
+			remoteAckBits = 0;
+			bReceivedAny = true;
+		}
+		else if (SequenceGreater(sequence, remoteSequence))
+		{
+			const uint32_t diff = static_cast<uint16_t>(sequence - remoteSequence);
+			if (diff < 32)
+				remoteAckBits = (remoteAckBits << diff) | (1u << (diff - 1));
+			else if (diff == 32)
+				remoteAckBits = 1u << 31;
+			else
+				remoteAckBits = 0;
+			remoteSequence = sequence;
+		}
+		else
+		{
+			const uint32_t diff = static_cast<uint16_t>(remoteSequence - sequence);
+			const uint32_t bit = diff >= 1 && diff <= 32 ? (1u << (diff - 1)) : 0;
+			if (bit == 0 || (remoteAckBits & bit) != 0)
+			{
+				++stats.droppedDatagrams;
+				return;
+			}
+			remoteAckBits |= bit;
+		}
+		++stats.receivedDatagrams;
+		lastReceiveTime = now;
+		bAckPending = true;
+		++unackedReceiveCount;
+
+		while (reader.GetBytesRead() < size)
+		{
+			uint8_t channelByte = 0;
+			uint32_t messageId = 0;
+			uint32_t fragmentIndex = 0;
+			uint32_t fragmentCount = 1;
+			uint32_t length = 0;
+			reader.Byte(channelByte);
+			reader.Bits(messageId, 16);
+			const bool bFragment = (channelByte & 0x80) != 0;
+			const uint8_t channelIdx = channelByte & 0x7f;
+			if (bFragment)
+			{
+				reader.Varint(fragmentIndex);
+				reader.Varint(fragmentCount);
+			}
+			reader.Varint(length);
+			const uint8_t* payload = reader.ReadBytes(length);
+			if (reader.IsOverflow() || channelIdx >= channels.size())
+			{
+				++stats.droppedDatagrams;
+				return;
+			}
+
+			if (!bFragment)
+			{
+				OnMessageReceived(channelIdx, static_cast<uint16_t>(messageId), std::vector<uint8_t>(payload, payload + length));
+				continue;
+			}
+
+			const bool bLast = fragmentIndex + 1 == fragmentCount;
+			if (fragmentCount < 2 || fragmentCount > 0xffff || fragmentIndex >= fragmentCount ||
+				static_cast<uint64_t>(fragmentCount - 1) * config.fragmentSize >= config.maxMessageSize ||
+				(bLast ? length > config.fragmentSize : length != config.fragmentSize))
+			{
+				++stats.droppedDatagrams;
+				return;
+			}
+			Channel& channel = channels[channelIdx];
+			const uint16_t id = static_cast<uint16_t>(messageId);
+			if (IsDuplicate(channel, id) || !IsInReceiveWindow(channel, id))
+				continue;
+
+			auto it = channel.reassemblies.find(id);
+			if (it == channel.reassemblies.end())
+			{
+				// 완성되지 않는 조각들이 메모리를 차지하지 않도록 동시에 재조립하는 메시지 수를 제한한다.
+				if (reassemblyCount >= config.maxReassemblies)
+					continue;
+				it = channel.reassemblies.emplace(id, Reassembly{}).first;
+				it->second.fragmentCount = static_cast<uint16_t>(fragmentCount);
+				it->second.received.assign(fragmentCount, false);
+				it->second.lastTime = now;
+				++reassemblyCount;
+			}
+			Reassembly& reassembly = it->second;
+			if (reassembly.fragmentCount != fragmentCount || reassembly.received[fragmentIndex])
+				continue;
+
+			// 전체 크기를 미리 잡지 않고 도착한 조각이 들어갈 만큼만 늘린다.
+			const std::size_t offset = static_cast<std::size_t>(fragmentIndex) * config.fragmentSize;
+			if (offset + length > reassembly.data.size())
+			{
+				const std::size_t growth = offset + length - reassembly.data.size();
+				if (reassemblyBytes + growth > config.maxReassemblyBytes)
+					continue;
+				reassembly.data.resize(offset + length);
+				reassemblyBytes += growth;
+			}
+			std::copy(payload, payload + length, reassembly.data.begin() + offset);
+			reassembly.received[fragmentIndex] = true;
+			++reassembly.receivedCount;
+			reassembly.lastTime = now;
+			if (bLast)
+				reassembly.size = static_cast<uint32_t>(offset + length);
+
+			if (reassembly.receivedCount == reassembly.fragmentCount)
+			{
+				const uint32_t messageSize = reassembly.size;
+				std::vector<uint8_t> message = RemoveReassembly(channel, it);
+				message.resize(messageSize);
+				OnMessageReceived(channelIdx, id, std::move(message));
+			}
+		}
+	}
+	SH_NET_API void Connection::Update(double now, const SendFunction& send)
+	{
+		if (lastUpdateTime < 0.0)
+		{
+			lastUpdateTime = now;
+			lastRateUpdateTime = now;
+			if (lastReceiveTime < 0.0)
+				lastReceiveTime = now;
+		}
+		const double burst = std::max<double>(sendRate * 0.02, config.maxDatagramSize * 4.0);
+		tokens = std::min(tokens + sendRate * (now - lastUpdateTime), burst);
+		lastUpdateTime = now;
+
+		for (Channel& channel : channels)
+		{
+			if (!IsReliable(channel.type))
+			{
+				for (OutMessage& msg : channel.sendQueue)
+				{
+					if (msg.expireTime < 0.0)
+						msg.expireTime = now + UNRELIABLE_EXPIRE_TIME;
+				}
+				while (!channel.sendQueue.empty() && channel.sendQueue.front().expireTime <= now)
+					channel.sendQueue.pop_front();
+			}
+			// 완성되지 못한 조각들은 일정 시간 뒤 버린다. 신뢰성 메시지는 다시 오므로 연결이 끊길 시간까지 기다린다.
+			const double reassemblyTime = IsReliable(channel.type) ? config.timeout : UNRELIABLE_REASSEMBLY_TIME;
+			for (auto it = channel.reassemblies.begin(); it != channel.reassemblies.end();)
+			{
+				if (now - it->second.lastTime > reassemblyTime)
+				{
+					auto next = std::next(it);
+					RemoveReassembly(channel, it);
+					it = next;
+				}
+				else
+					++it;
+			}
+		}
+
+		UpdateLoss(now);
+		UpdateSendRate(now);
+
+		uint32_t sentCount = 0;
+		while (tokens > 0.0 && sentCount < MAX_DATAGRAMS_PER_UPDATE)
+		{
+			if (!WriteDatagram(now, false, send))
+				break;
+			++sentCount;
+		}
+		const bool bSent = sentCount > 0;
+		if (tokens <= 0.0 && HasPendingData())
+			bRateLimited = true;
+
+		// 보낼 메시지가 없어도 ack와 RTT 측정을 위해 주기적으로 보낸다.
+		if (!bSent)
+		{
+			const double sinceLastSend = lastSendTime < 0.0 ? config.keepAliveInterval : now - lastSendTime;
+			if ((bAckPending && (sinceLastSend >= ACK_INTERVAL || unackedReceiveCount >= ACK_IMMEDIATE_COUNT)) ||
+				sinceLastSend >= config.keepAliveInterval)
+				WriteDatagram(now, true, send);
+		}
+	}
+	SH_NET_API auto Connection::PollMessages(std::vector<ReceivedMessage>& out) -> std::size_t
+	{
+		const std::size_t count = delivered.size();
+		if (count == 0)
+			return 0;
+		if (out.empty())
+			out.swap(delivered);
+		else
+		{
+			out.insert(out.end(), std::make_move_iterator(delivered.begin()), std::make_move_iterator(delivered.end()));
+			delivered.clear();
+		}
+		return count;
+	}
+	SH_NET_API auto Connection::IsTimedOut(double now) const -> bool
+	{
+		return lastReceiveTime >= 0.0 && now - lastReceiveTime > config.timeout;
+	}
+	SH_NET_API auto Connection::HasPendingData() const -> bool
+	{
+		for (const Channel& channel : channels)
+		{
+			if (!channel.sendQueue.empty())
+				return true;
+		}
+		return false;
+	}
+	void Connection::ProcessAck(uint16_t ack, uint32_t ackBits, double now)
+	{
+		for (uint32_t i = 0; i <= 32; ++i)
+		{
+			if (i > 0 && (ackBits & (1u << (i - 1))) == 0)
+				continue;
+			const uint16_t sequence = static_cast<uint16_t>(ack - i);
+			SentDatagram& datagram = sentDatagrams[sequence % SENT_BUFFER_SIZE];
+			if (datagram.bValid && datagram.sequence == sequence && !datagram.bAcked)
+				OnDatagramAcked(datagram, now);
+		}
+	}
+	void Connection::OnDatagramAcked(SentDatagram& datagram, double now)
+	{
+		datagram.bAcked = true;
+
+		const double sample = std::max(0.0, now - datagram.sendTime);
+		if (rtt == 0.0)
+		{
+			rtt = sample;
+			rttVar = sample * 0.5;
+			minRtt = sample;
+		}
+		else
+		{
+			rttVar = 0.75 * rttVar + 0.25 * std::abs(sample - rtt);
+			rtt = 0.875 * rtt + 0.125 * sample;
+			minRtt = std::min(minRtt, sample);
+		}
+
+		for (const FragmentRef& ref : datagram.fragments)
+		{
+			Channel& channel = channels[ref.channel];
+			if (!IsReliable(channel.type) || channel.sendQueue.empty())
+				continue;
+			// 신뢰성 채널의 대기열은 id가 연속이므로 바로 찾을 수 있다.
+			const uint16_t idx = static_cast<uint16_t>(ref.messageId - channel.sendQueue.front().messageId);
+			if (idx >= channel.sendQueue.size())
+				continue;
+			OutMessage& msg = channel.sendQueue[idx];
+			if (msg.messageId != ref.messageId || msg.acked[ref.fragmentIndex])
+				continue;
+			msg.acked[ref.fragmentIndex] = true;
+			++msg.ackedCount;
+		}
+		for (Channel& channel : channels)
+		{
+			if (!IsReliable(channel.type))
+				continue;
+			while (!channel.sendQueue.empty() && channel.sendQueue.front().ackedCount == channel.sendQueue.front().fragmentCount)
+				channel.sendQueue.pop_front();
+		}
+	}
+	void Connection::OnMessageReceived(uint8_t channelIdx, uint16_t messageId, std::vector<uint8_t>&& data)
+	{
+		Channel& channel = channels[channelIdx];
+		if (IsDuplicate(channel, messageId))
+			return;
+
+		switch (channel.type)
+		{
+		case ChannelType::Unreliable:
+			break;
+		case ChannelType::UnreliableSequenced:
+			channel.lastDeliveredId = messageId;
+			channel.bDeliveredAny = true;
+			break;
+		case ChannelType::ReliableUnordered:
+			if (!IsInReceiveWindow(channel, messageId))
+				return;
+			channel.receivedIds[messageId % RECEIVE_WINDOW] = messageId;
+			// 받을 수 있는 범위의 시작을 아직 받지 못한 id로 옮긴다.
+			while (channel.receivedIds[channel.nextDeliverId % RECEIVE_WINDOW] == channel.nextDeliverId)
+				++channel.nextDeliverId;
+			break;
+		case ChannelType::ReliableOrdered:
+		{
+			if (!IsInReceiveWindow(channel, messageId))
+				return;
+			channel.orderedBuffer[messageId % RECEIVE_WINDOW] = std::move(data);
+			channel.receivedIds[messageId % RECEIVE_WINDOW] = messageId;
+			// 순서가 이어지는 메시지들을 전달한다.
+			while (channel.receivedIds[channel.nextDeliverId % RECEIVE_WINDOW] == channel.nextDeliverId)
+			{
+				const uint32_t slot = channel.nextDeliverId % RECEIVE_WINDOW;
+				delivered.push_back(ReceivedMessage{ channelIdx, std::move(channel.orderedBuffer[slot]) });
+				channel.orderedBuffer[slot] = std::vector<uint8_t>{};
+				channel.receivedIds[slot] = INVALID_ID;
+				++channel.nextDeliverId;
+				++stats.deliveredMessages;
+			}
+			return;
+		}
+		}
+		delivered.push_back(ReceivedMessage{ channelIdx, std::move(data) });
+		++stats.deliveredMessages;
+	}
+	auto Connection::IsDuplicate(const Channel& channel, uint16_t messageId) const -> bool
+	{
+		switch (channel.type)
+		{
+		case ChannelType::Unreliable:
+			return false;
+		case ChannelType::UnreliableSequenced:
+			return channel.bDeliveredAny && !SequenceGreater(messageId, channel.lastDeliveredId);
+		case ChannelType::ReliableUnordered:
+		case ChannelType::ReliableOrdered:
+			return SequenceGreater(channel.nextDeliverId, messageId) || channel.receivedIds[messageId % RECEIVE_WINDOW] == messageId;
+		}
+		return false;
+	}
+	auto Connection::IsInReceiveWindow(const Channel& channel, uint16_t messageId) const -> bool
+	{
+		// 상대는 응답을 기다리는 메시지를 RECEIVE_WINDOW / 2개 까지만 보내므로 범위 밖의 id는 잘못된 데이터다.
+		return !IsReliable(channel.type) || static_cast<uint16_t>(messageId - channel.nextDeliverId) < RECEIVE_WINDOW;
+	}
+	auto Connection::RemoveReassembly(Channel& channel, std::unordered_map<uint16_t, Reassembly>::iterator it) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> data = std::move(it->second.data);
+		reassemblyBytes -= data.size();
+		--reassemblyCount;
+		channel.reassemblies.erase(it);
+		return data;
+	}
+	void Connection::UpdateLoss(double now)
+	{
+		// 응답을 기다릴 만큼 기다린 데이터그램부터 순서대로 손실 여부를 판단한다.
+		const double lossTimeout = std::max(GetResendTimeout() * 2.0, 0.1);
+		while (lossCheckSequence != nextSequence)
+		{
+			const SentDatagram& datagram = sentDatagrams[lossCheckSequence % SENT_BUFFER_SIZE];
+			if (datagram.bValid && datagram.sequence == lossCheckSequence)
+			{
+				if (!datagram.bAcked && now - datagram.sendTime < lossTimeout)
+					break;
+				const float sample = datagram.bAcked ? 0.f : 1.f;
+				packetLoss += (sample - packetLoss) * 0.05f;
+			}
+			++lossCheckSequence;
+		}
+	}
+	void Connection::UpdateSendRate(double now)
+	{
+		const double interval = std::max(rtt, 0.05);
+		if (now - lastRateUpdateTime < interval)
+			return;
+		lastRateUpdateTime = now;
+
+		// 대기 지연으로 RTT가 늘어나거나 손실이 크면 줄이고, 속도 제한에 걸렸었다면 늘린다.
+		const bool bCongested = (rtt > 0.0 && rtt > minRtt * 1.5 + 0.01) || packetLoss > 0.25f;
+		if (bCongested)
+			sendRate *= 0.8f;
+		else if (bRateLimited)
+			sendRate *= 1.1f;
+		sendRate = std::clamp(sendRate, config.minSendRate, config.maxSendRate);
+		bRateLimited = false;
+	}
+	auto Connection::WriteDatagram(double now, bool bForce, const SendFunction& send) -> bool
+	{
+		const uint16_t sequence = nextSequence;
+		SentDatagram& datagram = sentDatagrams[sequence % SENT_BUFFER_SIZE];
+		datagram.fragments.clear();
+
+		BitWriter writer{ scratch.data(), config.maxDatagramSize };
+		writer.WriteBits(sequence, 16);
+		// 아직 받은 데이터그램이 없다면 ack 필드는 의미가 없다.
+		writer.WriteBits(bReceivedAny ? 1 : 0, 8);
+		writer.WriteBits(remoteSequence, 16);
+		writer.WriteBits(remoteAckBits, 32);
+
+		const double resendTimeout = GetResendTimeout();
+		bool bFull = false;
+		bool bWroteBlock = false;
+
+		auto writeFragment =
+			[&](uint8_t channelIdx, OutMessage& msg, uint16_t fragmentIndex) -> bool
+			{
+				const std::size_t offset = static_cast<std::size_t>(fragmentIndex) * config.fragmentSize;
+				const uint32_t length = static_cast<uint32_t>(std::min<std::size_t>(config.fragmentSize, msg.data->size() - offset));
+				if (writer.GetBytesWritten() + BLOCK_HEADER_MAX_SIZE + length > config.maxDatagramSize)
+				{
+					bFull = true;
+					return false;
+				}
+				const bool bFragment = msg.fragmentCount > 1;
+				writer.WriteBits(channelIdx | (bFragment ? 0x80 : 0), 8);
+				writer.WriteBits(msg.messageId, 16);
+				if (bFragment)
+				{
+					uint32_t idx = fragmentIndex;
+					uint32_t count = msg.fragmentCount;
+					writer.Varint(idx);
+					writer.Varint(count);
+				}
+				uint32_t len = length;
+				writer.Varint(len);
+				writer.WriteBytes(msg.data->data() + offset, length);
+				bWroteBlock = true;
+				return true;
+			};
+
+		// 오래된 신뢰성 메시지(재전송 포함)가 먼저, 비신뢰성 메시지는 남는 공간에 넣는다.
+		for (std::size_t channelIdx = 0; channelIdx < channels.size() && !bFull; ++channelIdx)
+		{
+			Channel& channel = channels[channelIdx];
+			if (!IsReliable(channel.type))
+				continue;
+			for (OutMessage& msg : channel.sendQueue)
+			{
+				for (uint16_t fragmentIndex = 0; fragmentIndex < msg.fragmentCount; ++fragmentIndex)
+				{
+					if (msg.acked[fragmentIndex])
+						continue;
+					const double lastTime = msg.lastSendTimes[fragmentIndex];
+					if (lastTime >= 0.0 && now - lastTime < resendTimeout)
+						continue;
+					if (!writeFragment(static_cast<uint8_t>(channelIdx), msg, fragmentIndex))
+						break;
+					if (lastTime >= 0.0)
+						++stats.resentFragments;
+					msg.lastSendTimes[fragmentIndex] = now;
+					datagram.fragments.push_back(FragmentRef{ static_cast<uint8_t>(channelIdx), msg.messageId, fragmentIndex });
+				}
+				if (bFull)
+					break;
+			}
+		}
+		for (std::size_t channelIdx = 0; channelIdx < channels.size() && !bFull; ++channelIdx)
+		{
+			Channel& channel = channels[channelIdx];
+			if (IsReliable(channel.type))
+				continue;
+			while (!channel.sendQueue.empty())
+			{
+				OutMessage& msg = channel.sendQueue.front();
+				for (uint16_t fragmentIndex = 0; fragmentIndex < msg.fragmentCount; ++fragmentIndex)
+				{
+					if (msg.lastSendTimes[fragmentIndex] >= 0.0)
+						continue;
+					if (!writeFragment(static_cast<uint8_t>(channelIdx), msg, fragmentIndex))
+						break;
+					msg.lastSendTimes[fragmentIndex] = now;
+					// 비신뢰성 메시지는 ackedCount를 보낸 조각 수로 쓴다.
+					++msg.ackedCount;
+				}
+				if (msg.ackedCount < msg.fragmentCount)
+					break;
+				channel.sendQueue.pop_front();
+			}
+		}
+
+		if (!bWroteBlock && !bForce)
+			return false;
+
+		const std::size_t size = writer.Flush();
+		send(scratch.data(), size);
+
+		datagram.sequence = sequence;
+		datagram.bValid = true;
+		datagram.bAcked = false;
+		datagram.sendTime = now;
+		++nextSequence;
+
+		tokens -= static_cast<double>(size);
+		lastSendTime = now;
+		bAckPending = false;
+		unackedReceiveCount = 0;
+		++stats.sentDatagrams;
+		stats.sentBytes += size;
+		return true;
+	}
+	auto Connection::GetResendTimeout() const -> double
+	{
+		if (rtt == 0.0)
+			return 0.2;
+		// 편차가 거의 없는 경로에서도 ack 지연 때문에 성급히 재전송하지 않도록 RTT에 여유를 둔다.
+		return std::clamp(rtt * 1.25 + 4.0 * rttVar, 0.03, 1.0);
+	}
+}//namespace
@@ -0,0 +1,106 @@
+﻿#include "ConnectionHost.h"
+#include "UdpSocket.h"
+#include "PacketCodec.h"
+
+#include "Core/Logger.h"
+namespace sh::network
+{
+	SH_NET_API ConnectionHost::ConnectionHost(UdpSocket& socket) :
+		ConnectionHost(socket, Connection::Config{})
+	{
+	}
+	SH_NET_API ConnectionHost::ConnectionHost(UdpSocket& socket, const Connection::Config& config) :
+		socket(socket), config(config)
+	{
+	}
+	SH_NET_API ConnectionHost::~ConnectionHost() = default;
+
+	SH_NET_API auto ConnectionHost::Connect(const Endpoint& endpoint) -> Connection&
+	{
+		auto it = connections.find(endpoint);
+		if (it == connections.end())
+			it = connections.emplace(endpoint, std::make_unique<Connection>(config)).first;
+		return *it->second;
+	}
+	SH_NET_API void ConnectionHost::Disconnect(const Endpoint& endpoint)
+	{
+		connections.erase(endpoint);
+	}
+	SH_NET_API auto ConnectionHost::GetConnection(const Endpoint& endpoint) -> Connection*
+	{
+		auto it = connections.find(endpoint);
+		if (it == connections.end())
+			return nullptr;
+		return it->second.get();
+	}
+	SH_NET_API auto ConnectionHost::GetConnectionCount() const -> std::size_t
+	{
+		return connections.size();
+	}
+	SH_NET_API void ConnectionHost::SetAcceptIncoming(bool bAccept)
+	{
+		bAcceptIncoming = bAccept;
+	}
+	SH_NET_API void ConnectionHost::SetMaxConnections(std::size_t count)
+	{
+		maxConnections = count;
+	}
+	SH_NET_API auto ConnectionHost::HandleMessage(const NetworkContext::Message& message, double now) -> bool
+	{
+		if (message.packet == nullptr || message.packet->GetId() != ConnectionPacket::ID)
+			return false;
+
+		const auto& packet = static_cast<const ConnectionPacket&>(*message.packet);
+		Connection* connection = GetConnection(message.sender);
+		if (connection == nullptr)
+		{
+			// 주소만 바꿔 보내는 데이터그램으로 연결이 끝없이 만들어지지 않도록 수를 제한한다.
+			if (!bAcceptIncoming || connections.size() >= maxConnections)
+				return true;
+			connection = &Connect(message.sender);
+		}
+		const auto& payload = packet.GetPayload();
+		connection->Receive(payload.data(), payload.size(), now);
+		return true;
+	}
+	SH_NET_API void ConnectionHost::Update(double now)
+	{
+		for (auto it = connections.begin(); it != connections.end();)
+		{
+			if (it->second->IsTimedOut(now))
+			{
+				SH_INFO_FORMAT("Connection timed out: {}:{}", it->first.GetIp(), it->first.GetPort());
+				it = connections.erase(it);
+				continue;
+			}
+			const Endpoint& endpoint = it->first;
+			it->second->Update(now,
+				[&](const uint8_t* data, std::size_t size)
+				{
+					sendPacket.SetPayload(data, size);
+					socket.Enqueue(sendPacket, endpoint);
+				}
+			);
+			++it;
+		}
+		socket.Flush();
+	}
+	SH_NET_API auto ConnectionHost::PollPackets(std::vector<ChannelPacket>& out) -> std::size_t
+	{
+		std::size_t count = 0;
+		for (auto& [endpoint, connection] : connections)
+		{
+			receivedScratch.clear();
+			connection->PollMessages(receivedScratch);
+			for (auto& msg : receivedScratch)
+			{
+				auto packet = PacketCodec::DecodeAny(msg.data.data(), msg.data.size());
+				if (packet == nullptr)
+					continue;
+				out.push_back(ChannelPacket{ endpoint, msg.channel, std::move(packet) });
+				++count;
+			}
+		}
+		return count;
+	}
+}//namespace
@@ -0,0 +1,32 @@
+﻿#include "ConnectionPacket.h"
+
+namespace sh::network
+{
+	SH_NET_API auto ConnectionPacket::GetId() const -> uint32_t
+	{
+		return ID;
+	}
+	SH_NET_API auto ConnectionPacket::Serialize() const -> core::Json
+	{
+		core::Json mainJson = Packet::Serialize();
+		mainJson["payload"] = core::Json::binary(payload);
+		return mainJson;
+	}
+	SH_NET_API void ConnectionPacket::Deserialize(const core::Json& json)
+	{
+		Packet::Deserialize(json);
+		if (json.contains("payload") && json["payload"].is_binary())
+		{
+			const auto& binary = json["payload"].get_binary();
+			payload.assign(binary.begin(), binary.end());
+		}
+	}
+	SH_NET_API void ConnectionPacket::SetPayload(const uint8_t* data, std::size_t size)
+	{
+		payload.assign(data, data + size);
+	}
+	SH_NET_API auto ConnectionPacket::GetPayload() const -> const std::vector<uint8_t>&
+	{
+		return payload;
+	}
+}//namespace
@@ -0,0 +1,41 @@
+﻿#include "Endpoint.h"
+
+#include <asio.hpp>
+
+namespace sh::network
+{
+	SH_NET_API auto Endpoint::FromString(const std::string& ip, uint16_t port) -> Endpoint
+	{
+		Endpoint ep{};
+		ep.port = port;
+
+		asio::error_code ec;
+		const asio::ip::address address = asio::ip::make_address(ip, ec);
+		if (ec)
+			return ep;
+		if (address.is_v4())
+		{
+			const auto bytes = address.to_v4().to_bytes();
+			std::memcpy(ep.address.data(), bytes.data(), bytes.size());
+		}
+		else
+		{
+			const auto bytes = address.to_v6().to_bytes();
+			std::memcpy(ep.address.data(), bytes.data(), bytes.size());
+			ep.bV6 = true;
+		}
+		return ep;
+	}
+	SH_NET_API auto Endpoint::GetIp() const -> std::string
+	{
+		if (bV6)
+		{
+			asio::ip::address_v6::bytes_type bytes;
+			std::memcpy(bytes.data(), address.data(), bytes.size());
+			return asio::ip::address_v6{ bytes }.to_string();
+		}
+		asio::ip::address_v4::bytes_type bytes;
+		std::memcpy(bytes.data(), address.data(), bytes.size());
+		return asio::ip::address_v4{ bytes }.to_string();
+	}
+}//namespace
@@ -0,0 +1,256 @@
+﻿#include "MessageBatcher.h"
+#include "PacketCodec.h"
+
+#include "Core/Logger.h"
+
+#include "../External/lz4/lz4.h"
+
+#include <cstring>
+#include <algorithm>
+namespace sh::network
+{
+	namespace
+	{
+		/// @brief 7비트씩 나눠 기록하는 varint (LEB128)
+		inline auto VarintSize(uint32_t value) -> uint32_t
+		{
+			uint32_t size = 1;
+			while (value >= 0x80)
+			{
+				value >>= 7;
+				++size;
+			}
+			return size;
+		}
+		inline void WriteVarint(std::vector<uint8_t>& out, uint32_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(value));
+		}
+		/// @return 잘못된 값이면 false
+		inline auto ReadVarint(const uint8_t*& ptr, const uint8_t* end, uint32_t& value) -> bool
+		{
+			value = 0;
+			for (uint32_t shift = 0; shift < 35; shift += 7)
+			{
+				if (ptr == end)
+					return false;
+				const uint8_t byte = *ptr++;
+				value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+		/// @brief 압축된 데이터 뒤에 blockSize 바이트를 더 붙여 압축했을 때 늘어날 수 있는 최대 크기 (LZ4_COMPRESSBOUND 기준)
+		inline auto CompressedGrowth(uint32_t blockSize) -> uint32_t
+		{
+			return blockSize + blockSize / 255 + 1;
+		}
+		/// @brief 블록 끝 처리와 원본 크기 varint가 늘어날 수 있는 만큼의 여유
+		constexpr uint32_t COMPRESS_MARGIN = 16;
+	}//namespace
+
+	SH_NET_API MessageBatcher::MessageBatcher() :
+		MessageBatcher(Config{})
+	{
+	}
+	SH_NET_API MessageBatcher::MessageBatcher(const Config& config) :
+		config(config)
+	{
+	}
+	SH_NET_API auto MessageBatcher::Add(const Endpoint& peer, const uint8_t* data, std::size_t size) -> bool
+	{
+		const std::size_t blockSize = VarintSize(static_cast<uint32_t>(size)) + size;
+		if (size == 0 || HEADER_SIZE + blockSize > config.maxDatagramSize)
+		{
+			SH_ERROR_FORMAT("Invalid message size for batching: {}", size);
+			return false;
+		}
+
+		Peer& p = peers[peer];
+		if (p.count == 0 || !Fits(p, static_cast<uint32_t>(blockSize)))
+		{
+			if (p.count == p.datagrams.size())
+			{
+				p.datagrams.emplace_back();
+				p.datagrams.back().reserve(config.maxDatagramSize);
+			}
+			std::vector<uint8_t>& datagram = p.datagrams[p.count++];
+			datagram.clear();
+			datagram.push_back(PacketCodec::MAGIC0);
+			datagram.push_back(MAGIC_RAW);
+			p.room = config.maxDatagramSize - HEADER_SIZE;
+		}
+		std::vector<uint8_t>& datagram = p.datagrams[p.count - 1];
+		WriteVarint(datagram, static_cast<uint32_t>(size));
+		datagram.insert(datagram.end(), data, data + size);
+		const uint32_t used = config.bCompress ? CompressedGrowth(static_cast<uint32_t>(blockSize)) : static_cast<uint32_t>(blockSize);
+		p.room = p.room > used ? p.room - used : 0;
+
+		++stats.messages;
+		return true;
+	}
+	SH_NET_API auto MessageBatcher::Add(const Endpoint& peer, const Packet& packet) -> bool
+	{
+		if (!PacketCodec::EncodeAny(packet, encodeBuffer))
+		{
+			SH_ERROR_FORMAT("Failed to encode packet (id: {})", packet.GetId());
+			return false;
+		}
+		return Add(peer, encodeBuffer.data(), encodeBuffer.size());
+	}
+	SH_NET_API auto MessageBatcher::Flush(const SendFunction& send) -> std::size_t
+	{
+		std::size_t sent = 0;
+		for (auto& [endpoint, peer] : peers)
+		{
+			for (std::size_t i = 0; i < peer.count; ++i)
+			{
+				const std::vector<uint8_t>& datagram = peer.datagrams[i];
+				const bool bOversized = datagram.size() > config.maxDatagramSize;
+				if (config.bCompress && (bOversized || datagram.size() - HEADER_SIZE >= config.compressThreshold) && Compress(datagram))
+				{
+					++stats.compressedDatagrams;
+					stats.rawBytes += datagram.size();
+					stats.sentBytes += compressBuffer.size();
+					send(endpoint, compressBuffer.data(), compressBuffer.size());
+					++sent;
+				}
+				else if (bOversized)
+					sent += SendSplit(endpoint, datagram, send);
+				else
+				{
+					stats.rawBytes += datagram.size();
+					stats.sentBytes += datagram.size();
+					send(endpoint, datagram.data(), datagram.size());
+					++sent;
+				}
+			}
+			peer.count = 0;
+		}
+		stats.datagrams += sent;
+		return sent;
+	}
+	SH_NET_API void MessageBatcher::RemovePeer(const Endpoint& peer)
+	{
+		peers.erase(peer);
+	}
+	SH_NET_API auto MessageBatcher::IsBatch(const uint8_t* data, std::size_t size) -> bool
+	{
+		return size > HEADER_SIZE && data[0] == PacketCodec::MAGIC0 && (data[1] == MAGIC_RAW || data[1] == MAGIC_LZ4);
+	}
+	SH_NET_API auto MessageBatcher::Unpack(const uint8_t* data, std::size_t size, std::vector<uint8_t>& scratch, const MessageFunction& fn) -> bool
+	{
+		if (!IsBatch(data, size))
+			return false;
+
+		const uint8_t* ptr = data + HEADER_SIZE;
+		const uint8_t* end = data + size;
+		if (data[1] == MAGIC_LZ4)
+		{
+			uint32_t rawSize = 0;
+			if (!ReadVarint(ptr, end, rawSize) || rawSize == 0 || rawSize > MAX_UNPACKED_SIZE)
+				return false;
+			if (scratch.size() < rawSize)
+				scratch.resize(rawSize);
+			const int decompressed = LZ4_decompress_safe(reinterpret_cast<const char*>(ptr), reinterpret_cast<char*>(scratch.data()),
+				static_cast<int>(end - ptr), static_cast<int>(rawSize));
+			if (decompressed != static_cast<int>(rawSize))
+				return false;
+			ptr = scratch.data();
+			end = ptr + rawSize;
+		}
+		while (ptr < end)
+		{
+			uint32_t len = 0;
+			if (!ReadVarint(ptr, end, len) || len == 0 || len > static_cast<std::size_t>(end - ptr))
+				return false;
+			fn(ptr, len);
+			ptr += len;
+		}
+		return true;
+	}
+
+	auto MessageBatcher::Fits(Peer& peer, uint32_t blockSize) -> bool
+	{
+		if (config.bCompress ? CompressedGrowth(blockSize) <= peer.room : blockSize <= peer.room)
+			return true;
+		const std::vector<uint8_t>& datagram = peer.datagrams[peer.count - 1];
+		if (!config.bCompress || datagram.size() - HEADER_SIZE + blockSize > MAX_UNPACKED_SIZE)
+			return false;
+
+		// 지금까지 모은 것을 압축해 보고 남은 자리를 다시 잰다. 압축이 잘 될수록 다시 잴 일이 드물어진다.
+		if (!Compress(datagram))
+		{
+			// 압축이 안 되는 데이터라면 원본 크기로 잰다.
+			peer.room = datagram.size() < config.maxDatagramSize ? config.maxDatagramSize - static_cast<uint32_t>(datagram.size()) : 0;
+			return blockSize <= peer.room;
+		}
+		const uint32_t compressedSize = static_cast<uint32_t>(compressBuffer.size()) + COMPRESS_MARGIN;
+		peer.room = compressedSize < config.maxDatagramSize ? config.maxDatagramSize - compressedSize : 0;
+		return CompressedGrowth(blockSize) <= peer.room;
+	}
+	auto MessageBatcher::Compress(const std::vector<uint8_t>& datagram) -> bool
+	{
+		const uint32_t rawSize = static_cast<uint32_t>(datagram.size() - HEADER_SIZE);
+		const uint32_t prefixSize = HEADER_SIZE + VarintSize(rawSize);
+		// 원본보다 작고 데이터그램에 들어가야 의미가 있으므로 그 이상은 기록하지 않는다.
+		const int capacity = static_cast<int>(std::min<std::size_t>(datagram.size() - 1, config.maxDatagramSize)) - static_cast<int>(prefixSize);
+		if (capacity <= 0)
+			return false;
+
+		compressBuffer.clear();
+		compressBuffer.push_back(PacketCodec::MAGIC0);
+		compressBuffer.push_back(MAGIC_LZ4);
+		WriteVarint(compressBuffer, rawSize);
+		compressBuffer.resize(prefixSize + capacity);
+		const int compressed = LZ4_compress_default(reinterpret_cast<const char*>(datagram.data() + HEADER_SIZE),
+			reinterpret_cast<char*>(compressBuffer.data() + prefixSize), static_cast<int>(rawSize), capacity);
+		if (compressed <= 0)
+			return false;
+		compressBuffer.resize(prefixSize + compressed);
+		return true;
+	}
+	auto MessageBatcher::SendSplit(const Endpoint& peer, const std::vector<uint8_t>& datagram, const SendFunction& send) -> std::size_t
+	{
+		std::size_t sent = 0;
+		const auto sendBuffer =
+			[&]()
+			{
+				stats.rawBytes += compressBuffer.size();
+				stats.sentBytes += compressBuffer.size();
+				send(peer, compressBuffer.data(), compressBuffer.size());
+				++sent;
+			};
+		compressBuffer.clear();
+		const uint8_t* ptr = datagram.data() + HEADER_SIZE;
+		const uint8_t* end = datagram.data() + datagram.size();
+		while (ptr < end)
+		{
+			const uint8_t* block = ptr;
+			uint32_t len = 0;
+			ReadVarint(ptr, end, len);
+			ptr += len;
+			const std::size_t blockSize = ptr - block;
+			if (!compressBuffer.empty() && compressBuffer.size() + blockSize > config.maxDatagramSize)
+			{
+				sendBuffer();
+				compressBuffer.clear();
+			}
+			if (compressBuffer.empty())
+			{
+				compressBuffer.push_back(PacketCodec::MAGIC0);
+				compressBuffer.push_back(MAGIC_RAW);
+			}
+			compressBuffer.insert(compressBuffer.end(), block, ptr);
+		}
+		if (!compressBuffer.empty())
+			sendBuffer();
+		return sent;
+	}
+}//namespace
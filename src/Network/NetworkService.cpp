@@ -0,0 +1,123 @@
+﻿#include "NetworkService.h"
+
+#include "Core/Logger.h"
+
+#include <asio.hpp>
+
+#include <optional>
+#include <algorithm>
+namespace sh::network
+{
+	struct NetworkService::Impl
+	{
+		std::optional<asio::executor_work_guard<asio::io_context::executor_type>> workGuard;
+	};
+
+	SH_NET_API NetworkService::NetworkService() :
+		impl(std::make_unique<Impl>())
+	{
+	}
+	SH_NET_API NetworkService::~NetworkService()
+	{
+		Stop();
+	}
+	SH_NET_API void NetworkService::Start(uint32_t threadCount)
+	{
+		std::lock_guard<std::mutex> lock{ threadMu };
+		if (!threads.empty())
+			return;
+
+		if (threadCount == 0)
+			threadCount = std::clamp(std::thread::hardware_concurrency() / 4, 1u, 2u);
+
+		asio::io_context& ioCtx = *reinterpret_cast<asio::io_context*>(ctx.GetNativeHandle());
+		if (ioCtx.stopped())
+			ioCtx.restart();
+		// 할 일이 없어도 run()이 반환되지 않도록 한다.
+		impl->workGuard.emplace(asio::make_work_guard(ioCtx));
+
+		threads.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back(
+				[this]()
+				{
+					ctx.Update();
+				}
+			);
+		}
+		SH_INFO_FORMAT("Network service started ({} threads)", threadCount);
+	}
+	SH_NET_API void NetworkService::Stop()
+	{
+		std::lock_guard<std::mutex> lock{ threadMu };
+		if (threads.empty())
+			return;
+
+		impl->workGuard.reset();
+		ctx.Stop();
+		for (auto& thread : threads)
+		{
+			if (thread.joinable())
+				thread.join();
+		}
+		threads.clear();
+	}
+	SH_NET_API auto NetworkService::IsRunning() const -> bool
+	{
+		std::lock_guard<std::mutex> lock{ threadMu };
+		return !threads.empty();
+	}
+	SH_NET_API auto NetworkService::GetThreadCount() const -> uint32_t
+	{
+		std::lock_guard<std::mutex> lock{ threadMu };
+		return static_cast<uint32_t>(threads.size());
+	}
+	SH_NET_API auto NetworkService::RegisterReceiver(Receiver&& receiver) -> ReceiverId
+	{
+		const ReceiverId id = nextReceiverId++;
+		if (nextReceiverId == INVALID_RECEIVER)
+			nextReceiverId = 1;
+		receivers.insert_or_assign(id, std::move(receiver));
+		return id;
+	}
+	SH_NET_API void NetworkService::UnregisterReceiver(ReceiverId id)
+	{
+		if (id == INVALID_RECEIVER)
+			return;
+		// 전달 도중에는 실행 중인 수신자가 지워지지 않도록 미룬다.
+		if (bDispatching)
+			pendingUnregister.push_back(id);
+		else
+			receivers.erase(id);
+	}
+	SH_NET_API void NetworkService::Post(ReceiverId id, std::vector<NetworkContext::Message>&& messages)
+	{
+		if (messages.empty())
+			return;
+		deliveries.Push(Delivery{ id, std::move(messages) });
+	}
+	SH_NET_API auto NetworkService::Dispatch() -> std::size_t
+	{
+		std::size_t count = 0;
+		bDispatching = true;
+		deliveries.Drain(
+			[&](Delivery& delivery)
+			{
+				if (std::find(pendingUnregister.begin(), pendingUnregister.end(), delivery.id) != pendingUnregister.end())
+					return;
+				auto it = receivers.find(delivery.id);
+				if (it == receivers.end())
+					return;
+				count += delivery.messages.size();
+				it->second(delivery.messages);
+			}
+		);
+		bDispatching = false;
+
+		for (ReceiverId id : pendingUnregister)
+			receivers.erase(id);
+		pendingUnregister.clear();
+		return count;
+	}
+}//namespace
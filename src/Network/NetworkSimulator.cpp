@@ -0,0 +1,114 @@
+﻿#include "NetworkSimulator.h"
+
+#include <algorithm>
+#include <cstring>
+namespace sh::network
+{
+	SH_NET_API NetworkSimulator::NetworkSimulator() :
+		NetworkSimulator(Settings{})
+	{
+	}
+	SH_NET_API NetworkSimulator::NetworkSimulator(const Settings& settings) :
+		settings(settings), rng(settings.seed)
+	{
+	}
+
+	SH_NET_API void NetworkSimulator::Submit(const uint8_t* data, std::size_t size, double now)
+	{
+		++stats.submitted;
+		// 설정과 상관없이 데이터그램마다 난수를 같은 횟수만큼 뽑아야 설정을 바꿔도 다른 결정이 흔들리지 않는다.
+		const double lossRoll = NextUnit();
+		const double duplicateRoll = NextUnit();
+		const double reorderRoll = NextUnit();
+		const double jitterRoll = NextUnit();
+		const double duplicateJitterRoll = NextUnit();
+
+		double arriveTime = now + settings.latency + jitterRoll * settings.jitter;
+		if (settings.bStream)
+		{
+			arriveTime = std::max(arriveTime, lastArriveTime);
+			lastArriveTime = arriveTime;
+			Push(data, size, arriveTime);
+			return;
+		}
+
+		if (lossRoll < settings.loss)
+		{
+			++stats.dropped;
+			return;
+		}
+		if (reorderRoll < settings.reorder)
+		{
+			// 뒤따르는 데이터그램의 순서 기준은 건드리지 않는다.
+			++stats.reordered;
+			arriveTime += settings.reorderDelay;
+		}
+		else
+		{
+			arriveTime = std::max(arriveTime, lastArriveTime);
+			lastArriveTime = arriveTime;
+		}
+		Push(data, size, arriveTime);
+
+		if (duplicateRoll < settings.duplicate)
+		{
+			++stats.duplicated;
+			Push(data, size, arriveTime + duplicateJitterRoll * settings.jitter);
+		}
+	}
+	SH_NET_API auto NetworkSimulator::Poll(double now, const DeliverFunction& deliver) -> std::size_t
+	{
+		std::size_t count = 0;
+		while (!inFlight.empty() && inFlight.front().arriveTime <= now)
+		{
+			std::pop_heap(inFlight.begin(), inFlight.end(), IsLater);
+			InFlight& datagram = inFlight.back();
+			deliver(datagram.data.data(), datagram.data.size());
+			bufferPool.push_back(std::move(datagram.data));
+			inFlight.pop_back();
+			++count;
+		}
+		stats.delivered += count;
+		return count;
+	}
+	SH_NET_API void NetworkSimulator::Reset()
+	{
+		for (InFlight& datagram : inFlight)
+			bufferPool.push_back(std::move(datagram.data));
+		inFlight.clear();
+		rng.seed(settings.seed);
+		nextOrder = 0;
+		lastArriveTime = 0.0;
+		stats = Stats{};
+	}
+	SH_NET_API auto NetworkSimulator::GetNextArriveTime() const -> double
+	{
+		return inFlight.empty() ? -1.0 : inFlight.front().arriveTime;
+	}
+
+	auto NetworkSimulator::NextUnit() -> double
+	{
+		return static_cast<double>(rng()) / 4294967296.0;
+	}
+	void NetworkSimulator::Push(const uint8_t* data, std::size_t size, double arriveTime)
+	{
+		std::vector<uint8_t> buffer;
+		if (!bufferPool.empty())
+		{
+			buffer = std::move(bufferPool.back());
+			bufferPool.pop_back();
+		}
+		buffer.resize(size);
+		if (size > 0)
+			std::memcpy(buffer.data(), data, size);
+
+		inFlight.push_back(InFlight{ arriveTime, nextOrder++, std::move(buffer) });
+		std::push_heap(inFlight.begin(), inFlight.end(), IsLater);
+	}
+	auto NetworkSimulator::IsLater(const InFlight& a, const InFlight& b) -> bool
+	{
+		if (a.arriveTime != b.arriveTime)
+			return a.arriveTime > b.arriveTime;
+		return a.order > b.order;
+	}
+}//namespace
@@ -0,0 +1,115 @@
+﻿#include "PacketCodec.h"
+
+#include "Core/Logger.h"
+
+namespace sh::network
+{
+	SH_NET_API auto PacketCodec::Encode(const Packet& packet, core::ArrayView<uint8_t> out) -> std::size_t
+	{
+		if (!packet.HasBinaryCodec())
+			return 0;
+
+		BitWriter writer{ out };
+		writer.WriteBits(MAGIC0, 8);
+		writer.WriteBits(MAGIC1, 8);
+		uint32_t id = packet.GetId();
+		writer.Varint(id);
+		packet.Encode(writer);
+
+		const std::size_t size = writer.Flush();
+		if (writer.IsOverflow())
+			return 0;
+		return size;
+	}
+	SH_NET_API auto PacketCodec::IsBinary(const uint8_t* data, std::size_t size) -> bool
+	{
+		return size >= 3 && data[0] == MAGIC0 && data[1] == MAGIC1;
+	}
+	SH_NET_API auto PacketCodec::Decode(const uint8_t* data, std::size_t size) -> std::unique_ptr<Packet>
+	{
+		if (!IsBinary(data, size))
+			return nullptr;
+
+		BitReader reader{ data + 2, size - 2 };
+		uint32_t id = 0;
+		if (!reader.Varint(id))
+			return nullptr;
+
+		static auto factory = Packet::Factory::GetInstance();
+		if (!factory->HasKey(id))
+			return nullptr;
+		auto packet = factory->Create(id);
+		if (packet == nullptr || !packet->HasBinaryCodec())
+			return nullptr;
+
+		packet->Decode(reader);
+		if (reader.IsOverflow())
+			return nullptr;
+		return packet;
+	}
+	SH_NET_API auto PacketCodec::Decode(const uint8_t* data, std::size_t size, Packet& packet) -> bool
+	{
+		if (!IsBinary(data, size))
+			return false;
+
+		BitReader reader{ data + 2, size - 2 };
+		uint32_t id = 0;
+		if (!reader.Varint(id) || id != packet.GetId())
+			return false;
+
+		packet.Decode(reader);
+		return !reader.IsOverflow();
+	}
+	SH_NET_API auto PacketCodec::EncodeAny(const Packet& packet, std::vector<uint8_t>& out) -> bool
+	{
+		if (!packet.HasBinaryCodec())
+		{
+			out = core::Json::to_bson(packet.Serialize());
+			return !out.empty();
+		}
+		std::size_t capacity = Packet::MAX_PACKET_SIZE;
+		while (capacity <= 16 * 1024 * 1024)
+		{
+			out.resize(capacity);
+			const std::size_t size = Encode(packet, { out.data(), out.size() });
+			if (size != 0)
+			{
+				out.resize(size);
+				return true;
+			}
+			capacity *= 4;
+		}
+		out.clear();
+		return false;
+	}
+	SH_NET_API auto PacketCodec::DecodeAny(const uint8_t* data, std::size_t size) -> std::unique_ptr<Packet>
+	{
+		if (IsBinary(data, size))
+		{
+			auto packet = Decode(data, size);
+			if (packet == nullptr)
+				SH_ERROR("Error packet has been received! (Failed to decode)");
+			return packet;
+		}
+		const core::Json json = core::Json::from_bson(data, data + size, true, false);
+		if (json.empty() || json.is_discarded())
+		{
+			SH_ERROR("Error packet has been received! (Failed to parsing)");
+			return nullptr;
+		}
+		if (!json.contains("id"))
+		{
+			SH_ERROR("Error packet has been received! (No ID)");
+			return nullptr;
+		}
+		static auto conatinerFactory = Packet::Factory::GetInstance();
+		auto packet = conatinerFactory->Create(json["id"]);
+		if (packet == nullptr)
+		{
+			SH_ERROR("An unregistered packet has been received!");
+			return nullptr;
+		}
+		packet->Deserialize(json);
+		return packet;
+	}
+}//namespace
@@ -41,6 +41,14 @@ namespace sh::network
 		Accept();
 		return true;
 	}
+	SH_NET_API auto TcpListener::GetLocalPort() const -> uint16_t
+	{
+		if (!impl->acceptor.is_open())
+			return 0;
+		asio::error_code ec;
+		const auto ep = impl->acceptor.local_endpoint(ec);
+		return ec ? 0 : ep.port();
+	}
 	SH_NET_API auto TcpListener::GetJoinedSocket() -> std::optional<TcpSocket>
 	{
 		if (!mu.try_lock())
@@ -1,4 +1,5 @@
 ﻿#include "TcpSocket.h"
+#include "PacketCodec.h"
 
 #include "Core/Logger.h"
 
@@ -6,11 +7,32 @@
 
 #include <asio.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace sh::network
 {
+	namespace
+	{
+		/// @brief 재사용 버퍼 수와 크기 상한. 한 번 크게 보낸 뒤에 메모리를 계속 잡고 있지 않도록 한다.
+		constexpr std::size_t MAX_POOLED_BUFFERS = 256;
+		constexpr std::size_t MAX_POOLED_CAPACITY = 256 * 1024;
+
+		auto ReadHeaderValue(const uint8_t* data) -> uint32_t
+		{
+			return
+				(uint32_t)data[0] |
+				((uint32_t)data[1] << 8) |
+				((uint32_t)data[2] << 16) |
+				((uint32_t)data[3] << 24);
+		}
+	}
+
 	struct TcpSocket::Impl
 	{
 		asio::ip::tcp::socket socket;
+		/// @brief writingFrames의 헤더와 본문을 가리키는 버퍼 목록
+		std::vector<asio::const_buffer> writeBuffers;
 	};
 
 	TcpSocket::TcpSocket(const NetworkContext& ctx)
@@ -24,18 +46,22 @@ namespace sh::network
 			SH_ERROR_FORMAT("open failed: {}", ec.message());
 		else
 			impl = std::make_unique<Impl>(Impl{ std::move(socket) });
-
-		header.fill(0);
 	}
 	TcpSocket::TcpSocket(TcpSocket&& other) noexcept :
 		impl(std::move(other.impl)),
 		ip(std::move(other.ip)),
 		port(other.port),
-		header(other.header),
-		body(std::move(other.body)),
-		sendQueue(std::move(other.sendQueue)),
+		remoteEndpoint(other.remoteEndpoint),
+		recvBuffer(std::move(other.recvBuffer)),
+		recvSize(other.recvSize),
+		pendingFrames(std::move(other.pendingFrames)),
+		writingFrames(std::move(other.writingFrames)),
+		bufferPool(std::move(other.bufferPool)),
+		bWriting(other.bWriting),
 		receivedQueue(std::move(other.receivedQueue))
 	{
+		other.recvSize = 0;
+		other.bWriting = false;
 	}
 	TcpSocket::~TcpSocket()
 	{
@@ -50,17 +76,25 @@ namespace sh::network
 		impl = std::move(other.impl);
 		ip = std::move(other.ip);
 		port = other.port;
-		header = other.header;
-		body = std::move(other.body);
-		sendQueue = std::move(other.sendQueue);
+		remoteEndpoint = other.remoteEndpoint;
+		recvBuffer = std::move(other.recvBuffer);
+		recvSize = other.recvSize;
+		pendingFrames = std::move(other.pendingFrames);
+		writingFrames = std::move(other.writingFrames);
+		bufferPool = std::move(other.bufferPool);
+		bWriting = other.bWriting;
 		receivedQueue = std::move(other.receivedQueue);
 
+		other.recvSize = 0;
+		other.bWriting = false;
+
 		return *this;
 	}
 	SH_NET_API void TcpSocket::Connect(const std::string& ip, uint16_t port)
 	{
 		this->ip = ip;
 		this->port = port;
+		remoteEndpoint = Endpoint::FromString(this->ip, this->port);
 		asio::ip::tcp::endpoint endPoint{ asio::ip::make_address(this->ip), this->port };
 
 		impl->socket.async_connect(endPoint,
@@ -69,51 +103,38 @@ namespace sh::network
 				if (ec)
 					SH_ERROR_FORMAT("Failed to connect: {}", ec.message());
 				else
-					ReadHeader();
+					ReadStart();
 			}
 		);
 	}
 	SH_NET_API void TcpSocket::Send(const Packet& packet)
 	{
-		const std::vector<uint8_t> data(core::Json::to_bson(packet.Serialize()));
-
-		const uint32_t len = static_cast<uint32_t>(data.size());
-
-		std::vector<uint8_t> sendData;
-		// 헤더에 리틀엔디안으로 데이터 길이 기록
-		sendData.resize(4 + data.size());
-		sendData[0] = (len >> 0) & 0xFF;
-		sendData[1] = (len >> 8) & 0xFF;
-		sendData[2] = (len >> 16) & 0xFF;
-		sendData[3] = (len >> 24) & 0xFF;
-		// Body에 데이터 기록
-		std::memcpy(sendData.data() + 4, data.data(), data.size());
+		Frame frame{};
+		if (!MakeFrame(packet, frame))
+			return;
 
 		std::lock_guard<std::mutex> lock{ mu };
-		bool bWasEmpty = sendQueue.empty();
-		sendQueue.push_back(std::move(sendData));
-		if (bWasEmpty)
-			WriteNext();
+		pendingFrames.push_back(std::move(frame));
+		if (bWriting)
+			return;
+		// 바로 쓰지 않고 네트워크 스레드로 넘겨서, 그 사이 들어온 메시지들이 같은 쓰기에 묶이게 한다.
+		bWriting = true;
+		asio::post(impl->socket.get_executor(), [this] { WriteNext(); });
 	}
 	SH_NET_API void TcpSocket::SendBlocking(const Packet& packet)
 	{
-		const std::vector<uint8_t> data(core::Json::to_bson(packet.Serialize()));
+		Frame frame{};
+		if (!MakeFrame(packet, frame))
+			return;
 
-		const uint32_t len = static_cast<uint32_t>(data.size());
-
-		std::vector<uint8_t> sendData;
-		// 헤더에 리틀엔디안으로 데이터 길이 기록
-		sendData.resize(4 + data.size());
-		sendData[0] = (len >> 0) & 0xFF;
-		sendData[1] = (len >> 8) & 0xFF;
-		sendData[2] = (len >> 16) & 0xFF;
-		sendData[3] = (len >> 24) & 0xFF;
-		// Body에 데이터 기록
-		std::memcpy(sendData.data() + 4, data.data(), data.size());
+		const std::array<asio::const_buffer, 2> buffers{ asio::buffer(frame.header), asio::buffer(frame.body) };
 		std::error_code ec;
-		asio::write(impl->socket, asio::buffer(sendData), ec);
+		asio::write(impl->socket, buffers, ec);
 		if (ec)
 			SH_INFO_FORMAT("Send failed: {} ({})", ec.message(), ec.value());
+
+		std::lock_guard<std::mutex> lock{ mu };
+		ReleaseBuffer(std::move(frame.body));
 	}
 	SH_NET_API void TcpSocket::Close()
 	{
@@ -121,7 +142,9 @@ namespace sh::network
 	}
 	SH_NET_API void TcpSocket::ReadStart()
 	{
-		ReadHeader();
+		if (recvBuffer.size() < RECV_BUFFER_SIZE)
+			recvBuffer.resize(RECV_BUFFER_SIZE);
+		Read();
 	}
 	SH_NET_API void TcpSocket::SetReceiveQueue(const std::shared_ptr<MessageQueue>& msgQueue)
 	{
@@ -136,103 +159,200 @@ namespace sh::network
 		auto socketPtr = reinterpret_cast<asio::ip::tcp::socket*>(nativeSocketPtr);
 		ip = socketPtr->remote_endpoint().address().to_string();
 		port = socketPtr->remote_endpoint().port();
+		remoteEndpoint = Endpoint::FromString(ip, port);
 
 		impl = std::make_unique<Impl>(Impl{ std::move(*socketPtr) });
-
-		header.fill(0);
 	}
-	void TcpSocket::WriteNext()
+	auto TcpSocket::MakeFrame(const Packet& packet, Frame& frame) -> bool
 	{
-		asio::async_write(impl->socket, asio::buffer(sendQueue.front()),
-			[this](std::error_code ec, std::size_t)
+		frame.body = AcquireBuffer();
+		std::vector<uint8_t>& body = frame.body;
+
+		uint32_t len = 0;
+		uint32_t flag = 0;
+		if (packet.HasBinaryCodec())
+		{
+			// 크기를 미리 알 수 없으므로 부족하면 늘려가며 다시 기록한다.
+			std::size_t capacity = std::max<std::size_t>(Packet::MAX_PACKET_SIZE, body.capacity());
+			while (len == 0 && capacity <= MAX_BODY_SIZE)
 			{
-				if (ec) 
-				{
-					SH_INFO_FORMAT("Send failed: {} ({})", ec.message(), ec.value());
-					return;
-				}
+				body.resize(capacity);
+				len = static_cast<uint32_t>(PacketCodec::Encode(packet, { body.data(), capacity }));
+				capacity *= 4;
+			}
+			if (len == 0)
+			{
+				SH_ERROR_FORMAT("Failed to encode packet (id: {})", packet.GetId());
 				std::lock_guard<std::mutex> lock{ mu };
-				sendQueue.pop_front();
-				if (!sendQueue.empty())
-					WriteNext();
+				ReleaseBuffer(std::move(body));
+				return false;
 			}
-		);
+			body.resize(len);
+			flag = BINARY_FLAG;
+		}
+		else
+		{
+			// 재사용 버퍼 뒤에 바로 기록한다.
+			core::Json::to_bson(packet.Serialize(), body);
+			// 받는 쪽은 최대 크기를 넘는 프레임을 잘못된 스트림으로 보고 끊으므로 보내지 않는다.
+			if (body.size() > MAX_BODY_SIZE)
+			{
+				SH_ERROR_FORMAT("Packet is too large (id: {}, size: {})", packet.GetId(), body.size());
+				std::lock_guard<std::mutex> lock{ mu };
+				ReleaseBuffer(std::move(body));
+				return false;
+			}
+			len = static_cast<uint32_t>(body.size());
+		}
+		// 헤더에 리틀엔디안으로 데이터 길이 기록
+		const uint32_t headerValue = len | flag;
+		frame.header[0] = (headerValue >> 0) & 0xFF;
+		frame.header[1] = (headerValue >> 8) & 0xFF;
+		frame.header[2] = (headerValue >> 16) & 0xFF;
+		frame.header[3] = (headerValue >> 24) & 0xFF;
+		return true;
 	}
-	void TcpSocket::ReadHeader()
+	auto TcpSocket::AcquireBuffer() -> std::vector<uint8_t>
 	{
-		asio::async_read(impl->socket, asio::buffer(header),
+		std::lock_guard<std::mutex> lock{ mu };
+		if (bufferPool.empty())
+			return {};
+		std::vector<uint8_t> buffer{ std::move(bufferPool.back()) };
+		bufferPool.pop_back();
+		buffer.clear();
+		return buffer;
+	}
+	void TcpSocket::ReleaseBuffer(std::vector<uint8_t>&& buffer)
+	{
+		if (bufferPool.size() >= MAX_POOLED_BUFFERS || buffer.capacity() > MAX_POOLED_CAPACITY)
+			return;
+		bufferPool.push_back(std::move(buffer));
+	}
+	void TcpSocket::WriteNext()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mu };
+			std::swap(writingFrames, pendingFrames);
+		}
+		// writingFrames는 쓰기가 끝날 때 까지 이 스레드만 건드리므로 잠그지 않아도 된다.
+		std::vector<asio::const_buffer>& buffers = impl->writeBuffers;
+		buffers.clear();
+		buffers.reserve(writingFrames.size() * 2);
+		for (const Frame& frame : writingFrames)
+		{
+			buffers.push_back(asio::buffer(frame.header));
+			buffers.push_back(asio::buffer(frame.body));
+		}
+
+		asio::async_write(impl->socket, buffers,
 			[this](std::error_code ec, std::size_t)
 			{
+				std::lock_guard<std::mutex> lock{ mu };
+				for (Frame& frame : writingFrames)
+					ReleaseBuffer(std::move(frame.body));
+				writingFrames.clear();
+
 				if (ec)
 				{
-					SH_INFO_FORMAT("Read hedaer failed: {} ({})", ec.message(), ec.value());
+					SH_INFO_FORMAT("Send failed: {} ({})", ec.message(), ec.value());
+					for (Frame& frame : pendingFrames)
+						ReleaseBuffer(std::move(frame.body));
+					pendingFrames.clear();
+					bWriting = false;
 					return;
 				}
-				const uint32_t len =
-					(uint32_t)header[0] |
-					((uint32_t)header[1] << 8) |
-					((uint32_t)header[2] << 16) |
-					((uint32_t)header[3] << 24);
-
-				constexpr uint32_t kMaxPacket = 1 * 1024 * 1024;
-				if (len == 0 || len > kMaxPacket) 
-				{ 
-					Close(); 
-					return; 
+				if (pendingFrames.empty())
+				{
+					bWriting = false;
+					return;
 				}
-
-				body.resize(len);
-				ReadBody();
+				asio::post(impl->socket.get_executor(), [this] { WriteNext(); });
 			}
 		);
 	}
-	void TcpSocket::ReadBody()
+	void TcpSocket::Read()
 	{
-		asio::async_read(impl->socket, asio::buffer(body),
-			[this](std::error_code ec, std::size_t)
+		impl->socket.async_read_some(asio::buffer(recvBuffer.data() + recvSize, recvBuffer.size() - recvSize),
+			[this](std::error_code ec, std::size_t size)
 			{
 				if (ec)
 				{
-					SH_INFO_FORMAT("Read body failed: {} ({})", ec.message(), ec.value());
+					SH_INFO_FORMAT("Read failed: {} ({})", ec.message(), ec.value());
 					return;
 				}
-				const core::Json json = core::Json::from_bson(body.data(), body.size(), true, true);
-				if (json.contains("id"))
+				recvSize += size;
+				if (!ProcessReceived())
 				{
-					static auto conatinerFactory = Packet::Factory::GetInstance();
-					auto packet = conatinerFactory->Create(json["id"]);
-					if (packet != nullptr)
-					{
-						packet->Deserialize(json);
-						
-						asio::error_code err;
-						auto ep = impl->socket.remote_endpoint(err);
-						if (err)
-						{
-							SH_ERROR_FORMAT("{}", err.message());
-						}
-						else
-						{
-							PacketEvent evt{ packet.get(), ep.address().to_string(), static_cast<uint16_t>(ep.port()) };
-							bus.Publish(evt);
-
-							NetworkContext::Message message{};
-							message.senderIp = ep.address().to_string();
-							message.senderPort = static_cast<uint16_t>(ep.port());
-							message.packet = std::move(packet);
-
-							assert(receivedQueue.get() != nullptr);
-							receivedQueue.get()->Push(std::move(message));
-						}
-					}
-					else
-						SH_ERROR("An unregistered packet has been received!");
+					Close();
+					return;
 				}
-				else
-					SH_ERROR("Error packet has been received! (No ID.)");
-
-				ReadHeader();
+				Read();
 			}
 		);
 	}
-}//namespace
\ No newline at end of file
+	auto TcpSocket::ProcessReceived() -> bool
+	{
+		std::size_t offset = 0;
+		std::size_t required = 0;
+		while (recvSize - offset >= 4)
+		{
+			const uint32_t headerValue = ReadHeaderValue(recvBuffer.data() + offset);
+			const uint32_t len = headerValue & ~BINARY_FLAG;
+			if (len == 0 || len > MAX_BODY_SIZE)
+				return false;
+
+			if (recvSize - offset < 4 + len)
+			{
+				required = 4 + len;
+				break;
+			}
+			OnMessage(recvBuffer.data() + offset + 4, len, (headerValue & BINARY_FLAG) != 0);
+			offset += 4 + len;
+		}
+		// 덜 받은 메시지를 버퍼 앞으로 옮긴다.
+		recvSize -= offset;
+		if (offset > 0 && recvSize > 0)
+			std::memmove(recvBuffer.data(), recvBuffer.data() + offset, recvSize);
+		// 큰 메시지 뒤에 오는 메시지들도 같이 읽을 수 있도록 여유를 둔다.
+		if (required > recvBuffer.size())
+			recvBuffer.resize(required + RECV_BUFFER_SIZE);
+		return true;
+	}
+	void TcpSocket::OnMessage(const uint8_t* data, uint32_t size, bool bBinary)
+	{
+		std::unique_ptr<Packet> packet;
+		if (bBinary)
+		{
+			packet = PacketCodec::Decode(data, size);
+			if (packet == nullptr)
+				SH_ERROR("Error packet has been received! (Failed to decode)");
+		}
+		else
+		{
+			const core::Json json = core::Json::from_bson(data, data + size, true, false);
+			if (!json.is_discarded() && json.contains("id"))
+			{
+				static auto conatinerFactory = Packet::Factory::GetInstance();
+				packet = conatinerFactory->Create(json["id"]);
+				if (packet != nullptr)
+					packet->Deserialize(json);
+				else
+					SH_ERROR("An unregistered packet has been received!");
+			}
+			else
+				SH_ERROR("Error packet has been received! (No ID.)");
+		}
+		if (packet == nullptr)
+			return;
+
+		PacketEvent evt{ packet.get(), ip, port };
+		bus.Publish(evt);
+
+		NetworkContext::Message message{};
+		message.sender = remoteEndpoint;
+		message.packet = std::move(packet);
+
+		assert(receivedQueue.get() != nullptr);
+		receivedQueue.get()->Push(std::move(message));
+	}
+}//namespace
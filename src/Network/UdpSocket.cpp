@@ -1,49 +1,190 @@
 ﻿#include "UdpSocket.h"
+#include "PacketCodec.h"
+#include "MessageBatcher.h"
 
 #include "Core/Logger.h"
 
 #include <asio.hpp>
 
+#include <chrono>
+#include <future>
+
+#if __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cerrno>
+#endif
+
 namespace sh::network
 {
-	struct UdpSocket::Impl
+	namespace
+	{
+		auto ToAsio(const Endpoint& ep) -> asio::ip::udp::endpoint
+		{
+			if (ep.bV6)
+			{
+				asio::ip::address_v6::bytes_type bytes;
+				std::memcpy(bytes.data(), ep.address.data(), bytes.size());
+				return asio::ip::udp::endpoint{ asio::ip::address_v6{ bytes }, ep.port };
+			}
+			asio::ip::address_v4::bytes_type bytes;
+			std::memcpy(bytes.data(), ep.address.data(), bytes.size());
+			return asio::ip::udp::endpoint{ asio::ip::address_v4{ bytes }, ep.port };
+		}
+		auto FromAsio(const asio::ip::udp::endpoint& asioEp) -> Endpoint
+		{
+			Endpoint ep{};
+			ep.port = asioEp.port();
+			if (asioEp.address().is_v6())
+			{
+				const auto bytes = asioEp.address().to_v6().to_bytes();
+				std::memcpy(ep.address.data(), bytes.data(), bytes.size());
+				ep.bV6 = true;
+			}
+			else
+			{
+				const auto bytes = asioEp.address().to_v4().to_bytes();
+				std::memcpy(ep.address.data(), bytes.data(), bytes.size());
+			}
+			return ep;
+		}
+#if __linux__
+		auto FromSockAddr(const sockaddr_storage& addr) -> Endpoint
+		{
+			Endpoint ep{};
+			if (addr.ss_family == AF_INET6)
+			{
+				const auto& in6 = reinterpret_cast<const sockaddr_in6&>(addr);
+				std::memcpy(ep.address.data(), &in6.sin6_addr, 16);
+				ep.port = ntohs(in6.sin6_port);
+				ep.bV6 = true;
+			}
+			else
+			{
+				const auto& in4 = reinterpret_cast<const sockaddr_in&>(addr);
+				std::memcpy(ep.address.data(), &in4.sin_addr, 4);
+				ep.port = ntohs(in4.sin_port);
+			}
+			return ep;
+		}
+		auto ToSockAddr(const Endpoint& ep, sockaddr_storage& addr) -> socklen_t
+		{
+			std::memset(&addr, 0, sizeof(sockaddr_storage));
+			if (ep.bV6)
+			{
+				auto& in6 = reinterpret_cast<sockaddr_in6&>(addr);
+				in6.sin6_family = AF_INET6;
+				in6.sin6_port = htons(ep.port);
+				std::memcpy(&in6.sin6_addr, ep.address.data(), 16);
+				return sizeof(sockaddr_in6);
+			}
+			auto& in4 = reinterpret_cast<sockaddr_in&>(addr);
+			in4.sin_family = AF_INET;
+			in4.sin_port = htons(ep.port);
+			std::memcpy(&in4.sin_addr, ep.address.data(), 4);
+			return sizeof(sockaddr_in);
+		}
+#endif
+		/// @brief 네트워크 스레드에서 소켓이 닫히길 기다리는 최대 시간. 컨텍스트를 실행하는 스레드가 없으면 직접 닫는다.
+		constexpr auto CLOSE_TIMEOUT = std::chrono::seconds{ 1 };
+	}//namespace
+
+	struct UdpSocket::Impl : std::enable_shared_from_this<UdpSocket::Impl>
 	{
+		asio::io_context& ioCtx;
+		/// @brief 수신 핸들러와 닫기가 겹치지 않도록 소켓은 스트랜드 위에서 동작한다.
+		asio::strand<asio::io_context::executor_type> strand;
 		asio::ip::udp::socket udpSocket;
-		asio::ip::udp::endpoint receivedFrom;
+
+		/// @brief RECV_BATCH개의 수신 슬롯. 슬롯 하나는 MAX_PACKET_SIZE 바이트
+		std::vector<uint8_t> recvSlots;
+		/// @brief 네트워크 스레드에서만 접근
+		std::vector<NetworkContext::Message> batch;
+		/// @brief 압축된 묶음을 풀 버퍼. 네트워크 스레드에서만 접근
+		std::vector<uint8_t> unpackBuffer;
+
+		std::mutex mu;
+		std::vector<NetworkContext::Message> receivedMessages;
+		/// @brief 콜백 호출과 교체를 직렬화한다. 콜백은 mu를 잡지 않은 채로 호출된다.
+		std::mutex callbackMu;
+		ReceiveCallback callback;
+#if __linux__
+		std::array<mmsghdr, RECV_BATCH> recvMsgs{};
+		std::array<iovec, RECV_BATCH> recvIovs{};
+		std::array<sockaddr_storage, RECV_BATCH> recvAddrs{};
+
+		std::array<mmsghdr, SEND_BATCH> sendMsgs{};
+		std::array<iovec, SEND_BATCH> sendIovs{};
+		std::array<sockaddr_storage, SEND_BATCH> sendAddrs{};
+#endif
+		explicit Impl(asio::io_context& ioCtx) :
+			ioCtx(ioCtx),
+			strand(asio::make_strand(ioCtx)),
+			udpSocket(strand)
+		{
+			recvSlots.resize(static_cast<std::size_t>(RECV_BATCH) * Packet::MAX_PACKET_SIZE);
+			batch.reserve(RECV_BATCH);
+		}
+
+		/// @brief 소켓의 실행기에서 소켓을 닫고 끝날 때 까지 기다린다.
+		void Close();
+		void Receive();
+		void Drain();
+		/// @brief 수신 슬롯의 데이터를 패킷으로 해석해 batch에 추가한다. MessageBatcher의 묶음이면 나눠서 각각 해석한다.
+		void ParseDatagram(const uint8_t* data, std::size_t size, const Endpoint& sender);
+		void ParseMessage(const uint8_t* data, std::size_t size, const Endpoint& sender);
+		/// @brief batch를 콜백이나 받은 메시지 목록으로 넘긴다.
+		void CommitBatch();
 	};
 	UdpSocket::UdpSocket(const NetworkContext& ctx)
 	{
-		buffer.fill(0);
-
 		asio::io_context& ioCtx = *reinterpret_cast<asio::io_context*>(ctx.GetNativeHandle());
-		impl = std::make_unique<Impl>(UdpSocket::Impl{ asio::ip::udp::socket(ioCtx), asio::ip::udp::endpoint() });
+		impl = std::make_shared<Impl>(ioCtx);
+
+		sendSlots.resize(static_cast<std::size_t>(SEND_BATCH) * Packet::MAX_PACKET_SIZE);
 	}
 	UdpSocket::UdpSocket(UdpSocket&& other) noexcept :
 		impl(std::move(other.impl)),
-		buffer(other.buffer),
-		receivedMessage(std::move(other.receivedMessage))
+		sendSlots(std::move(other.sendSlots)),
+		sendSizes(other.sendSizes),
+		sendEndpoints(other.sendEndpoints),
+		sendCount(other.sendCount)
 	{
+		other.sendCount = 0;
 	}
 	UdpSocket::~UdpSocket()
 	{
 		if (impl != nullptr)
-			impl->udpSocket.close();
+		{
+			impl->Close();
+			std::lock_guard<std::mutex> lock{ impl->callbackMu };
+			impl->callback = nullptr;
+		}
 	}
 	SH_NET_API auto UdpSocket::operator=(UdpSocket&& other) noexcept -> UdpSocket&
 	{
 		if (this == &other)
 			return *this;
 
+		if (impl != nullptr)
+		{
+			impl->Close();
+			std::lock_guard<std::mutex> lock{ impl->callbackMu };
+			impl->callback = nullptr;
+		}
 		impl = std::move(other.impl);
-		buffer = other.buffer;
-		receivedMessage = std::move(other.receivedMessage);
+		sendSlots = std::move(other.sendSlots);
+		sendSizes = other.sendSizes;
+		sendEndpoints = other.sendEndpoints;
+		sendCount = other.sendCount;
+		other.sendCount = 0;
 		return *this;
 	}
 	SH_NET_API auto UdpSocket::Bind(uint16_t port) -> bool
 	{
 		impl->udpSocket.open(asio::ip::udp::v4());
-		if (port != 0)
 		{
+			// 0번 포트도 바인드해야 OS가 지정한 포트를 GetLocalPort()로 알 수 있다.
 			asio::error_code err;
 			impl->udpSocket.bind(asio::ip::udp::endpoint{ asio::ip::udp::v4(), port }, err);
 			if (err)
@@ -52,21 +193,64 @@ namespace sh::network
 				return false;
 			}
 		}
-		Receive();
+		// 수신은 읽기 가능 알림 후 비는 만큼 직접 읽어오므로 논블로킹이어야 한다.
+		asio::error_code err;
+		impl->udpSocket.non_blocking(true, err);
+		impl->udpSocket.set_option(asio::socket_base::receive_buffer_size{ 4 * 1024 * 1024 }, err);
+		impl->udpSocket.set_option(asio::socket_base::send_buffer_size{ 4 * 1024 * 1024 }, err);
+#if __linux__
+		for (uint32_t i = 0; i < RECV_BATCH; ++i)
+		{
+			impl->recvIovs[i].iov_base = impl->recvSlots.data() + static_cast<std::size_t>(i) * Packet::MAX_PACKET_SIZE;
+			impl->recvIovs[i].iov_len = Packet::MAX_PACKET_SIZE;
+			impl->recvMsgs[i].msg_hdr.msg_iov = &impl->recvIovs[i];
+			impl->recvMsgs[i].msg_hdr.msg_iovlen = 1;
+			impl->recvMsgs[i].msg_hdr.msg_name = &impl->recvAddrs[i];
+		}
+		for (uint32_t i = 0; i < SEND_BATCH; ++i)
+		{
+			impl->sendIovs[i].iov_base = sendSlots.data() + static_cast<std::size_t>(i) * Packet::MAX_PACKET_SIZE;
+			impl->sendMsgs[i].msg_hdr.msg_iov = &impl->sendIovs[i];
+			impl->sendMsgs[i].msg_hdr.msg_iovlen = 1;
+			impl->sendMsgs[i].msg_hdr.msg_name = &impl->sendAddrs[i];
+		}
+#endif
+		impl->Receive();
 		return true;
 	}
 	SH_NET_API void UdpSocket::Close()
 	{
-		impl->udpSocket.close();
+		impl->Close();
 	}
 	SH_NET_API void UdpSocket::Send(const Packet& packet, const std::string& ip, uint16_t port)
+	{
+		Send(packet, Endpoint::FromString(ip, port));
+	}
+	SH_NET_API void UdpSocket::Send(const Packet& packet, const Endpoint& endpoint)
 	{
 		if (!IsOpen())
 		{
 			SH_ERROR("Socket is not open!");
 			return;
 		}
-		const asio::ip::udp::endpoint endPoint{ asio::ip::make_address(ip), port };
+		const asio::ip::udp::endpoint endPoint = ToAsio(endpoint);
+
+		if (packet.HasBinaryCodec())
+		{
+			// 바이너리 코덱은 스택 버퍼에 바로 기록하고 동기로 보낸다. UDP 송신은 소켓 버퍼가 가득 차지 않는 한 막히지 않는다.
+			std::array<uint8_t, Packet::MAX_PACKET_SIZE> sendBuffer;
+			const std::size_t size = PacketCodec::Encode(packet, { sendBuffer.data(), sendBuffer.size() });
+			if (size == 0)
+			{
+				SH_ERROR_FORMAT("Failed to encode packet (id: {})", packet.GetId());
+				return;
+			}
+			asio::error_code ec;
+			impl->udpSocket.send_to(asio::buffer(sendBuffer.data(), size), endPoint, 0, ec);
+			if (ec)
+				SH_INFO_FORMAT("Send failed: {} ({})", ec.message(), ec.value());
+			return;
+		}
 
 		auto buffer = std::make_unique<std::vector<uint8_t>>(core::Json::to_bson(packet.Serialize()));
 		std::vector<uint8_t>* bufferRawPtr = buffer.get();
@@ -80,66 +264,293 @@ namespace sh::network
 			}
 		);
 	}
-	SH_NET_API auto UdpSocket::GetReceivedMessage() -> std::optional<NetworkContext::Message>
+	SH_NET_API auto UdpSocket::Enqueue(const Packet& packet, const Endpoint& endpoint) -> bool
+	{
+		if (sendCount == SEND_BATCH)
+			Flush();
+
+		uint8_t* slot = sendSlots.data() + static_cast<std::size_t>(sendCount) * Packet::MAX_PACKET_SIZE;
+		std::size_t size = 0;
+		if (packet.HasBinaryCodec())
+			size = PacketCodec::Encode(packet, { slot, Packet::MAX_PACKET_SIZE });
+		else
+		{
+			const std::vector<uint8_t> bson = core::Json::to_bson(packet.Serialize());
+			if (bson.size() <= Packet::MAX_PACKET_SIZE)
+			{
+				std::memcpy(slot, bson.data(), bson.size());
+				size = bson.size();
+			}
+		}
+		if (size == 0)
+		{
+			SH_ERROR_FORMAT("Failed to encode packet (id: {})", packet.GetId());
+			return false;
+		}
+		sendSizes[sendCount] = static_cast<uint32_t>(size);
+		sendEndpoints[sendCount] = endpoint;
+		++sendCount;
+		return true;
+	}
+	SH_NET_API auto UdpSocket::Enqueue(const uint8_t* data, std::size_t size, const Endpoint& endpoint) -> bool
+	{
+		if (size == 0 || size > Packet::MAX_PACKET_SIZE)
+		{
+			SH_ERROR_FORMAT("Invalid datagram size: {}", size);
+			return false;
+		}
+		if (sendCount == SEND_BATCH)
+			Flush();
+
+		uint8_t* slot = sendSlots.data() + static_cast<std::size_t>(sendCount) * Packet::MAX_PACKET_SIZE;
+		std::memcpy(slot, data, size);
+		sendSizes[sendCount] = static_cast<uint32_t>(size);
+		sendEndpoints[sendCount] = endpoint;
+		++sendCount;
+		return true;
+	}
+	SH_NET_API auto UdpSocket::Flush() -> std::size_t
+	{
+		if (sendCount == 0)
+			return 0;
+		if (!IsOpen())
+		{
+			sendCount = 0;
+			return 0;
+		}
+
+		std::size_t sent = 0;
+#if __linux__
+		for (uint32_t i = 0; i < sendCount; ++i)
+		{
+			impl->sendIovs[i].iov_len = sendSizes[i];
+			impl->sendMsgs[i].msg_hdr.msg_namelen = ToSockAddr(sendEndpoints[i], impl->sendAddrs[i]);
+		}
+		const int fd = impl->udpSocket.native_handle();
+		while (sent < sendCount)
+		{
+			const int n = sendmmsg(fd, impl->sendMsgs.data() + sent, sendCount - static_cast<uint32_t>(sent), MSG_DONTWAIT);
+			if (n < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				// 소켓 버퍼가 가득 찼다면 남은 데이터그램은 버린다. UDP이므로 유실과 같다.
+				SH_INFO_FORMAT("Send failed: {} of {} datagrams dropped (errno: {})", sendCount - sent, sendCount, errno);
+				break;
+			}
+			sent += static_cast<std::size_t>(n);
+		}
+#else
+		for (uint32_t i = 0; i < sendCount; ++i)
+		{
+			const uint8_t* slot = sendSlots.data() + static_cast<std::size_t>(i) * Packet::MAX_PACKET_SIZE;
+			asio::error_code ec;
+			impl->udpSocket.send_to(asio::buffer(slot, sendSizes[i]), ToAsio(sendEndpoints[i]), 0, ec);
+			if (ec)
+			{
+				SH_INFO_FORMAT("Send failed: {} ({})", ec.message(), ec.value());
+				continue;
+			}
+			++sent;
+		}
+#endif
+		sendCount = 0;
+		return sent;
+	}
+	SH_NET_API auto UdpSocket::GetReceivedMessages(std::vector<NetworkContext::Message>& out) -> std::size_t
 	{
-		if (!mu.try_lock())
-			return {};
-		std::lock_guard<std::mutex> lock{ mu, std::adopt_lock };
-		if (receivedMessage.empty())
-			return {};
-		NetworkContext::Message msg = std::move(receivedMessage.front());
-		receivedMessage.pop();
-		return msg;
+		std::lock_guard<std::mutex> lock{ impl->mu };
+		auto& receivedMessages = impl->receivedMessages;
+		const std::size_t count = receivedMessages.size();
+		if (count == 0)
+			return 0;
+		if (out.empty())
+			out.swap(receivedMessages);
+		else
+		{
+			out.insert(out.end(), std::make_move_iterator(receivedMessages.begin()), std::make_move_iterator(receivedMessages.end()));
+			receivedMessages.clear();
+		}
+		return count;
+	}
+	SH_NET_API void UdpSocket::SetReceiveCallback(ReceiveCallback&& callback)
+	{
+		std::lock_guard<std::mutex> callbackLock{ impl->callbackMu };
+		impl->callback = std::move(callback);
+		if (!impl->callback)
+			return;
+		// 콜백 전에 쌓인 메시지도 넘긴다.
+		std::vector<NetworkContext::Message> pending;
+		{
+			std::lock_guard<std::mutex> lock{ impl->mu };
+			pending.swap(impl->receivedMessages);
+		}
+		if (!pending.empty())
+			impl->callback(std::move(pending));
 	}
 	SH_NET_API auto UdpSocket::IsOpen() const -> bool
 	{
 		return impl != nullptr && impl->udpSocket.is_open();
 	}
-	void UdpSocket::Receive()
+	SH_NET_API auto UdpSocket::GetLocalPort() const -> uint16_t
 	{
 		if (!IsOpen())
+			return 0;
+		asio::error_code ec;
+		const auto ep = impl->udpSocket.local_endpoint(ec);
+		return ec ? 0 : ep.port();
+	}
+	void UdpSocket::Impl::Close()
+	{
+		if (!udpSocket.is_open())
+			return;
+
+		if (ioCtx.stopped() || strand.running_in_this_thread())
+		{
+			asio::error_code ec;
+			udpSocket.close(ec);
+			return;
+		}
+		// 다른 스레드에서 진행 중인 수신 핸들러와 겹치지 않게 소켓의 실행기에서 닫는다.
+		auto done = std::make_shared<std::promise<void>>();
+		std::future<void> future = done->get_future();
+		asio::post(strand,
+			[self = shared_from_this(), done]()
+			{
+				asio::error_code ec;
+				self->udpSocket.close(ec);
+				done->set_value();
+			}
+		);
+		const auto deadline = std::chrono::steady_clock::now() + CLOSE_TIMEOUT;
+		while (future.wait_for(std::chrono::milliseconds{ 10 }) != std::future_status::ready)
+		{
+			if (!ioCtx.stopped() && std::chrono::steady_clock::now() < deadline)
+				continue;
+			SH_INFO("Network context is not running. Closing the socket directly.");
+			asio::error_code ec;
+			udpSocket.close(ec);
+			return;
+		}
+	}
+	void UdpSocket::Impl::Receive()
+	{
+		if (!udpSocket.is_open())
 		{
 			SH_ERROR("Socket is not open!");
 			return;
 		}
-
-		impl->udpSocket.async_receive_from
-		(
-			asio::buffer(buffer), impl->receivedFrom,
-			[this](std::error_code ec, std::size_t receivedBytes)
+		// 핸들러가 소켓 객체보다 오래 살 수 있으므로 공유 상태만 붙잡는다.
+		udpSocket.async_wait(asio::ip::udp::socket::wait_read,
+			[self = shared_from_this()](std::error_code ec)
 			{
-				if (!ec && receivedBytes > 0)
-				{
-					const core::Json json = core::Json::from_bson(buffer.data(), receivedBytes, true, false);
-					if (json.empty() || json.is_discarded())
-						SH_ERROR("Error packet has been received! (Failed to parsing)");
-					else
-					{
-						if (json.contains("id"))
-						{
-							static auto conatinerFactory = Packet::Factory::GetInstance();
-							auto packet = conatinerFactory->Create(json["id"]);
-							if (packet != nullptr)
-							{
-								packet->Deserialize(json);
-								std::lock_guard<std::mutex> lock{ mu };
-
-								NetworkContext::Message message{};
-								message.senderIp = impl->receivedFrom.address().to_string();
-								message.senderPort = static_cast<uint16_t>(impl->receivedFrom.port());
-								message.packet = std::move(packet);
-
-								receivedMessage.push(std::move(message));
-							}
-							else
-								SH_ERROR("An unregistered packet has been received!");
-						}
-						else
-							SH_ERROR("Error packet has been received! (No ID)");
-					}
-				}
-				Receive();
+				if (ec == asio::error::operation_aborted || !self->udpSocket.is_open())
+					return;
+				if (!ec)
+					self->Drain();
+				self->Receive();
 			}
 		);
 	}
-}//namespace
\ No newline at end of file
+	void UdpSocket::Impl::Drain()
+	{
+#if __linux__
+		const int fd = udpSocket.native_handle();
+		while (true)
+		{
+			for (uint32_t i = 0; i < RECV_BATCH; ++i)
+			{
+				recvMsgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+				recvMsgs[i].msg_hdr.msg_flags = 0;
+			}
+			const int n = recvmmsg(fd, recvMsgs.data(), RECV_BATCH, MSG_DONTWAIT, nullptr);
+			if (n < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				if (errno != EAGAIN && errno != EWOULDBLOCK)
+					SH_INFO_FORMAT("Receive failed (errno: {})", errno);
+				break;
+			}
+			for (int i = 0; i < n; ++i)
+			{
+				// 슬롯보다 큰 데이터그램은 잘렸으므로 버린다.
+				if (recvMsgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+					continue;
+				const uint8_t* slot = recvSlots.data() + static_cast<std::size_t>(i) * Packet::MAX_PACKET_SIZE;
+				ParseDatagram(slot, recvMsgs[i].msg_len, FromSockAddr(recvAddrs[i]));
+			}
+			if (n < static_cast<int>(RECV_BATCH))
+				break;
+			CommitBatch();
+		}
+#else
+		asio::ip::udp::endpoint from;
+		for (uint32_t i = 0; i < RECV_BATCH; ++i)
+		{
+			uint8_t* slot = recvSlots.data() + static_cast<std::size_t>(i) * Packet::MAX_PACKET_SIZE;
+			asio::error_code err;
+			const std::size_t receivedBytes = udpSocket.receive_from(asio::buffer(slot, Packet::MAX_PACKET_SIZE), from, 0, err);
+			if (err)
+			{
+				if (err != asio::error::would_block)
+					SH_INFO_FORMAT("Receive failed: {} ({})", err.message(), err.value());
+				break;
+			}
+			ParseDatagram(slot, receivedBytes, FromAsio(from));
+		}
+#endif
+		CommitBatch();
+	}
+	void UdpSocket::Impl::ParseDatagram(const uint8_t* data, std::size_t size, const Endpoint& sender)
+	{
+		if (size == 0)
+			return;
+
+		if (MessageBatcher::IsBatch(data, size))
+		{
+			// 묶음 안의 메시지는 수신 슬롯에서 바로 해석한다.
+			const bool bValid = MessageBatcher::Unpack(data, size, unpackBuffer,
+				[&](const uint8_t* message, std::size_t messageSize)
+				{
+					ParseMessage(message, messageSize, sender);
+				}
+			);
+			if (!bValid)
+				SH_ERROR("Error batch has been received!");
+			return;
+		}
+		ParseMessage(data, size, sender);
+	}
+	void UdpSocket::Impl::ParseMessage(const uint8_t* data, std::size_t size, const Endpoint& sender)
+	{
+		std::unique_ptr<Packet> packet = PacketCodec::DecodeAny(data, size);
+		if (packet == nullptr)
+			return;
+
+		NetworkContext::Message message{};
+		message.sender = sender;
+		message.packet = std::move(packet);
+		batch.push_back(std::move(message));
+	}
+	void UdpSocket::Impl::CommitBatch()
+	{
+		if (batch.empty())
+			return;
+
+		std::lock_guard<std::mutex> callbackLock{ callbackMu };
+		if (callback)
+		{
+			callback(std::move(batch));
+			batch = std::vector<NetworkContext::Message>{};
+			batch.reserve(RECV_BATCH);
+			return;
+		}
+		std::lock_guard<std::mutex> lock{ mu };
+		if (receivedMessages.empty())
+			receivedMessages.swap(batch);
+		else
+			receivedMessages.insert(receivedMessages.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+		batch.clear();
+	}
+}//namespace
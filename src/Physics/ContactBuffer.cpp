@@ -0,0 +1,69 @@
+﻿#include "ContactBuffer.h"
+
+#include <cassert>
+namespace sh::phys
+{
+	SH_PHYS_API void ContactBuffer::Clear()
+	{
+		types.clear();
+		body1Idxs.clear();
+		body2Idxs.clear();
+		collider1Idxs.clear();
+		collider2Idxs.clear();
+		contactBegins.clear();
+		contactCounts.clear();
+
+		localPointsOnCollider1.clear();
+		localPointsOnCollider2.clear();
+		worldNormals.clear();
+		penetrationDepths.clear();
+
+		++generation;
+	}
+	SH_PHYS_API void ContactBuffer::AddPair(PairType type, uint32_t body1Idx, uint32_t body2Idx, uint32_t collider1Idx, uint32_t collider2Idx)
+	{
+		types.push_back(type);
+		body1Idxs.push_back(body1Idx);
+		body2Idxs.push_back(body2Idx);
+		collider1Idxs.push_back(collider1Idx);
+		collider2Idxs.push_back(collider2Idx);
+		contactBegins.push_back(GetContactCount());
+		contactCounts.push_back(0);
+	}
+	SH_PHYS_API void ContactBuffer::AddContact(const glm::vec3& localPointOnCollider1, const glm::vec3& localPointOnCollider2, const glm::vec3& worldNormal, float penetrationDepth)
+	{
+		assert(!contactCounts.empty());
+		localPointsOnCollider1.push_back(localPointOnCollider1);
+		localPointsOnCollider2.push_back(localPointOnCollider2);
+		worldNormals.push_back(worldNormal);
+		penetrationDepths.push_back(penetrationDepth);
+		++contactCounts.back();
+	}
+	SH_PHYS_API void ContactBuffer::Append(const ContactBuffer& other)
+	{
+		const uint32_t contactBase = GetContactCount();
+
+		types.insert(types.end(), other.types.begin(), other.types.end());
+		body1Idxs.insert(body1Idxs.end(), other.body1Idxs.begin(), other.body1Idxs.end());
+		body2Idxs.insert(body2Idxs.end(), other.body2Idxs.begin(), other.body2Idxs.end());
+		collider1Idxs.insert(collider1Idxs.end(), other.collider1Idxs.begin(), other.collider1Idxs.end());
+		collider2Idxs.insert(collider2Idxs.end(), other.collider2Idxs.begin(), other.collider2Idxs.end());
+		for (uint32_t begin : other.contactBegins)
+			contactBegins.push_back(contactBase + begin);
+		contactCounts.insert(contactCounts.end(), other.contactCounts.begin(), other.contactCounts.end());
+
+		localPointsOnCollider1.insert(localPointsOnCollider1.end(), other.localPointsOnCollider1.begin(), other.localPointsOnCollider1.end());
+		localPointsOnCollider2.insert(localPointsOnCollider2.end(), other.localPointsOnCollider2.begin(), other.localPointsOnCollider2.end());
+		worldNormals.insert(worldNormals.end(), other.worldNormals.begin(), other.worldNormals.end());
+		penetrationDepths.insert(penetrationDepths.end(), other.penetrationDepths.begin(), other.penetrationDepths.end());
+	}
+	SH_PHYS_API auto ContactBuffer::GetContactPoint(uint32_t contactIdx) const -> ContactPoint
+	{
+		ContactPoint cp{};
+		cp.localPointOnCollider1 = localPointsOnCollider1[contactIdx];
+		cp.localPointOnCollider2 = localPointsOnCollider2[contactIdx];
+		cp.worldNormal = worldNormals[contactIdx];
+		cp.penetrationDepth = penetrationDepths[contactIdx];
+		return cp;
+	}
+}//namespace
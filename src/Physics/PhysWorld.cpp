@@ -1,9 +1,17 @@
 ﻿#include "PhysWorld.h"
-#include "PhysicsEvent.h"
+#include "ContactBuffer.h"
+#include "QuerySnapshot.h"
 
 #include "Core/Logger.h"
+#include "Core/ThreadPool.h"
+#include "Core/SpinLock.h"
 
 #include "reactphysics3d/reactphysics3d.h"
+
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 namespace sh::phys
 {
 	class GroundRaycastCallback : public reactphysics3d::RaycastCallback
@@ -44,12 +52,61 @@ namespace sh::phys
 			return 0.0f;
 		}
 	};
+	/// @brief 해석적으로 다루지 않는 충돌체(볼록 메시 등)에 대한 레이캐스트. rp3d 할당자를 건드릴 수 있으므로 직렬화한다.
+	static auto NativeColliderRayCast(void* nativeCollider, const glm::vec3& from, const glm::vec3& to, HitPoint& hit) -> bool
+	{
+		static core::SpinLock lock{};
+
+		auto collider = reinterpret_cast<reactphysics3d::Collider*>(nativeCollider);
+		reactphysics3d::Ray ray{ { from.x, from.y, from.z }, { to.x, to.y, to.z } };
+		reactphysics3d::RaycastInfo info{};
+		{
+			std::lock_guard<core::SpinLock> guard{ lock };
+			if (!collider->raycast(ray, info))
+				return false;
+		}
+		hit.fraction = info.hitFraction;
+		hit.hitPoint = { info.worldPoint.x, info.worldPoint.y, info.worldPoint.z };
+		hit.hitNormal = { info.worldNormal.x, info.worldNormal.y, info.worldNormal.z };
+		hit.rigidBodyHandle = collider->getBody();
+		return true;
+	}
+	/// @brief 일괄 질의 하나가 가벼우므로 이보다 작은 구간으로는 나누지 않는다.
+	constexpr std::size_t QUERY_MIN_CHUNK = 256;
+
+	/// @brief [0, count)를 스레드 풀에서 나눠 fn(begin, end)를 수행하고 반환 값의 합을 돌려준다.
+	template<typename F>
+	static auto ParallelSum(std::size_t count, F&& fn) -> uint32_t
+	{
+		std::atomic<uint32_t> result{ 0 };
+		core::ThreadPool::GetInstance()->ParallelFor(count,
+			[&fn, &result](std::size_t begin, std::size_t end)
+			{
+				result.fetch_add(fn(begin, end), std::memory_order_relaxed);
+			},
+			QUERY_MIN_CHUNK
+		);
+		return result.load(std::memory_order_relaxed);
+	}
+
+	/// @brief rp3d 객체의 사용자 데이터에는 PhysWorld에 등록된 인덱스 + 1이 들어있다.
+	static auto ToRegisteredIdx(void* userData) -> uint32_t
+	{
+		if (userData == nullptr)
+			return ContactBuffer::INVALID_INDEX;
+		return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData) - 1);
+	}
+	static auto ToUserData(uint32_t idx) -> void*
+	{
+		return reinterpret_cast<void*>(static_cast<uintptr_t>(idx) + 1);
+	}
+
 	class CustomEventListener : public reactphysics3d::EventListener
 	{
 	public:
 		virtual void onContact(const reactphysics3d::CollisionCallback::CallbackData& callbackData) override
 		{
-			if (bus == nullptr)
+			if (target == nullptr)
 				return;
 
 			for (uint32_t i = 0; i < callbackData.getNbContactPairs(); ++i)
@@ -57,40 +114,36 @@ namespace sh::phys
 				const auto& pair = callbackData.getContactPair(i);
 				auto type = pair.getEventType();
 
-				PhysicsEvent evt{};
-				evt.rigidBody1Handle = pair.getBody1();
-				evt.rigidBody2Handle = pair.getBody2();
-				evt.collider1Handle = pair.getCollider1();
-				evt.collider2Handle = pair.getCollider2();
-
+				ContactBuffer::PairType pairType = ContactBuffer::PairType::CollisionStay;
 				if (type == reactphysics3d::CollisionCallback::ContactPair::EventType::ContactStart)
-					evt.type = PhysicsEvent::Type::CollisionEnter;
-				else if (type == reactphysics3d::CollisionCallback::ContactPair::EventType::ContactStay)
-					evt.type = PhysicsEvent::Type::CollisionStay;
+					pairType = ContactBuffer::PairType::CollisionEnter;
 				else if (type == reactphysics3d::CollisionCallback::ContactPair::EventType::ContactExit)
-					evt.type = PhysicsEvent::Type::CollisionExit;
+					pairType = ContactBuffer::PairType::CollisionExit;
 
-				evt.contactCount = pair.getNbContactPoints();
-				evt.getContactPointFn =
-					[&](phys::ContactPoint& cp, uint32_t idx)
-					{
-						auto contactPoint = pair.getContactPoint(idx);
-						const auto& localPoint1 = contactPoint.getLocalPointOnCollider1();
-						const auto& localPoint2 = contactPoint.getLocalPointOnCollider2();
-						const auto& normal = contactPoint.getWorldNormal();
-						cp.localPointOnCollider1 = { localPoint1.x, localPoint1.y, localPoint1.z };
-						cp.localPointOnCollider2 = { localPoint2.x, localPoint2.y, localPoint2.z };
-						cp.penetrationDepth = contactPoint.getPenetrationDepth();
-						cp.worldNormal = { normal.x, normal.y, normal.z };
-					};
-
-				bus->Publish(evt);
+				target->AddPair(pairType,
+					ToRegisteredIdx(pair.getBody1()->getUserData()), ToRegisteredIdx(pair.getBody2()->getUserData()),
+					ToRegisteredIdx(pair.getCollider1()->getUserData()), ToRegisteredIdx(pair.getCollider2()->getUserData()));
+
+				// 콜백이 끝나면 pair가 무효화 되므로 접촉점을 바로 복사한다.
+				const uint32_t contactCount = pair.getNbContactPoints();
+				for (uint32_t idx = 0; idx < contactCount; ++idx)
+				{
+					auto contactPoint = pair.getContactPoint(idx);
+					const auto& localPoint1 = contactPoint.getLocalPointOnCollider1();
+					const auto& localPoint2 = contactPoint.getLocalPointOnCollider2();
+					const auto& normal = contactPoint.getWorldNormal();
+					target->AddContact(
+						{ localPoint1.x, localPoint1.y, localPoint1.z },
+						{ localPoint2.x, localPoint2.y, localPoint2.z },
+						{ normal.x, normal.y, normal.z },
+						contactPoint.getPenetrationDepth());
+				}
 			}
 		}
 
 		virtual void onTrigger(const reactphysics3d::OverlapCallback::CallbackData& callbackData) override
 		{
-			if (bus == nullptr)
+			if (target == nullptr)
 				return;
 
 			for (uint32_t i = 0; i < callbackData.getNbOverlappingPairs(); i++)
@@ -101,23 +154,65 @@ namespace sh::phys
 				if (type == reactphysics3d::OverlapCallback::OverlapPair::EventType::OverlapStay)
 					continue;
 
-				PhysicsEvent evt{};
-				evt.rigidBody1Handle = pair.getBody1();
-				evt.rigidBody2Handle = pair.getBody2();
-				evt.collider1Handle = pair.getCollider1();
-				evt.collider2Handle = pair.getCollider2();
-				evt.contactCount = 0;
-
-				if (type == reactphysics3d::OverlapCallback::OverlapPair::EventType::OverlapStart)
-					evt.type = PhysicsEvent::Type::TriggerEnter;
-				else if (type == reactphysics3d::OverlapCallback::OverlapPair::EventType::OverlapExit)
-					evt.type = PhysicsEvent::Type::TriggerExit;
+				const ContactBuffer::PairType pairType = type == reactphysics3d::OverlapCallback::OverlapPair::EventType::OverlapStart ?
+					ContactBuffer::PairType::TriggerEnter : ContactBuffer::PairType::TriggerExit;
 
-				bus->Publish(evt);
+				target->AddPair(pairType,
+					ToRegisteredIdx(pair.getBody1()->getUserData()), ToRegisteredIdx(pair.getBody2()->getUserData()),
+					ToRegisteredIdx(pair.getCollider1()->getUserData()), ToRegisteredIdx(pair.getCollider2()->getUserData()));
 			}
 		}
 	public:
-		core::EventBus* bus;
+		/// @brief 기록할 버퍼. 동기 모드에서는 게임 쪽 버퍼, 비동기 모드에서는 스텝 전용 버퍼를 가리킨다.
+		ContactBuffer* target = nullptr;
+	};
+
+	/// @brief 안정적인 인덱스와 사용자 데이터를 관리하는 테이블.
+	/// @brief 해제된 인덱스는 Recycle() 이후에 재사용되어 아직 처리되지 않은 접촉 버퍼의 인덱스가 다른 객체를 가리키지 않도록 한다.
+	struct RegistryTable
+	{
+		std::vector<void*> userDatas;
+		std::vector<uint32_t> freeIdxs;
+		/// @brief 해제됐지만 아직 교체되지 않은 스텝 버퍼에 남아 있을 수 있는 인덱스
+		std::vector<uint32_t> releasedIdxs;
+		/// @brief 해제됐고 게임 쪽 버퍼에만 남아 있을 수 있는 인덱스
+		std::vector<uint32_t> retiredIdxs;
+
+		auto Register(void* userData) -> uint32_t
+		{
+			if (!freeIdxs.empty())
+			{
+				const uint32_t idx = freeIdxs.back();
+				freeIdxs.pop_back();
+				userDatas[idx] = userData;
+				return idx;
+			}
+			userDatas.push_back(userData);
+			return static_cast<uint32_t>(userDatas.size() - 1);
+		}
+		void Unregister(uint32_t idx)
+		{
+			if (idx >= userDatas.size())
+				return;
+			userDatas[idx] = nullptr;
+			releasedIdxs.push_back(idx);
+		}
+		auto Get(uint32_t idx) const -> void*
+		{
+			if (idx >= userDatas.size())
+				return nullptr;
+			return userDatas[idx];
+		}
+		void Retire()
+		{
+			retiredIdxs.insert(retiredIdxs.end(), releasedIdxs.begin(), releasedIdxs.end());
+			releasedIdxs.clear();
+		}
+		void Recycle()
+		{
+			freeIdxs.insert(freeIdxs.end(), retiredIdxs.begin(), retiredIdxs.end());
+			retiredIdxs.clear();
+		}
 	};
 
 	struct PhysWorld::Impl
@@ -125,6 +220,143 @@ namespace sh::phys
 		reactphysics3d::PhysicsCommon physicsCommon;
 		reactphysics3d::PhysicsWorld* world = nullptr;
 		CustomEventListener eventListener;
+
+		bool bAsync = false;
+		std::future<void> stepFuture;
+
+		std::vector<std::function<void()>> pendingWrites;
+
+		// 게임 스레드에서 보는 버퍼 (비동기 모드에서는 EndStep에서 stepContacts가 이어 붙여짐)
+		ContactBuffer contacts;
+		ContactBuffer stepContacts;
+
+		RegistryTable bodies;
+		RegistryTable colliders;
+
+		std::vector<BodyState> bodyStates;
+		std::unordered_map<void*, std::size_t> bodyStateIdxs;
+
+		QuerySnapshot querySnapshot;
+		/// @brief 물리 세계가 바뀌어 스냅샷을 다시 만들어야 하는지
+		bool bQuerySnapshotDirty = true;
+		/// @brief 일괄 질의가 한 번이라도 쓰였다면 스텝 시작 전에 미리 스냅샷을 만든다.
+		bool bQuerySnapshotUsed = false;
+
+		void FlushWrites()
+		{
+			if (pendingWrites.empty())
+				return;
+			for (auto& fn : pendingWrites)
+				fn();
+			pendingWrites.clear();
+			bQuerySnapshotDirty = true;
+		}
+		void SwapBuffers()
+		{
+			// 게임 쪽에서 아직 처리하지 않은 쌍이 있을 수 있으므로 뒤에 이어 붙인다.
+			contacts.Append(stepContacts);
+			stepContacts.Clear();
+			bodies.Retire();
+			colliders.Retire();
+
+			TakeSnapshot();
+			bQuerySnapshotDirty = true;
+		}
+		void TakeSnapshot()
+		{
+			const uint32_t bodyCount = world->getNbRigidBodies();
+			bodyStates.resize(bodyCount);
+			bodyStateIdxs.clear();
+			bodyStateIdxs.reserve(bodyCount);
+			for (uint32_t i = 0; i < bodyCount; ++i)
+			{
+				const reactphysics3d::RigidBody* body = world->getRigidBody(i);
+				const reactphysics3d::Transform& transform = body->getTransform();
+				const auto& pos = transform.getPosition();
+				const auto& quat = transform.getOrientation();
+				const auto& vel = body->getLinearVelocity();
+				const auto& angularVel = body->getAngularVelocity();
+
+				BodyState& state = bodyStates[i];
+				state.position = { pos.x, pos.y, pos.z };
+				state.rotation = glm::quat{ quat.w, quat.x, quat.y, quat.z };
+				state.linearVelocity = { vel.x, vel.y, vel.z };
+				state.angularVelocity = { angularVel.x, angularVel.y, angularVel.z };
+				state.bSleeping = body->isSleeping();
+				bodyStateIdxs.insert({ const_cast<reactphysics3d::RigidBody*>(body), i });
+			}
+		}
+		void BuildQuerySnapshot()
+		{
+			querySnapshot.Clear();
+			querySnapshot.SetNativeRayCast(&NativeColliderRayCast);
+
+			const uint32_t bodyCount = world->getNbRigidBodies();
+			for (uint32_t i = 0; i < bodyCount; ++i)
+			{
+				reactphysics3d::RigidBody* body = world->getRigidBody(i);
+				if (!body->isActive())
+					continue;
+				for (uint32_t j = 0; j < body->getNbColliders(); ++j)
+				{
+					reactphysics3d::Collider* collider = body->getCollider(j);
+					const reactphysics3d::CollisionShape* shape = collider->getCollisionShape();
+					const reactphysics3d::AABB aabb = collider->getWorldAABB();
+					const reactphysics3d::Transform transform = collider->getLocalToWorldTransform();
+					const auto& pos = transform.getPosition();
+					const auto& quat = transform.getOrientation();
+
+					QuerySnapshot::Shape snapshotShape{};
+					snapshotShape.aabbMin = { aabb.getMin().x, aabb.getMin().y, aabb.getMin().z };
+					snapshotShape.aabbMax = { aabb.getMax().x, aabb.getMax().y, aabb.getMax().z };
+					snapshotShape.position = { pos.x, pos.y, pos.z };
+					snapshotShape.rotation = glm::quat{ quat.w, quat.x, quat.y, quat.z };
+					snapshotShape.category = static_cast<Tagbit>(collider->getCollisionCategoryBits());
+					snapshotShape.rigidBodyHandle = body;
+					snapshotShape.nativeCollider = collider;
+					switch (shape->getName())
+					{
+					case reactphysics3d::CollisionShapeName::SPHERE:
+						snapshotShape.type = QuerySnapshot::ShapeType::Sphere;
+						snapshotShape.extents.x = static_cast<const reactphysics3d::SphereShape*>(shape)->getRadius();
+						break;
+					case reactphysics3d::CollisionShapeName::BOX:
+					{
+						const auto& half = static_cast<const reactphysics3d::BoxShape*>(shape)->getHalfExtents();
+						snapshotShape.type = QuerySnapshot::ShapeType::Box;
+						snapshotShape.extents = { half.x, half.y, half.z };
+						break;
+					}
+					case reactphysics3d::CollisionShapeName::CAPSULE:
+					{
+						auto capsule = static_cast<const reactphysics3d::CapsuleShape*>(shape);
+						snapshotShape.type = QuerySnapshot::ShapeType::Capsule;
+						snapshotShape.extents = { capsule->getRadius(), capsule->getHeight() * 0.5f, 0.f };
+						break;
+					}
+					default:
+						snapshotShape.type = QuerySnapshot::ShapeType::Bounds;
+						break;
+					}
+					querySnapshot.AddShape(snapshotShape);
+				}
+			}
+			querySnapshot.Build();
+			bQuerySnapshotDirty = false;
+		}
+		/// @brief 일괄 질의 전에 호출. 스냅샷이 낡았다면 스텝을 기다린 후 다시 만든다.
+		void PrepareQuerySnapshot(PhysWorld& physWorld)
+		{
+			bQuerySnapshotUsed = true;
+			if (bQuerySnapshotDirty)
+			{
+				physWorld.WaitForStep();
+				BuildQuerySnapshot();
+			}
+			// 네이티브 레이캐스트는 충돌체의 현재 트랜스폼을 읽는다.
+			else if (querySnapshot.HasBoundsShapes())
+				physWorld.WaitForStep();
+		}
 	};
 	SH_PHYS_API PhysWorld::PhysWorld()
 	{
@@ -132,7 +364,7 @@ namespace sh::phys
 
 		impl->world = impl->physicsCommon.createPhysicsWorld();
 
-		impl->eventListener.bus = &bus;
+		impl->eventListener.target = &impl->contacts;
 		impl->world->setEventListener(&impl->eventListener);
 	}
 	PhysWorld::PhysWorld(PhysWorld&& other) noexcept :
@@ -142,19 +374,178 @@ namespace sh::phys
 	SH_PHYS_API PhysWorld::~PhysWorld()
 	{
 		SH_INFO("~PhysWorld()");
+		if (impl != nullptr)
+			WaitForStep();
 	}
 
 	SH_PHYS_API void PhysWorld::Clean()
 	{
+		WaitForStep();
 		impl->physicsCommon.destroyPhysicsWorld(impl->world);
 	}
 
 	SH_PHYS_API void PhysWorld::Update(float deltaTime)
 	{
 		impl->world->update(deltaTime);
+		impl->bQuerySnapshotDirty = true;
+	}
+	SH_PHYS_API void PhysWorld::SetAsyncStep(bool bAsync)
+	{
+		if (impl->bAsync == bAsync)
+			return;
+		EndStep();
+		impl->bAsync = bAsync;
+		impl->eventListener.target = bAsync ? &impl->stepContacts : &impl->contacts;
 	}
-	SH_PHYS_API auto PhysWorld::RayCastHit(const Ray& ray, Tagbit allowedTag) const -> bool
+	SH_PHYS_API auto PhysWorld::IsAsyncStep() const -> bool
 	{
+		return impl->bAsync;
+	}
+	SH_PHYS_API void PhysWorld::BeginStep(float deltaTime)
+	{
+		EndStep();
+		impl->FlushWrites();
+		// 스텝 도중의 일괄 질의가 기다리지 않도록 스텝 전 상태로 미리 스냅샷을 만든다.
+		if (impl->bQuerySnapshotUsed && impl->bQuerySnapshotDirty)
+			impl->BuildQuerySnapshot();
+
+		core::ThreadPool* const threadPool = core::ThreadPool::GetInstance();
+		if (!impl->bAsync || !threadPool->IsInit())
+		{
+			Update(deltaTime);
+			// 스레드 풀이 없으면 동기적으로 진행하되 버퍼 교체 규칙은 같게 유지한다.
+			if (impl->bAsync)
+				impl->SwapBuffers();
+			return;
+		}
+		impl->stepFuture = threadPool->AddContinousTask(
+			[world = impl->world, deltaTime]()
+			{
+				world->update(deltaTime);
+			}
+		);
+	}
+	SH_PHYS_API void PhysWorld::EndStep()
+	{
+		if (!impl->stepFuture.valid())
+			return;
+		impl->stepFuture.get();
+
+		impl->SwapBuffers();
+		// 스텝 중에 밀린 쓰기를 여기서 반영하지 않으면 이후 즉시 실행되는 쓰기가 먼저 적용된다.
+		impl->FlushWrites();
+	}
+	SH_PHYS_API void PhysWorld::WaitForStep()
+	{
+		// 기다리기만 하면 IsStepping()이 계속 참이라 이후 읽기는 이전 스냅샷을, 쓰기는 다음 스텝까지 밀린다.
+		// 그래서 스텝을 끝내고 밀린 쓰기까지 반영한다. (핸들 파괴 전에 반영 되어야 함)
+		EndStep();
+	}
+	SH_PHYS_API auto PhysWorld::IsStepping() const -> bool
+	{
+		return impl->stepFuture.valid();
+	}
+	SH_PHYS_API auto PhysWorld::GetContacts() const -> const ContactBuffer&
+	{
+		return impl->contacts;
+	}
+	SH_PHYS_API void PhysWorld::ClearContacts()
+	{
+		impl->contacts.Clear();
+		// 진행 중인 스텝이 없다면 해제된 인덱스가 남아 있을 버퍼가 없다.
+		if (!IsStepping())
+		{
+			impl->bodies.Retire();
+			impl->colliders.Retire();
+		}
+		impl->bodies.Recycle();
+		impl->colliders.Recycle();
+	}
+	SH_PHYS_API auto PhysWorld::RegisterBody(void* rigidBodyHandle, void* userData) -> uint32_t
+	{
+		WaitForStep();
+		const uint32_t idx = impl->bodies.Register(userData);
+		reinterpret_cast<reactphysics3d::RigidBody*>(rigidBodyHandle)->setUserData(ToUserData(idx));
+		return idx;
+	}
+	SH_PHYS_API void PhysWorld::UnregisterBody(uint32_t idx)
+	{
+		impl->bodies.Unregister(idx);
+	}
+	SH_PHYS_API auto PhysWorld::GetBodyUserData(uint32_t idx) const -> void*
+	{
+		return impl->bodies.Get(idx);
+	}
+	SH_PHYS_API auto PhysWorld::RegisterCollider(void* colliderHandle, void* userData) -> uint32_t
+	{
+		WaitForStep();
+		const uint32_t idx = impl->colliders.Register(userData);
+		reinterpret_cast<reactphysics3d::Collider*>(colliderHandle)->setUserData(ToUserData(idx));
+		return idx;
+	}
+	SH_PHYS_API void PhysWorld::UnregisterCollider(uint32_t idx)
+	{
+		impl->colliders.Unregister(idx);
+	}
+	SH_PHYS_API auto PhysWorld::GetColliderUserData(uint32_t idx) const -> void*
+	{
+		return impl->colliders.Get(idx);
+	}
+	SH_PHYS_API void PhysWorld::Write(std::function<void()>&& fn)
+	{
+		if (IsStepping())
+			impl->pendingWrites.push_back(std::move(fn));
+		else
+		{
+			fn();
+			impl->bQuerySnapshotDirty = true;
+		}
+	}
+	SH_PHYS_API auto PhysWorld::GetBodyState(void* rigidBodyHandle) const -> const BodyState*
+	{
+		auto it = impl->bodyStateIdxs.find(rigidBodyHandle);
+		if (it == impl->bodyStateIdxs.end())
+			return nullptr;
+		return &impl->bodyStates[it->second];
+	}
+	SH_PHYS_API void PhysWorld::ReadBodyState(void* rigidBodyHandle, BodyState& state)
+	{
+		WaitForStep();
+
+		const auto body = reinterpret_cast<const reactphysics3d::RigidBody*>(rigidBodyHandle);
+		const reactphysics3d::Transform& transform = body->getTransform();
+		const auto& pos = transform.getPosition();
+		const auto& quat = transform.getOrientation();
+		const auto& vel = body->getLinearVelocity();
+		const auto& angularVel = body->getAngularVelocity();
+
+		state.position = { pos.x, pos.y, pos.z };
+		state.rotation = glm::quat{ quat.w, quat.x, quat.y, quat.z };
+		state.linearVelocity = { vel.x, vel.y, vel.z };
+		state.angularVelocity = { angularVel.x, angularVel.y, angularVel.z };
+		state.bSleeping = body->isSleeping();
+	}
+	SH_PHYS_API void PhysWorld::WriteBodyState(void* rigidBodyHandle, const BodyState& state)
+	{
+		WaitForStep();
+
+		auto body = reinterpret_cast<reactphysics3d::RigidBody*>(rigidBodyHandle);
+		reactphysics3d::Transform transform{
+			{ state.position.x, state.position.y, state.position.z },
+			{ state.rotation.x, state.rotation.y, state.rotation.z, state.rotation.w }
+		};
+		body->setTransform(transform);
+		body->resetForce();
+		body->resetTorque();
+		body->setLinearVelocity({ state.linearVelocity.x, state.linearVelocity.y, state.linearVelocity.z });
+		body->setAngularVelocity({ state.angularVelocity.x, state.angularVelocity.y, state.angularVelocity.z });
+		body->setIsSleeping(state.bSleeping);
+		impl->bQuerySnapshotDirty = true;
+	}
+	SH_PHYS_API auto PhysWorld::RayCastHit(const Ray& ray, Tagbit allowedTag) -> bool
+	{
+		WaitForStep();
+
 		reactphysics3d::Vector3 start{ ray.origin.x, ray.origin.y, ray.origin.z };
 		reactphysics3d::Vector3 dir{ ray.direction.x, ray.direction.y, ray.direction.z };
 		dir.normalize();
@@ -164,8 +555,10 @@ namespace sh::phys
 
 		return callback.hit;
 	}
-	SH_PHYS_API auto PhysWorld::RayCast(const Ray& ray, Tagbit allowedTag) const -> std::vector<HitPoint>
+	SH_PHYS_API auto PhysWorld::RayCast(const Ray& ray, Tagbit allowedTag) -> std::vector<HitPoint>
 	{
+		WaitForStep();
+
 		reactphysics3d::Vector3 start{ ray.origin.x, ray.origin.y, ray.origin.z };
 		reactphysics3d::Vector3 dir{ ray.direction.x, ray.direction.y, ray.direction.z };
 		dir.normalize();
@@ -185,20 +578,103 @@ namespace sh::phys
 		);
 		return hits;
 	}
-	SH_PHYS_API auto PhysWorld::GetContext() const -> ContextHandle
+	SH_PHYS_API auto PhysWorld::RayCastBatch(core::ArrayView<const RayQuery> queries, core::ArrayView<HitPoint> results) -> uint32_t
+	{
+		assert(results.size() >= queries.size());
+		impl->PrepareQuerySnapshot(*this);
+
+		const QuerySnapshot& snapshot = impl->querySnapshot;
+		const RayQuery* const queryPtr = queries.data();
+		HitPoint* const resultPtr = results.data();
+		return ParallelSum(std::min(queries.size(), results.size()),
+			[&snapshot, queryPtr, resultPtr](std::size_t begin, std::size_t end) -> uint32_t
+			{
+				uint32_t hitCount = 0;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					HitPoint& hit = resultPtr[i];
+					if (snapshot.RayCast(queryPtr[i], hit))
+						++hitCount;
+					else
+						hit = HitPoint{ 1.f, glm::vec3{ 0.f }, glm::vec3{ 0.f }, nullptr };
+				}
+				return hitCount;
+			}
+		);
+	}
+	SH_PHYS_API auto PhysWorld::SphereCastBatch(core::ArrayView<const SphereCastQuery> queries, core::ArrayView<HitPoint> results) -> uint32_t
+	{
+		assert(results.size() >= queries.size());
+		impl->PrepareQuerySnapshot(*this);
+
+		const QuerySnapshot& snapshot = impl->querySnapshot;
+		const SphereCastQuery* const queryPtr = queries.data();
+		HitPoint* const resultPtr = results.data();
+		return ParallelSum(std::min(queries.size(), results.size()),
+			[&snapshot, queryPtr, resultPtr](std::size_t begin, std::size_t end) -> uint32_t
+			{
+				uint32_t hitCount = 0;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					HitPoint& hit = resultPtr[i];
+					if (snapshot.SphereCast(queryPtr[i], hit))
+						++hitCount;
+					else
+						hit = HitPoint{ 1.f, glm::vec3{ 0.f }, glm::vec3{ 0.f }, nullptr };
+				}
+				return hitCount;
+			}
+		);
+	}
+	SH_PHYS_API auto PhysWorld::OverlapBatch(core::ArrayView<const OverlapQuery> queries, core::ArrayView<void*> bodies, core::ArrayView<uint32_t> counts) -> uint32_t
 	{
+		assert(counts.size() >= queries.size());
+		if (queries.size() == 0)
+			return 0;
+		impl->PrepareQuerySnapshot(*this);
+
+		const QuerySnapshot& snapshot = impl->querySnapshot;
+		const OverlapQuery* const queryPtr = queries.data();
+		void** const bodyPtr = bodies.data();
+		uint32_t* const countPtr = counts.data();
+		const uint32_t maxBodies = static_cast<uint32_t>(bodies.size() / queries.size());
+		return ParallelSum(std::min(queries.size(), counts.size()),
+			[&snapshot, queryPtr, bodyPtr, countPtr, maxBodies](std::size_t begin, std::size_t end) -> uint32_t
+			{
+				uint32_t total = 0;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					countPtr[i] = snapshot.Overlap(queryPtr[i], bodyPtr + i * maxBodies, maxBodies);
+					total += countPtr[i];
+				}
+				return total;
+			}
+		);
+	}
+	SH_PHYS_API auto PhysWorld::GetContext() -> ContextHandle
+	{
+		WaitForStep();
 		return &impl->physicsCommon;
 	}
-	SH_PHYS_API auto PhysWorld::GetNative() const -> PhysicsWorldHandle
+	SH_PHYS_API auto PhysWorld::GetNative() -> PhysicsWorldHandle
 	{
+		WaitForStep();
+		// 호출자가 세계를 바꿀 수 있다.
+		impl->bQuerySnapshotDirty = true;
 		return impl->world;
 	}
 	SH_PHYS_API void PhysWorld::SetGravity(const glm::vec3& gravity)
 	{
-		impl->world->setGravity({ gravity.x,gravity.y,gravity.z });
+		Write(
+			[world = impl->world, gravity]()
+			{
+				world->setGravity({ gravity.x,gravity.y,gravity.z });
+			}
+		);
 	}
-	SH_PHYS_API auto PhysWorld::GetGravity() const -> glm::vec3
+	SH_PHYS_API auto PhysWorld::GetGravity() -> glm::vec3
 	{
+		WaitForStep();
 		auto g = impl->world->getGravity();
 		return glm::vec3{ g.x, g.y, g.z };
 	}
@@ -0,0 +1,564 @@
+﻿#include "QuerySnapshot.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+namespace sh::phys
+{
+	namespace
+	{
+		constexpr float EPSILON = 1e-6f;
+
+		auto SafeInverse(const glm::vec3& dir) -> glm::vec3
+		{
+			constexpr float big = std::numeric_limits<float>::max();
+			return glm::vec3{
+				std::abs(dir.x) > EPSILON ? 1.f / dir.x : big,
+				std::abs(dir.y) > EPSILON ? 1.f / dir.y : big,
+				std::abs(dir.z) > EPSILON ? 1.f / dir.z : big
+			};
+		}
+		auto RayAabb(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& min, const glm::vec3& max, float tMax) -> bool
+		{
+			const glm::vec3 t0 = (min - origin) * invDir;
+			const glm::vec3 t1 = (max - origin) * invDir;
+			const glm::vec3 tSmall = glm::min(t0, t1);
+			const glm::vec3 tBig = glm::max(t0, t1);
+			const float tNear = std::max(std::max(tSmall.x, tSmall.y), std::max(tSmall.z, 0.f));
+			const float tFar = std::min(std::min(tBig.x, tBig.y), std::min(tBig.z, tMax));
+			return tNear <= tFar;
+		}
+		auto SphereAabb(const glm::vec3& center, float radius, const glm::vec3& min, const glm::vec3& max) -> bool
+		{
+			const glm::vec3 closest = glm::clamp(center, min, max);
+			const glm::vec3 diff = center - closest;
+			return glm::dot(diff, diff) <= radius * radius;
+		}
+		auto ClosestOnSegment(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b) -> glm::vec3
+		{
+			const glm::vec3 ab = b - a;
+			const float len2 = glm::dot(ab, ab);
+			if (len2 < EPSILON)
+				return a;
+			const float s = glm::clamp(glm::dot(p - a, ab) / len2, 0.f, 1.f);
+			return a + ab * s;
+		}
+		/// @brief 구와 레이의 교차. 시작점이 구 안이면 bInsideHit에 따라 0을 반환하거나 실패한다.
+		auto RaySphere(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& center, float radius, float tMax, bool bInsideHit, float& t) -> bool
+		{
+			const glm::vec3 m = origin - center;
+			const float b = glm::dot(m, dir);
+			const float c = glm::dot(m, m) - radius * radius;
+			if (c <= 0.f)
+			{
+				if (!bInsideHit)
+					return false;
+				t = 0.f;
+				return true;
+			}
+			if (b > 0.f)
+				return false;
+			const float disc = b * b - c;
+			if (disc < 0.f)
+				return false;
+			t = -b - std::sqrt(disc);
+			return t <= tMax;
+		}
+		/// @brief 선분 a-b를 축으로 하는 캡슐과 레이의 교차. 시작점이 캡슐 안이면 bInsideHit에 따라 0을 반환하거나 실패한다.
+		auto RayCapsule(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& a, const glm::vec3& b, float radius, float tMax, bool bInsideHit, float& t) -> bool
+		{
+			const glm::vec3 inside = origin - ClosestOnSegment(origin, a, b);
+			if (glm::dot(inside, inside) <= radius * radius)
+			{
+				if (!bInsideHit)
+					return false;
+				t = 0.f;
+				return true;
+			}
+			bool bHit = false;
+			float best = tMax;
+
+			const glm::vec3 ab = b - a;
+			const float ab2 = glm::dot(ab, ab);
+			if (ab2 > EPSILON)
+			{
+				// 무한 원기둥과의 교차 후 선분 범위 안인지 확인
+				const glm::vec3 ao = origin - a;
+				const glm::vec3 dirPerp = dir - ab * (glm::dot(dir, ab) / ab2);
+				const glm::vec3 originPerp = ao - ab * (glm::dot(ao, ab) / ab2);
+				const float qa = glm::dot(dirPerp, dirPerp);
+				const float qb = glm::dot(originPerp, dirPerp);
+				const float qc = glm::dot(originPerp, originPerp) - radius * radius;
+				if (qa > EPSILON)
+				{
+					const float disc = qb * qb - qa * qc;
+					if (disc >= 0.f)
+					{
+						const float tc = (-qb - std::sqrt(disc)) / qa;
+						const float s = glm::dot(ao + dir * tc, ab) / ab2;
+						if (tc >= 0.f && tc <= best && s >= 0.f && s <= 1.f)
+						{
+							best = tc;
+							bHit = true;
+						}
+					}
+				}
+			}
+			// 양 끝 반구. 캡슐 밖에서 시작했으므로 원기둥 안쪽의 구면에 먼저 닿는 경우는 없다.
+			float ts;
+			if (RaySphere(origin, dir, a, radius, best, false, ts) && ts <= best)
+			{
+				best = ts;
+				bHit = true;
+			}
+			if (RaySphere(origin, dir, b, radius, best, false, ts) && ts <= best)
+			{
+				best = ts;
+				bHit = true;
+			}
+			if (bHit)
+				t = best;
+			return bHit;
+		}
+		/// @brief 원점 중심 박스와 레이의 교차. 시작점이 박스 안이면 실패한다.
+		auto RayBox(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& half, float tMax, float& t, glm::vec3& normal) -> bool
+		{
+			float tNear = -std::numeric_limits<float>::max();
+			float tFar = tMax;
+			int axis = -1;
+			for (int i = 0; i < 3; ++i)
+			{
+				if (std::abs(dir[i]) < EPSILON)
+				{
+					if (origin[i] < -half[i] || origin[i] > half[i])
+						return false;
+					continue;
+				}
+				const float inv = 1.f / dir[i];
+				float t0 = (-half[i] - origin[i]) * inv;
+				float t1 = (half[i] - origin[i]) * inv;
+				if (t0 > t1)
+					std::swap(t0, t1);
+				if (t0 > tNear)
+				{
+					tNear = t0;
+					axis = i;
+				}
+				tFar = std::min(tFar, t1);
+				if (tNear > tFar)
+					return false;
+			}
+			if (axis < 0 || tNear < 0.f)
+				return false;
+			t = tNear;
+			normal = glm::vec3{ 0.f };
+			normal[axis] = dir[axis] > 0.f ? -1.f : 1.f;
+			return true;
+		}
+		/// @brief 원점 중심 박스에 구를 밀어 넣는 교차. (Real-Time Collision Detection 5.5.7)
+		auto SweepSphereBox(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& half, float radius, float tMax, float& t) -> bool
+		{
+			const glm::vec3 closest = glm::clamp(origin, -half, half);
+			const glm::vec3 diff = origin - closest;
+			if (glm::dot(diff, diff) <= radius * radius)
+			{
+				t = 0.f;
+				return true;
+			}
+			glm::vec3 normal;
+			if (!RayBox(origin, dir, half + glm::vec3{ radius }, tMax, t, normal))
+				return false;
+
+			// 확장된 박스의 모서리와 꼭짓점 영역은 실제로 둥근 면이므로 캡슐로 다시 검사한다.
+			const glm::vec3 p = origin + dir * t;
+			int u = 0, v = 0;
+			for (int i = 0; i < 3; ++i)
+			{
+				if (p[i] < -half[i])
+					u |= 1 << i;
+				if (p[i] > half[i])
+					v |= 1 << i;
+			}
+			const int mask = u | v;
+			const int bits = (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1);
+			if (bits <= 1)
+				return true;
+
+			// 바깥쪽 축은 해당 면 쪽 좌표로 고정된다.
+			glm::vec3 vertex;
+			for (int i = 0; i < 3; ++i)
+				vertex[i] = (u & (1 << i)) ? -half[i] : half[i];
+			if (bits == 2)
+			{
+				// 두 축이 바깥이면 나머지 축 방향의 모서리
+				glm::vec3 a = vertex;
+				glm::vec3 b = vertex;
+				for (int i = 0; i < 3; ++i)
+				{
+					if ((mask & (1 << i)) == 0)
+					{
+						a[i] = -half[i];
+						b[i] = half[i];
+					}
+				}
+				return RayCapsule(origin, dir, a, b, radius, tMax, true, t);
+			}
+			// 꼭짓점 영역: 꼭짓점에서 뻗은 세 모서리 중 가장 먼저 닿는 곳
+			bool bHit = false;
+			float best = tMax;
+			for (int i = 0; i < 3; ++i)
+			{
+				glm::vec3 other = vertex;
+				other[i] = -vertex[i];
+				float te;
+				if (RayCapsule(origin, dir, vertex, other, radius, best, true, te) && te <= best)
+				{
+					best = te;
+					bHit = true;
+				}
+			}
+			if (bHit)
+				t = best;
+			return bHit;
+		}
+		/// @brief 원점 중심 박스 위에서 p와 가장 가까운 점 기준의 법선
+		auto BoxNormal(const glm::vec3& p, const glm::vec3& half, const glm::vec3& fallback) -> glm::vec3
+		{
+			const glm::vec3 diff = p - glm::clamp(p, -half, half);
+			const float len2 = glm::dot(diff, diff);
+			if (len2 < EPSILON)
+				return fallback;
+			return diff / std::sqrt(len2);
+		}
+		auto SafeNormalize(const glm::vec3& v, const glm::vec3& fallback) -> glm::vec3
+		{
+			const float len2 = glm::dot(v, v);
+			if (len2 < EPSILON)
+				return fallback;
+			return v / std::sqrt(len2);
+		}
+	}//namespace
+
+	SH_PHYS_API void QuerySnapshot::Clear()
+	{
+		shapes.clear();
+		nodes.clear();
+		bHasBoundsShapes = false;
+	}
+	SH_PHYS_API void QuerySnapshot::AddShape(const Shape& shape)
+	{
+		shapes.push_back(shape);
+		if (shape.type == ShapeType::Bounds)
+			bHasBoundsShapes = true;
+	}
+	SH_PHYS_API void QuerySnapshot::Build()
+	{
+		nodes.clear();
+		if (shapes.empty())
+			return;
+
+		shapeIdxs.resize(shapes.size());
+		std::iota(shapeIdxs.begin(), shapeIdxs.end(), 0);
+
+		nodes.reserve(shapes.size() * 2);
+		nodes.emplace_back();
+		BuildNode(0, 0, static_cast<uint32_t>(shapes.size()));
+
+		// 리프가 모양들을 연속으로 가리키도록 순서를 맞춘다.
+		std::vector<Shape> sorted;
+		sorted.reserve(shapes.size());
+		for (uint32_t idx : shapeIdxs)
+			sorted.push_back(shapes[idx]);
+		shapes = std::move(sorted);
+	}
+	void QuerySnapshot::BuildNode(uint32_t nodeIdx, uint32_t first, uint32_t count)
+	{
+		glm::vec3 min{ std::numeric_limits<float>::max() };
+		glm::vec3 max{ -std::numeric_limits<float>::max() };
+		glm::vec3 centroidMin = min;
+		glm::vec3 centroidMax = max;
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			const Shape& shape = shapes[shapeIdxs[i]];
+			min = glm::min(min, shape.aabbMin);
+			max = glm::max(max, shape.aabbMax);
+			const glm::vec3 centroid = (shape.aabbMin + shape.aabbMax) * 0.5f;
+			centroidMin = glm::min(centroidMin, centroid);
+			centroidMax = glm::max(centroidMax, centroid);
+		}
+		nodes[nodeIdx].min = min;
+		nodes[nodeIdx].max = max;
+
+		const glm::vec3 extent = centroidMax - centroidMin;
+		int axis = 0;
+		if (extent.y > extent[axis])
+			axis = 1;
+		if (extent.z > extent[axis])
+			axis = 2;
+		if (count <= LEAF_SIZE || extent[axis] < EPSILON)
+		{
+			nodes[nodeIdx].leftOrFirst = first;
+			nodes[nodeIdx].count = count;
+			return;
+		}
+
+		const uint32_t mid = first + count / 2;
+		std::nth_element(shapeIdxs.begin() + first, shapeIdxs.begin() + mid, shapeIdxs.begin() + first + count,
+			[&](uint32_t left, uint32_t right)
+			{
+				return shapes[left].aabbMin[axis] + shapes[left].aabbMax[axis] < shapes[right].aabbMin[axis] + shapes[right].aabbMax[axis];
+			}
+		);
+		const uint32_t leftIdx = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+		nodes.emplace_back();
+		nodes[nodeIdx].leftOrFirst = leftIdx;
+		nodes[nodeIdx].count = 0;
+
+		BuildNode(leftIdx, first, mid - first);
+		BuildNode(leftIdx + 1, mid, first + count - mid);
+	}
+	template<typename NodeTestFn, typename LeafFn>
+	void QuerySnapshot::Traverse(NodeTestFn&& nodeTest, LeafFn&& leafFn) const
+	{
+		if (nodes.empty())
+			return;
+
+		uint32_t stack[STACK_SIZE];
+		uint32_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node& node = nodes[stack[--top]];
+			if (!nodeTest(node.min, node.max))
+				continue;
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i)
+				{
+					if (!leafFn(shapes[i]))
+						return;
+				}
+				continue;
+			}
+			stack[top++] = node.leftOrFirst;
+			stack[top++] = node.leftOrFirst + 1;
+		}
+	}
+	SH_PHYS_API auto QuerySnapshot::RayCast(const RayQuery& query, HitPoint& hit) const -> bool
+	{
+		const glm::vec3 dir = SafeNormalize(query.direction, glm::vec3{ 0.f, 0.f, 1.f });
+		const glm::vec3 invDir = SafeInverse(dir);
+		float best = query.distance;
+		bool bHit = false;
+
+		Traverse(
+			[&](const glm::vec3& min, const glm::vec3& max)
+			{
+				return RayAabb(query.origin, invDir, min, max, best);
+			},
+			[&](const Shape& shape)
+			{
+				if ((shape.category & query.allowedTag) == 0)
+					return true;
+
+				float t = 0.f;
+				glm::vec3 normal;
+				if (shape.type == ShapeType::Bounds)
+				{
+					if (nativeRayCast == nullptr)
+						return true;
+					HitPoint nativeHit{};
+					if (!nativeRayCast(shape.nativeCollider, query.origin, query.origin + dir * best, nativeHit))
+						return true;
+					// 네이티브 결과는 현재까지의 최단 거리 기준 비율이다.
+					best *= nativeHit.fraction;
+					hit = nativeHit;
+					hit.rigidBodyHandle = shape.rigidBodyHandle;
+					bHit = true;
+					return true;
+				}
+
+				const glm::quat invRot = glm::conjugate(shape.rotation);
+				const glm::vec3 localOrigin = invRot * (query.origin - shape.position);
+				const glm::vec3 localDir = invRot * dir;
+				bool bShapeHit = false;
+				switch (shape.type)
+				{
+				case ShapeType::Sphere:
+					bShapeHit = RaySphere(localOrigin, localDir, glm::vec3{ 0.f }, shape.extents.x, best, false, t);
+					if (bShapeHit)
+						normal = SafeNormalize(localOrigin + localDir * t, -localDir);
+					break;
+				case ShapeType::Box:
+					bShapeHit = RayBox(localOrigin, localDir, shape.extents, best, t, normal);
+					break;
+				case ShapeType::Capsule:
+				{
+					const glm::vec3 a{ 0.f, -shape.extents.y, 0.f };
+					const glm::vec3 b{ 0.f, shape.extents.y, 0.f };
+					bShapeHit = RayCapsule(localOrigin, localDir, a, b, shape.extents.x, best, false, t);
+					if (bShapeHit)
+					{
+						const glm::vec3 p = localOrigin + localDir * t;
+						normal = SafeNormalize(p - ClosestOnSegment(p, a, b), -localDir);
+					}
+					break;
+				}
+				default:
+					break;
+				}
+				if (!bShapeHit || t > best)
+					return true;
+
+				best = t;
+				hit.hitPoint = query.origin + dir * t;
+				hit.hitNormal = shape.rotation * normal;
+				hit.rigidBodyHandle = shape.rigidBodyHandle;
+				bHit = true;
+				return true;
+			}
+		);
+		if (bHit)
+			hit.fraction = query.distance > 0.f ? best / query.distance : 0.f;
+		return bHit;
+	}
+	SH_PHYS_API auto QuerySnapshot::SphereCast(const SphereCastQuery& query, HitPoint& hit) const -> bool
+	{
+		const glm::vec3 dir = SafeNormalize(query.direction, glm::vec3{ 0.f, 0.f, 1.f });
+		const glm::vec3 invDir = SafeInverse(dir);
+		const glm::vec3 expand{ query.radius };
+		float best = query.distance;
+		bool bHit = false;
+
+		Traverse(
+			[&](const glm::vec3& min, const glm::vec3& max)
+			{
+				return RayAabb(query.origin, invDir, min - expand, max + expand, best);
+			},
+			[&](const Shape& shape)
+			{
+				if ((shape.category & query.allowedTag) == 0)
+					return true;
+
+				float t = 0.f;
+				glm::vec3 normal;
+				bool bShapeHit = false;
+				if (shape.type == ShapeType::Bounds)
+				{
+					// 해석적인 모양이 아니라면 AABB에 대해 보수적으로 검사한다.
+					const glm::vec3 center = (shape.aabbMin + shape.aabbMax) * 0.5f;
+					const glm::vec3 half = (shape.aabbMax - shape.aabbMin) * 0.5f;
+					const glm::vec3 localOrigin = query.origin - center;
+					bShapeHit = SweepSphereBox(localOrigin, dir, half, query.radius, best, t);
+					if (bShapeHit && t <= best)
+					{
+						best = t;
+						normal = BoxNormal(localOrigin + dir * t, half, -dir);
+						hit.hitNormal = normal;
+						hit.hitPoint = query.origin + dir * t - normal * query.radius;
+						hit.rigidBodyHandle = shape.rigidBodyHandle;
+						bHit = true;
+					}
+					return true;
+				}
+
+				const glm::quat invRot = glm::conjugate(shape.rotation);
+				const glm::vec3 localOrigin = invRot * (query.origin - shape.position);
+				const glm::vec3 localDir = invRot * dir;
+				switch (shape.type)
+				{
+				case ShapeType::Sphere:
+					bShapeHit = RaySphere(localOrigin, localDir, glm::vec3{ 0.f }, shape.extents.x + query.radius, best, true, t);
+					if (bShapeHit)
+						normal = SafeNormalize(localOrigin + localDir * t, -localDir);
+					break;
+				case ShapeType::Box:
+					bShapeHit = SweepSphereBox(localOrigin, localDir, shape.extents, query.radius, best, t);
+					if (bShapeHit)
+						normal = BoxNormal(localOrigin + localDir * t, shape.extents, -localDir);
+					break;
+				case ShapeType::Capsule:
+				{
+					const glm::vec3 a{ 0.f, -shape.extents.y, 0.f };
+					const glm::vec3 b{ 0.f, shape.extents.y, 0.f };
+					bShapeHit = RayCapsule(localOrigin, localDir, a, b, shape.extents.x + query.radius, best, true, t);
+					if (bShapeHit)
+					{
+						const glm::vec3 p = localOrigin + localDir * t;
+						normal = SafeNormalize(p - ClosestOnSegment(p, a, b), -localDir);
+					}
+					break;
+				}
+				default:
+					break;
+				}
+				if (!bShapeHit || t > best)
+					return true;
+
+				best = t;
+				hit.hitNormal = shape.rotation * normal;
+				hit.hitPoint = query.origin + dir * t - hit.hitNormal * query.radius;
+				hit.rigidBodyHandle = shape.rigidBodyHandle;
+				bHit = true;
+				return true;
+			}
+		);
+		if (bHit)
+			hit.fraction = query.distance > 0.f ? best / query.distance : 0.f;
+		return bHit;
+	}
+	SH_PHYS_API auto QuerySnapshot::Overlap(const OverlapQuery& query, void** bodies, uint32_t maxBodies) const -> uint32_t
+	{
+		uint32_t count = 0;
+		if (maxBodies == 0)
+			return 0;
+
+		Traverse(
+			[&](const glm::vec3& min, const glm::vec3& max)
+			{
+				return SphereAabb(query.center, query.radius, min, max);
+			},
+			[&](const Shape& shape)
+			{
+				if ((shape.category & query.allowedTag) == 0)
+					return true;
+				// 한 강체에 여러 충돌체가 있을 수 있다.
+				if (std::find(bodies, bodies + count, shape.rigidBodyHandle) != bodies + count)
+					return true;
+
+				const glm::vec3 localCenter = glm::conjugate(shape.rotation) * (query.center - shape.position);
+				bool bOverlap = false;
+				switch (shape.type)
+				{
+				case ShapeType::Sphere:
+				{
+					const float radius = shape.extents.x + query.radius;
+					bOverlap = glm::dot(localCenter, localCenter) <= radius * radius;
+					break;
+				}
+				case ShapeType::Box:
+					bOverlap = SphereAabb(localCenter, query.radius, -shape.extents, shape.extents);
+					break;
+				case ShapeType::Capsule:
+				{
+					const glm::vec3 diff = localCenter - ClosestOnSegment(localCenter, glm::vec3{ 0.f, -shape.extents.y, 0.f }, glm::vec3{ 0.f, shape.extents.y, 0.f });
+					const float radius = shape.extents.x + query.radius;
+					bOverlap = glm::dot(diff, diff) <= radius * radius;
+					break;
+				}
+				default:
+					bOverlap = SphereAabb(query.center, query.radius, shape.aabbMin, shape.aabbMax);
+					break;
+				}
+				if (!bOverlap)
+					return true;
+				bodies[count++] = shape.rigidBodyHandle;
+				return count < maxBodies;
+			}
+		);
+		return count;
+	}
+}//namespace
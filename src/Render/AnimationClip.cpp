@@ -0,0 +1,271 @@
+﻿#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SH_ANIMATION_CLIP_SSE2 1
+#include <emmintrin.h>
+#endif
+namespace sh::render
+{
+	namespace
+	{
+		constexpr float QUANTIZE_MAX = 65535.f;
+		/// @brief 두 쿼터니언의 내적이 이보다 크면 구면 보간 대신 선형 보간한다.
+		constexpr float SLERP_THRESHOLD = 0.9995f;
+
+		/// @brief 커브의 time 값. 회전 커브는 가까운 쪽으로 구면 보간한다.
+		auto EvaluateCurve(const AnimationClip::RawCurve& curve, float time, bool bRotation) -> glm::vec4
+		{
+			const std::size_t count = std::min(curve.times.size(), curve.values.size());
+			if (count == 0)
+				return curve.values.empty() ? glm::vec4{ 0.f } : curve.values.front();
+			if (time <= curve.times.front())
+				return curve.values.front();
+			if (time >= curve.times[count - 1])
+				return curve.values[count - 1];
+
+			const std::size_t next = std::upper_bound(curve.times.begin(), curve.times.begin() + count, time) - curve.times.begin();
+			const std::size_t prev = next - 1;
+			if (curve.bStep)
+				return curve.values[prev];
+
+			const float span = curve.times[next] - curve.times[prev];
+			const float alpha = span > 0.f ? (time - curve.times[prev]) / span : 0.f;
+			const glm::vec4& a = curve.values[prev];
+			glm::vec4 b = curve.values[next];
+			if (!bRotation)
+				return a + (b - a) * alpha;
+
+			// glTF의 회전 선형 보간은 구면 선형 보간이다.
+			float cosTheta = glm::dot(a, b);
+			if (cosTheta < 0.f)
+			{
+				b = -b;
+				cosTheta = -cosTheta;
+			}
+			glm::vec4 result{};
+			if (cosTheta > SLERP_THRESHOLD)
+				result = a + (b - a) * alpha;
+			else
+			{
+				const float theta = std::acos(cosTheta);
+				const float sinTheta = std::sin(theta);
+				result = a * (std::sin((1.f - alpha) * theta) / sinTheta) + b * (std::sin(alpha * theta) / sinTheta);
+			}
+			const float length = std::sqrt(glm::dot(result, result));
+			if (length > 0.f)
+				result /= length;
+			return result;
+		}
+	}//namespace
+
+	SH_RENDER_API AnimationClip::AnimationClip() = default;
+	SH_RENDER_API AnimationClip::~AnimationClip() = default;
+
+	SH_RENDER_API void AnimationClip::Compress(const std::vector<RawTrack>& tracks, float duration, float sampleRate, float tolerance)
+	{
+		data = Data{};
+		data.sampleRate = sampleRate > 0.f ? sampleRate : DEFAULT_SAMPLE_RATE;
+		if (duration <= 0.f)
+		{
+			duration = 0.f;
+			for (const RawTrack& track : tracks)
+			{
+				for (const RawCurve* curve : { &track.translation, &track.rotation, &track.scale })
+				{
+					if (!curve->times.empty())
+						duration = std::max(duration, curve->times.back());
+				}
+			}
+		}
+		data.duration = duration;
+		data.frameCount = static_cast<uint32_t>(std::ceil(duration * data.sampleRate - 1e-3f)) + 1;
+
+		struct AnimatedChannel
+		{
+			CurveTarget target;
+			float min;
+			float max;
+			std::vector<float> samples;
+		};
+		std::vector<AnimatedChannel> animated;
+		std::vector<glm::vec4> samples(data.frameCount);
+
+		for (std::size_t trackIdx = 0; trackIdx < tracks.size(); ++trackIdx)
+		{
+			const RawTrack& track = tracks[trackIdx];
+			data.trackNames.push_back(track.name);
+
+			const struct
+			{
+				const RawCurve& curve;
+				uint32_t firstChannel;
+				uint32_t componentCount;
+			} curves[3] =
+			{
+				{ track.translation, AnimationPose::TranslationX, 3 },
+				{ track.rotation, AnimationPose::RotationX, 4 },
+				{ track.scale, AnimationPose::ScaleX, 3 }
+			};
+			for (const auto& [curve, firstChannel, componentCount] : curves)
+			{
+				if (curve.values.empty())
+					continue;
+				const bool bRotation = firstChannel == AnimationPose::RotationX;
+				for (uint32_t frame = 0; frame < data.frameCount; ++frame)
+				{
+					const float time = std::min(frame / data.sampleRate, duration);
+					samples[frame] = EvaluateCurve(curve, time, bRotation);
+					// 이웃한 프레임끼리 선형 보간할 수 있도록 쿼터니언을 같은 반구로 맞춘다.
+					if (bRotation && frame > 0 && glm::dot(samples[frame - 1], samples[frame]) < 0.f)
+						samples[frame] = -samples[frame];
+				}
+				for (uint32_t component = 0; component < componentCount; ++component)
+				{
+					float min = std::numeric_limits<float>::max();
+					float max = std::numeric_limits<float>::lowest();
+					for (const glm::vec4& sample : samples)
+					{
+						min = std::min(min, sample[component]);
+						max = std::max(max, sample[component]);
+					}
+					const CurveTarget target{ static_cast<uint32_t>(trackIdx), firstChannel + component };
+					if (max - min <= tolerance)
+					{
+						data.constantTargets.push_back(target);
+						data.constantValues.push_back((min + max) * 0.5f);
+						continue;
+					}
+					AnimatedChannel& channel = animated.emplace_back();
+					channel.target = target;
+					channel.min = min;
+					channel.max = max;
+					channel.samples.resize(samples.size());
+					for (std::size_t frame = 0; frame < samples.size(); ++frame)
+						channel.samples[frame] = samples[frame][component];
+				}
+			}
+		}
+
+		const std::size_t animatedCount = animated.size();
+		data.animatedTargets.reserve(animatedCount);
+		data.animatedMin.reserve(animatedCount);
+		data.animatedScale.reserve(animatedCount);
+		data.frames.resize(animatedCount * data.frameCount);
+		for (std::size_t i = 0; i < animatedCount; ++i)
+		{
+			const AnimatedChannel& channel = animated[i];
+			const float scale = (channel.max - channel.min) / QUANTIZE_MAX;
+			data.animatedTargets.push_back(channel.target);
+			data.animatedMin.push_back(channel.min);
+			data.animatedScale.push_back(scale);
+			for (uint32_t frame = 0; frame < data.frameCount; ++frame)
+			{
+				const float quantized = std::round((channel.samples[frame] - channel.min) / scale);
+				data.frames[frame * animatedCount + i] = static_cast<uint16_t>(std::clamp(quantized, 0.f, QUANTIZE_MAX));
+			}
+		}
+	}
+	SH_RENDER_API void AnimationClip::SetData(Data data)
+	{
+		this->data = std::move(data);
+	}
+	SH_RENDER_API auto AnimationClip::Bind(const Skeleton& skeleton) const -> Binding
+	{
+		Binding binding{};
+		binding.poseStride = AnimationPose::CalcStride(skeleton.joints.size());
+
+		std::vector<int> trackJoints(data.trackNames.size(), -1);
+		for (std::size_t i = 0; i < data.trackNames.size(); ++i)
+			trackJoints[i] = skeleton.FindJoint(data.trackNames[i]);
+
+		const auto toDst =
+			[&](const CurveTarget& target) -> uint32_t
+			{
+				if (target.track >= trackJoints.size() || trackJoints[target.track] < 0 || target.channel >= AnimationPose::ChannelCount)
+					return INVALID;
+				return static_cast<uint32_t>(target.channel * binding.poseStride + trackJoints[target.track]);
+			};
+		binding.constantDst.reserve(data.constantTargets.size());
+		for (const CurveTarget& target : data.constantTargets)
+			binding.constantDst.push_back(toDst(target));
+		binding.animatedDst.reserve(data.animatedTargets.size());
+		for (const CurveTarget& target : data.animatedTargets)
+			binding.animatedDst.push_back(toDst(target));
+		return binding;
+	}
+	SH_RENDER_API void AnimationClip::Sample(float time, bool bLoop, const Binding& binding, AnimationPose& pose) const
+	{
+		if (binding.poseStride != pose.GetStride())
+			return;
+		float* const poseData = pose.GetData();
+
+		const std::size_t constantCount = std::min(binding.constantDst.size(), data.constantValues.size());
+		for (std::size_t i = 0; i < constantCount; ++i)
+		{
+			if (binding.constantDst[i] != INVALID)
+				poseData[binding.constantDst[i]] = data.constantValues[i];
+		}
+
+		const std::size_t animatedCount = data.animatedTargets.size();
+		if (animatedCount > 0 && data.frameCount > 0 && binding.animatedDst.size() == animatedCount)
+		{
+			if (bLoop && data.duration > 0.f)
+			{
+				time = std::fmod(time, data.duration);
+				if (time < 0.f)
+					time += data.duration;
+			}
+			else
+				time = std::clamp(time, 0.f, data.duration);
+
+			const float framePos = time * data.sampleRate;
+			const uint32_t frame0 = std::min(static_cast<uint32_t>(framePos), data.frameCount - 1);
+			const uint32_t frame1 = std::min(frame0 + 1, data.frameCount - 1);
+			const float alpha = std::clamp(framePos - static_cast<float>(frame0), 0.f, 1.f);
+
+			const uint16_t* const row0 = data.frames.data() + frame0 * animatedCount;
+			const uint16_t* const row1 = data.frames.data() + frame1 * animatedCount;
+			const float* const mins = data.animatedMin.data();
+			const float* const scales = data.animatedScale.data();
+
+			thread_local std::vector<float> values;
+			values.resize(animatedCount);
+
+			// 두 프레임의 양자화 값을 보간한 뒤 복원한다.
+			std::size_t i = 0;
+#if SH_ANIMATION_CLIP_SSE2
+			const __m128 alphaVec = _mm_set1_ps(alpha);
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 8 <= animatedCount; i += 8)
+			{
+				const __m128i q0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i));
+				const __m128i q1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i));
+				const __m128 a[2] = { _mm_cvtepi32_ps(_mm_unpacklo_epi16(q0, zero)), _mm_cvtepi32_ps(_mm_unpackhi_epi16(q0, zero)) };
+				const __m128 b[2] = { _mm_cvtepi32_ps(_mm_unpacklo_epi16(q1, zero)), _mm_cvtepi32_ps(_mm_unpackhi_epi16(q1, zero)) };
+				for (int half = 0; half < 2; ++half)
+				{
+					const std::size_t idx = i + half * 4;
+					const __m128 q = _mm_add_ps(a[half], _mm_mul_ps(_mm_sub_ps(b[half], a[half]), alphaVec));
+					_mm_storeu_ps(values.data() + idx, _mm_add_ps(_mm_loadu_ps(mins + idx), _mm_mul_ps(q, _mm_loadu_ps(scales + idx))));
+				}
+			}
+#endif
+			for (; i < animatedCount; ++i)
+			{
+				const float q = row0[i] + (static_cast<float>(row1[i]) - row0[i]) * alpha;
+				values[i] = mins[i] + q * scales[i];
+			}
+
+			for (std::size_t k = 0; k < animatedCount; ++k)
+			{
+				if (binding.animatedDst[k] != INVALID)
+					poseData[binding.animatedDst[k]] = values[k];
+			}
+		}
+		pose.NormalizeRotations();
+	}
+}//namespace
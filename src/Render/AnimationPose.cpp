@@ -0,0 +1,248 @@
+﻿#include "AnimationPose.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SH_ANIMATION_POSE_SSE2 1
+#include <emmintrin.h>
+#endif
+namespace sh::render
+{
+	namespace
+	{
+		constexpr std::size_t LANES = 4;
+		constexpr float MIN_QUAT_LENGTH = 1e-12f;
+
+		/// @brief 조인트 로컬 행렬의 3x4 성분을 SoA로 담는 임시 버퍼
+		struct LocalMatrices
+		{
+			std::vector<float> data;
+			std::size_t stride = 0;
+
+			auto At(int element) -> float* { return data.data() + element * stride; }
+		};
+
+		inline void ComposeScalar(const float* t[3], const float* q[4], const float* s[3], std::size_t j, float* m[12])
+		{
+			const float x = q[0][j], y = q[1][j], z = q[2][j], w = q[3][j];
+			const float xx = x * x, yy = y * y, zz = z * z;
+			const float xy = x * y, xz = x * z, yz = y * z;
+			const float wx = w * x, wy = w * y, wz = w * z;
+
+			m[0][j] = (1.f - 2.f * (yy + zz)) * s[0][j];
+			m[1][j] = 2.f * (xy + wz) * s[0][j];
+			m[2][j] = 2.f * (xz - wy) * s[0][j];
+			m[3][j] = 2.f * (xy - wz) * s[1][j];
+			m[4][j] = (1.f - 2.f * (xx + zz)) * s[1][j];
+			m[5][j] = 2.f * (yz + wx) * s[1][j];
+			m[6][j] = 2.f * (xz + wy) * s[2][j];
+			m[7][j] = 2.f * (yz - wx) * s[2][j];
+			m[8][j] = (1.f - 2.f * (xx + yy)) * s[2][j];
+			m[9][j] = t[0][j];
+			m[10][j] = t[1][j];
+			m[11][j] = t[2][j];
+		}
+	}//namespace
+
+	SH_RENDER_API AnimationPose::AnimationPose(std::size_t jointCount)
+	{
+		Resize(jointCount);
+	}
+	SH_RENDER_API void AnimationPose::Resize(std::size_t jointCount)
+	{
+		this->jointCount = jointCount;
+		stride = CalcStride(jointCount);
+		data.assign(ChannelCount * stride, 0.f);
+		// 남는 자리도 항등 포즈로 둬야 정규화에서 0으로 나누지 않는다.
+		std::fill_n(GetChannel(RotationW), stride, 1.f);
+		std::fill_n(GetChannel(ScaleX), stride * 3, 1.f);
+	}
+	SH_RENDER_API void AnimationPose::SetRestPose(const Skeleton& skeleton)
+	{
+		if (jointCount != skeleton.joints.size())
+			Resize(skeleton.joints.size());
+		for (std::size_t j = 0; j < jointCount; ++j)
+		{
+			const Skeleton::Joint& joint = skeleton.joints[j];
+			for (int i = 0; i < 3; ++i)
+			{
+				GetChannel(TranslationX + i)[j] = joint.restTranslation[i];
+				GetChannel(ScaleX + i)[j] = joint.restScale[i];
+			}
+			for (int i = 0; i < 4; ++i)
+				GetChannel(RotationX + i)[j] = joint.restRotation[i];
+		}
+	}
+	SH_RENDER_API void AnimationPose::NormalizeRotations()
+	{
+		float* const qx = GetChannel(RotationX);
+		float* const qy = GetChannel(RotationY);
+		float* const qz = GetChannel(RotationZ);
+		float* const qw = GetChannel(RotationW);
+
+		std::size_t j = 0;
+#if SH_ANIMATION_POSE_SSE2
+		const __m128 minLength = _mm_set1_ps(MIN_QUAT_LENGTH);
+		for (; j + LANES <= stride; j += LANES)
+		{
+			const __m128 x = _mm_loadu_ps(qx + j);
+			const __m128 y = _mm_loadu_ps(qy + j);
+			const __m128 z = _mm_loadu_ps(qz + j);
+			const __m128 w = _mm_loadu_ps(qw + j);
+			const __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+			const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), _mm_max_ps(_mm_sqrt_ps(lengthSqr), minLength));
+			_mm_storeu_ps(qx + j, _mm_mul_ps(x, invLength));
+			_mm_storeu_ps(qy + j, _mm_mul_ps(y, invLength));
+			_mm_storeu_ps(qz + j, _mm_mul_ps(z, invLength));
+			_mm_storeu_ps(qw + j, _mm_mul_ps(w, invLength));
+		}
+#endif
+		for (; j < stride; ++j)
+		{
+			const float length = std::sqrt(qx[j] * qx[j] + qy[j] * qy[j] + qz[j] * qz[j] + qw[j] * qw[j]);
+			const float invLength = 1.f / std::max(length, MIN_QUAT_LENGTH);
+			qx[j] *= invLength;
+			qy[j] *= invLength;
+			qz[j] *= invLength;
+			qw[j] *= invLength;
+		}
+	}
+	SH_RENDER_API void AnimationPose::ComputeModelMatrices(const Skeleton& skeleton, glm::mat4* out) const
+	{
+		const std::size_t count = std::min(jointCount, skeleton.joints.size());
+		if (count == 0)
+			return;
+
+		// 로컬 행렬은 조인트끼리 독립이므로 SoA 그대로 4개씩 만든다.
+		thread_local LocalMatrices locals;
+		locals.stride = stride;
+		locals.data.resize(12 * stride);
+
+		const float* t[3] = { GetChannel(TranslationX), GetChannel(TranslationY), GetChannel(TranslationZ) };
+		const float* q[4] = { GetChannel(RotationX), GetChannel(RotationY), GetChannel(RotationZ), GetChannel(RotationW) };
+		const float* s[3] = { GetChannel(ScaleX), GetChannel(ScaleY), GetChannel(ScaleZ) };
+		float* m[12];
+		for (int i = 0; i < 12; ++i)
+			m[i] = locals.At(i);
+
+		std::size_t j = 0;
+#if SH_ANIMATION_POSE_SSE2
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 two = _mm_set1_ps(2.f);
+		for (; j + LANES <= count; j += LANES)
+		{
+			const __m128 x = _mm_loadu_ps(q[0] + j);
+			const __m128 y = _mm_loadu_ps(q[1] + j);
+			const __m128 z = _mm_loadu_ps(q[2] + j);
+			const __m128 w = _mm_loadu_ps(q[3] + j);
+			const __m128 sx = _mm_loadu_ps(s[0] + j);
+			const __m128 sy = _mm_loadu_ps(s[1] + j);
+			const __m128 sz = _mm_loadu_ps(s[2] + j);
+
+			const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+			const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+			const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+			_mm_storeu_ps(m[0] + j, _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx));
+			_mm_storeu_ps(m[1] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx));
+			_mm_storeu_ps(m[2] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx));
+			_mm_storeu_ps(m[3] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy));
+			_mm_storeu_ps(m[4] + j, _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy));
+			_mm_storeu_ps(m[5] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy));
+			_mm_storeu_ps(m[6] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz));
+			_mm_storeu_ps(m[7] + j, _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz));
+			_mm_storeu_ps(m[8] + j, _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz));
+			_mm_storeu_ps(m[9] + j, _mm_loadu_ps(t[0] + j));
+			_mm_storeu_ps(m[10] + j, _mm_loadu_ps(t[1] + j));
+			_mm_storeu_ps(m[11] + j, _mm_loadu_ps(t[2] + j));
+		}
+#endif
+		for (; j < count; ++j)
+			ComposeScalar(t, q, s, j, m);
+
+		// 부모가 먼저 계산되도록 order 순서로 계층을 내려간다.
+		const bool bOrdered = skeleton.order.size() == skeleton.joints.size();
+		for (std::size_t i = 0; i < skeleton.joints.size(); ++i)
+		{
+			const uint32_t jointIdx = bOrdered ? skeleton.order[i] : static_cast<uint32_t>(i);
+			if (jointIdx >= count)
+				continue;
+
+			glm::mat4 local{ 1.f };
+			for (int col = 0; col < 4; ++col)
+			{
+				for (int row = 0; row < 3; ++row)
+					local[col][row] = m[col * 3 + row][jointIdx];
+			}
+			const Skeleton::Joint& joint = skeleton.joints[jointIdx];
+			if (joint.parentIdx >= 0 && static_cast<std::size_t>(joint.parentIdx) < count)
+				out[jointIdx] = out[joint.parentIdx] * joint.parentMat * local;
+			else
+				out[jointIdx] = joint.parentMat * local;
+		}
+	}
+	SH_RENDER_API void AnimationPose::Blend(const AnimationPose& a, const AnimationPose& b, float weight, AnimationPose& out, const float* jointWeights)
+	{
+		const std::size_t stride = std::min(a.stride, b.stride);
+		if (out.stride != stride)
+			out.Resize(std::min(a.jointCount, b.jointCount));
+
+		const float* aq[4] = { a.GetChannel(RotationX), a.GetChannel(RotationY), a.GetChannel(RotationZ), a.GetChannel(RotationW) };
+		const float* bq[4] = { b.GetChannel(RotationX), b.GetChannel(RotationY), b.GetChannel(RotationZ), b.GetChannel(RotationW) };
+		float* oq[4] = { out.GetChannel(RotationX), out.GetChannel(RotationY), out.GetChannel(RotationZ), out.GetChannel(RotationW) };
+		constexpr uint32_t linearChannels[6] = { TranslationX, TranslationY, TranslationZ, ScaleX, ScaleY, ScaleZ };
+
+		std::size_t j = 0;
+#if SH_ANIMATION_POSE_SSE2
+		const __m128 weightVec = _mm_set1_ps(weight);
+		const __m128 signBit = _mm_set1_ps(-0.f);
+		const __m128 zero = _mm_setzero_ps();
+		for (; j + LANES <= stride; j += LANES)
+		{
+			const __m128 w = jointWeights != nullptr ? _mm_mul_ps(weightVec, _mm_loadu_ps(jointWeights + j)) : weightVec;
+			for (uint32_t channel : linearChannels)
+			{
+				const __m128 va = _mm_loadu_ps(a.GetChannel(channel) + j);
+				const __m128 vb = _mm_loadu_ps(b.GetChannel(channel) + j);
+				_mm_storeu_ps(out.GetChannel(channel) + j, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), w)));
+			}
+			__m128 qa[4], qb[4];
+			__m128 dot = zero;
+			for (int i = 0; i < 4; ++i)
+			{
+				qa[i] = _mm_loadu_ps(aq[i] + j);
+				qb[i] = _mm_loadu_ps(bq[i] + j);
+				dot = _mm_add_ps(dot, _mm_mul_ps(qa[i], qb[i]));
+			}
+			// 내적이 음수인 조인트는 b의 부호를 뒤집는다.
+			const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+			for (int i = 0; i < 4; ++i)
+			{
+				const __m128 vb = _mm_xor_ps(qb[i], flip);
+				_mm_storeu_ps(oq[i] + j, _mm_add_ps(qa[i], _mm_mul_ps(_mm_sub_ps(vb, qa[i]), w)));
+			}
+		}
+#endif
+		for (; j < stride; ++j)
+		{
+			const float w = jointWeights != nullptr ? weight * jointWeights[j] : weight;
+			for (uint32_t channel : linearChannels)
+			{
+				const float va = a.GetChannel(channel)[j];
+				out.GetChannel(channel)[j] = va + (b.GetChannel(channel)[j] - va) * w;
+			}
+			float dot = 0.f;
+			for (int i = 0; i < 4; ++i)
+				dot += aq[i][j] * bq[i][j];
+			const float sign = dot < 0.f ? -1.f : 1.f;
+			for (int i = 0; i < 4; ++i)
+				oq[i][j] = aq[i][j] + (bq[i][j] * sign - aq[i][j]) * w;
+		}
+		out.NormalizeRotations();
+	}
+	SH_RENDER_API auto AnimationPose::CalcStride(std::size_t jointCount) -> std::size_t
+	{
+		return (jointCount + LANES - 1) / LANES * LANES;
+	}
+}//namespace
@@ -1,5 +1,6 @@
 ﻿#include "Drawable.h"
 #include "SkinnedMesh.h"
+#include "RenderData.h"
 
 #include "Core/ThreadSyncManager.h"
 
@@ -19,6 +20,12 @@ namespace sh::render
 		priority[core::ThreadType::Game] = 0;
 		priority[core::ThreadType::Render] = 0;
 
+		shadowLod[core::ThreadType::Game] = 0;
+		shadowLod[core::ThreadType::Render] = 0;
+
+		skinOffset[core::ThreadType::Game] = 0;
+		skinOffset[core::ThreadType::Render] = 0;
+
 		if (mesh.GetType().IsChildOf(SkinnedMesh::GetStaticType()))
 			bSkinned = true;
 	}
@@ -30,9 +37,14 @@ namespace sh::render
 		topology(other.topology),
 		subMeshIndex(other.subMeshIndex),
 		syncDatas(other.syncDatas),
+		lods(std::move(other.lods)),
+		shadowLod(other.shadowLod),
+		skinOffset(other.skinOffset),
 		bSkinned(other.bSkinned),
 		bDirty(other.bDirty),
-		bMatrixDirty(other.bMatrixDirty)
+		bMatrixDirty(other.bMatrixDirty),
+		bLodDirty(other.bLodDirty),
+		bSkinOffsetDirty(other.bSkinOffsetDirty)
 	{
 		other.bDirty = false;
 	}
@@ -104,6 +116,33 @@ namespace sh::render
 		subMeshIndex = idx;
 	}
 
+	SH_RENDER_API void Drawable::SetLods(const std::vector<uint8_t>& lods, uint8_t shadowLod)
+	{
+		assert(core::ThreadSyncManager::IsMainThread());
+		if (this->lods[core::ThreadType::Game] == lods && this->shadowLod[core::ThreadType::Game] == shadowLod)
+			return;
+		this->lods[core::ThreadType::Game] = lods;
+		this->shadowLod[core::ThreadType::Game] = shadowLod;
+		bLodDirty = true;
+		SyncDirty();
+	}
+	SH_RENDER_API void Drawable::SetSkinOffset(uint32_t offset)
+	{
+		assert(core::ThreadSyncManager::IsMainThread());
+		if (skinOffset[core::ThreadType::Game] == offset)
+			return;
+		skinOffset[core::ThreadType::Game] = offset;
+		bSkinOffsetDirty = true;
+		SyncDirty();
+	}
+	SH_RENDER_API auto Drawable::GetLod(uint32_t lodSlot) const -> uint32_t
+	{
+		if (lodSlot == RenderViewer::SHADOW_LOD_SLOT)
+			return shadowLod[core::ThreadType::Render];
+		const std::vector<uint8_t>& renderLods = lods[core::ThreadType::Render];
+		return lodSlot < renderLods.size() ? renderLods[lodSlot] : 0;
+	}
+
 	SH_RENDER_API auto Drawable::CheckAssetValid() const -> bool
 	{
 		return core::IsValid(mesh) && core::IsValid(mat) && core::IsValid(mesh);
@@ -149,6 +188,15 @@ namespace sh::render
 		if (bMatrixDirty)
 			std::swap(modelMatrix[core::ThreadType::Game], modelMatrix[core::ThreadType::Render]);
 		bMatrixDirty = false;
+		if (bLodDirty)
+		{
+			lods[core::ThreadType::Render] = lods[core::ThreadType::Game];
+			shadowLod[core::ThreadType::Render] = shadowLod[core::ThreadType::Game];
+		}
+		bLodDirty = false;
+		if (bSkinOffsetDirty)
+			skinOffset[core::ThreadType::Render] = skinOffset[core::ThreadType::Game];
+		bSkinOffsetDirty = false;
 		bDirty = false;
 	}
 }//namespace
\ No newline at end of file
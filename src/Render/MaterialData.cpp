@@ -9,6 +9,7 @@
 #include "Core/Logger.h"
 
 #include "Render/RenderDataManager.h"
+#include "Render/SkinPaletteBuffer.h"
 
 namespace sh::render
 {
@@ -163,6 +164,12 @@ namespace sh::render
 				PassData passData{};
 				uint32_t maxSet = 0;
 				std::vector<uint32_t> sets;
+				// 스키닝 행렬은 모든 메쉬가 공유하는 버퍼를 쓴다.
+				const auto isSkinFn =
+					[&shaderPass](uint32_t set, uint32_t binding)
+					{
+						return set == static_cast<uint32_t>(UniformStructLayout::Usage::Object) && static_cast<int>(binding) == shaderPass.GetSkinBinding();
+					};
 				// 버퍼 (텍스쳐외 모든 GPU에 저장할 데이터)
 				for (const std::vector<UniformStructLayout>* layouts : { &shaderPass.GetVertexUniforms(), &shaderPass.GetFragmentUniforms() })
 				{
@@ -184,7 +191,7 @@ namespace sh::render
 						if (bindingBuffers.size() <= uniformLayout.binding)
 							bindingBuffers.resize(uniformLayout.binding + 1);
 
-						if (set == 0) // 카메라 데이터는 다른 곳에서 관리한다.
+						if (set == 0 || isSkinFn(set, uniformLayout.binding)) // 카메라, 스키닝 데이터는 다른 곳에서 관리한다.
 							continue;
 
 						BufferFactory::CreateInfo info{};
@@ -216,7 +223,11 @@ namespace sh::render
 					const std::vector<std::unique_ptr<IBuffer>>& bufferVec = it->second;
 					for (uint32_t binding = 0; binding < bufferVec.size(); ++binding)
 					{
-						if (set != 0) // 카메라 데이터는 다른 곳에서 관리한다.
+						if (isSkinFn(set, binding))
+						{
+							passData.shaderBindings[set]->Link(binding, *context.GetSkinPaletteBuffer().GetBuffer());
+						}
+						else if (set != 0) // 카메라 데이터는 다른 곳에서 관리한다.
 						{
 							if (bufferVec[binding] == nullptr)
 								continue;
@@ -1,10 +1,19 @@
 ﻿#include "Mesh.h"
 #include "VertexBufferFactory.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 
 #include "Core/Logger.h"
 
+#include <algorithm>
 namespace sh::render
 {
+	namespace
+	{
+		/// @brief LOD 단순화에서 허용하는 최대 오차 (AABB 긴 변 대비)
+		constexpr float LOD_MAX_ERROR = 0.1f;
+	}
+
 	Mesh::Mesh() :
 		topology(Topology::Face)
 	{
@@ -12,7 +21,10 @@ namespace sh::render
 	Mesh::Mesh(const Mesh& other) :
 		verts(other.verts), indices(other.indices), faces(other.faces),
 		topology(other.topology), 
-		bounding(other.bounding)
+		bounding(other.bounding),
+		dequantization(other.dequantization), bQuantize(other.bQuantize),
+		lodIndices(other.lodIndices), lods(other.lods),
+		lodRatios(other.lodRatios), lodScreenSizes(other.lodScreenSizes)
 	{
 		buffer = other.buffer->Clone();
 	}
@@ -20,7 +32,10 @@ namespace sh::render
 		verts(std::move(other.verts)), indices(std::move(other.indices)), faces(std::move(other.faces)),
 		buffer(std::move(other.buffer)),
 		topology(other.topology),
-		bounding(std::move(other.bounding))
+		bounding(std::move(other.bounding)),
+		dequantization(other.dequantization), bQuantize(other.bQuantize),
+		lodIndices(std::move(other.lodIndices)), lods(std::move(other.lods)),
+		lodRatios(std::move(other.lodRatios)), lodScreenSizes(std::move(other.lodScreenSizes))
 	{
 	}
 	Mesh::~Mesh()
@@ -38,6 +53,12 @@ namespace sh::render
 
 		topology = other.topology;
 		bounding = other.bounding;
+		dequantization = other.dequantization;
+		bQuantize = other.bQuantize;
+		lodIndices = other.lodIndices;
+		lods = other.lods;
+		lodRatios = other.lodRatios;
+		lodScreenSizes = other.lodScreenSizes;
 
 		return *this;
 	}
@@ -50,6 +71,12 @@ namespace sh::render
 		buffer = std::move(other.buffer);
 		topology = other.topology;
 		bounding = std::move(other.bounding);
+		dequantization = other.dequantization;
+		bQuantize = other.bQuantize;
+		lodIndices = std::move(other.lodIndices);
+		lods = std::move(other.lods);
+		lodRatios = std::move(other.lodRatios);
+		lodScreenSizes = std::move(other.lodScreenSizes);
 		
 		return *this;
 	}
@@ -73,11 +100,45 @@ namespace sh::render
 
 	SH_RENDER_API void Mesh::Build(const IRenderContext& context)
 	{
+		this->context = &context;
+
 		CreateFace();
 
+		if (bQuantize)
+			dequantization = MeshOptimizer::CalcDequantization(verts);
+		else
+			dequantization = Dequantization{};
+
 		buffer = VertexBufferFactory::Create(context, *this);
 	}
 
+	SH_RENDER_API void Mesh::SetQuantize(bool bQuantize)
+	{
+		if (this->bQuantize == bQuantize)
+			return;
+		this->bQuantize = bQuantize;
+		if (context != nullptr && buffer != nullptr)
+			Build(*context);
+	}
+	SH_RENDER_API void Mesh::Deserialize(const core::Json& json)
+	{
+		Super::Deserialize(json);
+
+		bool bRatioChanged = lodRatios.size() != lods.size();
+		for (std::size_t i = 0; i < lods.size() && !bRatioChanged; ++i)
+			bRatioChanged = lods[i].ratio != lodRatios[i];
+
+		if (!bRatioChanged)
+		{
+			for (std::size_t i = 0; i < lods.size(); ++i)
+				lods[i].screenSize = i < lodScreenSizes.size() ? lodScreenSizes[i] : lods[i].screenSize;
+			return;
+		}
+		GenerateLods();
+		if (context != nullptr && buffer != nullptr)
+			Build(*context);
+	}
+
 	SH_RENDER_API void Mesh::CalculateTangents()
 	{
 		for (size_t i = 0; i < indices.size(); i += 3) 
@@ -114,12 +175,103 @@ namespace sh::render
 			v.tangent = glm::normalize(v.tangent);
 	}
 
+	SH_RENDER_API void Mesh::GenerateLods()
+	{
+		lodIndices.clear();
+		lods.clear();
+		if (topology != Topology::Face || indices.size() < 3)
+			return;
+
+		std::vector<SubMesh> ranges = subMeshes;
+		if (ranges.empty())
+			ranges.push_back(SubMesh{ 0, indices.size() });
+
+		// 서브 메쉬별 직전 LOD의 인덱스
+		std::vector<std::vector<uint32_t>> sources(ranges.size());
+		for (std::size_t i = 0; i < ranges.size(); ++i)
+		{
+			const auto begin = indices.begin() + ranges[i].indexOffset;
+			sources[i].assign(begin, begin + ranges[i].indexCount);
+		}
+
+		lods.reserve(lodRatios.size());
+		float screenSize = 1.f;
+		for (std::size_t lodIdx = 0; lodIdx < lodRatios.size(); ++lodIdx)
+		{
+			Lod lod{};
+			lod.ratio = lodRatios[lodIdx];
+			screenSize = lodIdx < lodScreenSizes.size() ? lodScreenSizes[lodIdx] : screenSize * 0.5f;
+			lod.screenSize = screenSize;
+			lod.subMeshes.reserve(ranges.size());
+
+			const float ratio = std::clamp(lod.ratio, 0.f, 1.f);
+			for (std::size_t i = 0; i < ranges.size(); ++i)
+			{
+				const std::size_t target = static_cast<std::size_t>(ranges[i].indexCount * ratio) / 3 * 3;
+				std::vector<uint32_t> simplified = MeshSimplifier::Simplify(verts, sources[i].data(), sources[i].size(), target, LOD_MAX_ERROR);
+				MeshOptimizer::OptimizeVertexCache(simplified.data(), simplified.size(), verts.size());
+
+				lod.subMeshes.push_back(SubMesh{ lodIndices.size(), simplified.size() });
+				lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+				sources[i] = std::move(simplified);
+			}
+			lods.push_back(std::move(lod));
+		}
+	}
+	SH_RENDER_API void Mesh::SetLods(std::vector<uint32_t> lodIndices, std::vector<Lod> lods)
+	{
+		this->lodIndices = std::move(lodIndices);
+		this->lods = std::move(lods);
+
+		lodRatios.clear();
+		lodScreenSizes.clear();
+		for (const Lod& lod : this->lods)
+		{
+			lodRatios.push_back(lod.ratio);
+			lodScreenSizes.push_back(lod.screenSize);
+		}
+	}
+	SH_RENDER_API auto Mesh::SelectLod(float screenSize, uint32_t currentLod, float hysteresis) const -> uint32_t
+	{
+		const uint32_t lodCount = GetLodCount();
+		uint32_t lod = std::min(currentLod, lodCount - 1);
+		// lod번 LOD로 바뀌는 경계는 lods[lod - 1].screenSize
+		while (lod + 1 < lodCount && screenSize < lods[lod].screenSize * (1.f - hysteresis))
+			++lod;
+		while (lod > 0 && screenSize >= lods[lod - 1].screenSize * (1.f + hysteresis))
+			--lod;
+		return lod;
+	}
+	SH_RENDER_API auto Mesh::GetIndexRange(uint32_t subMeshIdx, uint32_t lod) const -> SubMesh
+	{
+		if (lod == 0 || lods.empty())
+		{
+			if (subMeshIdx < subMeshes.size())
+				return subMeshes[subMeshIdx];
+			return SubMesh{ 0, indices.size() };
+		}
+		const Lod& lodData = lods[std::min<std::size_t>(lod, lods.size()) - 1];
+		if (subMeshIdx < lodData.subMeshes.size() && subMeshIdx < subMeshes.size())
+		{
+			const SubMesh& range = lodData.subMeshes[subMeshIdx];
+			return SubMesh{ indices.size() + range.indexOffset, range.indexCount };
+		}
+		if (lodData.subMeshes.size() == 1)
+			return SubMesh{ indices.size() + lodData.subMeshes.front().indexOffset, lodData.subMeshes.front().indexCount };
+		// 메쉬 전체를 그리는 경우 LOD의 모든 서브 메쉬는 연속해 있다.
+		std::size_t count = 0;
+		for (const SubMesh& range : lodData.subMeshes)
+			count += range.indexCount;
+		return SubMesh{ indices.size() + lodData.subMeshes.front().indexOffset, count };
+	}
+
 	SH_RENDER_API void Mesh::SetVertexBuffer(std::unique_ptr<IVertexBuffer> buf)
 	{
 		buffer = std::move(buf);
 	}
 	SH_RENDER_API void Mesh::CreateFace()
 	{
+		faces.clear();
 		if (topology == Topology::Face)
 		{
 			for (int i = 0; i < indices.size(); i += 3)
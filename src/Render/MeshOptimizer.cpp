@@ -0,0 +1,545 @@
+﻿#include "MeshOptimizer.h"
+
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+namespace sh::render
+{
+	namespace
+	{
+		// Forsyth 알고리즘의 점수 계산에 쓰는 값들
+		constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+		constexpr float CACHE_DECAY_POWER = 1.5f;
+		constexpr float LAST_TRI_SCORE = 0.75f;
+		constexpr float VALENCE_BOOST_SCALE = 2.0f;
+		constexpr float VALENCE_BOOST_POWER = 0.5f;
+		constexpr uint32_t VALENCE_TABLE_SIZE = 32;
+
+		// 오버드로우 최적화에서 클러스터를 나눌 때 시뮬레이션하는 캐시 크기
+		constexpr uint32_t OVERDRAW_CACHE_SIZE = 16;
+
+		struct ScoreTable
+		{
+			float cache[FORSYTH_CACHE_SIZE];
+			float valence[VALENCE_TABLE_SIZE];
+
+			ScoreTable()
+			{
+				for (uint32_t i = 0; i < FORSYTH_CACHE_SIZE; ++i)
+				{
+					if (i < 3)
+						cache[i] = LAST_TRI_SCORE;
+					else
+					{
+						const float scaler = 1.f / (FORSYTH_CACHE_SIZE - 3);
+						cache[i] = std::pow(1.f - (i - 3) * scaler, CACHE_DECAY_POWER);
+					}
+				}
+				valence[0] = 0.f;
+				for (uint32_t i = 1; i < VALENCE_TABLE_SIZE; ++i)
+					valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+			}
+		};
+		/// @brief 버텍스의 점수. 캐시에서 최근에 쓰였을수록, 남은 삼각형이 적을수록 높다.
+		inline auto CalcVertexScore(const ScoreTable& table, int cachePos, uint32_t remainingTris) -> float
+		{
+			if (remainingTris == 0)
+				return -1.f;
+			float score = cachePos >= 0 ? table.cache[cachePos] : 0.f;
+			if (remainingTris < VALENCE_TABLE_SIZE)
+				score += table.valence[remainingTris];
+			else
+				score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTris), -VALENCE_BOOST_POWER);
+			return score;
+		}
+
+		/// @brief 타임스탬프로 흉내 낸 FIFO 캐시
+		class FifoCache
+		{
+		public:
+			FifoCache(std::size_t vertexCount, uint32_t cacheSize) :
+				timestamps(vertexCount, 0), cacheSize(cacheSize), time(cacheSize + 1)
+			{
+			}
+			/// @return 캐시 미스면 true
+			auto Access(uint32_t vertex) -> bool
+			{
+				if (time - timestamps[vertex] > cacheSize)
+				{
+					timestamps[vertex] = time++;
+					return true;
+				}
+				return false;
+			}
+			auto AccessTriangle(const uint32_t* tri) -> uint32_t
+			{
+				return static_cast<uint32_t>(Access(tri[0])) + static_cast<uint32_t>(Access(tri[1])) + static_cast<uint32_t>(Access(tri[2]));
+			}
+			void Flush()
+			{
+				time += cacheSize + 1;
+			}
+		private:
+			std::vector<uint32_t> timestamps;
+			uint32_t cacheSize;
+			uint32_t time;
+		};
+
+		inline auto SignNotZero(float v) -> float
+		{
+			return v >= 0.f ? 1.f : -1.f;
+		}
+		inline auto ToSnorm16(float v) -> int16_t
+		{
+			return static_cast<int16_t>(std::lround(std::clamp(v, -1.f, 1.f) * 32767.f));
+		}
+		inline auto ToUnorm16(float v) -> uint16_t
+		{
+			return static_cast<uint16_t>(std::lround(std::clamp(v, 0.f, 1.f) * 65535.f));
+		}
+	}//namespace
+
+	SH_RENDER_API auto MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, uint32_t cacheSize) -> CacheStatistics
+	{
+		CacheStatistics stats{};
+		const std::size_t triCount = indexCount / 3;
+		if (triCount == 0 || vertexCount == 0)
+			return stats;
+
+		FifoCache cache{ vertexCount, cacheSize };
+		std::vector<bool> used(vertexCount, false);
+		std::size_t misses = 0;
+		std::size_t usedCount = 0;
+		for (std::size_t i = 0; i < triCount * 3; ++i)
+		{
+			const uint32_t idx = indices[i];
+			if (idx >= vertexCount)
+				continue;
+			if (cache.Access(idx))
+				++misses;
+			if (!used[idx])
+			{
+				used[idx] = true;
+				++usedCount;
+			}
+		}
+		stats.acmr = static_cast<float>(misses) / static_cast<float>(triCount);
+		stats.atvr = usedCount > 0 ? static_cast<float>(misses) / static_cast<float>(usedCount) : 0.f;
+		return stats;
+	}
+
+	SH_RENDER_API void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+	{
+		static const ScoreTable table{};
+
+		const std::size_t triCount = indexCount / 3;
+		if (triCount < 2 || vertexCount == 0)
+			return;
+
+		// 버텍스 -> 삼각형 인접 리스트 (CSR)
+		std::vector<uint32_t> remaining(vertexCount, 0);
+		for (std::size_t i = 0; i < triCount * 3; ++i)
+		{
+			if (indices[i] >= vertexCount)
+			{
+				SH_ERROR_FORMAT("Index({}) is out of range({})", indices[i], vertexCount);
+				return;
+			}
+			++remaining[indices[i]];
+		}
+		std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+		for (std::size_t v = 0; v < vertexCount; ++v)
+			adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+		std::vector<uint32_t> adjacency(triCount * 3);
+		{
+			std::vector<uint32_t> cursor(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+			for (std::size_t t = 0; t < triCount; ++t)
+			{
+				for (int k = 0; k < 3; ++k)
+					adjacency[cursor[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+			}
+		}
+
+		std::vector<int> cachePos(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount);
+		for (std::size_t v = 0; v < vertexCount; ++v)
+			vertexScore[v] = CalcVertexScore(table, -1, remaining[v]);
+
+		std::vector<float> triScore(triCount);
+		std::vector<bool> emitted(triCount, false);
+		for (std::size_t t = 0; t < triCount; ++t)
+			triScore[t] = vertexScore[indices[t * 3 + 0]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+		std::vector<uint32_t> output;
+		output.reserve(triCount * 3);
+
+		std::array<uint32_t, FORSYTH_CACHE_SIZE + 3> cache{};
+		std::array<uint32_t, FORSYTH_CACHE_SIZE + 3> newCache{};
+		std::size_t cacheCount = 0;
+
+		std::size_t bestTri = std::max_element(triScore.begin(), triScore.end()) - triScore.begin();
+		std::size_t scanCursor = 0;
+		while (output.size() < triCount * 3)
+		{
+			if (bestTri == INVALID_INDEX)
+			{
+				// 캐시 안의 버텍스들로 이어갈 삼각형이 없으면 아직 그리지 않은 삼각형 중 하나로 다시 시작한다.
+				while (emitted[scanCursor])
+					++scanCursor;
+				bestTri = scanCursor;
+			}
+			const uint32_t* tri = indices + bestTri * 3;
+			emitted[bestTri] = true;
+			output.insert(output.end(), tri, tri + 3);
+
+			// 인접 리스트에서 그린 삼각형을 뺀다.
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = tri[k];
+				uint32_t* const begin = adjacency.data() + adjacencyOffset[v];
+				uint32_t* const end = begin + remaining[v];
+				uint32_t* const it = std::find(begin, end, static_cast<uint32_t>(bestTri));
+				if (it != end)
+				{
+					std::swap(*it, *(end - 1));
+					--remaining[v];
+				}
+			}
+
+			// 그린 삼각형의 버텍스를 캐시 앞에 둔다. 밀려난 버텍스는 cacheSize 뒤에 남아 점수만 갱신된다.
+			std::size_t newCount = 0;
+			for (int k = 0; k < 3; ++k)
+				newCache[newCount++] = tri[k];
+			for (std::size_t i = 0; i < cacheCount; ++i)
+			{
+				const uint32_t v = cache[i];
+				if (v != tri[0] && v != tri[1] && v != tri[2])
+					newCache[newCount++] = v;
+			}
+			for (std::size_t i = 0; i < newCount; ++i)
+			{
+				const uint32_t v = newCache[i];
+				cachePos[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+				vertexScore[v] = CalcVertexScore(table, cachePos[v], remaining[v]);
+			}
+
+			// 점수가 바뀐 버텍스들의 삼각형 점수를 갱신하면서 다음 삼각형을 고른다.
+			bestTri = INVALID_INDEX;
+			float bestScore = -1.f;
+			for (std::size_t i = 0; i < newCount; ++i)
+			{
+				const uint32_t v = newCache[i];
+				const uint32_t* const adj = adjacency.data() + adjacencyOffset[v];
+				for (uint32_t j = 0; j < remaining[v]; ++j)
+				{
+					const uint32_t t = adj[j];
+					const uint32_t* const adjTri = indices + t * 3;
+					const float score = vertexScore[adjTri[0]] + vertexScore[adjTri[1]] + vertexScore[adjTri[2]];
+					triScore[t] = score;
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTri = t;
+					}
+				}
+			}
+			cacheCount = std::min<std::size_t>(newCount, FORSYTH_CACHE_SIZE);
+			std::copy_n(newCache.begin(), cacheCount, cache.begin());
+		}
+		std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+	}
+
+	SH_RENDER_API void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, std::size_t indexCount, const std::vector<Mesh::Vertex>& verts, float threshold)
+	{
+		const std::size_t triCount = indexCount / 3;
+		if (triCount < 2 || verts.empty())
+			return;
+		for (std::size_t i = 0; i < triCount * 3; ++i)
+		{
+			if (indices[i] >= verts.size())
+				return;
+		}
+
+		// 캐시가 완전히 비워지는 곳(세 버텍스가 모두 미스)을 클러스터의 경계로 삼는다.
+		std::vector<std::size_t> hardClusters;
+		{
+			FifoCache cache{ verts.size(), OVERDRAW_CACHE_SIZE };
+			for (std::size_t t = 0; t < triCount; ++t)
+			{
+				if (cache.AccessTriangle(indices + t * 3) == 3 || t == 0)
+					hardClusters.push_back(t);
+			}
+		}
+		// 클러스터 안에서도 캐시 효율이 threshold 이내로 유지되는 곳에서 더 나눈다.
+		std::vector<std::size_t> clusters;
+		{
+			FifoCache cache{ verts.size(), OVERDRAW_CACHE_SIZE };
+			for (std::size_t c = 0; c < hardClusters.size(); ++c)
+			{
+				const std::size_t begin = hardClusters[c];
+				const std::size_t end = c + 1 < hardClusters.size() ? hardClusters[c + 1] : triCount;
+
+				cache.Flush();
+				std::size_t clusterMisses = 0;
+				for (std::size_t t = begin; t < end; ++t)
+					clusterMisses += cache.AccessTriangle(indices + t * 3);
+				const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+				cache.Flush();
+				clusters.push_back(begin);
+				std::size_t start = begin;
+				std::size_t misses = 0;
+				for (std::size_t t = begin; t < end; ++t)
+				{
+					misses += cache.AccessTriangle(indices + t * 3);
+					const float acmr = static_cast<float>(misses) / static_cast<float>(t - start + 1);
+					if (acmr <= clusterThreshold && t + 1 < end)
+					{
+						clusters.push_back(t + 1);
+						start = t + 1;
+						misses = 0;
+						cache.Flush();
+					}
+				}
+			}
+		}
+		if (clusters.size() < 2)
+			return;
+
+		// 메쉬 중심에서 클러스터의 면 방향으로 멀리 있는(바깥쪽의 가리는) 클러스터부터 그린다.
+		struct ClusterInfo
+		{
+			glm::vec3 centroid{ 0.f };
+			glm::vec3 normal{ 0.f };
+			float area = 0.f;
+		};
+		std::vector<ClusterInfo> infos(clusters.size());
+		glm::vec3 meshCentroid{ 0.f };
+		float meshArea = 0.f;
+		for (std::size_t c = 0; c < clusters.size(); ++c)
+		{
+			const std::size_t begin = clusters[c];
+			const std::size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triCount;
+			ClusterInfo& info = infos[c];
+			for (std::size_t t = begin; t < end; ++t)
+			{
+				const glm::vec3& p0 = verts[indices[t * 3 + 0]].vertex;
+				const glm::vec3& p1 = verts[indices[t * 3 + 1]].vertex;
+				const glm::vec3& p2 = verts[indices[t * 3 + 2]].vertex;
+				const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+				const float area = glm::length(n);
+				info.centroid += (p0 + p1 + p2) * (area / 3.f);
+				info.normal += n;
+				info.area += area;
+			}
+			meshCentroid += info.centroid;
+			meshArea += info.area;
+			info.centroid = info.area > 0.f ? info.centroid / info.area : verts[indices[begin * 3]].vertex;
+		}
+		if (meshArea > 0.f)
+			meshCentroid = meshCentroid / meshArea;
+
+		std::vector<float> sortKeys(clusters.size());
+		for (std::size_t c = 0; c < clusters.size(); ++c)
+		{
+			const float length = glm::length(infos[c].normal);
+			sortKeys[c] = length > 0.f ? glm::dot(infos[c].centroid - meshCentroid, infos[c].normal / length) : 0.f;
+		}
+		std::vector<std::size_t> order(clusters.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(),
+			[&](std::size_t a, std::size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32_t> output;
+		output.reserve(triCount * 3);
+		for (std::size_t c : order)
+		{
+			const std::size_t begin = clusters[c];
+			const std::size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triCount;
+			output.insert(output.end(), indices + begin * 3, indices + end * 3);
+		}
+		std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+	}
+
+	SH_RENDER_API auto MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, std::size_t vertexCount) -> std::vector<uint32_t>
+	{
+		std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+		uint32_t next = 0;
+		for (uint32_t& idx : indices)
+		{
+			if (idx >= vertexCount)
+				continue;
+			if (remap[idx] == INVALID_INDEX)
+				remap[idx] = next++;
+			idx = remap[idx];
+		}
+		return remap;
+	}
+
+	SH_RENDER_API void MeshOptimizer::Optimize(std::vector<Mesh::Vertex>& verts, std::vector<uint32_t>& indices, const std::vector<SubMesh>& subMeshes,
+		std::vector<SkinnedMesh::BoneVertex>* boneVerts)
+	{
+		if (verts.empty() || indices.empty())
+			return;
+		if (boneVerts != nullptr && boneVerts->size() != verts.size())
+		{
+			SH_ERROR_FORMAT("Can't optimize mesh: bone vertex count({}) is different from vertex count({})", boneVerts->size(), verts.size());
+			return;
+		}
+		for (uint32_t idx : indices)
+		{
+			if (idx >= verts.size())
+			{
+				SH_ERROR_FORMAT("Can't optimize mesh: index({}) is out of range({})", idx, verts.size());
+				return;
+			}
+		}
+
+		auto optimizeRangeFn = [&](std::size_t offset, std::size_t count)
+			{
+				if (offset + count > indices.size() || count % 3 != 0)
+					return;
+				OptimizeVertexCache(indices.data() + offset, count, verts.size());
+				OptimizeOverdraw(indices.data() + offset, count, verts);
+			};
+		if (subMeshes.empty())
+			optimizeRangeFn(0, indices.size());
+		else
+		{
+			for (const SubMesh& subMesh : subMeshes)
+				optimizeRangeFn(subMesh.indexOffset, subMesh.indexCount);
+		}
+
+		const std::vector<uint32_t> remap = OptimizeVertexFetch(indices, verts.size());
+		if (boneVerts != nullptr)
+			RemapVertices(*boneVerts, remap);
+		RemapVertices(verts, remap);
+	}
+
+	SH_RENDER_API auto MeshOptimizer::CalcDequantization(const std::vector<Mesh::Vertex>& verts) -> Mesh::Dequantization
+	{
+		Mesh::Dequantization dequantization{};
+		if (verts.empty())
+			return dequantization;
+
+		glm::vec3 min{ verts[0].vertex };
+		glm::vec3 max{ verts[0].vertex };
+		for (const Mesh::Vertex& vert : verts)
+		{
+			min = glm::min(min, vert.vertex);
+			max = glm::max(max, vert.vertex);
+		}
+		dequantization.offset = glm::vec4{ min, 0.f };
+		dequantization.scale = glm::vec4{ max - min, 1.f };
+		return dequantization;
+	}
+	SH_RENDER_API auto MeshOptimizer::Quantize(const std::vector<Mesh::Vertex>& verts, const Mesh::Dequantization& dequantization) -> std::vector<Mesh::QuantizedVertex>
+	{
+		std::vector<Mesh::QuantizedVertex> result(verts.size());
+		for (std::size_t i = 0; i < verts.size(); ++i)
+		{
+			const Mesh::Vertex& vert = verts[i];
+			Mesh::QuantizedVertex& out = result[i];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float scale = dequantization.scale[axis];
+				const float normalized = scale > 0.f ? (vert.vertex[axis] - dequantization.offset[axis]) / scale : 0.f;
+				out.vertex[axis] = ToUnorm16(normalized);
+			}
+			out.vertex[3] = 0;
+			out.uv = { FloatToHalf(vert.uv.x), FloatToHalf(vert.uv.y) };
+			out.normal = EncodeOctahedral(vert.normal);
+			out.tangent = EncodeOctahedral(vert.tangent);
+		}
+		return result;
+	}
+	SH_RENDER_API auto MeshOptimizer::EncodeOctahedral(const glm::vec3& dir) -> std::array<int16_t, 2>
+	{
+		const float l1 = std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z);
+		if (l1 <= 0.f || !std::isfinite(l1))
+			return { 0, 0 };
+		float x = dir.x / l1;
+		float y = dir.y / l1;
+		if (dir.z < 0.f)
+		{
+			const float ox = x;
+			x = (1.f - std::abs(y)) * SignNotZero(ox);
+			y = (1.f - std::abs(ox)) * SignNotZero(y);
+		}
+		return { ToSnorm16(x), ToSnorm16(y) };
+	}
+	SH_RENDER_API auto MeshOptimizer::DecodeOctahedral(const std::array<int16_t, 2>& encoded) -> glm::vec3
+	{
+		const float ex = std::max(encoded[0] / 32767.f, -1.f);
+		const float ey = std::max(encoded[1] / 32767.f, -1.f);
+		glm::vec3 n{ ex, ey, 1.f - std::abs(ex) - std::abs(ey) };
+		const float t = std::max(-n.z, 0.f);
+		n.x += n.x >= 0.f ? -t : t;
+		n.y += n.y >= 0.f ? -t : t;
+		return glm::normalize(n);
+	}
+	SH_RENDER_API auto MeshOptimizer::FloatToHalf(float value) -> uint16_t
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+		const uint32_t sign = (bits >> 16) & 0x8000;
+		const uint32_t exponent = (bits >> 23) & 0xff;
+		uint32_t mantissa = bits & 0x7fffff;
+
+		if (exponent == 0xff) // Inf, NaN
+			return static_cast<uint16_t>(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+
+		const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+		if (halfExponent >= 0x1f) // 오버플로우
+			return static_cast<uint16_t>(sign | 0x7c00);
+		if (halfExponent <= 0) // 비정규화 수 또는 0
+		{
+			if (halfExponent < -10)
+				return static_cast<uint16_t>(sign);
+			mantissa |= 0x800000;
+			const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+			uint32_t half = mantissa >> shift;
+			// 가장 가까운 짝수로 반올림
+			const uint32_t rest = mantissa & ((1u << shift) - 1);
+			const uint32_t halfway = 1u << (shift - 1);
+			if (rest > halfway || (rest == halfway && (half & 1)))
+				++half;
+			return static_cast<uint16_t>(sign | half);
+		}
+		uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+		const uint32_t rest = mantissa & 0x1fff;
+		if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+			++half; // 가수부 올림이 지수부로 넘어가도 올바른 값이 된다.
+		return static_cast<uint16_t>(sign | half);
+	}
+	SH_RENDER_API auto MeshOptimizer::HalfToFloat(uint16_t value) -> float
+	{
+		const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+		uint32_t exponent = (value >> 10) & 0x1f;
+		uint32_t mantissa = value & 0x3ff;
+		uint32_t bits;
+		if (exponent == 0x1f)
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		else if (exponent != 0)
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		else if (mantissa == 0)
+			bits = sign;
+		else
+		{
+			// 비정규화 수를 정규화한다.
+			exponent = 127 - 15 + 1;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				--exponent;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+		}
+		float result;
+		std::memcpy(&result, &bits, sizeof(float));
+		return result;
+	}
+}//namespace
@@ -0,0 +1,337 @@
+﻿#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+namespace sh::render
+{
+	namespace
+	{
+		/// @brief 붕괴 후 삼각형 노말이 이 값(cos) 이상 돌아가면 뒤집힌 것으로 본다.
+		constexpr float FLIP_THRESHOLD = 0.25f;
+		/// @brief 붕괴 후 삼각형의 품질(정삼각형 = 1)이 이보다 낮아지면 거부한다. 가늘고 긴 삼각형을 막는다.
+		constexpr float MIN_TRIANGLE_QUALITY = 0.05f;
+		constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+		/// @brief 대칭 4x4 행렬을 10개의 값으로 저장한 이차 오차 행렬. 평면까지 거리 제곱의 (면적 가중) 합을 나타낸다.
+		struct Quadric
+		{
+			double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+			double b2 = 0.0, bc = 0.0, bd = 0.0;
+			double c2 = 0.0, cd = 0.0;
+			double d2 = 0.0;
+			/// @brief 더해진 평면들의 가중치(면적) 합
+			double weight = 0.0;
+
+			static auto FromPlane(const glm::vec3& n, double d, double w) -> Quadric
+			{
+				Quadric q{};
+				q.a2 = w * n.x * n.x; q.ab = w * n.x * n.y; q.ac = w * n.x * n.z; q.ad = w * n.x * d;
+				q.b2 = w * n.y * n.y; q.bc = w * n.y * n.z; q.bd = w * n.y * d;
+				q.c2 = w * n.z * n.z; q.cd = w * n.z * d;
+				q.d2 = w * d * d;
+				q.weight = w;
+				return q;
+			}
+			auto operator+=(const Quadric& other) -> Quadric&
+			{
+				a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+				b2 += other.b2; bc += other.bc; bd += other.bd;
+				c2 += other.c2; cd += other.cd;
+				d2 += other.d2;
+				weight += other.weight;
+				return *this;
+			}
+			auto operator+(const Quadric& other) const -> Quadric
+			{
+				Quadric result = *this;
+				result += other;
+				return result;
+			}
+			/// @brief 점 p에서 평면들까지 거리 제곱의 가중 평균
+			auto Eval(const glm::vec3& p) const -> double
+			{
+				const double x = p.x, y = p.y, z = p.z;
+				const double sum =
+					a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+					b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+					c2 * z * z + 2.0 * cd * z +
+					d2;
+				return weight > 0.0 ? std::abs(sum) / weight : 0.0;
+			}
+		};
+		struct Collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			float error;
+		};
+		struct PositionKey
+		{
+			uint32_t bits[3];
+
+			auto operator==(const PositionKey& other) const -> bool
+			{
+				return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+			}
+		};
+		struct PositionKeyHasher
+		{
+			auto operator()(const PositionKey& key) const -> std::size_t
+			{
+				return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+			}
+		};
+		inline auto MakeEdgeKey(uint32_t a, uint32_t b) -> uint64_t
+		{
+			return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+		}
+		/// @brief 위치가 같은 버텍스들을 하나의 위치 번호로 묶는다.
+		/// @return 버텍스 번호 -> 위치 번호. 참조되지 않는 버텍스는 0
+		auto WeldPositions(const std::vector<Mesh::Vertex>& verts, const uint32_t* indices, std::size_t indexCount, std::vector<glm::vec3>& positions) -> std::vector<uint32_t>
+		{
+			std::vector<uint32_t> posRemap(verts.size(), 0);
+			std::vector<uint8_t> visited(verts.size(), 0);
+			std::unordered_map<PositionKey, uint32_t, PositionKeyHasher> posMap;
+			posMap.reserve(indexCount / 3);
+			for (std::size_t i = 0; i < indexCount; ++i)
+			{
+				const uint32_t idx = indices[i];
+				if (visited[idx])
+					continue;
+				visited[idx] = 1;
+
+				// -0과 0을 같은 위치로 본다.
+				const glm::vec3 p = verts[idx].vertex + glm::vec3{ 0.f };
+				PositionKey key{};
+				std::memcpy(key.bits, &p.x, sizeof(float));
+				std::memcpy(key.bits + 1, &p.y, sizeof(float));
+				std::memcpy(key.bits + 2, &p.z, sizeof(float));
+				auto [it, bInserted] = posMap.insert({ key, static_cast<uint32_t>(positions.size()) });
+				if (bInserted)
+					positions.push_back(p);
+				posRemap[idx] = it->second;
+			}
+			return posRemap;
+		}
+		/// @brief 삼각형의 품질. 정삼각형이면 1, 면적이 없으면 0
+		inline auto CalcTriangleQuality(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, float doubleArea) -> float
+		{
+			const glm::vec3 e0 = p1 - p0;
+			const glm::vec3 e1 = p2 - p1;
+			const glm::vec3 e2 = p0 - p2;
+			const float edgeSq = glm::dot(e0, e0) + glm::dot(e1, e1) + glm::dot(e2, e2);
+			return edgeSq > 0.f ? 2.f * std::sqrt(3.f) * doubleArea / edgeSq : 0.f;
+		}
+		/// @brief from의 위치를 to의 위치로 옮겼을 때 주변 삼각형이 뒤집히거나 지나치게 가늘어지는지
+		auto IsBadCollapse(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& posRemap, const std::vector<glm::vec3>& positions,
+			const uint32_t* adjacency, std::size_t adjacencyCount, uint32_t fromPos, uint32_t toPos) -> bool
+		{
+			const glm::vec3& newPos = positions[toPos];
+			for (std::size_t i = 0; i < adjacencyCount; ++i)
+			{
+				const std::size_t tri = adjacency[i];
+				uint32_t p[3] = { posRemap[indices[tri * 3 + 0]], posRemap[indices[tri * 3 + 1]], posRemap[indices[tri * 3 + 2]] };
+				// 붕괴로 사라지는 삼각형
+				if (p[0] == toPos || p[1] == toPos || p[2] == toPos)
+					continue;
+				const int k = p[0] == fromPos ? 0 : (p[1] == fromPos ? 1 : 2);
+				const glm::vec3& p1 = positions[p[(k + 1) % 3]];
+				const glm::vec3& p2 = positions[p[(k + 2) % 3]];
+				const glm::vec3 before = glm::cross(p1 - positions[fromPos], p2 - positions[fromPos]);
+				const glm::vec3 after = glm::cross(p1 - newPos, p2 - newPos);
+				const float beforeLen = glm::length(before);
+				const float afterLen = glm::length(after);
+				if (afterLen <= 0.f || glm::dot(before, after) < FLIP_THRESHOLD * beforeLen * afterLen)
+					return true;
+				const float beforeQuality = CalcTriangleQuality(positions[fromPos], p1, p2, beforeLen);
+				const float afterQuality = CalcTriangleQuality(newPos, p1, p2, afterLen);
+				if (afterQuality < std::min(beforeQuality, MIN_TRIANGLE_QUALITY))
+					return true;
+			}
+			return false;
+		}
+	}//namespace
+
+	SH_RENDER_API auto MeshSimplifier::Simplify(const std::vector<Mesh::Vertex>& verts, const uint32_t* indices, std::size_t indexCount,
+		std::size_t targetIndexCount, float maxError, float* outError) -> std::vector<uint32_t>
+	{
+		if (outError != nullptr)
+			*outError = 0.f;
+
+		std::vector<uint32_t> result(indices, indices + indexCount - indexCount % 3);
+		if (targetIndexCount >= result.size() || result.empty())
+			return result;
+
+		std::vector<glm::vec3> positions;
+		const std::vector<uint32_t> posRemap = WeldPositions(verts, result.data(), result.size(), positions);
+		const std::size_t posCount = positions.size();
+
+		glm::vec3 min = positions.front();
+		glm::vec3 max = positions.front();
+		for (const glm::vec3& p : positions)
+		{
+			min = glm::min(min, p);
+			max = glm::max(max, p);
+		}
+		const float extent = std::max(max.x - min.x, std::max(max.y - min.y, max.z - min.z));
+		if (extent <= 0.f)
+			return result;
+		const float errorLimit = maxError * extent;
+		const float errorLimitSq = errorLimit * errorLimit;
+
+		// 이음새(같은 위치에 버텍스가 여러개)와 열린 경계, 비다양체 간선의 버텍스는 잠근다.
+		std::vector<uint8_t> locked(posCount, 0);
+		{
+			std::vector<uint32_t> firstVertex(posCount, INVALID_INDEX);
+			for (uint32_t idx : result)
+			{
+				const uint32_t pos = posRemap[idx];
+				if (firstVertex[pos] == INVALID_INDEX)
+					firstVertex[pos] = idx;
+				else if (firstVertex[pos] != idx)
+					locked[pos] = 1;
+			}
+			std::unordered_map<uint64_t, uint32_t> edgeCount;
+			edgeCount.reserve(result.size());
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int k = 0; k < 3; ++k)
+					++edgeCount[MakeEdgeKey(posRemap[result[i + k]], posRemap[result[i + (k + 1) % 3]])];
+			}
+			for (const auto& [key, count] : edgeCount)
+			{
+				if (count == 2)
+					continue;
+				locked[static_cast<uint32_t>(key >> 32)] = 1;
+				locked[static_cast<uint32_t>(key & 0xffffffffu)] = 1;
+			}
+		}
+
+		std::vector<Quadric> quadrics(posCount);
+		for (std::size_t i = 0; i < result.size(); i += 3)
+		{
+			const glm::vec3& p0 = positions[posRemap[result[i + 0]]];
+			const glm::vec3& p1 = positions[posRemap[result[i + 1]]];
+			const glm::vec3& p2 = positions[posRemap[result[i + 2]]];
+			const glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+			const float len = glm::length(cross);
+			if (len <= 0.f)
+				continue;
+			const glm::vec3 normal = cross / len;
+			const Quadric q = Quadric::FromPlane(normal, -static_cast<double>(glm::dot(normal, p0)), len * 0.5);
+			for (int k = 0; k < 3; ++k)
+				quadrics[posRemap[result[i + k]]] += q;
+		}
+
+		std::vector<uint32_t> adjacencyOffsets(posCount + 1);
+		std::vector<uint32_t> adjacency;
+		std::vector<Collapse> candidates;
+		std::vector<uint8_t> touched(posCount);
+		std::vector<uint32_t> vertexRemap(verts.size());
+		float maxErrorSq = 0.f;
+
+		while (result.size() > targetIndexCount)
+		{
+			const std::size_t triCount = result.size() / 3;
+
+			// 위치 -> 주변 삼각형
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (uint32_t idx : result)
+				++adjacencyOffsets[posRemap[idx] + 1];
+			for (std::size_t i = 1; i < adjacencyOffsets.size(); ++i)
+				adjacencyOffsets[i] += adjacencyOffsets[i - 1];
+			adjacency.resize(result.size());
+			{
+				std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (std::size_t tri = 0; tri < triCount; ++tri)
+				{
+					for (int k = 0; k < 3; ++k)
+						adjacency[cursor[posRemap[result[tri * 3 + k]]]++] = static_cast<uint32_t>(tri);
+				}
+			}
+
+			candidates.clear();
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					const uint32_t v0 = result[i + k];
+					const uint32_t v1 = result[i + (k + 1) % 3];
+					const uint32_t p0 = posRemap[v0];
+					const uint32_t p1 = posRemap[v1];
+					if (p0 == p1)
+						continue;
+					const Quadric q = quadrics[p0] + quadrics[p1];
+					if (!locked[p0])
+						candidates.push_back(Collapse{ v0, v1, static_cast<float>(q.Eval(positions[p1])) });
+					if (!locked[p1])
+						candidates.push_back(Collapse{ v1, v0, static_cast<float>(q.Eval(positions[p0])) });
+				}
+			}
+			if (candidates.empty())
+				break;
+			std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+			// 한 번에 목표까지 줄이되, 서로 영향을 주는 붕괴는 다음 패스로 미룬다.
+			const std::size_t trisToRemove = (result.size() - targetIndexCount + 2) / 3;
+			std::size_t removed = 0;
+			std::fill(touched.begin(), touched.end(), 0);
+			std::iota(vertexRemap.begin(), vertexRemap.end(), 0);
+			for (const Collapse& collapse : candidates)
+			{
+				if (removed >= trisToRemove || collapse.error > errorLimitSq)
+					break;
+				const uint32_t fromPos = posRemap[collapse.from];
+				const uint32_t toPos = posRemap[collapse.to];
+				if (touched[fromPos] || touched[toPos])
+					continue;
+
+				const uint32_t* adj = adjacency.data() + adjacencyOffsets[fromPos];
+				const std::size_t adjCount = adjacencyOffsets[fromPos + 1] - adjacencyOffsets[fromPos];
+				if (IsBadCollapse(result, posRemap, positions, adj, adjCount, fromPos, toPos))
+					continue;
+
+				for (std::size_t i = 0; i < adjCount; ++i)
+				{
+					bool bRemoved = false;
+					for (int k = 0; k < 3; ++k)
+					{
+						const uint32_t pos = posRemap[result[adj[i] * 3 + k]];
+						touched[pos] = 1;
+						bRemoved |= pos == toPos;
+					}
+					if (bRemoved)
+						++removed;
+				}
+				touched[toPos] = 1;
+
+				vertexRemap[collapse.from] = collapse.to;
+				quadrics[toPos] += quadrics[fromPos];
+				maxErrorSq = std::max(maxErrorSq, collapse.error);
+			}
+			if (removed == 0)
+				break;
+
+			std::size_t write = 0;
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				const uint32_t a = vertexRemap[result[i + 0]];
+				const uint32_t b = vertexRemap[result[i + 1]];
+				const uint32_t c = vertexRemap[result[i + 2]];
+				if (posRemap[a] == posRemap[b] || posRemap[b] == posRemap[c] || posRemap[a] == posRemap[c])
+					continue;
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+			result.resize(write);
+		}
+		if (outError != nullptr)
+			*outError = std::sqrt(maxErrorSq) / extent;
+		return result;
+	}
+}//namespace
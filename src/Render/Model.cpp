@@ -1,4 +1,6 @@
 ﻿#include "Model.h"
+#include "SkinnedMesh.h"
+
 #include "Core/Logger.h"
 
 #include <queue>
@@ -13,8 +15,12 @@ namespace sh::render
 
 		for (Node& node : this->nodes)
 		{
-			if (node.mesh != nullptr)
-				meshes.push_back(node.mesh);
+			if (node.mesh == nullptr)
+				continue;
+			meshes.push_back(node.mesh);
+			// 캐시된 에셋에서 만들어질 때는 메쉬에 저장된 값이 설정이다.
+			if (node.mesh->GetType() != SkinnedMesh::GetStaticType())
+				bQuantizeMeshes = node.mesh->IsQuantized();
 		}
 	}
 	Model::~Model()
@@ -27,11 +33,53 @@ namespace sh::render
 			if (mesh != nullptr)
 				mesh->Destroy();
 		}
+		for (auto animation : animations)
+		{
+			if (animation != nullptr)
+				animation->Destroy();
+		}
 		Super::Destroy();
 		std::vector<int> a;
 		a.push_back(0);
 	}
 
+	SH_RENDER_API void Model::SetSkeletons(std::vector<Skeleton> skeletons)
+	{
+		this->skeletons = std::move(skeletons);
+
+		std::vector<int> nodeParents(nodes.size(), -1);
+		std::vector<glm::mat4> nodeMatrices(nodes.size());
+		std::vector<std::string> nodeNames(nodes.size());
+		for (std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			nodeMatrices[i] = nodes[i].modelMatrix;
+			nodeNames[i] = nodes[i].name;
+			for (int childIdx : nodes[i].childrenIdx)
+			{
+				if (childIdx >= 0 && childIdx < static_cast<int>(nodes.size()))
+					nodeParents[childIdx] = static_cast<int>(i);
+			}
+		}
+		for (Skeleton& skeleton : this->skeletons)
+			skeleton.BuildHierarchy(nodeParents, nodeMatrices, nodeNames);
+	}
+	SH_RENDER_API void Model::SetAnimations(std::vector<AnimationClip*> animations)
+	{
+		this->animations.clear();
+		for (AnimationClip* animation : animations)
+			this->animations.push_back(animation);
+	}
+
+	SH_RENDER_API void Model::SetQuantizeMeshes(bool bQuantize)
+	{
+		bQuantizeMeshes = bQuantize;
+		for (auto mesh : meshes)
+		{
+			if (mesh != nullptr && mesh->GetType() != SkinnedMesh::GetStaticType())
+				mesh->SetQuantize(bQuantize);
+		}
+	}
+
 	SH_RENDER_API auto Model::Serialize() const -> core::Json
 	{
 		// 노트 데이터는 직렬화 안 함 (ModelAsset에서 따로 저장)
@@ -41,11 +89,17 @@ namespace sh::render
 			if (mesh != nullptr)
 				mainJson["Mesh"].push_back(mesh->Serialize());
 		}
+		for (auto animation : animations)
+		{
+			if (animation != nullptr)
+				mainJson["Animation"].push_back(animation->Serialize());
+		}
 		return mainJson;
 	}
 	SH_RENDER_API void Model::Deserialize(const core::Json& json)
 	{
 		Super::Deserialize(json);
+		SetQuantizeMeshes(bQuantizeMeshes);
 		if (meshes.size() != json["Mesh"].size())
 		{
 			SH_ERROR_FORMAT("{}: Can't deserialize mesh", GetName().ToString());
@@ -58,5 +112,25 @@ namespace sh::render
 				meshes[idx]->Deserialize(meshJson);
 			++idx;
 		}
+		// 애니메이션이 없던 때의 메타 파일에는 Animation이 없다.
+		if (!json.contains("Animation"))
+			return;
+		if (animations.size() != json["Animation"].size())
+		{
+			SH_ERROR_FORMAT("{}: Can't deserialize animation", GetName().ToString());
+			return;
+		}
+		idx = 0;
+		for (auto& animationJson : json["Animation"])
+		{
+			if (animations[idx] != nullptr)
+				animations[idx]->Deserialize(animationJson);
+			++idx;
+		}
+	}
+	SH_RENDER_API void Model::OnPropertyChanged(const core::reflection::Property& prop)
+	{
+		if (prop.GetName() == core::Util::ConstexprHash("bQuantizeMeshes"))
+			SetQuantizeMeshes(bQuantizeMeshes);
 	}
 }//namespace
\ No newline at end of file
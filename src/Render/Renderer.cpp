@@ -1,6 +1,7 @@
 ﻿#include "Renderer.h"
 #include "Drawable.h"
 #include "RenderDataManager.h"
+#include "SkinPaletteBuffer.h"
 
 #include "Core/ThreadSyncManager.h"
 
@@ -67,6 +68,7 @@ namespace sh::render
 		drawables.clear();
 		DrainRenderCommands();
 		IRenderThrMethod<RenderDataManager>::UploadToGPU(GetContext()->GetRenderDataManager());
+		IRenderThrMethod<SkinPaletteBuffer>::UploadToGPU(GetContext()->GetSkinPaletteBuffer());
 	}
 	SH_RENDER_API void Renderer::Pause(bool b)
 	{
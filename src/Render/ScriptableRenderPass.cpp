@@ -22,8 +22,9 @@ namespace sh::render
 			const Material* mat;
 			Mesh::Topology topology;
 			bool bSkinned;
+			bool bQuantized;
 
-			bool operator==(const GroupKey& other) const noexcept { return mat == other.mat && topology == other.topology && bSkinned == other.bSkinned; }
+			bool operator==(const GroupKey& other) const noexcept { return mat == other.mat && topology == other.topology && bSkinned == other.bSkinned && bQuantized == other.bQuantized; }
 		};
 		struct GroupKeyHash
 		{
@@ -31,7 +32,8 @@ namespace sh::render
 			{
 				const std::size_t hash0 = core::Util::CombineHash(std::hash<const Material*>{}(k.mat), std::hash<int>{}(static_cast<int>(k.topology)));
 				const std::size_t hash1 = core::Util::CombineHash(hash0, std::hash<bool>{}(k.bSkinned));
-				return hash1;
+				const std::size_t hash2 = core::Util::CombineHash(hash1, std::hash<bool>{}(k.bQuantized));
+				return hash2;
 			}
 		};
 		std::unordered_map<GroupKey, std::size_t, GroupKeyHash> groupIndex;
@@ -61,8 +63,10 @@ namespace sh::render
 
 			Mesh::Topology topology = drawable->GetTopology(core::ThreadType::Render);
 			const bool bSkinned = drawable->IsSkinnedMesh();
+			// 양자화된 메쉬는 버텍스 레이아웃이 달라 파이프라인이 다르다.
+			const bool bQuantized = !bSkinned && drawable->GetMesh()->IsQuantized();
 
-			GroupKey key{ mat, topology, bSkinned };
+			GroupKey key{ mat, topology, bSkinned, bQuantized };
 			auto it = groupIndex.find(key);
 			if (it == groupIndex.end())
 			{
@@ -70,6 +74,7 @@ namespace sh::render
 				group.material = mat;
 				group.topology = topology;
 				group.bSkinned = bSkinned;
+				group.bQuantized = bQuantized;
 				group.drawables.push_back(drawable);
 
 				groupIndex.emplace(key, groups.size());
@@ -0,0 +1,130 @@
+﻿#include "ShaderCompiler.h"
+
+#include "Core/FileSystem.h"
+#include "Core/Logger.h"
+#include "Core/ThreadPool.h"
+#include "Core/Util.h"
+
+#include <shaderc/shaderc.hpp>
+
+#include <fmt/core.h>
+
+#include <cstring>
+#include <functional>
+#include <thread>
+namespace sh::render
+{
+	namespace
+	{
+		inline auto ToShaderKind(ShaderCompiler::Stage stage) -> shaderc_shader_kind
+		{
+			switch (stage)
+			{
+			case ShaderCompiler::Stage::Vertex: return shaderc_vertex_shader;
+			case ShaderCompiler::Stage::Fragment: return shaderc_fragment_shader;
+			case ShaderCompiler::Stage::Compute: return shaderc_compute_shader;
+			}
+			return shaderc_vertex_shader;
+		}
+	}//namespace
+
+	struct ShaderCompiler::Impl
+	{
+		shaderc::Compiler compiler;
+	};
+
+	SH_RENDER_API ShaderCompiler::ShaderCompiler() :
+		ShaderCompiler(Options{})
+	{
+	}
+	SH_RENDER_API ShaderCompiler::ShaderCompiler(const Options& options) :
+		impl(std::make_unique<Impl>()),
+		options(options)
+	{
+		if (!impl->compiler.IsValid())
+			SH_ERROR("Failed to initialize shader compiler");
+	}
+	SH_RENDER_API ShaderCompiler::~ShaderCompiler() = default;
+
+	SH_RENDER_API void ShaderCompiler::SetCachePath(const std::filesystem::path& path)
+	{
+		cachePath = path;
+		if (cachePath.empty())
+			return;
+		std::error_code ec;
+		if (!std::filesystem::exists(cachePath, ec))
+			std::filesystem::create_directories(cachePath, ec);
+	}
+
+	SH_RENDER_API auto ShaderCompiler::Compile(std::string_view code, Stage stage, const std::string& name) const -> std::optional<Spirv>
+	{
+		std::filesystem::path spirvPath;
+		if (!cachePath.empty())
+		{
+			spirvPath = cachePath / fmt::format("{:016x}.spv", GetCacheKey(code, stage));
+			std::error_code ec;
+			if (std::filesystem::exists(spirvPath, ec))
+			{
+				auto spirvOpt = core::FileSystem::LoadBinary(spirvPath);
+				if (spirvOpt.has_value() && !spirvOpt->empty() && spirvOpt->size() % sizeof(uint32_t) == 0)
+					return spirvOpt;
+			}
+		}
+
+		// CompileOptions는 스레드 안전하지 않으므로 호출마다 만든다.
+		shaderc::CompileOptions compileOptions{};
+		compileOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0);
+		compileOptions.SetOptimizationLevel(options.bOptimize ? shaderc_optimization_level_performance : shaderc_optimization_level_zero);
+		if (options.bDebugInfo)
+			compileOptions.SetGenerateDebugInfo();
+
+		const shaderc::SpvCompilationResult result = impl->compiler.CompileGlslToSpv(code.data(), code.size(), ToShaderKind(stage), name.c_str(), "main", compileOptions);
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+		{
+			SH_ERROR_FORMAT("Shader compile error: {}", result.GetErrorMessage());
+			return std::nullopt;
+		}
+		const std::size_t wordCount = static_cast<std::size_t>(result.cend() - result.cbegin());
+		Spirv spirv(wordCount * sizeof(uint32_t));
+		std::memcpy(spirv.data(), result.cbegin(), spirv.size());
+
+		if (!spirvPath.empty())
+		{
+			// 같은 키를 다른 스레드가 쓰고 있을 수 있으므로 임시 파일에 쓰고 이름을 바꾼다.
+			std::filesystem::path tempPath = spirvPath;
+			tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			if (core::FileSystem::SaveBinary(spirv, tempPath))
+			{
+				std::error_code ec;
+				std::filesystem::rename(tempPath, spirvPath, ec);
+				if (ec)
+					std::filesystem::remove(tempPath, ec);
+			}
+		}
+		return spirv;
+	}
+	SH_RENDER_API auto ShaderCompiler::CompileAll(const std::vector<Source>& sources) const -> std::vector<std::optional<Spirv>>
+	{
+		std::vector<std::optional<Spirv>> results(sources.size());
+
+		core::ThreadPool::GetInstance()->ParallelFor(sources.size(),
+			[this, &sources, &results](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					results[i] = Compile(sources[i].code, sources[i].stage, sources[i].name);
+			}
+		);
+		return results;
+	}
+	SH_RENDER_API auto ShaderCompiler::GetCacheKey(std::string_view code, Stage stage) const -> uint64_t
+	{
+		const uint32_t params[4] = {
+			VERSION,
+			static_cast<uint32_t>(stage),
+			static_cast<uint32_t>(options.bOptimize),
+			static_cast<uint32_t>(options.bDebugInfo)
+		};
+		const uint64_t seed = core::Util::Hash64(params, sizeof(params));
+		return core::Util::Hash64(code.data(), code.size(), seed);
+	}
+}//namespace
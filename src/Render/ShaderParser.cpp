@@ -637,6 +637,57 @@ namespace sh::render
 		bool usingSKIN = false;
 		bool usingMATRIX_SKIN = false;
 		bool usingTEXTURE_SHADOW = false;
+		bool usingDequantization = false;
+
+		// 푸시 상수 CONSTANTS 블록을 만들거나 필요한 멤버를 채우는 헬퍼. model은 항상 맨 앞에 둔다.
+		auto registerConstantsFn = [&](bool bDequantization)
+		{
+			auto it = std::find_if(stageNode.buffers.begin(), stageNode.buffers.end(),
+				[](const ShaderAST::BufferNode& ubo) { return ubo.name == "CONSTANTS"; });
+			if (it == stageNode.buffers.end())
+			{
+				ShaderAST::BufferNode uboNode{};
+				uboNode.bufferType = ShaderAST::BufferType::PushConstant;
+				uboNode.name = "CONSTANTS";
+				uboNode.set = static_cast<uint32_t>(UniformStructLayout::Usage::Object); // 의미 없음
+				uboNode.binding = 0; // 의미 없음
+				stageNode.buffers.push_back(std::move(uboNode));
+				it = std::prev(stageNode.buffers.end());
+			}
+			auto hasVar = [&](std::string_view name)
+			{
+				return std::find_if(it->vars.begin(), it->vars.end(),
+					[&](const ShaderAST::VariableNode& var) { return var.name == name; }) != it->vars.end();
+			};
+			if (!hasVar("model"))
+				it->vars.insert(it->vars.begin(), ShaderAST::VariableNode{ ShaderAST::VariableType::Mat4, 1, "model" });
+			// 양자화된 메쉬의 복원 값. Mesh::Dequantization과 같은 레이아웃
+			if (bDequantization && !hasVar("meshOffset"))
+				it->vars.push_back(ShaderAST::VariableNode{ ShaderAST::VariableType::Vec4, 1, "meshOffset" });
+			if (bDequantization && !hasVar("meshScale"))
+				it->vars.push_back(ShaderAST::VariableNode{ ShaderAST::VariableType::Vec4, 1, "meshScale" });
+			uboit = refreshUboIt();
+		};
+		auto registerDequantizationFn = [&]()
+		{
+			if (usingDequantization || stageNode.type != ShaderAST::StageType::Vertex)
+				return;
+			registerConstantsFn(true);
+			usingDequantization = true;
+		};
+		// 스키닝 행렬은 모든 메쉬가 공유하는 버퍼에 있으므로 이 메쉬 행렬의 시작 위치를 받는다. 복원 값 뒤에 둔다.
+		auto registerSkinOffsetFn = [&]()
+		{
+			if (stageNode.type != ShaderAST::StageType::Vertex)
+				return;
+			registerDequantizationFn();
+			auto it = std::find_if(stageNode.buffers.begin(), stageNode.buffers.end(),
+				[](const ShaderAST::BufferNode& ubo) { return ubo.name == "CONSTANTS"; });
+			if (std::find_if(it->vars.begin(), it->vars.end(),
+				[](const ShaderAST::VariableNode& var) { return var.name == "skinOffset"; }) == it->vars.end())
+				it->vars.push_back(ShaderAST::VariableNode{ ShaderAST::VariableType::Int, 1, "skinOffset" });
+			uboit = refreshUboIt();
+		};
 		auto registerCameraFn = [&]()
 		{
 			if (usingCamera)
@@ -690,13 +741,22 @@ namespace sh::render
 					code.pop_back();
 			}
 			else if (CheckToken(ShaderLexer::TokenType::VERTEX))
+			{
 				registerAttributeFn(usingVertex, "VERTEX", Mesh::VERTEX_ID, ShaderAST::VariableType::Vec3);
+				registerDequantizationFn();
+			}
 			else if (CheckToken(ShaderLexer::TokenType::UV))
 				registerAttributeFn(usingUV, "UV", Mesh::UV_ID, ShaderAST::VariableType::Vec2);
 			else if (CheckToken(ShaderLexer::TokenType::NORMAL))
+			{
 				registerAttributeFn(usingNormal, "NORMAL", Mesh::NORMAL_ID, ShaderAST::VariableType::Vec3);
+				registerDequantizationFn();
+			}
 			else if (CheckToken(ShaderLexer::TokenType::TANGENT))
+			{
 				registerAttributeFn(usingTangent, "TANGENT", Mesh::TANGENT_ID, ShaderAST::VariableType::Vec3);
+				registerDequantizationFn();
+			}
 			else if (CheckToken(ShaderLexer::TokenType::BONE_WEIGHTS))
 				registerAttributeFn(usingBoneWeights, "BONE_WEIGHTS", SkinnedMesh::BONE_WEIGHT_ID, ShaderAST::VariableType::Vec4);
 			else if (CheckToken(ShaderLexer::TokenType::BONE_INDICES))
@@ -711,19 +771,7 @@ namespace sh::render
 			{
 				if (!usingMatrixModel)
 				{
-					auto it = std::find_if(stageNode.buffers.begin(), stageNode.buffers.end(),
-						[](const ShaderAST::BufferNode& ubo) { return ubo.name == "CONSTANTS"; });
-					if (it == stageNode.buffers.end())
-					{
-						ShaderAST::BufferNode uboNode{};
-						uboNode.bufferType = ShaderAST::BufferType::PushConstant;
-						uboNode.name = "CONSTANTS";
-						uboNode.set = static_cast<uint32_t>(UniformStructLayout::Usage::Object); // 의미 없음
-						uboNode.binding = 0; // 의미 없음
-						uboNode.vars.push_back(ShaderAST::VariableNode{ ShaderAST::VariableType::Mat4, 1, "model" });
-						stageNode.buffers.push_back(std::move(uboNode));
-						uboit = refreshUboIt();
-					}
+					registerConstantsFn(false);
 					usingMatrixModel = true;
 				}
 			}
@@ -804,6 +852,7 @@ namespace sh::render
 						stageNode.skinBinding = ssboNode.binding;
 						uboit = refreshUboIt();
 					}
+					registerSkinOffsetFn();
 					usingSKIN = true;
 				}
 			}
@@ -823,10 +872,10 @@ namespace sh::render
 		if (usingMATRIX_SKIN)
 		{
 			code = "mat4 MATRIX_SKIN = "
-				"BONE_WEIGHTS.x * SKIN.ibm[BONE_INDICES.x] + "
-				"BONE_WEIGHTS.y * SKIN.ibm[BONE_INDICES.y] + "
-				"BONE_WEIGHTS.z * SKIN.ibm[BONE_INDICES.z] + "
-				"BONE_WEIGHTS.w * SKIN.ibm[BONE_INDICES.w]; "
+				"BONE_WEIGHTS.x * SKIN.ibm[CONSTANTS.skinOffset + BONE_INDICES.x] + "
+				"BONE_WEIGHTS.y * SKIN.ibm[CONSTANTS.skinOffset + BONE_INDICES.y] + "
+				"BONE_WEIGHTS.z * SKIN.ibm[CONSTANTS.skinOffset + BONE_INDICES.z] + "
+				"BONE_WEIGHTS.w * SKIN.ibm[CONSTANTS.skinOffset + BONE_INDICES.w]; "
 				+ code;
 		}
 		return code;
@@ -1085,8 +1134,30 @@ namespace sh::render
 	void ShaderParser::GenerateStageCode(int stageIdx, const ShaderAST::ShaderNode& shaderNode, const ShaderAST::PassNode& passNode, ShaderAST::StageNode& stageNode)
 	{
 		std::string code = fmt::format("#version {} {}\n", shaderNode.version.versionNumber, shaderNode.version.profile);
+		// 버텍스 스테이지의 위치, 노말, 탄젠트는 양자화된 값일 수 있으므로 복원 매크로를 거쳐 쓴다.
+		const bool bDequantize = stageNode.type == ShaderAST::StageType::Vertex &&
+			std::any_of(stageNode.buffers.begin(), stageNode.buffers.end(),
+				[](const ShaderAST::BufferNode& buffer)
+				{
+					return buffer.name == "CONSTANTS" && std::any_of(buffer.vars.begin(), buffer.vars.end(),
+						[](const ShaderAST::VariableNode& var) { return var.name == "meshScale"; });
+				}
+			);
+		auto isDequantizedInputFn = [bDequantize](const std::string& name)
+		{
+			return bDequantize && (name == "VERTEX" || name == "NORMAL" || name == "TANGENT");
+		};
+		std::vector<std::string_view> dequantizedInputs;
 		for (auto& in : stageNode.in)
-			code += fmt::format("layout(location = {}) in {} {};\n", in.binding, VariableTypeToString(in.var.type), in.var.name);
+		{
+			if (isDequantizedInputFn(in.var.name))
+			{
+				code += fmt::format("layout(location = {}) in {} SH_IN_{};\n", in.binding, VariableTypeToString(in.var.type), in.var.name);
+				dequantizedInputs.push_back(in.var.name);
+			}
+			else
+				code += fmt::format("layout(location = {}) in {} {};\n", in.binding, VariableTypeToString(in.var.type), in.var.name);
+		}
 		for (auto& out : stageNode.out)
 			code += fmt::format("layout(location = {}) out {} {};\n", out.binding, VariableTypeToString(out.var.type), out.var.name);
 
@@ -1151,6 +1222,19 @@ namespace sh::render
 			else
 				code += fmt::format("layout (constant_id = {}) const {} {} = {};", i, VariableTypeToString(varNode.type), varNode.name, varNode.defaultValue);
 		}
+		if (!dequantizedInputs.empty())
+		{
+			// meshScale.w가 0이 아니면 노말과 탄젠트는 팔면체 인코딩 돼있다. (MeshOptimizer::DecodeOctahedral과 같다)
+			code += "vec3 SH_DecodeOctahedral(vec3 e) { vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y)); float t = max(-n.z, 0.0); "
+				"n.x += n.x >= 0.0 ? -t : t; n.y += n.y >= 0.0 ? -t : t; return normalize(n); }\n";
+			for (std::string_view name : dequantizedInputs)
+			{
+				if (name == "VERTEX")
+					code += "#define VERTEX (CONSTANTS.meshOffset.xyz + SH_IN_VERTEX * CONSTANTS.meshScale.xyz)\n";
+				else
+					code += fmt::format("#define {0} (CONSTANTS.meshScale.w != 0.0 ? SH_DecodeOctahedral(SH_IN_{0}) : SH_IN_{0})\n", name);
+			}
+		}
 		for (auto& decl : stageNode.declaration)
 			code += decl + '\n';
 		for (auto& function : stageNode.functions)
@@ -129,6 +129,7 @@ namespace sh::render
 			viewer.to = caster->GetShadowLookAt();
 			viewer.viewportRect = glm::uvec4{ atlasSize * slot.uvOffset.x, atlasSize * slot.uvOffset.y, atlasSize * slot.uvSize.x, atlasSize * slot.uvSize.y };
 			viewer.viewportScissor = viewer.viewportRect;
+			viewer.lodSlot = RenderViewer::SHADOW_LOD_SLOT;
 			renderData.renderViewers.push_back(viewer);
 		}
 
@@ -0,0 +1,110 @@
+﻿#include "Skeleton.h"
+
+#include <algorithm>
+#include <cmath>
+namespace sh::render
+{
+	SH_RENDER_API void Skeleton::BuildHierarchy(const std::vector<int>& nodeParents, const std::vector<glm::mat4>& nodeMatrices, const std::vector<std::string>& nodeNames)
+	{
+		const int nodeCount = static_cast<int>(nodeParents.size());
+		std::vector<int> nodeToJoint(nodeCount, -1);
+		for (std::size_t i = 0; i < joints.size(); ++i)
+		{
+			const int nodeIdx = joints[i].nodeIdx;
+			if (nodeIdx >= 0 && nodeIdx < nodeCount)
+				nodeToJoint[nodeIdx] = static_cast<int>(i);
+		}
+
+		std::vector<int> depths(joints.size(), 0);
+		for (Joint& joint : joints)
+		{
+			joint.parentIdx = -1;
+			joint.parentMat = glm::mat4{ 1.f };
+			if (joint.nodeIdx < 0 || joint.nodeIdx >= nodeCount)
+				continue;
+
+			joint.name = joint.nodeIdx < static_cast<int>(nodeNames.size()) ? nodeNames[joint.nodeIdx] : std::string{};
+			if (joint.nodeIdx < static_cast<int>(nodeMatrices.size()))
+				DecomposeMatrix(nodeMatrices[joint.nodeIdx], joint.restTranslation, joint.restRotation, joint.restScale);
+
+			// 조인트가 아닌 중간 노드들의 행렬은 parentMat에 모아둔다.
+			int parent = nodeParents[joint.nodeIdx];
+			while (parent >= 0 && parent < nodeCount)
+			{
+				if (nodeToJoint[parent] >= 0)
+				{
+					joint.parentIdx = nodeToJoint[parent];
+					break;
+				}
+				if (parent < static_cast<int>(nodeMatrices.size()))
+					joint.parentMat = nodeMatrices[parent] * joint.parentMat;
+				parent = nodeParents[parent];
+			}
+		}
+		for (std::size_t i = 0; i < joints.size(); ++i)
+		{
+			int parent = joints[i].parentIdx;
+			while (parent >= 0 && depths[i] <= static_cast<int>(joints.size()))
+			{
+				++depths[i];
+				parent = joints[parent].parentIdx;
+			}
+		}
+		order.resize(joints.size());
+		for (std::size_t i = 0; i < order.size(); ++i)
+			order[i] = static_cast<uint32_t>(i);
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depths[a] < depths[b]; });
+	}
+	SH_RENDER_API auto Skeleton::FindJoint(const std::string& name) const -> int
+	{
+		for (std::size_t i = 0; i < joints.size(); ++i)
+		{
+			if (joints[i].name == name)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+	SH_RENDER_API void Skeleton::DecomposeMatrix(const glm::mat4& mat, glm::vec3& translation, glm::vec4& rotation, glm::vec3& scale)
+	{
+		translation = glm::vec3{ mat[3].x, mat[3].y, mat[3].z };
+
+		glm::vec3 axis[3] =
+		{
+			glm::vec3{ mat[0].x, mat[0].y, mat[0].z },
+			glm::vec3{ mat[1].x, mat[1].y, mat[1].z },
+			glm::vec3{ mat[2].x, mat[2].y, mat[2].z }
+		};
+		scale = glm::vec3{ glm::length(axis[0]), glm::length(axis[1]), glm::length(axis[2]) };
+		if (glm::dot(glm::cross(axis[0], axis[1]), axis[2]) < 0.f)
+			scale.x = -scale.x;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (scale[i] != 0.f)
+				axis[i] = axis[i] / scale[i];
+		}
+
+		// r(행, 열)
+		const auto r = [&](int row, int col) { return axis[col][row]; };
+		const float trace = r(0, 0) + r(1, 1) + r(2, 2);
+		if (trace > 0.f)
+		{
+			const float s = std::sqrt(trace + 1.f) * 2.f;
+			rotation = glm::vec4{ (r(2, 1) - r(1, 2)) / s, (r(0, 2) - r(2, 0)) / s, (r(1, 0) - r(0, 1)) / s, 0.25f * s };
+		}
+		else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2))
+		{
+			const float s = std::sqrt(1.f + r(0, 0) - r(1, 1) - r(2, 2)) * 2.f;
+			rotation = glm::vec4{ 0.25f * s, (r(0, 1) + r(1, 0)) / s, (r(0, 2) + r(2, 0)) / s, (r(2, 1) - r(1, 2)) / s };
+		}
+		else if (r(1, 1) > r(2, 2))
+		{
+			const float s = std::sqrt(1.f + r(1, 1) - r(0, 0) - r(2, 2)) * 2.f;
+			rotation = glm::vec4{ (r(0, 1) + r(1, 0)) / s, 0.25f * s, (r(1, 2) + r(2, 1)) / s, (r(0, 2) - r(2, 0)) / s };
+		}
+		else
+		{
+			const float s = std::sqrt(1.f + r(2, 2) - r(0, 0) - r(1, 1)) * 2.f;
+			rotation = glm::vec4{ (r(0, 2) + r(2, 0)) / s, (r(1, 2) + r(2, 1)) / s, 0.25f * s, (r(1, 0) - r(0, 1)) / s };
+		}
+	}
+}//namespace
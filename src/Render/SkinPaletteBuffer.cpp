@@ -0,0 +1,69 @@
+﻿#include "SkinPaletteBuffer.h"
+#include "BufferFactory.h"
+
+#include "Core/ThreadSyncManager.h"
+
+#include <algorithm>
+#include <cassert>
+namespace sh::render
+{
+	SkinPaletteBuffer::SkinPaletteBuffer() = default;
+	SkinPaletteBuffer::~SkinPaletteBuffer() = default;
+
+	SH_RENDER_API void SkinPaletteBuffer::Init(const IRenderContext& ctx)
+	{
+		if (buffer != nullptr)
+			return;
+
+		BufferFactory::CreateInfo info{};
+		info.size = CAPACITY * sizeof(glm::mat4);
+		info.bDynamic = true;
+		info.bGPUOnly = false;
+
+		buffer = BufferFactory::Create(ctx, info);
+	}
+	SH_RENDER_API auto SkinPaletteBuffer::Allocate(std::size_t count, uint32_t& offset) -> glm::mat4*
+	{
+		assert(core::ThreadSyncManager::IsMainThread());
+		std::vector<glm::mat4>& palette = palettes[core::ThreadType::Game];
+		offset = static_cast<uint32_t>(palette.size());
+		// 넘친 경우는 매 프레임 반복되므로 호출한 쪽에서 한 번만 알린다.
+		count = std::min(count, CAPACITY - palette.size());
+		if (count == 0)
+			return nullptr;
+		palette.resize(palette.size() + count);
+		SyncDirty();
+		return palette.data() + offset;
+	}
+	SH_RENDER_API void SkinPaletteBuffer::SyncDirty()
+	{
+		if (bDirty)
+			return;
+
+		core::ThreadSyncManager::PushSyncable(*this);
+
+		bDirty = true;
+	}
+	SH_RENDER_API void SkinPaletteBuffer::Sync()
+	{
+		std::swap(palettes[core::ThreadType::Game], palettes[core::ThreadType::Render]);
+		palettes[core::ThreadType::Game].clear();
+		bUploaded = false;
+		bDirty = false;
+	}
+	SH_RENDER_API void SkinPaletteBuffer::ClearBuffer()
+	{
+		buffer.reset();
+	}
+	SH_RENDER_API void SkinPaletteBuffer::UploadToGPU()
+	{
+		if (bUploaded || buffer == nullptr)
+			return;
+		bUploaded = true;
+
+		const std::vector<glm::mat4>& palette = palettes[core::ThreadType::Render];
+		if (palette.empty())
+			return;
+		buffer->SetData(palette.data(), 0, std::min(palette.size(), CAPACITY) * sizeof(glm::mat4));
+	}
+}//namespace
@@ -21,6 +21,8 @@ namespace sh::render
 
 	SH_RENDER_API void SkinnedMesh::Build(const IRenderContext& context)
 	{
+		this->context = &context;
+
 		CreateFace();
 
 		SetVertexBuffer(VertexBufferFactory::CreateSkinned(context, *this));
@@ -1,8 +1,10 @@
 ﻿#include "Texture.h"
 #include "VulkanContext.h"
 #include "VulkanImageBuffer.h"
+#include "TextureCompressor.h"
 
 #include "Core/ThreadSyncManager.h"
+#include "Core/Logger.h"
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <External/stb/stb_image_write.h>
@@ -18,6 +20,7 @@ namespace sh::render
 	{
 		bSRGB = CheckSRGB();
 		bGenerateMipmap = bUseMipmap;
+		compression = TextureCompressor::GetCompression(format);
 
 		uint32_t mipLevels = bUseMipmap ? static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1 : 1;
 		pixels.resize(mipLevels);
@@ -25,7 +28,7 @@ namespace sh::render
 		int mipHeight = height;
 		for (int i = 0; i < mipLevels; ++i)
 		{
-			pixels[i].resize(mipWidth * mipHeight * GetTextureFormatPixelSize(format));
+			pixels[i].resize(GetTextureFormatMipSize(format, mipWidth, mipHeight));
 			mipWidth = std::max(1, mipWidth / 2);
 			mipHeight = std::max(1, mipHeight / 2);
 		}
@@ -36,7 +39,8 @@ namespace sh::render
 		pixels(std::move(other.pixels)), textureBuffer(std::move(other.textureBuffer)),
 		onBufferUpdate(std::move(other.onBufferUpdate)),
 		aniso(other.aniso),
-		bSRGB(other.bSRGB), bSetDataDirty(other.bSetDataDirty)
+		bSRGB(other.bSRGB), compression(other.compression), bSetDataDirty(other.bSetDataDirty),
+		residentMip(other.residentMip), keepMip(other.keepMip)
 	{
 		if (other.bDirty.test_and_set(std::memory_order::memory_order_acquire))
 			bDirty.test_and_set(std::memory_order::memory_order_relaxed);
@@ -76,6 +80,10 @@ namespace sh::render
 		{
 			SetFiltering(filtering);
 		}
+		else if (prop.GetName() == core::Util::ConstexprHash("compression"))
+		{
+			SetCompression(compression);
+		}
 	}
 
 	SH_RENDER_API void Texture::SetPixelData(std::vector<uint8_t> pixels, uint32_t mipLevel)
@@ -139,6 +147,13 @@ namespace sh::render
 			return 1;
 		return pixels.size();
 	}
+	SH_RENDER_API auto Texture::GetResidentSize() const -> std::size_t
+	{
+		std::size_t size = 0;
+		for (uint32_t m = residentMip; m < pixels.size(); ++m)
+			size += GetTextureFormatMipSize(format, std::max(1u, width >> m), std::max(1u, height >> m));
+		return size;
+	}
 	SH_RENDER_API void sh::render::Texture::SetAnisoLevel(uint32_t aniso)
 	{
 		this->aniso = aniso;
@@ -162,6 +177,12 @@ namespace sh::render
 				ChangeTextureFormat(TextureFormat::SRGB24);
 			else if (format == TextureFormat::RGBA32)
 				ChangeTextureFormat(TextureFormat::SRGBA32);
+			else if (format == TextureFormat::BC1)
+				ChangeTextureFormat(TextureFormat::BC1_SRGB);
+			else if (format == TextureFormat::BC3)
+				ChangeTextureFormat(TextureFormat::BC3_SRGB);
+			else if (format == TextureFormat::BC7)
+				ChangeTextureFormat(TextureFormat::BC7_SRGB);
 		}
 		else
 		{
@@ -169,6 +190,12 @@ namespace sh::render
 				ChangeTextureFormat(TextureFormat::RGB24);
 			else if (format == TextureFormat::SRGBA32)
 				ChangeTextureFormat(TextureFormat::RGBA32);
+			else if (format == TextureFormat::BC1_SRGB)
+				ChangeTextureFormat(TextureFormat::BC1);
+			else if (format == TextureFormat::BC3_SRGB)
+				ChangeTextureFormat(TextureFormat::BC3);
+			else if (format == TextureFormat::BC7_SRGB)
+				ChangeTextureFormat(TextureFormat::BC7);
 		}
 	}
 	SH_RENDER_API void Texture::SetFiltering(Filtering filter)
@@ -180,8 +207,85 @@ namespace sh::render
 			SyncDirty();
 		}
 	}
+	SH_RENDER_API void Texture::SetCompression(TextureCompression compression)
+	{
+		const TextureCompression current = TextureCompressor::GetCompression(format);
+		this->compression = compression;
+		if (current == compression)
+			return;
+
+		if (IsCompressedTextureFormat(format))
+		{
+			SH_INFO("Texture is already compressed. The compression setting will be applied on re-import.");
+			return;
+		}
+		if (format != TextureFormat::RGBA32 && format != TextureFormat::SRGBA32 &&
+			format != TextureFormat::RGB24 && format != TextureFormat::SRGB24)
+		{
+			SH_ERROR_FORMAT("Can't compress texture format: {}", TextureFormatToString(format));
+			return;
+		}
+		const bool bHasAlpha = (format == TextureFormat::RGBA32 || format == TextureFormat::SRGBA32) && TextureCompressor::HasAlpha(pixels[0]);
+		const TextureFormat target = TextureCompressor::GetCompressedFormat(compression, bSRGB, bHasAlpha);
+
+		auto compressed = TextureCompressor::Compress(pixels, width, height, target);
+		if (compressed.empty())
+			return;
+		pixels = std::move(compressed);
+
+		ChangeTextureFormat(target);
+	}
+	SH_RENDER_API auto Texture::SetResidentMips(uint32_t firstMip, std::vector<std::vector<Byte>> mips) -> bool
+	{
+		const uint32_t mipCount = static_cast<uint32_t>(pixels.size());
+		if (firstMip >= mipCount || firstMip + mips.size() > mipCount)
+		{
+			SH_ERROR_FORMAT("Invalid resident mip: {} (mip count: {})", firstMip, mipCount);
+			return false;
+		}
+		for (uint32_t m = firstMip; m < mipCount; ++m)
+		{
+			const std::size_t idx = m - firstMip;
+			const std::vector<Byte>& data = idx < mips.size() ? mips[idx] : pixels[m];
+			const std::size_t expected = GetTextureFormatMipSize(format, std::max(1u, width >> m), std::max(1u, height >> m));
+			if (data.size() != expected)
+			{
+				SH_ERROR_FORMAT("Mip {} data is not ready ({} != {})", m, data.size(), expected);
+				return false;
+			}
+		}
+		for (std::size_t i = 0; i < mips.size(); ++i)
+			pixels[firstMip + i] = std::move(mips[i]);
+		for (uint32_t m = 0; m < firstMip; ++m)
+			std::vector<Byte>{}.swap(pixels[m]);
+
+		residentMip = firstMip;
+		if (textureBuffer != nullptr)
+		{
+			bSetDataDirty = true;
+			SyncDirty();
+		}
+		return true;
+	}
+	SH_RENDER_API void Texture::SetPixelDataKeepMip(uint32_t keepMip)
+	{
+		this->keepMip = keepMip;
+		// 이미 올라간 데이터라면 바로 해제한다.
+		if (textureBuffer != nullptr && !bSetDataDirty)
+			ReleaseUploadedPixelData();
+	}
 	SH_RENDER_API void Texture::ExportToPNG(const std::filesystem::path& path)
 	{
+		if (IsCompressedTextureFormat(format))
+		{
+			SH_ERROR_FORMAT("Can't export compressed texture({}) to png", TextureFormatToString(format));
+			return;
+		}
+		if (pixels[0].empty())
+		{
+			SH_ERROR("Can't export texture: pixel data is released");
+			return;
+		}
 		stbi_write_png(path.u8string().c_str(), width, height, GetTextureFormatChannel(format), pixels[0].data(), width * GetTextureFormatChannel(format));
 	}
 
@@ -192,28 +296,53 @@ namespace sh::render
 			if (context->GetRenderAPIType() == RenderAPI::Vulkan)
 				textureBuffer = std::make_unique<vk::VulkanImageBuffer>();
 		}
+		if (IsCompressedTextureFormat(format) && !context->IsTextureCompressionSupported())
+			DecompressForContext();
+
+		// 업로드 후 해제된 밉은 다시 올릴 수 없으므로 메모리에 남아있는 밉부터 올린다.
+		while (residentMip + 1 < pixels.size() && pixels[residentMip].empty())
+			++residentMip;
 
 		ITextureBuffer::CreateInfo ci{};
-		ci.width = width;
-		ci.height = height;
+		ci.width = std::max(1u, width >> residentMip);
+		ci.height = std::max(1u, height >> residentMip);
 		ci.format = format;
 		ci.aniso = aniso;
 		ci.filtering = static_cast<uint32_t>(filtering);
-		ci.mipLevel = pixels.size();
+		ci.mipLevel = pixels.size() - residentMip;
 		ci.bMSAAImg = false;
 		ci.bRenderTarget = false;
 
 		textureBuffer->Create(*context, ci);
 
-		const int mipLevel = bGenerateMipmap ? pixels.size() : 1;
-		for (int m = 0; m < mipLevel; ++m)
-			textureBuffer->SetData(pixels[m].data(), m);
+		const uint32_t mipLevel = bGenerateMipmap ? ci.mipLevel : 1;
+		for (uint32_t m = 0; m < mipLevel; ++m)
+			textureBuffer->SetData(pixels[residentMip + m].data(), m);
 
 		onBufferUpdate.Notify(this);
+
+		ReleaseUploadedPixelData();
+	}
+	void Texture::DecompressForContext()
+	{
+		auto decompressed = TextureCompressor::Decompress(pixels, width, height, format);
+		if (decompressed.empty())
+			return;
+		pixels = std::move(decompressed);
+		// 압축 설정은 그대로 두므로 다시 임포트 하거나 지원하는 장치에서는 압축된다.
+		format = TextureCompressor::GetDecompressedFormat(format);
+		bSRGB = CheckSRGB();
+	}
+	void Texture::ReleaseUploadedPixelData()
+	{
+		const std::size_t count = std::min<std::size_t>(keepMip, pixels.size() - 1);
+		for (std::size_t m = 0; m < count; ++m)
+			std::vector<Byte>{}.swap(pixels[m]);
 	}
 	auto Texture::CheckSRGB() const -> bool
 	{
-		if (format == TextureFormat::SRGB24 || format == TextureFormat::SRGBA32)
+		if (format == TextureFormat::SRGB24 || format == TextureFormat::SRGBA32 ||
+			format == TextureFormat::BC1_SRGB || format == TextureFormat::BC3_SRGB || format == TextureFormat::BC7_SRGB)
 			return true;
 		return false;
 	}
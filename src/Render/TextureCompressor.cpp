@@ -0,0 +1,709 @@
+﻿#include "TextureCompressor.h"
+
+#include "Core/Logger.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SH_TEXTURE_COMPRESSOR_SSE2 1
+#include <emmintrin.h>
+#endif
+namespace sh::render
+{
+	namespace
+	{
+		constexpr int BLOCK_PIXELS = 16;
+		constexpr uint32_t BLOCK_ROWS_PER_TASK = 16;
+
+		/// @brief 블록의 채널별 최소, 최대 값을 구한다.
+		inline void ComputeMinMax(const uint8_t* block, uint8_t* minColor, uint8_t* maxColor)
+		{
+#if SH_TEXTURE_COMPRESSOR_SSE2
+			const __m128i* src = reinterpret_cast<const __m128i*>(block);
+			const __m128i p0 = _mm_loadu_si128(src + 0);
+			const __m128i p1 = _mm_loadu_si128(src + 1);
+			const __m128i p2 = _mm_loadu_si128(src + 2);
+			const __m128i p3 = _mm_loadu_si128(src + 3);
+			__m128i mn = _mm_min_epu8(_mm_min_epu8(p0, p1), _mm_min_epu8(p2, p3));
+			__m128i mx = _mm_max_epu8(_mm_max_epu8(p0, p1), _mm_max_epu8(p2, p3));
+			// 레지스터 안의 4픽셀을 1픽셀로 줄인다.
+			mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(1, 0, 3, 2)));
+			mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(2, 3, 0, 1)));
+			mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(1, 0, 3, 2)));
+			mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(2, 3, 0, 1)));
+			const int minBits = _mm_cvtsi128_si32(mn);
+			const int maxBits = _mm_cvtsi128_si32(mx);
+			std::memcpy(minColor, &minBits, 4);
+			std::memcpy(maxColor, &maxBits, 4);
+#else
+			for (int c = 0; c < 4; ++c)
+			{
+				minColor[c] = 255;
+				maxColor[c] = 0;
+			}
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					minColor[c] = std::min(minColor[c], block[i * 4 + c]);
+					maxColor[c] = std::max(maxColor[c], block[i * 4 + c]);
+				}
+			}
+#endif
+		}
+		/// @brief 16개의 픽셀을 base에서 dir 방향으로 투영한 내적 값을 구한다.
+		inline void Project(const uint8_t* block, const int16_t* base, const int16_t* dir, int32_t* dots)
+		{
+#if SH_TEXTURE_COMPRESSOR_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i baseV = _mm_setr_epi16(base[0], base[1], base[2], base[3], base[0], base[1], base[2], base[3]);
+			const __m128i dirV = _mm_setr_epi16(dir[0], dir[1], dir[2], dir[3], dir[0], dir[1], dir[2], dir[3]);
+			for (int i = 0; i < 4; ++i)
+			{
+				const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block) + i);
+				const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(px, zero), baseV);
+				const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(px, zero), baseV);
+				// [p0.rg, p0.ba, p1.rg, p1.ba]
+				__m128i dotLo = _mm_madd_epi16(lo, dirV);
+				__m128i dotHi = _mm_madd_epi16(hi, dirV);
+				dotLo = _mm_add_epi32(dotLo, _mm_shuffle_epi32(dotLo, _MM_SHUFFLE(2, 3, 0, 1)));
+				dotHi = _mm_add_epi32(dotHi, _mm_shuffle_epi32(dotHi, _MM_SHUFFLE(2, 3, 0, 1)));
+				const __m128i result = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(dotLo), _mm_castsi128_ps(dotHi), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dots) + i, result);
+			}
+#else
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+			{
+				int32_t dot = 0;
+				for (int c = 0; c < 4; ++c)
+					dot += (static_cast<int32_t>(block[i * 4 + c]) - base[c]) * dir[c];
+				dots[i] = dot;
+			}
+#endif
+		}
+		/// @brief 블록을 대표하는 두 끝점을 구한다.
+		/// @brief 바운딩 박스를 1/16만큼 안쪽으로 줄이고, 가장 범위가 큰 채널과 반대로 움직이는 채널은 대각선을 뒤집는다.
+		/// @param channels 사용할 채널 수 (3: RGB, 4: RGBA)
+		inline void FitEndpoints(const uint8_t* block, int channels, uint8_t* start, uint8_t* end)
+		{
+			uint8_t minColor[4];
+			uint8_t maxColor[4];
+			ComputeMinMax(block, minColor, maxColor);
+
+			int dominant = 0;
+			for (int c = 0; c < channels; ++c)
+			{
+				const int inset = (maxColor[c] - minColor[c]) >> 4;
+				minColor[c] = static_cast<uint8_t>(minColor[c] + inset);
+				maxColor[c] = static_cast<uint8_t>(maxColor[c] - inset);
+				if (maxColor[c] - minColor[c] > maxColor[dominant] - minColor[dominant])
+					dominant = c;
+			}
+			int center[4];
+			for (int c = 0; c < 4; ++c)
+				center[c] = (minColor[c] + maxColor[c]) / 2;
+
+			int cov[4] = { 0, 0, 0, 0 };
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+			{
+				const int d = block[i * 4 + dominant] - center[dominant];
+				for (int c = 0; c < channels; ++c)
+					cov[c] += d * (block[i * 4 + c] - center[c]);
+			}
+			for (int c = 0; c < 4; ++c)
+			{
+				if (c < channels && cov[c] < 0)
+				{
+					start[c] = minColor[c];
+					end[c] = maxColor[c];
+				}
+				else
+				{
+					start[c] = maxColor[c];
+					end[c] = minColor[c];
+				}
+			}
+		}
+
+		inline auto To565(const uint8_t* color) -> uint16_t
+		{
+			const uint32_t r = (color[0] * 31 + 127) / 255;
+			const uint32_t g = (color[1] * 63 + 127) / 255;
+			const uint32_t b = (color[2] * 31 + 127) / 255;
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+		inline void From565(uint16_t packed, uint8_t* color)
+		{
+			const uint32_t r = (packed >> 11) & 31;
+			const uint32_t g = (packed >> 5) & 63;
+			const uint32_t b = packed & 31;
+			color[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+			color[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+			color[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+			color[3] = 255;
+		}
+
+		void EncodeBC1(const uint8_t* block, uint8_t* out)
+		{
+			uint8_t start[4];
+			uint8_t end[4];
+			FitEndpoints(block, 3, start, end);
+
+			uint16_t c0 = To565(start);
+			uint16_t c1 = To565(end);
+			// 4색 모드는 c0 > c1 이어야 한다.
+			if (c0 < c1)
+				std::swap(c0, c1);
+
+			uint32_t indices = 0;
+			if (c0 != c1)
+			{
+				uint8_t e0[4];
+				uint8_t e1[4];
+				From565(c0, e0);
+				From565(c1, e1);
+
+				const int16_t base[4] = { e1[0], e1[1], e1[2], 0 };
+				const int16_t dir[4] = {
+					static_cast<int16_t>(e0[0] - e1[0]),
+					static_cast<int16_t>(e0[1] - e1[1]),
+					static_cast<int16_t>(e0[2] - e1[2]),
+					0
+				};
+				const int32_t len2 = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+
+				int32_t dots[BLOCK_PIXELS];
+				Project(block, base, dir, dots);
+
+				// 투영 단계(0: c1 ~ 3: c0)를 BC1 인덱스로
+				constexpr uint32_t remap[4] = { 1, 3, 2, 0 };
+				for (int i = 0; i < BLOCK_PIXELS; ++i)
+				{
+					const int32_t t = std::clamp(dots[i], 0, len2);
+					const int32_t step = (t * 6 + len2) / (2 * len2);
+					indices |= remap[step] << (i * 2);
+				}
+			}
+			out[0] = static_cast<uint8_t>(c0 & 0xff);
+			out[1] = static_cast<uint8_t>(c0 >> 8);
+			out[2] = static_cast<uint8_t>(c1 & 0xff);
+			out[3] = static_cast<uint8_t>(c1 >> 8);
+			for (int i = 0; i < 4; ++i)
+				out[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+		}
+		void EncodeBC4(const uint8_t* block, int channel, uint8_t* out)
+		{
+			uint8_t minValue = 255;
+			uint8_t maxValue = 0;
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+			{
+				minValue = std::min(minValue, block[i * 4 + channel]);
+				maxValue = std::max(maxValue, block[i * 4 + channel]);
+			}
+			// 8단계 모드는 r0 > r1
+			out[0] = maxValue;
+			out[1] = minValue;
+
+			uint64_t indices = 0;
+			if (maxValue != minValue)
+			{
+				const int32_t range = maxValue - minValue;
+				// 투영 단계(0: r1 ~ 7: r0)를 BC4 인덱스로
+				constexpr uint64_t remap[8] = { 1, 7, 6, 5, 4, 3, 2, 0 };
+				for (int i = 0; i < BLOCK_PIXELS; ++i)
+				{
+					const int32_t t = block[i * 4 + channel] - minValue;
+					const int32_t step = (t * 14 + range) / (2 * range);
+					indices |= remap[step] << (i * 3);
+				}
+			}
+			for (int i = 0; i < 6; ++i)
+				out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+		}
+
+		/// @brief 8비트 끝점을 7비트 + p비트로 양자화한다. p비트는 오차가 작은 쪽을 고른다.
+		inline void QuantizeBC7Endpoint(const uint8_t* color, uint8_t* quantized, int& pbit)
+		{
+			int bestError = std::numeric_limits<int>::max();
+			for (int p = 0; p < 2; ++p)
+			{
+				uint8_t q[4];
+				int error = 0;
+				for (int c = 0; c < 4; ++c)
+				{
+					q[c] = static_cast<uint8_t>(std::clamp((color[c] - p + 1) / 2, 0, 127));
+					const int diff = ((q[c] << 1) | p) - color[c];
+					error += diff * diff;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					pbit = p;
+					std::memcpy(quantized, q, 4);
+				}
+			}
+		}
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(uint8_t* out) :
+				out(out)
+			{
+				std::memset(out, 0, 16);
+			}
+			void Write(uint32_t value, int bits)
+			{
+				for (int i = 0; i < bits; ++i, ++pos)
+				{
+					if ((value >> i) & 1)
+						out[pos / 8] |= static_cast<uint8_t>(1 << (pos % 8));
+				}
+			}
+		private:
+			uint8_t* out;
+			int pos = 0;
+		};
+		/// @brief BC7 모드 6 (서브셋 1개, RGBA 7.7.7.7 + p비트, 4비트 인덱스)으로 압축한다.
+		void EncodeBC7(const uint8_t* block, uint8_t* out)
+		{
+			constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+			uint8_t start[4];
+			uint8_t end[4];
+			FitEndpoints(block, 4, start, end);
+
+			uint8_t q0[4];
+			uint8_t q1[4];
+			int p0 = 0;
+			int p1 = 0;
+			QuantizeBC7Endpoint(start, q0, p0);
+			QuantizeBC7Endpoint(end, q1, p1);
+
+			uint8_t e0[4];
+			uint8_t e1[4];
+			for (int c = 0; c < 4; ++c)
+			{
+				e0[c] = static_cast<uint8_t>((q0[c] << 1) | p0);
+				e1[c] = static_cast<uint8_t>((q1[c] << 1) | p1);
+			}
+			const int16_t base[4] = { e0[0], e0[1], e0[2], e0[3] };
+			int16_t dir[4];
+			int32_t len2 = 0;
+			for (int c = 0; c < 4; ++c)
+			{
+				dir[c] = static_cast<int16_t>(e1[c] - e0[c]);
+				len2 += dir[c] * dir[c];
+			}
+
+			int indices[BLOCK_PIXELS] = {};
+			if (len2 > 0)
+			{
+				int32_t dots[BLOCK_PIXELS];
+				Project(block, base, dir, dots);
+				for (int i = 0; i < BLOCK_PIXELS; ++i)
+				{
+					const int32_t t = std::clamp(dots[i], 0, len2);
+					const int step = (t * 30 + len2) / (2 * len2);
+
+					// 가중치가 균등하지 않으므로 이웃 인덱스와 실제 오차를 비교한다.
+					int bestError = std::numeric_limits<int>::max();
+					for (int candidate = std::max(0, step - 1); candidate <= std::min(15, step + 1); ++candidate)
+					{
+						const int w = weights[candidate];
+						int error = 0;
+						for (int c = 0; c < 4; ++c)
+						{
+							const int value = ((64 - w) * e0[c] + w * e1[c] + 32) >> 6;
+							const int diff = value - block[i * 4 + c];
+							error += diff * diff;
+						}
+						if (error < bestError)
+						{
+							bestError = error;
+							indices[i] = candidate;
+						}
+					}
+				}
+			}
+			// 첫 픽셀(앵커)의 인덱스는 최상위 비트가 0이어야 하므로 끝점을 뒤집는다.
+			if (indices[0] >= 8)
+			{
+				std::swap(q0, q1);
+				std::swap(p0, p1);
+				for (int& index : indices)
+					index = 15 - index;
+			}
+
+			BitWriter writer{ out };
+			writer.Write(1 << 6, 7); // 모드 6
+			for (int c = 0; c < 4; ++c)
+			{
+				writer.Write(q0[c], 7);
+				writer.Write(q1[c], 7);
+			}
+			writer.Write(p0, 1);
+			writer.Write(p1, 1);
+			writer.Write(indices[0], 3);
+			for (int i = 1; i < BLOCK_PIXELS; ++i)
+				writer.Write(indices[i], 4);
+		}
+
+		/// @brief BC1 블록을 RGBA로 복원한다.
+		/// @param bAlwaysFourColor BC3의 색 블록처럼 끝점 순서와 상관없이 4색 모드로 해석할지
+		void DecodeBC1(const uint8_t* in, bool bAlwaysFourColor, uint8_t* block)
+		{
+			const uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+			const uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+			uint8_t palette[4][4];
+			From565(c0, palette[0]);
+			From565(c1, palette[1]);
+			if (c0 > c1 || bAlwaysFourColor)
+			{
+				for (int c = 0; c < 3; ++c)
+				{
+					palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+					palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+				}
+				palette[2][3] = palette[3][3] = 255;
+			}
+			else
+			{
+				// 3색 모드. 마지막 인덱스는 투명한 검은색
+				for (int c = 0; c < 3; ++c)
+					palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+				palette[2][3] = 255;
+				std::memset(palette[3], 0, 4);
+			}
+			const uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+				std::memcpy(block + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+		}
+		/// @brief BC4 블록을 한 채널로 복원한다.
+		void DecodeBC4(const uint8_t* in, int channel, uint8_t* block)
+		{
+			const int r0 = in[0];
+			const int r1 = in[1];
+			int palette[8] = { r0, r1 };
+			if (r0 > r1)
+			{
+				for (int i = 1; i < 7; ++i)
+					palette[i + 1] = ((7 - i) * r0 + i * r1) / 7;
+			}
+			else
+			{
+				for (int i = 1; i < 5; ++i)
+					palette[i + 1] = ((5 - i) * r0 + i * r1) / 5;
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+			uint64_t indices = 0;
+			for (int i = 0; i < 6; ++i)
+				indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+				block[i * 4 + channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+		}
+		class BitReader
+		{
+		public:
+			explicit BitReader(const uint8_t* in) :
+				in(in)
+			{
+			}
+			auto Read(int bits) -> uint32_t
+			{
+				uint32_t value = 0;
+				for (int i = 0; i < bits; ++i, ++pos)
+					value |= static_cast<uint32_t>((in[pos / 8] >> (pos % 8)) & 1) << i;
+				return value;
+			}
+		private:
+			const uint8_t* in;
+			int pos = 0;
+		};
+		/// @brief BC7 블록을 RGBA로 복원한다. EncodeBC7이 쓰는 모드 6만 해석하고 다른 모드는 0으로 채운다.
+		/// @return 해석할 수 있는 블록이었는지
+		auto DecodeBC7(const uint8_t* in, uint8_t* block) -> bool
+		{
+			constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+			BitReader reader{ in };
+			if (reader.Read(7) != (1 << 6))
+			{
+				std::memset(block, 0, BLOCK_PIXELS * 4);
+				return false;
+			}
+			int e0[4];
+			int e1[4];
+			for (int c = 0; c < 4; ++c)
+			{
+				e0[c] = static_cast<int>(reader.Read(7));
+				e1[c] = static_cast<int>(reader.Read(7));
+			}
+			const int p0 = static_cast<int>(reader.Read(1));
+			const int p1 = static_cast<int>(reader.Read(1));
+			for (int c = 0; c < 4; ++c)
+			{
+				e0[c] = (e0[c] << 1) | p0;
+				e1[c] = (e1[c] << 1) | p1;
+			}
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+			{
+				const int w = weights[reader.Read(i == 0 ? 3 : 4)];
+				for (int c = 0; c < 4; ++c)
+					block[i * 4 + c] = static_cast<uint8_t>(((64 - w) * e0[c] + w * e1[c] + 32) >> 6);
+			}
+			return true;
+		}
+
+		/// @brief 이미지에서 4x4 블록을 읽는다. 가장자리를 넘어가는 픽셀은 마지막 픽셀로 채운다.
+		inline void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* block)
+		{
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				const uint32_t srcY = std::min(blockY * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					const uint32_t srcX = std::min(blockX * 4 + x, width - 1);
+					std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<std::size_t>(srcY) * width + srcX) * 4, 4);
+				}
+			}
+		}
+	}//namespace
+
+	SH_RENDER_API auto TextureCompressor::GetCompressedFormat(TextureCompression compression, bool bSRGB, bool bHasAlpha) -> TextureFormat
+	{
+		switch (compression)
+		{
+		case TextureCompression::Color:
+			if (bHasAlpha)
+				return bSRGB ? TextureFormat::BC3_SRGB : TextureFormat::BC3;
+			return bSRGB ? TextureFormat::BC1_SRGB : TextureFormat::BC1;
+		case TextureCompression::ColorHighQuality:
+			return bSRGB ? TextureFormat::BC7_SRGB : TextureFormat::BC7;
+		case TextureCompression::NormalMap:
+			return TextureFormat::BC5;
+		case TextureCompression::SingleChannel:
+			return TextureFormat::BC4;
+		default:
+			return TextureFormat::None;
+		}
+	}
+	SH_RENDER_API auto TextureCompressor::GetCompression(TextureFormat format) -> TextureCompression
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1: [[fallthrough]];
+		case TextureFormat::BC1_SRGB: [[fallthrough]];
+		case TextureFormat::BC3: [[fallthrough]];
+		case TextureFormat::BC3_SRGB:
+			return TextureCompression::Color;
+		case TextureFormat::BC7: [[fallthrough]];
+		case TextureFormat::BC7_SRGB:
+			return TextureCompression::ColorHighQuality;
+		case TextureFormat::BC5:
+			return TextureCompression::NormalMap;
+		case TextureFormat::BC4:
+			return TextureCompression::SingleChannel;
+		default:
+			return TextureCompression::None;
+		}
+	}
+	SH_RENDER_API auto TextureCompressor::HasAlpha(const std::vector<uint8_t>& rgba) -> bool
+	{
+		for (std::size_t i = 3; i < rgba.size(); i += 4)
+		{
+			if (rgba[i] != 255)
+				return true;
+		}
+		return false;
+	}
+	SH_RENDER_API auto TextureCompressor::Compress(const std::vector<std::vector<uint8_t>>& mips, uint32_t width, uint32_t height, TextureFormat format) -> std::vector<std::vector<uint8_t>>
+	{
+		if (!IsCompressedTextureFormat(format) || width == 0 || height == 0)
+		{
+			SH_ERROR_FORMAT("Invalid compress target: {}", TextureFormatToString(format));
+			return {};
+		}
+		const std::size_t blockSize = GetTextureFormatBlockSize(format);
+
+		struct Task
+		{
+			uint32_t mip;
+			uint32_t rowBegin;
+			uint32_t rowEnd;
+		};
+		std::vector<std::vector<uint8_t>> result(mips.size());
+		std::vector<Task> tasks;
+		for (uint32_t mip = 0; mip < mips.size(); ++mip)
+		{
+			const uint32_t mipWidth = std::max(1u, width >> mip);
+			const uint32_t mipHeight = std::max(1u, height >> mip);
+			if (mips[mip].size() < static_cast<std::size_t>(mipWidth) * mipHeight * 4)
+			{
+				SH_ERROR_FORMAT("Mip {} is smaller than {}x{} RGBA8", mip, mipWidth, mipHeight);
+				return {};
+			}
+			result[mip].resize(GetTextureFormatMipSize(format, mipWidth, mipHeight));
+
+			const uint32_t blockRows = (mipHeight + 3) / 4;
+			for (uint32_t row = 0; row < blockRows; row += BLOCK_ROWS_PER_TASK)
+				tasks.push_back(Task{ mip, row, std::min(blockRows, row + BLOCK_ROWS_PER_TASK) });
+		}
+
+		auto runTask =
+			[&](const Task& task)
+			{
+				const uint32_t mipWidth = std::max(1u, width >> task.mip);
+				const uint32_t mipHeight = std::max(1u, height >> task.mip);
+				const uint32_t blocksX = (mipWidth + 3) / 4;
+				const uint8_t* src = mips[task.mip].data();
+				uint8_t* dst = result[task.mip].data();
+
+				uint8_t block[BLOCK_PIXELS * 4];
+				for (uint32_t by = task.rowBegin; by < task.rowEnd; ++by)
+				{
+					for (uint32_t bx = 0; bx < blocksX; ++bx)
+					{
+						LoadBlock(src, mipWidth, mipHeight, bx, by, block);
+						CompressBlock(block, format, dst + (static_cast<std::size_t>(by) * blocksX + bx) * blockSize);
+					}
+				}
+			};
+
+		core::ThreadPool::GetInstance()->ParallelFor(tasks.size(),
+			[&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					runTask(tasks[i]);
+			}
+		);
+		return result;
+	}
+	SH_RENDER_API void TextureCompressor::CompressBlock(const uint8_t* block, TextureFormat format, uint8_t* out)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1: [[fallthrough]];
+		case TextureFormat::BC1_SRGB:
+			EncodeBC1(block, out);
+			break;
+		case TextureFormat::BC3: [[fallthrough]];
+		case TextureFormat::BC3_SRGB:
+			EncodeBC4(block, 3, out);
+			EncodeBC1(block, out + 8);
+			break;
+		case TextureFormat::BC4:
+			EncodeBC4(block, 0, out);
+			break;
+		case TextureFormat::BC5:
+			EncodeBC4(block, 0, out);
+			EncodeBC4(block, 1, out + 8);
+			break;
+		case TextureFormat::BC7: [[fallthrough]];
+		case TextureFormat::BC7_SRGB:
+			EncodeBC7(block, out);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+	SH_RENDER_API auto TextureCompressor::GetDecompressedFormat(TextureFormat format) -> TextureFormat
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1_SRGB: [[fallthrough]];
+		case TextureFormat::BC3_SRGB: [[fallthrough]];
+		case TextureFormat::BC7_SRGB:
+			return TextureFormat::SRGBA32;
+		default:
+			return IsCompressedTextureFormat(format) ? TextureFormat::RGBA32 : format;
+		}
+	}
+	SH_RENDER_API auto TextureCompressor::Decompress(const std::vector<std::vector<uint8_t>>& mips, uint32_t width, uint32_t height, TextureFormat format) -> std::vector<std::vector<uint8_t>>
+	{
+		if (!IsCompressedTextureFormat(format) || width == 0 || height == 0)
+		{
+			SH_ERROR_FORMAT("Invalid decompress source: {}", TextureFormatToString(format));
+			return {};
+		}
+		const std::size_t blockSize = GetTextureFormatBlockSize(format);
+
+		std::vector<std::vector<uint8_t>> result(mips.size());
+		uint8_t block[BLOCK_PIXELS * 4];
+		for (uint32_t mip = 0; mip < mips.size(); ++mip)
+		{
+			// 스트리밍으로 해제된 밉은 비워둔다.
+			if (mips[mip].empty())
+				continue;
+			const uint32_t mipWidth = std::max(1u, width >> mip);
+			const uint32_t mipHeight = std::max(1u, height >> mip);
+			if (mips[mip].size() != GetTextureFormatMipSize(format, mipWidth, mipHeight))
+			{
+				SH_ERROR_FORMAT("Mip {} is not a {}x{} {} image", mip, mipWidth, mipHeight, TextureFormatToString(format));
+				return {};
+			}
+			result[mip].resize(static_cast<std::size_t>(mipWidth) * mipHeight * 4);
+
+			const uint32_t blocksX = (mipWidth + 3) / 4;
+			const uint32_t blocksY = (mipHeight + 3) / 4;
+			const uint8_t* src = mips[mip].data();
+			uint8_t* dst = result[mip].data();
+			for (uint32_t by = 0; by < blocksY; ++by)
+			{
+				for (uint32_t bx = 0; bx < blocksX; ++bx)
+				{
+					DecompressBlock(src + (static_cast<std::size_t>(by) * blocksX + bx) * blockSize, format, block);
+					// 가장자리를 넘어가는 픽셀은 버린다.
+					const uint32_t copyWidth = std::min(4u, mipWidth - bx * 4);
+					const uint32_t copyHeight = std::min(4u, mipHeight - by * 4);
+					for (uint32_t y = 0; y < copyHeight; ++y)
+						std::memcpy(dst + ((static_cast<std::size_t>(by) * 4 + y) * mipWidth + bx * 4) * 4, block + y * 16, copyWidth * 4);
+				}
+			}
+		}
+		return result;
+	}
+	SH_RENDER_API void TextureCompressor::DecompressBlock(const uint8_t* in, TextureFormat format, uint8_t* block)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1: [[fallthrough]];
+		case TextureFormat::BC1_SRGB:
+			DecodeBC1(in, false, block);
+			break;
+		case TextureFormat::BC3: [[fallthrough]];
+		case TextureFormat::BC3_SRGB:
+			DecodeBC1(in + 8, true, block);
+			DecodeBC4(in, 3, block);
+			break;
+		case TextureFormat::BC4:
+			// 샘플링 결과와 같도록 (R, 0, 0, 1)
+			std::memset(block, 0, BLOCK_PIXELS * 4);
+			DecodeBC4(in, 0, block);
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+				block[i * 4 + 3] = 255;
+			break;
+		case TextureFormat::BC5:
+			// 샘플링 결과와 같도록 (R, G, 0, 1)
+			std::memset(block, 0, BLOCK_PIXELS * 4);
+			DecodeBC4(in, 0, block);
+			DecodeBC4(in + 8, 1, block);
+			for (int i = 0; i < BLOCK_PIXELS; ++i)
+				block[i * 4 + 3] = 255;
+			break;
+		case TextureFormat::BC7: [[fallthrough]];
+		case TextureFormat::BC7_SRGB:
+			DecodeBC7(in, block);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+}//namespace
@@ -19,6 +19,7 @@
 #include "Render/Drawable.h"
 #include "Render/ShaderPass.h"
 #include "Render/RenderData.h"
+#include "Render/SkinPaletteBuffer.h"
 
 #include "Core/Reflection.hpp"
 #include "Core/Logger.h"
@@ -29,6 +30,16 @@ namespace sh::render::vk
 {
     namespace
     {
+        /// @brief 셰이더의 CONSTANTS 푸시 상수 블록과 같은 레이아웃
+        struct ObjectConstants
+        {
+            glm::mat4 model;
+            Mesh::Dequantization dequantization;
+            uint32_t skinOffset; // 공유 스키닝 버퍼에서 이 메쉬 행렬의 시작 인덱스
+            uint32_t padding[3];
+        };
+        static_assert(sizeof(ObjectConstants) == 112);
+
         auto HasStencil(TextureFormat format) -> bool
         {
             return format == TextureFormat::D32S8 ||
@@ -314,6 +325,10 @@ namespace sh::render::vk
         const Mesh& mesh = *drawable.GetMesh();
         const Mesh::Topology topology = drawable.GetTopology();
         const bool bSkinned = drawable.IsSkinnedMesh();
+        const bool bQuantized = !bSkinned && mesh.IsQuantized();
+        // 공유 스키닝 버퍼에 행렬 공간을 잡지 못한 메쉬
+        if (bSkinned && drawable.GetSkinOffset(core::ThreadType::Render) == SkinPaletteBuffer::INVALID_OFFSET)
+            return;
         const Shader* const shader = mat.GetShader();
         if (!core::IsValid(shader))
             return;
@@ -323,6 +338,7 @@ namespace sh::render::vk
             return;
 
         const uint32_t cameraOffset = renderState.renderData->renderViewers[viewerIdx].offset;
+        const uint32_t lodSlot = renderState.renderData->renderViewers[viewerIdx].lodSlot;
 
         for (const ShaderPass& pass : *passes)
         {
@@ -334,7 +350,7 @@ namespace sh::render::vk
             const std::vector<uint8_t>* constantData = mat.GetConstantData(pass);
             const uint32_t setSize = static_cast<uint32_t>(vkPass.GetSetCount());
             VulkanPipelineManager::PipelineHandle handle =
-                context.GetPipelineManager().GetOrCreatePipelineHandle(vkPass, renderState.layout, topology, bSkinned, constantData);
+                context.GetPipelineManager().GetOrCreatePipelineHandle(vkPass, renderState.layout, topology, bSkinned, bQuantized, constantData);
 
             if (handle.index != renderState.lastPipelineIdx || handle.generation != renderState.lastPipelineGen)
             {
@@ -353,13 +369,14 @@ namespace sh::render::vk
 
             if (pass.HasConstantUniform())
             {
+                const ObjectConstants constants{ drawable.GetModelMatrix(core::ThreadType::Render), bQuantized ? mesh.GetDequantization() : Mesh::Dequantization{}, drawable.GetSkinOffset(core::ThreadType::Render) };
                 vkCmdPushConstants(buffer, pipelineLayout,
                     VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT,
-                    0, sizeof(glm::mat4),
-                    &drawable.GetModelMatrix(core::ThreadType::Render));
+                    0, sizeof(ObjectConstants),
+                    &constants);
             }
 
-            BindMesh(mesh, drawable.GetSubMeshIndex(), bSkinned);
+            BindMesh(mesh, drawable.GetSubMeshIndex(), drawable.GetLod(lodSlot), bSkinned);
         }
     }
     SH_RENDER_API void VulkanCommandBuffer::DrawMeshBatch(const std::vector<const Drawable*>& drawables, core::Name passName, std::size_t viewerIdx)
@@ -370,6 +387,7 @@ namespace sh::render::vk
         const Material& mat = *drawables.front()->GetMaterial();
         const Mesh::Topology topology = drawables.front()->GetTopology();
         const bool bSkinned = drawables.front()->IsSkinnedMesh();
+        const bool bQuantized = !bSkinned && drawables.front()->GetMesh()->IsQuantized();
 
         const Shader* const shader = mat.GetShader();
         if (!core::IsValid(shader))
@@ -380,6 +398,7 @@ namespace sh::render::vk
             return;
 
         const uint32_t cameraOffset = renderState.renderData->renderViewers[viewerIdx].offset;
+        const uint32_t lodSlot = renderState.renderData->renderViewers[viewerIdx].lodSlot;
 
         for (const ShaderPass& pass : *passes)
         {
@@ -391,7 +410,7 @@ namespace sh::render::vk
             const std::vector<uint8_t>* constantData = mat.GetConstantData(pass);
             const uint32_t setSize = static_cast<uint32_t>(vkPass.GetSetCount());
             VulkanPipelineManager::PipelineHandle handle =
-                context.GetPipelineManager().GetOrCreatePipelineHandle(vkPass, renderState.layout, topology, bSkinned, constantData);
+                context.GetPipelineManager().GetOrCreatePipelineHandle(vkPass, renderState.layout, topology, bSkinned, bQuantized, constantData);
 
             if (handle.index != renderState.lastPipelineIdx || handle.generation != renderState.lastPipelineGen)
             {
@@ -408,19 +427,22 @@ namespace sh::render::vk
 
             for (const Drawable* drawable : drawables)
             {
+                if (bSkinned && drawable->GetSkinOffset(core::ThreadType::Render) == SkinPaletteBuffer::INVALID_OFFSET)
+                    continue;
                 if (setSize > 1)
                     BindObjectSet(*drawable, pass, pipelineLayout);
 
+                const Mesh& mesh = *drawable->GetMesh();
                 if (pass.HasConstantUniform())
                 {
+                    const ObjectConstants constants{ drawable->GetModelMatrix(core::ThreadType::Render), bQuantized ? mesh.GetDequantization() : Mesh::Dequantization{}, drawable->GetSkinOffset(core::ThreadType::Render) };
                     vkCmdPushConstants(buffer, pipelineLayout,
                         VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT,
-                        0, sizeof(glm::mat4),
-                        &drawable->GetModelMatrix(core::ThreadType::Render));
+                        0, sizeof(ObjectConstants),
+                        &constants);
                 }
 
-                const Mesh& mesh = *drawable->GetMesh();
-                BindMesh(mesh, drawable->GetSubMeshIndex(), bSkinned);
+                BindMesh(mesh, drawable->GetSubMeshIndex(), drawable->GetLod(lodSlot), bSkinned);
             }
         }
     }
@@ -636,22 +658,11 @@ namespace sh::render::vk
             static_cast<uint32_t>(UniformStructLayout::Usage::Object),
             1, &objSet, 0, nullptr);
     }
-    void VulkanCommandBuffer::BindMesh(const Mesh& mesh, uint32_t subMeshIdx, bool bSkinned)
+    void VulkanCommandBuffer::BindMesh(const Mesh& mesh, uint32_t subMeshIdx, uint32_t lod, bool bSkinned)
     {
-        uint32_t indexCount = 0;
-        uint32_t firstIndex = 0;
-        const std::vector<SubMesh>& subMeshes = mesh.GetSubMeshes();
-        const uint32_t subMeshIndex = subMeshIdx;
-        if (subMeshIndex < static_cast<uint32_t>(subMeshes.size()))
-        {
-            indexCount = static_cast<uint32_t>(subMeshes[subMeshIndex].indexCount);
-            firstIndex = static_cast<uint32_t>(subMeshes[subMeshIndex].indexOffset);
-        }
-        else
-        {
-            indexCount = static_cast<uint32_t>(mesh.GetIndices().size());
-            firstIndex = 0;
-        }
+        const SubMesh range = mesh.GetIndexRange(subMeshIdx, lod);
+        const uint32_t indexCount = static_cast<uint32_t>(range.indexCount);
+        const uint32_t firstIndex = static_cast<uint32_t>(range.indexOffset);
 
         if (bSkinned)
         {
@@ -114,6 +114,7 @@ namespace sh::render::vk
 		computePipelineManager = std::make_unique<VulkanComputePipelineManager>(*this);
 
 		renderDataManager.Init(*this);
+		skinPaletteBuffer.Init(*this);
 	}
 	SH_RENDER_API void VulkanContext::Clear()
 	{
@@ -122,6 +123,7 @@ namespace sh::render::vk
 		vkDeviceWaitIdle(device);
 
 		IRenderThrMethod<RenderDataManager>::ClearBuffer(renderDataManager);
+		IRenderThrMethod<SkinPaletteBuffer>::ClearBuffer(skinPaletteBuffer);
 		pipelineManager.reset();
 		computePipelineManager.reset();
 		if (emptyDescLayout)
@@ -375,8 +377,15 @@ namespace sh::render::vk
 		assert(gpu != nullptr);
 		VkResult result;
 
+		VkPhysicalDeviceFeatures supportedFeatures{};
+		vkGetPhysicalDeviceFeatures(gpu, &supportedFeatures);
+
 		VkPhysicalDeviceFeatures deviceFeatures{};
 		deviceFeatures.samplerAnisotropy = true;
+		deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+		bTextureCompressionBC = supportedFeatures.textureCompressionBC == VK_TRUE;
+		if (!bTextureCompressionBC)
+			SH_WARN("BC texture compression is not supported by this device. Compressed textures will be decompressed on load.");
 
 		std::vector<VkDeviceQueueCreateInfo> queueInfos = queueManager->BuildQueueCreateInfos();
 
@@ -256,6 +256,8 @@ namespace sh::render::vk
 			mipHeight = std::max(1u, mipHeight / 2);
 		}
 		std::size_t bufferSize = mipWidth * mipHeight * pixelSize;
+		if (const uint32_t blockSize = GetFormatBlockSize(format); blockSize != 0)
+			bufferSize = static_cast<std::size_t>((mipWidth + 3) / 4) * ((mipHeight + 3) / 4) * blockSize;
 		
 		stagingBuffer.Create(bufferSize,
 			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
@@ -437,6 +439,22 @@ namespace sh::render::vk
 			return VkFormat::VK_FORMAT_D32_SFLOAT;
 		case TextureFormat::D16:
 			return VkFormat::VK_FORMAT_D16_UNORM;
+		case TextureFormat::BC1:
+			return VkFormat::VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case TextureFormat::BC1_SRGB:
+			return VkFormat::VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		case TextureFormat::BC3:
+			return VkFormat::VK_FORMAT_BC3_UNORM_BLOCK;
+		case TextureFormat::BC3_SRGB:
+			return VkFormat::VK_FORMAT_BC3_SRGB_BLOCK;
+		case TextureFormat::BC4:
+			return VkFormat::VK_FORMAT_BC4_UNORM_BLOCK;
+		case TextureFormat::BC5:
+			return VkFormat::VK_FORMAT_BC5_UNORM_BLOCK;
+		case TextureFormat::BC7:
+			return VkFormat::VK_FORMAT_BC7_UNORM_BLOCK;
+		case TextureFormat::BC7_SRGB:
+			return VkFormat::VK_FORMAT_BC7_SRGB_BLOCK;
 		default:
 			return VkFormat::VK_FORMAT_UNDEFINED;
 		}
@@ -463,4 +481,22 @@ namespace sh::render::vk
 			return 0;
 		}
 	}
+	auto VulkanImageBuffer::GetFormatBlockSize(VkFormat format) -> uint32_t
+	{
+		switch (format)
+		{
+		case VkFormat::VK_FORMAT_BC1_RGBA_UNORM_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC1_RGBA_SRGB_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC4_UNORM_BLOCK:
+			return 8;
+		case VkFormat::VK_FORMAT_BC3_UNORM_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC3_SRGB_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC5_UNORM_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC7_UNORM_BLOCK: [[fallthrough]];
+		case VkFormat::VK_FORMAT_BC7_SRGB_BLOCK:
+			return 16;
+		default:
+			return 0;
+		}
+	}
 }//namespace
@@ -46,6 +46,7 @@ namespace sh::render::vk
 		const RenderTargetLayout& renderTargetLayout,
 		Mesh::Topology topology,
 		bool bSkinned,
+		bool bQuantized,
 		const std::vector<uint8_t>* constDataPtr) -> PipelineHandle
 	{
 		std::size_t constantHash = 0;
@@ -56,8 +57,11 @@ namespace sh::render::vk
 				constantHash = core::Util::CombineHash(constantHash, hasher(data));
 		}
 
+		if (bSkinned)
+			bQuantized = false;
+
 		// 이미 파이프라인이 존재
-		PipelineInfo info{ &shader, renderTargetLayout, topology, constantHash, bSkinned };
+		PipelineInfo info{ &shader, renderTargetLayout, topology, constantHash, bSkinned, bQuantized };
 		{
 			std::shared_lock<std::shared_mutex> readLock{ mu };
 			auto it = infoIdx.find(info);
@@ -71,7 +75,7 @@ namespace sh::render::vk
 					std::unique_lock<std::shared_mutex> writeLock{ mu };
 					if (pipelines[it->second].pipelinePtr.get() == nullptr)
 					{
-						pipelines[it->second].pipelinePtr = BuildPipeline(shader, renderTargetLayout, topology, bSkinned, constDataPtr);
+						pipelines[it->second].pipelinePtr = BuildPipeline(shader, renderTargetLayout, topology, bSkinned, bQuantized, constDataPtr);
 						gen = ++pipelines[it->second].generation;
 					}
 				}
@@ -91,7 +95,7 @@ namespace sh::render::vk
 			uint32_t gen = 0;
 			if (emptyIdx.empty())
 			{
-				pipelines.push_back(Pipeline{ BuildPipeline(shader, renderTargetLayout, topology, bSkinned, constDataPtr), 0 });
+				pipelines.push_back(Pipeline{ BuildPipeline(shader, renderTargetLayout, topology, bSkinned, bQuantized, constDataPtr), 0 });
 				pipelinesInfo.push_back(info);
 
 				idx = static_cast<uint32_t>(pipelines.size()) - 1;
@@ -101,7 +105,7 @@ namespace sh::render::vk
 				idx = emptyIdx.front();
 				emptyIdx.pop();
 
-				pipelines[idx].pipelinePtr = BuildPipeline(shader, renderTargetLayout, topology, bSkinned, constDataPtr);
+				pipelines[idx].pipelinePtr = BuildPipeline(shader, renderTargetLayout, topology, bSkinned, bQuantized, constDataPtr);
 				gen = ++pipelines[idx].generation;
 			}
 			infoIdx.insert({ info, idx });
@@ -140,6 +144,7 @@ namespace sh::render::vk
 		const RenderTargetLayout& renderTargetLayout, 
 		Mesh::Topology topology, 
 		bool bSkinned, 
+		bool bQuantized,
 		const std::vector<uint8_t>* constDataPtr) -> std::unique_ptr<VulkanPipeline>
 	{
 		auto pipeline = std::make_unique<VulkanPipeline>(context.GetDevice(), renderTargetLayout);
@@ -173,8 +178,8 @@ namespace sh::render::vk
 
 		if (!bSkinned)
 		{
-			pipeline->AddBindingDescription(VulkanVertexBuffer::GetBindingDescription());
-			for (auto& attrDesc : VulkanVertexBuffer::GetAttributeDescriptions())
+			pipeline->AddBindingDescription(VulkanVertexBuffer::GetBindingDescription(bQuantized));
+			for (auto& attrDesc : VulkanVertexBuffer::GetAttributeDescriptions(bQuantized))
 				pipeline->AddAttributeDescription(attrDesc);
 		}
 		else
@@ -1,5 +1,6 @@
 ﻿#include "VulkanShaderPass.h"
 #include "VulkanContext.h"
+#include "Mesh.h"
 
 #include "Core/Logger.h"
 
@@ -220,11 +221,11 @@ namespace sh::render::vk
 	}
 	auto VulkanShaderPass::CreatePipelineLayout() -> VkResult
 	{
-		// 푸쉬 상수는 모델 행렬 전달 할 때만 씀
+		// 푸쉬 상수는 모델 행렬, 양자화 복원 값, 스키닝 행렬 시작 위치를 전달 할 때만 씀 (VulkanCommandBuffer의 ObjectConstants)
 		VkPushConstantRange pushConstantRange{};
 		pushConstantRange.stageFlags = VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT;
 		pushConstantRange.offset = 0;
-		pushConstantRange.size = sizeof(glm::mat4);
+		pushConstantRange.size = sizeof(glm::mat4) + sizeof(Mesh::Dequantization) + sizeof(uint32_t) * 4;
 
 		std::vector<VkDescriptorSetLayout> layouts(setlayouts.size(), VK_NULL_HANDLE);
 		for (int i = 0; i < setlayouts.size(); ++i)
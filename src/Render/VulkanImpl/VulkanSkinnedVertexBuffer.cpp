@@ -170,14 +170,23 @@ namespace sh::render::vk
 				VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 		}
 
-		// Index 버퍼
-		size_t indicesSize = sizeof(uint32_t) * mesh.GetIndices().size();
+		// Index 버퍼. LOD 인덱스는 원본 뒤에 붙인다.
+		size_t indicesSize = sizeof(uint32_t) * (mesh.GetIndices().size() + mesh.GetLodIndices().size());
 		VulkanBuffer stagingIdx{ context };
 		stagingIdx.Create(indicesSize,
 			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VkSharingMode::VK_SHARING_MODE_EXCLUSIVE,
 			VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-		stagingIdx.SetData(mesh.GetIndices().data());
+		if (mesh.GetLodIndices().empty())
+			stagingIdx.SetData(mesh.GetIndices().data());
+		else
+		{
+			std::vector<uint32_t> lodMergedIndices;
+			lodMergedIndices.reserve(mesh.GetIndices().size() + mesh.GetLodIndices().size());
+			lodMergedIndices.insert(lodMergedIndices.end(), mesh.GetIndices().begin(), mesh.GetIndices().end());
+			lodMergedIndices.insert(lodMergedIndices.end(), mesh.GetLodIndices().begin(), mesh.GetLodIndices().end());
+			stagingIdx.SetData(lodMergedIndices.data());
+		}
 
 		indexBuffer.Create(indicesSize,
 			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
@@ -4,6 +4,7 @@
 #include "VulkanCommandBuffer.h"
 #include "VulkanCommandBufferPool.h"
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 
 #include <cstddef>
 #include <array>
@@ -67,17 +68,42 @@ namespace sh::render::vk
 	{
 		return std::make_unique<VulkanVertexBuffer>(*this);
 	}
-	SH_RENDER_API auto VulkanVertexBuffer::GetBindingDescription() -> VkVertexInputBindingDescription
+	SH_RENDER_API auto VulkanVertexBuffer::GetBindingDescription(bool bQuantized) -> VkVertexInputBindingDescription
 	{
 		static VkVertexInputBindingDescription bindingDescription;
 		bindingDescription.binding = 0;
-		bindingDescription.stride = sizeof(Mesh::Vertex);
+		bindingDescription.stride = bQuantized ? sizeof(Mesh::QuantizedVertex) : sizeof(Mesh::Vertex);
 		bindingDescription.inputRate = VkVertexInputRate::VK_VERTEX_INPUT_RATE_VERTEX;
 
 		return bindingDescription;
 	}
-	SH_RENDER_API auto VulkanVertexBuffer::GetAttributeDescriptions() -> std::vector<VkVertexInputAttributeDescription>
+	SH_RENDER_API auto VulkanVertexBuffer::GetAttributeDescriptions(bool bQuantized) -> std::vector<VkVertexInputAttributeDescription>
 	{
+		if (bQuantized)
+		{
+			if (quantizedAttribDescriptions.empty())
+			{
+				VkVertexInputAttributeDescription attrDesc{};
+				attrDesc.binding = 0;
+				attrDesc.location = Mesh::VERTEX_ID;
+				attrDesc.format = VkFormat::VK_FORMAT_R16G16B16A16_UNORM;
+				attrDesc.offset = offsetof(Mesh::QuantizedVertex, vertex);
+				quantizedAttribDescriptions.push_back(attrDesc);
+				attrDesc.location = Mesh::UV_ID;
+				attrDesc.format = VkFormat::VK_FORMAT_R16G16_SFLOAT;
+				attrDesc.offset = offsetof(Mesh::QuantizedVertex, uv);
+				quantizedAttribDescriptions.push_back(attrDesc);
+				attrDesc.location = Mesh::NORMAL_ID;
+				attrDesc.format = VkFormat::VK_FORMAT_R16G16_SNORM;
+				attrDesc.offset = offsetof(Mesh::QuantizedVertex, normal);
+				quantizedAttribDescriptions.push_back(attrDesc);
+				attrDesc.location = Mesh::TANGENT_ID;
+				attrDesc.format = VkFormat::VK_FORMAT_R16G16_SNORM;
+				attrDesc.offset = offsetof(Mesh::QuantizedVertex, tangent);
+				quantizedAttribDescriptions.push_back(attrDesc);
+			}
+			return quantizedAttribDescriptions;
+		}
 		if (attribDescriptions.empty())
 		{
 			VkVertexInputAttributeDescription attrDesc{};
@@ -107,19 +133,37 @@ namespace sh::render::vk
 			return;
 
 		// 버텍스 버퍼
-		const size_t vertexBufferSize = sizeof(Mesh::Vertex) * mesh.GetVertexCount();
+		std::vector<Mesh::QuantizedVertex> quantized;
+		if (mesh.IsQuantized())
+			quantized = MeshOptimizer::Quantize(mesh.GetVertex(), mesh.GetDequantization());
+
+		const size_t vertexBufferSize = mesh.IsQuantized() ? 
+			sizeof(Mesh::QuantizedVertex) * quantized.size() :
+			sizeof(Mesh::Vertex) * mesh.GetVertexCount();
 		vertexBuffer.Create(vertexBufferSize,
 			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 			VkSharingMode::VK_SHARING_MODE_EXCLUSIVE,
 			VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		vertexBuffer.SetData(mesh.GetVertex().data());
+		if (mesh.IsQuantized())
+			vertexBuffer.SetData(quantized.data());
+		else
+			vertexBuffer.SetData(mesh.GetVertex().data());
 
-		// 인덱스 버퍼
-		const size_t indicesSize = sizeof(uint32_t) * mesh.GetIndices().size();
+		// 인덱스 버퍼. LOD 인덱스는 원본 뒤에 붙인다.
+		std::vector<uint32_t> lodMergedIndices;
+		const uint32_t* indexData = mesh.GetIndices().data();
+		if (!mesh.GetLodIndices().empty())
+		{
+			lodMergedIndices.reserve(mesh.GetIndices().size() + mesh.GetLodIndices().size());
+			lodMergedIndices.insert(lodMergedIndices.end(), mesh.GetIndices().begin(), mesh.GetIndices().end());
+			lodMergedIndices.insert(lodMergedIndices.end(), mesh.GetLodIndices().begin(), mesh.GetLodIndices().end());
+			indexData = lodMergedIndices.data();
+		}
+		const size_t indicesSize = sizeof(uint32_t) * (mesh.GetIndices().size() + mesh.GetLodIndices().size());
 		indexBuffer.Create(indicesSize,
 			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			VkSharingMode::VK_SHARING_MODE_EXCLUSIVE,
 			VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		indexBuffer.SetData(mesh.GetIndices().data());
+		indexBuffer.SetData(indexData);
 	}
 }//namespace
\ No newline at end of file